@@ -202,3 +202,11 @@ CHECK_CXX_SOURCE_COMPILES("
     " HAVE_MMAP
 )
 GR_ADD_COND_DEF(HAVE_MMAP)
+
+########################################################################
+CHECK_CXX_SOURCE_COMPILES("
+    static __thread int x;
+    int main(){x = 1; return x;}
+    " HAVE___THREAD
+)
+GR_ADD_COND_DEF(HAVE___THREAD)
@@ -218,6 +218,9 @@ namespace gr {
         throw std::runtime_error("port does not exist!");
       return msg_queue[which_port].size(); 
     }
+
+    //! As nmsgs, but takes the mutex, for callers on other threads
+    size_t nmsgs_locked(pmt::pmt_t which_port);
   
     //| Acquires and release the mutex
     void insert_tail( pmt::pmt_t which_port, pmt::pmt_t msg);
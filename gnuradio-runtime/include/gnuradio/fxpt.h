@@ -101,6 +101,17 @@ namespace gr {
       return;
     }
 
+    /*!
+     * \brief The table behind sin and cos: slope and offset of
+     * each of the 1 << 10 segments, indexed by the top 10 bits of
+     * the angle and applied to the angle shifted right once
+     */
+    static const float *
+      sine_table()
+    {
+      return &s_sine_table[0][0];
+    }
+
   };
 
 } /* namespace gr */
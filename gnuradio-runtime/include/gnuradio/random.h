@@ -37,6 +37,7 @@ static const int RANDOM_MAX = 2147483647; // 2^31-1
 #endif /* RANDOM_MAX */
 
 #include <stdlib.h>
+#include <stdint.h>
 
 namespace gr {
 
@@ -53,6 +54,9 @@ namespace gr {
     long d_iv[NTAB];
     int	d_iset;
     float d_gset;
+    uint32_t d_state[16];
+
+    void seed_fill_state(long seed);
 
   public:
     random(long seed=3021);
@@ -73,6 +77,29 @@ namespace gr {
     float impulse(float factor);
     float rayleigh();
     gr_complex rayleigh_complex();
+
+    /*!
+     * \brief fill \p out with \p n uniform deviates in the range [0.0, 1.0)
+     *
+     * The fill functions draw from four interleaved xoshiro128**
+     * generators, 2^64 draws apart, that are seeded along with ran1()
+     * but are independent of it.  They are several times faster than
+     * the single sample functions and do not change their sequences.
+     */
+    void ran1_fill(float *out, int n);
+
+    /*!
+     * \brief fill \p out with \p n normally distributed deviates with
+     * zero mean and variance 1 (SIMD Box-Muller, see
+     * volk_32u_gaussian_32f)
+     */
+    void gasdev_fill(float *out, int n);
+
+    /*!
+     * \brief fill \p out with \p n complex deviates, I and Q normally
+     * distributed with zero mean and variance 1 like rayleigh_complex()
+     */
+    void rayleigh_complex_fill(gr_complex *out, int n);
   };
 
 } /* namespace gr */
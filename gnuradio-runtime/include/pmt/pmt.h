@@ -544,6 +544,9 @@ PMT_API std::complex<double> *c64vector_writable_elements(pmt_t v, size_t &len);
  * This is a functional data structure that is persistent.  Updating a
  * functional data structure does not destroy the existing version, but
  * rather creates a new version that coexists with the old.
+ *
+ * A dictionary that is not empty is also a list, that of dict_items:
+ * is_pair, car, cdr, nth and the other list functions see it as that.
  * ------------------------------------------------------------------------
  */
 
@@ -868,6 +871,33 @@ PMT_API std::string serialize_str(pmt_t obj);
  */
 PMT_API pmt_t deserialize_str(std::string str);
 
+/*!
+ * \brief Number of bytes in the portable byte-serial representation of \p obj
+ */
+PMT_API size_t serialized_size(pmt_t obj);
+
+/*!
+ * \brief Write portable byte-serial representation of \p obj to \p buf
+ *
+ * Returns the number of bytes written, or 0 if it takes more than
+ * \p len bytes.  See serialized_size().
+ */
+PMT_API size_t serialize_buf(pmt_t obj, void *buf, size_t len);
+
+/*!
+ * \brief Create obj from portable byte-serial representation in memory
+ *
+ * Reads the object at offset \p pos of the \p len bytes at \p buf and
+ * advances \p pos past it.  Returns PMT_EOF when \p pos is at the end.
+ * Throws exception on malformed input, including a truncated object.
+ */
+PMT_API pmt_t deserialize_buf(const void *buf, size_t len, size_t &pos);
+
+/*!
+ * \brief Create obj from the portable byte-serial representation in memory
+ */
+PMT_API pmt_t deserialize_buf(const void *buf, size_t len);
+
 /*!
  * \brief Provide a comparator function object to allow pmt use in stl types
  */
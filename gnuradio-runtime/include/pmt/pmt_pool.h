@@ -1,6 +1,6 @@
 /* -*- c++ -*- */
 /*
- * Copyright 2007,2009,2013 Free Software Foundation, Inc.
+ * Copyright 2007,2009,2013,2014 Free Software Foundation, Inc.
  *
  * This file is part of GNU Radio
  *
@@ -31,8 +31,12 @@ namespace pmt {
 /*!
  * \brief very simple thread-safe fixed-size allocation pool
  *
- * FIXME may want to go to global allocation with per-thread free list.
- * This would eliminate virtually all lock contention.
+ * Where the compiler has thread-local storage, each thread keeps a
+ * short free list of its own in front of the shared one, and trades
+ * items with it in batches under the lock.  A thread can then
+ * allocate and free without locking, including objects that were
+ * allocated by another thread.  Pools with a max_items limit always
+ * go through the shared list.
  */
 class PMT_API pmt_pool {
 
@@ -51,6 +55,11 @@ class PMT_API pmt_pool {
   size_t	      d_n_items;
   item	       	     *d_freelist;
   std::vector<char *> d_allocations;
+  int		      d_cache;		// per-thread free list slot, or -1
+
+  void grow();
+  void refill_cache();
+  void drain_cache(size_t n);
 
 public:
   /*!
@@ -66,6 +75,12 @@ public:
 
   void *malloc();
   void free(void *p);
+
+  /*!
+   * \brief Returns the items on the calling thread's free lists to
+   * their pools.  Done when a thread exits.
+   */
+  static void flush_thread_cache();
 };
 
 } /* namespace pmt */
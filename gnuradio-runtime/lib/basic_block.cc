@@ -201,6 +201,13 @@ namespace gr {
     global_block_registry.notify_blk(alias());
   }
 
+  size_t
+  basic_block::nmsgs_locked(pmt::pmt_t which_port)
+  {
+    gr::thread::scoped_lock guard(mutex);
+    return nmsgs(which_port);
+  }
+
   pmt::pmt_t
   basic_block::delete_head_nowait(pmt::pmt_t which_port)
   {
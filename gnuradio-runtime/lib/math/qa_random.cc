@@ -0,0 +1,110 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <qa_random.h>
+#include <gnuradio/random.h>
+#include <cppunit/TestAssert.h>
+#include <cmath>
+#include <vector>
+
+static const int N = 1 << 18;
+
+void
+qa_random::t1()
+{
+  // uniform fill stays in [0, 1) and has the right moments
+  gr::random rng(42);
+  std::vector<float> x(N + 3);
+  double s1 = 0, s2 = 0;
+
+  rng.ran1_fill(&x[0], N + 3);
+  for(int i = 0; i < N; i++) {
+    CPPUNIT_ASSERT(x[i] >= 0.0f && x[i] < 1.0f);
+    s1 += x[i];
+    s2 += x[i] * x[i];
+  }
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, s1/N, 0.005);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0/12.0, s2/N - (s1/N)*(s1/N), 0.002);
+}
+
+void
+qa_random::t2()
+{
+  // gaussian fill has zero mean, unit variance and the right tails
+  gr::random rng(7);
+  std::vector<float> x(N);
+  double s1 = 0, s2 = 0, s4 = 0;
+  int tail = 0;
+
+  rng.gasdev_fill(&x[0], N);
+  for(int i = 0; i < N; i++) {
+    double v = x[i];
+    s1 += v;
+    s2 += v * v;
+    s4 += v * v * v * v;
+    if(std::abs(v) > 2.0)
+      tail++;
+  }
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, s1/N, 0.01);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, s2/N, 0.01);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, s4/N, 0.05);
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0455, (double)tail/N, 0.002);
+
+  // I and Q are uncorrelated
+  std::vector<gr_complex> c(N/2);
+  double iq = 0;
+  rng.rayleigh_complex_fill(&c[0], N/2);
+  for(int i = 0; i < N/2; i++)
+    iq += c[i].real() * c[i].imag();
+  CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, iq/(N/2), 0.01);
+}
+
+void
+qa_random::t3()
+{
+  // the same seed gives the same samples, also when they are drawn in
+  // blocks of a multiple of eight
+  gr::random a(1234), b(1234), c(1235);
+  std::vector<float> x(1000), y(1000), z(1000);
+
+  a.gasdev_fill(&x[0], 1000);
+  b.gasdev_fill(&y[0], 1000);
+  c.gasdev_fill(&z[0], 1000);
+  for(int i = 0; i < 1000; i++)
+    CPPUNIT_ASSERT_EQUAL(x[i], y[i]);
+  CPPUNIT_ASSERT(x[0] != z[0] || x[1] != z[1]);
+
+  a.reseed(1234);
+  a.gasdev_fill(&y[0], 400);
+  a.gasdev_fill(&y[400], 600);
+  for(int i = 0; i < 1000; i++)
+    CPPUNIT_ASSERT_EQUAL(x[i], y[i]);
+
+  // the single sample functions are not affected
+  gr::random d(1234), e(1234);
+  d.gasdev_fill(&x[0], 1000);
+  CPPUNIT_ASSERT_EQUAL(e.ran1(), d.ran1());
+}
@@ -41,6 +41,7 @@
 
 #include <math.h>
 #include <gnuradio/random.h>
+#include <volk/volk.h>
 
 namespace gr {
 
@@ -67,6 +68,94 @@ namespace gr {
       d_iv[i] = 0;
     d_iset = 0;
     d_gset = 0;
+    seed_fill_state(seed);
+  }
+
+  /*
+   * xoshiro128** by D. Blackman and S. Vigna on one generator, s[0..3].
+   */
+  static inline uint32_t
+  xoshiro_next(uint32_t *s)
+  {
+    const uint32_t r = s[1] * 5;
+    const uint32_t result = ((r << 7) | (r >> 25)) * 9;
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+  }
+
+  /*
+   * One step of each of the four interleaved generators in d_state,
+   * written lane by lane so that the compiler can vectorize it.
+   */
+  static inline void
+  xoshiro_next4(uint32_t *st, uint32_t *k)
+  {
+    uint32_t r, t[4];
+
+    for(int l = 0; l < 4; l++) {
+      r = st[4 + l] * 5;
+      k[l] = ((r << 7) | (r >> 25)) * 9;
+      t[l] = st[4 + l] << 9;
+    }
+    for(int l = 0; l < 4; l++) {
+      st[8 + l] ^= st[l];
+      st[12 + l] ^= st[4 + l];
+      st[4 + l] ^= st[8 + l];
+      st[l] ^= st[12 + l];
+      st[8 + l] ^= t[l];
+      st[12 + l] = (st[12 + l] << 11) | (st[12 + l] >> 21);
+    }
+  }
+
+  /*
+   * The first generator is seeded through splitmix64, the others are
+   * each 2^64 draws further along, so that their sequences never
+   * overlap.  d_state is interleaved as s0[4] s1[4] s2[4] s3[4].
+   */
+  void
+  random::seed_fill_state(long seed)
+  {
+    static const uint32_t jump[4] = {
+      0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b
+    };
+    uint64_t x = (uint64_t)seed;
+    uint32_t s[4], j[4];
+
+    for(int i = 0; i < 4; i += 2) {
+      uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      z = z ^ (z >> 31);
+      s[i] = (uint32_t)z;
+      s[i+1] = (uint32_t)(z >> 32);
+    }
+    if(!(s[0] | s[1] | s[2] | s[3]))
+      s[0] = 1;
+
+    for(int l = 0; l < 4; l++) {
+      for(int w = 0; w < 4; w++)
+        d_state[4*w + l] = s[w];
+
+      j[0] = j[1] = j[2] = j[3] = 0;
+      for(int i = 0; i < 4; i++) {
+        for(int b = 0; b < 32; b++) {
+          if(jump[i] & (1u << b)) {
+            for(int w = 0; w < 4; w++)
+              j[w] ^= s[w];
+          }
+          xoshiro_next(s);
+        }
+      }
+      for(int w = 0; w < 4; w++)
+        s[w] = j[w];
+    }
   }
 
   /*
@@ -185,4 +274,36 @@ namespace gr {
     return sqrt(-2.0 * log(ran1()));
   }
 
+  void
+  random::ran1_fill(float *out, int n)
+  {
+    uint32_t k[4];
+    float tmp[4];
+
+    for(int i = 0; i < n; i += 4) {
+      float *o = (n - i >= 4) ? out + i : tmp;
+      xoshiro_next4(d_state, k);
+      for(int l = 0; l < 4; l++)
+        o[l] = (k[l] >> 8) * (1.0f / 16777216.0f);
+      if(o == tmp) {
+        for(int l = 0; i + l < n; l++)
+          out[i + l] = tmp[l];
+      }
+    }
+  }
+
+  void
+  random::gasdev_fill(float *out, int n)
+  {
+    if(n > 0)
+      volk_32u_gaussian_32f(out, d_state, n);
+  }
+
+  void
+  random::rayleigh_complex_fill(gr_complex *out, int n)
+  {
+    if(n > 0)
+      volk_32u_gaussian_32f((float*)out, d_state, 2*n);
+  }
+
 } /* namespace gr */
@@ -25,6 +25,7 @@
 #endif
 
 #include <vector>
+#include <algorithm>
 #include <pmt/pmt.h>
 #include "pmt_int.h"
 #include <gnuradio/messages/msg_accepter.h>
@@ -34,26 +35,47 @@
 
 namespace pmt {
 
-static const int CACHE_LINE_SIZE = 64;		// good guess
-
 # if (PMT_LOCAL_ALLOCATOR)
 
-static pmt_pool global_pmt_pool(sizeof(pmt_pair), CACHE_LINE_SIZE);
+/*
+ * Objects up to 64 bytes, which is all of them on 32 and 64-bit
+ * machines, come from two pools of 32 and 64 byte items.  The
+ * pools are made on first use, as objects are made during static
+ * initialization, and never destroyed, as they are freed during
+ * static destruction.
+ */
+static const size_t SMALL_OBJECT_SIZE = 32;
+static const size_t LARGE_OBJECT_SIZE = 64;
+
+static pmt_pool **
+object_pools()
+{
+  static pmt_pool *pools[2] = {
+    new pmt_pool(SMALL_OBJECT_SIZE, 16, 16384),
+    new pmt_pool(LARGE_OBJECT_SIZE, 16, 16384)
+  };
+  return pools;
+}
 
 void *
 pmt_base::operator new(size_t size)
 {
-  void *p = global_pmt_pool.malloc();
-
-  // fprintf(stderr, "pmt_base::new p = %p\n", p);
-  assert((reinterpret_cast<intptr_t>(p) & (CACHE_LINE_SIZE - 1)) == 0);
-  return p;
+  if (size <= SMALL_OBJECT_SIZE)
+    return object_pools()[0]->malloc();
+  if (size <= LARGE_OBJECT_SIZE)
+    return object_pools()[1]->malloc();
+  return ::operator new(size);
 }
 
 void
 pmt_base::operator delete(void *p, size_t size)
 {
-  global_pmt_pool.free(p);
+  if (size <= SMALL_OBJECT_SIZE)
+    object_pools()[0]->free(p);
+  else if (size <= LARGE_OBJECT_SIZE)
+    object_pools()[1]->free(p);
+  else
+    ::operator delete(p);
 }
 
 #endif
@@ -154,6 +176,12 @@ _any(pmt_t x)
   return dynamic_cast<pmt_any*>(x.get());
 }
 
+static pmt_dict *
+_dict(const pmt_t &x)
+{
+  return static_cast<pmt_dict*>(x.get());
+}
+
 ////////////////////////////////////////////////////////////////////////////
 //                           Globals
 ////////////////////////////////////////////////////////////////////////////
@@ -242,9 +270,10 @@ string_to_symbol(const std::string &name)
   unsigned hash = hash_string(name) % SYMBOL_HASH_TABLE_SIZE;
 
   // Does a symbol with this name already exist?
-  for (pmt_t sym = s_symbol_hash_table[hash]; sym; sym = _symbol(sym)->next()){
-    if (name == _symbol(sym)->name())
-      return sym;		// Yes.  Return it
+  for (const pmt_t *sym = &s_symbol_hash_table[hash]; *sym;
+       sym = &static_cast<pmt_symbol*>(sym->get())->next()){
+    if (name == static_cast<pmt_symbol*>(sym->get())->name())
+      return *sym;		// Yes.  Return it
   }
 
   // Nope.  Make a new one.
@@ -295,9 +324,36 @@ is_integer(pmt_t x)
 }
 
 
+/*
+ * The integers from -128 to 1023 are made once, like the booleans, as
+ * are the uint64s below 1024: packet lengths, counts and indices come
+ * from these again and again.  The tables are made on first use and
+ * never destroyed.
+ */
+static const long SMALL_INTEGER_MIN = -128;
+static const long SMALL_INTEGER_MAX = 1023;
+
+static const pmt_t *
+make_small_integers()
+{
+  pmt_t *t = new pmt_t[SMALL_INTEGER_MAX - SMALL_INTEGER_MIN + 1];
+  for (long i = SMALL_INTEGER_MIN; i <= SMALL_INTEGER_MAX; i++)
+    t[i - SMALL_INTEGER_MIN] = pmt_t(new pmt_integer(i));
+  return t;
+}
+
+static const pmt_t *
+small_integers()
+{
+  static const pmt_t *table = make_small_integers();
+  return table;
+}
+
 pmt_t
 from_long(long x)
 {
+  if (x >= SMALL_INTEGER_MIN && x <= SMALL_INTEGER_MAX)
+    return small_integers()[x - SMALL_INTEGER_MIN];
   return pmt_t(new pmt_integer(x));
 }
 
@@ -324,9 +380,27 @@ is_uint64(pmt_t x)
 }
 
 
+static const pmt_t *
+make_small_uint64s()
+{
+  pmt_t *t = new pmt_t[SMALL_INTEGER_MAX + 1];
+  for (long i = 0; i <= SMALL_INTEGER_MAX; i++)
+    t[i] = pmt_t(new pmt_uint64(i));
+  return t;
+}
+
+static const pmt_t *
+small_uint64s()
+{
+  static const pmt_t *table = make_small_uint64s();
+  return table;
+}
+
 pmt_t
 from_uint64(uint64_t x)
 {
+  if (x <= (uint64_t) SMALL_INTEGER_MAX)
+    return small_uint64s()[x];
   return pmt_t(new pmt_uint64(x));
 }
 
@@ -435,10 +509,12 @@ is_null(const pmt_t& x)
   return x == PMT_NIL;
 }
 
+// A pmt_dict is never empty, and is taken as the a-list of its items,
+// as when dicts were a-lists
 bool
 is_pair(const pmt_t& obj)
 {
-  return obj->is_pair();
+  return obj->is_pair() || obj->is_dict();
 }
 
 pmt_t
@@ -454,6 +530,12 @@ car(const pmt_t& pair)
   if ( p )
     return p->car();
 
+  if (pair->is_dict()){
+    std::vector<pmt_pair*> pairs;
+    _dict(pair)->entries(pairs);
+    return pmt_t(pairs[0]);
+  }
+
   throw wrong_type("pmt_car", pair);
 }
 
@@ -464,6 +546,9 @@ cdr(const pmt_t& pair)
   if ( p )
     return p->cdr();
 
+  if (pair->is_dict())
+    return cdr(dict_items(pair));
+
   throw wrong_type("pmt_cdr", pair);
 }
 
@@ -781,17 +866,380 @@ uniform_vector_writable_elements(pmt_t vector, size_t &len)
 ////////////////////////////////////////////////////////////////////////////
 
 /*
- * This is an a-list implementation.
+ * A dictionary is either an a-list, which is what make_dict() and
+ * dict_add() used to build and what deserialize() still returns, or a
+ * pmt_dict.  dict_add() makes a pmt_dict of either; the empty
+ * dictionary is always PMT_NIL.
+ *
+ * A pmt_dict is a persistent hash array mapped trie of (key . value)
+ * pairs, 5 bits of the key's hash per level, in the compressed form
+ * of Steindorfer and Vinju's CHAMP.  Each node keeps its entries and
+ * subnodes in one array, entries first, and a bitmap of each.  Adding
+ * or deleting copies the nodes along one path and shares the rest, so
+ * lookups are O(1) expected and updates cost a few node copies.  Below
+ * the last level, keys with equal hashes share a collision node.
  *
- * When we need better performance for large dictionaries, consider implementing
- * persistent Red-Black trees as described in "Purely Functional Data Structures",
- * Chris Okasaki, 1998, section 3.3.
+ * Each entry has a serial number, which dict_add() takes from the
+ * dictionary's count of additions.  dict_items() sorts by it, newest
+ * first: the order of the a-list the same calls would have built, and
+ * so what gets serialized.
+ */
+
+bool eqv_raw(pmt_base *x, pmt_base *y);
+
+static const unsigned int DICT_BITS = 5;
+static const uint32_t DICT_MASK = (1 << DICT_BITS) - 1;
+static const unsigned int DICT_HASH_BITS = 32;
+
+static inline unsigned int
+popcount(uint32_t x)
+{
+  x = x - ((x >> 1) & 0x55555555);
+  x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+  x = (x + (x >> 4)) & 0x0f0f0f0f;
+  return (x * 0x01010101) >> 24;
+}
+
+// Hash consistent with eqv(): numbers by value, the rest by identity
+static uint32_t
+dict_hash(pmt_base *key)
+{
+  uint64_t h;
+  if (key->is_number()){
+    if (key->is_integer())
+      h = static_cast<pmt_integer*>(key)->d_value;
+    else if (key->is_uint64())
+      h = static_cast<pmt_uint64*>(key)->d_value;
+    else if (key->is_real()){
+      double d = static_cast<pmt_real*>(key)->d_value;
+      if (d == 0)
+	d = 0;		// -0.0 is eqv to 0.0
+      memcpy(&h, &d, sizeof(h));
+    }
+    else {
+      std::complex<double> c = static_cast<pmt_complex*>(key)->d_value;
+      double d[2] = { c.real() == 0 ? 0 : c.real(), c.imag() == 0 ? 0 : c.imag() };
+      uint64_t i[2];
+      memcpy(i, d, sizeof(i));
+      h = i[0] ^ (i[1] * 31);
+    }
+  }
+  else
+    h = (uintptr_t) key;
+
+  // MurmurHash3 finalizer
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return (uint32_t) h;
+}
+
+namespace {
+
+  struct dict_slot {
+    pmt_t	ref;		// (key . value) pair or subnode
+    uint64_t	serial;		// of an entry
+
+    pmt_base *key() const { return static_cast<pmt_pair*>(ref.get())->d_car.get(); }
+  };
+
+  class pmt_dict_node : public pmt_base
+  {
+  public:
+    uint32_t d_datamap;			// slots holding entries
+    uint32_t d_nodemap;			// slots holding subnodes
+    std::vector<dict_slot> d_slots;	// entries, then subnodes, in bit order
+
+    pmt_dict_node() : d_datamap(0), d_nodemap(0) {}
+
+    size_t entry_index(uint32_t bit) const
+    { return popcount(d_datamap & (bit - 1)); }
+
+    size_t node_index(uint32_t bit) const
+    { return popcount(d_datamap) + popcount(d_nodemap & (bit - 1)); }
+
+    const pmt_dict_node *node(size_t i) const
+    { return static_cast<const pmt_dict_node*>(d_slots[i].ref.get()); }
+
+    pmt_dict_node *copy() const
+    {
+      pmt_dict_node *n = new pmt_dict_node();
+      n->d_datamap = d_datamap;
+      n->d_nodemap = d_nodemap;
+      n->d_slots.reserve(d_slots.size() + 1);	// room for an insert
+      n->d_slots.assign(d_slots.begin(), d_slots.end());
+      return n;
+    }
+  };
+
+} /* namespace */
+
+static inline uint32_t
+dict_bit(uint32_t hash, unsigned int shift)
+{
+  return 1u << ((hash >> shift) & DICT_MASK);
+}
+
+// The slot of key under node, or 0
+static const dict_slot *
+dict_find(const pmt_dict_node *node, pmt_base *key, uint32_t hash)
+{
+  for (unsigned int shift = 0; shift < DICT_HASH_BITS; shift += DICT_BITS){
+    uint32_t bit = dict_bit(hash, shift);
+    if (node->d_datamap & bit){
+      const dict_slot &s = node->d_slots[node->entry_index(bit)];
+      return eqv_raw(key, s.key()) ? &s : 0;
+    }
+    if (!(node->d_nodemap & bit))
+      return 0;
+    node = node->node(node->node_index(bit));
+  }
+
+  // collision node
+  for (size_t i = 0; i < node->d_slots.size(); i++)
+    if (eqv_raw(key, node->d_slots[i].key()))
+      return &node->d_slots[i];
+  return 0;
+}
+
+// A node holding entries a and b, whose hashes agree below shift
+static pmt_t
+dict_join(const dict_slot &a, uint32_t ha, const dict_slot &b, uint32_t hb,
+	  unsigned int shift)
+{
+  pmt_dict_node *n = new pmt_dict_node();
+  pmt_t result(n);
+
+  if (shift >= DICT_HASH_BITS){
+    n->d_slots.push_back(a);
+    n->d_slots.push_back(b);
+    return result;
+  }
+
+  uint32_t ba = dict_bit(ha, shift);
+  uint32_t bb = dict_bit(hb, shift);
+  if (ba == bb){
+    dict_slot sub;
+    sub.ref = dict_join(a, ha, b, hb, shift + DICT_BITS);
+    sub.serial = 0;
+    n->d_nodemap = ba;
+    n->d_slots.push_back(sub);
+  }
+  else {
+    n->d_datamap = ba | bb;
+    n->d_slots.push_back(ba < bb ? a : b);
+    n->d_slots.push_back(ba < bb ? b : a);
+  }
+  return result;
+}
+
+// node with entry e added, or replacing the entry with the same key
+static pmt_t
+dict_insert(const pmt_dict_node *node, const dict_slot &e, uint32_t hash,
+	    unsigned int shift, bool &replaced)
+{
+  pmt_dict_node *n = node->copy();
+  pmt_t result(n);
+  pmt_base *key = e.key();
+
+  if (shift >= DICT_HASH_BITS){		// collision node
+    for (size_t i = 0; i < n->d_slots.size(); i++){
+      if (eqv_raw(key, n->d_slots[i].key())){
+	n->d_slots[i] = e;
+	replaced = true;
+	return result;
+      }
+    }
+    n->d_slots.push_back(e);
+    return result;
+  }
+
+  uint32_t bit = dict_bit(hash, shift);
+  if (n->d_datamap & bit){
+    size_t i = n->entry_index(bit);
+    if (eqv_raw(key, n->d_slots[i].key())){
+      n->d_slots[i] = e;
+      replaced = true;
+      return result;
+    }
+
+    // push both entries down into a new subnode
+    dict_slot sub;
+    sub.ref = dict_join(n->d_slots[i], dict_hash(n->d_slots[i].key()),
+			e, hash, shift + DICT_BITS);
+    sub.serial = 0;
+    n->d_slots.erase(n->d_slots.begin() + i);
+    n->d_datamap &= ~bit;
+    n->d_nodemap |= bit;
+    n->d_slots.insert(n->d_slots.begin() + n->node_index(bit), sub);
+  }
+  else if (n->d_nodemap & bit){
+    size_t i = n->node_index(bit);
+    n->d_slots[i].ref = dict_insert(n->node(i), e, hash, shift + DICT_BITS,
+				    replaced);
+  }
+  else {
+    n->d_slots.insert(n->d_slots.begin() + n->entry_index(bit), e);
+    n->d_datamap |= bit;
+  }
+  return result;
+}
+
+/*
+ * node without key, or node itself if key isn't there.  A subnode
+ * left with a single entry is folded into its parent, and an empty
+ * one removed, so that a null result only comes from the root.
  */
+static pmt_t
+dict_remove(const pmt_t &node_ref, pmt_base *key, uint32_t hash,
+	    unsigned int shift, bool &found)
+{
+  const pmt_dict_node *node = static_cast<const pmt_dict_node*>(node_ref.get());
+
+  if (shift >= DICT_HASH_BITS){		// collision node
+    for (size_t i = 0; i < node->d_slots.size(); i++){
+      if (eqv_raw(key, node->d_slots[i].key())){
+	found = true;
+	if (node->d_slots.size() == 1)
+	  return pmt_t();
+	pmt_dict_node *n = node->copy();
+	n->d_slots.erase(n->d_slots.begin() + i);
+	return pmt_t(n);
+      }
+    }
+    return node_ref;
+  }
+
+  uint32_t bit = dict_bit(hash, shift);
+  if (node->d_datamap & bit){
+    size_t i = node->entry_index(bit);
+    if (!eqv_raw(key, node->d_slots[i].key()))
+      return node_ref;
+    found = true;
+    if (node->d_slots.size() == 1)
+      return pmt_t();
+    pmt_dict_node *n = node->copy();
+    n->d_slots.erase(n->d_slots.begin() + i);
+    n->d_datamap &= ~bit;
+    return pmt_t(n);
+  }
+
+  if (node->d_nodemap & bit){
+    size_t i = node->node_index(bit);
+    pmt_t sub = dict_remove(node->d_slots[i].ref, key, hash,
+			    shift + DICT_BITS, found);
+    if (!found)
+      return node_ref;
+
+    pmt_dict_node *n = node->copy();
+    pmt_t result(n);
+    const pmt_dict_node *s = static_cast<const pmt_dict_node*>(sub.get());
+    if (s && (s->d_nodemap != 0 || s->d_slots.size() > 1)){
+      n->d_slots[i].ref = sub;
+      return result;
+    }
+
+    // the subnode is gone, or down to an entry to fold in here
+    n->d_slots.erase(n->d_slots.begin() + i);
+    n->d_nodemap &= ~bit;
+    if (s){
+      n->d_slots.insert(n->d_slots.begin() + n->entry_index(bit), s->d_slots[0]);
+      n->d_datamap |= bit;
+    }
+    else if (n->d_slots.empty())
+      return pmt_t();
+    return result;
+  }
+
+  return node_ref;
+}
+
+static void
+dict_collect(const pmt_dict_node *node, std::vector<const dict_slot*> &out)
+{
+  size_t nentries = popcount(node->d_datamap);
+  if (node->d_datamap == 0 && node->d_nodemap == 0)
+    nentries = node->d_slots.size();		// collision node
+  for (size_t i = 0; i < node->d_slots.size(); i++){
+    if (i < nentries)
+      out.push_back(&node->d_slots[i]);
+    else
+      dict_collect(node->node(i), out);
+  }
+}
+
+static bool
+newer(const dict_slot *a, const dict_slot *b)
+{
+  return a->serial > b->serial;
+}
+
+pmt_dict::pmt_dict(const pmt_t &root, size_t size, uint64_t serial)
+  : d_root(root), d_size(size), d_serial(serial) {}
+
+void
+pmt_dict::entries(std::vector<pmt_pair*> &pairs) const
+{
+  std::vector<const dict_slot*> slots;
+  slots.reserve(d_size);
+  dict_collect(static_cast<const pmt_dict_node*>(d_root.get()), slots);
+  std::sort(slots.begin(), slots.end(), newer);
+
+  pairs.resize(slots.size());
+  for (size_t i = 0; i < slots.size(); i++)
+    pairs[i] = static_cast<pmt_pair*>(slots[i]->ref.get());
+}
+
+// A pmt_dict of root, with key associated with value
+static pmt_t
+dict_with(const pmt_t &root, size_t size, uint64_t serial,
+	  const pmt_t &key, const pmt_t &value)
+{
+  dict_slot e;
+  e.ref = cons(key, value);
+  e.serial = serial + 1;
+
+  bool replaced = false;
+  pmt_t r = dict_insert(static_cast<const pmt_dict_node*>(root.get()),
+			e, dict_hash(key.get()), 0, replaced);
+  return pmt_t(new pmt_dict(r, size + (replaced ? 0 : 1), e.serial));
+}
+
+// A pmt_dict of an a-list, its first entry for a key being the newest
+static pmt_t
+dict_from_alist(const pmt_t &alist)
+{
+  size_t n = length(alist);
+  pmt_t root(new pmt_dict_node());
+  size_t size = 0;
+
+  pmt_base *p = alist.get();
+  for (size_t i = 0; i < n; i++, p = static_cast<pmt_pair*>(p)->d_cdr.get()){
+    const pmt_t &item = static_cast<pmt_pair*>(p)->d_car;
+    if (!item->is_pair())
+      throw wrong_type("pmt_dict_add", alist);
+    pmt_base *key = static_cast<pmt_pair*>(item.get())->d_car.get();
+    uint32_t hash = dict_hash(key);
+    if (dict_find(static_cast<const pmt_dict_node*>(root.get()), key, hash))
+      continue;
+
+    dict_slot e;
+    e.ref = item;
+    e.serial = n - i;
+    bool replaced = false;
+    root = dict_insert(static_cast<const pmt_dict_node*>(root.get()), e, hash,
+		       0, replaced);
+    size++;
+  }
+  return pmt_t(new pmt_dict(root, size, n));
+}
 
 bool
 is_dict(const pmt_t &obj)
 {
-  return is_null(obj) || is_pair(obj);
+  return is_null(obj) || is_pair(obj) || obj->is_dict();
 }
 
 pmt_t
@@ -803,11 +1251,15 @@ make_dict()
 pmt_t
 dict_add(const pmt_t &dict, const pmt_t &key, const pmt_t &value)
 {
-  if (is_null(dict))
-    return acons(key, value, PMT_NIL);
+  pmt_t d = dict;
+  if (is_null(d))
+    d = pmt_t(new pmt_dict(pmt_t(new pmt_dict_node()), 0, 0));
+  else if (d->is_pair())
+    d = dict_from_alist(d);
 
-  if (dict_has_key(dict, key))
-    return acons(key, value, dict_delete(dict, key));
+  if (d->is_dict())
+    return dict_with(_dict(d)->d_root, _dict(d)->d_size, _dict(d)->d_serial,
+		     key, value);
 
   return acons(key, value, dict);
 }
@@ -815,6 +1267,17 @@ dict_add(const pmt_t &dict, const pmt_t &key, const pmt_t &value)
 pmt_t
 dict_delete(const pmt_t &dict, const pmt_t &key)
 {
+  if (dict->is_dict()){
+    pmt_dict *d = _dict(dict);
+    bool found = false;
+    pmt_t root = dict_remove(d->d_root, key.get(), dict_hash(key.get()), 0, found);
+    if (!found)
+      return dict;
+    if (d->d_size == 1)
+      return PMT_NIL;
+    return pmt_t(new pmt_dict(root, d->d_size - 1, d->d_serial));
+  }
+
   if (is_null(dict))
     return dict;
 
@@ -827,6 +1290,14 @@ dict_delete(const pmt_t &dict, const pmt_t &key)
 pmt_t
 dict_ref(const pmt_t &dict, const pmt_t &key, const pmt_t &not_found)
 {
+  if (dict->is_dict()){
+    const dict_slot *s = dict_find(static_cast<const pmt_dict_node*>(_dict(dict)->d_root.get()),
+				   key.get(), dict_hash(key.get()));
+    if (s)
+      return static_cast<pmt_pair*>(s->ref.get())->d_cdr;
+    return not_found;
+  }
+
   pmt_t	p = assv(key, dict);	// look for (key . value) pair
   if (is_pair(p))
     return cdr(p);
@@ -837,6 +1308,10 @@ dict_ref(const pmt_t &dict, const pmt_t &key, const pmt_t &not_found)
 bool
 dict_has_key(const pmt_t &dict, const pmt_t &key)
 {
+  if (dict->is_dict())
+    return dict_find(static_cast<const pmt_dict_node*>(_dict(dict)->d_root.get()),
+		     key.get(), dict_hash(key.get())) != 0;
+
   return is_pair(assv(key, dict));
 }
 
@@ -846,6 +1321,15 @@ dict_items(pmt_t dict)
   if (!is_dict(dict))
     throw wrong_type("pmt_dict_values", dict);
 
+  if (dict->is_dict()){
+    std::vector<pmt_pair*> pairs;
+    _dict(dict)->entries(pairs);
+    pmt_t items = PMT_NIL;
+    for (size_t i = pairs.size(); i > 0; i--)
+      items = cons(pmt_t(pairs[i-1]), items);
+    return items;
+  }
+
   return dict;		// equivalent to dict in the a-list case
 }
 
@@ -855,7 +1339,7 @@ dict_keys(pmt_t dict)
   if (!is_dict(dict))
     throw wrong_type("pmt_dict_keys", dict);
 
-  return map(car, dict);
+  return map(car, dict_items(dict));
 }
 
 pmt_t
@@ -864,7 +1348,7 @@ dict_values(pmt_t dict)
   if (!is_dict(dict))
     throw wrong_type("pmt_dict_keys", dict);
 
-  return map(cdr, dict);
+  return map(cdr, dict_items(dict));
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -1026,6 +1510,10 @@ equal(const pmt_t& x, const pmt_t& y)
   if (eqv(x, y))
     return true;
 
+  // a pmt_dict is equal to the a-list of its items
+  if ((x->is_dict() && is_dict(y)) || (y->is_dict() && is_dict(x)))
+    return equal(dict_items(x), dict_items(y));
+
   if (x->is_pair() && y->is_pair())
     return equal(car(x), car(y)) && equal(cdr(x), cdr(y));
 
@@ -1104,7 +1592,8 @@ length(const pmt_t& x)
     throw wrong_type("pmt_length", x);
   }
 
-  // FIXME dictionary length (number of entries)
+  if (x->is_dict())
+    return _dict(x)->d_size;
 
   throw wrong_type("pmt_length", x);
 }
@@ -1149,6 +1638,8 @@ assv_raw(pmt_base *obj, pmt_base *alist)
 pmt_t
 assv(pmt_t obj, pmt_t alist)
 {
+  if (alist->is_dict())
+    alist = dict_items(alist);
   return assv_raw(obj.get(), alist.get());
 }
 
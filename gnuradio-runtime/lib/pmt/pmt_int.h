@@ -32,7 +32,7 @@
  * See pmt.h for the public interface
  */
 
-#define PMT_LOCAL_ALLOCATOR 0		// define to 0 or 1
+#define PMT_LOCAL_ALLOCATOR 1		// define to 0 or 1
 namespace pmt {
 
 class PMT_API pmt_base : boost::noncopyable {
@@ -100,9 +100,9 @@ public:
   //~pmt_symbol(){}
 
   bool is_symbol() const { return true; }
-  const std::string name() { return d_name; }
+  const std::string &name() const { return d_name; }
 
-  pmt_t next() { return d_next; }		// symbol table link
+  const pmt_t &next() const { return d_next; }	// symbol table link
   void set_next(pmt_t next) { d_next = next; }
 };
 
@@ -198,7 +198,7 @@ public:
   void  fill(pmt_t fill);
   size_t length() const { return d_v.size(); }
 
-  pmt_t _ref(size_t k) const { return d_v[k]; }
+  const pmt_t &_ref(size_t k) const { return d_v[k]; }
 };
 
 class pmt_tuple : public pmt_base
@@ -213,10 +213,26 @@ public:
   pmt_t ref(size_t k) const;
   size_t length() const { return d_v.size(); }
 
-  pmt_t _ref(size_t k) const { return d_v[k]; }
+  const pmt_t &_ref(size_t k) const { return d_v[k]; }
   void _set(size_t k, pmt_t v) { d_v[k] = v; }
 };
 
+class pmt_dict : public pmt_base
+{
+public:
+  pmt_t		d_root;		// trie of (key . value) pairs
+  size_t	d_size;		// number of entries
+  uint64_t	d_serial;	// serial number of the newest entry
+
+  pmt_dict(const pmt_t &root, size_t size, uint64_t serial);
+  //~pmt_dict(){}
+
+  bool is_dict() const { return true; }
+
+  //! The (key . value) pairs, newest first, the a-list order
+  void entries(std::vector<pmt_pair*> &pairs) const;
+};
+
 class pmt_any : public pmt_base
 {
   boost::any	d_any;
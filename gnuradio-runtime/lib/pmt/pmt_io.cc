@@ -105,9 +105,7 @@ write(pmt_t obj, std::ostream &port)
     port << ")";
   }
   else if (is_dict(obj)){
-    // FIXME
-    // port << "#<dict " << obj << ">";
-    port << "#<dict>";
+    write(dict_items(obj), port);	// as the a-list
   }
   else if (is_uniform_vector(obj)){
     // FIXME
@@ -1,6 +1,6 @@
 /* -*- c++ -*- */
 /*
- * Copyright 2007,2009 Free Software Foundation, Inc.
+ * Copyright 2007,2009,2014 Free Software Foundation, Inc.
  *
  * This file is part of GNU Radio
  *
@@ -24,9 +24,16 @@
 #endif
 
 #include <pmt/pmt_pool.h>
+#include <boost/thread/tss.hpp>
 #include <algorithm>
 #include <stdint.h>
 
+#if defined(HAVE___THREAD)
+#define PMT_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define PMT_THREAD_LOCAL __declspec(thread)
+#endif
+
 namespace pmt {
 
 static inline size_t
@@ -35,42 +42,105 @@ ROUNDUP(size_t x, size_t stride)
   return ((((x) + (stride) - 1)/(stride)) * (stride));
 }
 
+// ----------------------------------------------------------------
+// per-thread free lists
+//
+// A pool with a slot here keeps a free list per thread, of up to
+// 2 * CACHE_BATCH items, chained through their first word like the
+// shared list.  Slots are handed out once and never reused.
+// ----------------------------------------------------------------
+
+static const int MAX_CACHED_POOLS = 8;
+static const size_t CACHE_BATCH = 32;
+
+static pmt_pool *s_cached_pools[MAX_CACHED_POOLS];
+
+static boost::mutex &
+cached_pools_mutex()
+{
+  static boost::mutex m;
+  return m;
+}
+
+#ifdef PMT_THREAD_LOCAL
+
+static int s_n_cached_pools;
+
+struct thread_cache {
+  void	       *list;
+  size_t	n;
+};
+
+// Once the owner has flushed a thread's lists on exit, items freed by
+// later TSS destructors go straight back to the shared lists
+enum { CACHE_UNUSED, CACHE_OWNED, CACHE_GONE };
+
+static PMT_THREAD_LOCAL thread_cache t_cache[MAX_CACHED_POOLS];
+static PMT_THREAD_LOCAL int t_cache_state;
+
+// Its only instance per thread flushes the thread's lists on exit
+struct thread_cache_owner {
+  ~thread_cache_owner()
+  {
+    t_cache_state = CACHE_GONE;
+    pmt_pool::flush_thread_cache();
+  }
+};
+
+static boost::thread_specific_ptr<thread_cache_owner> &
+thread_cache_owners()
+{
+  static boost::thread_specific_ptr<thread_cache_owner> owners;
+  return owners;
+}
+
+// Registers the exit flush on the thread's first malloc or free
+static inline bool
+thread_cache_usable()
+{
+  if (t_cache_state == CACHE_UNUSED){
+    t_cache_state = CACHE_OWNED;
+    thread_cache_owners().reset(new thread_cache_owner());
+  }
+  return t_cache_state == CACHE_OWNED;
+}
+
+#endif /* PMT_THREAD_LOCAL */
+
 pmt_pool::pmt_pool(size_t itemsize, size_t alignment,
 		   size_t allocation_size, size_t max_items)
   : d_itemsize(ROUNDUP(itemsize, alignment)),
     d_alignment(alignment),
     d_allocation_size(std::max(allocation_size, 16 * itemsize)),
     d_max_items(max_items), d_n_items(0),
-    d_freelist(0)
+    d_freelist(0), d_cache(-1)
 {
+#ifdef PMT_THREAD_LOCAL
+  if (d_max_items == 0){
+    boost::mutex::scoped_lock guard(cached_pools_mutex());
+    if (s_n_cached_pools < MAX_CACHED_POOLS){
+      d_cache = s_n_cached_pools++;
+      s_cached_pools[d_cache] = this;
+    }
+  }
+#endif
 }
 
 pmt_pool::~pmt_pool()
 {
+  if (d_cache >= 0){
+    boost::mutex::scoped_lock guard(cached_pools_mutex());
+    s_cached_pools[d_cache] = 0;
+  }
   for (unsigned int i = 0; i < d_allocations.size(); i++){
     delete [] d_allocations[i];
   }
 }
 
-void *
-pmt_pool::malloc()
+// Links a new chunk of items onto the free list.  Called locked.
+void
+pmt_pool::grow()
 {
-  scoped_lock guard(d_mutex);
-  item *p;
-
-  if (d_max_items != 0){
-    while (d_n_items >= d_max_items)
-      d_cond.wait(guard);
-  }
-
-  if (d_freelist){	// got something?
-    p = d_freelist;
-    d_freelist = p->d_next;
-    d_n_items++;
-    return p;
-  }
-
-  // allocate a new chunk
   char *alloc = new char[d_allocation_size + d_alignment - 1];
   d_allocations.push_back(alloc);
 
@@ -80,14 +150,40 @@ pmt_pool::malloc()
   size_t n = (end - start) / d_itemsize;
 
   // link the new items onto the free list.
-  p = (item *) start;
+  item *p = (item *) start;
   for (size_t i = 0; i < n; i++){
     p->d_next = d_freelist;
     d_freelist = p;
     p = (item *)((char *) p + d_itemsize);
   }
+}
+
+void *
+pmt_pool::malloc()
+{
+#ifdef PMT_THREAD_LOCAL
+  if (d_cache >= 0 && thread_cache_usable()){
+    thread_cache &c = t_cache[d_cache];
+    if (!c.list)
+      refill_cache();
+    item *p = (item *) c.list;
+    c.list = p->d_next;
+    c.n--;
+    return p;
+  }
+#endif
+
+  scoped_lock guard(d_mutex);
+  item *p;
+
+  if (d_max_items != 0){
+    while (d_n_items >= d_max_items)
+      d_cond.wait(guard);
+  }
+
+  if (!d_freelist)
+    grow();
 
-  // now return the first one
   p = d_freelist;
   d_freelist = p->d_next;
   d_n_items++;
@@ -100,6 +196,18 @@ pmt_pool::free(void *foo)
   if (!foo)
     return;
 
+#ifdef PMT_THREAD_LOCAL
+  if (d_cache >= 0 && thread_cache_usable()){
+    thread_cache &c = t_cache[d_cache];
+    item *p = (item *) foo;
+    p->d_next = (item *) c.list;
+    c.list = p;
+    if (++c.n >= 2 * CACHE_BATCH)
+      drain_cache(CACHE_BATCH);
+    return;
+  }
+#endif
+
   scoped_lock guard(d_mutex);
 
   item *p = (item *) foo;
@@ -110,4 +218,73 @@ pmt_pool::free(void *foo)
     d_cond.notify_one();
 }
 
+#ifdef PMT_THREAD_LOCAL
+
+// Moves CACHE_BATCH items from the shared list to the thread's list
+void
+pmt_pool::refill_cache()
+{
+  thread_cache &c = t_cache[d_cache];
+  scoped_lock guard(d_mutex);
+  for (size_t i = 0; i < CACHE_BATCH; i++){
+    if (!d_freelist)
+      grow();
+    item *p = d_freelist;
+    d_freelist = p->d_next;
+    p->d_next = (item *) c.list;
+    c.list = p;
+  }
+  c.n += CACHE_BATCH;
+  d_n_items += CACHE_BATCH;
+}
+
+// Moves n items from the thread's list back to the shared list
+void
+pmt_pool::drain_cache(size_t n)
+{
+  thread_cache &c = t_cache[d_cache];
+  item *first = (item *) c.list;
+  item *last = first;
+  for (size_t i = 1; i < n; i++)
+    last = last->d_next;
+  c.list = last->d_next;
+  c.n -= n;
+
+  scoped_lock guard(d_mutex);
+  last->d_next = d_freelist;
+  d_freelist = first;
+  d_n_items -= n;
+}
+
+void
+pmt_pool::flush_thread_cache()
+{
+  boost::mutex::scoped_lock guard(cached_pools_mutex());
+  for (int i = 0; i < s_n_cached_pools; i++){
+    if (s_cached_pools[i] && t_cache[i].n > 0)
+      s_cached_pools[i]->drain_cache(t_cache[i].n);
+    t_cache[i].list = 0;
+    t_cache[i].n = 0;
+  }
+}
+
+#else
+
+void
+pmt_pool::refill_cache()
+{
+}
+
+void
+pmt_pool::drain_cache(size_t n)
+{
+}
+
+void
+pmt_pool::flush_thread_cache()
+{
+}
+
+#endif /* PMT_THREAD_LOCAL */
+
 } /* namespace pmt */
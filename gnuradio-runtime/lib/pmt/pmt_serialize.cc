@@ -24,6 +24,7 @@
 #endif
 
 #include <vector>
+#include <string.h>
 #include <pmt/pmt.h>
 #include "pmt_int.h"
 #include "pmt/pmt_serial_tags.h"
@@ -33,65 +34,85 @@ namespace pmt {
 static pmt_t parse_pair(std::streambuf &sb);
 
 // ----------------------------------------------------------------
-// output primitives
+// buffer primitives
+//
+// The same big-endian encodings, straight to and from memory.  The
+// callers make sure of the space for a whole object or vector first.
 // ----------------------------------------------------------------
 
-static bool
-serialize_untagged_u8(unsigned int i, std::streambuf &sb)
+static inline uint8_t *
+put_u8(uint8_t *p, unsigned int i)
 {
-  return sb.sputc((i >> 0) & 0xff) != std::streambuf::traits_type::eof();
+  p[0] = i & 0xff;
+  return p + 1;
 }
 
-// always writes big-endian
-static bool
-serialize_untagged_u16(unsigned int i, std::streambuf &sb)
+static inline uint8_t *
+put_u16(uint8_t *p, unsigned int i)
 {
-  sb.sputc((i >> 8) & 0xff);
-  return sb.sputc((i >> 0) & 0xff) != std::streambuf::traits_type::eof();
+  p[0] = (i >> 8) & 0xff;
+  p[1] = (i >> 0) & 0xff;
+  return p + 2;
 }
 
-// always writes big-endian
-static bool
-serialize_untagged_u32(unsigned int i, std::streambuf &sb)
+static inline uint8_t *
+put_u32(uint8_t *p, uint32_t i)
 {
-  sb.sputc((i >> 24) & 0xff);
-  sb.sputc((i >> 16) & 0xff);
-  sb.sputc((i >>  8) & 0xff);
-  return sb.sputc((i >> 0) & 0xff) != std::streambuf::traits_type::eof();
+  p[0] = (i >> 24) & 0xff;
+  p[1] = (i >> 16) & 0xff;
+  p[2] = (i >>  8) & 0xff;
+  p[3] = (i >>  0) & 0xff;
+  return p + 4;
 }
 
-static bool
-serialize_untagged_f64(double i, std::streambuf &sb)
+static inline uint8_t *
+put_u64(uint8_t *p, uint64_t i)
 {
- typedef union {
-	double id;
-	uint64_t ii;
-	} iu_t;
-  iu_t iu;
-  iu.id = i;
-  sb.sputc((iu.ii >> 56) & 0xff);
-  sb.sputc((iu.ii >> 48) & 0xff);
-  sb.sputc((iu.ii >> 40) & 0xff);
-  sb.sputc((iu.ii >> 32) & 0xff);
-  sb.sputc((iu.ii >> 24) & 0xff);
-  sb.sputc((iu.ii >> 16) & 0xff);
-  sb.sputc((iu.ii >>  8) & 0xff);
-  return sb.sputc((iu.ii >>  0) & 0xff) != std::streambuf::traits_type::eof();
+  p[0] = (i >> 56) & 0xff;
+  p[1] = (i >> 48) & 0xff;
+  p[2] = (i >> 40) & 0xff;
+  p[3] = (i >> 32) & 0xff;
+  p[4] = (i >> 24) & 0xff;
+  p[5] = (i >> 16) & 0xff;
+  p[6] = (i >>  8) & 0xff;
+  p[7] = (i >>  0) & 0xff;
+  return p + 8;
+}
+
+static inline uint8_t *
+put_f64(uint8_t *p, double d)
+{
+  uint64_t i;
+  memcpy(&i, &d, sizeof(i));
+  return put_u64(p, i);
 }
 
+static inline uint16_t
+get_u16(const uint8_t *p)
+{
+  return (p[0] << 8) | p[1];
+}
 
-// always writes big-endian
-static bool
-serialize_untagged_u64(uint64_t i, std::streambuf &sb)
+static inline uint32_t
+get_u32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+    ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint64_t
+get_u64(const uint8_t *p)
+{
+  return ((uint64_t)get_u32(p) << 32) | get_u32(p + 4);
+}
+
+static inline double
+get_f64(const uint8_t *p)
 {
-  sb.sputc((i >> 56) & 0xff);
-  sb.sputc((i >> 48) & 0xff);
-  sb.sputc((i >> 40) & 0xff);
-  sb.sputc((i >> 32) & 0xff);
-  sb.sputc((i >> 24) & 0xff);
-  sb.sputc((i >> 16) & 0xff);
-  sb.sputc((i >>  8) & 0xff);
-  return sb.sputc((i >> 0) & 0xff) != std::streambuf::traits_type::eof();
+  uint64_t i = get_u64(p);
+  double d;
+  memcpy(&d, &i, sizeof(d));
+  return d;
 }
 
 // ----------------------------------------------------------------
@@ -234,286 +255,413 @@ deserialize_tuple(pmt_t *tuple, std::streambuf &sb)
 }
 
 
-/*
- * Write portable byte-serial representation of \p obj to \p sb
- *
- * N.B., Circular structures cause infinite recursion.
- */
-bool
-serialize(pmt_t obj, std::streambuf &sb)
+// ----------------------------------------------------------------
+// uniform vectors
+// ----------------------------------------------------------------
+
+// Subtype of a uniform vector and the bytes per element on the wire,
+// where f32 elements are widened to f64
+static uint8_t
+uniform_subtype(const pmt_base *x, size_t &width)
 {
-  bool ok = true;
+  if(x->is_u8vector())  { width = 1;  return UVI_U8; }
+  if(x->is_s8vector())  { width = 1;  return UVI_S8; }
+  if(x->is_u16vector()) { width = 2;  return UVI_U16; }
+  if(x->is_s16vector()) { width = 2;  return UVI_S16; }
+  if(x->is_u32vector()) { width = 4;  return UVI_U32; }
+  if(x->is_s32vector()) { width = 4;  return UVI_S32; }
+  if(x->is_u64vector()) { width = 8;  return UVI_U64; }
+  if(x->is_s64vector()) { width = 8;  return UVI_S64; }
+  if(x->is_f32vector()) { width = 8;  return UVI_F32; }
+  if(x->is_f64vector()) { width = 8;  return UVI_F64; }
+  if(x->is_c32vector()) { width = 16; return UVI_C32; }
+  if(x->is_c64vector()) { width = 16; return UVI_C64; }
+  throw notimplemented("pmt::serialize (?)", pmt_t(const_cast<pmt_base*>(x)));
+}
 
- tail_recursion:
+static size_t
+uniform_width(uint8_t utag)
+{
+  switch(utag) {
+  case UVI_U8:  case UVI_S8:  return 1;
+  case UVI_U16: case UVI_S16: return 2;
+  case UVI_U32: case UVI_S32: return 4;
+  case UVI_U64: case UVI_S64: case UVI_F32: case UVI_F64: return 8;
+  case UVI_C32: case UVI_C64: return 16;
+  default:
+    throw exception("pmt::deserialize: malformed input stream, tag value = ",
+		    from_long(utag));
+  }
+}
 
-  if(is_bool(obj)) {
-    if(eq(obj, PMT_T))
-      return serialize_untagged_u8(PST_TRUE, sb);
-    else
-      return serialize_untagged_u8(PST_FALSE, sb);
+// Writes the elements of a uniform vector in one pass
+static uint8_t *
+put_uniform(uint8_t *p, const pmt_base *x, uint8_t utag)
+{
+  pmt_uniform_vector *v = (pmt_uniform_vector*)x;
+  size_t nbytes;
+  const void *e = v->uniform_elements(nbytes);
+  size_t n = v->length();
+
+  switch(utag) {
+  case UVI_U8:
+  case UVI_S8:
+    if(n > 0)
+      memcpy(p, e, n);
+    return p + n;
+  case UVI_U16:
+  case UVI_S16:
+    for(size_t i = 0; i < n; i++)
+      p = put_u16(p, ((const uint16_t*)e)[i]);
+    return p;
+  case UVI_U32:
+  case UVI_S32:
+    for(size_t i = 0; i < n; i++)
+      p = put_u32(p, ((const uint32_t*)e)[i]);
+    return p;
+  case UVI_U64:
+  case UVI_S64:
+    for(size_t i = 0; i < n; i++)
+      p = put_u64(p, ((const uint64_t*)e)[i]);
+    return p;
+  case UVI_F32:
+    for(size_t i = 0; i < n; i++)
+      p = put_f64(p, ((const float*)e)[i]);
+    return p;
+  case UVI_C32:
+    for(size_t i = 0; i < 2 * n; i++)
+      p = put_f64(p, ((const float*)e)[i]);
+    return p;
+  case UVI_F64:
+    for(size_t i = 0; i < n; i++)
+      p = put_f64(p, ((const double*)e)[i]);
+    return p;
+  default:	// UVI_C64
+    for(size_t i = 0; i < 2 * n; i++)
+      p = put_f64(p, ((const double*)e)[i]);
+    return p;
   }
+}
 
-  if(is_null(obj))
-    return serialize_untagged_u8(PST_NULL, sb);
+// Makes a uniform vector of n elements from their wire form at p
+static pmt_t
+get_uniform(uint8_t utag, size_t n, const uint8_t *p)
+{
+  size_t len;
+  switch(utag) {
+  case UVI_U8:
+    return init_u8vector(n, p);
+  case UVI_S8:
+    return init_s8vector(n, (const int8_t*)p);
+  case UVI_U16:
+    {
+      pmt_t vec = make_u16vector(n, 0);
+      uint16_t *v = u16vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 2)
+	v[i] = get_u16(p);
+      return vec;
+    }
+  case UVI_S16:
+    {
+      pmt_t vec = make_s16vector(n, 0);
+      int16_t *v = s16vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 2)
+	v[i] = get_u16(p);
+      return vec;
+    }
+  case UVI_U32:
+    {
+      pmt_t vec = make_u32vector(n, 0);
+      uint32_t *v = u32vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 4)
+	v[i] = get_u32(p);
+      return vec;
+    }
+  case UVI_S32:
+    {
+      pmt_t vec = make_s32vector(n, 0);
+      int32_t *v = s32vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 4)
+	v[i] = get_u32(p);
+      return vec;
+    }
+  case UVI_U64:
+    {
+      pmt_t vec = make_u64vector(n, 0);
+      uint64_t *v = u64vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 8)
+	v[i] = get_u64(p);
+      return vec;
+    }
+  case UVI_S64:
+    {
+      pmt_t vec = make_s64vector(n, 0);
+      int64_t *v = s64vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 8)
+	v[i] = get_u64(p);
+      return vec;
+    }
+  case UVI_F32:
+    {
+      pmt_t vec = make_f32vector(n, 0);
+      float *v = f32vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 8)
+	v[i] = static_cast<float>(get_f64(p));
+      return vec;
+    }
+  case UVI_F64:
+    {
+      pmt_t vec = make_f64vector(n, 0);
+      double *v = f64vector_writable_elements(vec, len);
+      for(size_t i = 0; i < n; i++, p += 8)
+	v[i] = get_f64(p);
+      return vec;
+    }
+  case UVI_C32:
+    {
+      pmt_t vec = make_c32vector(n, 0);
+      float *v = (float*)c32vector_writable_elements(vec, len);
+      for(size_t i = 0; i < 2 * n; i++, p += 8)
+	v[i] = static_cast<float>(get_f64(p));
+      return vec;
+    }
+  default:	// UVI_C64
+    {
+      pmt_t vec = make_c64vector(n, 0);
+      double *v = (double*)c64vector_writable_elements(vec, len);
+      for(size_t i = 0; i < 2 * n; i++, p += 8)
+	v[i] = get_f64(p);
+      return vec;
+    }
+  }
+}
 
-  if(is_symbol(obj)) {
-    const std::string s = symbol_to_string(obj);
-    size_t len = s.size();
-    ok = serialize_untagged_u8(PST_SYMBOL, sb);
-    ok &= serialize_untagged_u16(len, sb);
-    for(size_t i = 0; i < len; i++)
-      ok &= serialize_untagged_u8(s[i], sb);
-    return ok;
+static long
+int32_value(const pmt_base *x)
+{
+  long i = static_cast<const pmt_integer*>(x)->d_value;
+  if(sizeof(long) > 4) {
+    if(i < -2147483647 || i > 2147483647)
+      throw notimplemented("pmt::serialize (64-bit integers)",
+			   pmt_t(const_cast<pmt_base*>(x)));
   }
+  return i;
+}
 
-  if(is_pair(obj)) {
-    ok = serialize_untagged_u8(PST_PAIR, sb);
-    ok &= serialize(car(obj), sb);
-    if(!ok)
-      return false;
-    obj = cdr(obj);
+// ----------------------------------------------------------------
+// serialization
+//
+// These walk the object through pmt_base pointers, which the object
+// itself keeps alive, to stay clear of the reference counts.
+// ----------------------------------------------------------------
+
+static size_t
+serialized_size(const pmt_base *x)
+{
+  size_t n = 0;
+
+ tail_recursion:
+
+  if(x->is_bool() || x->is_null())
+    return n + 1;
+
+  if(x->is_symbol())
+    return n + 3 + static_cast<const pmt_symbol*>(x)->name().size();
+
+  if(x->is_pair()) {
+    const pmt_pair *pair = static_cast<const pmt_pair*>(x);
+    n += 1 + serialized_size(pair->d_car.get());
+    x = pair->d_cdr.get();
     goto tail_recursion;
   }
 
-  if(is_number(obj)) {
-    
-    if(is_uint64(obj)) {
-        uint64_t i = to_uint64(obj);
-        ok = serialize_untagged_u8(PST_UINT64, sb);
-        ok &= serialize_untagged_u64(i, sb);
-        return ok;
-    }
-    else { 
-      if(is_integer(obj)) {
-	long i = to_long(obj);
-	if(sizeof(long) > 4) {
-	  if(i < -2147483647 || i > 2147483647)
-	    throw notimplemented("pmt::serialize (64-bit integers)", obj);
-	}
-	ok = serialize_untagged_u8(PST_INT32, sb);
-	ok &= serialize_untagged_u32(i, sb);
-	return ok;
-      }
+  if(x->is_number()) {
+    if(x->is_uint64())
+      return n + 9;
+    if(x->is_integer()) {
+      int32_value(x);
+      return n + 5;
     }
+    if(x->is_real())
+      return n + 9;
+    if(x->is_complex())
+      return n + 17;
+  }
 
-    if(is_real(obj)) {
-      float i = to_double(obj);
-      ok = serialize_untagged_u8(PST_DOUBLE, sb);
-      ok &= serialize_untagged_f64(i, sb);
-      return ok;
-    }
+  if(x->is_vector()) {
+    const pmt_vector *vec = static_cast<const pmt_vector*>(x);
+    size_t vec_len = vec->length();
+    n += 5;
+    for(size_t i = 0; i < vec_len; i++)
+      n += serialized_size(vec->_ref(i).get());
+    return n;
+  }
 
-    if(is_complex(obj)) {
-      std::complex<double> i = to_complex(obj);
-      ok = serialize_untagged_u8(PST_COMPLEX, sb);
-      ok &= serialize_untagged_f64(i.real(), sb);
-      ok &= serialize_untagged_f64(i.imag(), sb);
-      return ok;
-    }
+  if(x->is_uniform_vector()) {
+    size_t width;
+    uniform_subtype(x, width);
+    return n + 8 + static_cast<const pmt_uniform_vector*>(x)->length() * width;
   }
 
-  if(is_vector(obj)) {
-    size_t vec_len = pmt::length(obj);
-    ok = serialize_untagged_u8(PST_VECTOR, sb);
-    ok &= serialize_untagged_u32(vec_len, sb);
-    for(size_t i=0; i<vec_len; i++) {
-      ok &= serialize(vector_ref(obj, i), sb);
-    }
-    return ok;
+  // a pmt_dict goes as the a-list of its items
+  if(x->is_dict()) {
+    std::vector<pmt_pair*> pairs;
+    static_cast<const pmt_dict*>(x)->entries(pairs);
+    for(size_t i = 0; i < pairs.size(); i++)
+      n += 1 + serialized_size(pairs[i]);
+    return n + 1;
   }
 
-  if(is_uniform_vector(obj)) {
-    size_t npad = 1;
-    size_t vec_len = pmt::length(obj);
-
-    if(is_u8vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_U8, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u8(u8vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+  if(x->is_tuple()) {
+    const pmt_tuple *tuple = static_cast<const pmt_tuple*>(x);
+    size_t tuple_len = tuple->length();
+    n += 5;
+    for(size_t i = 0; i < tuple_len; i++)
+      n += serialized_size(tuple->_ref(i).get());
+    return n;
+  }
 
-    if(is_s8vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_S8, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u8(s8vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+  throw notimplemented("pmt::serialize (?)", pmt_t(const_cast<pmt_base*>(x)));
+}
 
-    if(is_u16vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_U16, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u16(u16vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+/*
+ * Writes the byte-serial representation of \p x at \p p, which has
+ * room for serialized_size(x) bytes, and returns the end of it.
+ *
+ * N.B., Circular structures cause infinite recursion.
+ */
+static uint8_t *
+serialize_to(const pmt_base *x, uint8_t *p)
+{
+ tail_recursion:
 
-    if(is_s16vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_S16, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u16(s16vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+  if(x->is_bool())
+    return put_u8(p, x == PMT_T.get() ? PST_TRUE : PST_FALSE);
 
-    if(is_u32vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_U32, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u32(u32vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+  if(x->is_null())
+    return put_u8(p, PST_NULL);
 
-    if(is_s32vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_S32, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u32(s32vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+  if(x->is_symbol()) {
+    const std::string &s = static_cast<const pmt_symbol*>(x)->name();
+    p = put_u8(p, PST_SYMBOL);
+    p = put_u16(p, s.size());
+    if(!s.empty())
+      memcpy(p, s.data(), s.size());
+    return p + s.size();
+  }
 
-    if(is_u64vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_U64, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u64(u64vector_ref(obj, i), sb);
-      }
-      return ok;
-    }
+  if(x->is_pair()) {
+    const pmt_pair *pair = static_cast<const pmt_pair*>(x);
+    p = put_u8(p, PST_PAIR);
+    p = serialize_to(pair->d_car.get(), p);
+    x = pair->d_cdr.get();
+    goto tail_recursion;
+  }
 
-    if(is_s64vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_S64, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_u64(s64vector_ref(obj, i), sb);
-      }
-      return ok;
+  if(x->is_number()) {
+    if(x->is_uint64()) {
+      p = put_u8(p, PST_UINT64);
+      return put_u64(p, static_cast<const pmt_uint64*>(x)->d_value);
     }
-
-    if(is_f32vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_F32, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_f64(f32vector_ref(obj, i), sb);
-      }
-      return ok;
+    if(x->is_integer()) {
+      p = put_u8(p, PST_INT32);
+      return put_u32(p, int32_value(x));
     }
-
-    if(is_f64vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_F64, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	ok &= serialize_untagged_f64(f64vector_ref(obj, i), sb);
-      }
-      return ok;
+    if(x->is_real()) {
+      // Goes through a float, as it always has
+      float i = static_cast<const pmt_real*>(x)->d_value;
+      p = put_u8(p, PST_DOUBLE);
+      return put_f64(p, i);
     }
-
-    if(is_c32vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_C32, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	std::complex<float> c = c32vector_ref(obj, i);
-	ok &= serialize_untagged_f64(c.real(), sb);
-	ok &= serialize_untagged_f64(c.imag(), sb);
-      }
-      return ok;
+    if(x->is_complex()) {
+      std::complex<double> i = static_cast<const pmt_complex*>(x)->d_value;
+      p = put_u8(p, PST_COMPLEX);
+      p = put_f64(p, i.real());
+      return put_f64(p, i.imag());
     }
+  }
 
-    if(is_c64vector(obj)) {
-      ok = serialize_untagged_u8(PST_UNIFORM_VECTOR, sb);
-      ok &= serialize_untagged_u8(UVI_C64, sb);
-      ok &= serialize_untagged_u32(vec_len, sb);
-      ok &= serialize_untagged_u8(npad, sb);
-      for(size_t i=0; i<npad; i++) {
-	ok &= serialize_untagged_u8(0, sb);
-      }
-      for(size_t i=0; i<vec_len; i++) {
-	std::complex<double> c = c64vector_ref(obj, i);
-	ok &= serialize_untagged_f64(c.real(), sb);
-	ok &= serialize_untagged_f64(c.imag(), sb);
-      }
-      return ok;
-    }
+  if(x->is_vector()) {
+    const pmt_vector *vec = static_cast<const pmt_vector*>(x);
+    size_t vec_len = vec->length();
+    p = put_u8(p, PST_VECTOR);
+    p = put_u32(p, vec_len);
+    for(size_t i = 0; i < vec_len; i++)
+      p = serialize_to(vec->_ref(i).get(), p);
+    return p;
   }
 
-  if (is_dict(obj))
-    throw notimplemented("pmt::serialize (dict)", obj);
+  if(x->is_uniform_vector()) {
+    size_t width;
+    uint8_t utag = uniform_subtype(x, width);
+    p = put_u8(p, PST_UNIFORM_VECTOR);
+    p = put_u8(p, utag);
+    p = put_u32(p, static_cast<const pmt_uniform_vector*>(x)->length());
+    p = put_u8(p, 1);		// npad
+    p = put_u8(p, 0);
+    return put_uniform(p, x, utag);
+  }
 
-  if (is_tuple(obj)){
-    size_t tuple_len = pmt::length(obj);
-    ok = serialize_untagged_u8(PST_TUPLE, sb);
-    ok &= serialize_untagged_u32(tuple_len, sb);
-    for(size_t i=0; i<tuple_len; i++){
-        ok &= serialize(tuple_ref(obj, i), sb);
+  if(x->is_dict()) {
+    std::vector<pmt_pair*> pairs;
+    static_cast<const pmt_dict*>(x)->entries(pairs);
+    for(size_t i = 0; i < pairs.size(); i++) {
+      p = put_u8(p, PST_PAIR);
+      p = serialize_to(pairs[i], p);
     }
-    return ok;
+    return put_u8(p, PST_NULL);
+  }
+
+  if(x->is_tuple()) {
+    const pmt_tuple *tuple = static_cast<const pmt_tuple*>(x);
+    size_t tuple_len = tuple->length();
+    p = put_u8(p, PST_TUPLE);
+    p = put_u32(p, tuple_len);
+    for(size_t i = 0; i < tuple_len; i++)
+      p = serialize_to(tuple->_ref(i).get(), p);
+    return p;
+  }
+
+  throw notimplemented("pmt::serialize (?)", pmt_t(const_cast<pmt_base*>(x)));
+}
+
+/*
+ * Number of bytes in the byte-serial representation of \p obj
+ */
+size_t
+serialized_size(pmt_t obj)
+{
+  return serialized_size(obj.get());
+}
+
+/*
+ * Write portable byte-serial representation of \p obj to \p sb
+ *
+ * The representation is built in memory and written with one call.
+ */
+bool
+serialize(pmt_t obj, std::streambuf &sb)
+{
+  size_t len = serialized_size(obj.get());
+  uint8_t local[256];
+  std::vector<uint8_t> heap;
+  uint8_t *buf = local;
+  if(len > sizeof(local)) {
+    heap.resize(len);
+    buf = &heap[0];
   }
-  //throw pmt_notimplemented("pmt::serialize (tuple)", obj);
+  serialize_to(obj.get(), buf);
+  return sb.sputn((const char*)buf, len) == (std::streamsize)len;
+}
 
-  throw notimplemented("pmt::serialize (?)", obj);
+size_t
+serialize_buf(pmt_t obj, void *buf, size_t len)
+{
+  size_t n = serialized_size(obj.get());
+  if(n > len)
+    return 0;
+  serialize_to(obj.get(), (uint8_t*)buf);
+  return n;
 }
 
 /*
@@ -619,129 +767,13 @@ deserialize(std::streambuf &sb)
       for(size_t i = 0; i < npad; i++)
 	deserialize_untagged_u8(&u8, sb);
 
-      switch(utag) {
-      case(UVI_U8):
-	{
-	  pmt_t vec = make_u8vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u8(&u8, sb);
-	    u8vector_set(vec, i, u8);
-	  }
-	  return vec;
-	}
-      case(UVI_S8):
-	{
-	  pmt_t vec = make_s8vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u8(&u8, sb);
-	    s8vector_set(vec, i, u8);
-	  }
-	  return vec;
-	}
-      case(UVI_U16):
-	{
-	  pmt_t vec = make_u16vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u16(&u16, sb);
-	    u16vector_set(vec, i, u16);
-	  }
-	  return vec;
-	}
-      case(UVI_S16):
-	{
-	  pmt_t vec = make_s16vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u16(&u16, sb);
-	    s16vector_set(vec, i, u16);
-	  }
-	  return vec;
-	}
-      case(UVI_U32):
-	{
-	  pmt_t vec = make_u32vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u32(&u32, sb);
-	    u32vector_set(vec, i, u32);
-	  }
-	  return vec;
-	}
-      case(UVI_S32):
-	{
-	  pmt_t vec = make_s32vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u32(&u32, sb);
-	    s32vector_set(vec, i, u32);
-	  }
-	  return vec;
-	}
-      case(UVI_U64):
-	{
-	  pmt_t vec = make_u64vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u64(&u64, sb);
-	    u64vector_set(vec, i, u64);
-	  }
-	  return vec;
-	}
-      case(UVI_S64):
-	{
-	  pmt_t vec = make_s64vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_u64(&u64, sb);
-	    s64vector_set(vec, i, u64);
-	  }
-	  return vec;
-	}
-      case(UVI_F32):
-	{
-	  pmt_t vec = make_f32vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_f64(&f64, sb);
-	    f32vector_set(vec, i, static_cast<float>(f64));
-	  }
-	  return vec;
-	}
-      case(UVI_F64):
-	{
-	  pmt_t vec = make_f64vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    deserialize_untagged_f64(&f64, sb);
-	    f64vector_set(vec, i, f64);
-	  }
-	  return vec;
-	}
-      case(UVI_C32):
-	{
-	  pmt_t vec = make_c32vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    float re, im;
-	    deserialize_untagged_f64(&f64, sb);
-	    re = static_cast<float>(f64);
-	    deserialize_untagged_f64(&f64, sb);
-	    im = static_cast<float>(f64);
-	    c32vector_set(vec, i, std::complex<float>(re, im));
-	  }
-	  return vec;
-	}
-
-      case(UVI_C64):
-	{
-	  pmt_t vec = make_c64vector(nitems, 0);
-	  for(uint32_t i=0; i<nitems; i++) {
-	    double re, im;
-	    deserialize_untagged_f64(&f64, sb);
-	    re = f64;
-	    deserialize_untagged_f64(&f64, sb);
-	    im = f64;
-	    c64vector_set(vec, i, std::complex<double>(re, im));
-	  }
-	  return vec;
-	}
-
-      default:
-	throw exception("pmt::deserialize: malformed input stream, tag value = ",
-			from_long(tag));
-      }
+      // Read all the elements at once
+      size_t nbytes = (size_t)nitems * uniform_width(utag);
+      std::vector<uint8_t> elements(nbytes);
+      if(nbytes > 0 &&
+	 sb.sgetn((char*)&elements[0], nbytes) != (std::streamsize)nbytes)
+	goto error;
+      return get_uniform(utag, nitems, nbytes > 0 ? &elements[0] : 0);
     }
 
   case PST_DICT:
@@ -764,9 +796,10 @@ deserialize(std::streambuf &sb)
  */
 std::string
 serialize_str(pmt_t obj){
-  std::stringbuf sb;
-  serialize(obj, sb);
-  return sb.str();
+  std::string s(serialized_size(obj.get()), '\0');
+  if(!s.empty())
+    serialize_to(obj.get(), (uint8_t*)&s[0]);
+  return s;
 }
 
 
@@ -775,8 +808,190 @@ serialize_str(pmt_t obj){
  */
 pmt_t
 deserialize_str(std::string s){
-  std::stringbuf sb(s);
-  return deserialize(sb);
+  return deserialize_buf(s.data(), s.size());
+}
+
+
+// ----------------------------------------------------------------
+// deserialization from memory
+// ----------------------------------------------------------------
+
+namespace {
+
+  // Read position in a serialized buffer.  take() hands out the next
+  // n bytes, or throws if the buffer ends first.
+  struct cursor
+  {
+    const uint8_t *p;
+    const uint8_t *end;
+
+    size_t remaining() const { return end - p; }
+
+    const uint8_t *take(size_t n)
+    {
+      if(n > remaining())
+	throw exception("pmt::deserialize: malformed input stream", PMT_F);
+      const uint8_t *q = p;
+      p += n;
+      return q;
+    }
+
+    uint8_t u8() { return *take(1); }
+    uint16_t u16() { return get_u16(take(2)); }
+    uint32_t u32() { return get_u32(take(4)); }
+    uint64_t u64() { return get_u64(take(8)); }
+    double f64() { return get_f64(take(8)); }
+  };
+
+} /* namespace */
+
+static pmt_t parse_pair(cursor &c);
+
+static pmt_t
+deserialize(cursor &c)
+{
+  uint8_t tag = c.u8();
+
+  switch (tag){
+  case PST_TRUE:
+    return PMT_T;
+
+  case PST_FALSE:
+    return PMT_F;
+
+  case PST_NULL:
+    return PMT_NIL;
+
+  case PST_SYMBOL:
+    {
+      uint16_t n = c.u16();
+      const char *name = (const char*)c.take(n);
+      return intern(std::string(name, n));
+    }
+
+  case PST_INT32:
+    return from_long((int32_t) c.u32());
+
+  case PST_UINT64:
+    return from_uint64(c.u64());
+
+  case PST_PAIR:
+    return parse_pair(c);
+
+  case PST_DOUBLE:
+    return from_double(c.f64());
+
+  case PST_COMPLEX:
+    {
+      double r = c.f64();
+      double i = c.f64();
+      return make_rectangular(r, i);
+    }
+
+  case PST_TUPLE:
+    {
+      uint32_t nitems = c.u32();
+      if(nitems > c.remaining())	// at least a byte each
+	throw exception("pmt::deserialize: malformed input stream", PMT_F);
+      pmt_tuple *t = new pmt_tuple(nitems);
+      pmt_t tuple(t);
+      for(uint32_t i = 0; i < nitems; i++)
+	t->_set(i, deserialize(c));
+      return tuple;
+    }
+
+  case PST_VECTOR:
+    {
+      uint32_t nitems = c.u32();
+      if(nitems > c.remaining())
+	throw exception("pmt::deserialize: malformed input stream", PMT_F);
+      pmt_t vec = make_vector(nitems, PMT_NIL);
+      for(uint32_t i = 0; i < nitems; i++)
+	vector_set(vec, i, deserialize(c));
+      return vec;
+    }
+
+  case PST_UNIFORM_VECTOR:
+    {
+      uint8_t utag = c.u8();
+      uint32_t nitems = c.u32();
+      uint8_t npad = c.u8();
+      c.take(npad);
+
+      size_t width = uniform_width(utag);
+      if(nitems > c.remaining() / width)
+	throw exception("pmt::deserialize: malformed input stream", PMT_F);
+      return get_uniform(utag, nitems, c.take(nitems * width));
+    }
+
+  case PST_DICT:
+  case PST_COMMENT:
+    throw notimplemented("pmt::deserialize: tag value = ",
+			 from_long(tag));
+
+  default:
+    throw exception("pmt::deserialize: malformed input stream, tag value = ",
+		    from_long(tag));
+  }
+}
+
+/*
+ * As parse_pair(std::streambuf &) below, without recursion along the
+ * cdrs.  On entry we've already eaten the PST_PAIR tag.
+ */
+static pmt_t
+parse_pair(cursor &c)
+{
+  pmt_t val, expr, lastnptr, nptr;
+
+  lastnptr = PMT_NIL;
+  while (1){
+    expr = deserialize(c);		// read the car
+
+    nptr = cons(expr, PMT_NIL);
+    if (is_null(lastnptr))
+      val = nptr;
+    else
+      set_cdr(lastnptr, nptr);
+    lastnptr = nptr;
+
+    uint8_t tag = c.u8();		// tag of cdr
+    if (tag == PST_PAIR)
+      continue;
+
+    if (tag == PST_NULL){
+      expr = PMT_NIL;
+      break;
+    }
+
+    c.p--;				// push tag back
+    expr = deserialize(c);
+    break;
+  }
+
+  set_cdr(lastnptr, expr);
+  return val;
+}
+
+pmt_t
+deserialize_buf(const void *buf, size_t len, size_t &pos)
+{
+  if(pos >= len)
+    return PMT_EOF;
+
+  cursor c;
+  c.p = (const uint8_t*)buf + pos;
+  c.end = (const uint8_t*)buf + len;
+  pmt_t obj = deserialize(c);
+  pos = c.p - (const uint8_t*)buf;
+  return obj;
+}
+
+pmt_t
+deserialize_buf(const void *buf, size_t len)
+{
+  size_t pos = 0;
+  return deserialize_buf(buf, len, pos);
 }
 
 
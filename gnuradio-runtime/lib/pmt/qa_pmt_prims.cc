@@ -98,6 +98,13 @@ qa_pmt_prims::test_integers()
   CPPUNIT_ASSERT_THROW(pmt::to_long(pmt::PMT_T), pmt::wrong_type);
   CPPUNIT_ASSERT_EQUAL(-1L, pmt::to_long(m1));
   CPPUNIT_ASSERT_EQUAL(1L, pmt::to_long(p1));
+
+  // small integers are shared, the others only equivalent
+  CPPUNIT_ASSERT(pmt::eq(pmt::from_long(-128), pmt::from_long(-128)));
+  CPPUNIT_ASSERT(pmt::eq(pmt::from_long(1023), pmt::from_long(1023)));
+  CPPUNIT_ASSERT(pmt::eqv(pmt::from_long(1024), pmt::from_long(1024)));
+  CPPUNIT_ASSERT_EQUAL(1024L, pmt::to_long(pmt::from_long(1024)));
+  CPPUNIT_ASSERT_EQUAL(-129L, pmt::to_long(pmt::from_long(-129)));
 }
 
 void
@@ -111,6 +118,8 @@ qa_pmt_prims::test_uint64s()
   CPPUNIT_ASSERT_THROW(pmt::to_uint64(pmt::PMT_T), pmt::wrong_type);
   CPPUNIT_ASSERT_EQUAL((uint64_t)8589934592ULL, (uint64_t)pmt::to_uint64(m1));
   CPPUNIT_ASSERT_EQUAL((uint64_t)1ULL, (uint64_t)pmt::to_uint64(p1));
+  CPPUNIT_ASSERT(pmt::eq(p1, pmt::from_uint64((uint64_t)1)));
+  CPPUNIT_ASSERT(!pmt::eqv(p1, pmt::from_long(1)));
 }
 
 void
@@ -402,6 +411,59 @@ qa_pmt_prims::test_dict()
   CPPUNIT_ASSERT(pmt::equal(vals, pmt::dict_values(dict)));
 }
 
+void
+qa_pmt_prims::test_dict_large()
+{
+  static const int N = 100;
+  pmt::pmt_t not_found = pmt::cons(pmt::PMT_NIL, pmt::PMT_NIL);
+  pmt::pmt_t dict = pmt::make_dict();
+  pmt::pmt_t alist = pmt::PMT_NIL;
+  for (int i = 0; i < N; i++) {
+    pmt::pmt_t k = pmt::mp(str(boost::format("key%d") % i));
+    dict = pmt::dict_add(dict, k, pmt::mp(i));
+    alist = pmt::acons(k, pmt::mp(i), alist);
+  }
+  CPPUNIT_ASSERT_EQUAL((size_t) N, pmt::length(dict));
+
+  // Older versions are unaffected by later updates
+  pmt::pmt_t old = dict;
+  dict = pmt::dict_add(dict, pmt::mp("key7"), pmt::mp("seven"));
+  CPPUNIT_ASSERT_EQUAL((size_t) N, pmt::length(dict));
+  CPPUNIT_ASSERT(pmt::eqv(pmt::mp(7), pmt::dict_ref(old, pmt::mp("key7"), not_found)));
+  CPPUNIT_ASSERT(pmt::eqv(pmt::mp("seven"), pmt::dict_ref(dict, pmt::mp("key7"), not_found)));
+  CPPUNIT_ASSERT(pmt::eqv(pmt::mp("key7"), pmt::car(pmt::dict_keys(dict))));
+
+  // Items come out newest first, just as they would from an a-list
+  CPPUNIT_ASSERT(pmt::equal(alist, pmt::dict_items(old)));
+  CPPUNIT_ASSERT(pmt::equal(alist, old));
+  CPPUNIT_ASSERT_EQUAL(pmt::serialize_str(alist), pmt::serialize_str(old));
+
+  // ...and the list functions see a dictionary as that a-list
+  CPPUNIT_ASSERT(pmt::is_pair(old));
+  CPPUNIT_ASSERT(pmt::equal(pmt::car(alist), pmt::car(old)));
+  CPPUNIT_ASSERT(pmt::equal(pmt::cdr(alist), pmt::cdr(old)));
+  CPPUNIT_ASSERT(pmt::equal(pmt::nth(42, alist), pmt::nth(42, old)));
+  CPPUNIT_ASSERT(pmt::equal(pmt::assv(pmt::mp("key42"), alist),
+			    pmt::assv(pmt::mp("key42"), old)));
+
+  // a-lists built by hand are still dictionaries
+  CPPUNIT_ASSERT(pmt::is_dict(alist));
+  CPPUNIT_ASSERT(pmt::eqv(pmt::mp(42), pmt::dict_ref(alist, pmt::mp("key42"), not_found)));
+  pmt::pmt_t d2 = pmt::dict_add(alist, pmt::mp("extra"), pmt::PMT_T);
+  CPPUNIT_ASSERT_EQUAL((size_t) N + 1, pmt::length(d2));
+  CPPUNIT_ASSERT(pmt::eqv(pmt::mp(42), pmt::dict_ref(d2, pmt::mp("key42"), not_found)));
+
+  for (int i = 0; i < N; i++) {
+    pmt::pmt_t k = pmt::mp(str(boost::format("key%d") % i));
+    CPPUNIT_ASSERT(pmt::dict_has_key(dict, k));
+    dict = pmt::dict_delete(dict, k);
+    CPPUNIT_ASSERT(!pmt::dict_has_key(dict, k));
+    CPPUNIT_ASSERT_EQUAL((size_t) (N - i - 1), pmt::length(dict));
+  }
+  CPPUNIT_ASSERT(pmt::eq(pmt::PMT_NIL, dict));
+  CPPUNIT_ASSERT_EQUAL((size_t) N, pmt::length(old));
+}
+
 void
 qa_pmt_prims::test_io()
 {
@@ -564,6 +626,49 @@ qa_pmt_prims::test_serialize()
 
 }
 
+void
+qa_pmt_prims::test_serialize_buf()
+{
+  std::vector<pmt::pmt_t> objs;
+  objs.push_back(pmt::mp("foobarvia"));
+  objs.push_back(pmt::from_long(-123456789));
+  objs.push_back(pmt::from_uint64(0x0123456789abcdefULL));
+  objs.push_back(pmt::from_double(0.25));
+  objs.push_back(pmt::from_complex(1.5, -2.0));
+  objs.push_back(pmt::list3(pmt::mp("a"), pmt::PMT_T, pmt::list1(pmt::PMT_F)));
+  objs.push_back(pmt::dict_add(pmt::make_dict(), pmt::mp("rate"),
+			       pmt::from_double(32000)));
+  objs.push_back(pmt::make_tuple(pmt::from_uint64(10), pmt::from_double(0.5)));
+  objs.push_back(pmt::make_vector(3, pmt::from_long(7)));
+  objs.push_back(pmt::init_s16vector(3, std::vector<int16_t>(3, -300)));
+  objs.push_back(pmt::init_f32vector(5, std::vector<float>(5, 0.75f)));
+  objs.push_back(pmt::init_c32vector(2, std::vector<std::complex<float> >(2, std::complex<float>(1, -1))));
+
+  // the buffer form is the stream form, and objects follow each other
+  std::stringbuf sb;
+  std::vector<char> buf;
+  for(size_t i = 0; i < objs.size(); i++) {
+    pmt::serialize(objs[i], sb);
+    size_t len = pmt::serialized_size(objs[i]);
+    size_t pos = buf.size();
+    buf.resize(pos + len);
+    CPPUNIT_ASSERT_EQUAL((size_t)0, pmt::serialize_buf(objs[i], &buf[pos], len - 1));
+    CPPUNIT_ASSERT_EQUAL(len, pmt::serialize_buf(objs[i], &buf[pos], len));
+  }
+  CPPUNIT_ASSERT(sb.str() == std::string(&buf[0], buf.size()));
+
+  size_t pos = 0;
+  for(size_t i = 0; i < objs.size(); i++)
+    CPPUNIT_ASSERT(pmt::equal(pmt::deserialize_buf(&buf[0], buf.size(), pos), objs[i]));
+  CPPUNIT_ASSERT_EQUAL(buf.size(), pos);
+  CPPUNIT_ASSERT(pmt::eq(pmt::deserialize_buf(&buf[0], buf.size(), pos), pmt::PMT_EOF));
+
+  // truncated input
+  std::string s = pmt::serialize_str(objs.back());
+  CPPUNIT_ASSERT_THROW(pmt::deserialize_buf(s.data(), s.size() - 1), pmt::exception);
+  CPPUNIT_ASSERT_THROW(pmt::deserialize_str(s.substr(0, 3)), pmt::exception);
+}
+
 void
 qa_pmt_prims::test_sets()
 {
@@ -41,6 +41,7 @@
 #include <qa_vmcircbuf.h>
 #include <qa_sincos.h>
 #include <qa_fast_atan2f.h>
+#include <qa_random.h>
 
 CppUnit::TestSuite *
 qa_runtime::suite()
@@ -58,6 +59,7 @@ qa_runtime::suite()
   s->addTest(qa_vmcircbuf::suite());
   s->addTest(qa_sincos::suite());
   s->addTest(qa_fast_atan2f::suite());
+  s->addTest(qa_random::suite());
 
   return s;
 }
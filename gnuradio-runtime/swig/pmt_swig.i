@@ -290,5 +290,6 @@ namespace pmt{
   void dump_sizeof();
   std::string serialize_str(pmt_t obj);
   pmt_t deserialize_str(std::string str);
+  size_t serialized_size(pmt_t obj);
 
 } //namespace pmt
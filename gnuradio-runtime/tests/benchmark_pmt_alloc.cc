@@ -0,0 +1,192 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Times the pmt work of a block that tags its output: an integer
+ * packet length, an rx_time tuple and a dict of stream parameters
+ * built, read and taken apart again.  The last case makes the values
+ * in one thread and drops them in another, as a tag does when it
+ * moves downstream.
+ */
+
+#include <stdio.h>
+#include <sys/time.h>
+#include <vector>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <pmt/pmt.h>
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+static void
+report(const char *name, double t, long n)
+{
+  printf("%-28s %8.1f ns\n", name, 1e9 * t / n);
+}
+
+static void
+bench_lengths(long n)
+{
+  pmt::pmt_t key = pmt::mp("packet_len");
+  long sum = 0;
+  double t0 = now();
+  for(long i = 0; i < n; i++) {
+    pmt::pmt_t tag = pmt::cons(key, pmt::from_long(i % 1500));
+    sum += pmt::to_long(pmt::cdr(tag));
+  }
+  report("packet_len tag", now() - t0, n);
+  if(sum < 0)
+    printf("%ld\n", sum);
+}
+
+static void
+bench_rx_time(long n)
+{
+  pmt::pmt_t key = pmt::mp("rx_time");
+  double t0 = now();
+  for(long i = 0; i < n; i++) {
+    pmt::pmt_t val = pmt::make_tuple(pmt::from_uint64(1413824312 + i / 1000),
+				     pmt::from_double((i % 1000) * 1e-3));
+    pmt::pmt_t tag = pmt::cons(key, val);
+  }
+  report("rx_time tag", now() - t0, n);
+}
+
+static void
+bench_symbols(long n)
+{
+  double t0 = now();
+  for(long i = 0; i < n; i++)
+    pmt::mp("rx_freq");
+  report("mp(\"rx_freq\")", now() - t0, n);
+}
+
+static void
+bench_dict(long n)
+{
+  const char *names[] = { "rx_time", "rx_rate", "rx_freq", "packet_len",
+			  "burst", "snr", "freq_offset", "ber" };
+  pmt::pmt_t keys[8];
+  for(int k = 0; k < 8; k++)
+    keys[k] = pmt::mp(names[k]);
+
+  double t0 = now();
+  for(long i = 0; i < n; i++) {
+    pmt::pmt_t d = pmt::make_dict();
+    for(int k = 0; k < 8; k++)
+      d = pmt::dict_add(d, keys[k], pmt::from_long(k + i));
+    d = pmt::dict_add(d, keys[3], pmt::from_long(7));	// replace
+    for(int k = 0; k < 8; k++)
+      pmt::dict_ref(d, keys[k], pmt::PMT_NIL);
+    d = pmt::dict_delete(d, keys[0]);
+  }
+  report("dict of 8: add, ref, delete", now() - t0, n);
+}
+
+// Hands the values over through a small bounded queue
+class handoff
+{
+  boost::mutex d_mutex;
+  boost::condition_variable d_cond;
+  std::vector<pmt::pmt_t> d_queue;
+  bool d_done;
+
+public:
+  handoff() : d_done(false) {}
+
+  void put(const std::vector<pmt::pmt_t> &batch)
+  {
+    boost::unique_lock<boost::mutex> lock(d_mutex);
+    while(!d_queue.empty())
+      d_cond.wait(lock);
+    d_queue = batch;
+    d_cond.notify_all();
+  }
+
+  void finish()
+  {
+    boost::unique_lock<boost::mutex> lock(d_mutex);
+    d_done = true;
+    d_cond.notify_all();
+  }
+
+  void drain()
+  {
+    std::vector<pmt::pmt_t> batch;
+    while(1) {
+      {
+	boost::unique_lock<boost::mutex> lock(d_mutex);
+	while(d_queue.empty() && !d_done)
+	  d_cond.wait(lock);
+	if(d_queue.empty())
+	  return;
+	batch.swap(d_queue);
+	d_cond.notify_all();
+      }
+      batch.clear();			// the values die here
+    }
+  }
+};
+
+static void
+bench_handoff(long n)
+{
+  const size_t batch_size = 256;
+  pmt::pmt_t key = pmt::mp("rx_time");
+  handoff h;
+  std::vector<pmt::pmt_t> batch;
+
+  double t0 = now();
+  boost::thread consumer(boost::bind(&handoff::drain, &h));
+  for(long i = 0; i < n; i++) {
+    batch.push_back(pmt::cons(key, pmt::make_tuple(pmt::from_uint64(i),
+						   pmt::from_double(0.5))));
+    if(batch.size() == batch_size) {
+      h.put(batch);
+      batch.clear();
+    }
+  }
+  h.put(batch);
+  h.finish();
+  consumer.join();
+  report("rx_time tag, freed elsewhere", now() - t0, n);
+}
+
+int
+main(int argc, char **argv)
+{
+  printf("time per operation\n");
+  bench_lengths(10000000);
+  bench_rx_time(2000000);
+  bench_symbols(10000000);
+  bench_dict(500000);
+  bench_handoff(2000000);
+  return 0;
+}
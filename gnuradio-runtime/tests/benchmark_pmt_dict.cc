@@ -0,0 +1,96 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Times dict_ref, dict_add and dict_delete on dicts of growing size,
+ * the way a block keeps its state or metadata in a dict and updates
+ * one key at a time.
+ */
+
+#include <stdio.h>
+#include <sys/time.h>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <pmt/pmt.h>
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+static void
+report(const char *what, size_t size, double t, long n)
+{
+  printf("%-10s %5d keys %10.1f ns\n", what, (int)size, 1e9 * t / n);
+}
+
+static void
+bench_dict(size_t size, long n)
+{
+  std::vector<pmt::pmt_t> keys;
+  for(size_t k = 0; k < size; k++)
+    keys.push_back(pmt::mp(str(boost::format("key_%d") % k)));
+
+  pmt::pmt_t d = pmt::make_dict();
+  double t0 = now();
+  long m = n / size + 1;
+  for(long i = 0; i < m; i++) {
+    d = pmt::make_dict();
+    for(size_t k = 0; k < size; k++)
+      d = pmt::dict_add(d, keys[k], pmt::from_long(k));
+  }
+  report("build", size, now() - t0, m * size);
+
+  long hits = 0;
+  t0 = now();
+  for(long i = 0; i < n; i++)
+    hits += pmt::dict_has_key(d, keys[(i * 7) % size]);
+  report("ref", size, now() - t0, n);
+
+  t0 = now();
+  for(long i = 0; i < n; i++)
+    d = pmt::dict_add(d, keys[(i * 7) % size], pmt::from_long(i));
+  report("replace", size, now() - t0, n);
+
+  t0 = now();
+  for(long i = 0; i < n; i++)
+    pmt::dict_delete(d, keys[(i * 7) % size]);
+  report("delete", size, now() - t0, n);
+
+  if(hits != n)
+    printf("lost keys\n");
+}
+
+int
+main(int argc, char **argv)
+{
+  printf("time per operation\n");
+  bench_dict(8, 1000000);
+  bench_dict(32, 500000);
+  bench_dict(128, 100000);
+  bench_dict(1024, 10000);
+  return 0;
+}
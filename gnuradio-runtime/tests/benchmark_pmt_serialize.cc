@@ -0,0 +1,146 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Times the serialization of large f32 and c32 vectors, of a dict of
+ * dicts like a file_meta header, and of a small tag value: through a
+ * std::stringbuf with serialize() and deserialize(), and through a
+ * contiguous buffer with serialize_buf() and deserialize_buf().
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sstream>
+#include <vector>
+
+#include <pmt/pmt.h>
+
+static double
+now()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+static pmt::pmt_t
+make_f32(size_t n)
+{
+  std::vector<float> v(n);
+  for(size_t i = 0; i < n; i++)
+    v[i] = 0.001f * i;
+  return pmt::init_f32vector(n, v);
+}
+
+static pmt::pmt_t
+make_c32(size_t n)
+{
+  std::vector<std::complex<float> > v(n);
+  for(size_t i = 0; i < n; i++)
+    v[i] = std::complex<float>(0.001f * i, -0.002f * i);
+  return pmt::init_c32vector(n, v);
+}
+
+// 32 dicts of 16 entries each, with a few of them nested once more
+static pmt::pmt_t
+make_dicts()
+{
+  char key[32];
+  pmt::pmt_t outer = pmt::make_dict();
+  for(int i = 0; i < 32; i++) {
+    pmt::pmt_t inner = pmt::make_dict();
+    for(int j = 0; j < 16; j++) {
+      snprintf(key, sizeof(key), "key_%d", j);
+      pmt::pmt_t val;
+      switch(j % 4) {
+      case 0: val = pmt::from_long(i * j); break;
+      case 1: val = pmt::from_double(0.5 * j); break;
+      case 2: val = pmt::make_tuple(pmt::from_uint64(i), pmt::from_double(0.25)); break;
+      default: val = pmt::dict_add(pmt::make_dict(), pmt::mp("rate"),
+				   pmt::from_double(1e6));
+      }
+      inner = pmt::dict_add(inner, pmt::mp(key), val);
+    }
+    snprintf(key, sizeof(key), "segment_%d", i);
+    outer = pmt::dict_add(outer, pmt::mp(key), inner);
+  }
+  return outer;
+}
+
+static void
+run(const char *name, pmt::pmt_t obj, int iterations)
+{
+  size_t len = pmt::serialized_size(obj);
+  std::vector<char> buf(len);
+  double t0, ser_stream, des_stream, ser_buf, des_buf;
+
+  t0 = now();
+  for(int i = 0; i < iterations; i++) {
+    std::stringbuf sb;
+    pmt::serialize(obj, sb);
+  }
+  ser_stream = now() - t0;
+
+  std::stringbuf sb;
+  pmt::serialize(obj, sb);
+  std::string s = sb.str();
+  t0 = now();
+  for(int i = 0; i < iterations; i++) {
+    std::stringbuf in(s);
+    pmt::deserialize(in);
+  }
+  des_stream = now() - t0;
+
+  t0 = now();
+  for(int i = 0; i < iterations; i++)
+    pmt::serialize_buf(obj, &buf[0], len);
+  ser_buf = now() - t0;
+
+  t0 = now();
+  for(int i = 0; i < iterations; i++)
+    pmt::deserialize_buf(&buf[0], len);
+  des_buf = now() - t0;
+
+  if(s != std::string(&buf[0], len) ||
+     !pmt::equal(pmt::deserialize_buf(&buf[0], len), obj)) {
+    fprintf(stderr, "%s: buffer and stream forms differ\n", name);
+    exit(1);
+  }
+
+  double mb = 1e-6 * len * iterations;
+  printf("%-10s %9lu bytes  stream %8.1f / %8.1f MB/s  buffer %8.1f / %8.1f MB/s\n",
+	 name, (unsigned long)len, mb / ser_stream, mb / des_stream,
+	 mb / ser_buf, mb / des_buf);
+}
+
+int
+main(int argc, char **argv)
+{
+  printf("serialize / deserialize\n");
+  run("f32 1M", make_f32(1 << 20), 20);
+  run("c32 1M", make_c32(1 << 20), 10);
+  run("dicts", make_dicts(), 1000);
+  run("rx_time", pmt::make_tuple(pmt::from_uint64(1413824312),
+				 pmt::from_double(0.125)), 1000000);
+  return 0;
+}
@@ -80,26 +80,36 @@ namespace gr {
 #if @IS_COMPLEX@	// complex?
 
       case GR_UNIFORM:
+	d_rng.ran1_fill((float*)&d_samples[0], 2*noutput_items);
 	for(int i = 0; i < noutput_items; i++)
-	  d_samples[i] = gr_complex(d_ampl * ((d_rng.ran1() * 2.0) - 1.0),
-				    d_ampl * ((d_rng.ran1() * 2.0) - 1.0));
+	  d_samples[i] = gr_complex(d_ampl * ((d_samples[i].real() * 2.0f) - 1.0f),
+				    d_ampl * ((d_samples[i].imag() * 2.0f) - 1.0f));
 	break;
 
       case GR_GAUSSIAN:
+	d_rng.rayleigh_complex_fill(&d_samples[0], noutput_items);
 	for(int i = 0; i < noutput_items; i++)
-	  d_samples[i] = d_ampl * d_rng.rayleigh_complex();
+	  d_samples[i] *= d_ampl;
 	break;
 
 #else			// nope...
 
       case GR_UNIFORM:
-	for(int i = 0; i < noutput_items; i++)
-	  d_samples[i] = (@TYPE@)(d_ampl * ((d_rng.ran1() * 2.0) - 1.0));
+	{
+	  std::vector<float> u(noutput_items);
+	  d_rng.ran1_fill(&u[0], noutput_items);
+	  for(int i = 0; i < noutput_items; i++)
+	    d_samples[i] = (@TYPE@)(d_ampl * ((u[i] * 2.0f) - 1.0f));
+	}
 	break;
 
       case GR_GAUSSIAN:
-	for(int i = 0; i < noutput_items; i++)
-	  d_samples[i] = (@TYPE@)(d_ampl * d_rng.gasdev());
+	{
+	  std::vector<float> g(noutput_items);
+	  d_rng.gasdev_fill(&g[0], noutput_items);
+	  for(int i = 0; i < noutput_items; i++)
+	    d_samples[i] = (@TYPE@)(d_ampl * g[i]);
+	}
 	break;
 
       case GR_LAPLACIAN:
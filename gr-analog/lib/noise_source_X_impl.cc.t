@@ -28,6 +28,7 @@
 
 #include "@IMPL_NAME@.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <stdexcept>
 
 namespace gr {
@@ -81,29 +82,34 @@ namespace gr {
 #if @IS_COMPLEX@	// complex?
 
       case GR_UNIFORM:
+	d_rng.ran1_fill((float*)out, 2*noutput_items);
 	for(int i = 0; i < noutput_items; i++) {
-	  out[i] = gr_complex(d_ampl * ((d_rng.ran1() * 2.0) - 1.0),
-			      d_ampl * ((d_rng.ran1() * 2.0) - 1.0));
+	  out[i] = gr_complex(d_ampl * ((out[i].real() * 2.0f) - 1.0f),
+			      d_ampl * ((out[i].imag() * 2.0f) - 1.0f));
 	}
 	break;
 
       case GR_GAUSSIAN:
-	for(int i = 0; i < noutput_items; i++) {
-	  out[i] = d_ampl * d_rng.rayleigh_complex();
-	}
+	d_rng.rayleigh_complex_fill(out, noutput_items);
+	volk_32f_s32f_multiply_32f((float*)out, (const float*)out,
+				   d_ampl, 2*noutput_items);
 	break;
 
 #else			// nope...
 
       case GR_UNIFORM:
+	d_buf.resize(noutput_items);
+	d_rng.ran1_fill(&d_buf[0], noutput_items);
 	for(int i = 0; i < noutput_items; i++) {
-	  out[i] = (@TYPE@)(d_ampl * ((d_rng.ran1() * 2.0) - 1.0));
+	  out[i] = (@TYPE@)(d_ampl * ((d_buf[i] * 2.0f) - 1.0f));
 	}
 	break;
 
       case GR_GAUSSIAN:
+	d_buf.resize(noutput_items);
+	d_rng.gasdev_fill(&d_buf[0], noutput_items);
 	for(int i = 0; i < noutput_items; i++) {
-	  out[i] = (@TYPE@)(d_ampl * d_rng.gasdev());
+	  out[i] = (@TYPE@)(d_ampl * d_buf[i]);
 	}
 	break;
 
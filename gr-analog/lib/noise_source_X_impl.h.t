@@ -27,6 +27,7 @@
 
 #include <gnuradio/analog/@BASE_NAME@.h>
 #include <gnuradio/random.h>
+#include <vector>
 
 namespace gr {
   namespace analog {
@@ -36,6 +37,7 @@ namespace gr {
       noise_type_t d_type;
       float d_ampl;
       gr::random d_rng;
+      std::vector<float> d_buf;
 
     public:
       @IMPL_NAME@(noise_type_t type, float ampl, long seed = 0);
@@ -45,13 +45,15 @@ class ATSC_API atsci_reed_solomon {
   void encode (atsc_mpeg_packet_rs_encoded &out, const atsc_mpeg_packet_no_sync &in);
 
   /*!
-   * Decode RS encoded packet.
+   * Decode RS encoded packet, using the VOLK GF(2^8) kernels for the
+   * syndromes and the Chien search.
    * \returns a count of corrected symbols, or -1 if the block was uncorrectible.
    */
   int decode (atsc_mpeg_packet_no_sync &out, const atsc_mpeg_packet_rs_encoded &in);
 
  private:
   void	*d_rs;
+  void	*d_rs_volk;
 };
 
 #endif /* _ATSC_REED_SOLOMON_H_ */
@@ -45,6 +45,12 @@ atsci_reed_solomon::atsci_reed_solomon ()
 		       rs_init_fcr, rs_init_prim, rs_init_nroots);
 
   assert (d_rs != 0);
+
+  d_rs_volk = init_rs_volk (rs_init_symsize, rs_init_gfpoly,
+			    rs_init_fcr, rs_init_prim, rs_init_nroots,
+			    amount_of_pad);
+
+  assert (d_rs_volk != 0);
 }
 
 atsci_reed_solomon::~atsci_reed_solomon ()
@@ -52,6 +58,9 @@ atsci_reed_solomon::~atsci_reed_solomon ()
   if (d_rs)
     free_rs_char (d_rs);
   d_rs = 0;
+  if (d_rs_volk)
+    free_rs_volk (d_rs_volk);
+  d_rs_volk = 0;
 }
 
 void
@@ -75,20 +84,20 @@ atsci_reed_solomon::encode (atsc_mpeg_packet_rs_encoded &out, const atsc_mpeg_pa
 int
 atsci_reed_solomon::decode (atsc_mpeg_packet_no_sync &out, const atsc_mpeg_packet_rs_encoded &in)
 {
-  unsigned char tmp[N];
+  unsigned char tmp[ATSC_MPEG_RS_ENCODED_LENGTH];
   int		ncorrections;
 
   assert ((int)(amount_of_pad + sizeof (in.data)) == N);
 
-  // add missing prefix zero padding to message
-  memset (tmp, 0, amount_of_pad);
-  memcpy (&tmp[amount_of_pad], in.data, sizeof (in.data));
+  // the decoder knows about the prefix zero padding, so the shortened
+  // block is corrected as is
+  memcpy (tmp, in.data, sizeof (in.data));
 
   // correct message...
-  ncorrections = decode_rs_char (d_rs, tmp, 0, 0);
+  ncorrections = decode_rs_volk (d_rs_volk, tmp, 0, 0);
 
-  // copy corrected message to output, skipping prefix zero padding
-  memcpy (out.data, &tmp[amount_of_pad], sizeof (out.data));
+  // copy corrected message to output
+  memcpy (out.data, tmp, sizeof (out.data));
 
   return ncorrections;
 }
@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_DIRECT_FILE_SINK_H
+#define INCLUDED_BLOCKS_DIRECT_FILE_SINK_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/blocks/file_meta_sink.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Records a stream to file at disk speed, with detached
+     * meta-data headers.
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * The samples are copied into a set of aligned buffers.  Full
+     * buffers go to a writer thread, which writes them with O_DIRECT,
+     * bypassing the page cache, and through io_uring where the kernel
+     * supports it, with several writes in flight.  The file is
+     * preallocated ahead of the writes.  The scheduler thread never
+     * waits for the disk: when all buffers are taken, the samples
+     * that do not fit are dropped and counted as an overflow.
+     *
+     * The headers are those of file_meta_sink with a detached header,
+     * written to filename.hdr, so that file_meta_source can play the
+     * recording back with detached_header set.  A new header starts
+     * on every tag, every \p max_segment_size items and after every
+     * overflow; the header after an overflow has rx_time moved on by
+     * the dropped samples, so the time stamps stay right across the
+     * gap.
+     */
+    class BLOCKS_API direct_file_sink : virtual public sync_block
+    {
+    public:
+      // gr::blocks::direct_file_sink::sptr
+      typedef boost::shared_ptr<direct_file_sink> sptr;
+
+      /*!
+       * \brief Create a recording sink.
+       *
+       * \param itemsize (size_t): Size of data type.
+       * \param filename (string): Name of file to write data to; the
+       *    headers go to filename.hdr.
+       * \param samp_rate (double): Sample rate of data.
+       * \param relative_rate (double): Rate change from source of sample
+       *    rate tag to sink.
+       * \param type (gr_file_types): Data type (int, float, etc.)
+       * \param complex (bool): If data stream is complex
+       * \param max_segment_size (size_t): Length of a single segment
+       *    before the header is repeated (in items).
+       * \param extra_dict (string): a serialized PMT dictionary of extra
+       *    information.
+       * \param buffer_size (size_t): Size of each buffer in bytes.
+       * \param nbuffers (int): Number of buffers, at least 2.
+       * \param preallocate (size_t): Bytes to allocate on disk ahead of
+       *    the writes, 0 for none.
+       */
+      static sptr make(size_t itemsize, const std::string &filename,
+		       double samp_rate=1, double relative_rate=1,
+		       gr_file_types type=GR_FILE_FLOAT, bool complex=true,
+		       size_t max_segment_size=1000000,
+		       const std::string &extra_dict="",
+		       size_t buffer_size=4*1024*1024, int nbuffers=8,
+		       size_t preallocate=256*1024*1024);
+
+      //! Writes out what is buffered and closes the files
+      virtual void close() = 0;
+
+      //! Number of times samples had to be dropped
+      virtual uint64_t overflows() const = 0;
+
+      //! Number of samples dropped
+      virtual uint64_t items_dropped() const = 0;
+
+      //! Number of samples that have reached the file
+      virtual uint64_t items_written() const = 0;
+
+      //! Number of buffers that failed to write
+      virtual uint64_t write_errors() const = 0;
+
+      //! True if the file is written with O_DIRECT
+      virtual bool direct_io() const = 0;
+
+      //! True if the writes go through io_uring
+      virtual bool uses_io_uring() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_DIRECT_FILE_SINK_H */
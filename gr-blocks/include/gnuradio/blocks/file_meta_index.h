@@ -0,0 +1,111 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_FILE_META_INDEX_H
+#define INCLUDED_BLOCKS_FILE_META_INDEX_H
+
+#include <gnuradio/blocks/api.h>
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Index of the segments of a meta-data file.
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * The index is a sidecar to a file_meta_sink recording, normally
+     * named filename.idx, with one fixed size record per segment:
+     * where its header and data are, the stream offset of its first
+     * item, its rx_time and rx_rate and its number of items.  A record
+     * is appended when a segment starts and rewritten in place as the
+     * segment grows, so the index of a recording that is still being
+     * written is good up to its last segment.
+     *
+     * Because the records have a fixed size and are in stream order,
+     * a segment is found by time or by item with a binary search that
+     * reads O(log n) records, instead of parsing every header from
+     * the start of the file.  The records are big endian, like the
+     * serialized headers, after an 8 byte magic string.
+     */
+    class BLOCKS_API file_meta_index
+    {
+    public:
+      struct entry {
+	uint64_t hdr_offset;   //!< byte offset of the header (in the .hdr file when detached)
+	uint64_t data_offset;  //!< byte offset of the data in the data file
+	uint64_t item;         //!< stream offset of the first item
+	uint64_t nitems;       //!< number of items in the segment
+	uint64_t secs;         //!< rx_time of the first item, whole seconds
+	double fracs;          //!< rx_time of the first item, fractional seconds
+	double rate;           //!< rx_rate of the segment
+      };
+
+      static const size_t HEADER_SIZE = 8;
+      static const size_t ENTRY_SIZE = 56;
+
+      /*!
+       * \param filename index file
+       * \param create true to create or truncate it for writing,
+       *        false to open it for reading
+       */
+      file_meta_index(const std::string &filename, bool create);
+      ~file_meta_index();
+
+      //! Appends the record of a new segment
+      void append(const entry &e);
+
+      //! Rewrites the record of the last segment
+      void update_last(const entry &e);
+
+      //! Number of segments in the index
+      uint64_t size() const;
+
+      //! Record of segment \p n
+      entry at(uint64_t n) const;
+
+      /*!
+       * \brief The last segment that starts at or before the given
+       * time, or -1 if the first one starts after it.
+       */
+      int64_t find_time(uint64_t secs, double fracs) const;
+
+      /*!
+       * \brief The last segment that starts at or before stream item
+       * \p item, or -1 if the first one starts after it.
+       */
+      int64_t find_item(uint64_t item) const;
+
+    private:
+      FILE *d_fp;
+
+      void write_entry(uint64_t n, const entry &e);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_FILE_META_INDEX_H */
@@ -66,6 +66,11 @@ namespace gr {
      * the first header (at position 0 in the file) and reading where
      * the data segment starts plus the data segment size. Following
      * will either be a new header or EOF.
+     *
+     * With \p index set, the sink also writes a file_meta_index of
+     * the segments to filename.idx, so that a segment can be found by
+     * time or item without reading the headers before it; see
+     * file_meta_source::seek_time.
      */
     class BLOCKS_API file_meta_sink : virtual public sync_block
     {
@@ -91,13 +96,16 @@ namespace gr {
        *    information. Currently not supported.
        * \param detached_header (bool): Set to true to store the header
        *    info in a separate file (named filename.hdr)
+       * \param index (bool): Set to true to write an index of the
+       *    segments (named filename.idx)
        */
       static sptr make(size_t itemsize, const std::string &filename,
 		       double samp_rate=1, double relative_rate=1,
 		       gr_file_types type=GR_FILE_FLOAT, bool complex=true,
 		       size_t max_segment_size=1000000,
 		       const std::string &extra_dict="",
-		       bool detached_header=false);
+		       bool detached_header=false,
+		       bool index=false);
 
       virtual bool open(const std::string &filename) = 0;
       virtual void close() = 0;
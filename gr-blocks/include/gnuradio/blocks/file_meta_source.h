@@ -47,6 +47,11 @@ namespace gr {
      *
      * Any item inside of the extra header dictionary is ready out and
      * made into a stream tag.
+     *
+     * Playback can start at a time with seek_time().  If the
+     * recording has an index (filename.idx, see file_meta_index), the
+     * segment is found with a binary search of the index; otherwise
+     * the headers are read from the start of the file.
      */
     class BLOCKS_API file_meta_source : virtual public sync_block
     {
@@ -74,6 +79,17 @@ namespace gr {
 			const std::string &hdr_filename="") = 0;
       virtual void close() = 0;
       virtual void do_update() = 0;
+
+      /*!
+       * \brief Moves playback to the first item at or after rx_time
+       * (\p secs, \p fracs).
+       *
+       * The move is made by the next call to work(), which tags the
+       * item with the header of its segment and its own rx_time.  A
+       * time before the recording starts playback from the start, a
+       * time after it ends playback.
+       */
+      virtual void seek_time(uint64_t secs, double fracs) = 0;
     };
 
   } /* namespace blocks */
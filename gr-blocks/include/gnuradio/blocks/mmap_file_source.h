@@ -0,0 +1,99 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_MMAP_FILE_SOURCE_H
+#define INCLUDED_BLOCKS_MMAP_FILE_SOURCE_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Read stream from a memory mapped file
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * Plays a file back like file_source, but through a memory
+     * mapping of the file instead of with fread.  The items are
+     * copied straight from the page cache into the output buffer,
+     * the kernel is told that the mapping is read sequentially, and
+     * the file is read ahead of the playback.  Repeating goes back to
+     * the start of the file without reopening it, and seek() only
+     * moves the read position.
+     *
+     * By default the whole file is mapped at once, so that a seek
+     * does not remap anything.  On 32-bit platforms, or with a
+     * \p window_size, the file is mapped a window at a time and a
+     * seek out of the window remaps it on the next call to work().
+     *
+     * Tags can be played back with the samples from a sidecar file
+     * of pmt tuples (offset, key, value), each written with
+     * pmt::serialize, where offset is the item offset in the file
+     * (uint64).  A tag is emitted every time its item is played,
+     * also after a seek and on every repeat.
+     */
+    class BLOCKS_API mmap_file_source : virtual public sync_block
+    {
+    public:
+      // gr::blocks::mmap_file_source::sptr
+      typedef boost::shared_ptr<mmap_file_source> sptr;
+
+      /*!
+       * \brief Create a memory mapped file source.
+       *
+       * \param itemsize the size of each item in the file, in bytes
+       * \param filename name of the file to source from
+       * \param repeat repeat file from start
+       * \param tag_file name of the file of tags to play back, empty
+       *        for none
+       * \param window_size bytes of the file to map at a time,
+       *        rounded up to the page size, 0 for the whole file
+       */
+      static sptr make(size_t itemsize, const char *filename,
+		       bool repeat = false, const char *tag_file = "",
+		       size_t window_size = 0);
+
+      /*!
+       * \brief seek file to \p seek_point relative to \p whence
+       *
+       * \param seek_point sample offset in file
+       * \param whence one of SEEK_SET, SEEK_CUR, SEEK_END (man fseek)
+       */
+      virtual bool seek(long seek_point, int whence) = 0;
+
+      //! Number of items in the file
+      virtual uint64_t file_items() const = 0;
+
+      //! Item offset in the file of the next item to play
+      virtual uint64_t position() const = 0;
+
+      //! Number of tags loaded from the tag file
+      virtual size_t num_tags() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_MMAP_FILE_SOURCE_H */
@@ -0,0 +1,91 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_BLOCKS_SHM_SINK_H
+#define INCLUDED_BLOCKS_SHM_SINK_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Write stream to a shared memory ring, for shm_source
+     * blocks in other processes.
+     * \ingroup networking_tools_blk
+     *
+     * \details
+     * Creates the POSIX shared memory segment \p name (under
+     * /dev/shm on Linux), replacing any left by an earlier writer,
+     * and removes it when the block is destroyed.  The items are
+     * copied into a ring in the segment, mapped twice back to back
+     * like the buffers between blocks, and the stream tags into a
+     * ring of tag slots beside it; up to 16 shm_source blocks can
+     * read it at once, each at its own pace.  Nothing on the way
+     * takes a lock or makes a system call.
+     *
+     * With \p block set, the sink waits for the slowest reader, so
+     * that the readers get every item.  Otherwise it never waits,
+     * and a reader that falls a ring behind skips ahead, marking
+     * the gap with a tag.  Either way, items written while no reader
+     * is attached are lost.  A tag whose key, value and srcid do not
+     * fit the 236 bytes of a tag slot when serialized is dropped,
+     * as are the tags on one item past the 4096 slots of the ring.
+     */
+    class BLOCKS_API shm_sink : virtual public sync_block
+    {
+    public:
+      // gr::blocks::shm_sink::sptr
+      typedef boost::shared_ptr<shm_sink> sptr;
+
+      /*!
+       * \brief Shared memory sink constructor
+       *
+       * \param itemsize The size (in bytes) of the item datatype
+       * \param name     The name of the shared memory segment
+       * \param nitems   Items the ring holds, rounded up to whole pages
+       * \param block    Wait for the slowest reader, instead of
+       *                 overwriting what it has not read
+       */
+      static sptr make(size_t itemsize, const std::string &name,
+		       int nitems=1048576, bool block=true);
+
+      //! Name of the shared memory segment
+      virtual std::string name() const = 0;
+
+      //! Items the ring holds
+      virtual int capacity() const = 0;
+
+      //! Number of readers attached
+      virtual int num_readers() const = 0;
+
+      //! Tags dropped for not fitting a tag slot or the ring
+      virtual uint64_t dropped_tags() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_SHM_SINK_H */
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_BLOCKS_SHM_SOURCE_H
+#define INCLUDED_BLOCKS_SHM_SOURCE_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Read stream from a shared memory ring written by a
+     * shm_sink in another process.
+     * \ingroup networking_tools_blk
+     *
+     * \details
+     * Attaches to the segment \p name, waiting for the shm_sink to
+     * create it, and outputs the items written from then on with
+     * their stream tags.  When the sink stops, the source outputs
+     * what is left and is done.
+     *
+     * If the sink does not wait for its readers and this one falls
+     * a ring behind, it skips ahead; an "items_lost" tag, with the
+     * number of items skipped as a uint64, goes on the first item
+     * after the gap.  The counts of items and tags lost are
+     * available through ControlPort.
+     */
+    class BLOCKS_API shm_source : virtual public sync_block
+    {
+    public:
+      // gr::blocks::shm_source::sptr
+      typedef boost::shared_ptr<shm_source> sptr;
+
+      /*!
+       * \brief Shared memory source constructor
+       *
+       * \param itemsize The size (in bytes) of the item datatype;
+       *                 must be that of the sink
+       * \param name     The name of the shared memory segment
+       */
+      static sptr make(size_t itemsize, const std::string &name);
+
+      //! Name of the shared memory segment
+      virtual std::string name() const = 0;
+
+      //! True while attached to the segment
+      virtual bool attached() const = 0;
+
+      //! Items skipped because the sink overran this reader
+      virtual uint64_t lost_items() const = 0;
+
+      //! Tags overwritten by the sink before they were read
+      virtual uint64_t lost_tags() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_SHM_SOURCE_H */
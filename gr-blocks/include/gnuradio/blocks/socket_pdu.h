@@ -32,6 +32,27 @@ namespace gr {
     /*!
      * \brief Creates socket interface and translates traffic to PDUs
      * \ingroup networking_tools_blk
+     *
+     * \details
+     * A TCP server sends each PDU to all its clients.  PDUs for a
+     * connection are queued and written a batch at a time in one
+     * gathered write, so a burst costs a few system calls rather than
+     * one per PDU and connection.  The sockets are served by
+     * \p io_threads threads.
+     *
+     * Without framing a TCP PDU is whatever one read returns, which
+     * need not match what the peer sent.  With \p framed, each PDU on
+     * a TCP stream is preceded by its length in bytes, as a 32-bit big
+     * endian number, and the PDUs come out as sent; a frame longer
+     * than \p MTU closes the connection.
+     *
+     * Both directions are bounded by the scheduler's limit on message
+     * queues, max_messages in the [DEFAULT] section of the config.  A
+     * connection queues at most that many PDUs, dropping the oldest
+     * when its peer falls behind, so one slow client does not hold up
+     * the rest.  Reading stops while a block subscribed to the pdus
+     * port has that many messages waiting, leaving TCP to slow the
+     * sender down.
      */
     class BLOCKS_API socket_pdu : virtual public block
     {
@@ -45,8 +66,11 @@ namespace gr {
        * \param addr network address to use
        * \param port network port to use
        * \param MTU maximum transmission unit
+       * \param framed prefix each PDU on a TCP stream with its length
+       * \param io_threads number of threads serving the sockets
        */
-      static sptr make(std::string type, std::string addr, std::string port, int MTU=10000);
+      static sptr make(std::string type, std::string addr, std::string port, int MTU=10000,
+                       bool framed=false, int io_threads=1);
     };
 
   } /* namespace blocks */
@@ -0,0 +1,162 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_TAG_LOG_H
+#define INCLUDED_BLOCKS_TAG_LOG_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/tags.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Writes stream tags to a tag log file.
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * A tag log holds the tags of a stream in offset order, in blocks
+     * of up to \p block_tags tags.  Each block starts with a fixed
+     * size header giving its size, its number of tags and the offsets
+     * of its first and last tag.  In a block, every key, value and
+     * source id is stored once, serialized with pmt::serialize_str,
+     * and the tags refer to them by number; the offsets are stored as
+     * differences.  The numbers are variable length, so that the
+     * repeated keys and values of a stream and its closely spaced
+     * offsets take a few bytes per tag.
+     *
+     * close() appends the offsets and file positions of the blocks,
+     * which tag_log_reader uses to find the block of an offset with a
+     * binary search.  A log that was not closed can still be read;
+     * the reader then walks the block headers to build the index.
+     */
+    class BLOCKS_API tag_log_writer
+    {
+    public:
+      /*!
+       * \param filename file to create or truncate
+       * \param block_tags number of tags per block
+       */
+      tag_log_writer(const std::string &filename,
+		     unsigned int block_tags = 1024);
+      ~tag_log_writer();
+
+      /*!
+       * \brief Adds a tag.
+       *
+       * Tags must be added in offset order, except within the block
+       * being filled.
+       */
+      void add(const tag_t &tag);
+
+      //! Writes out the block being filled
+      void flush();
+
+      //! Writes out the last block and the block index, and closes the file
+      void close();
+
+      //! Number of tags added
+      uint64_t ntags() const { return d_ntags; }
+
+    private:
+      struct block_info {
+	uint64_t first;
+	uint64_t last;
+	uint64_t pos;
+	uint64_t ntags;
+      };
+
+      FILE *d_fp;
+      unsigned int d_block_tags;
+      std::vector<tag_t> d_pending;
+      std::vector<block_info> d_blocks;
+      uint64_t d_ntags;
+    };
+
+    /*!
+     * \brief Reads the stream tags of a tag log file.
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * See tag_log_writer for the format.  The block of an offset is
+     * found with a binary search of the block index, and the last
+     * block read is kept, so reading a stream's tags in order reads
+     * each block once.  The keys and values of a block are
+     * deserialized when a tag returned refers to them, so reading a
+     * few tags after a seek does not deserialize the whole block.
+     */
+    class BLOCKS_API tag_log_reader
+    {
+    public:
+      tag_log_reader(const std::string &filename);
+      ~tag_log_reader();
+
+      //! Number of tags in the log
+      uint64_t ntags() const { return d_ntags; }
+
+      //! Number of blocks in the log
+      size_t nblocks() const { return d_blocks.size(); }
+
+      /*!
+       * \brief Appends the tags with offsets in [\p start, \p end) to
+       * \p tags, in offset order.
+       */
+      void get_tags(std::vector<tag_t> &tags, uint64_t start, uint64_t end);
+
+    private:
+      struct block_info {
+	uint64_t first;
+	uint64_t last;
+	uint64_t pos;
+	uint64_t ntags;
+      };
+
+      struct tag_ref {
+	uint64_t offset;
+	size_t key;
+	size_t value;
+	size_t srcid;
+      };
+
+      FILE *d_fp;
+      std::vector<block_info> d_blocks;
+      uint64_t d_ntags;
+      size_t d_cached;              // block in d_refs, or nblocks()
+      std::vector<char> d_payload;
+      std::vector<size_t> d_atom_pos;  // start, length in d_payload
+      std::vector<pmt::pmt_t> d_atoms; // deserialized when first used
+      std::vector<tag_ref> d_refs;
+
+      bool read_index();
+      void scan_blocks();
+      void decode(size_t n);
+      pmt::pmt_t atom(size_t i);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_TAG_LOG_H */
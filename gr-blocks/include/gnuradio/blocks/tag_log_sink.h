@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_TAG_LOG_SINK_H
+#define INCLUDED_BLOCKS_TAG_LOG_SINK_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Write stream and its tags to files.
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * Writes the items to \p filename, as file_sink does, and the
+     * tags on them to the tag log \p filename.tags (see
+     * tag_log_writer), with their offsets counted from the first item
+     * of the file.  tag_log_source plays both back.
+     *
+     * The tags are written out a block of \p block_tags at a time and
+     * the index of the log when the sink is closed or destroyed.
+     */
+    class BLOCKS_API tag_log_sink : virtual public sync_block
+    {
+    public:
+      // gr::blocks::tag_log_sink::sptr
+      typedef boost::shared_ptr<tag_log_sink> sptr;
+
+      /*!
+       * \brief Make a tag log sink.
+       * \param itemsize size of the input data items.
+       * \param filename name of the file to write the items to.
+       * \param block_tags number of tags per block of the tag log.
+       */
+      static sptr make(size_t itemsize, const char *filename,
+		       unsigned int block_tags = 1024);
+
+      //! Closes the files, writing out the tag log index
+      virtual void close() = 0;
+
+      //! Number of tags written
+      virtual uint64_t num_tags() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_TAG_LOG_SINK_H */
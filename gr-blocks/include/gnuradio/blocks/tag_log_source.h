@@ -0,0 +1,86 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_TAG_LOG_SOURCE_H
+#define INCLUDED_BLOCKS_TAG_LOG_SOURCE_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Read stream and its tags from files.
+     * \ingroup file_operators_blk
+     *
+     * \details
+     * Plays back the items of \p filename, as file_source does, with
+     * the tags of the tag log \p filename.tags (see tag_log_sink) on
+     * the items they were recorded on.  The tags keep their recorded
+     * keys, values and source ids.
+     *
+     * After a seek, the tags from the new position on are found with
+     * a binary search of the log's block index, so that seeking in a
+     * long recording reads no more than one block of tags.  A tag is
+     * emitted every time its item is played, also after a seek and on
+     * every repeat.
+     */
+    class BLOCKS_API tag_log_source : virtual public sync_block
+    {
+    public:
+      // gr::blocks::tag_log_source::sptr
+      typedef boost::shared_ptr<tag_log_source> sptr;
+
+      /*!
+       * \brief Create a tag log source.
+       *
+       * \param itemsize the size of each item in the file, in bytes
+       * \param filename name of the file to source from
+       * \param repeat repeat file from start
+       */
+      static sptr make(size_t itemsize, const char *filename,
+		       bool repeat = false);
+
+      /*!
+       * \brief seek file to \p seek_point relative to \p whence
+       *
+       * \param seek_point sample offset in file
+       * \param whence one of SEEK_SET, SEEK_CUR, SEEK_END (man fseek)
+       */
+      virtual bool seek(long seek_point, int whence) = 0;
+
+      //! Number of items in the file
+      virtual uint64_t file_items() const = 0;
+
+      //! Item offset in the file of the next item to play
+      virtual uint64_t position() const = 0;
+
+      //! Number of tags in the tag log
+      virtual uint64_t num_tags() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_TAG_LOG_SOURCE_H */
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_UDP_MMSG_SINK_H
+#define INCLUDED_BLOCKS_UDP_MMSG_SINK_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Write stream to a UDP socket, many packets at a time.
+     * \ingroup networking_tools_blk
+     *
+     * \details
+     * Sends the input in packets of \p payload_size bytes, a batch of
+     * packets per sendmmsg call where the system has it, with the
+     * payloads sent from the input buffer in place.  Only whole
+     * packets are sent.  With \p seq_header, each packet starts with
+     * a 32-bit big endian sequence number, which udp_mmsg_source
+     * checks with seq_offset 0, seq_shift 0 and seq_bits 32.
+     *
+     * Packets the system refuses, for example while nothing listens
+     * at the destination, are counted and dropped.  The packet counts
+     * and rate are available through ControlPort.
+     */
+    class BLOCKS_API udp_mmsg_sink : virtual public sync_block
+    {
+    public:
+      // gr::blocks::udp_mmsg_sink::sptr
+      typedef boost::shared_ptr<udp_mmsg_sink> sptr;
+
+      /*!
+       * \brief UDP batch sink constructor
+       *
+       * \param itemsize     The size (in bytes) of the item datatype
+       * \param host         The name or IP address of the receiving host
+       * \param port         Destination port
+       * \param payload_size UDP payload size, header included
+       * \param seq_header   Start each packet with a sequence number
+       * \param buffer_size  Socket send buffer size in bytes
+       */
+      static sptr make(size_t itemsize,
+		       const std::string &host, int port,
+		       int payload_size=1472,
+		       bool seq_header=false,
+		       int buffer_size=4*1024*1024);
+
+      //! Items per packet
+      virtual int items_per_packet() const = 0;
+
+      //! Packets sent
+      virtual uint64_t packets() const = 0;
+
+      //! Packets the system refused to send
+      virtual uint64_t send_errors() const = 0;
+
+      //! Packets sent per second, over the last second or so
+      virtual double packet_rate() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_UDP_MMSG_SINK_H */
@@ -0,0 +1,116 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_UDP_MMSG_SOURCE_H
+#define INCLUDED_BLOCKS_UDP_MMSG_SOURCE_H
+
+#include <gnuradio/blocks/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Read stream from a UDP socket, many packets at a time.
+     * \ingroup networking_tools_blk
+     *
+     * \details
+     * For high packet rates.  A thread of the block's own receives
+     * batches of packets with recvmmsg, where the system has it,
+     * straight into the slots of a ring, and work() copies their
+     * payloads to the output; the two sides share the ring without
+     * locks.  The socket is given a large receive buffer to ride out
+     * scheduling delays.  When the ring is full the packets are still
+     * read from the socket, and counted as overflows.
+     *
+     * Each packet may start with a header of \p header_size bytes,
+     * which is not output.  The payload after it should be a whole
+     * number of items.  If the header holds a sequence number, the
+     * block counts the packets lost on the way: the number is the
+     * \p seq_bits bits at bit \p seq_shift of the big endian 32-bit
+     * word at byte \p seq_offset of the packet, and counts up by one
+     * per packet.  For VITA-49 packets, the 4-bit packet count of the
+     * first header word is (0, 16, 4); for a plain 32-bit counter at
+     * the start of the packet it is (0, 0, 32).  A packet more than
+     * half the counter range behind is taken as late rather than as
+     * a gap.
+     *
+     * A "packets_lost" tag, with the number of packets lost to gaps
+     * and overflows as a uint64, goes on the first item of the packet
+     * after them.  The packet counts and rate are available through
+     * ControlPort.
+     */
+    class BLOCKS_API udp_mmsg_source : virtual public sync_block
+    {
+    public:
+      // gr::blocks::udp_mmsg_source::sptr
+      typedef boost::shared_ptr<udp_mmsg_source> sptr;
+
+      /*!
+       * \brief UDP batch source constructor
+       *
+       * \param itemsize     The size (in bytes) of the item datatype
+       * \param host         The name or IP address of the interface to
+       *                     receive on; empty or "0.0.0.0" for any
+       * \param port         The port number on which to receive data; use 0 to
+       *                     have the system assign an unused port number
+       * \param payload_size Largest UDP payload, header included
+       * \param header_size  Bytes of header at the start of each packet
+       * \param seq_offset   Byte offset of the word holding the
+       *                     sequence number, -1 for none
+       * \param seq_shift    Bit position of the sequence number in the word
+       * \param seq_bits     Width of the sequence number, 1 to 32
+       * \param buffer_size  Socket receive buffer size in bytes
+       * \param nslots       Number of packets the ring holds
+       */
+      static sptr make(size_t itemsize,
+		       const std::string &host, int port,
+		       int payload_size=1472,
+		       int header_size=0,
+		       int seq_offset=-1, int seq_shift=0, int seq_bits=32,
+		       int buffer_size=16*1024*1024,
+		       int nslots=16384);
+
+      //! Port number the socket is bound to
+      virtual int get_port() = 0;
+
+      //! Socket receive buffer size granted by the system
+      virtual int buffer_size() const = 0;
+
+      //! Packets received
+      virtual uint64_t packets() const = 0;
+
+      //! Packets lost, from the gaps in the sequence numbers
+      virtual uint64_t lost_packets() const = 0;
+
+      //! Packets received but dropped because the ring was full
+      virtual uint64_t overflows() const = 0;
+
+      //! Packets received per second, over the last second or so
+      virtual double packet_rate() const = 0;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_UDP_MMSG_SOURCE_H */
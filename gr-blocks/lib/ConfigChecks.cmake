@@ -51,6 +51,41 @@ CHECK_CXX_SOURCE_COMPILES("
 )
 GR_ADD_COND_DEF(HAVE_SELECT)
 
+########################################################################
+CHECK_CXX_SOURCE_COMPILES("
+    #include <linux/io_uring.h>
+    #include <sys/syscall.h>
+    int main(){return __NR_io_uring_setup + IORING_OP_WRITE;}
+    " HAVE_IO_URING
+)
+GR_ADD_COND_DEF(HAVE_IO_URING)
+
+CHECK_CXX_SOURCE_COMPILES("
+    #define _GNU_SOURCE
+    #include <fcntl.h>
+    int main(){return fallocate(0, FALLOC_FL_KEEP_SIZE, 0, 0);}
+    " HAVE_FALLOCATE
+)
+GR_ADD_COND_DEF(HAVE_FALLOCATE)
+
+CHECK_CXX_SOURCE_COMPILES("
+    #define _GNU_SOURCE
+    #include <sys/socket.h>
+    int main(){struct mmsghdr m; return recvmmsg(0, &m, 1, MSG_WAITFORONE, 0) + sendmmsg(0, &m, 1, 0);}
+    " HAVE_RECVMMSG
+)
+GR_ADD_COND_DEF(HAVE_RECVMMSG)
+
+SET(CMAKE_REQUIRED_LIBRARIES -lrt)
+CHECK_CXX_SOURCE_COMPILES("
+    #include <sys/types.h>
+    #include <sys/mman.h>
+    int main(){shm_open(0, 0, 0); return 0;}
+    " HAVE_SHM_OPEN
+)
+GR_ADD_COND_DEF(HAVE_SHM_OPEN)
+SET(CMAKE_REQUIRED_LIBRARIES)
+
 ########################################################################
 CHECK_INCLUDE_FILE_CXX(windows.h HAVE_WINDOWS_H)
 IF(HAVE_WINDOWS_H)
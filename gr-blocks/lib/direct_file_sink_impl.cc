@@ -0,0 +1,348 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "direct_file_sink_impl.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    direct_file_sink::sptr
+    direct_file_sink::make(size_t itemsize, const std::string &filename,
+			   double samp_rate, double relative_rate,
+			   gr_file_types type, bool complex,
+			   size_t max_segment_size,
+			   const std::string &extra_dict,
+			   size_t buffer_size, int nbuffers,
+			   size_t preallocate)
+    {
+      return gnuradio::get_initial_sptr
+	(new direct_file_sink_impl(itemsize, filename,
+				   samp_rate, relative_rate,
+				   type, complex,
+				   max_segment_size,
+				   extra_dict,
+				   buffer_size, nbuffers,
+				   preallocate));
+    }
+
+    direct_file_sink_impl::direct_file_sink_impl(size_t itemsize,
+						 const std::string &filename,
+						 double samp_rate, double relative_rate,
+						 gr_file_types type, bool complex,
+						 size_t max_segment_size,
+						 const std::string &extra_dict,
+						 size_t buffer_size, int nbuffers,
+						 size_t preallocate)
+      : sync_block("direct_file_sink",
+		   io_signature::make(1, 1, itemsize),
+		   io_signature::make(0, 0, 0)),
+	d_itemsize(itemsize),
+	d_samp_rate(samp_rate), d_relative_rate(relative_rate),
+	d_max_seg_size(max_segment_size), d_total_seg_size(0),
+	d_writer(0), d_hdr_fp(0), d_closed(false),
+	d_overflows(0), d_items_dropped(0)
+    {
+      if(nbuffers < 2)
+	throw std::invalid_argument("direct_file_sink: nbuffers must be at least 2");
+
+      std::string s = filename + ".hdr";
+      if((d_hdr_fp = fopen(s.c_str(), "wb")) == NULL) {
+	perror(s.c_str());
+	throw std::runtime_error("direct_file_sink: can't open file\n");
+      }
+
+      try {
+	d_writer = new direct_file_writer(filename, buffer_size,
+					  nbuffers, preallocate);
+      }
+      catch(...) {
+	fclose(d_hdr_fp);
+	throw;
+      }
+
+      pmt::pmt_t timestamp = pmt::make_tuple(pmt::from_uint64(0),
+					     pmt::from_double(0));
+
+      // handle extra dictionary
+      d_extra = pmt::make_dict();
+      if(extra_dict.size() > 0) {
+	pmt::pmt_t extras = pmt::deserialize_str(extra_dict);
+	pmt::pmt_t keys = pmt::dict_keys(extras);
+	pmt::pmt_t vals = pmt::dict_values(extras);
+	size_t nitems = pmt::length(keys);
+	for(size_t i = 0; i < nitems; i++) {
+	  d_extra = pmt::dict_add(d_extra,
+				  pmt::nth(i, keys),
+				  pmt::nth(i, vals));
+	}
+      }
+
+      d_extra_size = pmt::serialize_str(d_extra).size();
+
+      d_header = pmt::make_dict();
+      d_header = pmt::dict_add(d_header, pmt::mp("version"), pmt::mp(METADATA_VERSION));
+      d_header = pmt::dict_add(d_header, pmt::mp("rx_rate"), pmt::mp(samp_rate));
+      d_header = pmt::dict_add(d_header, pmt::mp("rx_time"), timestamp);
+      d_header = pmt::dict_add(d_header, pmt::mp("size"), pmt::from_long(d_itemsize));
+      d_header = pmt::dict_add(d_header, pmt::mp("type"), pmt::from_long(type));
+      d_header = pmt::dict_add(d_header, pmt::mp("cplx"), complex ? pmt::PMT_T : pmt::PMT_F);
+      d_header = pmt::dict_add(d_header, pmt::mp("strt"), pmt::from_uint64(METADATA_HEADER_SIZE+d_extra_size));
+      d_header = pmt::dict_add(d_header, pmt::mp("bytes"), pmt::from_uint64(0));
+
+      write_header(d_header, d_extra);
+    }
+
+    direct_file_sink_impl::~direct_file_sink_impl()
+    {
+      close();
+      delete d_writer;
+    }
+
+    void
+    direct_file_sink_impl::close()
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      if(d_closed)
+	return;
+
+      update_last_header();
+      d_writer->close();
+      fclose(d_hdr_fp);
+      d_hdr_fp = 0;
+      d_closed = true;
+    }
+
+    uint64_t
+    direct_file_sink_impl::items_written() const
+    {
+      return d_writer->bytes_written() / d_itemsize;
+    }
+
+    uint64_t
+    direct_file_sink_impl::write_errors() const
+    {
+      return d_writer->write_errors();
+    }
+
+    bool
+    direct_file_sink_impl::direct_io() const
+    {
+      return d_writer->direct_io();
+    }
+
+    bool
+    direct_file_sink_impl::uses_io_uring() const
+    {
+      return d_writer->uses_io_uring();
+    }
+
+    void
+    direct_file_sink_impl::write_header(pmt::pmt_t header, pmt::pmt_t extra)
+    {
+      std::string header_str = pmt::serialize_str(header);
+      std::string extra_str = pmt::serialize_str(extra);
+
+      if((header_str.size() != METADATA_HEADER_SIZE) && (extra_str.size() != d_extra_size))
+	throw std::runtime_error("direct_file_sink: header or extras is wrong size.\n");
+
+      if((fwrite(header_str.c_str(), 1, header_str.size(), d_hdr_fp) != header_str.size()) ||
+	 (fwrite(extra_str.c_str(), 1, extra_str.size(), d_hdr_fp) != extra_str.size()))
+	throw std::runtime_error("direct_file_sink: error writing header to file.\n");
+
+      fflush(d_hdr_fp);
+    }
+
+    void
+    direct_file_sink_impl::update_header(pmt::pmt_t key, pmt::pmt_t value)
+    {
+      // Special handling caveat to transform rate from radio source into
+      // the rate at this sink.
+      if(pmt::eq(key, pmt::mp("rx_rate"))) {
+	d_samp_rate = pmt::to_double(value);
+	value = pmt::from_double(d_samp_rate*d_relative_rate);
+      }
+
+      // If the tag is not part of the standard header, we put it into the
+      // extra data, which either updates the current dictionary or adds a
+      // new item.
+      if(pmt::dict_has_key(d_header, key)) {
+	d_header = pmt::dict_add(d_header, key, value);
+      }
+      else {
+	d_extra = pmt::dict_add(d_extra, key, value);
+	d_extra_size = pmt::serialize_str(d_extra).size();
+      }
+    }
+
+    void
+    direct_file_sink_impl::update_last_header()
+    {
+      // Update the last header info with the number of samples this
+      // block represents.
+      size_t hdrlen = pmt::to_uint64(pmt::dict_ref(d_header, pmt::mp("strt"), pmt::PMT_NIL));
+      size_t seg_size = d_itemsize*d_total_seg_size;
+      update_header(pmt::mp("bytes"), pmt::from_uint64(seg_size));
+      update_header(pmt::mp("strt"), pmt::from_uint64(METADATA_HEADER_SIZE+d_extra_size));
+      fseek(d_hdr_fp, -(long)hdrlen, SEEK_CUR);
+      write_header(d_header, d_extra);
+    }
+
+    void
+    direct_file_sink_impl::write_and_update()
+    {
+      // New header, so set current size of chunk to 0 and start of chunk
+      // based on current index + header size.
+      update_header(pmt::mp("bytes"), pmt::from_uint64(0));
+      update_header(pmt::mp("strt"), pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size));
+      write_header(d_header, d_extra);
+    }
+
+    void
+    direct_file_sink_impl::update_rx_time(uint64_t nitems)
+    {
+      pmt::pmt_t rx_time = pmt::string_to_symbol("rx_time");
+      pmt::pmt_t r = pmt::dict_ref(d_header, rx_time, pmt::PMT_NIL);
+      uint64_t secs = pmt::to_uint64(pmt::tuple_ref(r, 0));
+      double fracs = pmt::to_double(pmt::tuple_ref(r, 1));
+      double diff = nitems / (d_samp_rate*d_relative_rate);
+
+      fracs += diff;
+      uint64_t new_secs = static_cast<uint64_t>(fracs);
+      secs += new_secs;
+      fracs -= new_secs;
+
+      r = pmt::make_tuple(pmt::from_uint64(secs), pmt::from_double(fracs));
+      d_header = pmt::dict_add(d_header, rx_time, r);
+    }
+
+    void
+    direct_file_sink_impl::drop(uint64_t nitems)
+    {
+      d_overflows++;
+      d_items_dropped += nitems;
+
+      // Close the segment at the gap and start the next one at the
+      // time of the first sample after it; an empty segment just has
+      // its time moved on.
+      if(d_total_seg_size > 0) {
+	update_last_header();
+	update_rx_time(d_total_seg_size + nitems);
+	write_and_update();
+	d_total_seg_size = 0;
+      }
+      else {
+	update_rx_time(nitems);
+	update_last_header();
+      }
+    }
+
+    size_t
+    direct_file_sink_impl::write_items(const char *buf, size_t nitems)
+    {
+      size_t taken = d_writer->write(buf, nitems*d_itemsize, d_itemsize) / d_itemsize;
+      d_total_seg_size += taken;
+      if(taken < nitems)
+	drop(nitems - taken);
+      return nitems;
+    }
+
+    int
+    direct_file_sink_impl::work(int noutput_items,
+				gr_vector_const_void_star &input_items,
+				gr_vector_void_star &output_items)
+    {
+      const char *inbuf = (const char*)input_items[0];
+      int nwritten = 0;
+
+      gr::thread::scoped_lock guard(d_mutex);
+      if(d_closed)
+	return noutput_items;		// drop output on the floor
+
+      uint64_t abs_N = nitems_read(0);
+      uint64_t end_N = abs_N + (uint64_t)(noutput_items);
+      std::vector<tag_t> all_tags;
+      get_tags_in_range(all_tags, 0, abs_N, end_N);
+
+      std::vector<tag_t>::iterator itr;
+      for(itr = all_tags.begin(); itr != all_tags.end(); itr++) {
+	int item_offset = (int)(itr->offset - abs_N);
+
+	// Write data to file up to the next tag location
+	while(nwritten < item_offset) {
+	  size_t towrite = std::min(d_max_seg_size - d_total_seg_size,
+				    (size_t)(item_offset - nwritten));
+	  int count = write_items(inbuf, towrite);
+	  nwritten += count;
+	  inbuf += count * d_itemsize;
+
+	  // Only add a new header if we are not at the position of the
+	  // next tag
+	  if((d_total_seg_size == d_max_seg_size) &&
+	     (nwritten < item_offset)) {
+	    update_last_header();
+	    update_rx_time(d_total_seg_size);
+	    write_and_update();
+	    d_total_seg_size = 0;
+	  }
+	}
+
+	if(d_total_seg_size > 0) {
+	  update_last_header();
+	  update_header(itr->key, itr->value);
+	  write_and_update();
+	  d_total_seg_size = 0;
+	}
+	else {
+	  update_header(itr->key, itr->value);
+	  update_last_header();
+	}
+      }
+
+      // Finish up the rest of the data after tags
+      while(nwritten < noutput_items) {
+	size_t towrite = std::min(d_max_seg_size - d_total_seg_size,
+				  (size_t)(noutput_items - nwritten));
+	int count = write_items(inbuf, towrite);
+	nwritten += count;
+	inbuf += count * d_itemsize;
+
+	if(d_total_seg_size == d_max_seg_size) {
+	  update_last_header();
+	  update_rx_time(d_total_seg_size);
+	  write_and_update();
+	  d_total_seg_size = 0;
+	}
+      }
+
+      return nwritten;
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,91 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_DIRECT_FILE_SINK_IMPL_H
+#define INCLUDED_BLOCKS_DIRECT_FILE_SINK_IMPL_H
+
+#include <gnuradio/blocks/direct_file_sink.h>
+#include "direct_file_writer.h"
+#include <gnuradio/thread/thread.h>
+#include <pmt/pmt.h>
+#include <cstdio>
+
+namespace gr {
+  namespace blocks {
+
+    class direct_file_sink_impl : public direct_file_sink
+    {
+    private:
+      size_t d_itemsize;
+      double d_samp_rate;
+      double d_relative_rate;
+      size_t d_max_seg_size;
+      size_t d_total_seg_size;
+      pmt::pmt_t d_header;
+      pmt::pmt_t d_extra;
+      size_t d_extra_size;
+
+      direct_file_writer *d_writer;
+      FILE *d_hdr_fp;
+      bool d_closed;
+      gr::thread::mutex d_mutex;
+
+      uint64_t d_overflows;
+      uint64_t d_items_dropped;
+
+      void write_header(pmt::pmt_t header, pmt::pmt_t extra);
+      void update_header(pmt::pmt_t key, pmt::pmt_t value);
+      void update_last_header();
+      void write_and_update();
+      void update_rx_time(uint64_t nitems);
+      size_t write_items(const char *buf, size_t nitems);
+      void drop(uint64_t nitems);
+
+    public:
+      direct_file_sink_impl(size_t itemsize, const std::string &filename,
+			    double samp_rate, double relative_rate,
+			    gr_file_types type, bool complex,
+			    size_t max_segment_size,
+			    const std::string &extra_dict,
+			    size_t buffer_size, int nbuffers,
+			    size_t preallocate);
+      ~direct_file_sink_impl();
+
+      void close();
+
+      uint64_t overflows() const { return d_overflows; }
+      uint64_t items_dropped() const { return d_items_dropped; }
+      uint64_t items_written() const;
+      uint64_t write_errors() const;
+      bool direct_io() const;
+      bool uses_io_uring() const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_DIRECT_FILE_SINK_IMPL_H */
@@ -0,0 +1,519 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE		// O_DIRECT, fallocate
+#endif
+
+#include "direct_file_writer.h"
+#include <volk/volk.h>
+#include <boost/bind.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+// win32 (mingw/msvc) specific
+#ifdef HAVE_IO_H
+#include <io.h>
+#endif
+#ifdef O_BINARY
+#define	OUR_O_BINARY O_BINARY
+#else
+#define	OUR_O_BINARY 0
+#endif
+
+// should be handled via configure
+#ifdef O_LARGEFILE
+#define	OUR_O_LARGEFILE	O_LARGEFILE
+#else
+#define	OUR_O_LARGEFILE 0
+#endif
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace gr {
+  namespace blocks {
+
+    // Alignment of buffers, offsets and sizes for O_DIRECT; a page
+    // covers the logical block size of the usual devices.
+    static const size_t ALIGNMENT = 4096;
+
+    static ssize_t
+    write_at(int fd, const char *buf, size_t size, uint64_t offset)
+    {
+#ifdef HAVE_UNISTD_H
+      return pwrite(fd, buf, size, offset);
+#else
+      if(lseek(fd, offset, SEEK_SET) < 0)
+	return -1;
+      return ::write(fd, buf, size);
+#endif
+    }
+
+#ifdef HAVE_IO_URING
+    /*
+     * A minimal io_uring for writes, on the raw system calls so that
+     * no library is needed.
+     */
+    struct direct_file_writer::uring
+    {
+      int fd;
+      bool failed;                  // writes fall back to pwrite
+      void *sq_ptr, *cq_ptr;
+      size_t sq_size, cq_size, sqes_size;
+      io_uring_sqe *sqes;
+      unsigned int *sq_tail, *sq_mask, *sq_array;
+      unsigned int *cq_head, *cq_tail, *cq_mask;
+      io_uring_cqe *cqes;
+
+      uring()
+	: fd(-1), failed(false), sq_ptr(MAP_FAILED), cq_ptr(MAP_FAILED),
+	  sqes_size(0), sqes(0)
+      {
+      }
+
+      ~uring()
+      {
+	if(sqes)
+	  munmap(sqes, sqes_size);
+	if(cq_ptr != MAP_FAILED && cq_ptr != sq_ptr)
+	  munmap(cq_ptr, cq_size);
+	if(sq_ptr != MAP_FAILED)
+	  munmap(sq_ptr, sq_size);
+	if(fd >= 0)
+	  ::close(fd);
+      }
+
+      bool open(unsigned int entries)
+      {
+	io_uring_params p;
+	memset(&p, 0, sizeof(p));
+	fd = syscall(__NR_io_uring_setup, entries, &p);
+	if(fd < 0)
+	  return false;
+
+	sq_size = p.sq_off.array + p.sq_entries*sizeof(unsigned int);
+	cq_size = p.cq_off.cqes + p.cq_entries*sizeof(io_uring_cqe);
+	bool single = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+	single = p.features & IORING_FEAT_SINGLE_MMAP;
+#endif
+	if(single)
+	  sq_size = cq_size = std::max(sq_size, cq_size);
+
+	sq_ptr = mmap(0, sq_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+		      fd, IORING_OFF_SQ_RING);
+	if(sq_ptr == MAP_FAILED)
+	  return false;
+	if(single)
+	  cq_ptr = sq_ptr;
+	else
+	  cq_ptr = mmap(0, cq_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+			fd, IORING_OFF_CQ_RING);
+	if(cq_ptr == MAP_FAILED)
+	  return false;
+
+	sqes_size = p.sq_entries*sizeof(io_uring_sqe);
+	void *s = mmap(0, sqes_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_POPULATE,
+		       fd, IORING_OFF_SQES);
+	if(s == MAP_FAILED)
+	  return false;
+	sqes = (io_uring_sqe*)s;
+
+	char *sq = (char*)sq_ptr;
+	char *cq = (char*)cq_ptr;
+	sq_tail = (unsigned int*)(sq + p.sq_off.tail);
+	sq_mask = (unsigned int*)(sq + p.sq_off.ring_mask);
+	sq_array = (unsigned int*)(sq + p.sq_off.array);
+	cq_head = (unsigned int*)(cq + p.cq_off.head);
+	cq_tail = (unsigned int*)(cq + p.cq_off.tail);
+	cq_mask = (unsigned int*)(cq + p.cq_off.ring_mask);
+	cqes = (io_uring_cqe*)(cq + p.cq_off.cqes);
+	return true;
+      }
+
+      // The ring has an entry for every buffer, so it never fills
+      bool submit(int filefd, const char *buf, size_t size, uint64_t offset,
+		  uint64_t user_data)
+      {
+	unsigned int tail = *sq_tail;
+	unsigned int idx = tail & *sq_mask;
+	io_uring_sqe *sqe = &sqes[idx];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_WRITE;
+	sqe->fd = filefd;
+	sqe->off = offset;
+	sqe->addr = (uint64_t)(uintptr_t)buf;
+	sqe->len = size;
+	sqe->user_data = user_data;
+	sq_array[idx] = idx;
+	__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	int ret;
+	do {
+	  ret = syscall(__NR_io_uring_enter, fd, 1, 0, 0, NULL, 0);
+	} while(ret < 0 && errno == EINTR);
+	return ret == 1;
+      }
+
+      // Waits for at least one completion and returns all there are
+      void reap(std::vector<std::pair<uint64_t, int> > &done)
+      {
+	int ret;
+	do {
+	  ret = syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+	} while(ret < 0 && errno == EINTR);
+
+	unsigned int head = *cq_head;
+	while(head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+	  io_uring_cqe *cqe = &cqes[head & *cq_mask];
+	  done.push_back(std::make_pair((uint64_t)cqe->user_data, (int)cqe->res));
+	  head++;
+	}
+	__atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+      }
+    };
+#else
+    struct direct_file_writer::uring
+    {
+      bool failed;
+      uring() : failed(true) {}
+      bool open(unsigned int) { return false; }
+      bool submit(int, const char*, size_t, uint64_t, uint64_t) { return false; }
+      void reap(std::vector<std::pair<uint64_t, int> > &) {}
+    };
+#endif /* HAVE_IO_URING */
+
+    direct_file_writer::direct_file_writer(const std::string &filename,
+					   size_t buffer_size,
+					   unsigned int nbuffers,
+					   uint64_t preallocate)
+      : d_fd(-1), d_direct(false), d_prealloc(preallocate), d_allocated(0),
+	d_filling(false), d_fill(0), d_fill_bytes(0), d_offset(0), d_queued(0),
+	d_done(false), d_written(0), d_errors(0), d_uring(0)
+    {
+      if(buffer_size == 0)
+	throw std::invalid_argument("direct_file_writer: buffer_size must be > 0");
+      if(nbuffers < 2)
+	throw std::invalid_argument("direct_file_writer: nbuffers must be >= 2");
+
+      d_bufsize = (buffer_size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+      int flags = O_WRONLY|O_CREAT|O_TRUNC|OUR_O_LARGEFILE|OUR_O_BINARY;
+#ifdef O_DIRECT
+      d_fd = ::open(filename.c_str(), flags|O_DIRECT, 0664);
+      d_direct = d_fd >= 0;
+#endif
+      if(d_fd < 0)		// no direct I/O on this file system
+	d_fd = ::open(filename.c_str(), flags, 0664);
+      if(d_fd < 0) {
+	std::string s = "direct_file_writer: can't open " + filename + ": " + strerror(errno);
+	throw std::runtime_error(s);
+      }
+
+      d_buffers.resize(nbuffers);
+      d_jobs.resize(nbuffers);
+      for(unsigned int i = 0; i < nbuffers; i++) {
+	d_buffers[i] = (char*)volk_malloc(d_bufsize, ALIGNMENT);
+	d_free.push_back(i);
+      }
+
+      d_uring = new uring();
+      if(!d_uring->open(nbuffers)) {
+	delete d_uring;
+	d_uring = 0;
+      }
+
+      allocate_to(d_prealloc);
+
+      d_thread = gr::thread::thread(boost::bind(&direct_file_writer::run, this));
+    }
+
+    direct_file_writer::~direct_file_writer()
+    {
+      close();
+      for(unsigned int i = 0; i < d_buffers.size(); i++)
+	volk_free(d_buffers[i]);
+    }
+
+    size_t
+    direct_file_writer::write(const void *data, size_t nbytes, size_t unit)
+    {
+      if(d_fd < 0)
+	return 0;
+
+      // Buffers are only freed behind our back, so all of this room
+      // stays ours.
+      size_t room;
+      {
+	gr::thread::scoped_lock lock(d_mutex);
+	room = d_free.size() * d_bufsize;
+      }
+      if(d_filling)
+	room += d_bufsize - d_fill_bytes;
+
+      const size_t n = std::min(nbytes, room / unit * unit);
+      const char *in = (const char*)data;
+      size_t left = n;
+      while(left > 0) {
+	if(!d_filling) {
+	  gr::thread::scoped_lock lock(d_mutex);
+	  d_fill = d_free.front();
+	  d_free.pop_front();
+	  d_fill_bytes = 0;
+	  d_filling = true;
+	}
+
+	size_t count = std::min(left, d_bufsize - d_fill_bytes);
+	memcpy(d_buffers[d_fill] + d_fill_bytes, in, count);
+	d_fill_bytes += count;
+	in += count;
+	left -= count;
+
+	if(d_fill_bytes == d_bufsize) {
+	  queue(d_fill, d_bufsize, d_bufsize);
+	  d_filling = false;
+	}
+      }
+
+      d_queued += n;
+      return n;
+    }
+
+    void
+    direct_file_writer::close()
+    {
+      if(d_fd < 0)
+	return;
+
+      if(d_filling) {
+	if(d_fill_bytes > 0) {
+	  // O_DIRECT writes whole blocks; the padding is cut off below
+	  size_t size = d_fill_bytes;
+	  if(d_direct)
+	    size = (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	  memset(d_buffers[d_fill] + d_fill_bytes, 0, size - d_fill_bytes);
+	  queue(d_fill, size, d_fill_bytes);
+	}
+	else {
+	  gr::thread::scoped_lock lock(d_mutex);
+	  d_free.push_back(d_fill);
+	}
+	d_filling = false;
+      }
+
+      {
+	gr::thread::scoped_lock lock(d_mutex);
+	d_done = true;
+	d_cond.notify_one();
+      }
+      d_thread.join();
+
+#ifdef HAVE_UNISTD_H
+      // Drop the padding of the last block
+      if(ftruncate(d_fd, d_queued) < 0)
+	perror("direct_file_writer: ftruncate");
+#endif
+      ::close(d_fd);
+      d_fd = -1;
+
+      delete d_uring;
+      d_uring = 0;
+    }
+
+    uint64_t
+    direct_file_writer::bytes_queued() const
+    {
+      return d_queued;
+    }
+
+    uint64_t
+    direct_file_writer::bytes_written() const
+    {
+      gr::thread::scoped_lock lock(d_mutex);
+      return d_written;
+    }
+
+    uint64_t
+    direct_file_writer::write_errors() const
+    {
+      gr::thread::scoped_lock lock(d_mutex);
+      return d_errors;
+    }
+
+    bool
+    direct_file_writer::uses_io_uring() const
+    {
+      return d_uring != 0 && !d_uring->failed;
+    }
+
+    void
+    direct_file_writer::queue(unsigned int index, size_t size, size_t valid)
+    {
+      gr::thread::scoped_lock lock(d_mutex);
+      job j;
+      j.index = index;
+      j.offset = d_offset;
+      j.size = size;
+      j.valid = valid;
+      d_full.push_back(j);
+      d_offset += size;
+      d_cond.notify_one();
+    }
+
+    void
+    direct_file_writer::run()
+    {
+      unsigned int inflight = 0;
+
+      for(;;) {
+	job j;
+	bool have = false;
+	{
+	  gr::thread::scoped_lock lock(d_mutex);
+	  while(d_full.empty() && !d_done && inflight == 0)
+	    d_cond.wait(lock);
+	  if(!d_full.empty()) {
+	    j = d_full.front();
+	    d_full.pop_front();
+	    have = true;
+	  }
+	  else if(inflight == 0)
+	    break;		// closed and everything written
+	}
+
+	if(have) {
+	  allocate_to(j.offset + j.size);
+	  if(uses_io_uring() && uring_submit(j)) {
+	    // keep submitting while there are buffers to write
+	    if(++inflight < d_buffers.size())
+	      continue;
+	  }
+	  else {
+	    write_job(j, 0);
+	    continue;
+	  }
+	}
+
+	inflight -= uring_reap();
+      }
+    }
+
+    void
+    direct_file_writer::allocate_to(uint64_t end)
+    {
+#ifdef HAVE_FALLOCATE
+      if(d_prealloc == 0 || end <= d_allocated)
+	return;
+
+      uint64_t len = std::max(d_prealloc, end - d_allocated);
+      if(fallocate(d_fd, FALLOC_FL_KEEP_SIZE, d_allocated, len) == 0)
+	d_allocated += len;
+      else
+	d_prealloc = 0;		// not supported here; stop trying
+#endif
+    }
+
+    void
+    direct_file_writer::write_job(const job &j, size_t done)
+    {
+      const char *buf = d_buffers[j.index];
+      while(done < j.size) {
+	ssize_t ret = write_at(d_fd, buf + done, j.size - done, j.offset + done);
+	if(ret < 0 && errno == EINTR)
+	  continue;
+	if(ret <= 0) {
+	  release(j, false);
+	  return;
+	}
+	done += ret;
+      }
+      release(j, true);
+    }
+
+    void
+    direct_file_writer::release(const job &j, bool ok)
+    {
+      gr::thread::scoped_lock lock(d_mutex);
+      if(ok)
+	d_written += j.valid;
+      else if(d_errors++ == 0)
+	perror("direct_file_writer: write");
+      d_free.push_back(j.index);
+    }
+
+    bool
+    direct_file_writer::uring_submit(const job &j)
+    {
+      d_jobs[j.index] = j;
+      if(d_uring->submit(d_fd, d_buffers[j.index], j.size, j.offset, j.index))
+	return true;
+      d_uring->failed = true;
+      return false;
+    }
+
+    unsigned int
+    direct_file_writer::uring_reap()
+    {
+      std::vector<std::pair<uint64_t, int> > done;
+      d_uring->reap(done);
+
+      for(size_t i = 0; i < done.size(); i++) {
+	const job &j = d_jobs[done[i].first];
+	int res = done[i].second;
+	if(res == (int)j.size)
+	  release(j, true);
+	else if(res >= 0)
+	  write_job(j, res);	// short write, finish it here
+	else if(res == -EINVAL || res == -EOPNOTSUPP) {
+	  // a kernel without IORING_OP_WRITE
+	  d_uring->failed = true;
+	  write_job(j, 0);
+	}
+	else {
+	  errno = -res;
+	  release(j, false);
+	}
+      }
+      return done.size();
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,140 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DIRECT_FILE_WRITER_H
+#define INCLUDED_DIRECT_FILE_WRITER_H
+
+#include <gnuradio/thread/thread.h>
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Writes a file from a thread of its own, bypassing the
+     * page cache where it can.
+     *
+     * The caller copies into one of a set of aligned buffers; full
+     * buffers are queued to the writer thread, which writes them with
+     * O_DIRECT, through io_uring where the kernel supports it so that
+     * all of them can be in flight at once, and with pwrite
+     * otherwise.  The file is preallocated ahead of the writes.  When
+     * every buffer is full or being written, write() takes what it
+     * can and the caller drops the rest instead of waiting on the
+     * disk.
+     */
+    class direct_file_writer
+    {
+    public:
+      /*!
+       * \param filename file to create or truncate
+       * \param buffer_size size of each buffer in bytes, rounded up
+       *        to the direct I/O alignment
+       * \param nbuffers number of buffers, at least 2
+       * \param preallocate bytes to allocate ahead of the writes, 0
+       *        for none
+       */
+      direct_file_writer(const std::string &filename, size_t buffer_size,
+			 unsigned int nbuffers, uint64_t preallocate);
+      ~direct_file_writer();
+
+      /*!
+       * \brief Queues up to \p nbytes from \p data for writing.
+       *
+       * Takes a whole number of \p unit bytes: all of them if there
+       * is room in the buffers, otherwise as many as fit.  Returns
+       * the number of bytes taken.  Never waits for the disk.
+       */
+      size_t write(const void *data, size_t nbytes, size_t unit = 1);
+
+      //! Writes what is left, waits for the writes and closes the file
+      void close();
+
+      //! Bytes taken by write()
+      uint64_t bytes_queued() const;
+
+      //! Bytes that have reached the file
+      uint64_t bytes_written() const;
+
+      //! Writes that failed
+      uint64_t write_errors() const;
+
+      //! True if the file is open with O_DIRECT
+      bool direct_io() const { return d_direct; }
+
+      //! True if the writes go through io_uring
+      bool uses_io_uring() const;
+
+    private:
+      struct job {
+	unsigned int index;         // buffer
+	uint64_t offset;            // file offset
+	size_t size;                // bytes to write, padded when closing
+	size_t valid;               // bytes of data
+      };
+      struct uring;
+
+      int d_fd;
+      bool d_direct;
+      size_t d_bufsize;
+      std::vector<char*> d_buffers;
+      uint64_t d_prealloc;          // bytes to allocate at a time
+      uint64_t d_allocated;         // bytes allocated so far
+
+      // Producer side
+      bool d_filling;               // d_fill is taken from d_free
+      unsigned int d_fill;
+      size_t d_fill_bytes;
+      uint64_t d_offset;            // file offset of the next buffer
+      uint64_t d_queued;
+
+      // Shared with the writer thread
+      mutable gr::thread::mutex d_mutex;
+      gr::thread::condition_variable d_cond;
+      std::deque<unsigned int> d_free;
+      std::deque<job> d_full;
+      bool d_done;
+      uint64_t d_written;
+      uint64_t d_errors;
+
+      // Writer thread
+      std::vector<job> d_jobs;      // job of each buffer in flight
+      uring *d_uring;
+      gr::thread::thread d_thread;
+
+      void queue(unsigned int index, size_t size, size_t valid);
+      void run();
+      void allocate_to(uint64_t end);
+      void write_job(const job &j, size_t done);
+      void release(const job &j, bool ok);
+      bool uring_submit(const job &j);
+      unsigned int uring_reap();
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIRECT_FILE_WRITER_H */
@@ -0,0 +1,197 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/blocks/file_meta_index.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    static const char INDEX_MAGIC[file_meta_index::HEADER_SIZE] =
+      {'G', 'R', 'M', 'I', 'D', 'X', '0', '1'};
+
+    static void
+    put_u64(unsigned char *p, uint64_t v)
+    {
+      for(int i = 7; i >= 0; i--) {
+	p[i] = v & 0xff;
+	v >>= 8;
+      }
+    }
+
+    static uint64_t
+    get_u64(const unsigned char *p)
+    {
+      uint64_t v = 0;
+      for(int i = 0; i < 8; i++)
+	v = (v << 8) | p[i];
+      return v;
+    }
+
+    static void
+    put_double(unsigned char *p, double d)
+    {
+      uint64_t v;
+      memcpy(&v, &d, sizeof(v));
+      put_u64(p, v);
+    }
+
+    static double
+    get_double(const unsigned char *p)
+    {
+      uint64_t v = get_u64(p);
+      double d;
+      memcpy(&d, &v, sizeof(d));
+      return d;
+    }
+
+    file_meta_index::file_meta_index(const std::string &filename, bool create)
+    {
+      d_fp = fopen(filename.c_str(), create ? "w+b" : "rb");
+      if(d_fp == NULL)
+	throw std::runtime_error("file_meta_index: can't open " + filename);
+
+      if(create) {
+	if(fwrite(INDEX_MAGIC, 1, HEADER_SIZE, d_fp) != HEADER_SIZE) {
+	  fclose(d_fp);
+	  throw std::runtime_error("file_meta_index: error writing index");
+	}
+	fflush(d_fp);
+      }
+      else {
+	char magic[HEADER_SIZE];
+	if(fread(magic, 1, HEADER_SIZE, d_fp) != HEADER_SIZE ||
+	   memcmp(magic, INDEX_MAGIC, HEADER_SIZE) != 0) {
+	  fclose(d_fp);
+	  throw std::runtime_error("file_meta_index: " + filename + " is not an index");
+	}
+      }
+    }
+
+    file_meta_index::~file_meta_index()
+    {
+      fclose(d_fp);
+    }
+
+    void
+    file_meta_index::write_entry(uint64_t n, const entry &e)
+    {
+      unsigned char rec[ENTRY_SIZE];
+      put_u64(rec, e.hdr_offset);
+      put_u64(rec + 8, e.data_offset);
+      put_u64(rec + 16, e.item);
+      put_u64(rec + 24, e.nitems);
+      put_u64(rec + 32, e.secs);
+      put_double(rec + 40, e.fracs);
+      put_double(rec + 48, e.rate);
+
+      if(fseek(d_fp, HEADER_SIZE + n*ENTRY_SIZE, SEEK_SET) != 0 ||
+	 fwrite(rec, 1, ENTRY_SIZE, d_fp) != ENTRY_SIZE)
+	throw std::runtime_error("file_meta_index: error writing index");
+
+      // Keep the index readable while the recording goes on
+      fflush(d_fp);
+    }
+
+    void
+    file_meta_index::append(const entry &e)
+    {
+      write_entry(size(), e);
+    }
+
+    void
+    file_meta_index::update_last(const entry &e)
+    {
+      uint64_t n = size();
+      if(n == 0)
+	throw std::runtime_error("file_meta_index: no segment to update");
+      write_entry(n - 1, e);
+    }
+
+    uint64_t
+    file_meta_index::size() const
+    {
+      if(fseek(d_fp, 0, SEEK_END) != 0)
+	return 0;
+      long len = ftell(d_fp);
+      if(len < (long)HEADER_SIZE)
+	return 0;
+      return (len - HEADER_SIZE) / ENTRY_SIZE;
+    }
+
+    file_meta_index::entry
+    file_meta_index::at(uint64_t n) const
+    {
+      unsigned char rec[ENTRY_SIZE];
+      if(fseek(d_fp, HEADER_SIZE + n*ENTRY_SIZE, SEEK_SET) != 0 ||
+	 fread(rec, 1, ENTRY_SIZE, d_fp) != ENTRY_SIZE)
+	throw std::out_of_range("file_meta_index: no such segment");
+
+      entry e;
+      e.hdr_offset = get_u64(rec);
+      e.data_offset = get_u64(rec + 8);
+      e.item = get_u64(rec + 16);
+      e.nitems = get_u64(rec + 24);
+      e.secs = get_u64(rec + 32);
+      e.fracs = get_double(rec + 40);
+      e.rate = get_double(rec + 48);
+      return e;
+    }
+
+    int64_t
+    file_meta_index::find_time(uint64_t secs, double fracs) const
+    {
+      // Number of segments that start at or before the time
+      uint64_t lo = 0, hi = size();
+      while(lo < hi) {
+	uint64_t mid = lo + (hi - lo) / 2;
+	entry e = at(mid);
+	if(e.secs < secs || (e.secs == secs && e.fracs <= fracs))
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+      return (int64_t)lo - 1;
+    }
+
+    int64_t
+    file_meta_index::find_item(uint64_t item) const
+    {
+      uint64_t lo = 0, hi = size();
+      while(lo < hi) {
+	uint64_t mid = lo + (hi - lo) / 2;
+	if(at(mid).item <= item)
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+      return (int64_t)lo - 1;
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
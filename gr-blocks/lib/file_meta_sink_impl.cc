@@ -32,6 +32,7 @@
 #include <fcntl.h>
 #include <stdexcept>
 #include <stdio.h>
+#include <iostream>
 
 // win32 (mingw/msvc) specific
 #ifdef HAVE_IO_H
@@ -61,7 +62,8 @@ namespace gr {
 			 gr_file_types type, bool complex,
 			 size_t max_segment_size,
 			 const std::string &extra_dict,
-			 bool detached_header)
+			 bool detached_header,
+			 bool index)
     {
       return gnuradio::get_initial_sptr
 	(new file_meta_sink_impl(itemsize, filename,
@@ -69,7 +71,8 @@ namespace gr {
 				 type, complex,
 				 max_segment_size,
 				 extra_dict,
-				 detached_header));
+				 detached_header,
+				 index));
     }
 
     file_meta_sink_impl::file_meta_sink_impl(size_t itemsize,
@@ -78,14 +81,16 @@ namespace gr {
 					     gr_file_types type, bool complex,
 					     size_t max_segment_size,
 					     const std::string &extra_dict,
-					     bool detached_header)
+					     bool detached_header,
+					     bool index)
       : sync_block("file_meta_sink",
 		      io_signature::make(1, 1, itemsize),
 		      io_signature::make(0, 0, 0)),
 	d_itemsize(itemsize),
 	d_samp_rate(samp_rate), d_relative_rate(relative_rate),
 	d_max_seg_size(max_segment_size), d_total_seg_size(0),
-	d_updated(false), d_unbuffered(false)
+	d_updated(false), d_unbuffered(false),
+	d_use_index(index), d_new_index(0), d_index(0), d_items(0)
     {
       d_fp = 0;
       d_new_fp = 0;
@@ -135,6 +140,7 @@ namespace gr {
 	write_header(d_hdr_fp, d_header, d_extra);
       else
 	write_header(d_fp, d_header, d_extra);
+      index_append(0);
     }
 
     file_meta_sink_impl::~file_meta_sink_impl()
@@ -152,6 +158,9 @@ namespace gr {
 	  d_hdr_fp = 0;
 	}
       }
+
+      delete d_index;
+      d_index = 0;
     }
 
     bool
@@ -164,6 +173,20 @@ namespace gr {
       }
 
       ret = ret && _open(&d_new_fp, filename.c_str());
+
+      if(ret && d_use_index) {
+	gr::thread::scoped_lock guard(d_mutex);
+	delete d_new_index;
+	d_new_index = 0;
+	try {
+	  d_new_index = new file_meta_index(filename + ".idx", true);
+	}
+	catch(std::runtime_error &e) {
+	  std::cerr << e.what() << std::endl;
+	  ret = false;
+	}
+      }
+
       d_updated = true;
       return ret;
     }
@@ -215,6 +238,9 @@ namespace gr {
 	fclose(d_new_fp);
 	d_new_fp = 0;
       }
+
+      delete d_new_index;
+      d_new_index = 0;
       d_updated = true;
     }
 
@@ -235,6 +261,11 @@ namespace gr {
 	d_fp = d_new_fp;		// install new file pointer
 	d_new_fp = 0;
 
+	delete d_index;
+	d_index = d_new_index;
+	d_new_index = 0;
+	d_items = 0;
+
 	d_updated = false;
       }
     }
@@ -302,6 +333,7 @@ namespace gr {
 	update_last_header_detached();
       else
 	update_last_header_inline();
+      index_update();
     }
 
     void
@@ -349,10 +381,52 @@ namespace gr {
       s = pmt::from_uint64(METADATA_HEADER_SIZE + d_extra_size);
       update_header(mp("strt"), s);
 
-      if(d_state == STATE_DETACHED)
+      if(d_state == STATE_DETACHED) {
+	uint64_t hdr_offset = ftell(d_hdr_fp);
 	write_header(d_hdr_fp, d_header, d_extra);
-      else
+	index_append(hdr_offset);
+      }
+      else {
+	uint64_t hdr_offset = ftell(d_fp);
 	write_header(d_fp, d_header, d_extra);
+	index_append(hdr_offset);
+      }
+    }
+
+    void
+    file_meta_sink_impl::index_append(uint64_t hdr_offset)
+    {
+      if(!d_index)
+	return;
+
+      // The header has just been written, so the data of the segment
+      // starts at the current position of the data file.
+      d_last_entry.hdr_offset = hdr_offset;
+      d_last_entry.data_offset = ftell(d_fp);
+      d_last_entry.item = d_items;
+      d_last_entry.nitems = 0;
+      pmt::pmt_t r = pmt::dict_ref(d_header, mp("rx_time"), pmt::PMT_NIL);
+      d_last_entry.secs = pmt::to_uint64(pmt::tuple_ref(r, 0));
+      d_last_entry.fracs = pmt::to_double(pmt::tuple_ref(r, 1));
+      d_last_entry.rate = pmt::to_double(pmt::dict_ref(d_header, mp("rx_rate"), pmt::PMT_NIL));
+      d_index->append(d_last_entry);
+    }
+
+    void
+    file_meta_sink_impl::index_update()
+    {
+      // A file opened with open() has no first header, and so no
+      // segment to update.
+      if(!d_index || d_index->size() == 0)
+	return;
+
+      // Tags on an empty segment change its header in place
+      d_last_entry.nitems = d_total_seg_size;
+      pmt::pmt_t r = pmt::dict_ref(d_header, mp("rx_time"), pmt::PMT_NIL);
+      d_last_entry.secs = pmt::to_uint64(pmt::tuple_ref(r, 0));
+      d_last_entry.fracs = pmt::to_double(pmt::tuple_ref(r, 1));
+      d_last_entry.rate = pmt::to_double(pmt::dict_ref(d_header, mp("rx_rate"), pmt::PMT_NIL));
+      d_index->update_last(d_last_entry);
     }
 
     void
@@ -414,6 +488,7 @@ namespace gr {
 	  inbuf += count * d_itemsize;
 
 	  d_total_seg_size += count;
+	  d_items += count;
 
 	  // Only add a new header if we are not at the position of the
 	  // next tag
@@ -449,6 +524,7 @@ namespace gr {
 	inbuf += count * d_itemsize;
 
 	d_total_seg_size += count;
+	d_items += count;
 	if(d_total_seg_size == d_max_seg_size) {
 	  update_last_header();
 	  update_rx_time();
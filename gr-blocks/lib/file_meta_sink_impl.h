@@ -24,6 +24,7 @@
 #define INCLUDED_BLOCKS_FILE_META_SINK_IMPL_H
 
 #include <gnuradio/blocks/file_meta_sink.h>
+#include <gnuradio/blocks/file_meta_index.h>
 #include <pmt/pmt.h>
 #include <gnuradio/thread/thread.h>
 
@@ -56,6 +57,11 @@ namespace gr {
       FILE *d_fp, *d_hdr_fp;
       meta_state_t d_state;
 
+      bool d_use_index;
+      file_meta_index *d_new_index, *d_index;
+      file_meta_index::entry d_last_entry;
+      uint64_t d_items;             // items written to the file
+
     protected:
       void write_header(FILE *fp, pmt_t header, pmt_t extra);
       void update_header(pmt_t key, pmt_t value);
@@ -64,6 +70,8 @@ namespace gr {
       void update_last_header_detached();
       void write_and_update();
       void update_rx_time();
+      void index_append(uint64_t hdr_offset);
+      void index_update();
 
       bool _open(FILE **fp, const char *filename);
 
@@ -73,7 +81,8 @@ namespace gr {
 			  gr_file_types type=GR_FILE_FLOAT, bool complex=true,
 			  size_t max_segment_size=1000000,
 			  const std::string &extra_dict="",
-			  bool detached_header=false);
+			  bool detached_header=false,
+			  bool index=false);
       ~file_meta_sink_impl();
 
       bool open(const std::string &filename);
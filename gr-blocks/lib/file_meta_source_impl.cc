@@ -32,6 +32,7 @@
 #include <fcntl.h>
 #include <stdexcept>
 #include <stdio.h>
+#include <cmath>
 
 // win32 (mingw/msvc) specific
 #ifdef HAVE_IO_H
@@ -77,7 +78,8 @@ namespace gr {
 		      io_signature::make(1, 1, 1)),
 	d_itemsize(0), d_samp_rate(0),
 	d_seg_size(0),
-	d_updated(false), d_repeat(repeat)
+	d_updated(false), d_repeat(repeat),
+	d_new_index(0), d_index(0), d_seek_pending(false)
     {
       d_fp = 0;
       d_new_fp = 0;
@@ -122,6 +124,9 @@ namespace gr {
 	  d_hdr_fp = 0;
 	}
       }
+
+      delete d_index;
+      d_index = 0;
     }
 
     bool
@@ -258,20 +263,18 @@ namespace gr {
     file_meta_source_impl::parse_extras(pmt::pmt_t extras, uint64_t offset,
 					std::vector<tag_t> &tags)
     {
-      pmt::pmt_t item, key, val;
-
-      size_t nitems = pmt::length(extras);
-      for(size_t i = 0; i < nitems; i++) {
-	item = pmt::nth(i, extras);
-	key = pmt::car(item);
-	val = pmt::cdr(item);
+      pmt::pmt_t items = pmt::dict_items(extras);
+      while(!pmt::is_null(items)) {
+	pmt::pmt_t item = pmt::car(items);
 
 	tag_t t;
 	t.offset = offset;
-	t.key = key;
-	t.value = val;
+	t.key = pmt::car(item);
+	t.value = pmt::cdr(item);
 	t.srcid = alias_pmt();
 	tags.push_back(t);
+
+	items = pmt::cdr(items);
       }
     }
 
@@ -290,6 +293,19 @@ namespace gr {
       }
 
       ret = ret && _open(&d_new_fp, filename.c_str());
+
+      // Use the index of the recording if it has one
+      if(ret) {
+	gr::thread::scoped_lock guard(d_mutex);
+	delete d_new_index;
+	d_new_index = 0;
+	FILE *fp = fopen((filename + ".idx").c_str(), "rb");
+	if(fp) {
+	  fclose(fp);
+	  d_new_index = new file_meta_index(filename + ".idx", false);
+	}
+      }
+
       d_updated = true;
       return ret;
     }
@@ -338,6 +354,9 @@ namespace gr {
 	fclose(d_new_fp);
 	d_new_fp = 0;
       }
+
+      delete d_new_index;
+      d_new_index = 0;
       d_updated = true;
     }
 
@@ -358,15 +377,108 @@ namespace gr {
 	d_fp = d_new_fp;		// install new file pointer
 	d_new_fp = 0;
 
+	delete d_index;
+	d_index = d_new_index;
+	d_new_index = 0;
+
 	d_updated = false;
       }
     }
 
+    void
+    file_meta_source_impl::seek_time(uint64_t secs, double fracs)
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      d_seek_secs = secs;
+      d_seek_fracs = fracs;
+      d_seek_pending = true;
+    }
+
+    void
+    file_meta_source_impl::do_seek_time()
+    {
+      FILE *hdr_fp = (d_state == STATE_DETACHED) ? d_hdr_fp : d_fp;
+      pmt::pmt_t rx_time = pmt::string_to_symbol("rx_time");
+      pmt::pmt_t hdr = pmt::PMT_NIL, extras = pmt::PMT_NIL;
+      uint64_t hdr_offset = 0, data_offset = 0;
+
+      // Find the last segment that starts at or before the time
+      if(d_index && d_index->size() > 0) {
+	int64_t n = std::max<int64_t>(d_index->find_time(d_seek_secs, d_seek_fracs), 0);
+	file_meta_index::entry e = d_index->at(n);
+	hdr_offset = e.hdr_offset;
+	data_offset = e.data_offset;
+      }
+      else {
+	uint64_t h = 0, d = 0;
+	while(fseek(hdr_fp, h, SEEK_SET) == 0 && read_header(hdr, extras)) {
+	  pmt::pmt_t r = pmt::dict_ref(hdr, rx_time, pmt::PMT_NIL);
+	  uint64_t secs = pmt::to_uint64(pmt::tuple_ref(r, 0));
+	  double fracs = pmt::to_double(pmt::tuple_ref(r, 1));
+	  if((h > 0) && ((secs > d_seek_secs) ||
+			 ((secs == d_seek_secs) && (fracs > d_seek_fracs))))
+	    break;
+
+	  hdr_offset = h;
+	  data_offset = d;
+	  uint64_t strt = pmt::to_uint64(pmt::dict_ref(hdr, pmt::string_to_symbol("strt"), pmt::PMT_NIL));
+	  uint64_t bytes = pmt::to_uint64(pmt::dict_ref(hdr, pmt::string_to_symbol("bytes"), pmt::PMT_NIL));
+	  if(d_state == STATE_DETACHED) {
+	    h += strt;
+	    d += bytes;
+	  }
+	  else
+	    h += strt + bytes;
+	}
+      }
+
+      // Read its header; the data of an inline segment follows it
+      if(fseek(hdr_fp, hdr_offset, SEEK_SET) != 0 || !read_header(hdr, extras))
+	throw std::runtime_error("file_meta_source: could not read header at seek time.\n");
+      d_tags.clear();
+      parse_header(hdr, nitems_written(0), d_tags);
+      parse_extras(extras, nitems_written(0), d_tags);
+      if(d_state == STATE_DETACHED)
+	fseek(d_fp, data_offset, SEEK_SET);
+
+      // Skip to the first item at or after the time
+      uint64_t secs = pmt::to_uint64(pmt::tuple_ref(d_time_stamp, 0));
+      double fracs = pmt::to_double(pmt::tuple_ref(d_time_stamp, 1));
+      double dt = ((double)d_seek_secs - (double)secs) + (d_seek_fracs - fracs);
+      uint64_t skip = 0;
+      if(dt > 0)
+	skip = std::min((uint64_t)ceil(dt*d_samp_rate - 1e-6), (uint64_t)d_seg_size);
+      fseek(d_fp, skip*d_itemsize, SEEK_CUR);
+      d_seg_size -= skip;
+
+      // Past the end of the segment: the next one is read by work()
+      if(d_seg_size == 0) {
+	d_tags.clear();
+	return;
+      }
+
+      fracs += skip / d_samp_rate;
+      uint64_t whole = static_cast<uint64_t>(fracs);
+      d_time_stamp = pmt::make_tuple(pmt::from_uint64(secs + whole),
+				     pmt::from_double(fracs - whole));
+      for(size_t i = 0; i < d_tags.size(); i++) {
+	if(pmt::eq(d_tags[i].key, rx_time))
+	  d_tags[i].value = d_time_stamp;
+      }
+    }
+
     int
     file_meta_source_impl::work(int noutput_items,
 				gr_vector_const_void_star &input_items,
 				gr_vector_void_star &output_items)
     {
+      if(d_seek_pending) {
+	do_update();
+	gr::thread::scoped_lock lock(d_mutex);
+	do_seek_time();
+	d_seek_pending = false;
+      }
+
       // We've reached the end of a segment; parse the next header and get
       // the new tags to send and set the next segment size.
       if(d_seg_size == 0) {
@@ -29,6 +29,7 @@
 #include <gnuradio/thread/thread.h>
 
 #include <gnuradio/blocks/file_meta_sink.h>
+#include <gnuradio/blocks/file_meta_index.h>
 
 using namespace pmt;
 
@@ -57,6 +58,11 @@ namespace gr {
 
       std::vector<tag_t> d_tags;
 
+      file_meta_index *d_new_index, *d_index;
+      bool d_seek_pending;
+      uint64_t d_seek_secs;
+      double d_seek_fracs;
+
     protected:
       bool _open(FILE **fp, const char *filename);
       bool read_header(pmt_t &hdr, pmt_t &extras);
@@ -64,6 +70,7 @@ namespace gr {
 			std::vector<tag_t> &tags);
       void parse_extras(pmt_t extras, uint64_t offset,
 			std::vector<tag_t> &tags);
+      void do_seek_time();
 
     public:
       file_meta_source_impl(const std::string &filename,
@@ -78,6 +85,8 @@ namespace gr {
       void close();
       void do_update();
 
+      void seek_time(uint64_t secs, double fracs);
+
       int work(int noutput_items,
 	       gr_vector_const_void_star &input_items,
 	       gr_vector_void_star &output_items);
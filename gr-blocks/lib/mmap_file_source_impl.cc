@@ -0,0 +1,327 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "mmap_file_source_impl.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+// should be handled via configure
+#ifdef O_LARGEFILE
+#define	OUR_O_LARGEFILE	O_LARGEFILE
+#else
+#define	OUR_O_LARGEFILE 0
+#endif
+
+namespace gr {
+  namespace blocks {
+
+    // Bytes to keep requested ahead of the read position
+    static const size_t READAHEAD = 8*1024*1024;
+
+    mmap_file_source::sptr
+    mmap_file_source::make(size_t itemsize, const char *filename,
+			   bool repeat, const char *tag_file,
+			   size_t window_size)
+    {
+      return gnuradio::get_initial_sptr
+	(new mmap_file_source_impl(itemsize, filename, repeat,
+				   tag_file, window_size));
+    }
+
+    mmap_file_source_impl::mmap_file_source_impl(size_t itemsize,
+						 const char *filename,
+						 bool repeat,
+						 const char *tag_file,
+						 size_t window_size)
+      : sync_block("mmap_file_source",
+		   io_signature::make(0, 0, 0),
+		   io_signature::make(1, 1, itemsize)),
+	d_itemsize(itemsize), d_repeat(repeat), d_fd(-1),
+	d_size(0), d_nitems(0), d_pos(0), d_ra_end(0),
+	d_map(0), d_map_offset(0), d_map_len(0), d_next_tag(0)
+    {
+#ifdef HAVE_SYS_MMAN_H
+      if((d_fd = ::open(filename, O_RDONLY | OUR_O_LARGEFILE)) < 0) {
+	perror(filename);
+	throw std::runtime_error("mmap_file_source: can't open file");
+      }
+
+      struct stat st;
+      if(fstat(d_fd, &st) < 0) {
+	perror(filename);
+	::close(d_fd);
+	throw std::runtime_error("mmap_file_source: can't stat file");
+      }
+      d_nitems = (uint64_t)st.st_size / d_itemsize;
+      d_size = d_nitems * d_itemsize;
+
+      // A window of 0 maps the whole file, where it fits
+      uint64_t page = sysconf(_SC_PAGESIZE);
+      uint64_t window = window_size;
+      if(window == 0 || window > d_size)
+	window = d_size;
+      window = std::max(page, (window + page - 1) / page * page);
+      if(window > (uint64_t)std::numeric_limits<size_t>::max() / 16)
+	window = (uint64_t)1 << (sizeof(size_t) * 8 - 4);
+      d_window = window;
+      d_readahead = std::min<size_t>(d_window, READAHEAD);
+
+      if(d_nitems == 0 && d_repeat) {
+	::close(d_fd);
+	throw std::runtime_error("mmap_file_source: can't repeat an empty file");
+      }
+
+      if(tag_file && *tag_file) {
+	try {
+	  load_tags(tag_file);
+	}
+	catch(...) {
+	  ::close(d_fd);
+	  throw;
+	}
+      }
+#else
+      throw std::runtime_error("mmap_file_source: mmap is not supported on this platform");
+#endif
+    }
+
+    mmap_file_source_impl::~mmap_file_source_impl()
+    {
+      unmap();
+#ifdef HAVE_UNISTD_H
+      if(d_fd >= 0)
+	::close(d_fd);
+#endif
+    }
+
+    static bool
+    tag_before(const pmt::pmt_t &a, const pmt::pmt_t &b)
+    {
+      return pmt::to_uint64(pmt::tuple_ref(a, 0)) < pmt::to_uint64(pmt::tuple_ref(b, 0));
+    }
+
+    void
+    mmap_file_source_impl::load_tags(const char *tag_file)
+    {
+      std::ifstream in(tag_file, std::ios::in | std::ios::binary);
+      if(!in)
+	throw std::runtime_error("mmap_file_source: can't open tag file");
+
+      std::vector<pmt::pmt_t> tuples;
+      for(;;) {
+	pmt::pmt_t t = pmt::deserialize(*in.rdbuf());
+	if(pmt::eq(t, pmt::PMT_EOF))
+	  break;
+	if(!pmt::is_tuple(t) || pmt::length(t) != 3 ||
+	   !(pmt::is_integer(pmt::tuple_ref(t, 0)) || pmt::is_uint64(pmt::tuple_ref(t, 0))))
+	  throw std::runtime_error("mmap_file_source: tag file entry is not (offset, key, value)");
+	tuples.push_back(t);
+      }
+
+      // Keep the order of the file among tags on the same item
+      std::stable_sort(tuples.begin(), tuples.end(), tag_before);
+
+      d_tags.resize(tuples.size());
+      for(size_t i = 0; i < tuples.size(); i++) {
+	d_tags[i].offset = pmt::to_uint64(pmt::tuple_ref(tuples[i], 0));
+	d_tags[i].key = pmt::tuple_ref(tuples[i], 1);
+	d_tags[i].value = pmt::tuple_ref(tuples[i], 2);
+      }
+    }
+
+    bool
+    mmap_file_source_impl::seek(long seek_point, int whence)
+    {
+      gr::thread::scoped_lock lock(d_mutex);
+
+      int64_t base;
+      switch(whence) {
+      case SEEK_SET: base = 0; break;
+      case SEEK_CUR: base = d_pos; break;
+      case SEEK_END: base = d_nitems; break;
+      default: return false;
+      }
+
+      int64_t pos = base + seek_point;
+      if(pos < 0 || (uint64_t)pos > d_nitems)
+	return false;
+
+      d_pos = pos;
+      find_next_tag();
+      return true;
+    }
+
+    void
+    mmap_file_source_impl::unmap()
+    {
+#ifdef HAVE_SYS_MMAN_H
+      if(d_map)
+	munmap((void*)d_map, d_map_len);
+#endif
+      d_map = 0;
+      d_map_len = 0;
+    }
+
+    void
+    mmap_file_source_impl::map_window(uint64_t offset)
+    {
+      unmap();
+
+#ifdef HAVE_SYS_MMAN_H
+      d_map_offset = offset - offset % d_window;
+      d_map_len = std::min<uint64_t>(d_window, d_size - d_map_offset);
+
+      void *p = mmap(0, d_map_len, PROT_READ, MAP_SHARED, d_fd, d_map_offset);
+      if(p == MAP_FAILED) {
+	d_map_len = 0;
+	throw std::runtime_error("mmap_file_source: mmap failed");
+      }
+      d_map = (const char*)p;
+
+#ifdef MADV_SEQUENTIAL
+      madvise(p, d_map_len, MADV_SEQUENTIAL);
+#endif
+#endif /* HAVE_SYS_MMAN_H */
+    }
+
+    void
+    mmap_file_source_impl::read_ahead(uint64_t offset)
+    {
+      // Keep between half and all of d_readahead bytes requested
+      // ahead of the read position, from the start of the file too
+      // when it is about to repeat.  After a seek the request starts
+      // over at the new position, so a seek costs no more than the
+      // first request.
+      if(offset <= d_ra_end && offset + d_readahead / 2 <= d_ra_end)
+	return;
+
+      uint64_t start = (offset <= d_ra_end && d_ra_end < d_size) ? d_ra_end : offset;
+      uint64_t end = offset + d_readahead;
+#ifdef POSIX_FADV_WILLNEED
+      if(start < d_size)
+	posix_fadvise(d_fd, start, std::min(end, d_size) - start, POSIX_FADV_WILLNEED);
+      if(end > d_size && d_repeat)
+	posix_fadvise(d_fd, 0, std::min(end - d_size, d_size), POSIX_FADV_WILLNEED);
+#endif
+      d_ra_end = end;
+    }
+
+    void
+    mmap_file_source_impl::copy(char *out, uint64_t offset, size_t nbytes)
+    {
+      while(nbytes > 0) {
+	if(offset < d_map_offset || offset >= d_map_offset + d_map_len)
+	  map_window(offset);
+
+	size_t n = std::min<uint64_t>(nbytes, d_map_offset + d_map_len - offset);
+	memcpy(out, d_map + (offset - d_map_offset), n);
+	out += n;
+	offset += n;
+	nbytes -= n;
+      }
+    }
+
+    void
+    mmap_file_source_impl::find_next_tag()
+    {
+      // Binary search for the first tag at or after d_pos
+      size_t lo = 0, hi = d_tags.size();
+      while(lo < hi) {
+	size_t mid = lo + (hi - lo) / 2;
+	if(d_tags[mid].offset < d_pos)
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+      d_next_tag = lo;
+    }
+
+    void
+    mmap_file_source_impl::add_tags(uint64_t nitems, uint64_t abs_offset)
+    {
+      pmt::pmt_t srcid = alias_pmt();
+      while(d_next_tag < d_tags.size() &&
+	    d_tags[d_next_tag].offset < d_pos + nitems) {
+	const file_tag &t = d_tags[d_next_tag];
+	add_item_tag(0, abs_offset + t.offset - d_pos, t.key, t.value, srcid);
+	d_next_tag++;
+      }
+    }
+
+    int
+    mmap_file_source_impl::work(int noutput_items,
+				gr_vector_const_void_star &input_items,
+				gr_vector_void_star &output_items)
+    {
+      char *out = (char*)output_items[0];
+      uint64_t abs_offset = nitems_written(0);
+      int produced = 0;
+
+      gr::thread::scoped_lock lock(d_mutex);
+
+      while(produced < noutput_items) {
+	if(d_pos == d_nitems) {
+	  if(!d_repeat)
+	    break;
+	  d_pos = 0;
+	  d_next_tag = 0;
+	  d_ra_end = d_ra_end > d_size ? d_ra_end - d_size : 0;
+	}
+
+	uint64_t n = std::min<uint64_t>(noutput_items - produced, d_nitems - d_pos);
+	add_tags(n, abs_offset + produced);
+	copy(out + produced * d_itemsize, d_pos * d_itemsize, n * d_itemsize);
+	d_pos += n;
+	produced += n;
+      }
+
+      read_ahead(d_pos * d_itemsize);
+
+      if(produced == 0)
+	return -1;	// end of file, we're done
+
+      return produced;
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_MMAP_FILE_SOURCE_IMPL_H
+#define INCLUDED_BLOCKS_MMAP_FILE_SOURCE_IMPL_H
+
+#include <gnuradio/blocks/mmap_file_source.h>
+#include <gnuradio/thread/thread.h>
+#include <pmt/pmt.h>
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    class mmap_file_source_impl : public mmap_file_source
+    {
+    private:
+      struct file_tag {
+	uint64_t offset;
+	pmt::pmt_t key;
+	pmt::pmt_t value;
+      };
+
+      size_t d_itemsize;
+      bool d_repeat;
+      int d_fd;
+      uint64_t d_size;              // bytes, a whole number of items
+      uint64_t d_nitems;
+      uint64_t d_pos;               // next item to play
+      uint64_t d_ra_end;            // file offset read ahead to
+      size_t d_readahead;
+      size_t d_window;
+      const char *d_map;
+      uint64_t d_map_offset;        // file offset of d_map
+      size_t d_map_len;
+      std::vector<file_tag> d_tags; // sorted by offset
+      size_t d_next_tag;            // first tag at or after d_pos
+      gr::thread::mutex d_mutex;
+
+      void load_tags(const char *tag_file);
+      void map_window(uint64_t offset);
+      void read_ahead(uint64_t offset);
+      void unmap();
+      void copy(char *out, uint64_t offset, size_t nbytes);
+      void find_next_tag();
+      void add_tags(uint64_t nitems, uint64_t abs_offset);
+
+    public:
+      mmap_file_source_impl(size_t itemsize, const char *filename,
+			    bool repeat, const char *tag_file,
+			    size_t window_size);
+      ~mmap_file_source_impl();
+
+      bool seek(long seek_point, int whence);
+      uint64_t file_items() const { return d_nitems; }
+      uint64_t position() const { return d_pos; }
+      size_t num_tags() const { return d_tags.size(); }
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_MMAP_FILE_SOURCE_IMPL_H */
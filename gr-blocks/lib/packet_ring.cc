@@ -0,0 +1,53 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "packet_ring.h"
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    packet_ring::packet_ring(size_t nslots, size_t slot_size)
+      : d_mask(1), d_slot_size(slot_size), d_data(0), d_head(0), d_tail(0)
+    {
+      if(nslots == 0 || slot_size == 0)
+	throw std::invalid_argument("packet_ring: no slots");
+
+      while(d_mask + 1 < nslots)
+	d_mask = 2*d_mask + 1;
+
+      d_data = new char[(d_mask + 1) * d_slot_size];
+      d_packets.resize(d_mask + 1);
+    }
+
+    packet_ring::~packet_ring()
+    {
+      delete [] d_data;
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
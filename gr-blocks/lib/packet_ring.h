@@ -0,0 +1,112 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_PACKET_RING_H
+#define INCLUDED_PACKET_RING_H
+
+#include <boost/atomic.hpp>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    /*!
+     * \brief Ring of fixed size packet slots between one producer
+     * thread and one consumer thread, without locks.
+     *
+     * The producer fills free slots in place and publishes them with
+     * commit(); the consumer reads them in place and frees them with
+     * release().  The read and write counters run freely and each is
+     * written by one side only, so the two sides only ever wait on
+     * each other when the ring is full or empty.
+     */
+    class packet_ring
+    {
+    public:
+      struct packet {
+	uint32_t length;        // bytes in the slot
+	uint32_t lost;          // packets lost just before this one
+      };
+
+      /*!
+       * \param nslots number of slots, rounded up to a power of 2
+       * \param slot_size bytes per slot
+       */
+      packet_ring(size_t nslots, size_t slot_size);
+      ~packet_ring();
+
+      size_t nslots() const { return d_mask + 1; }
+      size_t slot_size() const { return d_slot_size; }
+
+      // Producer side
+
+      //! Number of free slots from the write position to the end of the ring
+      size_t writable() const
+      {
+	unsigned int head = d_head.load(boost::memory_order_relaxed);
+	unsigned int free = nslots() - (head - d_tail.load(boost::memory_order_acquire));
+	return std::min<size_t>(free, nslots() - (head & d_mask));
+      }
+
+      //! The \p i-th free slot
+      char *write_slot(size_t i) { return slot(d_head.load(boost::memory_order_relaxed) + i); }
+      packet &write_packet(size_t i) { return d_packets[(d_head.load(boost::memory_order_relaxed) + i) & d_mask]; }
+
+      //! Publishes the first \p n free slots
+      void commit(size_t n) { d_head.fetch_add(n, boost::memory_order_release); }
+
+      // Consumer side
+
+      //! Number of published slots from the read position to the end of the ring
+      size_t readable() const
+      {
+	unsigned int tail = d_tail.load(boost::memory_order_relaxed);
+	unsigned int used = d_head.load(boost::memory_order_acquire) - tail;
+	return std::min<size_t>(used, nslots() - (tail & d_mask));
+      }
+
+      //! The \p i-th published slot
+      const char *read_slot(size_t i) const { return slot(d_tail.load(boost::memory_order_relaxed) + i); }
+      const packet &read_packet(size_t i) const { return d_packets[(d_tail.load(boost::memory_order_relaxed) + i) & d_mask]; }
+
+      //! Frees the first \p n published slots
+      void release(size_t n) { d_tail.fetch_add(n, boost::memory_order_release); }
+
+    private:
+      size_t d_mask;
+      size_t d_slot_size;
+      char *d_data;
+      std::vector<packet> d_packets;
+      boost::atomic<unsigned int> d_head;   // slots committed
+      char d_pad[64];                       // keep the counters on separate cache lines
+      boost::atomic<unsigned int> d_tail;   // slots released
+
+      char *slot(unsigned int n) const { return d_data + (n & d_mask) * d_slot_size; }
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_PACKET_RING_H */
@@ -0,0 +1,578 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "shm_ring.h"
+#include <gnuradio/thread/thread.h>
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <errno.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_SIGNAL_H
+#include <signal.h>
+#endif
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_SHM_OPEN)
+#define SHM_RING_SUPPORTED
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+namespace gr {
+  namespace blocks {
+
+    static const char MAGIC[8] = { 'G', 'R', 'S', 'H', 'M', 'R', '0', '1' };
+    static const size_t TAG_SLOT_SIZE = 256;
+
+    enum { SLOT_FREE = 0, SLOT_CLAIMED, SLOT_ACTIVE };
+
+    // The segment starts with the header, then the tag slots, padded
+    // to a page, then the data.  Each counter that changes has a
+    // cache line to itself.
+
+    struct shm_ring_reader {
+      boost::atomic<uint32_t> state;
+      int32_t pid;
+      boost::atomic<uint64_t> items;   // items read
+      boost::atomic<uint64_t> tags;    // tags read or passed over
+      char pad[40];
+    };
+
+    struct shm_ring_header {
+      char magic[8];
+      uint32_t header_size;
+      uint32_t block;
+      uint64_t itemsize;
+      uint64_t capacity;
+      uint64_t data_offset;
+      uint64_t data_size;
+      uint64_t ntags;
+      int32_t writer_pid;
+      boost::atomic<uint32_t> ready;
+      boost::atomic<uint32_t> closed;
+      char pad0[60];
+      boost::atomic<uint64_t> items;   // items written
+      char pad1[56];
+      boost::atomic<uint64_t> tags;    // tags written
+      char pad2[56];
+      shm_ring_reader readers[shm_ring::MAX_READERS];
+    };
+
+    // A tag, guarded by a sequence count: odd while it is being
+    // written, 2n+2 once it holds tag n
+    struct shm_ring_tag {
+      boost::atomic<uint64_t> seq;
+      uint64_t offset;
+      uint32_t length;
+      char data[TAG_SLOT_SIZE - 20];
+    };
+
+    static size_t
+    round_up(size_t n, size_t unit)
+    {
+      return (n + unit - 1) / unit * unit;
+    }
+
+    static std::string
+    segment_name(const std::string &name)
+    {
+      if(name.empty())
+	throw std::invalid_argument("shm_ring: empty segment name");
+      return name[0] == '/' ? name : "/" + name;
+    }
+
+    shm_ring::shm_ring()
+      : d_writer(false), d_fd(-1), d_base(0), d_map_size(0), d_hdr(0),
+	d_data(0), d_tags(0), d_itemsize(0), d_capacity(0), d_data_size(0),
+	d_ntags(0), d_items(0), d_ntags_written(0), d_slot(-1)
+    {
+    }
+
+    shm_ring::shm_ring(const std::string &name, size_t itemsize, size_t nitems,
+		       size_t ntags, bool block)
+      : d_name(segment_name(name)), d_writer(true), d_fd(-1), d_base(0),
+	d_map_size(0), d_hdr(0), d_data(0), d_tags(0), d_itemsize(itemsize),
+	d_capacity(0), d_data_size(0), d_ntags(ntags), d_items(0),
+	d_ntags_written(0), d_slot(-1)
+    {
+#ifdef SHM_RING_SUPPORTED
+      if(itemsize == 0 || nitems == 0 || ntags == 0)
+	throw std::invalid_argument("shm_ring: itemsize, nitems and ntags must be positive");
+
+      size_t page = sysconf(_SC_PAGESIZE);
+      d_data_size = round_up(nitems * itemsize, page);
+      d_capacity = d_data_size / itemsize;
+      size_t data_offset = round_up(sizeof(shm_ring_header) + ntags * sizeof(shm_ring_tag), page);
+
+      // A segment left by a writer that died is replaced; its readers
+      // keep the old one until they close it
+      shm_unlink(d_name.c_str());
+      d_fd = shm_open(d_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0660);
+      if(d_fd < 0)
+	throw std::runtime_error(boost::str(boost::format("shm_ring: can't create %s: %s")
+					    % d_name % strerror(errno)));
+      if(ftruncate(d_fd, data_offset + d_data_size) < 0) {
+	int err = errno;
+	::close(d_fd);
+	shm_unlink(d_name.c_str());
+	throw std::runtime_error(boost::str(boost::format("shm_ring: can't size %s: %s")
+					    % d_name % strerror(err)));
+      }
+
+      d_hdr = 0;
+      d_map_size = data_offset;
+      try {
+	map(true);
+      }
+      catch(...) {
+	::close(d_fd);
+	shm_unlink(d_name.c_str());
+	throw;
+      }
+
+      shm_ring_header *h = new(d_base) shm_ring_header;
+      if(!h->items.is_lock_free()) {
+	unmap();
+	shm_unlink(d_name.c_str());
+	throw std::runtime_error("shm_ring: no lock-free 64-bit atomics on this platform");
+      }
+      memcpy(h->magic, MAGIC, sizeof(MAGIC));
+      h->header_size = sizeof(shm_ring_header);
+      h->block = block;
+      h->itemsize = itemsize;
+      h->capacity = d_capacity;
+      h->data_offset = data_offset;
+      h->data_size = d_data_size;
+      h->ntags = ntags;
+      h->writer_pid = getpid();
+      h->closed.store(0);
+      h->items.store(0);
+      h->tags.store(0);
+      for(unsigned int i = 0; i < MAX_READERS; i++) {
+	h->readers[i].state.store(SLOT_FREE);
+	h->readers[i].items.store(0);
+	h->readers[i].tags.store(0);
+      }
+      for(size_t i = 0; i < ntags; i++)
+	new(tag_slot(i)) shm_ring_tag;
+      for(size_t i = 0; i < ntags; i++)
+	tag_slot(i)->seq.store(0);
+      h->ready.store(1, boost::memory_order_release);
+#else
+      throw std::runtime_error("shm_ring: shared memory is not supported on this platform");
+#endif
+    }
+
+    shm_ring *
+    shm_ring::attach(const std::string &name)
+    {
+#ifdef SHM_RING_SUPPORTED
+      std::string seg = segment_name(name);
+      int fd = shm_open(seg.c_str(), O_RDWR, 0);
+      if(fd < 0) {
+	if(errno == ENOENT)
+	  return 0;
+	throw std::runtime_error(boost::str(boost::format("shm_ring: can't open %s: %s")
+					    % seg % strerror(errno)));
+      }
+
+      // Read the sizes from the header, once the writer has set it up
+      struct stat st;
+      if(fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(shm_ring_header)) {
+	::close(fd);
+	return 0;
+      }
+      void *p = mmap(0, sizeof(shm_ring_header), PROT_READ, MAP_SHARED, fd, 0);
+      if(p == MAP_FAILED) {
+	::close(fd);
+	throw std::runtime_error(boost::str(boost::format("shm_ring: can't map %s: %s")
+					    % seg % strerror(errno)));
+      }
+      const shm_ring_header *h = (const shm_ring_header*)p;
+      if(!h->ready.load(boost::memory_order_acquire)) {
+	munmap(p, sizeof(shm_ring_header));
+	::close(fd);
+	return 0;
+      }
+      bool valid = (memcmp(h->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+		    h->header_size == sizeof(shm_ring_header) &&
+		    (uint64_t)st.st_size >= h->data_offset + h->data_size);
+
+      shm_ring *ring = new shm_ring();
+      ring->d_name = seg;
+      ring->d_fd = fd;
+      ring->d_itemsize = h->itemsize;
+      ring->d_capacity = h->capacity;
+      ring->d_data_size = h->data_size;
+      ring->d_ntags = h->ntags;
+      ring->d_map_size = h->data_offset;
+      munmap(p, sizeof(shm_ring_header));
+      if(!valid) {
+	delete ring;
+	throw std::runtime_error(boost::str(boost::format("shm_ring: %s is not a segment of this version")
+					    % seg));
+      }
+
+      try {
+	ring->map(false);
+      }
+      catch(...) {
+	delete ring;
+	throw;
+      }
+
+      // Claim a slot, then start from the current write position
+      shm_ring_header *hdr = ring->d_hdr;
+      for(unsigned int i = 0; i < MAX_READERS && ring->d_slot < 0; i++) {
+	uint32_t expected = SLOT_FREE;
+	if(hdr->readers[i].state.compare_exchange_strong(expected, SLOT_CLAIMED))
+	  ring->d_slot = i;
+      }
+      if(ring->d_slot < 0) {
+	delete ring;
+	throw std::runtime_error(boost::str(boost::format("shm_ring: %s has %d readers already")
+					    % seg % (int)MAX_READERS));
+      }
+
+      // The writer may have published tags for items it has not
+      // published yet, so look back for the first tag on or after
+      // the first item to read.  Publishing this slot before reading
+      // the write count again makes sure that the writer either sees
+      // the slot or has not yet got past the count.
+      shm_ring_reader &me = hdr->readers[ring->d_slot];
+      me.pid = getpid();
+      me.items.store(hdr->items.load());
+      me.tags.store(hdr->tags.load());
+      me.state.store(SLOT_ACTIVE);
+      uint64_t w = hdr->items.load();
+      uint64_t t = hdr->tags.load();
+      uint64_t first = t > ring->d_ntags ? t - ring->d_ntags : 0;
+      while(t > first) {
+	const shm_ring_tag *s = ring->tag_slot(t - 1);
+	if(s->seq.load(boost::memory_order_acquire) != 2 * (t - 1) + 2 || s->offset < w)
+	  break;
+	t--;
+      }
+      me.items.store(w, boost::memory_order_release);
+      me.tags.store(t, boost::memory_order_release);
+      return ring;
+#else
+      throw std::runtime_error("shm_ring: shared memory is not supported on this platform");
+#endif
+    }
+
+    shm_ring::~shm_ring()
+    {
+#ifdef SHM_RING_SUPPORTED
+      if(d_hdr) {
+	if(d_writer)
+	  close();
+	else if(d_slot >= 0)
+	  d_hdr->readers[d_slot].state.store(SLOT_FREE, boost::memory_order_release);
+      }
+      unmap();
+      if(d_writer)
+	shm_unlink(d_name.c_str());
+#endif
+    }
+
+    // Maps the control area, then the data twice after it, over a
+    // reservation of the whole range so that nothing else can take
+    // the addresses in between
+    void
+    shm_ring::map(bool writer)
+    {
+#ifdef SHM_RING_SUPPORTED
+      size_t total = d_map_size + 2 * d_data_size;
+      void *base = mmap(0, total, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if(base == MAP_FAILED)
+	throw std::runtime_error(boost::str(boost::format("shm_ring: can't reserve %d bytes: %s")
+					    % total % strerror(errno)));
+
+      char *b = (char*)base;
+      int prot = writer ? PROT_READ | PROT_WRITE : PROT_READ;
+      if(mmap(b, d_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+	      d_fd, 0) == MAP_FAILED ||
+	 mmap(b + d_map_size, d_data_size, prot, MAP_SHARED | MAP_FIXED,
+	      d_fd, d_map_size) == MAP_FAILED ||
+	 mmap(b + d_map_size + d_data_size, d_data_size, prot, MAP_SHARED | MAP_FIXED,
+	      d_fd, d_map_size) == MAP_FAILED) {
+	int err = errno;
+	munmap(base, total);
+	throw std::runtime_error(boost::str(boost::format("shm_ring: can't map %s: %s")
+					    % d_name % strerror(err)));
+      }
+
+      d_base = b;
+      d_hdr = (shm_ring_header*)b;
+      d_tags = b + sizeof(shm_ring_header);
+      d_data = b + d_map_size;
+#endif
+    }
+
+    void
+    shm_ring::unmap()
+    {
+#ifdef SHM_RING_SUPPORTED
+      if(d_base)
+	munmap(d_base, d_map_size + 2 * d_data_size);
+      if(d_fd >= 0)
+	::close(d_fd);
+#endif
+      d_base = 0;
+      d_hdr = 0;
+      d_fd = -1;
+    }
+
+    shm_ring_tag *
+    shm_ring::tag_slot(uint64_t n) const
+    {
+      return (shm_ring_tag*)(d_tags + (n % d_ntags) * sizeof(shm_ring_tag));
+    }
+
+    bool
+    shm_ring::blocking() const
+    {
+      return d_hdr->block != 0;
+    }
+
+    unsigned int
+    shm_ring::readers() const
+    {
+      unsigned int n = 0;
+      for(unsigned int i = 0; i < MAX_READERS; i++)
+	if(d_hdr->readers[i].state.load(boost::memory_order_acquire) == SLOT_ACTIVE)
+	  n++;
+      return n;
+    }
+
+    size_t
+    shm_ring::writable() const
+    {
+      if(!d_hdr->block)
+	return std::max<size_t>(d_capacity / 4, 1);
+
+      size_t room = d_capacity;
+      for(unsigned int i = 0; i < MAX_READERS; i++) {
+	const shm_ring_reader &r = d_hdr->readers[i];
+	if(r.state.load(boost::memory_order_acquire) != SLOT_ACTIVE)
+	  continue;
+	if(d_ntags_written - r.tags.load(boost::memory_order_acquire) >= d_ntags)
+	  return 0;
+	uint64_t used = d_items - r.items.load(boost::memory_order_acquire);
+	room = used >= d_capacity ? 0 : std::min<size_t>(room, d_capacity - used);
+      }
+      return room;
+    }
+
+    shm_ring::tag_status
+    shm_ring::write_tag(const tag_t &tag, uint64_t offset)
+    {
+      // A tag made without a srcid has a null one
+      std::stringbuf sb;
+      pmt::serialize(tag.key, sb);
+      pmt::serialize(tag.value, sb);
+      pmt::serialize(tag.srcid ? tag.srcid : pmt::PMT_F, sb);
+      std::string s = sb.str();
+      if(s.size() > sizeof(((shm_ring_tag*)0)->data))
+	return TAG_TOO_LARGE;
+
+      if(d_hdr->block) {
+	for(unsigned int i = 0; i < MAX_READERS; i++) {
+	  const shm_ring_reader &r = d_hdr->readers[i];
+	  if(r.state.load(boost::memory_order_acquire) == SLOT_ACTIVE &&
+	     d_ntags_written - r.tags.load(boost::memory_order_acquire) >= d_ntags)
+	    return TAG_FULL;
+	}
+      }
+
+      shm_ring_tag *slot = tag_slot(d_ntags_written);
+      slot->seq.store(2 * d_ntags_written + 1, boost::memory_order_relaxed);
+      boost::atomic_thread_fence(boost::memory_order_release);
+      slot->offset = d_items + offset;
+      slot->length = s.size();
+      memcpy(slot->data, s.data(), s.size());
+      slot->seq.store(2 * d_ntags_written + 2, boost::memory_order_release);
+      d_ntags_written++;
+      return TAG_WRITTEN;
+    }
+
+    void
+    shm_ring::write(const void *items, size_t n)
+    {
+      memcpy(d_data + (d_items * d_itemsize) % d_data_size, items, n * d_itemsize);
+      d_items += n;
+      d_hdr->tags.store(d_ntags_written, boost::memory_order_release);
+      d_hdr->items.store(d_items, boost::memory_order_release);
+    }
+
+    void
+    shm_ring::close()
+    {
+      d_hdr->closed.store(1, boost::memory_order_release);
+    }
+
+    void
+    shm_ring::reopen()
+    {
+      d_hdr->closed.store(0, boost::memory_order_release);
+    }
+
+    unsigned int
+    shm_ring::reap_readers()
+    {
+      unsigned int n = 0;
+#if defined(SHM_RING_SUPPORTED) && defined(HAVE_SIGNAL_H)
+      for(unsigned int i = 0; i < MAX_READERS; i++) {
+	shm_ring_reader &r = d_hdr->readers[i];
+	if(r.state.load(boost::memory_order_acquire) == SLOT_ACTIVE &&
+	   kill(r.pid, 0) < 0 && errno == ESRCH) {
+	  r.state.store(SLOT_FREE, boost::memory_order_release);
+	  n++;
+	}
+      }
+#endif
+      return n;
+    }
+
+    size_t
+    shm_ring::read(void *items, size_t n, std::vector<tag_t> &tags,
+		   uint64_t &lost_items, uint64_t &lost_tags)
+    {
+      shm_ring_reader &me = d_hdr->readers[d_slot];
+      uint64_t r = me.items.load(boost::memory_order_relaxed);
+      uint64_t t = me.tags.load(boost::memory_order_relaxed);
+      uint64_t w = d_hdr->items.load(boost::memory_order_acquire);
+      uint64_t ntags = d_hdr->tags.load(boost::memory_order_acquire);
+
+      // Overrun: skip to half a ring behind the writer
+      if(w - r > d_capacity) {
+	uint64_t next = w - d_capacity / 2;
+	lost_items += next - r;
+	r = next;
+      }
+
+      size_t k = std::min<uint64_t>(n, w - r);
+      char *out = (char*)items;
+      if(k > 0)
+	memcpy(out, d_data + (r * d_itemsize) % d_data_size, k * d_itemsize);
+
+      // Without blocking, the writer may have gone on to overwrite
+      // what was copied: up to a quarter of a ring past what it has
+      // published, or the oldest items
+      if(!d_hdr->block) {
+	boost::atomic_thread_fence(boost::memory_order_acquire);
+	uint64_t w2 = d_hdr->items.load(boost::memory_order_relaxed);
+	uint64_t valid = w2 + std::max<size_t>(d_capacity / 4, 1);
+	valid = valid > d_capacity ? valid - d_capacity : 0;
+	if(valid > r) {
+	  size_t bad = std::min<uint64_t>(k, valid - r);
+	  memmove(out, out + bad * d_itemsize, (k - bad) * d_itemsize);
+	  lost_items += bad;
+	  k -= bad;
+	  r += bad;
+	}
+      }
+
+      if(ntags - t > d_ntags) {
+	lost_tags += ntags - t - d_ntags;
+	t = ntags - d_ntags;
+      }
+      char buf[sizeof(((shm_ring_tag*)0)->data)];
+      for(; t < ntags; t++) {
+	const shm_ring_tag *slot = tag_slot(t);
+	uint64_t seq = slot->seq.load(boost::memory_order_acquire);
+	uint64_t offset = slot->offset;
+	size_t length = std::min<size_t>(slot->length, sizeof(buf));
+	memcpy(buf, slot->data, length);
+	boost::atomic_thread_fence(boost::memory_order_acquire);
+	if(seq != 2 * t + 2 || slot->seq.load(boost::memory_order_relaxed) != seq) {
+	  lost_tags++;		// overwritten
+	  continue;
+	}
+	if(offset >= r + k)
+	  break;
+	if(offset < r)
+	  continue;
+
+	try {
+	  std::stringbuf sb(std::string(buf, length));
+	  tag_t tag;
+	  tag.offset = offset - r;
+	  tag.key = pmt::deserialize(sb);
+	  tag.value = pmt::deserialize(sb);
+	  tag.srcid = pmt::deserialize(sb);
+	  tags.push_back(tag);
+	}
+	catch(...) {
+	  lost_tags++;
+	}
+      }
+
+      me.tags.store(t, boost::memory_order_release);
+      me.items.store(r + k, boost::memory_order_release);
+      return k;
+    }
+
+    uint64_t
+    shm_ring::readable() const
+    {
+      return d_hdr->items.load(boost::memory_order_acquire) -
+	d_hdr->readers[d_slot].items.load(boost::memory_order_relaxed);
+    }
+
+    bool
+    shm_ring::done() const
+    {
+      return (d_hdr->closed.load(boost::memory_order_acquire) &&
+	      readable() == 0);
+    }
+
+    void
+    shm_ring::pause(unsigned int round)
+    {
+      if(round < 32)
+	boost::this_thread::yield();
+      else
+	boost::this_thread::sleep(boost::posix_time::microseconds(100));
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
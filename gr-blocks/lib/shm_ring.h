@@ -0,0 +1,190 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_SHM_RING_H
+#define INCLUDED_SHM_RING_H
+
+#include <gnuradio/tags.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    struct shm_ring_header;
+
+    /*!
+     * \brief Ring of items in a named shared memory segment, written
+     * by one process and read by any number of others.
+     *
+     * The segment is made with shm_open and, as in
+     * vmcircbuf_mmap_shm_open, its data is mapped twice back to
+     * back, so that any run of items up to the size of the ring is
+     * contiguous in memory.  In front of the data is a control area
+     * with the write count, a slot for each reader with its read
+     * count, and a ring of fixed size slots holding the stream tags,
+     * serialized.  Everything is done with atomics in the segment:
+     * no locks and no system calls on the way, so the two sides
+     * only wait on each other by polling.
+     *
+     * The writer either waits for the slowest reader (block), or
+     * does not, in which case a reader that falls behind by more than
+     * the ring loses items and skips ahead; each reader checks after
+     * copying that the writer has not overwritten what it copied.
+     */
+    class shm_ring
+    {
+    public:
+      enum tag_status { TAG_WRITTEN, TAG_FULL, TAG_TOO_LARGE };
+
+      //! Most readers of a segment
+      static const unsigned int MAX_READERS = 16;
+
+      /*!
+       * \brief Creates the segment \p name, replacing any old one, to
+       * be written.
+       *
+       * \param name name of the segment, with or without the leading '/'
+       * \param itemsize bytes per item
+       * \param nitems items the ring holds at least; rounded up to
+       *        fill whole pages
+       * \param ntags number of tag slots
+       * \param block wait for the slowest reader instead of
+       *        overwriting what it has not read
+       */
+      shm_ring(const std::string &name, size_t itemsize, size_t nitems,
+	       size_t ntags, bool block);
+
+      /*!
+       * \brief Opens the segment \p name to read from the current
+       * write position.
+       *
+       * Returns 0 if there is no such segment, or its writer has not
+       * finished setting it up.
+       */
+      static shm_ring *attach(const std::string &name);
+
+      //! The writer marks the segment closed and removes its name
+      ~shm_ring();
+
+      const std::string &name() const { return d_name; }
+      size_t itemsize() const { return d_itemsize; }
+
+      //! Items the ring holds
+      size_t capacity() const { return d_capacity; }
+
+      //! Whether the writer waits for the readers
+      bool blocking() const;
+
+      //! Number of attached readers
+      unsigned int readers() const;
+
+      // Writer side
+
+      /*!
+       * \brief Number of items that can be written.
+       *
+       * When blocking, limited by the slowest reader, and 0 while
+       * the slowest reader has every tag slot still to read;
+       * otherwise a quarter of the ring, which is as far ahead of
+       * the last count it published as the writer ever gets.
+       */
+      size_t writable() const;
+
+      /*!
+       * \brief Puts a tag on item \p offset, counted from the first
+       * item of the next write().
+       *
+       * Tags must come in order of their items, and before the write
+       * of their items.
+       */
+      tag_status write_tag(const tag_t &tag, uint64_t offset);
+
+      //! Writes \p n items, no more than writable(), and publishes them with the tags before them
+      void write(const void *items, size_t n);
+
+      //! Readers finish when they have read everything written before close()
+      void close();
+
+      //! Undoes close()
+      void reopen();
+
+      //! Frees the slots of readers whose process has gone
+      unsigned int reap_readers();
+
+      // Reader side
+
+      /*!
+       * \brief Copies up to \p n items and the tags on them.
+       *
+       * The offsets of the tags are from the first item copied.  If
+       * the writer has overrun this reader, the items it lost are
+       * added to \p lost_items, and the tags it lost or could not
+       * decode to \p lost_tags.  Returns the number of items copied,
+       * 0 when there are none to read.
+       */
+      size_t read(void *items, size_t n, std::vector<tag_t> &tags,
+		  uint64_t &lost_items, uint64_t &lost_tags);
+
+      //! Items written and not yet read
+      uint64_t readable() const;
+
+      //! True once the writer has closed the segment and everything is read
+      bool done() const;
+
+      //! Waits a little more each round, yielding first and then sleeping
+      static void pause(unsigned int round);
+
+    private:
+      std::string d_name;
+      bool d_writer;
+      int d_fd;
+      char *d_base;
+      size_t d_map_size;
+      shm_ring_header *d_hdr;
+      char *d_data;
+      char *d_tags;
+      size_t d_itemsize;
+      size_t d_capacity;
+      size_t d_data_size;
+      size_t d_ntags;
+
+      // Writer: counts not yet published
+      uint64_t d_items;
+      uint64_t d_ntags_written;
+
+      // Reader: its slot
+      int d_slot;
+
+      shm_ring();
+      void map(bool writer);
+      void unmap();
+      struct shm_ring_tag *tag_slot(uint64_t n) const;
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_SHM_RING_H */
@@ -0,0 +1,171 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "shm_sink_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/high_res_timer.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    // Tag slots in the segment
+    static const size_t NTAGS = 4096;
+
+    shm_sink::sptr
+    shm_sink::make(size_t itemsize, const std::string &name,
+		   int nitems, bool block)
+    {
+      return gnuradio::get_initial_sptr
+	(new shm_sink_impl(itemsize, name, nitems, block));
+    }
+
+    shm_sink_impl::shm_sink_impl(size_t itemsize, const std::string &name,
+				 int nitems, bool block)
+      : sync_block("shm_sink",
+		   io_signature::make(1, 1, itemsize),
+		   io_signature::make(0, 0, 0)),
+	d_dropped_tags(0), d_cut_offset(0), d_cut_written(0)
+    {
+      if(nitems <= 0)
+	throw std::invalid_argument("shm_sink: nitems must be positive");
+      d_ring.reset(new shm_ring(name, itemsize, nitems, NTAGS, block));
+    }
+
+    shm_sink_impl::~shm_sink_impl()
+    {
+    }
+
+    bool
+    shm_sink_impl::start()
+    {
+      d_ring->reopen();
+      return true;
+    }
+
+    bool
+    shm_sink_impl::stop()
+    {
+      d_ring->close();
+      return true;
+    }
+
+    int
+    shm_sink_impl::work(int noutput_items,
+			gr_vector_const_void_star &input_items,
+			gr_vector_void_star &output_items)
+    {
+      const char *in = (const char*)input_items[0];
+
+      size_t n = d_ring->writable();
+      if(n == 0) {
+	// Wait a little for the slowest reader, so that the scheduler
+	// does not spin, and free the slots of readers that have died
+	// without detaching
+	gr::high_res_timer_type deadline =
+	  gr::high_res_timer_now() + gr::high_res_timer_tps() / 100;
+	for(unsigned int round = 0; (n = d_ring->writable()) == 0; round++) {
+	  if(gr::high_res_timer_now() > deadline) {
+	    unsigned int reaped = d_ring->reap_readers();
+	    if(reaped > 0)
+	      GR_LOG_WARN(d_logger, boost::format("freed %d readers that had gone") % reaped);
+	    return 0;
+	  }
+	  shm_ring::pause(round);
+	}
+      }
+      n = std::min<size_t>(n, noutput_items);
+
+      uint64_t nread = nitems_read(0);
+      get_tags_in_range(d_tags, 0, nread, nread + n);
+      // Stable, so that tags at one offset keep the same order from
+      // call to call and the ones already written can be skipped
+      std::stable_sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+      size_t same = 0;
+      for(size_t i = 0; i < d_tags.size(); i++) {
+	same = (i > 0 && d_tags[i].offset == d_tags[i-1].offset) ? same + 1 : 0;
+	if(d_tags[i].offset == d_cut_offset && same < d_cut_written)
+	  continue;
+	shm_ring::tag_status s = d_ring->write_tag(d_tags[i], d_tags[i].offset - nread);
+	if(s == shm_ring::TAG_FULL && same >= NTAGS) {
+	  // Every slot holds a tag on this item, which readers cannot
+	  // take before the item is written: drop the rest rather than
+	  // wait forever
+	  size_t end = i;
+	  while(end < d_tags.size() && d_tags[end].offset == d_tags[i].offset)
+	    end++;
+	  d_dropped_tags.fetch_add(end - i);
+	  GR_LOG_WARN(d_logger, boost::format("dropping %d tags past the %d the ring holds on one item")
+		      % (end - i) % NTAGS);
+	  i = end - 1;
+	  continue;
+	}
+	if(s == shm_ring::TAG_FULL) {
+	  // The rest when the readers catch up; the tags already written
+	  // at this offset come back in the next call
+	  n = d_tags[i].offset - nread;
+	  d_cut_offset = d_tags[i].offset;
+	  d_cut_written = same;
+	  break;
+	}
+	if(s == shm_ring::TAG_TOO_LARGE) {
+	  if(d_dropped_tags.fetch_add(1) == 0)
+	    GR_LOG_WARN(d_logger, boost::format("dropping tags too large for the ring, key %s")
+			% pmt::symbol_to_string(d_tags[i].key));
+	}
+      }
+
+      if(n > 0)
+	d_ring->write(in, n);
+      return n;
+    }
+
+    void
+    shm_sink_impl::setup_rpc()
+    {
+#ifdef GR_CTRLPORT
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<shm_sink, int>(
+	  alias(), "num_readers", &shm_sink::num_readers,
+	  pmt::mp(0), pmt::mp((int)shm_ring::MAX_READERS), pmt::mp(0),
+	  "", "Readers attached", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<shm_sink, uint64_t>(
+	  alias(), "dropped_tags", &shm_sink::dropped_tags,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "tags", "Tags too large for the ring", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+#endif /* GR_CTRLPORT */
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,69 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_BLOCKS_SHM_SINK_IMPL_H
+#define INCLUDED_BLOCKS_SHM_SINK_IMPL_H
+
+#include <gnuradio/blocks/shm_sink.h>
+#include <boost/atomic.hpp>
+#include <boost/scoped_ptr.hpp>
+#include "shm_ring.h"
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    class shm_sink_impl : public shm_sink
+    {
+    private:
+      boost::scoped_ptr<shm_ring> d_ring;
+      boost::atomic<uint64_t> d_dropped_tags;
+      std::vector<tag_t> d_tags;
+      uint64_t d_cut_offset;	// where the last call ran out of tag space
+      size_t d_cut_written;	// tags at d_cut_offset already in the ring
+
+    public:
+      shm_sink_impl(size_t itemsize, const std::string &name,
+		    int nitems, bool block);
+      ~shm_sink_impl();
+
+      void setup_rpc();
+
+      std::string name() const { return d_ring->name(); }
+      int capacity() const { return d_ring->capacity(); }
+      int num_readers() const { return d_ring->readers(); }
+      uint64_t dropped_tags() const { return d_dropped_tags.load(); }
+
+      bool start();
+      bool stop();
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_SHM_SINK_IMPL_H */
@@ -0,0 +1,149 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "shm_source_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/thread/thread.h>
+#include <boost/format.hpp>
+
+namespace gr {
+  namespace blocks {
+
+    shm_source::sptr
+    shm_source::make(size_t itemsize, const std::string &name)
+    {
+      return gnuradio::get_initial_sptr
+	(new shm_source_impl(itemsize, name));
+    }
+
+    shm_source_impl::shm_source_impl(size_t itemsize, const std::string &name)
+      : sync_block("shm_source",
+		   io_signature::make(0, 0, 0),
+		   io_signature::make(1, 1, itemsize)),
+	d_itemsize(itemsize), d_name(name), d_attached(false),
+	d_lost_items(0), d_lost_tags(0), d_lost_carry(0),
+	d_lost_key(pmt::intern("items_lost"))
+    {
+      if(name.empty())
+	throw std::invalid_argument("shm_source: empty segment name");
+    }
+
+    shm_source_impl::~shm_source_impl()
+    {
+    }
+
+    bool
+    shm_source_impl::stop()
+    {
+      // Detach, so that the sink does not wait for this reader
+      d_ring.reset();
+      d_attached.store(false);
+      return true;
+    }
+
+    int
+    shm_source_impl::work(int noutput_items,
+			  gr_vector_const_void_star &input_items,
+			  gr_vector_void_star &output_items)
+    {
+      if(!d_ring) {
+	d_ring.reset(shm_ring::attach(d_name));
+	if(!d_ring) {
+	  // No writer yet
+	  boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+	  return 0;
+	}
+	if(d_ring->itemsize() != d_itemsize) {
+	  GR_LOG_ERROR(d_logger, boost::format("%s holds items of %d bytes, not %d")
+		       % d_ring->name() % d_ring->itemsize() % d_itemsize);
+	  d_ring.reset();
+	  return WORK_DONE;
+	}
+	d_attached.store(true);
+      }
+
+      // Wait a little for the sink, so that the scheduler does not spin
+      gr::high_res_timer_type deadline = 0;
+      uint64_t lost_items = 0, lost_tags = 0;
+      size_t n;
+      d_tags.clear();
+      for(unsigned int round = 0;
+	  (n = d_ring->read(output_items[0], noutput_items, d_tags,
+			    lost_items, lost_tags)) == 0; round++) {
+	if(d_ring->done())
+	  return WORK_DONE;
+	if(round == 0)
+	  deadline = gr::high_res_timer_now() + gr::high_res_timer_tps() / 100;
+	else if(gr::high_res_timer_now() > deadline)
+	  break;
+	shm_ring::pause(round);
+      }
+
+      if(lost_items > 0 || lost_tags > 0) {
+	d_lost_items.fetch_add(lost_items);
+	d_lost_tags.fetch_add(lost_tags);
+	d_lost_carry += lost_items;
+      }
+      if(n == 0)
+	return 0;
+
+      uint64_t abs_out = nitems_written(0);
+      if(d_lost_carry > 0) {
+	add_item_tag(0, abs_out, d_lost_key, pmt::from_uint64(d_lost_carry), alias_pmt());
+	d_lost_carry = 0;
+      }
+      for(size_t i = 0; i < d_tags.size(); i++)
+	add_item_tag(0, abs_out + d_tags[i].offset, d_tags[i].key,
+		     d_tags[i].value, d_tags[i].srcid);
+
+      return n;
+    }
+
+    void
+    shm_source_impl::setup_rpc()
+    {
+#ifdef GR_CTRLPORT
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<shm_source, uint64_t>(
+	  alias(), "lost_items", &shm_source::lost_items,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "items", "Items skipped after an overrun", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<shm_source, uint64_t>(
+	  alias(), "lost_tags", &shm_source::lost_tags,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "tags", "Tags overwritten before they were read", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+#endif /* GR_CTRLPORT */
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
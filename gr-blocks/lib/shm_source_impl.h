@@ -0,0 +1,71 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#ifndef INCLUDED_BLOCKS_SHM_SOURCE_IMPL_H
+#define INCLUDED_BLOCKS_SHM_SOURCE_IMPL_H
+
+#include <gnuradio/blocks/shm_source.h>
+#include <boost/atomic.hpp>
+#include <boost/scoped_ptr.hpp>
+#include "shm_ring.h"
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    class shm_source_impl : public shm_source
+    {
+    private:
+      size_t d_itemsize;
+      std::string d_name;
+      boost::scoped_ptr<shm_ring> d_ring;
+      boost::atomic<bool> d_attached;
+      boost::atomic<uint64_t> d_lost_items;
+      boost::atomic<uint64_t> d_lost_tags;
+      uint64_t d_lost_carry;        // items lost before the next output
+      std::vector<tag_t> d_tags;
+      pmt::pmt_t d_lost_key;
+
+    public:
+      shm_source_impl(size_t itemsize, const std::string &name);
+      ~shm_source_impl();
+
+      void setup_rpc();
+
+      std::string name() const { return d_name; }
+      bool attached() const { return d_attached.load(); }
+      uint64_t lost_items() const { return d_lost_items.load(); }
+      uint64_t lost_tags() const { return d_lost_tags.load(); }
+
+      bool stop();
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_SHM_SOURCE_IMPL_H */
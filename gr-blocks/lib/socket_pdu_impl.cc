@@ -28,24 +28,38 @@
 #include "tcp_connection.h"
 #include <gnuradio/io_signature.h>
 #include <gnuradio/blocks/pdu.h>
+#include <gnuradio/block_registry.h>
+#include <gnuradio/prefs.h>
+#include <algorithm>
 
 namespace gr {
   namespace blocks {
 
     socket_pdu::sptr
-    socket_pdu::make(std::string type, std::string addr, std::string port, int MTU)
+    socket_pdu::make(std::string type, std::string addr, std::string port, int MTU,
+		     bool framed, int io_threads)
     {
-      return gnuradio::get_initial_sptr(new socket_pdu_impl(type, addr, port, MTU));
+      return gnuradio::get_initial_sptr(new socket_pdu_impl(type, addr, port, MTU,
+							    framed, io_threads));
     }
 
-    socket_pdu_impl::socket_pdu_impl(std::string type, std::string addr, std::string port, int MTU)
+    socket_pdu_impl::socket_pdu_impl(std::string type, std::string addr, std::string port,
+				     int MTU, bool framed, int io_threads)
       :	block("socket_pdu",
 		 io_signature::make (0, 0, 0),
-		 io_signature::make (0, 0, 0))
+		 io_signature::make (0, 0, 0)),
+	stream_pdu_base(MTU),
+	d_io_service(std::max(io_threads, 1)),
+	d_mtu(MTU),
+	d_framed(framed)
     {
       message_port_register_in(PDU_PORT_ID);
       message_port_register_out(PDU_PORT_ID);
 
+      // the scheduler's limit on a message queue
+      prefs *p = prefs::singleton();
+      d_max_queued = static_cast<size_t>(p->get_long("DEFAULT", "max_messages", 100));
+
       if ((type == "TCP_SERVER") || (type == "TCP_CLIENT")) {
         boost::asio::ip::tcp::resolver resolver(d_io_service);
         boost::asio::ip::tcp::resolver::query query(boost::asio::ip::tcp::v4(), addr, port);
@@ -66,24 +80,19 @@ namespace gr {
         d_acceptor_tcp.reset(new boost::asio::ip::tcp::acceptor(d_io_service, d_tcp_endpoint));
         d_acceptor_tcp->set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
         start_tcp_accept();
-        set_msg_handler(PDU_PORT_ID, boost::bind(&socket_pdu_impl::tcp_server_send, this, _1));
-
+        set_msg_handler(PDU_PORT_ID, boost::bind(&socket_pdu_impl::tcp_send, this, _1));
       }
       else if (type =="TCP_CLIENT") {
         boost::system::error_code error = boost::asio::error::host_not_found;
-        d_tcp_socket.reset(new boost::asio::ip::tcp::socket(d_io_service));
-        d_tcp_socket->connect(d_tcp_endpoint, error);
+        tcp_connection::sptr connection = tcp_connection::make(d_io_service, d_mtu, d_framed,
+							       d_max_queued);
+        connection->socket().connect(d_tcp_endpoint, error);
         if (error)
             throw boost::system::system_error(error);
 
-        set_msg_handler(PDU_PORT_ID, boost::bind(&socket_pdu_impl::tcp_client_send, this, _1));
-
-        d_tcp_socket->async_read_some(
-	  boost::asio::buffer(d_rxbuf),
-	  boost::bind(&socket_pdu_impl::handle_tcp_read, this, 
-                      boost::asio::placeholders::error, 
-                      boost::asio::placeholders::bytes_transferred)
-	);
+        connection->start(this);
+        d_tcp_connections.push_back(connection);
+        set_msg_handler(PDU_PORT_ID, boost::bind(&socket_pdu_impl::tcp_send, this, _1));
       }
       else if (type =="UDP_SERVER") {
         d_udp_socket.reset(new boost::asio::ip::udp::socket(d_io_service, d_udp_endpoint));
@@ -104,31 +113,21 @@ namespace gr {
       else
 	throw std::runtime_error("gr::blocks:socket_pdu: unknown socket type");
 
-      d_thread = gr::thread::thread(boost::bind(&socket_pdu_impl::run_io_service, this));
-      d_started = true;
+      for (int i = 0; i < std::max(io_threads, 1); i++)
+	d_io_threads.create_thread(boost::bind(&socket_pdu_impl::run_io_service, this));
     }
 
-    void
-    socket_pdu_impl::handle_tcp_read(const boost::system::error_code& error, size_t bytes_transferred)
+    socket_pdu_impl::~socket_pdu_impl()
     {
-      if (!error) {
-	pmt::pmt_t vector = pmt::init_u8vector(bytes_transferred, (const uint8_t *)&d_rxbuf[0]);
-	pmt::pmt_t pdu = pmt::cons(pmt::PMT_NIL, vector);
-	message_port_pub(PDU_PORT_ID, pdu);
-
-	d_tcp_socket->async_read_some(boost::asio::buffer(d_rxbuf),
-				      boost::bind(&socket_pdu_impl::handle_tcp_read, this,
-						  boost::asio::placeholders::error,
-						  boost::asio::placeholders::bytes_transferred));
-      }
-      else
-        throw boost::system::system_error(error);
+      d_io_service.stop();
+      d_io_threads.join_all();
     }
 
     void
     socket_pdu_impl::start_tcp_accept()
     {
-      tcp_connection::sptr new_connection = tcp_connection::make(d_acceptor_tcp->get_io_service());
+      tcp_connection::sptr new_connection = tcp_connection::make(d_io_service, d_mtu, d_framed,
+								   d_max_queued);
 
       d_acceptor_tcp->async_accept(new_connection->socket(),
 				   boost::bind(&socket_pdu_impl::handle_tcp_accept, this, 
@@ -136,9 +135,10 @@ namespace gr {
     }
 
     void
-    socket_pdu_impl::tcp_server_send(pmt::pmt_t msg)
+    socket_pdu_impl::tcp_send(pmt::pmt_t msg)
     {
       pmt::pmt_t vector = pmt::cdr(msg);
+      gr::thread::scoped_lock guard(d_tcp_mutex);
       for(size_t i = 0; i < d_tcp_connections.size(); i++)
         d_tcp_connections[i]->send(vector);
     }
@@ -147,42 +147,62 @@ namespace gr {
     socket_pdu_impl::handle_tcp_accept(tcp_connection::sptr new_connection, const boost::system::error_code& error)
     {
       if (!error) {
+	// Started first, so that tcp_send never sees it without an owner
 	new_connection->start(this);
-	d_tcp_connections.push_back(new_connection);
+	{
+	  gr::thread::scoped_lock guard(d_tcp_mutex);
+	  d_tcp_connections.push_back(new_connection);
+	}
 	start_tcp_accept();
       }
       else
 	std::cout << error << std::endl;
     }
 
+    // Runs on the I/O threads, where an exception would terminate
+    // the program; a subscriber that is gone does not hold reads back
+    bool
+    socket_pdu_impl::backlogged()
+    {
+      pmt::pmt_t targets = pmt::dict_ref(d_message_subscribers, PDU_PORT_ID, pmt::PMT_NIL);
+      while(pmt::is_pair(targets)) {
+        pmt::pmt_t target = pmt::car(targets);
+        try {
+          basic_block_sptr blk = global_block_registry.block_lookup(pmt::car(target));
+          if(blk->nmsgs_locked(pmt::cdr(target)) >= d_max_queued)
+            return true;
+        }
+        catch(std::exception &) {
+        }
+        targets = pmt::cdr(targets);
+      }
+      return false;
+    }
+
     void
-    socket_pdu_impl::tcp_client_send(pmt::pmt_t msg)
+    socket_pdu_impl::remove_connection(tcp_connection::sptr connection)
     {
-      pmt::pmt_t vector = pmt::cdr(msg);
-      size_t len = pmt::length(vector);
-      size_t offset(0);
-      boost::array<char, 10000> txbuf;
-      memcpy(&txbuf[0], pmt::uniform_vector_elements(vector, offset), len);
-      d_tcp_socket->send(boost::asio::buffer(txbuf,len));
+      gr::thread::scoped_lock guard(d_tcp_mutex);
+      d_tcp_connections.erase(std::remove(d_tcp_connections.begin(), d_tcp_connections.end(),
+					  connection),
+			      d_tcp_connections.end());
     }
 
     void
     socket_pdu_impl::udp_send(pmt::pmt_t msg)
     {
       pmt::pmt_t vector = pmt::cdr(msg);
-      size_t len = pmt::length(vector);
-      size_t offset(0);
-      boost::array<char, 10000> txbuf;
-      memcpy(&txbuf[0], pmt::uniform_vector_elements(vector, offset), len);
+      size_t len;
+      const void *data = pmt::uniform_vector_elements(vector, len);
       if (d_udp_endpoint_other.address().to_string() != "0.0.0.0")
-        d_udp_socket->send_to(boost::asio::buffer(txbuf,len), d_udp_endpoint_other);
+        d_udp_socket->send_to(boost::asio::buffer(data, len), d_udp_endpoint_other);
     }
 
     void
     socket_pdu_impl::handle_udp_read(const boost::system::error_code& error, size_t bytes_transferred)
     {
       if (!error) {
-        pmt::pmt_t vector = pmt::init_u8vector(bytes_transferred, (const uint8_t*)&d_rxbuf[0]);
+        pmt::pmt_t vector = pmt::init_u8vector(bytes_transferred, &d_rxbuf[0]);
         pmt::pmt_t pdu = pmt::cons( pmt::PMT_NIL, vector);
         
         message_port_pub(PDU_PORT_ID, pdu);
@@ -24,6 +24,7 @@
 #define INCLUDED_BLOCKS_SOCKET_PDU_IMPL_H
 
 #include <gnuradio/blocks/socket_pdu.h>
+#include <boost/thread/thread.hpp>
 #include "stream_pdu_base.h"
 #include "tcp_connection.h"
 
@@ -34,33 +35,39 @@ namespace gr {
     {
     private:
       boost::asio::io_service d_io_service;
-      boost::array<char, 10000> d_rxbuf;
+      boost::thread_group d_io_threads;
+      int d_mtu;
+      bool d_framed;
+      size_t d_max_queued;
       void run_io_service() { d_io_service.run(); }
 
       // TCP specific
       boost::asio::ip::tcp::endpoint d_tcp_endpoint;
+      gr::thread::mutex d_tcp_mutex;	// guards d_tcp_connections
       std::vector<tcp_connection::sptr> d_tcp_connections;
-      void handle_tcp_read(const boost::system::error_code& error, size_t bytes_transferred);
+      void tcp_send(pmt::pmt_t msg);
 
       // TCP server specific
       boost::shared_ptr<boost::asio::ip::tcp::acceptor> d_acceptor_tcp;
       void start_tcp_accept();
-      void tcp_server_send(pmt::pmt_t msg);
       void handle_tcp_accept(tcp_connection::sptr new_connection, const boost::system::error_code& error);
 
-      // TCP client specific
-      boost::shared_ptr<boost::asio::ip::tcp::socket> d_tcp_socket;
-      void tcp_client_send(pmt::pmt_t msg);
-
       // UDP specific
       boost::asio::ip::udp::endpoint d_udp_endpoint;
       boost::asio::ip::udp::endpoint d_udp_endpoint_other;
       boost::shared_ptr<boost::asio::ip::udp::socket> d_udp_socket;
       void handle_udp_read(const boost::system::error_code& error, size_t bytes_transferred);
       void udp_send(pmt::pmt_t msg);
-    
+
+      // Called by the connections
+      friend class tcp_connection;
+      bool backlogged();
+      void remove_connection(tcp_connection::sptr connection);
+
     public:
-      socket_pdu_impl(std::string type, std::string addr, std::string port, int MTU);
+      socket_pdu_impl(std::string type, std::string addr, std::string port,
+		      int MTU, bool framed, int io_threads);
+      ~socket_pdu_impl();
     };
 
   } /* namespace blocks */
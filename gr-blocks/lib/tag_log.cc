@@ -0,0 +1,405 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/blocks/tag_log.h>
+#include <pmt/pmt.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    /*
+     * File:    "GRTAGL01", blocks, index
+     * Block:   "TAGB", payload size (u32), ntags (u32),
+     *          first offset (u64), last offset (u64), payload
+     * Payload: number of atoms, atoms as (length, serialized pmt),
+     *          then per tag: offset - previous offset (the first
+     *          from the block's first offset), key, value, srcid
+     *          as atom numbers; all variable length
+     * Index:   per block: first, last, file position, ntags (u64),
+     *          then the number of blocks (u64) and "GRTAGIDX"
+     *
+     * Fixed size numbers are big endian.
+     */
+
+    static const char FILE_MAGIC[8] = {'G','R','T','A','G','L','0','1'};
+    static const char BLOCK_MAGIC[4] = {'T','A','G','B'};
+    static const char INDEX_MAGIC[8] = {'G','R','T','A','G','I','D','X'};
+    static const size_t BLOCK_HEADER_SIZE = 28;
+    static const size_t INDEX_ENTRY_SIZE = 32;
+
+    static void
+    put_be(std::string &s, uint64_t v, int nbytes)
+    {
+      for(int i = nbytes - 1; i >= 0; i--)
+	s.push_back((char)((v >> (8*i)) & 0xff));
+    }
+
+    static uint64_t
+    get_be(const unsigned char *p, int nbytes)
+    {
+      uint64_t v = 0;
+      for(int i = 0; i < nbytes; i++)
+	v = (v << 8) | p[i];
+      return v;
+    }
+
+    static void
+    put_varint(std::string &s, uint64_t v)
+    {
+      while(v >= 0x80) {
+	s.push_back((char)((v & 0x7f) | 0x80));
+	v >>= 7;
+      }
+      s.push_back((char)v);
+    }
+
+    static uint64_t
+    get_varint(const unsigned char *&p, const unsigned char *end)
+    {
+      uint64_t v = 0;
+      for(int shift = 0; p < end && shift < 64; shift += 7) {
+	unsigned char c = *p++;
+	v |= (uint64_t)(c & 0x7f) << shift;
+	if(!(c & 0x80))
+	  return v;
+      }
+      throw std::runtime_error("tag_log: corrupt block");
+    }
+
+    static void
+    write_all(FILE *fp, const std::string &s)
+    {
+      if(fwrite(s.data(), 1, s.size(), fp) != s.size())
+	throw std::runtime_error("tag_log: write failed");
+    }
+
+    /**************************************************************/
+
+    tag_log_writer::tag_log_writer(const std::string &filename,
+				   unsigned int block_tags)
+      : d_block_tags(std::max(block_tags, 1u)), d_ntags(0)
+    {
+      if((d_fp = fopen(filename.c_str(), "wb")) == NULL) {
+	perror(filename.c_str());
+	throw std::runtime_error("tag_log_writer: can't open file");
+      }
+      write_all(d_fp, std::string(FILE_MAGIC, sizeof(FILE_MAGIC)));
+    }
+
+    tag_log_writer::~tag_log_writer()
+    {
+      close();
+    }
+
+    void
+    tag_log_writer::add(const tag_t &tag)
+    {
+      if(!d_fp)
+	throw std::runtime_error("tag_log_writer: file is closed");
+      if(!d_blocks.empty() && tag.offset < d_blocks.back().last)
+	throw std::invalid_argument("tag_log_writer: tag before the last block written");
+
+      d_pending.push_back(tag);
+      d_ntags++;
+      if(d_pending.size() >= d_block_tags)
+	flush();
+    }
+
+    void
+    tag_log_writer::flush()
+    {
+      if(!d_fp || d_pending.empty())
+	return;
+
+      std::stable_sort(d_pending.begin(), d_pending.end(), tag_t::offset_compare);
+
+      // Number the distinct keys, values and source ids
+      std::map<std::string, uint64_t> numbers;
+      std::vector<const std::string*> atoms;
+      std::vector<uint64_t> refs;
+      refs.reserve(3*d_pending.size());
+      for(size_t i = 0; i < d_pending.size(); i++) {
+	pmt::pmt_t p[3] = {d_pending[i].key, d_pending[i].value, d_pending[i].srcid};
+	for(int j = 0; j < 3; j++) {
+	  if(!p[j])
+	    p[j] = pmt::PMT_F;	// tags made without a source id
+	  std::pair<std::map<std::string, uint64_t>::iterator, bool> r =
+	    numbers.insert(std::make_pair(pmt::serialize_str(p[j]), (uint64_t)atoms.size()));
+	  if(r.second)
+	    atoms.push_back(&r.first->first);
+	  refs.push_back(r.first->second);
+	}
+      }
+
+      std::string payload;
+      put_varint(payload, atoms.size());
+      for(size_t i = 0; i < atoms.size(); i++) {
+	put_varint(payload, atoms[i]->size());
+	payload += *atoms[i];
+      }
+      uint64_t prev = d_pending.front().offset;
+      for(size_t i = 0; i < d_pending.size(); i++) {
+	put_varint(payload, d_pending[i].offset - prev);
+	prev = d_pending[i].offset;
+	put_varint(payload, refs[3*i]);
+	put_varint(payload, refs[3*i+1]);
+	put_varint(payload, refs[3*i+2]);
+      }
+
+      block_info b;
+      b.first = d_pending.front().offset;
+      b.last = d_pending.back().offset;
+      b.pos = ftell(d_fp);
+      b.ntags = d_pending.size();
+
+      std::string header(BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+      put_be(header, payload.size(), 4);
+      put_be(header, b.ntags, 4);
+      put_be(header, b.first, 8);
+      put_be(header, b.last, 8);
+      write_all(d_fp, header);
+      write_all(d_fp, payload);
+      fflush(d_fp);
+
+      d_blocks.push_back(b);
+      d_pending.clear();
+    }
+
+    void
+    tag_log_writer::close()
+    {
+      if(!d_fp)
+	return;
+
+      flush();
+
+      std::string index;
+      for(size_t i = 0; i < d_blocks.size(); i++) {
+	put_be(index, d_blocks[i].first, 8);
+	put_be(index, d_blocks[i].last, 8);
+	put_be(index, d_blocks[i].pos, 8);
+	put_be(index, d_blocks[i].ntags, 8);
+      }
+      put_be(index, d_blocks.size(), 8);
+      index.append(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+      write_all(d_fp, index);
+
+      fclose(d_fp);
+      d_fp = 0;
+    }
+
+    /**************************************************************/
+
+    tag_log_reader::tag_log_reader(const std::string &filename)
+      : d_ntags(0), d_cached(0)
+    {
+      if((d_fp = fopen(filename.c_str(), "rb")) == NULL) {
+	perror(filename.c_str());
+	throw std::runtime_error("tag_log_reader: can't open file");
+      }
+
+      char magic[sizeof(FILE_MAGIC)];
+      if(fread(magic, 1, sizeof(magic), d_fp) != sizeof(magic) ||
+	 memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+	fclose(d_fp);
+	throw std::runtime_error("tag_log_reader: " + filename + " is not a tag log");
+      }
+
+      if(!read_index())
+	scan_blocks();
+
+      for(size_t i = 0; i < d_blocks.size(); i++)
+	d_ntags += d_blocks[i].ntags;
+      d_cached = d_blocks.size();
+    }
+
+    tag_log_reader::~tag_log_reader()
+    {
+      fclose(d_fp);
+    }
+
+    bool
+    tag_log_reader::read_index()
+    {
+      unsigned char tail[16];
+      if(fseek(d_fp, -16, SEEK_END) != 0 || fread(tail, 1, 16, d_fp) != 16 ||
+	 memcmp(tail + 8, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+	return false;
+
+      uint64_t nblocks = get_be(tail, 8);
+      long size = ftell(d_fp);
+      if(nblocks > (uint64_t)(size / INDEX_ENTRY_SIZE))
+	return false;
+
+      std::vector<unsigned char> index(nblocks * INDEX_ENTRY_SIZE);
+      if(fseek(d_fp, size - 16 - (long)index.size(), SEEK_SET) != 0 ||
+	 (nblocks > 0 && fread(&index[0], 1, index.size(), d_fp) != index.size()))
+	return false;
+
+      d_blocks.resize(nblocks);
+      for(size_t i = 0; i < nblocks; i++) {
+	const unsigned char *p = &index[i * INDEX_ENTRY_SIZE];
+	d_blocks[i].first = get_be(p, 8);
+	d_blocks[i].last = get_be(p + 8, 8);
+	d_blocks[i].pos = get_be(p + 16, 8);
+	d_blocks[i].ntags = get_be(p + 24, 8);
+      }
+      return true;
+    }
+
+    void
+    tag_log_reader::scan_blocks()
+    {
+      // No index: the log was not closed.  Take the blocks that were
+      // written out whole.
+      fseek(d_fp, 0, SEEK_END);
+      long size = ftell(d_fp);
+      long pos = sizeof(FILE_MAGIC);
+      unsigned char h[BLOCK_HEADER_SIZE];
+
+      d_blocks.clear();
+      while(fseek(d_fp, pos, SEEK_SET) == 0 &&
+	    fread(h, 1, BLOCK_HEADER_SIZE, d_fp) == BLOCK_HEADER_SIZE &&
+	    memcmp(h, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) == 0) {
+	uint64_t payload = get_be(h + 4, 4);
+	if(pos + BLOCK_HEADER_SIZE + payload > (uint64_t)size)
+	  break;
+
+	block_info b;
+	b.ntags = get_be(h + 8, 4);
+	b.first = get_be(h + 12, 8);
+	b.last = get_be(h + 20, 8);
+	b.pos = pos;
+	d_blocks.push_back(b);
+	pos += BLOCK_HEADER_SIZE + payload;
+      }
+    }
+
+    void
+    tag_log_reader::decode(size_t n)
+    {
+      if(n == d_cached)
+	return;
+
+      unsigned char h[BLOCK_HEADER_SIZE];
+      if(fseek(d_fp, d_blocks[n].pos, SEEK_SET) != 0 ||
+	 fread(h, 1, BLOCK_HEADER_SIZE, d_fp) != BLOCK_HEADER_SIZE ||
+	 memcmp(h, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0)
+	throw std::runtime_error("tag_log: corrupt block");
+
+      d_cached = d_blocks.size();
+      d_payload.resize(get_be(h + 4, 4));
+      if(!d_payload.empty() &&
+	 fread(&d_payload[0], 1, d_payload.size(), d_fp) != d_payload.size())
+	throw std::runtime_error("tag_log: truncated block");
+
+      const unsigned char *begin = (const unsigned char*)&d_payload[0];
+      const unsigned char *p = begin;
+      const unsigned char *end = p + d_payload.size();
+
+      size_t natoms = get_varint(p, end);
+      if(natoms > d_payload.size())
+	throw std::runtime_error("tag_log: corrupt block");
+      d_atom_pos.resize(2*natoms);
+      for(size_t i = 0; i < natoms; i++) {
+	uint64_t len = get_varint(p, end);
+	if(len > (uint64_t)(end - p))
+	  throw std::runtime_error("tag_log: corrupt block");
+	d_atom_pos[2*i] = p - begin;
+	d_atom_pos[2*i+1] = len;
+	p += len;
+      }
+      d_atoms.assign(natoms, pmt::pmt_t());
+
+      d_refs.resize(d_blocks[n].ntags);
+      uint64_t offset = d_blocks[n].first;
+      for(size_t i = 0; i < d_refs.size(); i++) {
+	offset += get_varint(p, end);
+	d_refs[i].offset = offset;
+	d_refs[i].key = get_varint(p, end);
+	d_refs[i].value = get_varint(p, end);
+	d_refs[i].srcid = get_varint(p, end);
+	if(d_refs[i].key >= natoms || d_refs[i].value >= natoms ||
+	   d_refs[i].srcid >= natoms)
+	  throw std::runtime_error("tag_log: corrupt block");
+      }
+      d_cached = n;
+    }
+
+    pmt::pmt_t
+    tag_log_reader::atom(size_t i)
+    {
+      if(!d_atoms[i])
+	d_atoms[i] = pmt::deserialize_str(std::string(&d_payload[d_atom_pos[2*i]],
+						      d_atom_pos[2*i+1]));
+      return d_atoms[i];
+    }
+
+    void
+    tag_log_reader::get_tags(std::vector<tag_t> &tags,
+			     uint64_t start, uint64_t end)
+    {
+      // First block with tags at or after start
+      size_t lo = 0, hi = d_blocks.size();
+      while(lo < hi) {
+	size_t mid = lo + (hi - lo) / 2;
+	if(d_blocks[mid].last < start)
+	  lo = mid + 1;
+	else
+	  hi = mid;
+      }
+
+      for(size_t n = lo; n < d_blocks.size() && d_blocks[n].first < end; n++) {
+	decode(n);
+
+	// First tag of the block at or after start
+	size_t i = 0, j = d_refs.size();
+	while(i < j) {
+	  size_t mid = i + (j - i) / 2;
+	  if(d_refs[mid].offset < start)
+	    i = mid + 1;
+	  else
+	    j = mid;
+	}
+
+	for(; i < d_refs.size() && d_refs[i].offset < end; i++) {
+	  tag_t t;
+	  t.offset = d_refs[i].offset;
+	  t.key = atom(d_refs[i].key);
+	  t.value = atom(d_refs[i].value);
+	  t.srcid = atom(d_refs[i].srcid);
+	  tags.push_back(t);
+	}
+      }
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,116 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tag_log_sink_impl.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    tag_log_sink::sptr
+    tag_log_sink::make(size_t itemsize, const char *filename,
+		       unsigned int block_tags)
+    {
+      return gnuradio::get_initial_sptr
+	(new tag_log_sink_impl(itemsize, filename, block_tags));
+    }
+
+    tag_log_sink_impl::tag_log_sink_impl(size_t itemsize,
+					 const char *filename,
+					 unsigned int block_tags)
+      : sync_block("tag_log_sink",
+		   io_signature::make(1, 1, itemsize),
+		   io_signature::make(0, 0, 0)),
+	d_itemsize(itemsize), d_fp(0), d_log(0)
+    {
+      if((d_fp = fopen(filename, "wb")) == NULL) {
+	perror(filename);
+	throw std::runtime_error("tag_log_sink: can't open file");
+      }
+
+      try {
+	d_log = new tag_log_writer(std::string(filename) + ".tags", block_tags);
+      }
+      catch(...) {
+	fclose(d_fp);
+	throw;
+      }
+    }
+
+    tag_log_sink_impl::~tag_log_sink_impl()
+    {
+      close();
+      delete d_log;
+    }
+
+    void
+    tag_log_sink_impl::close()
+    {
+      gr::thread::scoped_lock guard(d_mutex);
+      if(!d_fp)
+	return;
+
+      d_log->close();
+      fclose(d_fp);
+      d_fp = 0;
+    }
+
+    int
+    tag_log_sink_impl::work(int noutput_items,
+			    gr_vector_const_void_star &input_items,
+			    gr_vector_void_star &output_items)
+    {
+      const char *inbuf = (const char*)input_items[0];
+
+      gr::thread::scoped_lock guard(d_mutex);
+      if(!d_fp)
+	return noutput_items;		// drop output on the floor
+
+      // Item n of the stream is item n of the file
+      uint64_t abs_N = nitems_read(0);
+      d_tags.clear();
+      get_tags_in_range(d_tags, 0, abs_N, abs_N + noutput_items);
+      // The writer needs offsets in order; tags come in insertion
+      // order, which is kept among tags at one offset
+      std::stable_sort(d_tags.begin(), d_tags.end(), tag_t::offset_compare);
+      for(size_t i = 0; i < d_tags.size(); i++)
+	d_log->add(d_tags[i]);
+
+      if(fwrite(inbuf, d_itemsize, noutput_items, d_fp) != (size_t)noutput_items) {
+	std::stringstream s;
+	s << "tag_log_sink write failed with error " << fileno(d_fp) << std::endl;
+	throw std::runtime_error(s.str());
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_TAG_LOG_SINK_IMPL_H
+#define INCLUDED_BLOCKS_TAG_LOG_SINK_IMPL_H
+
+#include <gnuradio/blocks/tag_log_sink.h>
+#include <gnuradio/blocks/tag_log.h>
+#include <gnuradio/thread/thread.h>
+#include <cstdio>
+
+namespace gr {
+  namespace blocks {
+
+    class tag_log_sink_impl : public tag_log_sink
+    {
+    private:
+      size_t d_itemsize;
+      FILE *d_fp;
+      tag_log_writer *d_log;
+      std::vector<tag_t> d_tags;
+      gr::thread::mutex d_mutex;
+
+    public:
+      tag_log_sink_impl(size_t itemsize, const char *filename,
+			unsigned int block_tags);
+      ~tag_log_sink_impl();
+
+      void close();
+      uint64_t num_tags() const { return d_log->ntags(); }
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_TAG_LOG_SINK_IMPL_H */
@@ -0,0 +1,156 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "tag_log_source_impl.h"
+#include <gnuradio/io_signature.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace blocks {
+
+    tag_log_source::sptr
+    tag_log_source::make(size_t itemsize, const char *filename, bool repeat)
+    {
+      return gnuradio::get_initial_sptr
+	(new tag_log_source_impl(itemsize, filename, repeat));
+    }
+
+    tag_log_source_impl::tag_log_source_impl(size_t itemsize,
+					     const char *filename,
+					     bool repeat)
+      : sync_block("tag_log_source",
+		   io_signature::make(0, 0, 0),
+		   io_signature::make(1, 1, itemsize)),
+	d_itemsize(itemsize), d_repeat(repeat), d_fp(0),
+	d_nitems(0), d_pos(0), d_seeked(false), d_log(0)
+    {
+      if((d_fp = fopen(filename, "rb")) == NULL) {
+	perror(filename);
+	throw std::runtime_error("tag_log_source: can't open file");
+      }
+
+      fseek(d_fp, 0, SEEK_END);
+      d_nitems = (uint64_t)ftell(d_fp) / d_itemsize;
+      fseek(d_fp, 0, SEEK_SET);
+
+      if(d_nitems == 0 && d_repeat) {
+	fclose(d_fp);
+	throw std::runtime_error("tag_log_source: can't repeat an empty file");
+      }
+
+      try {
+	d_log = new tag_log_reader(std::string(filename) + ".tags");
+      }
+      catch(...) {
+	fclose(d_fp);
+	throw;
+      }
+    }
+
+    tag_log_source_impl::~tag_log_source_impl()
+    {
+      delete d_log;
+      fclose(d_fp);
+    }
+
+    bool
+    tag_log_source_impl::seek(long seek_point, int whence)
+    {
+      gr::thread::scoped_lock lock(d_mutex);
+
+      int64_t base;
+      switch(whence) {
+      case SEEK_SET: base = 0; break;
+      case SEEK_CUR: base = d_pos; break;
+      case SEEK_END: base = d_nitems; break;
+      default: return false;
+      }
+
+      int64_t pos = base + seek_point;
+      if(pos < 0 || (uint64_t)pos > d_nitems)
+	return false;
+
+      d_pos = pos;
+      d_seeked = true;
+      return true;
+    }
+
+    void
+    tag_log_source_impl::add_tags(uint64_t nitems, uint64_t abs_offset)
+    {
+      d_tags.clear();
+      d_log->get_tags(d_tags, d_pos, d_pos + nitems);
+      for(size_t i = 0; i < d_tags.size(); i++) {
+	const tag_t &t = d_tags[i];
+	add_item_tag(0, abs_offset + t.offset - d_pos, t.key, t.value, t.srcid);
+      }
+    }
+
+    int
+    tag_log_source_impl::work(int noutput_items,
+			      gr_vector_const_void_star &input_items,
+			      gr_vector_void_star &output_items)
+    {
+      char *out = (char*)output_items[0];
+      uint64_t abs_offset = nitems_written(0);
+      int produced = 0;
+
+      gr::thread::scoped_lock lock(d_mutex);
+
+      while(produced < noutput_items) {
+	if(d_pos == d_nitems) {
+	  if(!d_repeat)
+	    break;
+	  d_pos = 0;
+	  d_seeked = true;
+	}
+
+	if(d_seeked) {
+	  if(fseek(d_fp, (long)(d_pos * d_itemsize), SEEK_SET) != 0)
+	    throw std::runtime_error("tag_log_source: seek failed");
+	  d_seeked = false;
+	}
+
+	uint64_t n = std::min<uint64_t>(noutput_items - produced, d_nitems - d_pos);
+	n = fread(out + produced * d_itemsize, d_itemsize, n, d_fp);
+	if(n == 0)
+	  break;	// the file was truncated under us
+
+	add_tags(n, abs_offset + produced);
+	d_pos += n;
+	produced += n;
+      }
+
+      if(produced == 0)
+	return -1;	// end of file, we're done
+
+      return produced;
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
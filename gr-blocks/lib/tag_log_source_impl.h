@@ -0,0 +1,68 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_TAG_LOG_SOURCE_IMPL_H
+#define INCLUDED_BLOCKS_TAG_LOG_SOURCE_IMPL_H
+
+#include <gnuradio/blocks/tag_log_source.h>
+#include <gnuradio/blocks/tag_log.h>
+#include <gnuradio/thread/thread.h>
+#include <cstdio>
+
+namespace gr {
+  namespace blocks {
+
+    class tag_log_source_impl : public tag_log_source
+    {
+    private:
+      size_t d_itemsize;
+      bool d_repeat;
+      FILE *d_fp;
+      uint64_t d_nitems;
+      uint64_t d_pos;               // next item to play
+      bool d_seeked;                // d_fp is not at d_pos
+      tag_log_reader *d_log;
+      std::vector<tag_t> d_tags;
+      gr::thread::mutex d_mutex;
+
+      void add_tags(uint64_t nitems, uint64_t abs_offset);
+
+    public:
+      tag_log_source_impl(size_t itemsize, const char *filename,
+			  bool repeat);
+      ~tag_log_source_impl();
+
+      bool seek(long seek_point, int whence);
+      uint64_t file_items() const { return d_nitems; }
+      uint64_t position() const { return d_pos; }
+      uint64_t num_tags() const { return d_log->ntags(); }
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_TAG_LOG_SOURCE_IMPL_H */
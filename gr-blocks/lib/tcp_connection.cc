@@ -25,60 +25,200 @@
 #endif
 
 #include "tcp_connection.h"
-#include <gnuradio/basic_block.h>
+#include "socket_pdu_impl.h"
 #include <gnuradio/blocks/pdu.h>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace gr {
   namespace blocks {
 
-    tcp_connection::sptr tcp_connection::make(boost::asio::io_service& io_service)
+    // PDUs per write: two buffers each, within the 64 buffers asio
+    // hands to one sendmsg
+    static const size_t MAX_BATCH = 32;
+
+    // How long reading waits for the subscribers to catch up
+    static const long BACKLOG_WAIT_US = 1000;
+
+    tcp_connection::sptr tcp_connection::make(boost::asio::io_service& io_service, int MTU,
+					      bool framed, size_t max_queued)
     {
-      return sptr(new tcp_connection(io_service));
+      return sptr(new tcp_connection(io_service, MTU, framed, max_queued));
     }
 
-    tcp_connection::tcp_connection(boost::asio::io_service& io_service)
-      : d_socket(io_service)
+    tcp_connection::tcp_connection(boost::asio::io_service& io_service, int MTU,
+				   bool framed, size_t max_queued)
+      : d_socket(io_service),
+	d_strand(io_service),
+	d_timer(io_service),
+	d_owner(0),
+	d_mtu(MTU),
+	d_framed(framed),
+	d_max_queued(std::max(max_queued, (size_t)1)),
+	d_nbuf(0),
+	d_writing(false),
+	d_closed(false),
+	d_dropped(0)
     {
+      // room for many frames per read
+      d_buf.resize(framed ? std::max(d_mtu + 4, (size_t)65536) : d_mtu);
     }
 
     void
     tcp_connection::send(pmt::pmt_t vector)
     {
-      size_t len = pmt::length(vector);
-      size_t offset(0);
-      boost::array<char, 10000> txbuf;
-      memcpy(&txbuf[0], pmt::uniform_vector_elements(vector, offset), len);
-      boost::asio::async_write(d_socket, boost::asio::buffer(txbuf, len),
-			       boost::bind(&tcp_connection::handle_write, this,
-					   boost::asio::placeholders::error,
-					   boost::asio::placeholders::bytes_transferred));
+      pdu_buffer b;
+      b.vector = vector;
+      b.data = pmt::uniform_vector_elements(vector, b.len);
+      b.header[0] = b.len >> 24;
+      b.header[1] = b.len >> 16;
+      b.header[2] = b.len >> 8;
+      b.header[3] = b.len;
+
+      uint64_t dropped = 0;
+      {
+	gr::thread::scoped_lock guard(d_mutex);
+	if(d_closed)
+	  return;
+	if(d_queue.size() >= d_max_queued) {
+	  // the peer isn't keeping up; drop rather than hold up the others
+	  d_queue.pop_front();
+	  dropped = ++d_dropped;
+	}
+	d_queue.push_back(b);
+	if(!d_writing) {
+	  d_writing = true;
+	  d_strand.post(boost::bind(&tcp_connection::start_write, shared_from_this()));
+	}
+      }
+
+      if(dropped && (dropped & (dropped - 1)) == 0)
+	GR_LOG_WARN(d_owner->d_logger, boost::format("%s: %d PDUs dropped, peer not reading")
+		    % d_remote % dropped);
     }
 
     void
-    tcp_connection::start(gr::basic_block *block)
+    tcp_connection::start_write()
     {
-      d_block = block;
-      d_socket.async_read_some(boost::asio::buffer(d_buf),
-			       boost::bind(&tcp_connection::handle_read, this, 
-					   boost::asio::placeholders::error,
-					   boost::asio::placeholders::bytes_transferred));
+      {
+	gr::thread::scoped_lock guard(d_mutex);
+	size_t n = std::min(d_queue.size(), MAX_BATCH);
+	if(n == 0 || d_closed) {
+	  d_writing = false;
+	  return;
+	}
+	d_sending.assign(d_queue.begin(), d_queue.begin() + n);
+	d_queue.erase(d_queue.begin(), d_queue.begin() + n);
+      }
+
+      d_buffers.clear();
+      for(size_t i = 0; i < d_sending.size(); i++) {
+	if(d_framed)
+	  d_buffers.push_back(boost::asio::buffer(d_sending[i].header, 4));
+	d_buffers.push_back(boost::asio::buffer(d_sending[i].data, d_sending[i].len));
+      }
+
+      boost::asio::async_write(d_socket, d_buffers,
+			       d_strand.wrap(boost::bind(&tcp_connection::handle_write, shared_from_this(),
+							 boost::asio::placeholders::error,
+							 boost::asio::placeholders::bytes_transferred)));
+    }
+
+    void
+    tcp_connection::handle_write(const boost::system::error_code& error, size_t bytes_transferred)
+    {
+      d_sending.clear();
+      if(error) {
+	close();
+	return;
+      }
+      start_write();
+    }
+
+    void
+    tcp_connection::start(socket_pdu_impl *owner)
+    {
+      boost::system::error_code ignored;
+      d_owner = owner;
+      d_remote = boost::lexical_cast<std::string>(d_socket.remote_endpoint(ignored));
+      d_socket.set_option(boost::asio::ip::tcp::no_delay(true), ignored);
+      d_strand.dispatch(boost::bind(&tcp_connection::start_read, shared_from_this()));
+    }
+
+    void
+    tcp_connection::start_read()
+    {
+      if(d_owner->backlogged()) {
+	// Leave the data in the socket, so that TCP slows the sender
+	d_timer.expires_from_now(boost::posix_time::microseconds(BACKLOG_WAIT_US));
+	d_timer.async_wait(d_strand.wrap(boost::bind(&tcp_connection::start_read, shared_from_this())));
+	return;
+      }
+
+      d_socket.async_read_some(boost::asio::buffer(&d_buf[d_nbuf], d_buf.size() - d_nbuf),
+			       d_strand.wrap(boost::bind(&tcp_connection::handle_read, shared_from_this(),
+							 boost::asio::placeholders::error,
+							 boost::asio::placeholders::bytes_transferred)));
     }
 
     void
     tcp_connection::handle_read(const boost::system::error_code& error, size_t bytes_transferred)
     {
-      if (!error) {
-        pmt::pmt_t vector = pmt::init_u8vector(bytes_transferred, (const uint8_t*)&d_buf[0]);
-        pmt::pmt_t pdu = pmt::cons( pmt::PMT_NIL, vector);
+      if(error) {
+	close();
+	return;
+      }
 
-        d_block->message_port_pub(PDU_PORT_ID, pdu);
+      if(!d_framed) {
+	pmt::pmt_t vector = pmt::init_u8vector(bytes_transferred, &d_buf[0]);
+	d_owner->message_port_pub(PDU_PORT_ID, pmt::cons(pmt::PMT_NIL, vector));
+	start_read();
+	return;
+      }
+
+      d_nbuf += bytes_transferred;
+      size_t pos = 0;
+      while(d_nbuf - pos >= 4) {
+	const uint8_t *h = &d_buf[pos];
+	size_t len = ((size_t)h[0] << 24) | (h[1] << 16) | (h[2] << 8) | h[3];
+	if(len > d_mtu) {
+	  GR_LOG_WARN(d_owner->d_logger, boost::format("%s: closing, frame of %d bytes, MTU is %d")
+		      % d_remote % len % d_mtu);
+	  close();
+	  return;
+	}
+	if(d_nbuf - pos - 4 < len)
+	  break;
+
+	pmt::pmt_t vector = pmt::init_u8vector(len, &d_buf[pos + 4]);
+	d_owner->message_port_pub(PDU_PORT_ID, pmt::cons(pmt::PMT_NIL, vector));
+	pos += 4 + len;
+      }
 
-        d_socket.async_read_some(boost::asio::buffer(d_buf),
-				 boost::bind(&tcp_connection::handle_read, this,
-					     boost::asio::placeholders::error,
-					     boost::asio::placeholders::bytes_transferred));
+      // keep the start of the next frame
+      memmove(&d_buf[0], &d_buf[pos], d_nbuf - pos);
+      d_nbuf -= pos;
+      start_read();
+    }
 
+    void
+    tcp_connection::close()
+    {
+      {
+	gr::thread::scoped_lock guard(d_mutex);
+	if(d_closed)
+	  return;
+	d_closed = true;
+	d_queue.clear();
       }
+
+      boost::system::error_code ignored;
+      d_timer.cancel(ignored);
+      d_socket.close(ignored);
+      d_owner->remove_connection(shared_from_this());
     }
 
   } /* namespace blocks */
@@ -23,37 +23,86 @@
 #ifndef INCLUDED_TCP_CONNECTION_H
 #define INCLUDED_TCP_CONNECTION_H
 
-#include <boost/array.hpp>
+#include <gnuradio/thread/thread.h>
 #include <boost/asio.hpp>
+#include <boost/enable_shared_from_this.hpp>
 #include <pmt/pmt.h>
+#include <deque>
 
 namespace gr {
-  
-  class basic_block;
-
   namespace blocks {
 
-    class tcp_connection
+    class socket_pdu_impl;
+
+    /*!
+     * One TCP stream of a socket_pdu.  PDUs to send are queued and
+     * written a batch at a time in one gathered write, from a strand
+     * of the block's io_service.  With framing, each PDU goes out
+     * after its length as a 32-bit big endian number, and incoming
+     * frames are cut out of reads as large as the buffer allows;
+     * without, each read is a PDU.
+     */
+    class tcp_connection : public boost::enable_shared_from_this<tcp_connection>
     {
     private:
+      struct pdu_buffer {
+	pmt::pmt_t vector;		// keeps data alive
+	const void *data;
+	size_t len;
+	uint8_t header[4];		// len, big endian
+      };
+
       boost::asio::ip::tcp::socket d_socket;
-      boost::array<char, 10000> d_buf;
-      std::string d_message;
-      basic_block *d_block;
+      boost::asio::io_service::strand d_strand;
+      boost::asio::deadline_timer d_timer;
+      socket_pdu_impl *d_owner;
+      std::string d_remote;		// peer address, for messages
+      size_t d_mtu;
+      bool d_framed;
+      size_t d_max_queued;
+
+      std::vector<uint8_t> d_buf;	// received bytes
+      size_t d_nbuf;			// bytes held in d_buf
+
+      gr::thread::mutex d_mutex;	// guards the queue
+      std::deque<pdu_buffer> d_queue;	// PDUs waiting to be written
+      bool d_writing;
+      bool d_closed;
+      uint64_t d_dropped;		// PDUs dropped from a full queue
+
+      // only touched from the strand
+      std::vector<pdu_buffer> d_sending;
+      std::vector<boost::asio::const_buffer> d_buffers;
+
+      tcp_connection(boost::asio::io_service& io_service, int MTU,
+		     bool framed, size_t max_queued);
+
+      void start_read();
+      void handle_read(const boost::system::error_code& error, size_t bytes_transferred);
+      void start_write();
+      void handle_write(const boost::system::error_code& error, size_t bytes_transferred);
+      void close();
 
-      tcp_connection(boost::asio::io_service& io_service);
-      
     public:
       typedef boost::shared_ptr<tcp_connection> sptr;
-      
-      static sptr make(boost::asio::io_service& io_service);
+
+      /*!
+       * \param io_service  service to run the socket on
+       * \param MTU         size of the largest PDU received
+       * \param framed      prefix each PDU with its length
+       * \param max_queued  PDUs to queue for writing before dropping
+       *                    the oldest
+       */
+      static sptr make(boost::asio::io_service& io_service, int MTU=10000,
+		       bool framed=false, size_t max_queued=100);
 
       boost::asio::ip::tcp::socket& socket() { return d_socket; };
 
-      void start(gr::basic_block *block);
+      //! Start reading, passing the PDUs to \p owner
+      void start(socket_pdu_impl *owner);
+
+      //! Queue the data of a uniform vector for writing; thread safe
       void send(pmt::pmt_t vector);
-      void handle_read(const boost::system::error_code& error, size_t bytes_transferred);
-      void handle_write(const boost::system::error_code& error, size_t bytes_transferred) { }
     };
 
   } /* namespace blocks */
@@ -0,0 +1,150 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "udp_mmsg.h"
+#include <boost/format.hpp>
+#include <stdexcept>
+#include <errno.h>
+#include <string.h>
+
+#ifdef HAVE_SYS_SOCKET_H
+#include <netdb.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace gr {
+  namespace blocks {
+
+#ifdef HAVE_SYS_SOCKET_H
+
+    static void
+    set_buffer_size(int fd, bool receive, int size, int &granted)
+    {
+      // The FORCE options pass the system limit for privileged processes
+#if defined(SO_RCVBUFFORCE) && defined(SO_SNDBUFFORCE)
+      if(setsockopt(fd, SOL_SOCKET, receive ? SO_RCVBUFFORCE : SO_SNDBUFFORCE,
+		    &size, sizeof(size)) != 0)
+#endif
+	setsockopt(fd, SOL_SOCKET, receive ? SO_RCVBUF : SO_SNDBUF,
+		   &size, sizeof(size));
+
+      socklen_t len = sizeof(granted);
+      if(getsockopt(fd, SOL_SOCKET, receive ? SO_RCVBUF : SO_SNDBUF,
+		    &granted, &len) != 0)
+	granted = 0;
+    }
+
+    int
+    udp_mmsg_open(const std::string &host, int port, bool receive,
+		  int buffer_size, int &granted)
+    {
+      struct addrinfo hints, *res;
+      memset(&hints, 0, sizeof(hints));
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_DGRAM;
+      hints.ai_flags = receive ? AI_PASSIVE : 0;
+
+      std::string s_port = (boost::format("%d")%port).str();
+      const char *node = (host.empty() || (receive && host == "0.0.0.0")) ? NULL : host.c_str();
+      int r = getaddrinfo(node, s_port.c_str(), &hints, &res);
+      if(r != 0)
+	throw std::runtime_error(std::string("udp: can't resolve ") + host + ": " + gai_strerror(r));
+
+      int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+      if(fd < 0) {
+	freeaddrinfo(res);
+	throw std::runtime_error(std::string("udp: can't open socket: ") + strerror(errno));
+      }
+
+      int one = 1;
+      setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      set_buffer_size(fd, receive, buffer_size, granted);
+
+      if(receive) {
+	// Wake the receiving thread now and then to see if it should stop
+	struct timeval tv = {0, 100000};
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	r = bind(fd, res->ai_addr, res->ai_addrlen);
+      }
+      else
+	r = connect(fd, res->ai_addr, res->ai_addrlen);
+      freeaddrinfo(res);
+
+      if(r != 0) {
+	int e = errno;
+	::close(fd);
+	throw std::runtime_error(std::string(receive ? "udp: can't bind: " : "udp: can't connect: ")
+				 + strerror(e));
+      }
+      return fd;
+    }
+
+    int
+    udp_mmsg_recv(int fd, struct mmsghdr *msgs, unsigned int n)
+    {
+#ifdef HAVE_RECVMMSG
+      return recvmmsg(fd, msgs, n, MSG_WAITFORONE, NULL);
+#else
+      unsigned int i;
+      for(i = 0; i < n; i++) {
+	ssize_t r = recvmsg(fd, &msgs[i].msg_hdr, i == 0 ? 0 : MSG_DONTWAIT);
+	if(r < 0)
+	  break;
+	msgs[i].msg_len = r;
+      }
+      return i > 0 ? (int)i : -1;
+#endif
+    }
+
+    int
+    udp_mmsg_send(int fd, struct mmsghdr *msgs, unsigned int n)
+    {
+#ifdef HAVE_RECVMMSG
+      return sendmmsg(fd, msgs, n, 0);
+#else
+      unsigned int i;
+      for(i = 0; i < n; i++) {
+	ssize_t r = sendmsg(fd, &msgs[i].msg_hdr, 0);
+	if(r < 0)
+	  break;
+	msgs[i].msg_len = r;
+      }
+      return i > 0 ? (int)i : -1;
+#endif
+    }
+
+    void
+    udp_mmsg_close(int fd)
+    {
+      ::close(fd);
+    }
+
+#endif /* HAVE_SYS_SOCKET_H */
+
+  } /* namespace blocks */
+} /* namespace gr */
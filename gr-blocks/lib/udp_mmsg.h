@@ -0,0 +1,83 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_UDP_MMSG_H
+#define INCLUDED_UDP_MMSG_H
+
+#include <string>
+
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+namespace gr {
+  namespace blocks {
+
+#ifdef HAVE_SYS_SOCKET_H
+#ifndef HAVE_RECVMMSG
+    // As in Linux, for the fallbacks
+    struct mmsghdr {
+      struct msghdr msg_hdr;
+      unsigned int msg_len;
+    };
+#endif
+
+    /*!
+     * \brief Opens a UDP socket for udp_mmsg_source or udp_mmsg_sink.
+     *
+     * Binds the socket to \p host and \p port when \p receive,
+     * otherwise connects it to them, and asks for a socket buffer of
+     * \p buffer_size bytes, past the system limit where the process
+     * is allowed to.  \p granted receives the size the system gave.
+     * Throws on failure.
+     */
+    int udp_mmsg_open(const std::string &host, int port, bool receive,
+		      int buffer_size, int &granted);
+
+    /*!
+     * \brief Receives up to \p n packets.
+     *
+     * Waits for the first packet, up to the socket's receive timeout,
+     * then takes the ones already queued.  Returns the number of
+     * packets, with their lengths in msg_len, or -1 with errno set.
+     */
+    int udp_mmsg_recv(int fd, struct mmsghdr *msgs, unsigned int n);
+
+    /*!
+     * \brief Sends up to \p n packets.
+     *
+     * Returns the number of packets sent, which is less than \p n
+     * when the system refuses one, or -1 with errno set when it
+     * refuses the first.
+     */
+    int udp_mmsg_send(int fd, struct mmsghdr *msgs, unsigned int n);
+
+    void udp_mmsg_close(int fd);
+#endif /* HAVE_SYS_SOCKET_H */
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_UDP_MMSG_H */
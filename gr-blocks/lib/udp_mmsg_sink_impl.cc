@@ -0,0 +1,208 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "udp_mmsg_sink_impl.h"
+#include <gnuradio/io_signature.h>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <errno.h>
+#include <string.h>
+
+namespace gr {
+  namespace blocks {
+
+    // Most packets given per send call
+    static const unsigned int BATCH = 64;
+
+    udp_mmsg_sink::sptr
+    udp_mmsg_sink::make(size_t itemsize,
+			const std::string &host, int port,
+			int payload_size, bool seq_header,
+			int buffer_size)
+    {
+      return gnuradio::get_initial_sptr
+	(new udp_mmsg_sink_impl(itemsize, host, port, payload_size,
+				seq_header, buffer_size));
+    }
+
+    udp_mmsg_sink_impl::udp_mmsg_sink_impl(size_t itemsize,
+					   const std::string &host, int port,
+					   int payload_size, bool seq_header,
+					   int buffer_size)
+      : sync_block("udp_mmsg_sink",
+		   io_signature::make(1, 1, itemsize),
+		   io_signature::make(0, 0, 0)),
+	d_itemsize(itemsize), d_seq_header(seq_header), d_fd(-1), d_seq(0),
+	d_packets(0), d_send_errors(0), d_rate(0),
+	d_rate_t0(gr::high_res_timer_now()), d_rate_packets0(0)
+    {
+      d_items_per_packet = (payload_size - (seq_header ? 4 : 0)) / (int)itemsize;
+      if(d_items_per_packet < 1)
+	throw std::invalid_argument("udp_mmsg_sink: payload_size is less than an item");
+      set_output_multiple(d_items_per_packet);
+
+#ifdef HAVE_SYS_SOCKET_H
+      int granted;
+      d_fd = udp_mmsg_open(host, port, false, buffer_size, granted);
+      if(granted < buffer_size)
+	GR_LOG_WARN(d_logger, boost::format("socket send buffer is %d bytes, %d asked for")
+		    % granted % buffer_size);
+
+      d_headers.resize(4 * BATCH);
+      d_iovs.resize(2 * BATCH);
+      d_msgs.resize(BATCH);
+      memset(&d_msgs[0], 0, BATCH * sizeof(d_msgs[0]));
+      for(unsigned int i = 0; i < BATCH; i++) {
+	d_iovs[2*i].iov_base = &d_headers[4*i];
+	d_iovs[2*i].iov_len = 4;
+	d_iovs[2*i+1].iov_len = d_items_per_packet * d_itemsize;
+	d_msgs[i].msg_hdr.msg_iov = &d_iovs[seq_header ? 2*i : 2*i+1];
+	d_msgs[i].msg_hdr.msg_iovlen = seq_header ? 2 : 1;
+      }
+#else
+      throw std::runtime_error("udp_mmsg_sink: sockets are not supported on this platform");
+#endif
+    }
+
+    udp_mmsg_sink_impl::~udp_mmsg_sink_impl()
+    {
+#ifdef HAVE_SYS_SOCKET_H
+      if(d_fd >= 0)
+	udp_mmsg_close(d_fd);
+#endif
+    }
+
+    uint64_t
+    udp_mmsg_sink_impl::packets() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_packets;
+    }
+
+    uint64_t
+    udp_mmsg_sink_impl::send_errors() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_send_errors;
+    }
+
+    double
+    udp_mmsg_sink_impl::packet_rate() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_rate;
+    }
+
+    int
+    udp_mmsg_sink_impl::work(int noutput_items,
+			     gr_vector_const_void_star &input_items,
+			     gr_vector_void_star &output_items)
+    {
+      const char *in = (const char*)input_items[0];
+      int npackets = noutput_items / d_items_per_packet;
+      size_t packet_bytes = d_items_per_packet * d_itemsize;
+      uint64_t sent = 0, refused = 0;
+
+#ifdef HAVE_SYS_SOCKET_H
+      for(int p = 0; p < npackets; ) {
+	unsigned int n = std::min<unsigned int>(npackets - p, BATCH);
+	for(unsigned int i = 0; i < n; i++) {
+	  unsigned char *h = &d_headers[4*i];
+	  h[0] = d_seq >> 24;
+	  h[1] = d_seq >> 16;
+	  h[2] = d_seq >> 8;
+	  h[3] = d_seq;
+	  d_seq++;
+	  d_iovs[2*i+1].iov_base = (void*)(in + (p + i) * packet_bytes);
+	}
+
+	for(unsigned int i = 0; i < n; ) {
+	  int r = udp_mmsg_send(d_fd, &d_msgs[i], n - i);
+	  if(r < 0) {
+	    if(errno == EINTR)
+	      continue;
+	    if(errno != ECONNREFUSED && errno != ENOBUFS && errno != EHOSTUNREACH &&
+	       errno != ENETUNREACH && errno != EAGAIN && errno != EWOULDBLOCK) {
+	      GR_LOG_ERROR(d_logger, boost::format("send error: %s") % strerror(errno));
+	      return -1;
+	    }
+	    // Nobody listening or no room: drop the packet
+	    r = 0;
+	    refused++;
+	    i++;
+	  }
+	  sent += r;
+	  i += r;
+	}
+	p += n;
+      }
+#endif /* HAVE_SYS_SOCKET_H */
+
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      d_packets += sent;
+      d_send_errors += refused;
+
+      gr::high_res_timer_type t = gr::high_res_timer_now();
+      if(t - d_rate_t0 >= gr::high_res_timer_tps()) {
+	d_rate = (d_packets - d_rate_packets0) * (double)gr::high_res_timer_tps() / (t - d_rate_t0);
+	d_rate_t0 = t;
+	d_rate_packets0 = d_packets;
+      }
+
+      return npackets * d_items_per_packet;
+    }
+
+    void
+    udp_mmsg_sink_impl::setup_rpc()
+    {
+#ifdef GR_CTRLPORT
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_sink, double>(
+	  alias(), "packet_rate", &udp_mmsg_sink::packet_rate,
+	  pmt::mp(0.0), pmt::mp(10.0e6), pmt::mp(0.0),
+	  "packets/s", "Packets sent per second", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_sink, uint64_t>(
+	  alias(), "packets", &udp_mmsg_sink::packets,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "packets", "Packets sent", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_sink, uint64_t>(
+	  alias(), "send_errors", &udp_mmsg_sink::send_errors,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "packets", "Packets the system refused to send", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+#endif /* GR_CTRLPORT */
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
@@ -0,0 +1,79 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_UDP_MMSG_SINK_IMPL_H
+#define INCLUDED_BLOCKS_UDP_MMSG_SINK_IMPL_H
+
+#include <gnuradio/blocks/udp_mmsg_sink.h>
+#include <gnuradio/high_res_timer.h>
+#include <gnuradio/thread/thread.h>
+#include "udp_mmsg.h"
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    class udp_mmsg_sink_impl : public udp_mmsg_sink
+    {
+    private:
+      size_t d_itemsize;
+      bool d_seq_header;
+      int d_items_per_packet;
+      int d_fd;
+      uint32_t d_seq;
+#ifdef HAVE_SYS_SOCKET_H
+      std::vector<struct mmsghdr> d_msgs;
+      std::vector<struct iovec> d_iovs;   // header and payload of each packet
+#endif
+      std::vector<unsigned char> d_headers;
+
+      mutable gr::thread::mutex d_stats_mutex;
+      uint64_t d_packets;
+      uint64_t d_send_errors;
+      double d_rate;
+      gr::high_res_timer_type d_rate_t0;
+      uint64_t d_rate_packets0;
+
+    public:
+      udp_mmsg_sink_impl(size_t itemsize,
+			 const std::string &host, int port,
+			 int payload_size, bool seq_header,
+			 int buffer_size);
+      ~udp_mmsg_sink_impl();
+
+      void setup_rpc();
+
+      int items_per_packet() const { return d_items_per_packet; }
+      uint64_t packets() const;
+      uint64_t send_errors() const;
+      double packet_rate() const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_UDP_MMSG_SINK_IMPL_H */
@@ -0,0 +1,352 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "udp_mmsg_source_impl.h"
+#include <gnuradio/io_signature.h>
+#include <gnuradio/high_res_timer.h>
+#include <boost/bind.hpp>
+#include <boost/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <errno.h>
+#include <string.h>
+
+#ifdef HAVE_SYS_SOCKET_H
+#include <netinet/in.h>
+#endif
+
+namespace gr {
+  namespace blocks {
+
+    // Most packets taken per receive call
+    static const unsigned int BATCH = 64;
+
+    udp_mmsg_source::sptr
+    udp_mmsg_source::make(size_t itemsize,
+			  const std::string &host, int port,
+			  int payload_size, int header_size,
+			  int seq_offset, int seq_shift, int seq_bits,
+			  int buffer_size, int nslots)
+    {
+      return gnuradio::get_initial_sptr
+	(new udp_mmsg_source_impl(itemsize, host, port, payload_size,
+				  header_size, seq_offset, seq_shift,
+				  seq_bits, buffer_size, nslots));
+    }
+
+    udp_mmsg_source_impl::udp_mmsg_source_impl(size_t itemsize,
+					       const std::string &host, int port,
+					       int payload_size, int header_size,
+					       int seq_offset, int seq_shift,
+					       int seq_bits, int buffer_size,
+					       int nslots)
+      : sync_block("udp_mmsg_source",
+		   io_signature::make(0, 0, 0),
+		   io_signature::make(1, 1, itemsize)),
+	d_itemsize(itemsize), d_payload_size(payload_size),
+	d_header_size(header_size), d_seq_offset(seq_offset),
+	d_seq_shift(seq_shift), d_fd(-1), d_buffer_size(0),
+	d_ring(std::max(nslots, 1), std::max(payload_size, 1)),
+	d_stop(true), d_have_seq(false), d_next_seq(0), d_lost(0),
+	d_packets(0), d_lost_packets(0), d_overflows(0), d_rate(0),
+	d_offset(0), d_lost_carry(0), d_waiting(false),
+	d_lost_key(pmt::intern("packets_lost"))
+    {
+      if(payload_size <= 0 || header_size < 0 || header_size >= payload_size)
+	throw std::invalid_argument("udp_mmsg_source: header_size must be less than payload_size");
+      if(seq_offset >= 0 && (seq_offset + 4 > payload_size || seq_bits < 1 ||
+			     seq_bits > 32 || seq_shift < 0 || seq_shift + seq_bits > 32))
+	throw std::invalid_argument("udp_mmsg_source: sequence number out of the packet");
+      d_seq_mask = seq_bits >= 32 ? 0xffffffff : ((uint32_t)1 << seq_bits) - 1;
+
+#ifdef HAVE_SYS_SOCKET_H
+      d_fd = udp_mmsg_open(host, port, true, buffer_size, d_buffer_size);
+      if(d_buffer_size < buffer_size)
+	GR_LOG_WARN(d_logger, boost::format("socket receive buffer is %d bytes, %d asked for")
+		    % d_buffer_size % buffer_size);
+
+      d_scratch.resize(BATCH * d_payload_size);
+      d_iovs.resize(BATCH);
+      d_msgs.resize(BATCH);
+      memset(&d_msgs[0], 0, BATCH * sizeof(d_msgs[0]));
+      for(unsigned int i = 0; i < BATCH; i++) {
+	d_iovs[i].iov_len = d_payload_size;
+	d_msgs[i].msg_hdr.msg_iov = &d_iovs[i];
+	d_msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+#else
+      throw std::runtime_error("udp_mmsg_source: sockets are not supported on this platform");
+#endif
+    }
+
+    udp_mmsg_source_impl::~udp_mmsg_source_impl()
+    {
+      stop();
+#ifdef HAVE_SYS_SOCKET_H
+      if(d_fd >= 0)
+	udp_mmsg_close(d_fd);
+#endif
+    }
+
+    int
+    udp_mmsg_source_impl::get_port()
+    {
+#ifdef HAVE_SYS_SOCKET_H
+      struct sockaddr_storage addr;
+      socklen_t len = sizeof(addr);
+      if(getsockname(d_fd, (struct sockaddr*)&addr, &len) == 0) {
+	if(addr.ss_family == AF_INET)
+	  return ntohs(((struct sockaddr_in*)&addr)->sin_port);
+	if(addr.ss_family == AF_INET6)
+	  return ntohs(((struct sockaddr_in6*)&addr)->sin6_port);
+      }
+#endif
+      return -1;
+    }
+
+    uint64_t
+    udp_mmsg_source_impl::packets() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_packets;
+    }
+
+    uint64_t
+    udp_mmsg_source_impl::lost_packets() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_lost_packets;
+    }
+
+    uint64_t
+    udp_mmsg_source_impl::overflows() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_overflows;
+    }
+
+    double
+    udp_mmsg_source_impl::packet_rate() const
+    {
+      gr::thread::scoped_lock lock(d_stats_mutex);
+      return d_rate;
+    }
+
+    bool
+    udp_mmsg_source_impl::start()
+    {
+      if(d_stop.load()) {
+	d_stop.store(false);
+	d_rx_thread = gr::thread::thread(boost::bind(&udp_mmsg_source_impl::receive, this));
+      }
+      return true;
+    }
+
+    bool
+    udp_mmsg_source_impl::stop()
+    {
+      d_stop.store(true);
+      if(d_rx_thread.joinable())
+	d_rx_thread.join();
+      return true;
+    }
+
+    uint32_t
+    udp_mmsg_source_impl::check_sequence(const char *packet, size_t length)
+    {
+      if(d_seq_offset < 0 || length < (size_t)d_seq_offset + 4)
+	return 0;
+
+      const unsigned char *p = (const unsigned char*)packet + d_seq_offset;
+      uint32_t word = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+	((uint32_t)p[2] << 8) | p[3];
+      uint32_t seq = (word >> d_seq_shift) & d_seq_mask;
+
+      uint32_t lost = 0;
+      if(d_have_seq) {
+	lost = (seq - d_next_seq) & d_seq_mask;
+	if(lost > d_seq_mask / 2)
+	  return 0;		// late, keep waiting for the one after the last
+      }
+      d_have_seq = true;
+      d_next_seq = (seq + 1) & d_seq_mask;
+      return lost;
+    }
+
+    void
+    udp_mmsg_source_impl::receive()
+    {
+#ifdef HAVE_SYS_SOCKET_H
+      gr::high_res_timer_type t0 = gr::high_res_timer_now();
+      uint64_t packets0 = packets();
+
+      while(!d_stop.load()) {
+	// Straight into the ring when it has room, into the scratch
+	// slots otherwise, to keep the socket drained
+	unsigned int n = std::min<size_t>(d_ring.writable(), BATCH);
+	bool overflow = (n == 0);
+	if(overflow)
+	  n = BATCH;
+	for(unsigned int i = 0; i < n; i++)
+	  d_iovs[i].iov_base = overflow ? &d_scratch[i * d_payload_size] : d_ring.write_slot(i);
+
+	int r = udp_mmsg_recv(d_fd, &d_msgs[0], n);
+	if(r < 0) {
+	  if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+	    GR_LOG_ERROR(d_logger, boost::format("receive error: %s") % strerror(errno));
+	    break;
+	  }
+	  r = 0;
+	}
+
+	uint64_t lost = 0;
+	for(int i = 0; i < r; i++) {
+	  uint32_t gap = check_sequence((const char*)d_iovs[i].iov_base, d_msgs[i].msg_len);
+	  lost += gap;
+	  if(overflow)
+	    d_lost += gap + 1;
+	  else {
+	    packet_ring::packet &p = d_ring.write_packet(i);
+	    p.length = d_msgs[i].msg_len;
+	    p.lost = d_lost + gap;
+	    d_lost = 0;
+	  }
+	}
+
+	if(!overflow && r > 0) {
+	  d_ring.commit(r);
+	  boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	  if(d_waiting.load()) {
+	    gr::thread::scoped_lock lock(d_wait_mutex);
+	    d_cond.notify_one();
+	  }
+	}
+
+	gr::thread::scoped_lock lock(d_stats_mutex);
+	d_packets += r;
+	d_lost_packets += lost;
+	if(overflow)
+	  d_overflows += r;
+
+	gr::high_res_timer_type t = gr::high_res_timer_now();
+	if(t - t0 >= gr::high_res_timer_tps()) {
+	  d_rate = (d_packets - packets0) * (double)gr::high_res_timer_tps() / (t - t0);
+	  t0 = t;
+	  packets0 = d_packets;
+	}
+      }
+#endif /* HAVE_SYS_SOCKET_H */
+    }
+
+    int
+    udp_mmsg_source_impl::work(int noutput_items,
+			       gr_vector_const_void_star &input_items,
+			       gr_vector_void_star &output_items)
+    {
+      char *out = (char*)output_items[0];
+      int produced = 0;
+
+      if(d_ring.readable() == 0) {
+	// Wait a little, so that the scheduler does not spin
+	gr::thread::scoped_lock lock(d_wait_mutex);
+	d_waiting.store(true);
+	boost::atomic_thread_fence(boost::memory_order_seq_cst);
+	if(d_ring.readable() == 0)
+	  d_cond.timed_wait(lock, boost::posix_time::milliseconds(10));
+	d_waiting.store(false);
+      }
+
+      size_t n;
+      while(produced < noutput_items && (n = d_ring.readable()) > 0) {
+	size_t done = 0;
+	for(; done < n && produced < noutput_items; done++) {
+	  const packet_ring::packet &p = d_ring.read_packet(done);
+	  size_t nbytes = p.length > (uint32_t)d_header_size ?
+	    (p.length - d_header_size) / d_itemsize * d_itemsize : 0;
+
+	  if(d_offset == 0 && (p.lost > 0 || d_lost_carry > 0)) {
+	    if(nbytes == 0)
+	      d_lost_carry += p.lost;	// tag the next packet with items
+	    else {
+	      add_item_tag(0, nitems_written(0) + produced, d_lost_key,
+			   pmt::from_uint64(p.lost + d_lost_carry), alias_pmt());
+	      d_lost_carry = 0;
+	    }
+	  }
+
+	  size_t k = std::min<size_t>(noutput_items - produced,
+				      (nbytes - d_offset) / d_itemsize);
+	  memcpy(out + produced * d_itemsize,
+		 d_ring.read_slot(done) + d_header_size + d_offset, k * d_itemsize);
+	  produced += k;
+	  d_offset += k * d_itemsize;
+	  if(d_offset < nbytes)
+	    break;
+	  d_offset = 0;
+	}
+	d_ring.release(done);
+      }
+
+      return produced;
+    }
+
+    void
+    udp_mmsg_source_impl::setup_rpc()
+    {
+#ifdef GR_CTRLPORT
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_source, double>(
+	  alias(), "packet_rate", &udp_mmsg_source::packet_rate,
+	  pmt::mp(0.0), pmt::mp(10.0e6), pmt::mp(0.0),
+	  "packets/s", "Packets received per second", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_source, uint64_t>(
+	  alias(), "packets", &udp_mmsg_source::packets,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "packets", "Packets received", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_source, uint64_t>(
+	  alias(), "lost_packets", &udp_mmsg_source::lost_packets,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "packets", "Packets lost, from the sequence numbers", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+
+      d_rpc_vars.push_back(
+	rpcbasic_sptr(new rpcbasic_register_get<udp_mmsg_source, uint64_t>(
+	  alias(), "overflows", &udp_mmsg_source::overflows,
+	  pmt::from_uint64(0), pmt::from_uint64(~(uint64_t)0), pmt::from_uint64(0),
+	  "packets", "Packets dropped with the ring full", RPC_PRIVLVL_MIN,
+	  DISPTIME | DISPOPTSTRIP)));
+#endif /* GR_CTRLPORT */
+    }
+
+  } /* namespace blocks */
+} /* namespace gr */
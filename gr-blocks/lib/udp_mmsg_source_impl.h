@@ -0,0 +1,108 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_BLOCKS_UDP_MMSG_SOURCE_IMPL_H
+#define INCLUDED_BLOCKS_UDP_MMSG_SOURCE_IMPL_H
+
+#include <gnuradio/blocks/udp_mmsg_source.h>
+#include <gnuradio/thread/thread.h>
+#include <boost/atomic.hpp>
+#include "packet_ring.h"
+#include "udp_mmsg.h"
+#include <vector>
+
+namespace gr {
+  namespace blocks {
+
+    class udp_mmsg_source_impl : public udp_mmsg_source
+    {
+    private:
+      size_t d_itemsize;
+      int d_payload_size;
+      int d_header_size;
+      int d_seq_offset;
+      int d_seq_shift;
+      uint32_t d_seq_mask;
+      int d_fd;
+      int d_buffer_size;
+      packet_ring d_ring;
+
+      // Receiving thread
+      gr::thread::thread d_rx_thread;
+      boost::atomic<bool> d_stop;
+#ifdef HAVE_SYS_SOCKET_H
+      std::vector<struct mmsghdr> d_msgs;
+      std::vector<struct iovec> d_iovs;
+#endif
+      std::vector<char> d_scratch;  // receives packets while the ring is full
+      bool d_have_seq;
+      uint32_t d_next_seq;
+      uint32_t d_lost;              // for the next packet in the ring
+
+      // Statistics, updated once per batch
+      mutable gr::thread::mutex d_stats_mutex;
+      uint64_t d_packets;
+      uint64_t d_lost_packets;
+      uint64_t d_overflows;
+      double d_rate;
+
+      // work()
+      size_t d_offset;              // bytes output from the first packet
+      uint64_t d_lost_carry;        // lost before packets without items
+      boost::atomic<bool> d_waiting;
+      gr::thread::mutex d_wait_mutex;
+      gr::thread::condition_variable d_cond;
+      pmt::pmt_t d_lost_key;
+
+      void receive();
+      uint32_t check_sequence(const char *packet, size_t length);
+
+    public:
+      udp_mmsg_source_impl(size_t itemsize,
+			   const std::string &host, int port,
+			   int payload_size, int header_size,
+			   int seq_offset, int seq_shift, int seq_bits,
+			   int buffer_size, int nslots);
+      ~udp_mmsg_source_impl();
+
+      void setup_rpc();
+
+      int get_port();
+      int buffer_size() const { return d_buffer_size; }
+      uint64_t packets() const;
+      uint64_t lost_packets() const;
+      uint64_t overflows() const;
+      double packet_rate() const;
+
+      bool start();
+      bool stop();
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace blocks */
+} /* namespace gr */
+
+#endif /* INCLUDED_BLOCKS_UDP_MMSG_SOURCE_IMPL_H */
@@ -202,5 +202,49 @@ class test_file_metadata(gr_unittest.TestCase):
 	os.remove(outfile)
 	os.remove(outfile_hdr)
 
+    def test_003(self):
+        N = 10000
+        outfile = "test_out.dat"
+
+        samp_rate = 200000
+        data = sig_source_c(samp_rate, 1000, 1, N)
+        src  = blocks.vector_source_c(data)
+        fsnk = blocks.file_meta_sink(gr.sizeof_gr_complex, outfile,
+                                     samp_rate, 1,
+                                     blocks.GR_FILE_FLOAT, True,
+                                     1000, "", False, True)
+        fsnk.set_unbuffered(True)
+
+        self.tb.connect(src, fsnk)
+        self.tb.run()
+        fsnk.close()
+        self.assertTrue(os.path.exists(outfile + ".idx"))
+
+        # Start part way through the sixth segment, with the index and
+        # then by reading the headers
+        start = 5020
+        for use_index in (True, False):
+            if not use_index:
+                os.remove(outfile + ".idx")
+
+            tb = gr.top_block()
+            fsrc = blocks.file_meta_source(outfile, False)
+            fsrc.seek_time(0, start / float(samp_rate))
+            vsnk = blocks.vector_sink_c()
+            tb.connect(fsrc, vsnk)
+            tb.run()
+
+            self.assertComplexTuplesAlmostEqual(vsnk.data(), data[start:], 5)
+
+            tags = [t for t in vsnk.tags() if t.offset == 0 and
+                    pmt.eq(t.key, pmt.intern("rx_time"))]
+            self.assertEqual(len(tags), 1)
+            self.assertEqual(pmt.to_uint64(pmt.tuple_ref(tags[0].value, 0)), 0)
+            self.assertAlmostEqual(pmt.to_double(pmt.tuple_ref(tags[0].value, 1)),
+                                   start / float(samp_rate))
+            fsrc = None
+
+        os.remove(outfile)
+
 if __name__ == '__main__':
     gr_unittest.run(test_file_metadata, "test_file_metadata.xml")
@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import os
+import struct
+
+class test_mmap_file_source(gr_unittest.TestCase):
+
+    def setUp(self):
+        os.environ['GR_CONF_CONTROLPORT_ON'] = 'False'
+        self.tb = gr.top_block()
+        self.filename = "tmp_mmap.32f"
+        self.tagfile = "tmp_mmap.tags"
+        self.N = 10000
+        f = open(self.filename, "wb")
+        f.write(struct.pack('%df' % self.N, *range(self.N)))
+        f.close()
+
+    def tearDown(self):
+        self.tb = None
+        os.remove(self.filename)
+        if os.path.exists(self.tagfile):
+            os.remove(self.tagfile)
+
+    def test_001(self):
+        # Small windows, so that the items cross window boundaries
+        src = blocks.mmap_file_source(gr.sizeof_float, self.filename,
+                                      False, "", 4096)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, snk)
+        self.tb.run()
+
+        self.assertEqual(src.file_items(), self.N)
+        self.assertFloatTuplesAlmostEqual(range(self.N), snk.data())
+
+    def test_002(self):
+        # Repeat and seek
+        src = blocks.mmap_file_source(gr.sizeof_float, self.filename, True)
+        self.assertTrue(src.seek(self.N - 10, os.SEEK_SET))
+        self.assertFalse(src.seek(self.N + 1, os.SEEK_SET))
+        head = blocks.head(gr.sizeof_float, 2*self.N)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, head, snk)
+        self.tb.run()
+
+        expected = [(self.N - 10 + i) % self.N for i in xrange(2*self.N)]
+        self.assertFloatTuplesAlmostEqual(expected, snk.data())
+
+    def test_003(self):
+        # Tags from the sidecar file, out of order in the file, are
+        # played back at their items on every repeat
+        offsets = (5000, 0, 9999, 123)
+        f = open(self.tagfile, "wb")
+        for i, o in enumerate(offsets):
+            t = pmt.make_tuple(pmt.from_uint64(o), pmt.intern("key"),
+                               pmt.from_long(i))
+            f.write(pmt.serialize_str(t))
+        f.close()
+
+        src = blocks.mmap_file_source(gr.sizeof_float, self.filename,
+                                      True, self.tagfile)
+        head = blocks.head(gr.sizeof_float, 2*self.N)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, head, snk)
+        self.tb.run()
+
+        self.assertEqual(src.num_tags(), len(offsets))
+        tags = snk.tags()
+        self.assertEqual(len(tags), 2*len(offsets))
+        for t in tags:
+            i = pmt.to_long(t.value)
+            self.assertEqual(t.offset % self.N, offsets[i])
+            self.assertTrue(pmt.eq(t.key, pmt.intern("key")))
+
+if __name__ == '__main__':
+    gr_unittest.run(test_mmap_file_source, "test_mmap_file_source.xml")
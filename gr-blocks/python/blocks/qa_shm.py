@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import os
+import time
+
+class test_shm(gr_unittest.TestCase):
+
+    def setUp(self):
+        os.environ['GR_CONF_CONTROLPORT_ON'] = 'False'
+        self.name = 'qa_shm_%d' % os.getpid()
+        self.tb_snd = gr.top_block()
+        self.tb_rcv = gr.top_block()
+
+    def tearDown(self):
+        self.tb_rcv = None
+        self.tb_snd = None
+
+    def wait_readers(self, shm_snd, n):
+        for i in xrange(200):
+            if shm_snd.num_readers() == n:
+                break
+            time.sleep(0.01)
+        self.assertEqual(shm_snd.num_readers(), n)
+
+    def test_001(self):
+        # Sink to source, with tags, through a ring smaller than the data
+        src_data = [float(x) for x in range(100000)]
+        tags = []
+        for n in (0, 5, 999, 50000):
+            t = gr.tag_t()
+            t.offset = n
+            t.key = pmt.intern("test")
+            t.value = pmt.from_long(n)
+            t.srcid = pmt.intern("qa")
+            tags.append(t)
+        src = blocks.vector_source_f(src_data, False, 1, tags)
+        shm_snd = blocks.shm_sink(gr.sizeof_float, self.name, 4096)
+        self.assertGreaterEqual(shm_snd.capacity(), 4096)
+        self.tb_snd.connect(src, shm_snd)
+
+        shm_rcv = blocks.shm_source(gr.sizeof_float, self.name)
+        dst = blocks.vector_sink_f()
+        self.tb_rcv.connect(shm_rcv, dst)
+        self.tb_rcv.start()
+        self.wait_readers(shm_snd, 1)
+
+        self.tb_snd.run()
+        self.tb_rcv.wait()
+
+        self.assertEqual(tuple(src_data), dst.data())
+        self.assertEqual(shm_rcv.lost_items(), 0)
+        result = [(t.offset, pmt.symbol_to_string(t.key), pmt.to_long(t.value),
+                   pmt.symbol_to_string(t.srcid)) for t in dst.tags()]
+        self.assertEqual(result, [(n, "test", n, "qa") for n in (0, 5, 999, 50000)])
+
+    def test_002(self):
+        # Two readers get everything
+        src_data = range(20000)
+        src = blocks.vector_source_i(src_data, False)
+        shm_snd = blocks.shm_sink(gr.sizeof_int, self.name, 1024)
+        self.tb_snd.connect(src, shm_snd)
+
+        dsts = []
+        for i in range(2):
+            shm_rcv = blocks.shm_source(gr.sizeof_int, self.name)
+            dst = blocks.vector_sink_i()
+            self.tb_rcv.connect(shm_rcv, dst)
+            dsts.append(dst)
+        self.tb_rcv.start()
+        self.wait_readers(shm_snd, 2)
+
+        self.tb_snd.run()
+        self.tb_rcv.wait()
+
+        for dst in dsts:
+            self.assertEqual(tuple(src_data), dst.data())
+
+    def test_003(self):
+        # A source with the wrong item size outputs nothing
+        src = blocks.vector_source_f([1.0, 2.0], False)
+        shm_snd = blocks.shm_sink(gr.sizeof_float, self.name)
+        self.tb_snd.connect(src, shm_snd)
+
+        shm_rcv = blocks.shm_source(gr.sizeof_gr_complex, self.name)
+        dst = blocks.vector_sink_c()
+        self.tb_rcv.connect(shm_rcv, dst)
+        self.tb_rcv.run()
+
+        self.assertEqual(len(dst.data()), 0)
+        self.assertFalse(shm_rcv.attached())
+
+if __name__ == '__main__':
+    gr_unittest.run(test_shm, "test_shm.xml")
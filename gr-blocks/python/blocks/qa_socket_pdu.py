@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import socket
+import struct
+import time
+
+class test_socket_pdu(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def wait_for(self, dbg, n):
+        for i in xrange(200):
+            if dbg.num_messages() >= n:
+                break
+            time.sleep(0.01)
+
+    def pdus(self, dbg):
+        return [pmt.u8vector_elements(pmt.cdr(dbg.get_message(i)))
+                for i in xrange(dbg.num_messages())]
+
+    def test_001(self):
+        # Framed server to framed client: every PDU arrives whole
+        server = blocks.socket_pdu("TCP_SERVER", "127.0.0.1", "52211", 10000, True, 2)
+        client = blocks.socket_pdu("TCP_CLIENT", "127.0.0.1", "52211", 10000, True)
+        dbg = blocks.message_debug()
+        self.tb.msg_connect(client, "pdus", dbg, "store")
+        # The server needs to be in the graph to handle posted messages
+        self.tb.msg_connect(server, "pdus", blocks.message_debug(), "store")
+        self.tb.start()
+        time.sleep(0.2)			# let the server accept
+
+        port = pmt.intern("pdus")
+        sent = [tuple(i % 256 for i in xrange(n))
+                for n in (0, 1, 100, 255, 256, 3000, 9999)]
+        for data in sent:
+            msg = pmt.cons(pmt.PMT_NIL, pmt.init_u8vector(len(data), data))
+            server.to_basic_block()._post(port, msg)
+
+        self.wait_for(dbg, len(sent))
+        self.tb.stop()
+        self.tb.wait()
+        self.assertEqual(sent, self.pdus(dbg))
+
+    def test_002(self):
+        # Framed server reading frames split across reads
+        server = blocks.socket_pdu("TCP_SERVER", "127.0.0.1", "52212", 100, True)
+        dbg = blocks.message_debug()
+        self.tb.msg_connect(server, "pdus", dbg, "store")
+        self.tb.start()
+
+        s = socket.create_connection(("127.0.0.1", 52212))
+        stream = ''.join(struct.pack('>I', n) + chr(n) * n for n in (3, 0, 100, 7))
+        for i in xrange(0, len(stream), 5):
+            s.sendall(stream[i:i+5])
+            time.sleep(0.001)
+
+        self.wait_for(dbg, 4)
+        s.close()
+        self.tb.stop()
+        self.tb.wait()
+        self.assertEqual([(n,) * n for n in (3, 0, 100, 7)], self.pdus(dbg))
+
+if __name__ == '__main__':
+    gr_unittest.run(test_socket_pdu, "test_socket_pdu.xml")
@@ -0,0 +1,111 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import os
+
+class test_tag_log(gr_unittest.TestCase):
+
+    def setUp(self):
+        os.environ['GR_CONF_CONTROLPORT_ON'] = 'False'
+        self.tb = gr.top_block()
+        self.filename = "tmp_tag_log.32f"
+        self.N = 10000
+        self.offsets = (0, 17, 17, 500, 2048, 2049, 7000, 9999)
+
+        # Record, with a few tags per block of the log
+        tags = []
+        for i, o in enumerate(self.offsets):
+            t = gr.tag_t()
+            t.offset = o
+            t.key = pmt.intern("key%d" % (i % 2))
+            t.value = pmt.from_long(i)
+            tags.append(t)
+        src = blocks.vector_source_f(range(self.N), False, 1, tags)
+        snk = blocks.tag_log_sink(gr.sizeof_float, self.filename, 3)
+        self.tb.connect(src, snk)
+        self.tb.run()
+        snk.close()
+        self.assertEqual(snk.num_tags(), len(self.offsets))
+
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+        os.remove(self.filename)
+        os.remove(self.filename + ".tags")
+
+    def check_tags(self, tags, start, nitems):
+        expected = [(o - start) % self.N for o in self.offsets]
+        for t in tags:
+            i = pmt.to_long(t.value)
+            self.assertEqual(t.offset % self.N, expected[i])
+            self.assertTrue(pmt.eq(t.key, pmt.intern("key%d" % (i % 2))))
+        played = [i for i, o in enumerate(expected) if o < nitems]
+        self.assertEqual(sorted(pmt.to_long(t.value) for t in tags), played)
+
+    def test_001(self):
+        # Play back the samples and the tags at their offsets
+        src = blocks.tag_log_source(gr.sizeof_float, self.filename)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, snk)
+        self.tb.run()
+
+        self.assertEqual(src.file_items(), self.N)
+        self.assertEqual(src.num_tags(), len(self.offsets))
+        self.assertFloatTuplesAlmostEqual(range(self.N), snk.data())
+        self.check_tags(snk.tags(), 0, self.N)
+
+    def test_002(self):
+        # Seek into the recording
+        src = blocks.tag_log_source(gr.sizeof_float, self.filename)
+        self.assertTrue(src.seek(2049, os.SEEK_SET))
+        self.assertFalse(src.seek(self.N + 1, os.SEEK_SET))
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, snk)
+        self.tb.run()
+
+        self.assertFloatTuplesAlmostEqual(range(2049, self.N), snk.data())
+        tags = [t for t in snk.tags()]
+        self.assertEqual(len(tags), 3)
+        for t in tags:
+            o = self.offsets[pmt.to_long(t.value)]
+            self.assertEqual(t.offset, o - 2049)
+
+    def test_003(self):
+        # Repeat from a seek point, the tags come back on every pass
+        src = blocks.tag_log_source(gr.sizeof_float, self.filename, True)
+        self.assertTrue(src.seek(500, os.SEEK_SET))
+        head = blocks.head(gr.sizeof_float, 2*self.N)
+        snk = blocks.vector_sink_f()
+        self.tb.connect(src, head, snk)
+        self.tb.run()
+
+        expected = [(500 + i) % self.N for i in xrange(2*self.N)]
+        self.assertFloatTuplesAlmostEqual(expected, snk.data())
+        tags = snk.tags()
+        self.assertEqual(len(tags), 2*len(self.offsets))
+        self.check_tags(tags[:len(self.offsets)], 500, self.N)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_tag_log, "test_tag_log.xml")
@@ -0,0 +1,101 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+from gnuradio import gr, gr_unittest, blocks
+import pmt
+import os
+import socket
+import struct
+import time
+
+class test_udp_mmsg(gr_unittest.TestCase):
+
+    def setUp(self):
+        os.environ['GR_CONF_CONTROLPORT_ON'] = 'False'
+        self.tb_snd = gr.top_block()
+        self.tb_rcv = gr.top_block()
+
+    def tearDown(self):
+        self.tb_rcv = None
+        self.tb_snd = None
+
+    def receive(self, dst, nitems):
+        # Wait for the data, then stop the receiving flowgraph
+        for i in xrange(200):
+            if len(dst.data()) >= nitems:
+                break
+            time.sleep(0.01)
+        self.tb_rcv.stop()
+        self.tb_rcv.wait()
+
+    def test_001(self):
+        # Sink to source with sequence numbers
+        n_packets = 50
+        psize = 4 + 100*gr.sizeof_float
+        src_data = [float(x) for x in range(100*n_packets)]
+
+        udp_rcv = blocks.udp_mmsg_source(gr.sizeof_float, '127.0.0.1', 0,
+                                         psize, 4, 0, 0, 32)
+        dst = blocks.vector_sink_f()
+        self.tb_rcv.connect(udp_rcv, dst)
+
+        src = blocks.vector_source_f(src_data, False)
+        udp_snd = blocks.udp_mmsg_sink(gr.sizeof_float, '127.0.0.1',
+                                       udp_rcv.get_port(), psize, True)
+        self.assertEqual(udp_snd.items_per_packet(), 100)
+        self.tb_snd.connect(src, udp_snd)
+
+        self.tb_rcv.start()
+        self.tb_snd.run()
+        self.receive(dst, len(src_data))
+
+        self.assertEqual(tuple(src_data), dst.data())
+        self.assertEqual(udp_snd.packets(), n_packets)
+        self.assertEqual(udp_rcv.packets(), n_packets)
+        self.assertEqual(udp_rcv.lost_packets(), 0)
+        self.assertEqual(len(dst.tags()), 0)
+
+    def test_002(self):
+        # VITA-49 style 4-bit packet counts with gaps and a late packet
+        udp_rcv = blocks.udp_mmsg_source(gr.sizeof_float, '127.0.0.1', 0,
+                                         1472, 4, 0, 16, 4)
+        dst = blocks.vector_sink_f()
+        self.tb_rcv.connect(udp_rcv, dst)
+        self.tb_rcv.start()
+
+        counts = (14, 15, 0, 3, 4, 2, 5, 11)
+        s = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        for i, c in enumerate(counts):
+            hdr = 0x18000000 | (c << 16)
+            s.sendto(struct.pack('>I', hdr) + struct.pack('f', i),
+                     ('127.0.0.1', udp_rcv.get_port()))
+        s.close()
+        self.receive(dst, len(counts))
+
+        self.assertFloatTuplesAlmostEqual(range(len(counts)), dst.data())
+        self.assertEqual(udp_rcv.lost_packets(), 2 + 5)
+        tags = [(t.offset, pmt.to_uint64(t.value)) for t in dst.tags()
+                if pmt.eq(t.key, pmt.intern("packets_lost"))]
+        self.assertEqual(tags, [(3, 2), (7, 5)])
+
+if __name__ == '__main__':
+    gr_unittest.run(test_udp_mmsg, "test_udp_mmsg.xml")
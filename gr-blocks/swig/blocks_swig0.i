@@ -33,6 +33,7 @@
 #include "gnuradio/blocks/control_loop.h"
 #include "gnuradio/blocks/copy.h"
 #include "gnuradio/blocks/delay.h"
+#include "gnuradio/blocks/direct_file_sink.h"
 #include "gnuradio/blocks/endian_swap.h"
 #include "gnuradio/blocks/file_descriptor_sink.h"
 #include "gnuradio/blocks/file_descriptor_source.h"
@@ -48,9 +49,12 @@
 #include "gnuradio/blocks/message_strobe.h"
 #include "gnuradio/blocks/message_strobe_random.h"
 #include "gnuradio/blocks/message_burst_source.h"
+#include "gnuradio/blocks/mmap_file_source.h"
 #include "gnuradio/blocks/nop.h"
 #include "gnuradio/blocks/null_sink.h"
 #include "gnuradio/blocks/null_source.h"
+#include "gnuradio/blocks/tag_log_sink.h"
+#include "gnuradio/blocks/tag_log_source.h"
 %}
 
 %include "gnuradio/blocks/annotator_1to1.h"
@@ -59,6 +63,7 @@
 %include "gnuradio/blocks/control_loop.h"
 %include "gnuradio/blocks/copy.h"
 %include "gnuradio/blocks/delay.h"
+%include "gnuradio/blocks/direct_file_sink.h"
 %include "gnuradio/blocks/endian_swap.h"
 %include "gnuradio/blocks/file_descriptor_sink.h"
 %include "gnuradio/blocks/file_descriptor_source.h"
@@ -74,15 +79,19 @@
 %include "gnuradio/blocks/message_strobe.h"
 %include "gnuradio/blocks/message_strobe_random.h"
 %include "gnuradio/blocks/message_burst_source.h"
+%include "gnuradio/blocks/mmap_file_source.h"
 %include "gnuradio/blocks/nop.h"
 %include "gnuradio/blocks/null_sink.h"
 %include "gnuradio/blocks/null_source.h"
+%include "gnuradio/blocks/tag_log_sink.h"
+%include "gnuradio/blocks/tag_log_source.h"
 
 GR_SWIG_BLOCK_MAGIC2(blocks, annotator_1to1);
 GR_SWIG_BLOCK_MAGIC2(blocks, annotator_alltoall);
 GR_SWIG_BLOCK_MAGIC2(blocks, annotator_raw);
 GR_SWIG_BLOCK_MAGIC2(blocks, copy);
 GR_SWIG_BLOCK_MAGIC2(blocks, delay);
+GR_SWIG_BLOCK_MAGIC2(blocks, direct_file_sink);
 GR_SWIG_BLOCK_MAGIC2(blocks, endian_swap);
 GR_SWIG_BLOCK_MAGIC2(blocks, file_descriptor_sink);
 GR_SWIG_BLOCK_MAGIC2(blocks, file_descriptor_source);
@@ -97,9 +106,12 @@ GR_SWIG_BLOCK_MAGIC2(blocks, message_source);
 GR_SWIG_BLOCK_MAGIC2(blocks, message_strobe);
 GR_SWIG_BLOCK_MAGIC2(blocks, message_strobe_random);
 GR_SWIG_BLOCK_MAGIC2(blocks, message_burst_source);
+GR_SWIG_BLOCK_MAGIC2(blocks, mmap_file_source);
 GR_SWIG_BLOCK_MAGIC2(blocks, nop);
 GR_SWIG_BLOCK_MAGIC2(blocks, null_sink);
 GR_SWIG_BLOCK_MAGIC2(blocks, null_source);
+GR_SWIG_BLOCK_MAGIC2(blocks, tag_log_sink);
+GR_SWIG_BLOCK_MAGIC2(blocks, tag_log_source);
 
 #ifdef GR_CTRLPORT
 
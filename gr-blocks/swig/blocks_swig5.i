@@ -42,6 +42,8 @@
 #include "gnuradio/blocks/sample_and_hold_ss.h"
 #include "gnuradio/blocks/sample_and_hold_ii.h"
 #include "gnuradio/blocks/sample_and_hold_ff.h"
+#include "gnuradio/blocks/shm_sink.h"
+#include "gnuradio/blocks/shm_source.h"
 #include "gnuradio/blocks/short_to_char.h"
 #include "gnuradio/blocks/short_to_float.h"
 #include "gnuradio/blocks/socket_pdu.h"
@@ -61,6 +63,8 @@
 #include "gnuradio/blocks/uchar_to_float.h"
 #include "gnuradio/blocks/udp_sink.h"
 #include "gnuradio/blocks/udp_source.h"
+#include "gnuradio/blocks/udp_mmsg_sink.h"
+#include "gnuradio/blocks/udp_mmsg_source.h"
 #include "gnuradio/blocks/unpack_k_bits_bb.h"
 #include "gnuradio/blocks/unpacked_to_packed_bb.h"
 #include "gnuradio/blocks/unpacked_to_packed_ss.h"
@@ -83,6 +87,8 @@
 %include "gnuradio/blocks/sample_and_hold_ss.h"
 %include "gnuradio/blocks/sample_and_hold_ii.h"
 %include "gnuradio/blocks/sample_and_hold_ff.h"
+%include "gnuradio/blocks/shm_sink.h"
+%include "gnuradio/blocks/shm_source.h"
 %include "gnuradio/blocks/short_to_char.h"
 %include "gnuradio/blocks/short_to_float.h"
 %include "gnuradio/blocks/socket_pdu.h"
@@ -102,6 +108,8 @@
 %include "gnuradio/blocks/uchar_to_float.h"
 %include "gnuradio/blocks/udp_sink.h"
 %include "gnuradio/blocks/udp_source.h"
+%include "gnuradio/blocks/udp_mmsg_sink.h"
+%include "gnuradio/blocks/udp_mmsg_source.h"
 %include "gnuradio/blocks/unpack_k_bits_bb.h"
 %include "gnuradio/blocks/unpacked_to_packed_bb.h"
 %include "gnuradio/blocks/unpacked_to_packed_ss.h"
@@ -123,6 +131,8 @@ GR_SWIG_BLOCK_MAGIC2(blocks, sample_and_hold_bb);
 GR_SWIG_BLOCK_MAGIC2(blocks, sample_and_hold_ss);
 GR_SWIG_BLOCK_MAGIC2(blocks, sample_and_hold_ii);
 GR_SWIG_BLOCK_MAGIC2(blocks, sample_and_hold_ff);
+GR_SWIG_BLOCK_MAGIC2(blocks, shm_sink);
+GR_SWIG_BLOCK_MAGIC2(blocks, shm_source);
 GR_SWIG_BLOCK_MAGIC2(blocks, short_to_char);
 GR_SWIG_BLOCK_MAGIC2(blocks, short_to_float);
 GR_SWIG_BLOCK_MAGIC2(blocks, socket_pdu);
@@ -142,6 +152,8 @@ GR_SWIG_BLOCK_MAGIC2(blocks, tuntap_pdu);
 GR_SWIG_BLOCK_MAGIC2(blocks, uchar_to_float);
 GR_SWIG_BLOCK_MAGIC2(blocks, udp_sink);
 GR_SWIG_BLOCK_MAGIC2(blocks, udp_source);
+GR_SWIG_BLOCK_MAGIC2(blocks, udp_mmsg_sink);
+GR_SWIG_BLOCK_MAGIC2(blocks, udp_mmsg_source);
 GR_SWIG_BLOCK_MAGIC2(blocks, unpack_k_bits_bb);
 GR_SWIG_BLOCK_MAGIC2(blocks, unpacked_to_packed_bb);
 GR_SWIG_BLOCK_MAGIC2(blocks, unpacked_to_packed_ss);
@@ -0,0 +1,231 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/*
+ * Seeks by time into a 100 GB file_meta_sink recording of 12500
+ * segments, inline and detached: by reading the headers from the
+ * start of the file, as file_meta_source does without an index, and
+ * by a binary search of the file_meta_index.  The recordings are
+ * sparse files with only their headers written, so they take no disk
+ * space; the headers are the ones file_meta_sink writes.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <gnuradio/blocks/file_meta_sink.h>
+#include <gnuradio/blocks/file_meta_index.h>
+#include <pmt/pmt.h>
+#include <stdexcept>
+#include <string>
+
+using namespace gr::blocks;
+
+#define NSEGMENTS 12500
+#define SEGMENT_ITEMS 1000000   // 1 s at 1 Msps
+#define ITEMSIZE 8              // complex float
+#define NSCANS 20
+#define NLOOKUPS 10000
+
+static const uint64_t SEGMENT_BYTES = (uint64_t)SEGMENT_ITEMS * ITEMSIZE;
+
+static double
+wall_time()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec * 1e-6;
+}
+
+static std::string
+make_header(uint64_t secs, std::string &extra)
+{
+  pmt::pmt_t extras = pmt::make_dict();
+  extra = pmt::serialize_str(extras);
+
+  pmt::pmt_t h = pmt::make_dict();
+  h = pmt::dict_add(h, pmt::mp("version"), pmt::mp(METADATA_VERSION));
+  h = pmt::dict_add(h, pmt::mp("rx_rate"), pmt::mp(1e6));
+  h = pmt::dict_add(h, pmt::mp("rx_time"), pmt::make_tuple(pmt::from_uint64(secs),
+							   pmt::from_double(0)));
+  h = pmt::dict_add(h, pmt::mp("size"), pmt::from_long(ITEMSIZE));
+  h = pmt::dict_add(h, pmt::mp("type"), pmt::from_long(GR_FILE_FLOAT));
+  h = pmt::dict_add(h, pmt::mp("cplx"), pmt::PMT_T);
+  h = pmt::dict_add(h, pmt::mp("strt"), pmt::from_uint64(METADATA_HEADER_SIZE+extra.size()));
+  h = pmt::dict_add(h, pmt::mp("bytes"), pmt::from_uint64(SEGMENT_BYTES));
+  return pmt::serialize_str(h);
+}
+
+static void
+write_at(FILE *fp, uint64_t offset, const std::string &s)
+{
+  if(fseek(fp, offset, SEEK_SET) != 0 ||
+     fwrite(s.data(), 1, s.size(), fp) != s.size())
+    throw std::runtime_error("write failed");
+}
+
+// Writes the headers and index of a recording, and sizes the data file
+static void
+make_recording(const std::string &name, bool detached)
+{
+  FILE *fp = fopen(name.c_str(), "wb");
+  FILE *hdr_fp = detached ? fopen((name + ".hdr").c_str(), "wb") : fp;
+  file_meta_index index(name + ".idx", true);
+  uint64_t pos = 0, hdr_pos = 0;
+
+  for(uint64_t n = 0; n < NSEGMENTS; n++) {
+    std::string extra, hdr = make_header(n, extra);
+    file_meta_index::entry e;
+    e.hdr_offset = detached ? hdr_pos : pos;
+    write_at(hdr_fp, e.hdr_offset, hdr + extra);
+    if(detached)
+      hdr_pos += hdr.size() + extra.size();
+    else
+      pos += hdr.size() + extra.size();
+    e.data_offset = pos;
+    e.item = n * SEGMENT_ITEMS;
+    e.nitems = SEGMENT_ITEMS;
+    e.secs = n;
+    e.fracs = 0;
+    e.rate = 1e6;
+    index.append(e);
+    pos += SEGMENT_BYTES;
+  }
+
+  fflush(fp);
+  if(ftruncate(fileno(fp), pos) != 0)
+    throw std::runtime_error("ftruncate failed");
+  fclose(fp);
+  if(detached)
+    fclose(hdr_fp);
+}
+
+static pmt::pmt_t
+read_header(FILE *fp, uint64_t offset)
+{
+  char buf[METADATA_HEADER_SIZE];
+  if(fseek(fp, offset, SEEK_SET) != 0 ||
+     fread(buf, 1, METADATA_HEADER_SIZE, fp) != METADATA_HEADER_SIZE)
+    throw std::runtime_error("read failed");
+  pmt::pmt_t hdr = pmt::deserialize_str(std::string(buf, METADATA_HEADER_SIZE));
+
+  // Read the extras too, as file_meta_source does
+  uint64_t strt = pmt::to_uint64(pmt::dict_ref(hdr, pmt::mp("strt"), pmt::PMT_NIL));
+  std::string extra(strt - METADATA_HEADER_SIZE, '\0');
+  if(fread(&extra[0], 1, extra.size(), fp) != extra.size())
+    throw std::runtime_error("read failed");
+  pmt::deserialize_str(extra);
+  return hdr;
+}
+
+static uint64_t
+header_secs(pmt::pmt_t hdr)
+{
+  return pmt::to_uint64(pmt::tuple_ref(pmt::dict_ref(hdr, pmt::mp("rx_time"), pmt::PMT_NIL), 0));
+}
+
+// Data offset of the segment holding time secs, reading every header
+// before it
+static uint64_t
+scan_seek(FILE *hdr_fp, bool detached, uint64_t secs)
+{
+  uint64_t h = 0, d = 0;
+  for(;;) {
+    pmt::pmt_t hdr = read_header(hdr_fp, h);
+    uint64_t strt = pmt::to_uint64(pmt::dict_ref(hdr, pmt::mp("strt"), pmt::PMT_NIL));
+    uint64_t bytes = pmt::to_uint64(pmt::dict_ref(hdr, pmt::mp("bytes"), pmt::PMT_NIL));
+    if(header_secs(hdr) == secs)
+      return detached ? d : h + strt;
+    if(detached) {
+      h += strt;
+      d += bytes;
+    }
+    else
+      h += strt + bytes;
+  }
+}
+
+// The same with the index, reading only the header of the segment
+static uint64_t
+index_seek(const file_meta_index &index, FILE *hdr_fp, uint64_t secs)
+{
+  file_meta_index::entry e = index.at(index.find_time(secs, 0.5));
+  if(header_secs(read_header(hdr_fp, e.hdr_offset)) != secs)
+    throw std::runtime_error("index points to the wrong header");
+  return e.data_offset;
+}
+
+static void
+benchmark(const char *name, bool detached)
+{
+  std::string file = std::string("benchmark_file_meta_seek_") + name + ".dat";
+  make_recording(file, detached);
+
+  FILE *hdr_fp = fopen((detached ? file + ".hdr" : file).c_str(), "rb");
+  file_meta_index index(file + ".idx", false);
+  uint64_t targets[NLOOKUPS];
+  for(int i = 0; i < NLOOKUPS; i++)
+    targets[i] = (uint64_t)rand() % NSEGMENTS;
+
+  // Make sure both find the same data, then time them
+  for(int i = 0; i < NSCANS; i++) {
+    if(scan_seek(hdr_fp, detached, targets[i]) != index_seek(index, hdr_fp, targets[i])) {
+      fprintf(stderr, "%s: seeks disagree\n", name);
+      exit(1);
+    }
+  }
+
+  double t0 = wall_time();
+  for(int i = 0; i < NSCANS; i++)
+    scan_seek(hdr_fp, detached, targets[i]);
+  double t1 = wall_time();
+  for(int i = 0; i < NLOOKUPS; i++)
+    index_seek(index, hdr_fp, targets[i]);
+  double t2 = wall_time();
+
+  double scan = (t1 - t0) / NSCANS, lookup = (t2 - t1) / NLOOKUPS;
+  printf("%9s: %d segments, %.0f GB\n", name, NSEGMENTS,
+	 NSEGMENTS * (double)SEGMENT_BYTES * 1e-9);
+  printf("           headers: %10.1f us/seek\n", scan * 1e6);
+  printf("           index:   %10.1f us/seek  (%.0fx)\n", lookup * 1e6, scan / lookup);
+
+  fclose(hdr_fp);
+  remove(file.c_str());
+  remove((file + ".hdr").c_str());
+  remove((file + ".idx").c_str());
+}
+
+int
+main(int argc, char **argv)
+{
+  benchmark("inline", false);
+  benchmark("detached", true);
+  return 0;
+}
@@ -0,0 +1,158 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+/*
+ * Streams complex samples from one process to another, through a
+ * pipe with file_descriptor_sink and file_descriptor_source, and
+ * through shared memory with shm_sink and shm_source: to one reader
+ * and to two, and with a stream tag every 1000 samples.  Each reader
+ * is a forked process running a flowgraph of its own into a null
+ * sink; the time is from the start of the writer to the end of the
+ * last reader.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gnuradio/top_block.h>
+#include <gnuradio/blocks/file_descriptor_sink.h>
+#include <gnuradio/blocks/file_descriptor_source.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/null_source.h>
+#include <gnuradio/blocks/shm_sink.h>
+#include <gnuradio/blocks/shm_source.h>
+#include <gnuradio/blocks/tags_strobe.h>
+#include <gnuradio/gr_complex.h>
+#include <pmt/pmt.h>
+
+using namespace gr::blocks;
+
+#define NITEMS 200000000ULL	// 1.6 GB
+#define ITEMSIZE sizeof(gr_complex)
+#define SEGMENT "benchmark_shm_transport"
+
+static double
+wall_time()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return (double)tv.tv_sec + (double)tv.tv_usec * 1e-6;
+}
+
+static void
+report(const char *name, double secs)
+{
+  printf("%-24s %8.1f Msamples/s %6.2f GB/s\n", name,
+	 NITEMS / secs * 1e-6, NITEMS * ITEMSIZE / secs * 1e-9);
+}
+
+static gr::basic_block_sptr
+writer_source(bool tagged)
+{
+  if(tagged)
+    return tags_strobe::make(ITEMSIZE, pmt::from_uint64(0), 1000);
+  return null_source::make(ITEMSIZE);
+}
+
+static void
+pipe_transport()
+{
+  int fds[2];
+  if(pipe(fds) < 0) {
+    perror("pipe");
+    exit(1);
+  }
+
+  pid_t pid = fork();
+  if(pid == 0) {
+    close(fds[1]);
+    gr::top_block_sptr tb = gr::make_top_block("reader");
+    tb->connect(file_descriptor_source::make(ITEMSIZE, fds[0]), 0,
+		null_sink::make(ITEMSIZE), 0);
+    tb->run();
+    _exit(0);
+  }
+  close(fds[0]);
+
+  gr::top_block_sptr tb = gr::make_top_block("writer");
+  head::sptr h = head::make(ITEMSIZE, NITEMS);
+  tb->connect(null_source::make(ITEMSIZE), 0, h, 0);
+  tb->connect(h, 0, file_descriptor_sink::make(ITEMSIZE, fds[1]), 0);
+
+  double t0 = wall_time();
+  tb->run();
+  tb.reset();		// closes the pipe
+  waitpid(pid, 0, 0);
+  report("pipe", wall_time() - t0);
+}
+
+static void
+shm_transport(const char *name, int nreaders, bool tagged)
+{
+  pid_t pids[2];
+  for(int i = 0; i < nreaders; i++) {
+    pids[i] = fork();
+    if(pids[i] == 0) {
+      gr::top_block_sptr tb = gr::make_top_block("reader");
+      tb->connect(shm_source::make(ITEMSIZE, SEGMENT), 0,
+		  null_sink::make(ITEMSIZE), 0);
+      tb->run();
+      _exit(0);
+    }
+  }
+
+  gr::top_block_sptr tb = gr::make_top_block("writer");
+  shm_sink::sptr sink = shm_sink::make(ITEMSIZE, SEGMENT);
+  head::sptr h = head::make(ITEMSIZE, NITEMS);
+  tb->connect(writer_source(tagged), 0, h, 0);
+  tb->connect(h, 0, sink, 0);
+
+  // The readers start from where the writer is when they attach
+  while(sink->num_readers() < nreaders)
+    usleep(1000);
+
+  double t0 = wall_time();
+  tb->run();
+  for(int i = 0; i < nreaders; i++)
+    waitpid(pids[i], 0, 0);
+  report(name, wall_time() - t0);
+}
+
+int
+main(int argc, char **argv)
+{
+  pipe_transport();
+  shm_transport("shm", 1, false);
+  shm_transport("shm, 2 readers", 2, false);
+  shm_transport("shm, tag every 1000", 1, true);
+  return 0;
+}
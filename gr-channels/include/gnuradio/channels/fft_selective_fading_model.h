@@ -0,0 +1,94 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_CHANNELS_FFT_SELECTIVE_FADING_MODEL_H
+#define INCLUDED_CHANNELS_FFT_SELECTIVE_FADING_MODEL_H
+
+#include <gnuradio/channels/api.h>
+#include <gnuradio/sync_block.h>
+#include <gnuradio/types.h>
+
+namespace gr {
+  namespace channels {
+
+    /*!
+     * \brief frequency selective fading simulator for long delay spreads
+     * \ingroup channel_models_blk
+     *
+     * \details
+     * Applies the same model as selective_fading_model, a sum of
+     * sinusoids fader for each ray of the power delay profile, but
+     * filters by overlap-save FFT convolution so that the cost grows
+     * with the log of the number of taps rather than linearly.  This
+     * makes profiles with hundreds of taps, such as the 3GPP TDL and
+     * CDL models, usable at high sample rates.
+     *
+     * The impulse response is evaluated at the edges of each FFT block
+     * and the taps are interpolated linearly in between, which holds
+     * as long as the block, about 3*ntaps samples, is short against
+     * the coherence time 1/fDTs.  Each ray is placed on the tap grid
+     * by a sinc of its fractional delay, so ntaps should cover the
+     * largest delay with some margin for the sinc tails.
+     */
+    class CHANNELS_API fft_selective_fading_model : virtual public sync_block
+    {
+    public:
+      // gr::channels::fft_selective_fading_model::sptr
+      typedef boost::shared_ptr<fft_selective_fading_model> sptr;
+
+      /*! \brief Build the channel simulator.
+       *
+       * \param N      The number of sinusiods to use in simulating each ray; 8 is a good value
+       * \param fDTs   normalized maximum Doppler frequency, fD * Ts
+       * \param LOS    include Line-of-Site path? selects between Rayleigh (NLOS) and Rician (LOS) models for the first ray
+       * \param K      Rician factor (ratio of the specular power to the scattered power)
+       * \param seed   a random number to seed the noise generators
+       * \param delays A vector of the time delays of the rays, in samples
+       * \param mags   A vector of the magnitudes of the rays
+       * \param ntaps  The number of filter taps.
+       */
+      static sptr make(unsigned int N,
+                       float fDTs,
+                       bool LOS,
+                       float K,
+                       int seed,
+                       std::vector<float> delays,
+                       std::vector<float> mags,
+                       int ntaps);
+
+      virtual float fDTs() = 0;
+      virtual float K() = 0;
+      virtual float step() = 0;
+
+      virtual void set_fDTs(float fDTs) = 0;
+      virtual void set_K(float K) = 0;
+      virtual void set_step(float step) = 0;
+
+      //! The FFT size; each block yields fft_size() - ntaps + 1 samples
+      virtual int fft_size() const = 0;
+    };
+
+  } /* namespace channels */
+} /* namespace gr */
+
+#endif /* INCLUDED_CHANNELS_FFT_SELECTIVE_FADING_MODEL_H */
@@ -50,12 +50,12 @@ namespace gr {
 		       io_signature::make(1, 1, sizeof(gr_complex)),
 		       io_signature::make(1, 1, sizeof(gr_complex))),
         d_samp_rate(sample_rate_hz),
+        d_std_dev_hz(std_dev_hz),
         d_max_dev_hz(max_dev_hz),
         d_table(8*1024),
-        d_noise(gr::analog::fastnoise_source_f::make(analog::GR_GAUSSIAN, std_dev_hz, noise_seed)),
+        d_rng((long)noise_seed),
         d_cfo(0),
-        d_angle(0),
-        d_noise_seed(noise_seed)
+        d_angle(0)
     {
     }
 
@@ -69,11 +69,11 @@ namespace gr {
 
         const gr_complex* in = (const gr_complex*) input_items[0];
         gr_complex* out = (gr_complex*) output_items[0];
+        d_noise.resize(noutput_items);
+        d_rng.gasdev_fill(&d_noise[0], noutput_items);
         for(int i=0; i<noutput_items; i++){
             // update and bound cfo
-            // we multiply by a random {1,-1} to remove any sign
-            // bias that may exist in our random sample pool
-            d_cfo += d_noise->sample_unbiased();
+            d_cfo += d_std_dev_hz * d_noise[i];
             d_cfo = std::min( d_cfo, d_max_dev_hz );
             d_cfo = std::max( d_cfo, -d_max_dev_hz );
             // update and wrap angle
@@ -27,7 +27,7 @@
 #include <gnuradio/blocks/integrate_ff.h>
 #include <gnuradio/blocks/vco_c.h>
 #include <gnuradio/blocks/multiply_cc.h>
-#include <gnuradio/analog/fastnoise_source_f.h>
+#include <gnuradio/random.h>
 #include <gnuradio/channels/cfo_model.h>
 #include <sincostable.h>
 
@@ -41,10 +41,10 @@ namespace gr {
       double d_std_dev_hz;
       double d_max_dev_hz;
       sincostable d_table;
-      gr::analog::fastnoise_source_f::sptr d_noise;
+      gr::random d_rng;
+      std::vector<float> d_noise;
       double d_cfo;
       float d_angle;
-      double d_noise_seed;
 
     public:
       cfo_model_impl(
@@ -57,7 +57,7 @@ namespace gr {
       void setup_rpc();
       int work(int, gr_vector_const_void_star&, gr_vector_void_star&);
 
-      void set_std_dev(double _dev){ d_std_dev_hz = _dev; d_noise = gr::analog::fastnoise_source_f::make(analog::GR_GAUSSIAN, d_std_dev_hz, d_noise_seed); }
+      void set_std_dev(double _dev){ d_std_dev_hz = _dev; }
       void set_max_dev(double _dev){ d_max_dev_hz = _dev; }
       void set_samp_rate(double _rate){ d_samp_rate = _rate; }
 
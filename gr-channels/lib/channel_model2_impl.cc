@@ -64,7 +64,7 @@ namespace gr {
       d_multipath = filter::fir_filter_ccc::make(1, d_taps);
 
       d_noise_adder = blocks::add_cc::make();
-      d_noise = analog::fastnoise_source_c::make(analog::GR_GAUSSIAN,
+      d_noise = analog::noise_source_c::make(analog::GR_GAUSSIAN,
 						 noise_voltage, noise_seed);
       d_freq_gen = blocks::vco_c::make(1.0, 2*M_PI, 1.0);
 
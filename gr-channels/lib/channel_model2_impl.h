@@ -28,7 +28,7 @@
 #include <gnuradio/blocks/add_cc.h>
 #include <gnuradio/blocks/multiply_cc.h>
 #include <gnuradio/analog/sig_source_c.h>
-#include <gnuradio/analog/fastnoise_source_c.h>
+#include <gnuradio/analog/noise_source_c.h>
 #include <gnuradio/filter/fractional_resampler_cc.h>
 #include <gnuradio/filter/fir_filter_ccc.h>
 #include <gnuradio/blocks/vco_c.h>
@@ -44,7 +44,7 @@ namespace gr {
 
       blocks::vco_c::sptr d_freq_gen;
 
-      analog::fastnoise_source_c::sptr d_noise;
+      analog::noise_source_c::sptr d_noise;
 
       filter::fractional_resampler_cc::sptr d_timing_offset;
       filter::fir_filter_ccc::sptr d_multipath;
@@ -27,7 +27,7 @@
 #include <gnuradio/blocks/add_cc.h>
 #include <gnuradio/blocks/multiply_cc.h>
 #include <gnuradio/analog/sig_source_c.h>
-#include <gnuradio/analog/fastnoise_source_c.h>
+#include <gnuradio/analog/noise_source_c.h>
 #include <gnuradio/channels/channel_model.h>
 #include <gnuradio/filter/fractional_resampler_cc.h>
 #include <gnuradio/filter/fir_filter_ccc.h>
@@ -42,7 +42,7 @@ namespace gr {
       blocks::multiply_cc::sptr d_mixer_offset;
 
       analog::sig_source_c::sptr d_freq_offset;
-      analog::fastnoise_source_c::sptr d_noise;
+      analog::noise_source_c::sptr d_noise;
 
       filter::fractional_resampler_cc::sptr d_timing_offset;
       filter::fir_filter_ccc::sptr d_multipath;
@@ -72,10 +72,12 @@ namespace gr {
 		       io_signature::make(1, 1, sizeof(gr_complex)))
     {
       d_noise_adder = blocks::add_cc::make();
-      d_noise = analog::fastnoise_source_c::make(analog::GR_GAUSSIAN,
-						 noise_amp, noise_seed, 1024*8);
-      d_sro_model = channels::sro_model::make(samp_rate, sro_std_dev, sro_max_dev, noise_seed);
-      d_cfo_model = channels::cfo_model::make(samp_rate, cfo_std_dev, cfo_max_dev, noise_seed);
+      d_noise = analog::noise_source_c::make(analog::GR_GAUSSIAN,
+						 noise_amp, noise_seed);
+      // The random walks draw from their own generators; with one seed
+      // they would move in lockstep
+      d_sro_model = channels::sro_model::make(samp_rate, sro_std_dev, sro_max_dev, noise_seed + 1);
+      d_cfo_model = channels::cfo_model::make(samp_rate, cfo_std_dev, cfo_max_dev, noise_seed + 2);
       d_fader = channels::selective_fading_model::make(N, doppler_freq / samp_rate, LOS_model, K, noise_seed, delays, mags, ntaps_mpath);
 
       connect(self(), 0, d_sro_model, 0);
@@ -27,7 +27,7 @@
 #include <gnuradio/blocks/add_cc.h>
 #include <gnuradio/blocks/multiply_cc.h>
 #include <gnuradio/analog/sig_source_c.h>
-#include <gnuradio/analog/fastnoise_source_c.h>
+#include <gnuradio/analog/noise_source_c.h>
 #include <gnuradio/channels/dynamic_channel_model.h>
 #include <gnuradio/channels/selective_fading_model.h>
 #include <gnuradio/channels/sro_model.h>
@@ -46,7 +46,7 @@ namespace gr {
       channels::cfo_model::sptr d_cfo_model;
       channels::selective_fading_model::sptr d_fader;
       blocks::add_cc::sptr d_noise_adder;
-      analog::fastnoise_source_c::sptr d_noise;
+      analog::noise_source_c::sptr d_noise;
 
     public:
       dynamic_channel_model_impl( double samp_rate,
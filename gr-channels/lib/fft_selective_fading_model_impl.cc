@@ -0,0 +1,207 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "fft_selective_fading_model_impl.h"
+#include <gnuradio/io_signature.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+  namespace channels {
+
+    fft_selective_fading_model::sptr
+    fft_selective_fading_model::make(unsigned int N, float fDTs, bool LOS, float K, int seed, std::vector<float> delays, std::vector<float> mags, int ntaps)
+    {
+      return gnuradio::get_initial_sptr
+	(new fft_selective_fading_model_impl(N, fDTs, LOS, K, seed, delays, mags, ntaps));
+    }
+
+    fft_selective_fading_model_impl::fft_selective_fading_model_impl(unsigned int N, float fDTs, bool LOS, float K, int seed, std::vector<float> delays, std::vector<float> mags, int ntaps)
+      : sync_block("fft_selective_fading_model",
+		       io_signature::make(1, 1, sizeof(gr_complex)),
+		       io_signature::make(1, 1, sizeof(gr_complex))),
+        d_ntaps(ntaps)
+    {
+        if(mags.size() != delays.size())
+            throw std::runtime_error("magnitude and delay vectors must be the same length!");
+        if(mags.empty())
+            throw std::runtime_error("at least one ray is needed");
+        if(ntaps < 1)
+            throw std::runtime_error("ntaps must be >= 1");
+
+        // An FFT of at least four times the taps, so that most of each
+        // block is output
+        d_fftsize = 4;
+        while(d_fftsize < 4*ntaps)
+            d_fftsize *= 2;
+        d_nsamples = d_fftsize - ntaps + 1;
+
+        d_fwdfft = new fft::fft_complex(d_fftsize, true);
+        d_invfft = new fft::fft_complex(d_fftsize, false);
+        d_H0 = fft::malloc_complex(d_fftsize);
+        d_H1 = fft::malloc_complex(d_fftsize);
+        d_y0.resize(d_nsamples);
+
+        for(size_t j=0; j<mags.size(); j++){
+            d_faders.push_back(new gr::channels::flat_fader_impl(N, fDTs, (j==0)&&(LOS), K, seed+j));
+
+            std::vector<float> taps(ntaps);
+            for(int k=0; k<ntaps; k++){
+                double x = M_PI*(k - delays[j]);
+                taps[k] = mags[j] * (fabs(x) < 1e-9 ? 1.0 : sin(x)/x);
+            }
+            d_ray_taps.push_back(taps);
+        }
+
+        response(d_H0);
+
+        set_history(ntaps);
+        set_output_multiple(d_nsamples);
+    }
+
+    fft_selective_fading_model_impl::~fft_selective_fading_model_impl()
+    {
+        for(size_t j=0; j<d_faders.size(); j++){
+            delete d_faders[j];
+        }
+        delete d_fwdfft;
+        delete d_invfft;
+        fft::free(d_H0);
+        fft::free(d_H1);
+    }
+
+    // Frequency response of the current impulse response, including
+    // the 1/fftsize of the inverse FFT
+    void
+    fft_selective_fading_model_impl::response(gr_complex *H)
+    {
+        gr_complex *h = d_fwdfft->get_inbuf();
+
+        std::fill(h, h+d_fftsize, gr_complex(0,0));
+        for(size_t j=0; j<d_faders.size(); j++){
+            gr_complex g = d_faders[j]->gain() / (float)d_fftsize;
+            const float *c = &d_ray_taps[j][0];
+            for(int k=0; k<d_ntaps; k++){
+                h[k] += g * c[k];
+            }
+        }
+
+        d_fwdfft->execute();
+        memcpy(H, d_fwdfft->get_outbuf(), d_fftsize*sizeof(gr_complex));
+    }
+
+    int
+    fft_selective_fading_model_impl::work (int noutput_items,
+        gr_vector_const_void_star &input_items,
+        gr_vector_void_star &output_items)
+    {
+        const gr_complex* in = (const gr_complex*) input_items[0];
+        gr_complex* out = (gr_complex*) output_items[0];
+
+        for(int i=0; i<noutput_items; i+=d_nsamples){
+            // response at the start of the next block
+            for(size_t j=0; j<d_faders.size(); j++){
+                d_faders[j]->advance(d_nsamples);
+            }
+            response(d_H1);
+
+            // overlap-save with both responses, the first ntaps-1
+            // outputs wrapping around
+            memcpy(d_fwdfft->get_inbuf(), &in[i], d_fftsize*sizeof(gr_complex));
+            d_fwdfft->execute();
+
+            volk_32fc_x2_multiply_32fc(d_invfft->get_inbuf(), d_fwdfft->get_outbuf(), d_H0, d_fftsize);
+            d_invfft->execute();
+            memcpy(&d_y0[0], d_invfft->get_outbuf() + d_ntaps-1, d_nsamples*sizeof(gr_complex));
+
+            volk_32fc_x2_multiply_32fc(d_invfft->get_inbuf(), d_fwdfft->get_outbuf(), d_H1, d_fftsize);
+            d_invfft->execute();
+            const gr_complex *y1 = d_invfft->get_outbuf() + d_ntaps-1;
+
+            // Filtering is linear in the taps, so fading the outputs is
+            // the same as interpolating the taps for every sample
+            for(int n=0; n<d_nsamples; n++){
+                float a = n / (float)d_nsamples;
+                out[i+n] = d_y0[n] + a*(y1[n] - d_y0[n]);
+            }
+
+            std::swap(d_H0, d_H1);
+        }
+
+        return noutput_items;
+    }
+
+    void
+    fft_selective_fading_model_impl::setup_rpc()
+    {
+#ifdef GR_CTRLPORT
+    add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_get<fft_selective_fading_model, float >(
+            alias(), "fDTs",
+            &fft_selective_fading_model::fDTs,
+            pmt::mp(0), pmt::mp(1), pmt::mp(0.01),
+            "Hz*Sec", "normalized maximum doppler frequency (fD*Ts)",
+            RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+    add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_set<fft_selective_fading_model, float >(
+            alias(), "fDTs",
+            &fft_selective_fading_model::set_fDTs,
+            pmt::mp(0), pmt::mp(1), pmt::mp(0.01),
+            "Hz*Sec", "normalized maximum doppler frequency (fD*Ts)",
+            RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+
+    add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_get<fft_selective_fading_model, float >(
+            alias(), "K",
+            &fft_selective_fading_model::K,
+            pmt::mp(0), pmt::mp(8), pmt::mp(4),
+            "Ratio", "Rician factor (ratio of the specular power to the scattered power)",
+            RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+    add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_set<fft_selective_fading_model, float >(
+            alias(), "K",
+            &fft_selective_fading_model::set_K,
+            pmt::mp(0), pmt::mp(8), pmt::mp(4),
+            "Ratio", "Rician factor (ratio of the specular power to the scattered power)",
+            RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+
+    add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_get<fft_selective_fading_model, float >(
+            alias(), "step",
+            &fft_selective_fading_model::step,
+            pmt::mp(0), pmt::mp(8), pmt::mp(4),
+            "radians", "Maximum step size for random walk angle per sample",
+            RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+    add_rpc_variable(
+        rpcbasic_sptr(new rpcbasic_register_set<fft_selective_fading_model, float >(
+            alias(), "step",
+            &fft_selective_fading_model::set_step,
+            pmt::mp(0), pmt::mp(1), pmt::mp(0.00001),
+            "radians", "Maximum step size for random walk angle per sample",
+            RPC_PRIVLVL_MIN, DISPTIME | DISPOPTSTRIP)));
+#endif /* GR_CTRLPORT */
+    }
+
+  } /* namespace channels */
+} /* namespace gr */
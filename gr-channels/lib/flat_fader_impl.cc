@@ -21,6 +21,11 @@
  */
 
 #include <flat_fader_impl.h>
+#include <volk/volk.h>
+#include <algorithm>
+
+// number of samples generated with the same sinusoid frequencies
+#define FADER_BLOCK 1024
 
 namespace gr {
   namespace channels {
@@ -29,11 +34,20 @@ namespace gr {
         seed_1((int)seed),
         dist_1(-M_PI, M_PI),
         rv_1( seed_1, dist_1 ), // U(-pi,pi)
-        
-        seed_2((int)seed+1),
-        dist_2(0, 1),
-        rv_2( seed_2, dist_2 ), // U(0,1)
-        
+
+        d_rng((long)seed+1),
+
+        d_phase_i(std::max((int)N, 1), 0),
+        d_phase_q(std::max((int)N, 1), 0),
+
+        d_w_i(std::max((int)N, 1), 0),
+        d_w_q(std::max((int)N, 1), 0),
+        d_phasors(std::max((int)N, 1)),
+        d_rotators(std::max((int)N, 1)),
+        d_sum_i(FADER_BLOCK),
+        d_sum_q(FADER_BLOCK),
+        d_walk(FADER_BLOCK),
+
         d_N(N),
         d_fDTs(fDTs),
         d_theta(rv_1()),
@@ -46,8 +60,6 @@ namespace gr {
         d_psi(d_N+1, 0),
         d_phi(d_N+1, 0),
         
-        d_table(8*1024),
-        
         scale_sin(sqrtf(2.0/d_N)),
         scale_los(sqrtf(d_K)/sqrtf(d_K+1)),
         scale_nlos(1/sqrtf(d_K+1))
@@ -57,61 +69,131 @@ namespace gr {
           d_psi[i] = rv_1();
           d_phi[i] = rv_1();
         }
-    }
-    
-    
-    gr_complex flat_fader_impl::next_sample(){
-        gr_complex H(0,0);
 
         for(int n=1; n<d_N; n++){
-            float alpha_n = (2*M_PI*n - M_PI + d_theta)/4*d_N;
-#if FASTSINCOS == 1
-            float s_i = scale_sin*gr::fxpt::cos(gr::fxpt::float_to_fixed(2*M_PI*d_fDTs*d_m*gr::fxpt::cos(gr::fxpt::float_to_fixed(alpha_n))+d_psi[n+1]));
-            float s_q = scale_sin*gr::fxpt::cos(gr::fxpt::float_to_fixed(2*M_PI*d_fDTs*d_m*gr::fxpt::sin(gr::fxpt::float_to_fixed(alpha_n))+d_phi[n+1]));
-#elif FASTSINCOS == 2
-            float s_i = scale_sin*d_table.cos(2*M_PI*d_fDTs*d_m*d_table.cos(alpha_n)+d_psi[n+1]);
-            float s_q = scale_sin*d_table.cos(2*M_PI*d_fDTs*d_m*d_table.sin(alpha_n)+d_phi[n+1]);
-
-#else
-            float s_i = scale_sin*cos(2*M_PI*d_fDTs*d_m*cos(alpha_n)+d_psi[n+1]);
-            float s_q = scale_sin*cos(2*M_PI*d_fDTs*d_m*sin(alpha_n)+d_phi[n+1]);
-#endif
-
-            H += gr_complex(s_i, s_q);
+          d_phase_i[n-1] = d_psi[n+1];
+          d_phase_q[n-1] = d_phi[n+1];
         }
+        if(d_N > 0){
+          d_phase_i[d_N-1] = d_psi[0];
+          d_phase_q[d_N-1] = d_psi[0] - M_PI/2;
+        }
+    }
 
-        if(d_LOS){
-#if FASTSINCOS == 1
-            float los_i = gr::fxpt::cos(gr::fxpt::float_to_fixed(2*M_PI*d_fDTs*d_m*gr::fxpt::cos(gr::fxpt::float_to_fixed(d_theta_los)) + d_psi[0]));
-            float los_q = gr::fxpt::sin(gr::fxpt::float_to_fixed(2*M_PI*d_fDTs*d_m*gr::fxpt::cos(gr::fxpt::float_to_fixed(d_theta_los)) + d_psi[0]));
-#elif FASTSINCOS == 2
-            float los_i = d_table.cos(2*M_PI*d_fDTs*d_m*d_table.cos(d_theta_los) + d_psi[0]);
-            float los_q = d_table.sin(2*M_PI*d_fDTs*d_m*d_table.cos(d_theta_los) + d_psi[0]);
-#else
-            float los_i = cos(2*M_PI*d_fDTs*d_m*cos(d_theta_los) + d_psi[0]);
-            float los_q = sin(2*M_PI*d_fDTs*d_m*cos(d_theta_los) + d_psi[0]);
-#endif
-
-            H = H*scale_nlos + gr_complex(los_i,los_q)*scale_los;
+    int flat_fader_impl::nsinusoids() const
+    {
+        return std::max(d_N-1, 0) + ((d_LOS && d_N > 0) ? 1 : 0);
+    }
+
+    // amplitude of sinusoid k, the LOS one being last
+    float flat_fader_impl::amplitude(int k) const
+    {
+        if(k == d_N-1)
+            return scale_los;
+        return d_LOS ? scale_sin*scale_nlos : scale_sin;
+    }
+
+    // Doppler shifts at the current angle of arrival
+    void flat_fader_impl::update_frequencies()
+    {
+        for(int k=1; k<d_N; k++){
+            double alpha_n = (2*M_PI*k - M_PI + d_theta)/4*d_N;
+            d_w_i[k-1] = 2*M_PI*d_fDTs*cos(alpha_n);
+            d_w_q[k-1] = 2*M_PI*d_fDTs*sin(alpha_n);
+        }
+        if(d_N > 0){
+            d_w_i[d_N-1] = 2*M_PI*d_fDTs*cos(d_theta_los);
+            d_w_q[d_N-1] = d_w_i[d_N-1];
+        }
+    }
+
+    void flat_fader_impl::sum_sinusoids(float *out, std::vector<double> &phase,
+                                        const std::vector<double> &w, int n)
+    {
+        int nsin = nsinusoids();
+
+        // The recursions only run over one block, so they are restarted
+        // from the double precision phases to keep them from drifting.
+        // The amplitudes go into the phasors.
+        for(int k=0; k<nsin; k++){
+            float amp = amplitude(k);
+            d_phasors[k] = gr_complex(amp*cos(phase[k]), amp*sin(phase[k]));
+            d_rotators[k] = gr_complex(cos(w[k]), sin(w[k]));
+            phase[k] = fmod(phase[k] + w[k]*n, 2*M_PI);
+        }
+        volk_32fc_x2_sum_of_sinusoids_32f(out, &d_phasors[0], &d_rotators[0], nsin, n);
+    }
+
+    void flat_fader_impl::next_samples(gr_complex *out, int n)
+    {
+        for(int i=0; i<n; i+=FADER_BLOCK){
+            int c = std::min(n-i, FADER_BLOCK);
+
+            update_frequencies();
+            sum_sinusoids(&d_sum_i[0], d_phase_i, d_w_i, c);
+            sum_sinusoids(&d_sum_q[0], d_phase_q, d_w_q, c);
+            for(int j=0; j<c; j++){
+                out[i+j] = gr_complex(d_sum_i[j], d_sum_q[j]);
             }
 
-        //out[i] = in[i]*H;
-        d_m++;
-        update_theta();
-        return H;
+            d_m += c;
+            update_theta(c);
+        }
+    }
+
+    gr_complex flat_fader_impl::gain() const
+    {
+        double h_i = 0, h_q = 0;
+        for(int k=0; k<nsinusoids(); k++){
+            h_i += amplitude(k)*cos(d_phase_i[k]);
+            h_q += amplitude(k)*cos(d_phase_q[k]);
+        }
+        return gr_complex(h_i, h_q);
+    }
+
+    void flat_fader_impl::advance(int n)
+    {
+        for(int i=0; i<n; i+=FADER_BLOCK){
+            int c = std::min(n-i, FADER_BLOCK);
+
+            update_frequencies();
+            for(int k=0; k<nsinusoids(); k++){
+                d_phase_i[k] = fmod(d_phase_i[k] + d_w_i[k]*c, 2*M_PI);
+                d_phase_q[k] = fmod(d_phase_q[k] + d_w_q[k]*c, 2*M_PI);
+            }
 
+            d_m += c;
+            update_theta(c);
+        }
     }
 
-    void flat_fader_impl::update_theta()
+    void flat_fader_impl::update_theta(int n)
     {
-        d_theta += (d_step*rv_2());
-        if(d_theta > M_PI){
-            d_theta = M_PI; d_step = -d_step;
-        } else if(d_theta < -M_PI){
-            d_theta = -M_PI; d_step = -d_step;
+        // Away from the reflections the walk is a plain sum of steps.
+        // Over long blocks the sum of the uniform variates is drawn
+        // from its normal approximation instead.
+        if(fabs(d_theta) + fabs(d_step)*n < M_PI){
+            if(n >= 64){
+                d_theta += d_step*(0.5*n + sqrt(n/12.0)*d_rng.gasdev());
+            } else {
+                float sum;
+                d_rng.ran1_fill(&d_walk[0], n);
+                volk_32f_accumulator_s32f(&sum, &d_walk[0], n);
+                d_theta += d_step*sum;
+            }
+            return;
+        }
+
+        d_rng.ran1_fill(&d_walk[0], n);
+        for(int i=0; i<n; i++){
+            d_theta += (d_step*d_walk[i]);
+            if(d_theta > M_PI){
+                d_theta = M_PI; d_step = -d_step;
+            } else if(d_theta < -M_PI){
+                d_theta = -M_PI; d_step = -d_step;
+            }
         }
     }
 
   } /* namespace channels */
 } /* namespace gr */
-
@@ -30,11 +30,7 @@
 #include <boost/format.hpp>
 #include <boost/random.hpp>
 
-#include <gnuradio/fxpt.h>
-#include <sincostable.h>
-
-// FASTSINCOS:  0 = slow native,  1 = gr::fxpt impl,  2 = sincostable.h
-#define FASTSINCOS  2
+#include <gnuradio/random.h>
 
 namespace gr {
   namespace channels { 
@@ -46,11 +42,29 @@ namespace gr {
         boost::uniform_real<> dist_1; // U(-pi,pi)
         boost::variate_generator<boost::mt19937&, boost::uniform_real<> > rv_1;
     
-        // random walk variate
-        boost::mt19937 seed_2;
-        boost::uniform_real<> dist_2; // U(-pi,pi)
-        boost::variate_generator<boost::mt19937&, boost::uniform_real<> > rv_2;
-      
+        // random walk variates, U(0,1)
+        gr::random d_rng;
+
+        // phases of the sinusoids, integrated over their frequencies,
+        // with the LOS component last
+        std::vector<double> d_phase_i;
+        std::vector<double> d_phase_q;
+
+        // per block frequencies and scratch space of the recursions
+        std::vector<double> d_w_i;
+        std::vector<double> d_w_q;
+        std::vector<gr_complex> d_phasors;
+        std::vector<gr_complex> d_rotators;
+        std::vector<float> d_sum_i;
+        std::vector<float> d_sum_q;
+        std::vector<float> d_walk;
+
+        int nsinusoids() const;
+        float amplitude(int k) const;
+        void update_frequencies();
+        void sum_sinusoids(float *out, std::vector<double> &phase,
+                           const std::vector<double> &w, int n);
+
       public:
         int d_N; // number of sinusoids
         float d_fDTs;  // normalized maximum doppler frequency
@@ -65,16 +79,30 @@ namespace gr {
         std::vector<float> d_psi; // in-phase initial phase
         std::vector<float> d_phi; // quadrature initial phase
         
-        std::vector<float>  d_costable;
-        
-        sincostable d_table;
-        
         float scale_sin, scale_los, scale_nlos;
     
-        void update_theta();
-    
+        void update_theta(int n);
+
         flat_fader_impl(unsigned int N, float fDTs, bool LOS, float K, int seed);
-        gr_complex next_sample();
+
+        /*!
+         * Generates the next \p n channel gains.  The sinusoids are
+         * generated by phasor recursions in blocks of 1024 samples,
+         * with their frequencies taken from the random walk at the
+         * start of each block.
+         */
+        void next_samples(gr_complex *out, int n);
+
+        /*!
+         * Returns the channel gain at the current sample, which is the
+         * one the next call to next_samples() would start with.
+         */
+        gr_complex gain() const;
+
+        /*!
+         * Advances the fader by \p n samples without generating them.
+         */
+        void advance(int n);
     
     }; /* class flat_fader_impl */
   } /* namespace channels */
@@ -22,7 +22,9 @@
 
 #include "selective_fading_model_impl.h"
 #include <gnuradio/io_signature.h>
+#include <volk/volk.h>
 #include <iostream>
+#include <algorithm>
 
 #include <boost/format.hpp>
 #include <boost/random.hpp>
@@ -64,7 +66,19 @@ namespace gr {
         // set up tap history
         if(ntaps < 1){ throw std::runtime_error("ntaps must be >= 1"); }
         set_history(1+ntaps);
-        d_taps.resize(ntaps, gr_complex(0,0));
+
+        // The taps are the sum of the fading paths, each interpolated
+        // onto the tap grid.  As the interpolation does not change, each
+        // path is filtered on its own and then weighted by its gain.
+        // Taps are stored in input order, taps[k] weighing in[i+k].
+        for(size_t j=0; j<d_faders.size(); j++){
+            std::vector<float> taps(ntaps);
+            for(int k=0; k<ntaps; k++){
+                float dist = k-d_delays[j];
+                taps[ntaps-k-1] = d_sintable.sinc(2*M_PI*dist) * d_mags[j];
+            }
+            d_path_taps.push_back(taps);
+        }
     }
 
     selective_fading_model_impl::~selective_fading_model_impl()
@@ -82,38 +96,41 @@ namespace gr {
         const gr_complex* in = (const gr_complex*) input_items[0];
         gr_complex* out = (gr_complex*) output_items[0];
 
-        // loop over each output sample
-        for(int i=0; i<noutput_items; i++){
-
-            // clear the current values in each tap
-            for(size_t j=0; j<d_taps.size(); j++){
-                d_taps[j] = gr_complex(0,0);
-            }
-            
-            // add each flat fading component to the taps
-            for(size_t j=0; j<d_faders.size(); j++){
-                gr_complex ff_H(d_faders[j]->next_sample());
-                for(size_t k=0; k<d_taps.size(); k++){
-                    float dist = k-d_delays[j];
-                    float interpmag = d_sintable.sinc(2*M_PI*dist);       
-                    d_taps[k] += ff_H * interpmag * d_mags[j];
-                }
-            }
-
-            // apply the taps and generate output
-            gr_complex sum(0,0);
-            for(size_t j=0; j<d_taps.size(); j++){
-                sum += in[i+j] * d_taps[d_taps.size()-j-1];
-            }
+        if((int)d_H.size() < noutput_items){
+            d_H.resize(noutput_items);
+            d_y.resize(noutput_items);
+        }
 
-            // assign output 
-            out[i] = sum;
+        std::fill(out, out+noutput_items, gr_complex(0,0));
+        for(size_t j=0; j<d_faders.size(); j++){
+            d_faders[j]->next_samples(&d_H[0], noutput_items);
+            filter_path(j, in, noutput_items);
+            volk_32fc_x2_multiply_32fc(&d_y[0], &d_y[0], &d_H[0], noutput_items);
+            volk_32f_x2_add_32f((float*)out, (const float*)out, (const float*)&d_y[0], 2*noutput_items);
         }
 
         // return all outputs
         return noutput_items;
     }
 
+    void
+    selective_fading_model_impl::filter_path(size_t j, const gr_complex *in, int n)
+    {
+        // The taps are short, so the filter runs a tap at a time over
+        // the whole block, which keeps the inner loop vectorizable.
+        const std::vector<float> &taps = d_path_taps[j];
+        float *y = (float*)&d_y[0];
+
+        std::fill(d_y.begin(), d_y.begin()+n, gr_complex(0,0));
+        for(size_t k=0; k<taps.size(); k++){
+            const float *x = (const float*)(in+k);
+            const float c = taps[k];
+            for(int m=0; m<2*n; m++){
+                y[m] += c*x[m];
+            }
+        }
+    }
+
     void
     selective_fading_model_impl::setup_rpc()
     {
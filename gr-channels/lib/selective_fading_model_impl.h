@@ -45,6 +45,13 @@ namespace gr {
       std::vector<float> d_mags;
       sincostable d_sintable;
 
+      // fixed interpolation filter of each path, scaled by its magnitude
+      std::vector<std::vector<float> > d_path_taps;
+      std::vector<gr_complex> d_H;
+      std::vector<gr_complex> d_y;
+
+      void filter_path(size_t j, const gr_complex *in, int n);
+
     public:
       selective_fading_model_impl(unsigned int N, float fDTs, bool LOS, float K, int seed, std::vector<float> delays, std::vector<float> mags, int ntaps);
       ~selective_fading_model_impl();
@@ -52,7 +59,6 @@ namespace gr {
       int work (int noutput_items,
             gr_vector_const_void_star &input_items,
             gr_vector_void_star &output_items);
-      std::vector<gr_complex> d_taps;
 
       virtual float fDTs(){ return d_faders[0]->d_fDTs; }
       virtual float K(){ return d_faders[0]->d_K; }
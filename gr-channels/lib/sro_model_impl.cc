@@ -53,8 +53,7 @@ namespace gr {
 	d_mu (0.0), d_mu_inc (1.0), d_sro(0.0), d_samp_rate(sample_rate_hz),
     d_max_dev_hz(max_dev_hz), d_std_dev_hz(std_dev_hz),
 	d_interp(new gr::filter::mmse_fir_interpolator_cc()),
-    d_noise(gr::analog::fastnoise_source_f::make(analog::GR_GAUSSIAN, std_dev_hz, noise_seed)),
-    d_noise_seed(noise_seed)
+    d_rng((long)noise_seed)
     {
       //set_relative_rate(1.0 / interp_ratio);
       set_relative_rate(1.0);
@@ -88,10 +87,13 @@ namespace gr {
       int ii = 0; // input index
       int oo = 0; // output index
 
+      d_noise.resize(noutput_items);
+      d_rng.gasdev_fill(&d_noise[0], noutput_items);
+
       while(oo < noutput_items) {
 
     // perform sample rate offset update
-    d_sro += d_noise->sample_unbiased();
+    d_sro += d_std_dev_hz * d_noise[oo];
     d_sro = std::min(d_sro, d_max_dev_hz);
     d_sro = std::max(d_sro, -d_max_dev_hz);
     d_mu_inc = 1.0 + d_sro/d_samp_rate;
@@ -25,7 +25,7 @@
 
 #include <gnuradio/filter/fractional_interpolator_cc.h>
 #include <gnuradio/filter/mmse_fir_interpolator_cc.h>
-#include <gnuradio/analog/fastnoise_source_f.h>
+#include <gnuradio/random.h>
 #include <gnuradio/channels/sro_model.h>
 
 namespace gr {
@@ -42,8 +42,8 @@ namespace gr {
       float d_max_dev_hz;
       float d_std_dev_hz;
       gr::filter::mmse_fir_interpolator_cc *d_interp;
-      gr::analog::fastnoise_source_f::sptr d_noise;
-      double d_noise_seed;
+      gr::random d_rng;
+      std::vector<float> d_noise;
 
     public:
       sro_model_impl(
@@ -66,7 +66,7 @@ namespace gr {
       void set_interp_ratio(float interp_ratio);
       void setup_rpc();
 
-      void set_std_dev(double _dev){ d_std_dev_hz = _dev; d_noise = gr::analog::fastnoise_source_f::make(analog::GR_GAUSSIAN, _dev, d_noise_seed); }
+      void set_std_dev(double _dev){ d_std_dev_hz = _dev; }
       void set_max_dev(double _dev){ d_max_dev_hz = _dev; }
       void set_samp_rate(double _rate){ d_samp_rate = _rate; }
 
@@ -21,7 +21,55 @@
 #
 
 from gnuradio import gr, gr_unittest, analog, blocks, channels
-import math
+import math, random
+
+def old_fader(N, fDTs, LOS, K, n):
+    # The per-sample model the fader used to evaluate: the Doppler
+    # shifts at the current angle times the sample count
+    theta = random.uniform(-math.pi, math.pi)
+    theta_los = random.uniform(-math.pi, math.pi)
+    psi = [0]*(N+1)
+    phi = [0]*(N+1)
+    for i in range(N+1):
+        psi[i] = random.uniform(-math.pi, math.pi)
+        phi[i] = random.uniform(-math.pi, math.pi)
+    step = (0.00125*fDTs)**1.1
+    scale_sin = math.sqrt(2.0/N)
+    scale_los = math.sqrt(K)/math.sqrt(K+1)
+    scale_nlos = 1/math.sqrt(K+1)
+
+    h = []
+    for m in range(n):
+        H = 0j
+        for k in range(1, N):
+            alpha = (2*math.pi*k - math.pi + theta)/4*N
+            H += complex(scale_sin*math.cos(2*math.pi*fDTs*m*math.cos(alpha) + psi[k+1]),
+                         scale_sin*math.cos(2*math.pi*fDTs*m*math.sin(alpha) + phi[k+1]))
+        if LOS:
+            x = 2*math.pi*fDTs*m*math.cos(theta_los) + psi[0]
+            H = H*scale_nlos + complex(math.cos(x), math.sin(x))*scale_los
+        h.append(H)
+        theta += step*random.random()
+        if theta > math.pi:
+            theta = math.pi; step = -step
+        elif theta < -math.pi:
+            theta = -math.pi; step = -step
+    return h
+
+def fading_stats(gains, lags):
+    # power, E|h|^4/P^2, fraction of deep fades and the normalized
+    # autocorrelation at the lags, over all the gain sequences
+    p = p2 = deep = n = 0
+    r = [0]*len(lags)
+    for h in gains:
+        for v in h:
+            a = v.real*v.real + v.imag*v.imag
+            p += a; p2 += a*a; n += 1
+            if a < 0.1:
+                deep += 1
+        for i, l in enumerate(lags):
+            r[i] += sum((h[t+l]*h[t].conjugate()).real for t in range(len(h)-l))*len(h)/float(len(h)-l)
+    return p/n, p2*n/(p*p), deep/float(n), [x/p for x in r]
 
 class test_fading_model(gr_unittest.TestCase):
 
@@ -55,6 +103,45 @@ class test_fading_model(gr_unittest.TestCase):
         #dst_data = snk.data()
         #exp_data = snk1.data()
         #self.assertComplexTuplesAlmostEqual(exp_data, dst_data, 5)
-        
+
+    def run_statistics(self, LOS):
+        # The envelope and autocorrelation of the gains, over an
+        # ensemble of seeds, against those of the old model.  The
+        # tolerances are about four times the spread between ensembles.
+        N = 8
+        fDTs = 0.05
+        K = 4
+        nseeds = 400
+        n = 1000
+        lags = (1, 2, 4)    # fD*tau = 0.05, 0.1, 0.2
+
+        gains = []
+        for seed in range(nseeds):
+            self.tb = gr.top_block()
+            src = blocks.vector_source_c([1+0j]*n)
+            op = channels.fading_model(N, fDTs=fDTs, LOS=LOS, K=K, seed=seed)
+            snk = blocks.vector_sink_c()
+            self.tb.connect(src, op, snk)
+            self.tb.run()
+            gains.append(snk.data())
+        self.assertEqual(n, len(gains[-1]))
+
+        random.seed(0)
+        old_gains = [old_fader(N, fDTs, LOS, K, n) for seed in range(nseeds)]
+
+        p, kurt, deep, r = fading_stats(gains, lags)
+        old_p, old_kurt, old_deep, old_r = fading_stats(old_gains, lags)
+        self.assertTrue(abs(p - old_p) < 0.2*old_p)
+        self.assertTrue(abs(kurt - old_kurt) < 0.25)
+        self.assertTrue(abs(deep - old_deep) < 0.02)
+        for x, y, tol in zip(r, old_r, (0.005, 0.015, 0.06)):
+            self.assertTrue(abs(x - y) < tol)
+
+    def test_001_statistics_rayleigh(self):
+        self.run_statistics(False)
+
+    def test_002_statistics_rician(self):
+        self.run_statistics(True)
+
 if __name__ == '__main__':
     gr_unittest.run(test_fading_model, "test_fading_model.xml")
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest, blocks, channels
+import random
+
+class test_fft_selective_fading_model(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_model(self, op, src_data):
+        src = blocks.vector_source_c(src_data)
+        dst = blocks.vector_sink_c()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        return dst.data()
+
+    def test_001_static(self):
+        # Without Doppler the channel is a fixed filter: every impulse
+        # gets the same response, and random data is convolved with it
+        ntaps = 16
+        op = channels.fft_selective_fading_model(8, 0.0, False, 4.0, 3,
+                                                 (0.0, 2.5, 7.0), (1.0, 0.5, 0.25), ntaps)
+        nsamples = op.fft_size() - ntaps + 1
+        n = 8*nsamples
+
+        impulses = [0j]*n
+        for i in range(0, n - ntaps, 100):
+            impulses[i] = 1
+        result = self.run_model(op, impulses)
+        self.assertEqual(n, len(result))
+        h = result[0:ntaps]
+        for i in range(100, n - ntaps, 100):
+            self.assertComplexTuplesAlmostEqual(h, result[i:i+ntaps], 5)
+
+        random.seed(0)
+        x = [complex(random.uniform(-1, 1), random.uniform(-1, 1)) for i in range(n)]
+        self.tb = gr.top_block()
+        op = channels.fft_selective_fading_model(8, 0.0, False, 4.0, 3,
+                                                 (0.0, 2.5, 7.0), (1.0, 0.5, 0.25), ntaps)
+        result = self.run_model(op, x)
+        expected = [sum(h[k]*x[i-k] for k in range(ntaps) if i >= k) for i in range(n)]
+        self.assertComplexTuplesAlmostEqual(expected, result, 4)
+
+    def test_002_integer_delay(self):
+        # A single ray on a whole sample falls on one tap
+        ntaps = 32
+        op = channels.fft_selective_fading_model(8, 0.0, False, 4.0, 1,
+                                                 (5.0,), (1.0,), ntaps)
+        n = 4*(op.fft_size() - ntaps + 1)
+        random.seed(1)
+        x = [complex(random.uniform(-1, 1), random.uniform(-1, 1)) for i in range(n)]
+        result = self.run_model(op, x)
+        g = result[5] / x[0]
+        expected = [0j]*5 + [g*v for v in x[:n-5]]
+        self.assertComplexTuplesAlmostEqual(expected, result, 4)
+
+    def test_003_fading(self):
+        # With Doppler the gain changes, smoothly across the blocks
+        ntaps = 8
+        op = channels.fft_selective_fading_model(8, 0.01, True, 4.0, 0,
+                                                 (0.0,), (1.0,), ntaps)
+        n = 64*(op.fft_size() - ntaps + 1)
+        result = self.run_model(op, [1+0j]*n)
+        self.assertEqual(n, len(result))
+        g = result[ntaps:]
+        self.assertTrue(max(abs(a - b) for a, b in zip(g[1:], g[:-1])) < 0.3)
+        self.assertTrue(max(abs(v) for v in g) - min(abs(v) for v in g) > 0.1)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_fft_selective_fading_model, "test_fft_selective_fading_model.xml")
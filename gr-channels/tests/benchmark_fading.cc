@@ -0,0 +1,139 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Runs gr::channels::fading_model with 8 to 64 sinusoids, and
+ * gr::channels::selective_fading_model with 1 to 8 paths of 8
+ * sinusoids each over 4 to 16 taps, and prints the throughput of each.
+ * Then runs a 24 ray profile over 64 to 1024 taps through
+ * gr::channels::fft_selective_fading_model and, up to 256 taps,
+ * through gr::channels::selective_fading_model.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <gnuradio/channels/fading_model.h>
+#include <gnuradio/channels/fft_selective_fading_model.h>
+#include <gnuradio/channels/selective_fading_model.h>
+
+#define NSAMPLES (4*1024*1024)
+#define CHUNK 8192
+#define NRAYS 24
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+// Calls the block's work function about CHUNK samples at a time, with
+// history samples ahead of each chunk, and returns samples per second
+static double
+run(gr::sync_block &blk, const std::vector<gr_complex> &in, int history)
+{
+  const int chunk = std::max(CHUNK / blk.output_multiple(), 1) * blk.output_multiple();
+  std::vector<gr_complex> out(chunk);
+  gr_vector_const_void_star input_items(1);
+  gr_vector_void_star output_items(1);
+  int n = 0;
+
+  output_items[0] = &out[0];
+  double start = cpu_time();
+  for(int i = 0; i + chunk + history <= (int)in.size(); i += chunk) {
+    input_items[0] = &in[i];
+    n += blk.work(chunk, input_items, output_items);
+  }
+  return n / (cpu_time() - start);
+}
+
+int
+main(int argc, char **argv)
+{
+  std::vector<gr_complex> in(NSAMPLES + 1024);
+  for(size_t i = 0; i < in.size(); i++)
+    in[i] = gr_complex(rand() / (float)RAND_MAX - 0.5f, rand() / (float)RAND_MAX - 0.5f);
+
+  for(unsigned int N = 8; N <= 64; N *= 2) {
+    gr::channels::fading_model::sptr flat =
+      gr::channels::fading_model::make(N, 0.01, true, 4, 0);
+    printf("flat       N %2u                    %8.2f Msps\n", N, run(*flat, in, 0)*1e-6);
+  }
+
+  for(unsigned int npaths = 1; npaths <= 8; npaths *= 2) {
+    for(int ntaps = 4; ntaps <= 16; ntaps *= 2) {
+      std::vector<float> delays, mags;
+      for(unsigned int j = 0; j < npaths; j++) {
+        delays.push_back(j * (ntaps - 1) / (float)npaths);
+        mags.push_back(1.0 / (j + 1));
+      }
+      gr::channels::selective_fading_model::sptr sel =
+        gr::channels::selective_fading_model::make(8, 0.01, true, 4, 0, delays, mags, ntaps);
+      printf("selective  N  8 %u paths %2d taps  %8.2f Msps\n",
+             npaths, ntaps, run(*sel, in, ntaps)*1e-6);
+    }
+  }
+
+  // Exponentially decaying power delay profile spread over the taps
+  for(int ntaps = 64; ntaps <= 1024; ntaps *= 2) {
+    std::vector<float> delays, mags;
+    for(int j = 0; j < NRAYS; j++) {
+      delays.push_back(j * (ntaps - 16) / (float)NRAYS);
+      mags.push_back(exp(-j / 8.0));
+    }
+    gr::channels::fft_selective_fading_model::sptr fft =
+      gr::channels::fft_selective_fading_model::make(8, 1e-4, true, 4, 0, delays, mags, ntaps);
+    printf("fft        N  8 %u rays %4d taps %8.2f Msps  (fft size %d)\n",
+           NRAYS, ntaps, run(*fft, in, ntaps)*1e-6, fft->fft_size());
+    if(ntaps <= 256) {
+      gr::channels::selective_fading_model::sptr sel =
+        gr::channels::selective_fading_model::make(8, 1e-4, true, 4, 0, delays, mags, ntaps);
+      printf("selective  N  8 %u rays %4d taps %8.2f Msps\n",
+             NRAYS, ntaps, run(*sel, in, ntaps)*1e-6);
+    }
+  }
+
+  return 0;
+}
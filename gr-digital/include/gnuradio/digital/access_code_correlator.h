@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_ACCESS_CODE_CORRELATOR_H
+#define INCLUDED_DIGITAL_ACCESS_CODE_CORRELATOR_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/types.h>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Searches packed bits for one or more access codes
+     * \ingroup packet_operators_blk
+     *
+     * \details
+     * The input holds 8 bits per byte, MSB first. Every bit position
+     * is compared with every access code at once: each byte is
+     * matched against the codes shifted to all eight bit offsets
+     * with the volk_8u_x2_hamming_8u kernel, which counts the
+     * differing bits a byte at a time (with PSHUFB where available).
+     * The codes may have any length; Hamming distances saturate at
+     * 255, so the threshold must be below that.
+     */
+    class DIGITAL_API access_code_correlator
+    {
+    public:
+      //! A position where an access code matched
+      struct hit_t {
+	size_t byte;		//!< Byte holding the first bit after the code
+	unsigned int bit;	//!< That bit, 0 is the MSB
+	unsigned int code;	//!< Index of the access code
+	unsigned int nwrong;	//!< Number of differing bits
+
+	bool operator<(const hit_t &other) const;
+      };
+
+    private:
+      std::vector<unsigned int> d_lengths;
+      std::vector<unsigned int> d_nbytes;
+      std::vector<std::vector<unsigned char> > d_tables;
+      std::vector<unsigned char> d_dist;
+      unsigned int d_threshold;
+      unsigned int d_history;
+
+    public:
+      /*!
+       * \param access_codes the codes, 1 byte per bit,
+       *                     e.g., "010101010111000100"
+       * \param threshold maximum number of bits that may be wrong
+       */
+      access_code_correlator(const std::vector<std::string> &access_codes,
+			     unsigned int threshold);
+      ~access_code_correlator();
+
+      /*!
+       * \brief Finds the access codes ending in \p nbytes bytes.
+       *
+       * \p in points to history() bytes preceding the bytes that are
+       * searched, so that codes may straddle the previous call. The
+       * hits, with \p byte counted from the first searched byte, are
+       * appended to \p hits in stream order.
+       */
+      void correlate(const unsigned char *in, size_t nbytes,
+		     std::vector<hit_t> &hits);
+
+      //! Bytes needed before the searched bytes
+      unsigned int history() const { return d_history; }
+
+      size_t num_codes() const { return d_lengths.size(); }
+      unsigned int code_length(size_t i) const { return d_lengths[i]; }
+      unsigned int threshold() const { return d_threshold; }
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_ACCESS_CODE_CORRELATOR_H */
@@ -0,0 +1,157 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_ADAPTIVE_EQUALIZER_H
+#define INCLUDED_DIGITAL_ADAPTIVE_EQUALIZER_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+    class fft_complex;
+  }
+
+  namespace digital {
+
+    /*!
+     * \brief Adaptive FIR equalizer with optional decision feedback
+     * and block updates
+     * \ingroup equalizers_blk
+     *
+     * \details
+     * For symbol n, with x the input starting at sample n * sps(),
+     *
+     *   y[n] = sum_k taps[k] * x[k]
+     *        + sum_m feedback_taps[m] * decision[n-1-m]
+     *
+     * so the last tap goes with the newest sample and the first
+     * feedback tap with the newest decision.  The derived class
+     * supplies the error criterion through step(), which also returns
+     * the decision for y[n]; the taps then move along conj(x) times
+     * the step, using volk_32fc_x2_s32fc_multiply_conjugate_add_32fc.
+     *
+     * With a block size of 1 the taps are updated after every symbol.
+     * With a larger block size B they are held over B symbols and
+     * updated once with the sum of the B gradients (block LMS).  The
+     * feed-forward part of a block is then a fixed filter, and so is
+     * the correlation that gives the gradient; for long equalizers
+     * both are done with FFTs.  In AUTO mode an operation count
+     * decides.
+     */
+    class DIGITAL_API adaptive_equalizer
+    {
+    public:
+      enum mode_t {
+	AUTO,
+	DIRECT,
+	FFT
+      };
+
+    private:
+      unsigned int d_ntaps;
+      unsigned int d_nfb;
+      unsigned int d_sps;
+      unsigned int d_block;
+      mode_t d_mode;
+      gr_complex *d_taps;
+      gr_complex *d_fb_taps;
+      gr_complex *d_fb_grad;
+      gr_complex *d_decisions;
+      unsigned int d_decision_pos;
+      gr_complex *d_ff;
+      gr_complex *d_steps;
+      fft::fft_complex *d_fwdfft;
+      fft::fft_complex *d_invfft;
+      unsigned int d_fftsize;
+      gr_complex *d_xformed_in;
+
+      void plan();
+      gr_complex feedback() const;
+      void push_decision(const gr_complex &decision);
+      void equalize_symbols(const gr_complex *in, gr_complex *out,
+			    unsigned int n);
+      void equalize_block(const gr_complex *in, gr_complex *out,
+			  unsigned int n);
+      void filter_fft(const gr_complex *in, unsigned int n);
+      void update_fft(unsigned int n);
+
+    protected:
+      /*!
+       * \brief Error criterion of the equalizer.
+       *
+       * Returns the step for output \p out: the taps move by
+       * conj(x) * step.  \p decision receives the symbol that is fed
+       * back; criteria that make no decision can leave \p out there.
+       */
+      virtual gr_complex step(const gr_complex &out,
+			      gr_complex &decision) = 0;
+
+    public:
+      /*!
+       * \param ntaps number of feed-forward taps
+       * \param sps input samples per symbol
+       * \param nfb number of feedback taps
+       */
+      adaptive_equalizer(unsigned int ntaps, unsigned int sps,
+			 unsigned int nfb = 0);
+      virtual ~adaptive_equalizer();
+
+      void set_taps(const std::vector<gr_complex> &taps);
+      std::vector<gr_complex> taps() const;
+      void set_feedback_taps(const std::vector<gr_complex> &taps);
+      std::vector<gr_complex> feedback_taps() const;
+
+      //! Clears the past decisions
+      void reset_decisions();
+
+      /*!
+       * \brief Sets the number of symbols between tap updates and how
+       * to filter the blocks.
+       */
+      void set_block_size(unsigned int block_size, mode_t mode = AUTO);
+
+      /*!
+       * \brief Equalizes \p n symbols.
+       *
+       * \p in holds (n - 1) * sps() + ntaps() samples.  When \p n is
+       * not a multiple of block_size(), the last block is shorter.
+       */
+      void equalize(const gr_complex *in, gr_complex *out, unsigned int n);
+
+      unsigned int ntaps() const { return d_ntaps; }
+      unsigned int num_feedback_taps() const { return d_nfb; }
+      unsigned int sps() const { return d_sps; }
+      unsigned int block_size() const { return d_block; }
+
+      //! True if blocks are filtered with the FFT
+      bool use_fft() const { return d_fwdfft != 0; }
+
+      //! FFT size, 0 when filtering directly
+      unsigned int fft_size() const { return d_fftsize; }
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_ADAPTIVE_EQUALIZER_H */
@@ -43,6 +43,10 @@ namespace gr {
      *    G. R. Danesfahani, T.G. Jeans, "Optimisation of modified Mueller
      *    and Muller algorithm," Electronics Letters, Vol. 31, no. 13, 22
      *    June 1995, pp. 1032 - 1033.
+     *
+     * The loop can update every few symbols instead of after each
+     * one (see set_loop_decimation()); the symbols between updates
+     * are then interpolated together by a symbol_interpolator.
      */
     class DIGITAL_API clock_recovery_mm_cc : virtual public block
     {
@@ -73,6 +77,16 @@ namespace gr {
       virtual void set_gain_omega (float gain_omega) = 0;
       virtual void set_mu (float mu) = 0;
       virtual void set_omega (float omega) = 0;
+
+      /*!
+       * \brief Sets the number of symbols between loop updates.
+       *
+       * Omega and the mu correction are held over \p decimation
+       * symbols and then updated once with the sum of their errors.
+       * The default of 1 updates after every symbol.
+       */
+      virtual void set_loop_decimation(int decimation) = 0;
+      virtual int loop_decimation() const = 0;
     };
 
   } /* namespace digital */
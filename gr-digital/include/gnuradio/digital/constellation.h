@@ -80,6 +80,21 @@ namespace gr {
       unsigned int decision_maker_v(std::vector<gr_complex> sample);
       //! Also calculates the phase error.
       unsigned int decision_maker_pe(const gr_complex *sample, float *phase_error);
+
+      /*!
+       * \brief Returns the best matching points for \p nsymbols symbols.
+       *
+       * \details
+       * \p samples holds nsymbols*dimensionality() samples. The
+       * result for each symbol is the same as from decision_maker,
+       * but subclasses decide on the whole batch at once: distances
+       * to all points with volk_32fc_x2_square_dist_32f, grid
+       * slicing for rectangular constellations and sector tables
+       * for PSK.
+       */
+      virtual void decision_maker_n(const gr_complex *samples,
+                                    unsigned int *decisions,
+                                    unsigned int nsymbols);
       //! Calculates distance.
       //unsigned int decision_maker_e(const gr_complex *sample, float *error);
   
@@ -197,6 +212,22 @@ namespace gr {
        */
       std::vector<float> soft_decision_maker(gr_complex sample);
 
+      /*! \brief Returns the soft decisions for \p nsymbols samples.
+       *
+       * \details Writes bits_per_symbol() soft decisions per
+       * sample to \p llrs. If a LUT is defined for the object, the
+       * decisions are taken from there. Otherwise they are the
+       * values #calc_soft_dec gives for each sample and \p npwr,
+       * computed from a buffer of distances.
+       *
+       * \param samples The complex samples to get the soft decisions.
+       * \param llrs The soft decisions, most significant bit first.
+       * \param nsymbols The number of samples.
+       * \param npwr Estimate of the noise power (if known).
+       */
+      void soft_decision_maker_n(const gr_complex *samples, float *llrs,
+                                 unsigned int nsymbols, float npwr=1.0);
+
 
     protected:
       std::vector<gr_complex> d_constellation;
@@ -215,6 +246,7 @@ namespace gr {
       float d_lut_scale;
 
       float get_distance(unsigned int index, const gr_complex *sample);
+      const std::vector<float> &soft_dec_lut_entry(gr_complex sample);
       unsigned int get_closest_point(const gr_complex *sample);
       void calc_arity();
 
@@ -232,7 +264,9 @@ namespace gr {
      * \details
      * Constellation which calculates the distance to each point in the
      * constellation for decision making. Inefficient for large
-     * constellations.
+     * constellations, unless the points form a complete rectangular
+     * grid (e.g. square QAM): then the nearest point is found by
+     * rounding each axis to the grid.
      */
     class DIGITAL_API constellation_calcdist
       : public constellation
@@ -255,6 +289,9 @@ namespace gr {
 		       unsigned int dimensionality);
 
       unsigned int decision_maker(const gr_complex *sample);
+      void decision_maker_n(const gr_complex *samples,
+                            unsigned int *decisions,
+                            unsigned int nsymbols);
       // void calc_metric(gr_complex *sample, float *metric, trellis_metric_type_t type);
       // void calc_euclidean_metric(gr_complex *sample, float *metric);
       // void calc_hard_symbol_metric(gr_complex *sample, float *metric);
@@ -264,6 +301,16 @@ namespace gr {
 			     std::vector<int> pre_diff_code,
 			     unsigned int rotational_symmetry,
 			     unsigned int dimensionality);
+
+    private:
+      //! Point index for each grid position, empty if there is no grid
+      std::vector<unsigned int> d_grid;
+      unsigned int d_grid_n_real, d_grid_n_imag;
+      float d_grid_real0, d_grid_imag0;
+      float d_grid_inv_step_real, d_grid_inv_step_imag;
+
+      void find_grid();
+      inline unsigned int grid_point(const gr_complex &sample) const;
     };
 
 
@@ -302,9 +349,16 @@ namespace gr {
       ~constellation_sector();
 
       unsigned int decision_maker(const gr_complex *sample);
+      void decision_maker_n(const gr_complex *samples,
+                            unsigned int *decisions,
+                            unsigned int nsymbols);
 
     protected:
       virtual unsigned int get_sector(const gr_complex *sample) = 0;
+      //! Sectors of \p nsymbols samples, by default one get_sector call each.
+      virtual void get_sectors(const gr_complex *samples,
+                               unsigned int *sectors,
+                               unsigned int nsymbols);
       virtual unsigned int calc_sector_value(unsigned int sector) = 0;
       void find_sector_values();
 
@@ -370,6 +424,9 @@ namespace gr {
 			 float width_imag_sectors);
 
       unsigned int get_sector(const gr_complex *sample);
+      void get_sectors(const gr_complex *samples,
+                       unsigned int *sectors,
+                       unsigned int nsymbols);
       gr_complex calc_sector_center(unsigned int sector);
       unsigned int calc_sector_value(unsigned int sector);
 
@@ -378,6 +435,10 @@ namespace gr {
       unsigned int n_imag_sectors;
       float d_width_real_sectors;
       float d_width_imag_sectors;
+      float d_inv_width_real_sectors;
+      float d_inv_width_imag_sectors;
+
+      inline unsigned int slice(const gr_complex &sample) const;
     };
 
 
@@ -466,12 +527,22 @@ namespace gr {
 
     protected:
       unsigned int get_sector(const gr_complex *sample);
+      void get_sectors(const gr_complex *samples,
+                       unsigned int *sectors,
+                       unsigned int nsymbols);
   
       unsigned int calc_sector_value(unsigned int sector);
 
       constellation_psk(std::vector<gr_complex> constell,
 			std::vector<int> pre_diff_code,
 			unsigned int n_sectors);
+
+    private:
+      //! Directions of the sector boundaries, (n_sectors+1) pairs of cos and sin
+      std::vector<float> d_boundaries;
+      float d_inv_width;
+
+      inline unsigned int slice(const gr_complex &sample) const;
     };
 
 
@@ -502,6 +573,9 @@ namespace gr {
       ~constellation_bpsk();
 
       unsigned int decision_maker(const gr_complex *sample);
+      void decision_maker_n(const gr_complex *samples,
+                            unsigned int *decisions,
+                            unsigned int nsymbols);
 
     protected:
       constellation_bpsk();
@@ -537,6 +611,9 @@ namespace gr {
       ~constellation_qpsk();
 
       unsigned int decision_maker(const gr_complex *sample);
+      void decision_maker_n(const gr_complex *samples,
+                            unsigned int *decisions,
+                            unsigned int nsymbols);
 
     protected:
       constellation_qpsk();
@@ -572,6 +649,9 @@ namespace gr {
       ~constellation_dqpsk();
 
       unsigned int decision_maker(const gr_complex *sample);
+      void decision_maker_n(const gr_complex *samples,
+                            unsigned int *decisions,
+                            unsigned int nsymbols);
 
     protected:
       constellation_dqpsk();
@@ -609,6 +689,9 @@ namespace gr {
       ~constellation_8psk();
 
       unsigned int decision_maker(const gr_complex *sample);
+      void decision_maker_n(const gr_complex *samples,
+                            unsigned int *decisions,
+                            unsigned int nsymbols);
 
     protected:
       constellation_8psk();
@@ -37,7 +37,9 @@ namespace gr {
      * \details
      * Decode a constellation's points from a complex space to soft
      * bits based on the map and soft decision LUT of the \p
-     * consetllation object.
+     * consetllation object. Without a LUT, the soft bits are those
+     * of constellation::calc_soft_dec, computed for a whole buffer by
+     * constellation::soft_decision_maker_n.
      */
     class DIGITAL_API constellation_soft_decoder_cf
       : virtual public sync_interpolator
@@ -0,0 +1,73 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CORRELATE_ACCESS_CODE_PACKED_TAG_BB_H
+#define INCLUDED_DIGITAL_CORRELATE_ACCESS_CODE_PACKED_TAG_BB_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/sync_block.h>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Examine packed input for one or more access codes.
+     * \ingroup packet_operators_blk
+     *
+     * \details
+     * input:  stream of packed bits, 8 bits per byte, MSB first
+     * output: unaltered stream of bytes (plus tags)
+     *
+     * This is the packed counterpart of correlate_access_code_tag_bb,
+     * searching all eight bit positions of each byte at once (see
+     * access_code_correlator). The access codes may be longer than 64
+     * bits.
+     *
+     * A tag with key [tag_name] is put on the byte holding the first
+     * bit after a matching code. Its value is a dictionary with
+     * "code", the index of the access code, "nwrong", the number of
+     * wrong bits, and "bit", the position of that first bit in the
+     * byte (0 is the MSB).
+     */
+    class DIGITAL_API correlate_access_code_packed_tag_bb : virtual public sync_block
+    {
+    public:
+      // gr::digital::correlate_access_code_packed_tag_bb::sptr
+      typedef boost::shared_ptr<correlate_access_code_packed_tag_bb> sptr;
+
+      /*!
+       * \param access_codes the codes, each represented with 1 byte
+       *                     per bit, e.g., "010101010111000100"
+       * \param threshold maximum number of bits that may be wrong
+       * \param tag_name key of the tag inserted into the tag stream
+       */
+      static sptr make(const std::vector<std::string> &access_codes,
+		       int threshold,
+		       const std::string &tag_name);
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_CORRELATE_ACCESS_CODE_PACKED_TAG_BB_H */
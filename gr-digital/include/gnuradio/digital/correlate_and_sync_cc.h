@@ -52,6 +52,8 @@ namespace gr {
      * The preamble is provided as a set of symbols along with a
      * baseband matched filter which we use to create the filtered and
      * upsampled symbol that we will receive over-the-air.
+     * Long preambles are correlated in the frequency domain (see
+     * gr::digital::preamble_correlator).
      *
      * The phase_est tag is used to adjust the phase estimation of any
      * downstream synchronization blocks and is currently used by the
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CORRELATE_AND_SYNC_MULTI_CC_H
+#define INCLUDED_DIGITAL_CORRELATE_AND_SYNC_MULTI_CC_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Correlate to several preambles at several frequency
+     * offsets and send time/phase sync info
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * Input:
+     * \li Stream of complex samples.
+     *
+     * Output:
+     * \li Output stream that just passes the input complex samples
+     * \li Optional: the correlation of the best hypothesis
+     * \li tag 'phase_est': estimate of phase offset
+     * \li tag 'time_est': estimate of symbol timing offset
+     * \li tag 'corr_est': the correlation magnitude squared
+     * \li tag 'preamble': index of the detected preamble
+     * \li tag 'freq_est': the frequency offset hypothesis, rad/sample
+     *
+     * Like gr::digital::correlate_and_sync_cc, but every preamble is
+     * searched at every frequency offset in \p freq_offsets.  All
+     * hypotheses share one forward FFT per block of input (see
+     * gr::digital::preamble_correlator).  The correlations are
+     * normalized to the detection threshold of their preamble, and
+     * at every sample the strongest one is used for the detection
+     * and the tags.  The preambles may have different lengths;
+     * their correlation peaks at their last sample.
+     */
+    class DIGITAL_API correlate_and_sync_multi_cc : virtual public sync_block
+    {
+     public:
+      typedef boost::shared_ptr<correlate_and_sync_multi_cc> sptr;
+
+      /*!
+       * Make a block that correlates against every vector in \p
+       * symbols and outputs phase and symbol timing estimates.
+       *
+       * \param symbols      The preambles to correlate against
+       * \param filter       Baseband matched filter (e.g., RRC)
+       * \param sps          Samples per symbol
+       * \param freq_offsets Frequency offsets to search, in rad/sample
+       * \param nfilts       Number of filters in the internal PFB
+       */
+      static sptr make(const std::vector<std::vector<gr_complex> > &symbols,
+                       const std::vector<float> &filter,
+                       unsigned int sps,
+                       const std::vector<float> &freq_offsets = std::vector<float>(1, 0),
+                       unsigned int nfilts=32);
+
+      virtual size_t num_preambles() const = 0;
+      virtual std::vector<float> freq_offsets() const = 0;
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_CORRELATE_AND_SYNC_MULTI_CC_H */
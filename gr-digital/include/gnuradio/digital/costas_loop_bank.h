@@ -0,0 +1,98 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_COSTAS_LOOP_BANK_H
+#define INCLUDED_DIGITAL_COSTAS_LOOP_BANK_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/types.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Runs many independent Costas loops or PLLs side by side
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * The loops follow gr::digital::costas_loop_cc (order 2, 4 or 8)
+     * or, for order 1, a PLL on an unmodulated carrier with the phase
+     * of the derotated sample as error, like
+     * gr::analog::pll_carriertracking_cc.  All loops share the gains
+     * and the frequency limits.
+     *
+     * The feedback keeps a single loop from being vectorized, but
+     * separate loops are: the phases and frequencies are stored one
+     * array per quantity and volk_32fc_s32f_x2_costas_loop_32fc
+     * advances several loops per SIMD register.  The NCO keeps the
+     * phase as a fixed point angle, which wraps by itself, and takes
+     * sin and cos from the table of gr::fxpt.
+     */
+    class DIGITAL_API costas_loop_bank
+    {
+    private:
+      unsigned int d_nchan;
+      int d_order;
+      gr_int32 *d_phase;
+      float *d_freq;
+      float d_gains[4];
+      float *d_freq_out;
+      unsigned int d_freq_out_len;
+
+    public:
+      /*!
+       * \param nchan number of loops
+       * \param order 1 for a PLL, or 2, 4 or 8 for a Costas loop
+       */
+      costas_loop_bank(unsigned int nchan, int order);
+      ~costas_loop_bank();
+
+      //! Sets the gains and the frequency limits of all loops
+      void set_gains(float alpha, float beta, float min_freq, float max_freq);
+
+      /*!
+       * \brief Runs all loops over \p nsteps steps.
+       *
+       * \p in and \p out hold nchan() samples per step, one of each
+       * loop.  If \p freq_out is not NULL, it receives the frequency
+       * of every loop after every step in the same order.
+       */
+      void process(const gr_complex *in, gr_complex *out, float *freq_out,
+		   unsigned int nsteps);
+
+      //! Resets all loops to phase and frequency 0
+      void reset();
+
+      float phase(unsigned int chan) const;
+      void set_phase(unsigned int chan, float phase);
+      float frequency(unsigned int chan) const;
+      void set_frequency(unsigned int chan, float freq);
+
+      unsigned int nchan() const { return d_nchan; }
+      int order() const { return d_order; }
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_COSTAS_LOOP_BANK_H */
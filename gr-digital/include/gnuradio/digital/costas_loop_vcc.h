@@ -0,0 +1,80 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_COSTAS_LOOP_VCC_H
+#define INCLUDED_DIGITAL_COSTAS_LOOP_VCC_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/blocks/control_loop.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Costas loops or PLLs on every channel of a vector stream
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * Every item holds one sample of each of \p vlen channels, e.g.
+     * the outputs of a pfb_channelizer_ccf gathered with
+     * streams_to_vector.  Each channel gets its own loop, as in
+     * gr::digital::costas_loop_cc for order 2, 4 and 8; order 1
+     * tracks an unmodulated carrier like
+     * gr::analog::pll_carriertracking_cc.  The loops share the loop
+     * bandwidth and the frequency limits, which are set through
+     * gr::blocks::control_loop; its phase and frequency are not
+     * used.  The loops run side by side in SIMD registers (see
+     * gr::digital::costas_loop_bank).
+     *
+     * The block can have two output streams:
+     * \li stream 1 (required) is the baseband I and Q of every channel;
+     * \li stream 2 (optional) is the normalized frequency of every loop
+     */
+    class DIGITAL_API costas_loop_vcc
+      : virtual public sync_block,
+        virtual public blocks::control_loop
+    {
+    public:
+      // gr::digital::costas_loop_vcc::sptr
+      typedef boost::shared_ptr<costas_loop_vcc> sptr;
+
+      /*!
+       * Make a bank of carrier recovery loops.
+       *
+       * \param vlen     number of channels
+       * \param loop_bw  internal 2nd order loop bandwidth (~ 2pi/100)
+       * \param order    the loop order, 1 (PLL), 2, 4, or 8
+       */
+      static sptr make(int vlen, float loop_bw, int order);
+
+      //! Current phase of the loop of channel \p chan
+      virtual float phase(unsigned int chan) const = 0;
+
+      //! Current frequency of the loop of channel \p chan
+      virtual float frequency(unsigned int chan) const = 0;
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_COSTAS_LOOP_VCC_H */
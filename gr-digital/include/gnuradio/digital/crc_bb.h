@@ -0,0 +1,81 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CRC_BB_H
+#define INCLUDED_DIGITAL_CRC_BB_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/tagged_stream_block.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Byte-stream CRC block with a configurable CRC
+     * \ingroup packet_operators_blk
+     *
+     * \details
+     * Input: stream of bytes, which form a packet. The first byte of the packet
+     * has a tag with key "length" and the value being the number of bytes in the
+     * packet.
+     *
+     * Output: The same bytes as incoming, but trailing the CRC of the packet
+     * in (num_bits+7)/8 bytes. The tag is re-set to the new length. In check
+     * mode, packets with a wrong CRC are dropped and the CRC is removed from
+     * the others.
+     *
+     * The CRC is described as for gr::digital::crc_engine. Reflected CRCs
+     * are appended least significant byte first, the others most significant
+     * byte first, so that with the CRC-32 parameters the output is the same
+     * as that of crc32_bb on little endian machines.
+     */
+    class DIGITAL_API crc_bb : virtual public tagged_stream_block
+    {
+     public:
+      typedef boost::shared_ptr<crc_bb> sptr;
+
+      /*!
+       * \param num_bits Width of the CRC, 1 to 32
+       * \param poly Generator polynomial, without the x^num_bits term
+       * \param initial_value Initial register value
+       * \param final_xor Value XORed onto the result
+       * \param input_reflected Process the bits of each byte LSB first
+       * \param result_reflected Reflect the result before the final XOR
+       * \param check Set to true if you want to check CRC, false to create CRC.
+       * \param lengthtagname Length tag key
+       */
+      static sptr make(int num_bits, unsigned int poly,
+		       unsigned int initial_value, unsigned int final_xor,
+		       bool input_reflected, bool result_reflected,
+		       bool check=false, const std::string& lengthtagname="packet_len");
+
+      //! Number of packets that passed the check
+      virtual uint64_t num_passed() const = 0;
+
+      //! Number of packets dropped for a wrong CRC
+      virtual uint64_t num_failed() const = 0;
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_CRC_BB_H */
@@ -0,0 +1,120 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CRC_ENGINE_H
+#define INCLUDED_DIGITAL_CRC_ENGINE_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/types.h>
+#include <string>
+#include <vector>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Table driven CRC of 1 to 32 bits with any polynomial
+     * \ingroup packet_operators_blk
+     *
+     * \details
+     * The CRC is given by the usual parameters (as in the Rocksoft
+     * model): the width, the polynomial without its leading term,
+     * the initial register value, the value XORed onto the result
+     * and whether input bytes and result are reflected. Some common
+     * ones:
+     *
+     * \li CRC-8:         8, 0x07, 0x00, 0x00, false, false
+     * \li CRC-16/CCITT:  16, 0x1021, 0xFFFF, 0x0000, false, false
+     * \li CRC-16/ARC:    16, 0x8005, 0x0000, 0x0000, true, true
+     * \li CRC-24/OPENPGP: 24, 0x864CFB, 0xB704CE, 0x000000, false, false
+     * \li CRC-32:        32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true
+     * \li CRC-32C:       32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true
+     *
+     * The bytes are processed by the volk_8u_x2_crc_32u kernel, eight
+     * bytes per step with slicing-by-8 tables, or by carry-less
+     * multiplication (PCLMULQDQ) where the machine has it.
+     */
+    class DIGITAL_API crc_engine
+    {
+    private:
+      unsigned int d_num_bits;
+      unsigned int d_poly;
+      unsigned int d_initial_value;
+      unsigned int d_final_xor;
+      bool d_input_reflected;
+      bool d_result_reflected;
+
+      unsigned int d_mask;
+      unsigned int d_shift;	// Left shift of a normal register
+      unsigned int d_initial_register;
+      std::vector<unsigned int> d_tables;
+
+    public:
+      /*!
+       * \param num_bits Width of the CRC, 1 to 32
+       * \param poly Generator polynomial, without the x^num_bits term
+       * \param initial_value Initial register value
+       * \param final_xor Value XORed onto the result
+       * \param input_reflected Process the bits of each byte LSB first
+       * \param result_reflected Reflect the result before the final XOR
+       */
+      crc_engine(unsigned int num_bits, unsigned int poly,
+		 unsigned int initial_value, unsigned int final_xor,
+		 bool input_reflected, bool result_reflected);
+      ~crc_engine();
+
+      //! CRC of \p len bytes
+      unsigned int compute(const unsigned char *data, size_t len) const;
+      unsigned int compute(const std::string &data) const;
+
+      /*!
+       * \brief Runs the CRC register over more bytes.
+       *
+       * Starting from initial_register(), any number of update()
+       * calls followed by finalize() give the same result as
+       * compute() on the concatenated data. The register is kept
+       * reflected for reflected input and shifted up to bit 31
+       * otherwise.
+       */
+      unsigned int update(unsigned int reg, const unsigned char *data, size_t len) const;
+
+      //! Register value before the first byte
+      unsigned int initial_register() const { return d_initial_register; }
+
+      //! Turns a register value into the CRC
+      unsigned int finalize(unsigned int reg) const;
+
+      unsigned int num_bits() const { return d_num_bits; }
+      unsigned int poly() const { return d_poly; }
+      unsigned int initial_value() const { return d_initial_value; }
+      unsigned int final_xor() const { return d_final_xor; }
+      bool input_reflected() const { return d_input_reflected; }
+      bool result_reflected() const { return d_result_reflected; }
+
+      //! Number of bytes taken by the CRC in a packet
+      unsigned int num_bytes() const { return (d_num_bits + 7) / 8; }
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_CRC_ENGINE_H */
@@ -34,8 +34,6 @@ namespace gr {
      * \ingroup equalizers_blk
      *
      * \details
-     * Warning: This block does not yet work.
-     *
      * "Y. Guo, J. Zhao, Y. Sun, "Sign kurtosis maximization based blind
      * equalization algorithm," IEEE Conf. on Control, Automation,
      * Robotics and Vision, Vol. 3, Dec. 2004, pp. 2052 - 2057."
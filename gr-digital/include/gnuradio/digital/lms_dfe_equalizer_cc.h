@@ -0,0 +1,96 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DIGITAL_LMS_DFE_EQUALIZER_CC_H
+#define INCLUDED_DIGITAL_LMS_DFE_EQUALIZER_CC_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/sync_decimator.h>
+#include <gnuradio/digital/constellation.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Decision feedback LMS equalizer (complex in/out)
+     * \ingroup equalizers_blk
+     *
+     * \details
+     * Like gr::digital::lms_dd_equalizer_cc, with num_fb_taps more
+     * taps on the past decisions:
+     *
+     * y[n] = w^T u[n] + b^T d[n-1]
+     * d[n] = decision(y[n])
+     * e[n] = d[n] - y[n]
+     * w[n+1] = w[n] + mu conj(u[n]) e[n]
+     * b[n+1] = b[n] + mu conj(d[n-1]) e[n]
+     *
+     * where d[n-1] holds the last num_fb_taps decisions, newest
+     * first.  The feedback cancels the postcursor ISI without
+     * enhancing the noise as a longer feed-forward filter would.
+     * With no feedback taps this is the LMS decision-directed
+     * equalizer.
+     *
+     * With a block_size larger than 1 the taps are updated once every
+     * block_size symbols with the sum of the gradients (block
+     * LMS). This converges like the per-symbol update for a small mu
+     * and lets long feed-forward filters and their updates run with
+     * FFTs; see gr::digital::adaptive_equalizer.
+     */
+    class DIGITAL_API lms_dfe_equalizer_cc :
+      virtual public sync_decimator
+    {
+    public:
+      // gr::digital::lms_dfe_equalizer_cc::sptr
+      typedef boost::shared_ptr<lms_dfe_equalizer_cc> sptr;
+
+      /*!
+       * Make a decision feedback LMS equalizer
+       *
+       * \param num_ff_taps Number of feed-forward taps
+       * \param num_fb_taps Number of feedback taps
+       * \param mu Gain of the update loop
+       * \param sps Number of samples per symbol of the input signal
+       * \param cnst A constellation derived from class
+       * 'constellation'. Use base() method to get a shared pointer to
+       * this base class type.
+       * \param block_size Number of symbols between tap updates
+       */
+      static sptr make(int num_ff_taps, int num_fb_taps,
+		       float mu, int sps,
+		       constellation_sptr cnst,
+		       int block_size = 1);
+
+      virtual void set_taps(const std::vector<gr_complex> &taps) = 0;
+      virtual std::vector<gr_complex> taps() const = 0;
+      virtual void set_feedback_taps(const std::vector<gr_complex> &taps) = 0;
+      virtual std::vector<gr_complex> feedback_taps() const = 0;
+      virtual float gain() const = 0;
+      virtual void set_gain(float mu) = 0;
+      virtual int block_size() const = 0;
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_LMS_DFE_EQUALIZER_CC_H */
@@ -55,6 +55,9 @@ namespace gr {
      * channel state is estimated incorrectly during equalization; after that,
      * all subsequent symbols will be completely wrong.
      *
+     * The decisions for all data carriers of a symbol are made in one
+     * call to constellation::decision_maker_n.
+     *
      * Note that the equalized symbols are *exact points* on the constellation.
      * This means soft information of the modulation symbols is lost after the
      * equalization, which is suboptimal for channel codes that use soft decision.
@@ -122,6 +125,10 @@ namespace gr {
       gr::digital::constellation_sptr d_constellation;
       //! Averaging coefficient
       float d_alpha;
+      //! Carriers of the current symbol to decide on, and their equalized values
+      std::vector<int> d_data_carriers;
+      std::vector<gr_complex> d_sym_eq;
+      std::vector<unsigned int> d_decisions;
     };
 
   } /* namespace digital */
@@ -58,6 +58,9 @@ namespace gr {
      * i.e., we estimate the energy from *both* half-symbols. This avoids spurious detects
      * at the end of a burst, when the energy level suddenly drops.
      *
+     * The work is done by ofdm_sync_sc_fused_cfb, which also allows setting
+     * the detection threshold and outputs the timing metric.
+     *
      * [1] Schmidl, T.M. and Cox, D.C., "Robust frequency and timing synchronization for OFDM",
      *     Communications, IEEE Transactions on, 1997.
      */
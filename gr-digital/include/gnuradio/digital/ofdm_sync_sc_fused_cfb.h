@@ -0,0 +1,78 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_OFDM_SYNC_SC_FUSED_CFB_H
+#define INCLUDED_DIGITAL_OFDM_SYNC_SC_FUSED_CFB_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/block.h>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Schmidl & Cox synchronisation for OFDM in a single block
+     * \ingroup ofdm_blk
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * Input: complex samples.
+     * Output 0: Fine frequency offset, scaled by the OFDM symbol duration.
+     *           The normalized frequency offset is 2.0*output0/fft_len.
+     * Output 1: Beginning of the first OFDM symbol after the first (doubled) OFDM
+     *           symbol. The beginning is marked with a 1 (it's 0 everywhere else).
+     * Output 2 (optional): The timing metric.
+     *
+     * This computes the same outputs as ofdm_sync_sc_cfb (which uses this
+     * block), but instead of moving average filters over fft_len/2 resp.
+     * fft_len samples it keeps running sums of the autocorrelation P(d)
+     * and the energy R(d), which are updated with the newest and the
+     * oldest sample of their windows. The cost per sample does not depend
+     * on the FFT length. To keep rounding errors from building up, both
+     * sums are computed anew every fft_len samples, and they are exactly
+     * zero once the window only holds zeros.
+     *
+     * The timing metric M(d) = |P(d)|^2/R(d)^2, its plateau detection
+     * (see blocks::plateau_detector_fb) and the sample-and-hold of the
+     * angle of P(d) are done in the same pass.
+     */
+    class DIGITAL_API ofdm_sync_sc_fused_cfb : virtual public block
+    {
+     public:
+      typedef boost::shared_ptr<ofdm_sync_sc_fused_cfb> sptr;
+
+      /*! \param fft_len FFT length
+       *  \param cp_len Length of the guard interval (cyclic prefix) in samples
+       *  \param use_even_carriers If true, the carriers in the sync preamble are occupied such
+       *                     that the even carriers are used (0, 2, 4, ...).
+       *  \param threshold Timing metric above which a plateau is detected
+       */
+      static sptr make(int fft_len, int cp_len, bool use_even_carriers=false, float threshold=0.9);
+
+      virtual void set_threshold(float threshold) = 0;
+      virtual float threshold() const = 0;
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_OFDM_SYNC_SC_FUSED_CFB_H */
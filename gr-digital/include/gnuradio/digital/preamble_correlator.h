@@ -0,0 +1,135 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_PREAMBLE_CORRELATOR_H
+#define INCLUDED_DIGITAL_PREAMBLE_CORRELATOR_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/gr_complex.h>
+#include <vector>
+
+namespace gr {
+  namespace fft {
+    class fft_complex;
+  }
+  namespace filter {
+    namespace kernel {
+      class fir_filter_ccc;
+    }
+  }
+
+  namespace digital {
+
+    /*!
+     * \brief Filters a stream with several sets of taps at once,
+     * directly or with overlap-save FFT convolution
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * Every tap set is used once for every frequency offset, which
+     * gives num_taps() * num_freqs() hypotheses; hypothesis
+     * t * num_freqs() + f uses tap set t and frequency offset f.
+     * Like filter::kernel::fir_filter_ccc, hypothesis h computes
+     *
+     *   out[h][i] = sum_k taps_h[k] * in[i + ntaps() - 1 - k]
+     *
+     * where ntaps() is the length of the longest tap set; shorter
+     * sets are padded with zeros at the end, so every set lines up
+     * with the newest sample.  For a frequency offset of w
+     * rad/sample the input is derotated by exp(-j*w*m) over the
+     * window, where m counts from the oldest sample the tap set
+     * covers.
+     *
+     * Short tap sets are applied directly.  For longer ones the
+     * input is transformed once per block of fft_size() samples and
+     * every hypothesis costs a complex multiply and an inverse
+     * FFT.  In AUTO mode the cheaper one is picked from an operation
+     * count, along with the FFT size.
+     */
+    class DIGITAL_API preamble_correlator
+    {
+    public:
+      enum mode_t {
+	AUTO,
+	DIRECT,
+	FFT
+      };
+
+    private:
+      mode_t d_mode;
+      unsigned int d_ntaps;
+      size_t d_ntapsets;
+      size_t d_nfreqs;
+      std::vector<filter::kernel::fir_filter_ccc*> d_filters;
+      fft::fft_complex *d_fwdfft;
+      fft::fft_complex *d_invfft;
+      unsigned int d_fftsize;
+      unsigned int d_nsamples;
+      gr_complex *d_xformed_taps;
+
+      void clear();
+
+    public:
+      /*!
+       * \param taps the tap sets
+       * \param freq_offsets frequency offsets in rad/sample
+       * \param mode how to filter
+       */
+      preamble_correlator(const std::vector<std::vector<gr_complex> > &taps,
+			  const std::vector<float> &freq_offsets = std::vector<float>(1, 0),
+			  mode_t mode = AUTO);
+      ~preamble_correlator();
+
+      //! Replaces the tap sets and frequency offsets
+      void set_taps(const std::vector<std::vector<gr_complex> > &taps,
+		    const std::vector<float> &freq_offsets = std::vector<float>(1, 0));
+
+      /*!
+       * \brief Computes \p n outputs of every hypothesis.
+       *
+       * \p in holds ntaps() - 1 samples of history followed by the
+       * \p n new ones.  out[h] receives the \p n outputs of
+       * hypothesis h.
+       */
+      void filter(unsigned int n, const gr_complex *in, gr_complex *const *out);
+
+      //! Length of the longest tap set
+      unsigned int ntaps() const { return d_ntaps; }
+
+      size_t num_taps() const { return d_ntapsets; }
+      size_t num_freqs() const { return d_nfreqs; }
+      size_t num_hypotheses() const { return d_ntapsets * d_nfreqs; }
+
+      //! True if the FFT is used
+      bool use_fft() const { return d_fwdfft != 0; }
+
+      //! FFT size, 0 when filtering directly
+      unsigned int fft_size() const { return d_fftsize; }
+
+      //! Outputs computed per FFT, 0 when filtering directly
+      unsigned int block_size() const { return d_nsamples; }
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_PREAMBLE_CORRELATOR_H */
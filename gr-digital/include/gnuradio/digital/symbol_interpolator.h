@@ -0,0 +1,104 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifndef INCLUDED_DIGITAL_SYMBOL_INTERPOLATOR_H
+#define INCLUDED_DIGITAL_SYMBOL_INTERPOLATOR_H
+
+#include <gnuradio/digital/api.h>
+#include <gnuradio/gr_complex.h>
+#include <stdint.h>
+#include <vector>
+
+namespace gr {
+  namespace digital {
+
+    /*!
+     * \brief Interpolates a block of symbols from a polyphase bank
+     * \ingroup synchronizers_blk
+     *
+     * \details
+     * Separates the interpolation of a symbol timing loop from its
+     * control.  The loop first pushes the input offset and bank
+     * phase of each symbol it will take, then interpolate() computes
+     * all of them in one pass of
+     * volk_32fc_32f_32u_gather_dot_prod_32fc.  Output i is
+     *
+     *   out[i] = sum_k in[offset(i) + k] * bank[phase(i)][k]
+     *
+     * The default bank is the MMSE interpolator of
+     * gr::filter::mmse_fir_interpolator_cc, with phase
+     * mmse_phase(mu) for a delay mu in [0, 1], and gives the same
+     * outputs as that interpolator.
+     */
+    class DIGITAL_API symbol_interpolator
+    {
+    private:
+      unsigned int d_ntaps;
+      unsigned int d_nphases;
+      std::vector<float> d_bank;
+      std::vector<uint32_t> d_schedule;
+
+    public:
+      //! Uses the MMSE interpolator bank
+      symbol_interpolator();
+
+      /*!
+       * \param bank filter of each phase, all of the same length, in
+       * the order they multiply the input
+       */
+      symbol_interpolator(const std::vector< std::vector<float> > &bank);
+
+      void set_taps(const std::vector< std::vector<float> > &bank);
+
+      unsigned int ntaps() const { return d_ntaps; }
+      unsigned int nphases() const { return d_nphases; }
+
+      //! Phase of the MMSE bank nearest the delay \p mu in [0, 1]
+      static unsigned int mmse_phase(float mu);
+
+      //! Empties the schedule
+      void clear() { d_schedule.clear(); }
+
+      //! Schedules a symbol at input \p offset from bank phase \p phase
+      void push(unsigned int offset, unsigned int phase)
+      {
+	d_schedule.push_back(offset);
+	d_schedule.push_back(phase * d_ntaps);
+      }
+
+      //! Number of scheduled symbols
+      unsigned int size() const { return d_schedule.size() / 2; }
+
+      /*!
+       * \brief Computes the scheduled symbols.
+       *
+       * \p in holds at least the largest offset plus ntaps() samples
+       * and \p out size() symbols.
+       */
+      void interpolate(const gr_complex *in, gr_complex *out) const;
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_SYMBOL_INTERPOLATOR_H */
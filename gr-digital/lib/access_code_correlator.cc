@@ -0,0 +1,128 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/digital/access_code_correlator.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    // Window positions handed to the kernel at once
+    static const size_t CHUNK = 4096;
+
+    bool
+    access_code_correlator::hit_t::operator<(const hit_t &other) const
+    {
+      if(byte != other.byte)
+	return byte < other.byte;
+      if(bit != other.bit)
+	return bit < other.bit;
+      return code < other.code;
+    }
+
+    access_code_correlator::access_code_correlator(
+        const std::vector<std::string> &access_codes, unsigned int threshold)
+      : d_threshold(threshold), d_history(0)
+    {
+      if(access_codes.empty())
+	throw std::invalid_argument("access_code_correlator: no access codes");
+      if(threshold > 254)
+	throw std::out_of_range("access_code_correlator: threshold must be below 255");
+
+      for(size_t c = 0; c < access_codes.size(); c++) {
+	const std::string &code = access_codes[c];
+	const unsigned int len = code.length();
+	if(len == 0)
+	  throw std::invalid_argument("access_code_correlator: empty access code");
+
+	// The window ends with the byte holding the first bit after
+	// the code, so for offset o the code takes the len bits just
+	// before bit o of the last byte.
+	const unsigned int nbytes = (len + 7) / 8 + 1;
+	std::vector<unsigned char> tables(16*nbytes, 0);
+	for(unsigned int o = 0; o < 8; o++) {
+	  unsigned char *bits = &tables[2*nbytes*o];
+	  unsigned char *mask = bits + nbytes;
+	  for(unsigned int b = 0; b < len; b++) {
+	    unsigned int pos = 8*(nbytes - 1) + o - len + b;
+	    unsigned char m = 0x80 >> (pos % 8);
+	    mask[pos / 8] |= m;
+	    if(code[b] & 1)
+	      bits[pos / 8] |= m;
+	  }
+	}
+
+	d_lengths.push_back(len);
+	d_nbytes.push_back(nbytes);
+	d_tables.push_back(tables);
+	d_history = std::max(d_history, nbytes - 1);
+      }
+
+      d_dist.resize(8*CHUNK);
+    }
+
+    access_code_correlator::~access_code_correlator()
+    {
+    }
+
+    void
+    access_code_correlator::correlate(const unsigned char *in, size_t nbytes,
+				      std::vector<hit_t> &hits)
+    {
+      const size_t first = hits.size();
+
+      for(size_t start = 0; start < nbytes; start += CHUNK) {
+	const size_t n = std::min(CHUNK, nbytes - start);
+
+	for(size_t c = 0; c < d_tables.size(); c++) {
+	  // Windows end at the searched bytes
+	  const unsigned char *window = in + d_history + start - (d_nbytes[c] - 1);
+	  volk_8u_x2_hamming_8u(&d_dist[0], window, &d_tables[c][0],
+				d_nbytes[c], n);
+
+	  for(unsigned int o = 0; o < 8; o++) {
+	    const unsigned char *dist = &d_dist[o*n];
+	    for(size_t j = 0; j < n; j++) {
+	      if(dist[j] <= d_threshold) {
+		hit_t hit;
+		hit.byte = start + j;
+		hit.bit = o;
+		hit.code = c;
+		hit.nwrong = dist[j];
+		hits.push_back(hit);
+	      }
+	    }
+	  }
+	}
+      }
+
+      std::sort(hits.begin() + first, hits.end());
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
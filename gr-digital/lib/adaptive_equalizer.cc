@@ -0,0 +1,350 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/digital/adaptive_equalizer.h>
+#include <gnuradio/fft/fft.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    // Cost of one point of one radix-2 FFT stage, in complex
+    // multiply-accumulates; see preamble_correlator.cc.
+    static const double FFT_POINT_COST = 2.0;
+
+    static gr_complex *
+    alloc_complex(unsigned int n)
+    {
+      gr_complex *p = (gr_complex*)volk_malloc(std::max(1u, n)*sizeof(gr_complex),
+					       volk_get_alignment());
+      std::fill(p, p + n, gr_complex(0));
+      return p;
+    }
+
+    adaptive_equalizer::adaptive_equalizer(unsigned int ntaps, unsigned int sps,
+					   unsigned int nfb)
+      : d_ntaps(ntaps), d_nfb(nfb), d_sps(sps), d_block(1), d_mode(AUTO),
+	d_decision_pos(0), d_fwdfft(0), d_invfft(0), d_fftsize(0)
+    {
+      if(ntaps == 0)
+	throw std::invalid_argument("adaptive_equalizer: ntaps must be > 0");
+      if(sps == 0)
+	throw std::invalid_argument("adaptive_equalizer: sps must be > 0");
+
+      d_taps = alloc_complex(ntaps);
+      d_fb_taps = alloc_complex(nfb);
+      d_fb_grad = alloc_complex(nfb);
+      d_decisions = alloc_complex(2*nfb);
+      d_ff = alloc_complex(1);
+      d_steps = alloc_complex(1);
+      d_xformed_in = 0;
+    }
+
+    adaptive_equalizer::~adaptive_equalizer()
+    {
+      volk_free(d_taps);
+      volk_free(d_fb_taps);
+      volk_free(d_fb_grad);
+      volk_free(d_decisions);
+      volk_free(d_ff);
+      volk_free(d_steps);
+      if(d_xformed_in)
+	volk_free(d_xformed_in);
+      delete d_fwdfft;
+      delete d_invfft;
+    }
+
+    void
+    adaptive_equalizer::set_taps(const std::vector<gr_complex> &taps)
+    {
+      if(taps.empty())
+	throw std::invalid_argument("adaptive_equalizer: no taps");
+
+      if(taps.size() != d_ntaps) {
+	volk_free(d_taps);
+	d_ntaps = taps.size();
+	d_taps = alloc_complex(d_ntaps);
+	plan();
+      }
+      std::copy(taps.begin(), taps.end(), d_taps);
+    }
+
+    std::vector<gr_complex>
+    adaptive_equalizer::taps() const
+    {
+      return std::vector<gr_complex>(d_taps, d_taps + d_ntaps);
+    }
+
+    void
+    adaptive_equalizer::set_feedback_taps(const std::vector<gr_complex> &taps)
+    {
+      if(taps.size() != d_nfb) {
+	volk_free(d_fb_taps);
+	volk_free(d_fb_grad);
+	volk_free(d_decisions);
+	d_nfb = taps.size();
+	d_fb_taps = alloc_complex(d_nfb);
+	d_fb_grad = alloc_complex(d_nfb);
+	d_decisions = alloc_complex(2*d_nfb);
+	d_decision_pos = 0;
+      }
+      // Stored oldest decision first, like the decisions
+      std::reverse_copy(taps.begin(), taps.end(), d_fb_taps);
+    }
+
+    std::vector<gr_complex>
+    adaptive_equalizer::feedback_taps() const
+    {
+      std::vector<gr_complex> t(d_nfb);
+      std::reverse_copy(d_fb_taps, d_fb_taps + d_nfb, t.begin());
+      return t;
+    }
+
+    void
+    adaptive_equalizer::reset_decisions()
+    {
+      std::fill(d_decisions, d_decisions + 2*d_nfb, gr_complex(0));
+      d_decision_pos = 0;
+    }
+
+    void
+    adaptive_equalizer::set_block_size(unsigned int block_size, mode_t mode)
+    {
+      if(block_size == 0)
+	throw std::invalid_argument("adaptive_equalizer: block size must be > 0");
+
+      d_block = block_size;
+      d_mode = mode;
+      volk_free(d_ff);
+      volk_free(d_steps);
+      d_ff = alloc_complex(d_block);
+      d_steps = alloc_complex(d_block);
+      plan();
+    }
+
+    void
+    adaptive_equalizer::plan()
+    {
+      delete d_fwdfft;
+      delete d_invfft;
+      d_fwdfft = d_invfft = 0;
+      if(d_xformed_in)
+	volk_free(d_xformed_in);
+      d_xformed_in = 0;
+      d_fftsize = 0;
+
+      if(d_block == 1 || d_mode == DIRECT)
+	return;
+
+      // A block of B symbols covers (B - 1) * sps + ntaps input
+      // samples; with an FFT at least that long, neither the
+      // filter nor the gradient correlation wraps around.  Directly,
+      // every symbol costs ntaps MACs for the output and as many for
+      // the update.  The FFT form costs five FFTs per block: the
+      // input, the taps, the outputs, the steps and the gradient.
+      const unsigned int nin = (d_block - 1)*d_sps + d_ntaps;
+      unsigned int fftsize = 1;
+      while(fftsize < nin)
+	fftsize <<= 1;
+
+      const double direct = 2.0 * d_ntaps * d_block;
+      const double fft = 5.0 * FFT_POINT_COST * fftsize * log(double(fftsize)) / log(2.0)
+	+ 4.0 * fftsize;
+      if(d_mode == AUTO && fft >= direct)
+	return;
+
+      d_fftsize = fftsize;
+      d_fwdfft = new fft::fft_complex(fftsize, true);
+      d_invfft = new fft::fft_complex(fftsize, false);
+      d_xformed_in = alloc_complex(fftsize);
+    }
+
+    gr_complex
+    adaptive_equalizer::feedback() const
+    {
+      gr_complex fb = 0;
+      if(d_nfb > 0)
+	volk_32fc_x2_dot_prod_32fc(&fb, d_decisions + d_decision_pos, d_fb_taps, d_nfb);
+      return fb;
+    }
+
+    void
+    adaptive_equalizer::push_decision(const gr_complex &decision)
+    {
+      // Every decision is stored twice, nfb apart, so that the last
+      // nfb of them are always contiguous, oldest first.
+      d_decisions[d_decision_pos] = decision;
+      d_decisions[d_decision_pos + d_nfb] = decision;
+      if(++d_decision_pos == d_nfb)
+	d_decision_pos = 0;
+    }
+
+    void
+    adaptive_equalizer::equalize(const gr_complex *in, gr_complex *out, unsigned int n)
+    {
+      if(d_block == 1) {
+	equalize_symbols(in, out, n);
+	return;
+      }
+
+      for(unsigned int i = 0; i < n; i += d_block) {
+	equalize_block(in + i*d_sps, out + i, std::min(d_block, n - i));
+      }
+    }
+
+    void
+    adaptive_equalizer::equalize_symbols(const gr_complex *in, gr_complex *out,
+					 unsigned int n)
+    {
+      gr_complex y, s, decision;
+
+      for(unsigned int i = 0; i < n; i++) {
+	const gr_complex *x = in + i*d_sps;
+
+	volk_32fc_x2_dot_prod_32fc(&y, x, d_taps, d_ntaps);
+	y += feedback();
+	out[i] = y;
+
+	decision = y;
+	s = step(y, decision);
+	volk_32fc_x2_s32fc_multiply_conjugate_add_32fc(d_taps, d_taps, x, s, d_ntaps);
+	if(d_nfb > 0) {
+	  volk_32fc_x2_s32fc_multiply_conjugate_add_32fc(d_fb_taps, d_fb_taps,
+							  d_decisions + d_decision_pos,
+							  s, d_nfb);
+	  push_decision(decision);
+	}
+      }
+    }
+
+    void
+    adaptive_equalizer::equalize_block(const gr_complex *in, gr_complex *out,
+				       unsigned int n)
+    {
+      // The FFT is planned for full blocks; a short one at the end of
+      // a call is done directly, which gives the same result.
+      const bool fft = use_fft() && n == d_block;
+      gr_complex y, decision;
+      unsigned int i;
+
+      if(fft) {
+	filter_fft(in, n);
+      }
+      else {
+	for(i = 0; i < n; i++)
+	  volk_32fc_x2_dot_prod_32fc(&d_ff[i], in + i*d_sps, d_taps, d_ntaps);
+      }
+
+      // The decisions still come one at a time; the feedback taps
+      // are held over the block like the feed-forward ones.
+      for(i = 0; i < n; i++) {
+	y = d_ff[i] + feedback();
+	out[i] = y;
+
+	decision = y;
+	d_steps[i] = step(y, decision);
+	if(d_nfb > 0) {
+	  volk_32fc_x2_s32fc_multiply_conjugate_add_32fc(d_fb_grad, d_fb_grad,
+							  d_decisions + d_decision_pos,
+							  d_steps[i], d_nfb);
+	  push_decision(decision);
+	}
+      }
+
+      if(fft) {
+	update_fft(n);
+      }
+      else {
+	for(i = 0; i < n; i++)
+	  volk_32fc_x2_s32fc_multiply_conjugate_add_32fc(d_taps, d_taps, in + i*d_sps,
+							  d_steps[i], d_ntaps);
+      }
+
+      if(d_nfb > 0) {
+	volk_32f_x2_add_32f((float*)d_fb_taps, (const float*)d_fb_taps,
+			    (const float*)d_fb_grad, 2*d_nfb);
+	std::fill(d_fb_grad, d_fb_grad + d_nfb, gr_complex(0));
+      }
+    }
+
+    void
+    adaptive_equalizer::filter_fft(const gr_complex *in, unsigned int n)
+    {
+      // With X the transform of the input and W that of conj(taps),
+      // the inverse transform of X * conj(W) is the correlation
+      // sum_k x[m+k] * taps[k] for every offset m; the symbols are
+      // at the multiples of sps.
+      const unsigned int nin = (n - 1)*d_sps + d_ntaps;
+      gr_complex *fwd_in = d_fwdfft->get_inbuf();
+      const gr_complex *fwd_out = d_fwdfft->get_outbuf();
+      gr_complex *inv_in = d_invfft->get_inbuf();
+      const gr_complex *inv_out = d_invfft->get_outbuf();
+      const float scale = 1.0f / d_fftsize;
+
+      std::copy(in, in + nin, fwd_in);
+      std::fill(fwd_in + nin, fwd_in + d_fftsize, gr_complex(0));
+      d_fwdfft->execute();
+      std::copy(fwd_out, fwd_out + d_fftsize, d_xformed_in);
+
+      volk_32fc_conjugate_32fc(fwd_in, d_taps, d_ntaps);
+      std::fill(fwd_in + d_ntaps, fwd_in + d_fftsize, gr_complex(0));
+      d_fwdfft->execute();
+
+      volk_32fc_x2_multiply_conjugate_32fc(inv_in, d_xformed_in, fwd_out, d_fftsize);
+      d_invfft->execute();
+
+      for(unsigned int i = 0; i < n; i++)
+	d_ff[i] = inv_out[i*d_sps] * scale;
+    }
+
+    void
+    adaptive_equalizer::update_fft(unsigned int n)
+    {
+      // The gradient of tap k is sum_i conj(x[i*sps+k]) * step[i], the
+      // conjugate of the correlation of the input with the steps
+      // placed at the symbol positions.
+      gr_complex *fwd_in = d_fwdfft->get_inbuf();
+      const gr_complex *fwd_out = d_fwdfft->get_outbuf();
+      gr_complex *inv_in = d_invfft->get_inbuf();
+      const gr_complex *inv_out = d_invfft->get_outbuf();
+      const gr_complex scale(1.0f / d_fftsize, 0);
+
+      std::fill(fwd_in, fwd_in + d_fftsize, gr_complex(0));
+      for(unsigned int i = 0; i < n; i++)
+	fwd_in[i*d_sps] = d_steps[i];
+      d_fwdfft->execute();
+
+      volk_32fc_x2_multiply_conjugate_32fc(inv_in, d_xformed_in, fwd_out, d_fftsize);
+      d_invfft->execute();
+
+      volk_32fc_x2_s32fc_multiply_conjugate_add_32fc(d_taps, d_taps, inv_out, scale, d_ntaps);
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
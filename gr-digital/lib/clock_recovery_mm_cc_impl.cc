@@ -55,7 +55,8 @@ namespace gr {
 		 io_signature::make2(1, 2, sizeof(gr_complex), sizeof(float))),
 	d_mu(mu), d_omega(omega), d_gain_omega(gain_omega), 
 	d_omega_relative_limit(omega_relative_limit), 
-	d_gain_mu(gain_mu), d_last_sample(0), d_interp(new filter::mmse_fir_interpolator_cc()),
+	d_gain_mu(gain_mu), d_last_sample(0),
+	d_loop_decim(1), d_loop_count(0), d_loop_error(0),
 	d_verbose(prefs::singleton()->get_bool("clock_recovery_mm_cc", "verbose", false)),
 	d_p_2T(0), d_p_1T(0), d_p_0T(0), d_c_2T(0), d_c_1T(0), d_c_0T(0)
     {
@@ -71,7 +72,18 @@ namespace gr {
 
     clock_recovery_mm_cc_impl::~clock_recovery_mm_cc_impl()
     {
-      delete d_interp;
+    }
+
+    void
+    clock_recovery_mm_cc_impl::set_loop_decimation(int decimation)
+    {
+      if(decimation < 1)
+	throw std::out_of_range("loop decimation must be >= 1");
+
+      // the error of a partly done group is dropped
+      d_loop_decim = decimation;
+      d_loop_count = 0;
+      d_loop_error = 0;
     }
 
     void
@@ -81,7 +93,7 @@ namespace gr {
       unsigned ninputs = ninput_items_required.size();
       for(unsigned i=0; i < ninputs; i++)
 	ninput_items_required[i] =
-	  (int)ceil((noutput_items * d_omega) + d_interp->ntaps()) + FUDGE;
+	  (int)ceil((noutput_items * d_omega) + d_interp.ntaps()) + FUDGE;
     }
 
     gr_complex
@@ -121,20 +133,39 @@ namespace gr {
   
       int ii = 0; // input index
       int oo = 0; // output index
-      int ni = ninput_items[0] - d_interp->ntaps() - FUDGE;  // don't use more input than this
+      int ni = ninput_items[0] - d_interp.ntaps() - FUDGE;  // don't use more input than this
 
       assert(d_mu >= 0.0);
       assert(d_mu <= 1.0);
 
+      // the error is limited harder when it is not written out
+      const float limit = write_foptr ? 4.0 : 1.0;
       float mm_val = 0;
       gr_complex u, x, y;
 
-      // This loop writes the error to the second output, if it exists
-      if(write_foptr) {
-	while(oo < noutput_items && ii < ni) {
+      while(oo < noutput_items && ii < ni) {
+	// Schedule the symbols up to the next loop update; omega does
+	// not change before it, so all their positions are known.
+	const int nleft = d_loop_decim - d_loop_count;
+	float mu = d_mu;
+	int jj = ii;
+	d_interp.clear();
+	while((int)d_interp.size() < nleft && oo + (int)d_interp.size() < noutput_items && jj < ni) {
+	  d_interp.push(jj, symbol_interpolator::mmse_phase(mu));
+	  if((int)d_interp.size() < nleft) {
+	    mu = mu + d_omega;
+	    jj += (int)floor(mu);
+	    mu -= floor(mu);
+	  }
+	}
+
+	const int n = d_interp.size();
+	d_interp.interpolate(in, &out[oo]);
+
+	for(int j = 0; j < n; j++) {
 	  d_p_2T = d_p_1T;
 	  d_p_1T = d_p_0T;
-	  d_p_0T = d_interp->interpolate(&in[ii], d_mu);
+	  d_p_0T = out[oo+j];
 
 	  d_c_2T = d_c_1T;
 	  d_c_1T = d_c_0T;
@@ -143,59 +174,37 @@ namespace gr {
 	  x = (d_c_0T - d_c_2T) * conj(d_p_1T);
 	  y = (d_p_0T - d_p_2T) * conj(d_c_1T);
 	  u = y - x;
-	  mm_val = u.real();
-	  out[oo++] = d_p_0T;
-      
-	  // limit mm_val
-	  mm_val = gr::branchless_clip(mm_val,4.0);
-	  d_omega = d_omega + d_gain_omega * mm_val;
-	  d_omega = d_omega_mid + gr::branchless_clip(d_omega-d_omega_mid, d_omega_relative_limit);
+	  mm_val = gr::branchless_clip(u.real(), limit);
+	  d_loop_error += mm_val;
 
-	  d_mu = d_mu + d_omega + d_gain_mu * mm_val;
-	  ii += (int)floor(d_mu);
-	  d_mu -= floor(d_mu);
-            
 	  // write the error signal to the second output
-	  foptr[oo-1] = mm_val;
-      
-	  if(ii < 0) // clamp it.  This should only happen with bogus input
-	    ii = 0;
+	  if(write_foptr)
+	    foptr[oo+j] = mm_val;
 	}
-      }
-      // This loop does not write to the second output (ugly, but faster)
-      else {
-	while(oo < noutput_items && ii < ni) {
-	  d_p_2T = d_p_1T;
-	  d_p_1T = d_p_0T;
-	  d_p_0T = d_interp->interpolate(&in[ii], d_mu);
+	oo += n;
+	d_loop_count += n;
 
-	  d_c_2T = d_c_1T;
-	  d_c_1T = d_c_0T;
-	  d_c_0T = slicer_0deg(d_p_0T);
-      
-	  x = (d_c_0T - d_c_2T) * conj(d_p_1T);
-	  y = (d_p_0T - d_p_2T) * conj(d_c_1T);
-	  u = y - x;
-	  mm_val = u.real();
-	  out[oo++] = d_p_0T;
-      
-	  // limit mm_val
-	  mm_val = gr::branchless_clip(mm_val,1.0);
-      
-	  d_omega = d_omega + d_gain_omega * mm_val;
+	// Update the loop and step to the next symbol with it
+	if(d_loop_count == d_loop_decim) {
+	  d_omega = d_omega + d_gain_omega * d_loop_error;
 	  d_omega = d_omega_mid + gr::branchless_clip(d_omega-d_omega_mid, d_omega_relative_limit);
-      
-	  d_mu = d_mu + d_omega + d_gain_mu * mm_val;
-	  ii += (int)floor(d_mu);
-	  d_mu -= floor(d_mu);
-      
+
+	  mu = mu + d_omega + d_gain_mu * d_loop_error;
+	  jj += (int)floor(mu);
+	  mu -= floor(mu);
+
+	  d_loop_count = 0;
+	  d_loop_error = 0;
+
 	  if(d_verbose) {
-	    std::cout << d_omega << "\t" << d_mu << std::endl;
+	    std::cout << d_omega << "\t" << mu << std::endl;
 	  }
-            
-	  if(ii < 0) // clamp it.  This should only happen with bogus input
-	    ii = 0;
 	}
+	d_mu = mu;
+	ii = jj;
+
+	if(ii < 0) // clamp it.  This should only happen with bogus input
+	  ii = 0;
       }
 
       if(ii > 0) {
@@ -24,7 +24,7 @@
 #define	INCLUDED_DIGITAL_CLOCK_RECOVERY_MM_CC_IMPL_H
 
 #include <gnuradio/digital/clock_recovery_mm_cc.h>
-#include <gnuradio/filter/mmse_fir_interpolator_cc.h>
+#include <gnuradio/digital/symbol_interpolator.h>
 
 namespace gr {
   namespace digital {
@@ -58,6 +58,8 @@ namespace gr {
 	d_max_omega = omega*(1.0 + d_omega_relative_limit);
 	d_omega_mid = 0.5*(d_min_omega+d_max_omega);
       }
+      void set_loop_decimation(int decimation);
+      int loop_decimation() const { return d_loop_decim; }
 
     private:
       float d_mu;                   // fractional sample position [0.0, 1.0]
@@ -70,7 +72,11 @@ namespace gr {
       float d_gain_mu;              // gain for adjusting mu
 
       gr_complex d_last_sample;
-      filter::mmse_fir_interpolator_cc *d_interp;
+      symbol_interpolator d_interp;
+
+      int d_loop_decim;             // symbols between loop updates
+      int d_loop_count;             // symbols since the last update
+      float d_loop_error;           // sum of their errors
 
       bool d_verbose;
 
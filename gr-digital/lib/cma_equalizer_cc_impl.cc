@@ -30,8 +30,6 @@
 namespace gr {
   namespace digital {
 
-    using namespace filter::kernel;
-
     cma_equalizer_cc::sptr
     cma_equalizer_cc::make(int num_taps, float modulus, float mu, int sps)
     {
@@ -45,15 +43,15 @@ namespace gr {
 			  io_signature::make(1, 1, sizeof(gr_complex)),
 			  io_signature::make(1, 1, sizeof(gr_complex)),
 			  sps),
-	fir_filter_ccc(sps, std::vector<gr_complex>(num_taps, gr_complex(0,0))),
+	adaptive_equalizer(num_taps, sps),
 	d_new_taps(num_taps, gr_complex(0,0)),
 	d_updated(false), d_error(gr_complex(0,0))
     {
       set_modulus(modulus);
       set_gain(mu);
       if(num_taps > 0)
-	d_new_taps[0] = 1.0;
-      fir_filter_ccc::set_taps(d_new_taps);
+	d_new_taps[num_taps-1] = 1.0;
+      adaptive_equalizer::set_taps(d_new_taps);
 
       set_history(num_taps);
     }
@@ -72,7 +70,7 @@ namespace gr {
     std::vector<gr_complex>
     cma_equalizer_cc_impl::taps() const
     {
-      return d_taps;
+      return adaptive_equalizer::taps();
     }
 
     gr_complex
@@ -91,6 +89,13 @@ namespace gr {
       tap -= d_mu*conj(in)*d_error;
     }
 
+    gr_complex
+    cma_equalizer_cc_impl::step(const gr_complex &out, gr_complex &decision)
+    {
+      d_error = error(out);
+      return -d_mu*d_error;
+    }
+
     int
     cma_equalizer_cc_impl::work(int noutput_items,
 				gr_vector_const_void_star &input_items,
@@ -100,29 +105,13 @@ namespace gr {
       gr_complex *out = (gr_complex *)output_items[0];
 
       if(d_updated) {
-	d_taps = d_new_taps;
-	set_history(d_taps.size());
+	adaptive_equalizer::set_taps(d_new_taps);
+	set_history(d_new_taps.size());
 	d_updated = false;
 	return 0;		     // history requirements may have changed.
       }
 
-      int j = 0;
-      size_t k, l = d_taps.size();
-      for(int i = 0; i < noutput_items; i++) {
-	out[i] = filter(&in[j]);
-
-	// Adjust taps
-	d_error = error(out[i]);
-	for(k = 0; k < l; k++) {
-	  // Update tap locally from error.
-	  update_tap(d_taps[k], in[j+k]);
-
-	  // Update aligned taps in filter object.
-	  fir_filter_ccc::update_tap(d_taps[k], k);
-	}
-
-	j += decimation();
-      }
+      equalize(in, out, noutput_items);
 
       return noutput_items;
     }
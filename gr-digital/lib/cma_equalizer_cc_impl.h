@@ -24,7 +24,7 @@
 #define	INCLUDED_DIGITAL_CMA_EQUALIZER_CC_IMPL_H
 
 #include <gnuradio/digital/cma_equalizer_cc.h>
-#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/digital/adaptive_equalizer.h>
 #include <gnuradio/math.h>
 #include <stdexcept>
 
@@ -32,7 +32,7 @@ namespace gr {
   namespace digital {
 
     class cma_equalizer_cc_impl
-      : public cma_equalizer_cc, filter::kernel::fir_filter_ccc
+      : public cma_equalizer_cc, adaptive_equalizer
     {
     private:
       std::vector<gr_complex> d_new_taps;
@@ -45,7 +45,8 @@ namespace gr {
     protected:
       gr_complex error(const gr_complex &out);
       void update_tap(gr_complex &tap, const gr_complex &in);
-  
+      gr_complex step(const gr_complex &out, gr_complex &decision);
+
     public:
       cma_equalizer_cc_impl(int num_taps, float modulus, float mu, int sps);
       ~cma_equalizer_cc_impl();
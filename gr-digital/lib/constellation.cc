@@ -28,6 +28,8 @@
 #include <gnuradio/digital/constellation.h>
 #include <gnuradio/math.h>
 #include <gnuradio/gr_complex.h>
+#include <volk/volk.h>
+#include <algorithm>
 #include <cstdlib>
 #include <cfloat>
 #include <stdexcept>
@@ -39,6 +41,50 @@ namespace gr {
 #define M_TWOPI (2*M_PI)
 #define SQRT_TWO 0.707107
 
+    // Squared distances from sample to the n points.  The VOLK kernel
+    // writes at least four results, so small constellations are done
+    // here.
+    static inline void
+    square_dist(float *dist, const gr_complex *sample,
+                const gr_complex *points, unsigned int n)
+    {
+      if(n < 4) {
+        for(unsigned int i = 0; i < n; i++)
+          dist[i] = std::norm(*sample - points[i]);
+        return;
+      }
+      volk_32fc_x2_square_dist_32f(dist, const_cast<gr_complex*>(sample),
+                                   const_cast<gr_complex*>(points), n);
+    }
+
+    // Log-likelihood ratios of the k bits of a symbol, most
+    // significant first, from its squared distances to the M points
+    // labelled by labels.  Shared by calc_soft_dec and
+    // soft_decision_maker_n so that both give the same values.
+    static void
+    soft_dec_from_dist(const float *dist, const std::vector<int> &labels,
+                       unsigned int k, float npwr, float scale,
+                       float *tmp, float *llrs)
+    {
+      const unsigned int M = labels.size();
+      std::fill(tmp, tmp + 2*k, 0.0f);
+      for(unsigned int i = 0; i < M; i++) {
+        // Calculate the probability factor from the distance and
+        // the scaled noise power.
+        float d = expf(-dist[i] / (2.0*npwr*scale));
+
+        // Add to the probability of a zero or a one for each bit
+        for(unsigned int j = 0; j < k; j++)
+          tmp[2*j + ((labels[i] >> j) & 1)] += d;
+      }
+
+      // Calculate the log-likelihood ratio for all bits based on the
+      // probability of ones (tmp[2*i+1]) over the probability of a zero
+      // (tmp[2*i+0]).
+      for(unsigned int i = 0; i < k; i++)
+        llrs[k-1-i] = (logf(tmp[2*i+1]) - logf(tmp[2*i+0])) * scale;
+    }
+
     // Base Constellation Class
     constellation::constellation(std::vector<gr_complex> constell,
                                  std::vector<int> pre_diff_code,
@@ -153,6 +199,15 @@ namespace gr {
       return index;
     }
 
+    void
+    constellation::decision_maker_n(const gr_complex *samples,
+                                    unsigned int *decisions,
+                                    unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++)
+        decisions[i] = decision_maker(&samples[i*d_dimensionality]);
+    }
+
     std::vector<gr_complex> constellation::s_points()
     {
       if(d_dimensionality != 1)
@@ -201,6 +256,10 @@ namespace gr {
     constellation::calc_euclidean_metric(const gr_complex *sample,
                                          float *metric)
     {
+      if(d_dimensionality == 1) {
+        square_dist(metric, sample, &d_constellation[0], d_arity);
+        return;
+      }
       for(unsigned int o=0; o<d_arity; o++) {
         metric[o] = get_distance(o, sample);
       }
@@ -271,45 +330,18 @@ namespace gr {
       int k = static_cast<int>(log(static_cast<double>(M))/log(2.0));
       std::vector<float> tmp(2*k, 0);
       std::vector<float> s(k, 0);
+      std::vector<float> dist(M);
+      std::vector<int> labels(M);
 
-      float scale = d_scalefactor*d_scalefactor;
-      int v;
-      
       for(int i = 0; i < M; i++) {
         // Calculate the distance between the sample and the current
         // constellation point.
-        float dist = powf(std::abs(sample - d_constellation[i]), 2.0f);
-
-        // Calculate the probability factor from the distance and
-        // the scaled noise power.
-        float d = expf(-dist / (2.0*npwr*scale));
-
-        if(d_apply_pre_diff_code)
-          v = d_pre_diff_code[i];
-        else
-          v = i;
-
-        for(int j = 0; j < k; j++) {
-          // Get the bit at the jth index
-          int mask = 1 << j;
-          int bit = (v & mask) >> j;
-
-          // If the bit is a 0, add to the probability of a zero
-          if(bit == 0)
-            tmp[2*j+0] += d;
-          // else, add to the probability of a one
-          else
-            tmp[2*j+1] += d;
-        }
-      }
-
-      // Calculate the log-likelihood ratio for all bits based on the
-      // probability of ones (tmp[2*i+1]) over the probability of a zero
-      // (tmp[2*i+0]).
-      for(int i = 0; i < k; i++) {
-        s[k-1-i] = (logf(tmp[2*i+1]) - logf(tmp[2*i+0])) * scale;
+        dist[i] = std::norm(sample - d_constellation[i]);
+        labels[i] = d_apply_pre_diff_code ? d_pre_diff_code[i] : i;
       }
 
+      soft_dec_from_dist(&dist[0], labels, k, npwr,
+                         d_scalefactor*d_scalefactor, &tmp[0], &s[0]);
       return s;
     }
 
@@ -330,38 +362,74 @@ namespace gr {
       return d_soft_dec_lut.size() > 0;
     }
 
-    std::vector<float>
-    constellation::soft_decision_maker(gr_complex sample)
+    const std::vector<float> &
+    constellation::soft_dec_lut_entry(gr_complex sample)
     {
-      if(has_soft_dec_lut()) {
-        float xre = sample.real();
-        float xim = sample.imag();
+      float xre = sample.real();
+      float xim = sample.imag();
 
-        float xstep = (d_re_max-d_re_min) / d_lut_scale;
-        float ystep = (d_im_max-d_im_min) / d_lut_scale;
+      float xstep = (d_re_max-d_re_min) / d_lut_scale;
+      float ystep = (d_im_max-d_im_min) / d_lut_scale;
 
-        float xscale = (d_lut_scale / (d_re_max-d_re_min)) - xstep;
-        float yscale = (d_lut_scale / (d_im_max-d_im_min)) - ystep;
+      float xscale = (d_lut_scale / (d_re_max-d_re_min)) - xstep;
+      float yscale = (d_lut_scale / (d_im_max-d_im_min)) - ystep;
 
-        xre = floorf((-d_re_min + std::min(d_re_max, std::max(d_re_min, xre))) * xscale);
-        xim = floorf((-d_im_min + std::min(d_im_max, std::max(d_im_min, xim))) * yscale);
-        int index = static_cast<int>(d_lut_scale*xim + xre);
+      xre = floorf((-d_re_min + std::min(d_re_max, std::max(d_re_min, xre))) * xscale);
+      xim = floorf((-d_im_min + std::min(d_im_max, std::max(d_im_min, xim))) * yscale);
+      int index = static_cast<int>(d_lut_scale*xim + xre);
 
-        int max_index = d_lut_scale*d_lut_scale;
-        if(index > max_index) {
-          return d_soft_dec_lut[max_index-1];
-        }
+      int max_index = d_lut_scale*d_lut_scale;
+      if(index > max_index) {
+        return d_soft_dec_lut[max_index-1];
+      }
+
+      if(index < 0)
+        throw std::runtime_error("constellation::soft_decision_maker: input sample out of range.");
 
-        if(index < 0)
-          throw std::runtime_error("constellation::soft_decision_maker: input sample out of range.");
+      return d_soft_dec_lut[index];
+    }
 
-        return d_soft_dec_lut[index];
+    std::vector<float>
+    constellation::soft_decision_maker(gr_complex sample)
+    {
+      if(has_soft_dec_lut()) {
+        return soft_dec_lut_entry(sample);
       }
       else {
         return calc_soft_dec(sample);
       }
     }
 
+    void
+    constellation::soft_decision_maker_n(const gr_complex *samples, float *llrs,
+                                         unsigned int nsymbols, float npwr)
+    {
+      const unsigned int k = bits_per_symbol();
+
+      if(has_soft_dec_lut()) {
+        for(unsigned int i = 0; i < nsymbols; i++) {
+          const std::vector<float> &soft = soft_dec_lut_entry(samples[i]);
+          for(unsigned int j = 0; j < k; j++)
+            llrs[i*k+j] = soft[j];
+        }
+        return;
+      }
+
+      const unsigned int M = d_constellation.size();
+      std::vector<int> labels(M);
+      std::vector<float> dist(M);
+      std::vector<float> tmp(2*k);
+
+      for(unsigned int p = 0; p < M; p++)
+        labels[p] = d_apply_pre_diff_code ? d_pre_diff_code[p] : p;
+
+      for(unsigned int i = 0; i < nsymbols; i++) {
+        square_dist(&dist[0], &samples[i], &d_constellation[0], M);
+        soft_dec_from_dist(&dist[0], labels, k, npwr,
+                           d_scalefactor*d_scalefactor, &tmp[0], &llrs[i*k]);
+      }
+    }
+
     void
     constellation::max_min_axes()
     {
@@ -411,16 +479,126 @@ namespace gr {
       unsigned int rotational_symmetry,
       unsigned int dimensionality)
       : constellation(constell, pre_diff_code, rotational_symmetry, dimensionality)
-    {}
-    
+    {
+      find_grid();
+    }
+
+    // Sorted distinct values, merging those closer than tol
+    static std::vector<float>
+    distinct_values(std::vector<float> v, float tol)
+    {
+      std::vector<float> d;
+      std::sort(v.begin(), v.end());
+      for(size_t i = 0; i < v.size(); i++) {
+        if(d.empty() || v[i] - d.back() > tol)
+          d.push_back(v[i]);
+      }
+      return d;
+    }
+
+    void
+    constellation_calcdist::find_grid()
+    {
+      d_grid.clear();
+      if(d_dimensionality != 1 || d_arity < 4)
+        return;
+
+      float tol = 0;
+      std::vector<float> re(d_arity), im(d_arity);
+      for(unsigned int p = 0; p < d_arity; p++) {
+        re[p] = d_constellation[p].real();
+        im[p] = d_constellation[p].imag();
+        tol = std::max(tol, std::abs(d_constellation[p]));
+      }
+      tol *= 1e-4;
+
+      std::vector<float> re_values = distinct_values(re, tol);
+      std::vector<float> im_values = distinct_values(im, tol);
+      d_grid_n_real = re_values.size();
+      d_grid_n_imag = im_values.size();
+      if(d_grid_n_real < 2 || d_grid_n_imag < 2 ||
+         d_grid_n_real * d_grid_n_imag != d_arity)
+        return;
+
+      // The values must be evenly spaced on both axes
+      float step_real = (re_values.back() - re_values.front()) / (d_grid_n_real - 1);
+      float step_imag = (im_values.back() - im_values.front()) / (d_grid_n_imag - 1);
+      for(unsigned int i = 0; i < d_grid_n_real; i++) {
+        if(std::abs(re_values[i] - (re_values[0] + i*step_real)) > tol)
+          return;
+      }
+      for(unsigned int i = 0; i < d_grid_n_imag; i++) {
+        if(std::abs(im_values[i] - (im_values[0] + i*step_imag)) > tol)
+          return;
+      }
+
+      // Every grid position must hold exactly one point
+      std::vector<unsigned int> grid(d_arity, d_arity);
+      for(unsigned int p = 0; p < d_arity; p++) {
+        unsigned int i = floor((re[p] - re_values[0]) / step_real + 0.5);
+        unsigned int j = floor((im[p] - im_values[0]) / step_imag + 0.5);
+        if(grid[i*d_grid_n_imag + j] != d_arity)
+          return;
+        grid[i*d_grid_n_imag + j] = p;
+      }
+
+      d_grid = grid;
+      d_grid_real0 = re_values[0];
+      d_grid_imag0 = im_values[0];
+      d_grid_inv_step_real = 1.0 / step_real;
+      d_grid_inv_step_imag = 1.0 / step_imag;
+    }
+
+    inline unsigned int
+    constellation_calcdist::grid_point(const gr_complex &sample) const
+    {
+      int i = floorf((sample.real() - d_grid_real0) * d_grid_inv_step_real + 0.5f);
+      int j = floorf((sample.imag() - d_grid_imag0) * d_grid_inv_step_imag + 0.5f);
+      i = std::min(std::max(i, 0), (int)d_grid_n_real - 1);
+      j = std::min(std::max(j, 0), (int)d_grid_n_imag - 1);
+      return d_grid[i*d_grid_n_imag + j];
+    }
+
     // Chooses points base on shortest distance.
-    // Inefficient.
+    // Inefficient, unless the points are on a grid.
     unsigned int
     constellation_calcdist::decision_maker(const gr_complex *sample)
     {
+      if(!d_grid.empty())
+        return grid_point(*sample);
       return get_closest_point(sample);
     }
 
+    void
+    constellation_calcdist::decision_maker_n(const gr_complex *samples,
+                                             unsigned int *decisions,
+                                             unsigned int nsymbols)
+    {
+      if(!d_grid.empty()) {
+        for(unsigned int i = 0; i < nsymbols; i++)
+          decisions[i] = grid_point(samples[i]);
+        return;
+      }
+      if(d_dimensionality != 1) {
+        constellation::decision_maker_n(samples, decisions, nsymbols);
+        return;
+      }
+
+      std::vector<float> dist(d_arity);
+      for(unsigned int i = 0; i < nsymbols; i++) {
+        square_dist(&dist[0], &samples[i], &d_constellation[0], d_arity);
+        unsigned int min_index = 0;
+        float min_dist = dist[0];
+        for(unsigned int j = 1; j < d_arity; j++) {
+          if(dist[j] < min_dist) {
+            min_dist = dist[j];
+            min_index = j;
+          }
+        }
+        decisions[i] = min_index;
+      }
+    }
+
 
     /********************************************************************/
 
@@ -447,6 +625,25 @@ namespace gr {
       sector = get_sector(sample);
       return sector_values[sector];
     }
+
+    void
+    constellation_sector::decision_maker_n(const gr_complex *samples,
+                                           unsigned int *decisions,
+                                           unsigned int nsymbols)
+    {
+      get_sectors(samples, decisions, nsymbols);
+      for(unsigned int i = 0; i < nsymbols; i++)
+        decisions[i] = sector_values[decisions[i]];
+    }
+
+    void
+    constellation_sector::get_sectors(const gr_complex *samples,
+                                      unsigned int *sectors,
+                                      unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++)
+        sectors[i] = get_sector(&samples[i*d_dimensionality]);
+    }
     
     void
     constellation_sector::find_sector_values()
@@ -493,6 +690,8 @@ namespace gr {
     {
       d_width_real_sectors *= d_scalefactor;
       d_width_imag_sectors *= d_scalefactor;
+      d_inv_width_real_sectors = 1.0 / d_width_real_sectors;
+      d_inv_width_imag_sectors = 1.0 / d_width_imag_sectors;
       find_sector_values();
     }
     
@@ -500,28 +699,41 @@ namespace gr {
     {
     }
     
-    unsigned int
-    constellation_rect::get_sector(const gr_complex *sample)
+    inline unsigned int
+    constellation_rect::slice(const gr_complex &sample) const
     {
       int real_sector, imag_sector;
-      unsigned int sector;
-      
-      real_sector = int(real(*sample)/d_width_real_sectors
-                        + n_real_sectors/2.0);
+
+      real_sector = int(sample.real()*d_inv_width_real_sectors
+                        + n_real_sectors/2.0f);
       if(real_sector < 0)
         real_sector = 0;
       if(real_sector >= (int)n_real_sectors)
         real_sector = n_real_sectors-1;
-      
-      imag_sector = int(imag(*sample)/d_width_imag_sectors
-                        + n_imag_sectors/2.0);
+
+      imag_sector = int(sample.imag()*d_inv_width_imag_sectors
+                        + n_imag_sectors/2.0f);
       if(imag_sector < 0)
         imag_sector = 0;
       if(imag_sector >= (int)n_imag_sectors)
         imag_sector = n_imag_sectors-1;
-      
-      sector = real_sector * n_imag_sectors + imag_sector;
-      return sector;
+
+      return real_sector * n_imag_sectors + imag_sector;
+    }
+
+    unsigned int
+    constellation_rect::get_sector(const gr_complex *sample)
+    {
+      return slice(*sample);
+    }
+
+    void
+    constellation_rect::get_sectors(const gr_complex *samples,
+                                    unsigned int *sectors,
+                                    unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++)
+        sectors[i] = slice(samples[i]);
     }
 
     gr_complex
@@ -604,6 +816,15 @@ namespace gr {
       constellation_sector(constell, pre_diff_code, constell.size(),
                            1, n_sectors)
     {
+      // Sector k lies between the boundaries at (k-1/2) and (k+1/2)
+      // sector widths.
+      float width = M_TWOPI / n_sectors;
+      d_inv_width = 1.0 / width;
+      d_boundaries.resize(2*(n_sectors+1));
+      for(unsigned int k = 0; k <= n_sectors; k++) {
+        d_boundaries[2*k] = cos((k - 0.5) * width);
+        d_boundaries[2*k+1] = sin((k - 0.5) * width);
+      }
       find_sector_values();
     }
     
@@ -611,16 +832,66 @@ namespace gr {
     {
     }
     
-    unsigned int
-    constellation_psk::get_sector(const gr_complex *sample)
+    inline unsigned int
+    constellation_psk::slice(const gr_complex &sample) const
     {
-      float phase = arg(*sample);
-      float width = M_TWOPI / n_sectors;
-      int sector = floor(phase/width + 0.5);
+      const bool use_table = n_sectors >= 3 && n_sectors <= 512;
+      float re = sample.real();
+      float im = sample.imag();
+      float phase;
+
+      // Sectors wider than the error of this phase approximation
+      // (below 0.005 rad) are found from a guess and a check against
+      // the neighbouring boundaries, without calling atan2.
+      if(use_table) {
+        float are = fabsf(re), aim = fabsf(im);
+        if(are >= aim) {
+          float a = are > 0 ? aim / are : 0;
+          phase = a * (M_PI/4 + 0.273f * (1 - a));
+        }
+        else {
+          float a = are / aim;
+          phase = M_PI/2 - a * (M_PI/4 + 0.273f * (1 - a));
+        }
+        if(re < 0)
+          phase = M_PI - phase;
+        if(im < 0)
+          phase = -phase;
+      }
+      else {
+        phase = arg(sample);
+      }
+
+      int sector = floor(phase*d_inv_width + 0.5f);
       if(sector < 0)
         sector += n_sectors;
+      if(sector >= (int)n_sectors)
+        sector -= n_sectors;
+
+      if(use_table && (re != 0 || im != 0)) {
+        const float *lower = &d_boundaries[2*sector];
+        if(lower[0]*im - lower[1]*re < 0)
+          sector = sector == 0 ? n_sectors-1 : sector-1;
+        else if(lower[2]*im - lower[3]*re >= 0)
+          sector = sector == (int)n_sectors-1 ? 0 : sector+1;
+      }
       return sector;
     }
+
+    unsigned int
+    constellation_psk::get_sector(const gr_complex *sample)
+    {
+      return slice(*sample);
+    }
+
+    void
+    constellation_psk::get_sectors(const gr_complex *samples,
+                                   unsigned int *sectors,
+                                   unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++)
+        sectors[i] = slice(samples[i]);
+    }
   
     unsigned int
     constellation_psk::calc_sector_value(unsigned int sector)
@@ -661,6 +932,15 @@ namespace gr {
       return (real(*sample) > 0);
     }
 
+    void
+    constellation_bpsk::decision_maker_n(const gr_complex *samples,
+                                         unsigned int *decisions,
+                                         unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++)
+        decisions[i] = (samples[i].real() > 0);
+    }
+
 
     /********************************************************************/
 
@@ -727,6 +1007,15 @@ namespace gr {
       */
     }
 
+    void
+    constellation_qpsk::decision_maker_n(const gr_complex *samples,
+                                         unsigned int *decisions,
+                                         unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++)
+        decisions[i] = 2*(samples[i].imag() > 0) + (samples[i].real() > 0);
+    }
+
 
     /********************************************************************/
 
@@ -787,6 +1076,17 @@ namespace gr {
       }
     }
 
+    void
+    constellation_dqpsk::decision_maker_n(const gr_complex *samples,
+                                          unsigned int *decisions,
+                                          unsigned int nsymbols)
+    {
+      // Indexed by 2*(imag > 0) + (real > 0)
+      static const unsigned int quadrant[4] = { 0x2, 0x3, 0x1, 0x0 };
+      for(unsigned int i = 0; i < nsymbols; i++)
+        decisions[i] = quadrant[2*(samples[i].imag() > 0) + (samples[i].real() > 0)];
+    }
+
 
     /********************************************************************/
 
@@ -837,5 +1137,17 @@ namespace gr {
       return ret;
     }
 
+    void
+    constellation_8psk::decision_maker_n(const gr_complex *samples,
+                                         unsigned int *decisions,
+                                         unsigned int nsymbols)
+    {
+      for(unsigned int i = 0; i < nsymbols; i++) {
+        float re = samples[i].real();
+        float im = samples[i].imag();
+        decisions[i] = 4*(fabsf(re) <= fabsf(im)) + 2*(im <= 0) + (re <= 0);
+      }
+    }
+
   } /* namespace digital */
 } /* namespace gr */
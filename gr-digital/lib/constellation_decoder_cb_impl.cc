@@ -72,8 +72,11 @@ namespace gr {
       gr_complex const *in = (const gr_complex*)input_items[0];
       unsigned char *out = (unsigned char*)output_items[0];
 
+      if(d_decisions.size() < (size_t)noutput_items)
+	d_decisions.resize(noutput_items);
+      d_constellation->decision_maker_n(in, &d_decisions[0], noutput_items);
       for(int i = 0; i < noutput_items; i++) {
-	out[i] = d_constellation->decision_maker(&(in[i*d_dim]));
+	out[i] = d_decisions[i];
       }
 
       consume_each(noutput_items * d_dim);
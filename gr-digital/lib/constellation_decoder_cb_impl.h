@@ -33,6 +33,7 @@ namespace gr {
     private:
       constellation_sptr d_constellation;
       unsigned int d_dim;
+      std::vector<unsigned int> d_decisions;
 
     public:
       constellation_decoder_cb_impl(constellation_sptr constellation);
@@ -0,0 +1,92 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "correlate_access_code_packed_tag_bb_impl.h"
+#include <gnuradio/io_signature.h>
+#include <cstring>
+#include <sstream>
+
+namespace gr {
+  namespace digital {
+
+    correlate_access_code_packed_tag_bb::sptr
+    correlate_access_code_packed_tag_bb::make(const std::vector<std::string> &access_codes,
+					      int threshold,
+					      const std::string &tag_name)
+    {
+      return gnuradio::get_initial_sptr
+	(new correlate_access_code_packed_tag_bb_impl(access_codes,
+						      threshold, tag_name));
+    }
+
+    correlate_access_code_packed_tag_bb_impl::correlate_access_code_packed_tag_bb_impl(
+        const std::vector<std::string> &access_codes, int threshold,
+        const std::string &tag_name)
+      : sync_block("correlate_access_code_packed_tag_bb",
+		   io_signature::make(1, 1, sizeof(char)),
+		   io_signature::make(1, 1, sizeof(char))),
+	d_correlator(access_codes, threshold)
+    {
+      // Codes may start in earlier bytes
+      set_history(d_correlator.history() + 1);
+
+      std::stringstream str;
+      str << name() << unique_id();
+      d_me = pmt::string_to_symbol(str.str());
+      d_key = pmt::string_to_symbol(tag_name);
+    }
+
+    correlate_access_code_packed_tag_bb_impl::~correlate_access_code_packed_tag_bb_impl()
+    {
+    }
+
+    int
+    correlate_access_code_packed_tag_bb_impl::work(int noutput_items,
+						   gr_vector_const_void_star &input_items,
+						   gr_vector_void_star &output_items)
+    {
+      const unsigned char *in = (const unsigned char*)input_items[0];
+      unsigned char *out = (unsigned char*)output_items[0];
+
+      memcpy(out, in + history() - 1, noutput_items);
+
+      d_hits.clear();
+      d_correlator.correlate(in, noutput_items, d_hits);
+
+      uint64_t abs_out_sample_cnt = nitems_written(0);
+      for(size_t i = 0; i < d_hits.size(); i++) {
+	pmt::pmt_t value = pmt::make_dict();
+	value = pmt::dict_add(value, pmt::intern("code"), pmt::from_long(d_hits[i].code));
+	value = pmt::dict_add(value, pmt::intern("nwrong"), pmt::from_long(d_hits[i].nwrong));
+	value = pmt::dict_add(value, pmt::intern("bit"), pmt::from_long(d_hits[i].bit));
+	add_item_tag(0, abs_out_sample_cnt + d_hits[i].byte, d_key, value, d_me);
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
@@ -0,0 +1,55 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CORRELATE_ACCESS_CODE_PACKED_TAG_BB_IMPL_H
+#define INCLUDED_DIGITAL_CORRELATE_ACCESS_CODE_PACKED_TAG_BB_IMPL_H
+
+#include <gnuradio/digital/correlate_access_code_packed_tag_bb.h>
+#include <gnuradio/digital/access_code_correlator.h>
+
+namespace gr {
+  namespace digital {
+
+    class correlate_access_code_packed_tag_bb_impl :
+      public correlate_access_code_packed_tag_bb
+    {
+    private:
+      access_code_correlator d_correlator;
+      std::vector<access_code_correlator::hit_t> d_hits;
+
+      pmt::pmt_t d_key, d_me; //d_key is the tag name, d_me is the block name + unique ID
+
+    public:
+      correlate_access_code_packed_tag_bb_impl(const std::vector<std::string> &access_codes,
+					       int threshold,
+					       const std::string &tag_name);
+      ~correlate_access_code_packed_tag_bb_impl();
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_CORRELATE_ACCESS_CODE_PACKED_TAG_BB_IMPL_H */
@@ -74,8 +74,8 @@ namespace gr {
 
       d_center_first_symbol = (padding.size() + 0.5) * d_sps;
 
-      //d_filter = new kernel::fft_filter_ccc(1, d_symbols);
-      d_filter = new kernel::fir_filter_ccc(1, d_symbols);
+      // Long preambles are correlated with the FFT
+      d_filter = new preamble_correlator(std::vector<std::vector<gr_complex> >(1, d_symbols));
 
       set_history(d_filter->ntaps());
 
@@ -100,7 +100,7 @@ namespace gr {
     {
       gr::thread::scoped_lock lock(d_setlock);
       d_symbols = symbols;
-      d_filter->set_taps(symbols);
+      d_filter->set_taps(std::vector<std::vector<gr_complex> >(1, symbols));
       set_history(d_filter->ntaps());
     }
 
@@ -118,17 +118,18 @@ namespace gr {
       memcpy(out, in, sizeof(gr_complex)*noutput_items);
 
       // Calculate the correlation with the known symbol
-      //d_filter->filter(noutput_items, in, corr);
-      d_filter->filterN(corr, in, noutput_items);
-      
+      d_filter->filter(noutput_items, in, &corr);
+
       // Find the magnitude squared of the correlation
-      std::vector<float> corr_mag(noutput_items);
-      volk_32fc_magnitude_squared_32f(&corr_mag[0], corr, noutput_items);
+      if((int)d_corr_mag.size() < noutput_items)
+        d_corr_mag.resize(noutput_items);
+      float *corr_mag = &d_corr_mag[0];
+      volk_32fc_magnitude_squared_32f(corr_mag, corr, noutput_items);
 
       int i = d_sps;
-      while(i < noutput_items) {
+      while(i < noutput_items-1) {
         if((corr_mag[i] - corr_mag[i-d_sps]) > d_thresh) {
-          while(corr_mag[i] < corr_mag[i+1])
+          while(i < noutput_items-2 && corr_mag[i] < corr_mag[i+1])
             i++;
 
           double nom = 0, den = 0;
@@ -24,10 +24,7 @@
 #define INCLUDED_DIGITAL_CORRELATE_AND_SYNC_CC_IMPL_H
 
 #include <gnuradio/digital/correlate_and_sync_cc.h>
-#include <gnuradio/filter/fir_filter.h>
-#include <gnuradio/filter/fft_filter.h>
-
-using namespace gr::filter;
+#include <gnuradio/digital/preamble_correlator.h>
 
 namespace gr {
   namespace digital {
@@ -39,8 +36,8 @@ namespace gr {
       unsigned int d_sps;
       float d_center_first_symbol;
       float d_thresh;
-      kernel::fir_filter_ccc  *d_filter;
-      //kernel::fft_filter_ccc  *d_filter;
+      preamble_correlator *d_filter;
+      std::vector<float> d_corr_mag;
 
       int d_last_index;
       
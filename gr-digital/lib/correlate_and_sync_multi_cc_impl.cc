@@ -0,0 +1,181 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include <gnuradio/math.h>
+#include "correlate_and_sync_multi_cc_impl.h"
+#include <volk/volk.h>
+#include <gnuradio/filter/pfb_arb_resampler.h>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    correlate_and_sync_multi_cc::sptr
+    correlate_and_sync_multi_cc::make(const std::vector<std::vector<gr_complex> > &symbols,
+                                      const std::vector<float> &filter,
+                                      unsigned int sps,
+                                      const std::vector<float> &freq_offsets,
+                                      unsigned int nfilts)
+    {
+      return gnuradio::get_initial_sptr
+        (new correlate_and_sync_multi_cc_impl(symbols, filter, sps, freq_offsets, nfilts));
+    }
+
+    correlate_and_sync_multi_cc_impl::correlate_and_sync_multi_cc_impl(const std::vector<std::vector<gr_complex> > &symbols,
+                                                                       const std::vector<float> &filter,
+                                                                       unsigned int sps,
+                                                                       const std::vector<float> &freq_offsets,
+                                                                       unsigned int nfilts)
+      : sync_block("correlate_and_sync_multi_cc",
+                   io_signature::make(1, 1, sizeof(gr_complex)),
+                   io_signature::make(1, 2, sizeof(gr_complex))),
+        d_sps(sps), d_freqs(freq_offsets)
+    {
+      if(symbols.empty())
+        throw std::invalid_argument("correlate_and_sync_multi_cc: no preambles");
+
+      // Every preamble is upsampled and pulse shaped as in
+      // correlate_and_sync_cc
+      std::vector<std::vector<gr_complex> > taps(symbols.size());
+      std::vector<gr_complex> padding((1+filter.size()/nfilts)/2, 0);
+      for(size_t t = 0; t < symbols.size(); t++) {
+        std::vector<gr_complex> padded_symbols = symbols[t];
+        padded_symbols.insert(padded_symbols.begin(), padding.begin(), padding.end());
+
+        taps[t].resize(d_sps*symbols[t].size(), 0);
+        filter::kernel::pfb_arb_resampler_ccf resamp(d_sps, filter, nfilts);
+        int nread;
+        resamp.filter(&taps[t][0], &padded_symbols[0], symbols[t].size(), nread);
+        std::reverse(taps[t].begin(), taps[t].end());
+
+        float corr = 0;
+        for(size_t i = 0; i < taps[t].size(); i++)
+          corr += abs(taps[t][i]*conj(taps[t][i]));
+        d_scale.push_back(1.0 / (0.9*corr*corr));
+      }
+
+      d_filter = new preamble_correlator(taps, freq_offsets);
+      d_corr.resize(d_filter->num_hypotheses());
+      d_corr_ptrs.resize(d_filter->num_hypotheses());
+
+      set_history(d_filter->ntaps());
+
+      const int alignment_multiple =
+        volk_get_alignment() / sizeof(gr_complex);
+      set_alignment(std::max(1,alignment_multiple));
+    }
+
+    correlate_and_sync_multi_cc_impl::~correlate_and_sync_multi_cc_impl()
+    {
+      delete d_filter;
+    }
+
+    int
+    correlate_and_sync_multi_cc_impl::work(int noutput_items,
+                                           gr_vector_const_void_star &input_items,
+                                           gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (gr_complex *)input_items[0];
+      gr_complex *out = (gr_complex*)output_items[0];
+      const size_t nfreqs = d_freqs.size();
+      const size_t nhyp = d_corr.size();
+
+      memcpy(out, in, sizeof(gr_complex)*noutput_items);
+
+      if((int)d_metric.size() < noutput_items) {
+        for(size_t h = 0; h < nhyp; h++) {
+          d_corr[h].resize(noutput_items);
+          d_corr_ptrs[h] = &d_corr[h][0];
+        }
+        d_mag.resize(noutput_items);
+        d_metric.resize(noutput_items);
+        d_best.resize(noutput_items);
+      }
+
+      // Correlate with all hypotheses at once
+      d_filter->filter(noutput_items, in, &d_corr_ptrs[0]);
+
+      // Keep the strongest hypothesis, relative to its threshold
+      for(size_t h = 0; h < nhyp; h++) {
+        volk_32fc_magnitude_squared_32f(&d_mag[0], d_corr_ptrs[h], noutput_items);
+        volk_32f_s32f_multiply_32f(&d_mag[0], &d_mag[0], d_scale[h/nfreqs], noutput_items);
+        for(int i = 0; i < noutput_items; i++) {
+          if(h == 0 || d_mag[i] > d_metric[i]) {
+            d_metric[i] = d_mag[i];
+            d_best[i] = h;
+          }
+        }
+      }
+
+      if(output_items.size() > 1) {
+        gr_complex *corr = (gr_complex*)output_items[1];
+        for(int i = 0; i < noutput_items; i++)
+          corr[i] = d_corr_ptrs[d_best[i]][i];
+      }
+
+      const float *metric = &d_metric[0];
+      int i = d_sps;
+      while(i < noutput_items-1) {
+        if((metric[i] - metric[i-d_sps]) > 1.0f) {
+          while(i < noutput_items-2 && metric[i] < metric[i+1])
+            i++;
+
+          double nom = 0, den = 0;
+          for(int s = 0; s < 3; s++) {
+            nom += (s+1)*metric[i+s-1];
+            den += metric[i+s-1];
+          }
+          double center = nom / den;
+          center = (center - 2.0);
+
+          int index = i;
+          int h = d_best[index];
+          gr_complex c = d_corr_ptrs[h][index];
+
+          float phase = fast_atan2f(c.imag(), c.real());
+          add_item_tag(0, nitems_written(0) + index, pmt::intern("phase_est"),
+                       pmt::from_double(phase), pmt::intern(alias()));
+          add_item_tag(0, nitems_written(0) + index, pmt::intern("time_est"),
+                       pmt::from_double(center), pmt::intern(alias()));
+          add_item_tag(0, nitems_written(0) + index, pmt::intern("corr_est"),
+                       pmt::from_double(std::norm(c)), pmt::intern(alias()));
+          add_item_tag(0, nitems_written(0) + index, pmt::intern("preamble"),
+                       pmt::from_long(h/nfreqs), pmt::intern(alias()));
+          add_item_tag(0, nitems_written(0) + index, pmt::intern("freq_est"),
+                       pmt::from_double(d_freqs[h%nfreqs]), pmt::intern(alias()));
+
+          i += d_sps;
+        }
+        else
+          i++;
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
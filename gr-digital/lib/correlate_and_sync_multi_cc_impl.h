@@ -0,0 +1,65 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CORRELATE_AND_SYNC_MULTI_CC_IMPL_H
+#define INCLUDED_DIGITAL_CORRELATE_AND_SYNC_MULTI_CC_IMPL_H
+
+#include <gnuradio/digital/correlate_and_sync_multi_cc.h>
+#include <gnuradio/digital/preamble_correlator.h>
+
+namespace gr {
+  namespace digital {
+
+    class correlate_and_sync_multi_cc_impl : public correlate_and_sync_multi_cc
+    {
+    private:
+      unsigned int d_sps;
+      std::vector<float> d_freqs;
+      std::vector<float> d_scale;     // 1/threshold of every preamble
+      preamble_correlator *d_filter;
+
+      std::vector<std::vector<gr_complex> > d_corr;
+      std::vector<gr_complex*> d_corr_ptrs;
+      std::vector<float> d_mag;
+      std::vector<float> d_metric;
+      std::vector<int> d_best;
+
+    public:
+      correlate_and_sync_multi_cc_impl(const std::vector<std::vector<gr_complex> > &symbols,
+                                       const std::vector<float> &filter,
+                                       unsigned int sps,
+                                       const std::vector<float> &freq_offsets,
+                                       unsigned int nfilts);
+      ~correlate_and_sync_multi_cc_impl();
+
+      size_t num_preambles() const { return d_scale.size(); }
+      std::vector<float> freq_offsets() const { return d_freqs; }
+
+      int work(int noutput_items,
+               gr_vector_const_void_star &input_items,
+               gr_vector_void_star &output_items);
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_CORRELATE_AND_SYNC_MULTI_CC_IMPL_H */
@@ -0,0 +1,121 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/digital/costas_loop_bank.h>
+#include <gnuradio/fxpt.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    costas_loop_bank::costas_loop_bank(unsigned int nchan, int order)
+      : d_nchan(nchan), d_order(order), d_freq_out(NULL), d_freq_out_len(0)
+    {
+      if(nchan == 0)
+	throw std::invalid_argument("costas_loop_bank: nchan must be > 0");
+      if(order != 1 && order != 2 && order != 4 && order != 8)
+	throw std::invalid_argument("costas_loop_bank: order must be 1, 2, 4, or 8");
+
+      d_phase = (gr_int32*)volk_malloc(sizeof(gr_int32)*nchan, volk_get_alignment());
+      d_freq = (float*)volk_malloc(sizeof(float)*nchan, volk_get_alignment());
+      set_gains(0, 0, -1, 1);
+      reset();
+    }
+
+    costas_loop_bank::~costas_loop_bank()
+    {
+      volk_free(d_phase);
+      volk_free(d_freq);
+      if(d_freq_out)
+	volk_free(d_freq_out);
+    }
+
+    void
+    costas_loop_bank::set_gains(float alpha, float beta, float min_freq, float max_freq)
+    {
+      d_gains[0] = alpha;
+      d_gains[1] = beta;
+      d_gains[2] = min_freq;
+      d_gains[3] = max_freq;
+    }
+
+    void
+    costas_loop_bank::reset()
+    {
+      memset(d_phase, 0, sizeof(gr_int32)*d_nchan);
+      memset(d_freq, 0, sizeof(float)*d_nchan);
+    }
+
+    void
+    costas_loop_bank::process(const gr_complex *in, gr_complex *out, float *freq_out,
+			      unsigned int nsteps)
+    {
+      const unsigned int n = nsteps * d_nchan;
+
+      if(freq_out == NULL) {
+	if(d_freq_out_len < n) {
+	  if(d_freq_out)
+	    volk_free(d_freq_out);
+	  d_freq_out = (float*)volk_malloc(sizeof(float)*n, volk_get_alignment());
+	  d_freq_out_len = n;
+	}
+	freq_out = d_freq_out;
+      }
+
+      volk_32fc_s32f_x2_costas_loop_32fc(out, freq_out, in, d_phase, d_freq,
+					 fxpt::sine_table(), d_gains,
+					 d_order, d_nchan, n);
+    }
+
+    float
+    costas_loop_bank::phase(unsigned int chan) const
+    {
+      return fxpt::fixed_to_float(d_phase[chan]);
+    }
+
+    void
+    costas_loop_bank::set_phase(unsigned int chan, float phase)
+    {
+      d_phase[chan] = fxpt::float_to_fixed(phase);
+    }
+
+    float
+    costas_loop_bank::frequency(unsigned int chan) const
+    {
+      return d_freq[chan];
+    }
+
+    void
+    costas_loop_bank::set_frequency(unsigned int chan, float freq)
+    {
+      d_freq[chan] = std::max(d_gains[2], std::min(freq, d_gains[3]));
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
@@ -0,0 +1,87 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "costas_loop_vcc_impl.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    costas_loop_vcc::sptr
+    costas_loop_vcc::make(int vlen, float loop_bw, int order)
+    {
+      return gnuradio::get_initial_sptr
+	(new costas_loop_vcc_impl(vlen, loop_bw, order));
+    }
+
+    costas_loop_vcc_impl::costas_loop_vcc_impl(int vlen, float loop_bw, int order)
+      : sync_block("costas_loop_vcc",
+                   io_signature::make(1, 1, sizeof(gr_complex)*vlen),
+                   io_signature::make2(1, 2, sizeof(gr_complex)*vlen, sizeof(float)*vlen)),
+	blocks::control_loop(loop_bw, 1.0, -1.0),
+	d_bank(vlen > 0 ? vlen : 0, order)
+    {
+    }
+
+    costas_loop_vcc_impl::~costas_loop_vcc_impl()
+    {
+    }
+
+    float
+    costas_loop_vcc_impl::phase(unsigned int chan) const
+    {
+      if(chan >= d_bank.nchan())
+	throw std::out_of_range("costas_loop_vcc: no such channel");
+      return d_bank.phase(chan);
+    }
+
+    float
+    costas_loop_vcc_impl::frequency(unsigned int chan) const
+    {
+      if(chan >= d_bank.nchan())
+	throw std::out_of_range("costas_loop_vcc: no such channel");
+      return d_bank.frequency(chan);
+    }
+
+    int
+    costas_loop_vcc_impl::work(int noutput_items,
+			       gr_vector_const_void_star &input_items,
+			       gr_vector_void_star &output_items)
+    {
+      const gr_complex *iptr = (gr_complex *) input_items[0];
+      gr_complex *optr = (gr_complex *) output_items[0];
+      float *foptr = output_items.size() >= 2 ? (float *) output_items[1] : NULL;
+
+      // The gains may have been changed through control_loop
+      d_bank.set_gains(d_alpha, d_beta, d_min_freq, d_max_freq);
+      d_bank.process(iptr, optr, foptr, noutput_items);
+
+      return noutput_items;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
@@ -0,0 +1,52 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_COSTAS_LOOP_VCC_IMPL_H
+#define INCLUDED_DIGITAL_COSTAS_LOOP_VCC_IMPL_H
+
+#include <gnuradio/digital/costas_loop_vcc.h>
+#include <gnuradio/digital/costas_loop_bank.h>
+
+namespace gr {
+  namespace digital {
+
+    class costas_loop_vcc_impl : public costas_loop_vcc
+    {
+    private:
+      costas_loop_bank d_bank;
+
+    public:
+      costas_loop_vcc_impl(int vlen, float loop_bw, int order);
+      ~costas_loop_vcc_impl();
+
+      float phase(unsigned int chan) const;
+      float frequency(unsigned int chan) const;
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace digital */
+} /* namespace gr */
+
+#endif /* INCLUDED_DIGITAL_COSTAS_LOOP_VCC_IMPL_H */
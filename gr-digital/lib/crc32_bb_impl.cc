@@ -42,6 +42,7 @@ namespace gr {
 		   io_signature::make(1, 1, sizeof (char)),
 		   lengthtagname),
 	d_check(check),
+	d_crc_impl(32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true),
 	d_npass(0), d_nfail(0)
     {
       set_tag_propagation_policy(TPP_DONT);
@@ -74,9 +75,7 @@ namespace gr {
       unsigned int crc;
 
       if (d_check) {
-        d_crc_impl.reset();
-        d_crc_impl.process_bytes(in, packet_length-4);
-        crc = d_crc_impl();
+        crc = d_crc_impl.compute(in, packet_length-4);
 	if (crc != *(unsigned int *)(in+packet_length-4)) { // Drop package
 	  d_nfail++;
 	  return 0;
@@ -84,9 +83,7 @@ namespace gr {
 	d_npass++;
 	memcpy((void *) out, (const void *) in, packet_length-4);
       } else {
-        d_crc_impl.reset();
-        d_crc_impl.process_bytes(in, packet_length);
-        crc = d_crc_impl();
+        crc = d_crc_impl.compute(in, packet_length);
 	memcpy((void *) out, (const void *) in, packet_length);
 	memcpy((void *) (out + packet_length), &crc, 4); // FIXME big-endian/little-endian, this might be wrong
       }
@@ -24,7 +24,7 @@
 #define INCLUDED_DIGITAL_CRC32_BB_IMPL_H
 
 #include <gnuradio/digital/crc32_bb.h>
-#include <boost/crc.hpp>
+#include <gnuradio/digital/crc_engine.h>
 
 namespace gr {
   namespace digital {
@@ -33,7 +33,7 @@ namespace gr {
     {
      private:
       bool d_check;
-      boost::crc_optimal<32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true>    d_crc_impl;
+      crc_engine d_crc_impl;
 
      public:
       crc32_bb_impl(bool check, const std::string& lengthtagname);
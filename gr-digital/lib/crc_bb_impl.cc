@@ -0,0 +1,131 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "crc_bb_impl.h"
+#include <string.h>
+
+namespace gr {
+  namespace digital {
+
+    crc_bb::sptr
+    crc_bb::make(int num_bits, unsigned int poly,
+		 unsigned int initial_value, unsigned int final_xor,
+		 bool input_reflected, bool result_reflected,
+		 bool check, const std::string& lengthtagname)
+    {
+      return gnuradio::get_initial_sptr
+	(new crc_bb_impl(num_bits, poly, initial_value, final_xor,
+			 input_reflected, result_reflected,
+			 check, lengthtagname));
+    }
+
+    crc_bb_impl::crc_bb_impl(int num_bits, unsigned int poly,
+			     unsigned int initial_value, unsigned int final_xor,
+			     bool input_reflected, bool result_reflected,
+			     bool check, const std::string& lengthtagname)
+      : tagged_stream_block("crc_bb",
+		   io_signature::make(1, 1, sizeof (char)),
+		   io_signature::make(1, 1, sizeof (char)),
+		   lengthtagname),
+	d_crc_impl(num_bits, poly, initial_value, final_xor,
+		   input_reflected, result_reflected),
+	d_check(check),
+	d_crc_len(d_crc_impl.num_bytes()),
+	d_npass(0), d_nfail(0)
+    {
+      set_tag_propagation_policy(TPP_DONT);
+    }
+
+    crc_bb_impl::~crc_bb_impl()
+    {
+    }
+
+    void
+    crc_bb_impl::write_crc(unsigned char *out, unsigned int crc) const
+    {
+      for (int i = 0; i < d_crc_len; i++) {
+	int shift = d_crc_impl.input_reflected() ? 8*i : 8*(d_crc_len-1-i);
+	out[i] = (crc >> shift) & 0xff;
+      }
+    }
+
+    int
+    crc_bb_impl::calculate_output_stream_length(const gr_vector_int &ninput_items)
+    {
+      if (d_check) {
+	return ninput_items[0] - d_crc_len;
+      } else {
+	return ninput_items[0] + d_crc_len;
+      }
+    }
+
+    int
+    crc_bb_impl::work (int noutput_items,
+                       gr_vector_int &ninput_items,
+                       gr_vector_const_void_star &input_items,
+                       gr_vector_void_star &output_items)
+    {
+      const unsigned char *in = (const unsigned char *) input_items[0];
+      unsigned char *out = (unsigned char *) output_items[0];
+      long packet_length = ninput_items[0];
+      int packet_size_diff = d_check ? -d_crc_len : d_crc_len;
+      unsigned char crc[4];
+
+      if (d_check) {
+	if (packet_length < d_crc_len) {
+	  d_nfail++;
+	  return 0;
+	}
+	write_crc(crc, d_crc_impl.compute(in, packet_length-d_crc_len));
+	if (memcmp(crc, in+packet_length-d_crc_len, d_crc_len) != 0) { // Drop package
+	  d_nfail++;
+	  return 0;
+	}
+	d_npass++;
+	memcpy((void *) out, (const void *) in, packet_length-d_crc_len);
+      } else {
+	memcpy((void *) out, (const void *) in, packet_length);
+	write_crc(out + packet_length, d_crc_impl.compute(in, packet_length));
+      }
+
+      std::vector<tag_t> tags;
+      get_tags_in_range(tags, 0, nitems_read(0), nitems_read(0)+packet_length);
+      for (size_t i = 0; i < tags.size(); i++) {
+	tags[i].offset -= nitems_read(0);
+	if (d_check && tags[i].offset >= (unsigned int)(packet_length+packet_size_diff)) {
+	  tags[i].offset = packet_length+packet_size_diff-1;
+	}
+	add_item_tag(0, nitems_written(0) + tags[i].offset,
+	    tags[i].key,
+	    tags[i].value);
+      }
+
+      return packet_length + packet_size_diff;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
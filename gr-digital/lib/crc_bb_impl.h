@@ -0,0 +1,63 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_CRC_BB_IMPL_H
+#define INCLUDED_DIGITAL_CRC_BB_IMPL_H
+
+#include <gnuradio/digital/crc_bb.h>
+#include <gnuradio/digital/crc_engine.h>
+
+namespace gr {
+  namespace digital {
+
+    class crc_bb_impl : public crc_bb
+    {
+     private:
+      crc_engine d_crc_impl;
+      bool d_check;
+      int d_crc_len;
+      uint64_t d_npass;
+      uint64_t d_nfail;
+
+      void write_crc(unsigned char *out, unsigned int crc) const;
+
+     public:
+      crc_bb_impl(int num_bits, unsigned int poly,
+		  unsigned int initial_value, unsigned int final_xor,
+		  bool input_reflected, bool result_reflected,
+		  bool check, const std::string& lengthtagname);
+      ~crc_bb_impl();
+
+      uint64_t num_passed() const { return d_npass; }
+      uint64_t num_failed() const { return d_nfail; }
+
+      int calculate_output_stream_length(const gr_vector_int &ninput_items);
+      int work(int noutput_items,
+	       gr_vector_int &ninput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_CRC_BB_IMPL_H */
@@ -0,0 +1,166 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/digital/crc_engine.h>
+#include <volk/volk.h>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    // Layout of the tables, see volk_8u_x2_crc_32u
+    static const unsigned int TABLE_OFFSET = 16;
+
+    static unsigned int
+    reflect(unsigned int v, unsigned int nbits)
+    {
+      unsigned int r = 0;
+      for(unsigned int i = 0; i < nbits; i++)
+	r |= ((v >> i) & 1) << (nbits - 1 - i);
+      return r;
+    }
+
+    static uint64_t
+    reflect64(uint64_t v)
+    {
+      uint64_t r = 0;
+      for(unsigned int i = 0; i < 64; i++)
+	r |= ((v >> i) & 1) << (63 - i);
+      return r;
+    }
+
+    // x^k mod poly, poly including its x^degree term
+    static uint64_t
+    xpow_mod(unsigned int k, unsigned int degree, uint64_t poly)
+    {
+      uint64_t r = 1;
+      for(; k > 0; k--) {
+	r <<= 1;
+	if((r >> degree) & 1)
+	  r ^= poly;
+      }
+      return r;
+    }
+
+    crc_engine::crc_engine(unsigned int num_bits, unsigned int poly,
+			   unsigned int initial_value, unsigned int final_xor,
+			   bool input_reflected, bool result_reflected)
+      : d_num_bits(num_bits), d_input_reflected(input_reflected),
+	d_result_reflected(result_reflected)
+    {
+      if(num_bits < 1 || num_bits > 32)
+	throw std::invalid_argument("crc_engine: num_bits must be between 1 and 32");
+
+      d_mask = num_bits == 32 ? 0xffffffff : (1U << num_bits) - 1;
+      d_poly = poly & d_mask;
+      d_initial_value = initial_value & d_mask;
+      d_final_xor = final_xor & d_mask;
+      d_shift = input_reflected ? 0 : 32 - num_bits;
+      d_initial_register = input_reflected ? reflect(d_initial_value, num_bits)
+	: d_initial_value << d_shift;
+
+      d_tables.resize(TABLE_OFFSET + 8*256, 0);
+      unsigned int *t = &d_tables[TABLE_OFFSET];
+      uint64_t k[4];
+
+      d_tables[0] = input_reflected ? 1 : 0;
+      if(input_reflected) {
+	const unsigned int rpoly = reflect(d_poly, num_bits);
+	const uint64_t full = ((uint64_t)1 << num_bits) | d_poly;
+	for(unsigned int n = 0; n < 256; n++) {
+	  unsigned int c = n;
+	  for(int b = 0; b < 8; b++)
+	    c = (c & 1) ? (c >> 1) ^ rpoly : c >> 1;
+	  t[n] = c;
+	}
+	// The folding constants are one power lower to account for the
+	// bit reversed carry-less products
+	k[0] = reflect64(xpow_mod(575, num_bits, full));
+	k[1] = reflect64(xpow_mod(511, num_bits, full));
+	k[2] = reflect64(xpow_mod(191, num_bits, full));
+	k[3] = reflect64(xpow_mod(127, num_bits, full));
+      }
+      else {
+	// Work on P*x^(32-num_bits) so the register is always 32 bits
+	const unsigned int p = d_poly << d_shift;
+	const uint64_t full = ((uint64_t)1 << 32) | p;
+	for(unsigned int n = 0; n < 256; n++) {
+	  unsigned int c = n << 24;
+	  for(int b = 0; b < 8; b++)
+	    c = (c & 0x80000000) ? (c << 1) ^ p : c << 1;
+	  t[n] = c;
+	}
+	k[0] = xpow_mod(512, 32, full);
+	k[1] = xpow_mod(576, 32, full);
+	k[2] = xpow_mod(128, 32, full);
+	k[3] = xpow_mod(192, 32, full);
+      }
+      for(int n = 0; n < 4; n++) {
+	d_tables[2 + 2*n] = (unsigned int)k[n];
+	d_tables[3 + 2*n] = (unsigned int)(k[n] >> 32);
+      }
+
+      // Table j advances a byte through j more zero bytes
+      for(unsigned int n = 256; n < 8*256; n++) {
+	unsigned int c = t[n - 256];
+	t[n] = input_reflected ? (c >> 8) ^ t[c & 0xff] : (c << 8) ^ t[c >> 24];
+      }
+    }
+
+    crc_engine::~crc_engine()
+    {
+    }
+
+    unsigned int
+    crc_engine::update(unsigned int reg, const unsigned char *data, size_t len) const
+    {
+      volk_8u_x2_crc_32u(&reg, data, &d_tables[0], len);
+      return reg;
+    }
+
+    unsigned int
+    crc_engine::finalize(unsigned int reg) const
+    {
+      unsigned int crc = reg >> d_shift;
+      if(d_result_reflected != d_input_reflected)
+	crc = reflect(crc, d_num_bits);
+      return (crc ^ d_final_xor) & d_mask;
+    }
+
+    unsigned int
+    crc_engine::compute(const unsigned char *data, size_t len) const
+    {
+      return finalize(update(d_initial_register, data, len));
+    }
+
+    unsigned int
+    crc_engine::compute(const std::string &data) const
+    {
+      return compute((const unsigned char *)data.data(), data.size());
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
@@ -26,7 +26,6 @@
 
 #include "kurtotic_equalizer_cc_impl.h"
 #include <gnuradio/io_signature.h>
-#include <volk/volk.h>
 
 namespace gr {
   namespace digital {
@@ -43,12 +42,13 @@ namespace gr {
 			  io_signature::make(1, 1, sizeof(gr_complex)),
 			  io_signature::make(1, 1, sizeof(gr_complex)),
 			  1),
-	filter::kernel::fir_filter_ccc(1, std::vector<gr_complex>(num_taps, gr_complex(0,0)))
+	adaptive_equalizer(num_taps, 1)
     {
       set_gain(mu);
+      std::vector<gr_complex> taps(num_taps, gr_complex(0,0));
       if(num_taps > 0)
-	d_taps[0] = 1.0;
-      set_taps(d_taps);
+	taps[num_taps-1] = 1.0;
+      set_taps(taps);
 
       d_alpha_p = 0.01;
       d_alpha_q = 0.01;
@@ -59,9 +59,6 @@ namespace gr {
       d_q = gr_complex(0,0);
       d_u = gr_complex(0,0);
 
-      const int alignment_multiple =
-	volk_get_alignment() / sizeof(gr_complex);
-      set_alignment(std::max(1,alignment_multiple));
       set_history(num_taps+1);
     }
 
@@ -77,18 +74,7 @@ namespace gr {
       gr_complex *in = (gr_complex *)input_items[0];
       gr_complex *out = (gr_complex *)output_items[0];
 
-      int j = 0, k, l = d_taps.size();
-      for(int i = 0; i < noutput_items; i++) {
-	out[i] = filter(&in[j]);
-
-	// Adjust taps
-	d_error = error(out[i]);
-	for(k = 0; k < l; k++) {
-	  update_tap(d_taps[l-k-1], in[j+k]);
-	}
-
-	j += decimation();
-      }
+      equalize(in, out, noutput_items);
 
       return noutput_items;
     }
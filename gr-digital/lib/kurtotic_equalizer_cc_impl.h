@@ -24,7 +24,7 @@
 #define	INCLUDED_DIGITAL_KURTOTIC_EQUALIZER_CC_IMPL_H
 
 #include <gnuradio/digital/kurtotic_equalizer_cc.h>
-#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/digital/adaptive_equalizer.h>
 #include <gnuradio/math.h>
 #include <stdexcept>
 
@@ -32,10 +32,9 @@ namespace gr {
   namespace digital {
 
     class kurtotic_equalizer_cc_impl
-      : public kurtotic_equalizer_cc, filter::kernel::fir_filter_ccc
+      : public kurtotic_equalizer_cc, adaptive_equalizer
     {
     private:
-      std::vector<gr_complex> d_new_taps;
       gr_complex d_error;
 
       float d_mu;
@@ -45,9 +44,7 @@ namespace gr {
 
       gr_complex sign(gr_complex x)
       {
-	float re = (float)(x.real() >= 0.0f);
-	float im = (float)(x.imag() >= 0.0f);
-	return gr_complex(re, im);
+	return gr_complex(x.real() >= 0.0f ? 1.0f : -1.0f, 0.0f);
       }
 
     protected:
@@ -81,6 +78,14 @@ namespace gr {
       {
 	tap += d_mu*in*d_error;
       }
+
+      // update_tap() is written for y = sum conj(tap) * in; the engine
+      // computes y = sum tap * in, so its taps are the conjugates.
+      gr_complex step(const gr_complex &out, gr_complex &decision)
+      {
+	d_error = error(out);
+	return d_mu*conj(d_error);
+      }
   
     public:
       kurtotic_equalizer_cc_impl(int num_taps, float mu);
@@ -26,14 +26,10 @@
 
 #include "lms_dd_equalizer_cc_impl.h"
 #include <gnuradio/io_signature.h>
-#include <gnuradio/misc.h>
-#include <volk/volk.h>
 
 namespace gr {
   namespace digital {
 
-    using namespace filter::kernel;
-
     lms_dd_equalizer_cc::sptr
     lms_dd_equalizer_cc::make(int num_taps, float mu, int sps,
 			      constellation_sptr cnst)
@@ -49,18 +45,14 @@ namespace gr {
 			  io_signature::make(1, 1, sizeof(gr_complex)),
 			  io_signature::make(1, 1, sizeof(gr_complex)),
 			  sps),
-	fir_filter_ccc(sps, std::vector<gr_complex>(num_taps, gr_complex(0,0))),
+	adaptive_equalizer(num_taps, sps),
 	d_new_taps(num_taps, gr_complex(0,0)),
 	d_updated(false), d_cnst(cnst)
     {
       set_gain(mu);
       if(num_taps > 0)
-	d_new_taps[0] = 1.0;
-      fir_filter_ccc::set_taps(d_new_taps);
-
-      const int alignment_multiple =
-	volk_get_alignment() / sizeof(gr_complex);
-      set_alignment(std::max(1,alignment_multiple));
+	d_new_taps[num_taps-1] = 1.0;
+      adaptive_equalizer::set_taps(d_new_taps);
 
       set_history(num_taps);
     }
@@ -79,7 +71,7 @@ namespace gr {
     std::vector<gr_complex>
     lms_dd_equalizer_cc_impl::taps() const
     {
-      return d_taps;
+      return adaptive_equalizer::taps();
     }
 
     gr_complex
@@ -97,6 +89,14 @@ namespace gr {
       tap += d_mu*conj(in)*d_error;
     }
 
+    gr_complex
+    lms_dd_equalizer_cc_impl::step(const gr_complex &out, gr_complex &decision)
+    {
+      d_cnst->map_to_points(d_cnst->decision_maker(&out), &decision);
+      d_error = decision - out;
+      return d_mu*d_error;
+    }
+
     int
     lms_dd_equalizer_cc_impl::work(int noutput_items,
 				   gr_vector_const_void_star &input_items,
@@ -106,29 +106,13 @@ namespace gr {
       gr_complex *out = (gr_complex *)output_items[0];
 
       if(d_updated) {
-	d_taps = d_new_taps;
-	set_history(d_taps.size());
+	adaptive_equalizer::set_taps(d_new_taps);
+	set_history(d_new_taps.size());
 	d_updated = false;
 	return 0;		     // history requirements may have changed.
       }
 
-      int j = 0;
-      size_t k, l = d_taps.size();
-      for(int i = 0; i < noutput_items; i++) {
-	out[i] = filter(&in[j]);
-
-	// Adjust taps
-	d_error = error(out[i]);
-	for(k = 0; k < l; k++) {
-	  // Update tap locally from error.
-	  update_tap(d_taps[k], in[j+k]);
-
-	  // Update aligned taps in filter object.
-	  fir_filter_ccc::update_tap(d_taps[k], k);
-	}
-
-	j += decimation();
-      }
+      equalize(in, out, noutput_items);
 
       return noutput_items;
     }
@@ -24,14 +24,14 @@
 #define INCLUDED_DIGITAL_LMS_DD_EQUALIZER_CC_IMPL_H
 
 #include <gnuradio/digital/lms_dd_equalizer_cc.h>
-#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/digital/adaptive_equalizer.h>
 #include <stdexcept>
 
 namespace gr {
   namespace digital {
 
     class lms_dd_equalizer_cc_impl
-      : public lms_dd_equalizer_cc, filter::kernel::fir_filter_ccc
+      : public lms_dd_equalizer_cc, adaptive_equalizer
     {
     private:
       std::vector<gr_complex> d_new_taps;
@@ -44,6 +44,7 @@ namespace gr {
     protected:
       gr_complex error(const gr_complex &out);
       void update_tap(gr_complex &tap, const gr_complex &in);
+      gr_complex step(const gr_complex &out, gr_complex &decision);
 
     public:
       lms_dd_equalizer_cc_impl(int num_taps,
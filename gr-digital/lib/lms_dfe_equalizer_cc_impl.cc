@@ -0,0 +1,136 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "lms_dfe_equalizer_cc_impl.h"
+#include <gnuradio/io_signature.h>
+
+namespace gr {
+  namespace digital {
+
+    lms_dfe_equalizer_cc::sptr
+    lms_dfe_equalizer_cc::make(int num_ff_taps, int num_fb_taps,
+			       float mu, int sps,
+			       constellation_sptr cnst,
+			       int block_size)
+    {
+      return gnuradio::get_initial_sptr
+	(new lms_dfe_equalizer_cc_impl(num_ff_taps, num_fb_taps, mu, sps,
+				       cnst, block_size));
+    }
+
+    lms_dfe_equalizer_cc_impl::lms_dfe_equalizer_cc_impl(int num_ff_taps, int num_fb_taps,
+							 float mu, int sps,
+							 constellation_sptr cnst,
+							 int block_size)
+      : sync_decimator("lms_dfe_equalizer_cc",
+			  io_signature::make(1, 1, sizeof(gr_complex)),
+			  io_signature::make(1, 1, sizeof(gr_complex)),
+			  sps),
+	adaptive_equalizer(num_ff_taps, sps, num_fb_taps),
+	d_new_taps(num_ff_taps, gr_complex(0,0)),
+	d_new_fb_taps(num_fb_taps, gr_complex(0,0)),
+	d_updated(false), d_fb_updated(false), d_cnst(cnst)
+    {
+      if(num_fb_taps < 0)
+	throw std::out_of_range("lms_dfe_equalizer_cc: num_fb_taps must be >= 0");
+      if(block_size < 1)
+	throw std::out_of_range("lms_dfe_equalizer_cc: block_size must be > 0");
+
+      set_gain(mu);
+      if(num_ff_taps > 0)
+	d_new_taps[num_ff_taps-1] = 1.0;
+      adaptive_equalizer::set_taps(d_new_taps);
+
+      adaptive_equalizer::set_block_size(block_size);
+      set_output_multiple(block_size);
+      set_history(num_ff_taps);
+    }
+
+    lms_dfe_equalizer_cc_impl::~lms_dfe_equalizer_cc_impl()
+    {
+    }
+
+    void
+    lms_dfe_equalizer_cc_impl::set_taps(const std::vector<gr_complex> &taps)
+    {
+      d_new_taps = taps;
+      d_updated = true;
+    }
+
+    std::vector<gr_complex>
+    lms_dfe_equalizer_cc_impl::taps() const
+    {
+      return adaptive_equalizer::taps();
+    }
+
+    void
+    lms_dfe_equalizer_cc_impl::set_feedback_taps(const std::vector<gr_complex> &taps)
+    {
+      d_new_fb_taps = taps;
+      d_fb_updated = true;
+    }
+
+    std::vector<gr_complex>
+    lms_dfe_equalizer_cc_impl::feedback_taps() const
+    {
+      return adaptive_equalizer::feedback_taps();
+    }
+
+    gr_complex
+    lms_dfe_equalizer_cc_impl::step(const gr_complex &out, gr_complex &decision)
+    {
+      d_cnst->map_to_points(d_cnst->decision_maker(&out), &decision);
+      return d_mu*(decision - out);
+    }
+
+    int
+    lms_dfe_equalizer_cc_impl::work(int noutput_items,
+				    gr_vector_const_void_star &input_items,
+				    gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *)input_items[0];
+      gr_complex *out = (gr_complex *)output_items[0];
+
+      if(d_updated) {
+	adaptive_equalizer::set_taps(d_new_taps);
+	set_history(d_new_taps.size());
+	d_updated = false;
+	return 0;		     // history requirements may have changed.
+      }
+
+      if(d_fb_updated) {
+	adaptive_equalizer::set_feedback_taps(d_new_fb_taps);
+	d_fb_updated = false;
+      }
+
+      equalize(in, out, noutput_items);
+
+      return noutput_items;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
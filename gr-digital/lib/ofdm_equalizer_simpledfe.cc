@@ -64,8 +64,11 @@ namespace gr {
 	bool input_is_shifted)
       : ofdm_equalizer_1d_pilots(fft_len, occupied_carriers, pilot_carriers, pilot_symbols, symbols_skipped, input_is_shifted),
 	  d_constellation(constellation),
-	  d_alpha(alpha)
+	  d_alpha(alpha),
+	  d_sym_eq(fft_len),
+	  d_decisions(fft_len)
     {
+      d_data_carriers.reserve(fft_len);
     }
 
 
@@ -83,9 +86,12 @@ namespace gr {
       if (!initial_taps.empty()) {
 	d_channel_state = initial_taps;
       }
-      gr_complex sym_eq, sym_est;
+      gr_complex sym_est;
 
       for (int i = 0; i < n_sym; i++) {
+	// Every carrier only depends on its own channel state, so the
+	// data carriers of a symbol are decided on together.
+	d_data_carriers.clear();
 	for (int k = 0; k < d_fft_len; k++) {
 	  if (!d_occupied_carriers[k]) {
 	    continue;
@@ -95,13 +101,20 @@ namespace gr {
 			       + (1-d_alpha) * frame[i*d_fft_len + k] / d_pilot_symbols[d_pilot_carr_set][k];
 	    frame[i*d_fft_len+k] = d_pilot_symbols[d_pilot_carr_set][k];
 	  } else {
-	    sym_eq = frame[i*d_fft_len+k] / d_channel_state[k];
-	    d_constellation->map_to_points(d_constellation->decision_maker(&sym_eq), &sym_est);
-	    d_channel_state[k] = d_alpha * d_channel_state[k]
-                               + (1-d_alpha) * frame[i*d_fft_len + k] / sym_est;
-	    frame[i*d_fft_len+k] = sym_est;
+	    d_sym_eq[d_data_carriers.size()] = frame[i*d_fft_len+k] / d_channel_state[k];
+	    d_data_carriers.push_back(k);
 	  }
 	}
+	if (!d_data_carriers.empty()) {
+	  d_constellation->decision_maker_n(&d_sym_eq[0], &d_decisions[0], d_data_carriers.size());
+	}
+	for (size_t c = 0; c < d_data_carriers.size(); c++) {
+	  const int k = d_data_carriers[c];
+	  d_constellation->map_to_points(d_decisions[c], &sym_est);
+	  d_channel_state[k] = d_alpha * d_channel_state[k]
+			     + (1-d_alpha) * frame[i*d_fft_len + k] / sym_est;
+	  frame[i*d_fft_len+k] = sym_est;
+	}
 	if (!d_pilot_carriers.empty()) {
 	  d_pilot_carr_set = (d_pilot_carr_set + 1) % d_pilot_carriers.size();
 	}
@@ -0,0 +1,183 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/io_signature.h>
+#include "ofdm_sync_sc_fused_cfb_impl.h"
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+namespace gr {
+  namespace digital {
+
+    ofdm_sync_sc_fused_cfb::sptr
+    ofdm_sync_sc_fused_cfb::make(int fft_len, int cp_len, bool use_even_carriers, float threshold)
+    {
+      return gnuradio::get_initial_sptr
+	(new ofdm_sync_sc_fused_cfb_impl(fft_len, cp_len, use_even_carriers, threshold));
+    }
+
+    static std::vector<int>
+    output_sizes()
+    {
+      std::vector<int> sizes;
+      sizes.push_back(sizeof(float));
+      sizes.push_back(sizeof(unsigned char));
+      sizes.push_back(sizeof(float));
+      return sizes;
+    }
+
+    ofdm_sync_sc_fused_cfb_impl::ofdm_sync_sc_fused_cfb_impl(int fft_len, int cp_len,
+							     bool use_even_carriers, float threshold)
+      : block("ofdm_sync_sc_fused_cfb",
+	      io_signature::make(1, 1, sizeof(gr_complex)),
+	      io_signature::makev(2, 3, output_sizes())),
+	d_fft_len(fft_len),
+	d_cp_len(cp_len),
+	d_sign(use_even_carriers ? 1.0 : -1.0),
+	d_threshold(threshold),
+	d_corr(0),
+	d_energy(0),
+	d_since_resync(0),
+	d_nzeros(fft_len),
+	d_hold(0)
+    {
+      if(fft_len < 2 || fft_len % 2)
+	throw std::invalid_argument("ofdm_sync_sc_fused_cfb: fft_len must be even and positive");
+      if(cp_len < 0)
+	throw std::invalid_argument("ofdm_sync_sc_fused_cfb: cp_len must not be negative");
+
+      // The oldest sample of the energy window is fft_len samples back
+      set_history(fft_len + 1);
+    }
+
+    ofdm_sync_sc_fused_cfb_impl::~ofdm_sync_sc_fused_cfb_impl()
+    {
+    }
+
+    void
+    ofdm_sync_sc_fused_cfb_impl::forecast(int noutput_items, gr_vector_int &ninput_items_required)
+    {
+      // The plateau detection needs to see past the end of a plateau
+      ninput_items_required[0] = std::max(2*d_cp_len, 1);
+    }
+
+    // Compute both sums over the windows ending at x[0]
+    void
+    ofdm_sync_sc_fused_cfb_impl::resync(const gr_complex *x)
+    {
+      const int half = d_fft_len/2;
+      gr_complex corr, energy;
+
+      volk_32fc_x2_conjugate_dot_prod_32fc(&corr, x - half + 1, x - d_fft_len + 1, half);
+      volk_32fc_x2_conjugate_dot_prod_32fc(&energy, x - d_fft_len + 1, x - d_fft_len + 1, d_fft_len);
+      d_corr = std::complex<double>(corr.real(), corr.imag());
+      d_energy = energy.real();
+      d_since_resync = 0;
+    }
+
+    void
+    ofdm_sync_sc_fused_cfb_impl::compute(const gr_complex *in, int ninput)
+    {
+      const int half = d_fft_len/2;
+
+      for(int i = d_metric.size(); i < ninput; i++) {
+	const gr_complex *x = &in[i + d_fft_len];
+
+	// Slide both windows by one sample
+	gr_complex c_new = x[0] * std::conj(x[-half]);
+	gr_complex c_old = x[-half] * std::conj(x[-d_fft_len]);
+	d_corr += std::complex<double>(c_new.real() - c_old.real(), c_new.imag() - c_old.imag());
+	d_energy += (double)std::norm(x[0]) - (double)std::norm(x[-d_fft_len]);
+
+	d_nzeros = (x[0] == gr_complex(0)) ? d_nzeros + 1 : 0;
+	if(d_nzeros >= d_fft_len) {
+	  d_corr = 0;
+	  d_energy = 0;
+	  d_since_resync = 0;
+	}
+	else if(++d_since_resync >= d_fft_len) {
+	  resync(x);
+	}
+
+	double r = 0.5*d_energy;
+	d_metric.push_back(r > 0 ? std::norm(d_corr) / (r*r) : 0);
+	d_angle.push_back(std::arg(d_sign * d_corr));
+      }
+    }
+
+    int
+    ofdm_sync_sc_fused_cfb_impl::general_work(int noutput_items,
+					      gr_vector_int &ninput_items,
+					      gr_vector_const_void_star &input_items,
+					      gr_vector_void_star &output_items)
+    {
+      const gr_complex *in = (const gr_complex *) input_items[0];
+      float *out_freq = (float *) output_items[0];
+      unsigned char *out_detect = (unsigned char *) output_items[1];
+      float *out_metric = output_items.size() > 2 ? (float *) output_items[2] : NULL;
+      int n = std::min(noutput_items, ninput_items[0]);
+      int i, flank_start;
+
+      compute(in, n);
+
+      // Plateau detection as in blocks::plateau_detector_fb
+      memset((void *) out_detect, 0x00, n);
+      for(i = 0; i < n; i++) {
+	if(d_metric[i] >= d_threshold) {
+	  if(n - i < 2*d_cp_len) { // If we can't finish, come back later
+	    break;
+	  }
+	  flank_start = i;
+	  while(i < n && d_metric[i] >= d_threshold)
+	    i++;
+	  if((i - flank_start) > 1) { // 1 Sample is not a plateau
+	    out_detect[flank_start + (i-flank_start)/2] = 1;
+	    i = std::min(i + d_cp_len, n - 1);
+	  }
+	}
+      }
+      // A one-sample crossing at the end leaves i past n
+      i = std::min(i, n);
+
+      // Hold the angle of the correlation at each detection
+      for(int j = 0; j < i; j++) {
+	if(out_detect[j])
+	  d_hold = d_angle[j];
+	out_freq[j] = d_hold;
+	if(out_metric)
+	  out_metric[j] = d_metric[j];
+      }
+
+      d_metric.erase(d_metric.begin(), d_metric.begin() + i);
+      d_angle.erase(d_angle.begin(), d_angle.begin() + i);
+      consume_each(i);
+      return i;
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
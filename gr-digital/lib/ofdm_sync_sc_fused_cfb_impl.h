@@ -0,0 +1,73 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_DIGITAL_OFDM_SYNC_SC_FUSED_CFB_IMPL_H
+#define INCLUDED_DIGITAL_OFDM_SYNC_SC_FUSED_CFB_IMPL_H
+
+#include <gnuradio/digital/ofdm_sync_sc_fused_cfb.h>
+#include <complex>
+#include <vector>
+
+namespace gr {
+  namespace digital {
+
+    class ofdm_sync_sc_fused_cfb_impl : public ofdm_sync_sc_fused_cfb
+    {
+     private:
+      int d_fft_len;
+      int d_cp_len;
+      double d_sign;
+      float d_threshold;
+
+      // Running sums over the windows ending at the last computed sample
+      std::complex<double> d_corr;
+      double d_energy;
+      int d_since_resync;
+      int d_nzeros;
+
+      // Timing metric and angle of the samples computed but not yet
+      // consumed, which are at the start of the next input buffer
+      std::vector<float> d_metric;
+      std::vector<float> d_angle;
+      float d_hold;
+
+      void resync(const gr_complex *in);
+      void compute(const gr_complex *in, int ninput);
+
+     public:
+      ofdm_sync_sc_fused_cfb_impl(int fft_len, int cp_len, bool use_even_carriers, float threshold);
+      ~ofdm_sync_sc_fused_cfb_impl();
+
+      void set_threshold(float threshold) { d_threshold = threshold; }
+      float threshold() const { return d_threshold; }
+
+      void forecast(int noutput_items, gr_vector_int &ninput_items_required);
+      int general_work(int noutput_items,
+		       gr_vector_int &ninput_items,
+		       gr_vector_const_void_star &input_items,
+		       gr_vector_void_star &output_items);
+    };
+
+  } // namespace digital
+} // namespace gr
+
+#endif /* INCLUDED_DIGITAL_OFDM_SYNC_SC_FUSED_CFB_IMPL_H */
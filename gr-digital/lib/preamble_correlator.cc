@@ -0,0 +1,189 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/digital/preamble_correlator.h>
+#include <gnuradio/filter/fir_filter.h>
+#include <gnuradio/fft/fft.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    // Cost of one point of one radix-2 FFT stage, in complex
+    // multiply-accumulates of the direct form.  Twice the butterfly
+    // count, for the copies and the cache misses of large FFTs; a
+    // single tap set goes to the FFT from about 48 taps.
+    static const double FFT_POINT_COST = 2.0;
+
+    // Largest FFT tried unless the taps need a longer one
+    static const unsigned int MAX_FFT_SIZE = 8192;
+
+    preamble_correlator::preamble_correlator(const std::vector<std::vector<gr_complex> > &taps,
+					     const std::vector<float> &freq_offsets,
+					     mode_t mode)
+      : d_mode(mode), d_ntaps(0), d_ntapsets(0), d_nfreqs(0),
+	d_fwdfft(0), d_invfft(0), d_fftsize(0), d_nsamples(0),
+	d_xformed_taps(0)
+    {
+      set_taps(taps, freq_offsets);
+    }
+
+    preamble_correlator::~preamble_correlator()
+    {
+      clear();
+    }
+
+    void
+    preamble_correlator::clear()
+    {
+      for(size_t h = 0; h < d_filters.size(); h++)
+	delete d_filters[h];
+      d_filters.clear();
+      delete d_fwdfft;
+      delete d_invfft;
+      d_fwdfft = d_invfft = 0;
+      if(d_xformed_taps)
+	volk_free(d_xformed_taps);
+      d_xformed_taps = 0;
+      d_fftsize = d_nsamples = 0;
+    }
+
+    void
+    preamble_correlator::set_taps(const std::vector<std::vector<gr_complex> > &taps,
+				  const std::vector<float> &freq_offsets)
+    {
+      if(taps.empty() || freq_offsets.empty())
+	throw std::invalid_argument("preamble_correlator: no taps or frequency offsets");
+
+      unsigned int ntaps = 0;
+      for(size_t t = 0; t < taps.size(); t++)
+	ntaps = std::max(ntaps, (unsigned int)taps[t].size());
+      if(ntaps == 0)
+	throw std::invalid_argument("preamble_correlator: empty taps");
+
+      const size_t nhyp = taps.size() * freq_offsets.size();
+      std::vector<std::vector<gr_complex> > hyp(nhyp, std::vector<gr_complex>(ntaps, 0));
+      for(size_t t = 0; t < taps.size(); t++) {
+	const size_t len = taps[t].size();
+	for(size_t f = 0; f < freq_offsets.size(); f++) {
+	  for(size_t k = 0; k < len; k++) {
+	    hyp[t*freq_offsets.size() + f][k] =
+	      taps[t][k] * std::polar(1.0f, -freq_offsets[f]*(len - 1 - k));
+	  }
+	}
+      }
+
+      clear();
+      d_ntaps = ntaps;
+      d_ntapsets = taps.size();
+      d_nfreqs = freq_offsets.size();
+
+      // Direct form costs ntaps MACs per output and hypothesis.  The
+      // FFT form costs a forward FFT shared by all hypotheses plus a
+      // multiply and an inverse FFT each, spread over the
+      // fftsize - ntaps + 1 outputs of one block.
+      unsigned int p2 = 1;
+      while(p2 < ntaps)
+	p2 <<= 1;
+      const unsigned int max_size = std::max(2*p2, MAX_FFT_SIZE);
+      double best = d_mode == FFT ? -1 : double(nhyp) * ntaps;
+      unsigned int fftsize = 0;
+      if(d_mode != DIRECT) {
+	for(unsigned int size = 2*p2; size <= max_size; size <<= 1) {
+	  double cost = (FFT_POINT_COST * (nhyp + 1) * size * log(double(size)) / log(2.0)
+			 + double(nhyp) * size) / (size - ntaps + 1);
+	  if(best < 0 || cost < best) {
+	    best = cost;
+	    fftsize = size;
+	  }
+	}
+      }
+
+      if(fftsize == 0) {
+	for(size_t h = 0; h < nhyp; h++)
+	  d_filters.push_back(new filter::kernel::fir_filter_ccc(1, hyp[h]));
+	return;
+      }
+
+      d_fftsize = fftsize;
+      d_nsamples = fftsize - ntaps + 1;
+      d_fwdfft = new fft::fft_complex(fftsize, true);
+      d_invfft = new fft::fft_complex(fftsize, false);
+      d_xformed_taps = (gr_complex*)volk_malloc(sizeof(gr_complex)*fftsize*nhyp,
+						volk_get_alignment());
+
+      // The inverse FFT is not normalized; do it here once
+      const float scale = 1.0 / fftsize;
+      gr_complex *in = d_fwdfft->get_inbuf();
+      for(size_t h = 0; h < nhyp; h++) {
+	for(unsigned int k = 0; k < ntaps; k++)
+	  in[k] = hyp[h][k] * scale;
+	std::fill(in + ntaps, in + fftsize, gr_complex(0));
+	d_fwdfft->execute();
+	memcpy(d_xformed_taps + h*fftsize, d_fwdfft->get_outbuf(),
+	       sizeof(gr_complex)*fftsize);
+      }
+    }
+
+    void
+    preamble_correlator::filter(unsigned int n, const gr_complex *in, gr_complex *const *out)
+    {
+      const size_t nhyp = num_hypotheses();
+
+      if(!use_fft()) {
+	for(size_t h = 0; h < nhyp; h++)
+	  d_filters[h]->filterN(out[h], in, n);
+	return;
+      }
+
+      // Overlap-save: of every circular convolution of fftsize input
+      // samples the first ntaps - 1 outputs wrap around and are
+      // dropped; the history supplies those samples again.
+      gr_complex *fwd_in = d_fwdfft->get_inbuf();
+      const gr_complex *fwd_out = d_fwdfft->get_outbuf();
+      gr_complex *inv_in = d_invfft->get_inbuf();
+      const gr_complex *inv_out = d_invfft->get_outbuf();
+      for(unsigned int j = 0; j < n; j += d_nsamples) {
+	const unsigned int m = std::min(d_nsamples, n - j);
+	const unsigned int nin = m + d_ntaps - 1;
+	memcpy(fwd_in, in + j, sizeof(gr_complex)*nin);
+	std::fill(fwd_in + nin, fwd_in + d_fftsize, gr_complex(0));
+	d_fwdfft->execute();
+
+	for(size_t h = 0; h < nhyp; h++) {
+	  volk_32fc_x2_multiply_32fc(inv_in, fwd_out, d_xformed_taps + h*d_fftsize, d_fftsize);
+	  d_invfft->execute();
+	  memcpy(out[h] + j, inv_out + d_ntaps - 1, sizeof(gr_complex)*m);
+	}
+      }
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
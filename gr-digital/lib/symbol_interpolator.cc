@@ -0,0 +1,94 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <gnuradio/digital/symbol_interpolator.h>
+#include <gnuradio/filter/interpolator_taps.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace gr {
+  namespace digital {
+
+    symbol_interpolator::symbol_interpolator()
+    {
+      // fir_filter_ccf runs its taps reversed, so reverse the rows to
+      // match mmse_fir_interpolator_cc.
+      std::vector< std::vector<float> > bank(NSTEPS + 1);
+      for(int i = 0; i < NSTEPS + 1; i++) {
+	bank[i].assign(taps[i], taps[i] + NTAPS);
+	std::reverse(bank[i].begin(), bank[i].end());
+      }
+      set_taps(bank);
+    }
+
+    symbol_interpolator::symbol_interpolator(const std::vector< std::vector<float> > &bank)
+    {
+      set_taps(bank);
+    }
+
+    void
+    symbol_interpolator::set_taps(const std::vector< std::vector<float> > &bank)
+    {
+      if(bank.empty() || bank[0].empty())
+	throw std::invalid_argument("symbol_interpolator: bank must not be empty");
+
+      d_nphases = bank.size();
+      d_ntaps = bank[0].size();
+      d_bank.clear();
+      d_bank.reserve(d_nphases * d_ntaps);
+      for(unsigned int i = 0; i < d_nphases; i++) {
+	if(bank[i].size() != d_ntaps)
+	  throw std::invalid_argument("symbol_interpolator: all phases must have the same length");
+	d_bank.insert(d_bank.end(), bank[i].begin(), bank[i].end());
+      }
+      d_schedule.clear();
+    }
+
+    unsigned int
+    symbol_interpolator::mmse_phase(float mu)
+    {
+      int imu = (int)rint(mu * NSTEPS);
+
+      if((imu < 0) || (imu > NSTEPS)) {
+	throw std::runtime_error("symbol_interpolator: imu out of bounds.\n");
+      }
+      return imu;
+    }
+
+    void
+    symbol_interpolator::interpolate(const gr_complex *in, gr_complex *out) const
+    {
+      if(d_schedule.empty())
+	return;
+      volk_32fc_32f_32u_gather_dot_prod_32fc(out, in, &d_bank[0], &d_schedule[0],
+					     d_ntaps, size());
+    }
+
+  } /* namespace digital */
+} /* namespace gr */
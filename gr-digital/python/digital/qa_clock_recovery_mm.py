@@ -172,6 +172,39 @@ class test_clock_recovery_mm(gr_unittest.TestCase):
         
         self.assertFloatTuplesAlmostEqual(expected_result, dst_data, 1)
 
+    def test05(self):
+        # Test complex/complex version updating the loop every 8 symbols
+        omega = 2
+        gain_omega = 0.01
+        mu = 0.25
+        gain_mu = 0.1
+        omega_rel_lim = 0.0001
+
+        self.test = digital.clock_recovery_mm_cc(omega, gain_omega,
+                                                 mu, gain_mu,
+                                                 omega_rel_lim)
+        self.test.set_loop_decimation(8)
+        self.assertEqual(8, self.test.loop_decimation())
+
+        data = 1000*[complex(1, 1), complex(1, 1), complex(-1, -1), complex(-1, -1)]
+        self.src = blocks.vector_source_c(data, False)
+        self.snk = blocks.vector_sink_c()
+
+        self.tb.connect(self.src, self.test, self.snk)
+        self.tb.run()
+        
+        expected_result = 1000*[complex(-1.2, -1.2), complex(1.2, 1.2)]
+        dst_data = self.snk.data()
+
+        # Only compare last Ncmp samples
+        Ncmp = 100
+        len_e = len(expected_result)
+        len_d = len(dst_data)
+        expected_result = expected_result[len_e - Ncmp:]
+        dst_data = dst_data[len_d - Ncmp:]
+        
+        self.assertComplexTuplesAlmostEqual(expected_result, dst_data, 1)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_clock_recovery_mm, "test_clock_recovery_mm.xml")
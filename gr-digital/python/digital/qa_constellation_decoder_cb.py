@@ -21,6 +21,7 @@
 # 
 
 from gnuradio import gr, gr_unittest, digital, blocks
+import random, cmath
 
 class test_constellation_decoder(gr_unittest.TestCase):
 
@@ -68,6 +69,36 @@ class test_constellation_decoder(gr_unittest.TestCase):
 	#print "expected result", expected_result
         self.assertFloatTuplesAlmostEqual(expected_result, actual_result)
 
+    def test_constellation_decoder_cb_batch(self):
+        # The block decides on whole buffers; check it against the
+        # decisions made one sample at a time.
+        qam16, code16 = digital.qam_16_0x0_0_1_2_3()
+        psk8 = [cmath.exp(2j*cmath.pi*k/8) for k in range(8)]
+        apsk = [1j**k * (1+1j) for k in range(4)] + \
+               [2.6 * (1j**(k/3.0)) for k in range(12)]
+        constellations = (
+            digital.constellation_calcdist(qam16, code16, 4, 1),
+            digital.constellation_calcdist(apsk, [], 4, 1),
+            digital.constellation_rect(qam16, code16, 4, 4, 4, 2, 2),
+            digital.constellation_psk(psk8, range(8), 8),
+            digital.constellation_bpsk(),
+            digital.constellation_qpsk(),
+            digital.constellation_dqpsk(),
+            digital.constellation_8psk(),
+        )
+        random.seed(1)
+        src_data = [complex(random.uniform(-1.5, 1.5), random.uniform(-1.5, 1.5))
+                    for i in range(1000)]
+        for cnst in constellations:
+            expected_result = [cnst.decision_maker_v((s,)) for s in src_data]
+            src = blocks.vector_source_c(src_data)
+            op = digital.constellation_decoder_cb(cnst.base())
+            dst = blocks.vector_sink_b()
+            self.tb = gr.top_block()
+            self.tb.connect(src, op, dst)
+            self.tb.run()
+            self.assertEqual(tuple(expected_result), dst.data())
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_constellation_decoder, "test_constellation_decoder.xml")
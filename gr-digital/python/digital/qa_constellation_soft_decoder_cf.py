@@ -106,6 +106,35 @@ class test_constellation_soft_decoder(gr_unittest.TestCase):
 	#print "expected result", expected_result
         self.assertFloatTuplesAlmostEqual(expected_result, actual_result, 5)
 
+    def test_constellation_soft_decoder_cf_qam16_maxlog(self):
+        # Without a LUT, the soft bits are max-log LLRs
+        src_data = (0.5 + 0.5j,  0.1 - 1.2j, -0.8 - 0.1j, -0.45 + 0.8j,
+                    0.8 + 1.0j, -0.5 + 0.1j,  0.1 - 1.2j, 1+1j)
+        cnst_pts, code = digital.qam_16_0x0_0_1_2_3()
+        cnst = digital.constellation_calcdist(cnst_pts, code, 2, 1)
+        points = cnst.points()
+        k = cnst.bits_per_symbol()
+        expected_result = list()
+        for s in src_data:
+            dist = [abs(s - p)**2 for p in points]
+            soft = [0] * k
+            for j in range(k):
+                d0 = min([d for d, c in zip(dist, code) if not (c >> j) & 1])
+                d1 = min([d for d, c in zip(dist, code) if (c >> j) & 1])
+                soft[k-1-j] = (d0 - d1) / 2.0
+            expected_result += soft
+
+        src = blocks.vector_source_c(src_data)
+        op = digital.constellation_soft_decoder_cf(cnst.base())
+        dst = blocks.vector_sink_f()
+
+        self.tb.connect(src, op)
+        self.tb.connect(op, dst)
+        self.tb.run()
+
+        actual_result = dst.data()
+        self.assertFloatTuplesAlmostEqual(expected_result, actual_result, 5)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_constellation_soft_decoder, "test_constellation_soft_decoder.xml")
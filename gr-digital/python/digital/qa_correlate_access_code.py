@@ -21,6 +21,7 @@
 # 
 
 from gnuradio import gr, gr_unittest, digital, blocks
+import pmt
 
 default_access_code = '\xAC\xDD\xA4\xE2\xF2\x8C\x20\xFC'
 
@@ -37,6 +38,11 @@ def string_to_1_0_list(s):
 def to_1_0_string(L):
     return ''.join(map(lambda x: chr(x + ord('0')), L))
 
+def pack_msb_first(bits):
+    bits = list(bits) + [0] * (-len(bits) % 8)
+    return tuple(sum(bits[i + j] << (7 - j) for j in range(8))
+                 for i in range(0, len(bits), 8))
+
 class test_correlate_access_code(gr_unittest.TestCase):
 
     def setUp(self):
@@ -91,6 +97,48 @@ class test_correlate_access_code(gr_unittest.TestCase):
         result_data = dst.data()
         self.assertEqual(expected_result, result_data)
 
+    def test_004(self):
+        # A 64 and a 100 bit code, neither starting on a byte boundary
+        code0 = tuple(string_to_1_0_list(default_access_code))
+        code1 = tuple((i * 37 + 11) % 7 < 3 and 1 or 0 for i in range(100))
+        payload = (1, 0, 1, 1) * 5
+        bits = (0,) * 5 + code0 + payload + code1 + payload + (0,) * 64
+        src_data = pack_msb_first(bits)
+        src = blocks.vector_source_b(src_data)
+        op = digital.correlate_access_code_packed_tag_bb(
+            (to_1_0_string(code0), to_1_0_string(code1)), 0, "test")
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        self.assertEqual(src_data, dst.data())
+        tags = dst.tags()
+        self.assertEqual(2, len(tags))
+        ends = [5 + 64, 5 + 64 + 20 + 100]
+        for i in range(2):
+            self.assertEqual(ends[i] / 8, tags[i].offset)
+            value = tags[i].value
+            self.assertEqual(i, pmt.to_long(pmt.dict_ref(value, pmt.intern("code"), pmt.PMT_NIL)))
+            self.assertEqual(0, pmt.to_long(pmt.dict_ref(value, pmt.intern("nwrong"), pmt.PMT_NIL)))
+            self.assertEqual(ends[i] % 8, pmt.to_long(pmt.dict_ref(value, pmt.intern("bit"), pmt.PMT_NIL)))
+
+    def test_005(self):
+        # Wrong bits up to the threshold
+        code = tuple(string_to_1_0_list(default_access_code))
+        bad = list(code)
+        bad[3] ^= 1
+        bad[40] ^= 1
+        bits = (0,) * 16 + code + (0,) * 11 + tuple(bad) + (0,) * 64
+        src = blocks.vector_source_b(pack_msb_first(bits))
+        op = digital.correlate_access_code_packed_tag_bb((to_1_0_string(code),), 2, "test")
+        dst = blocks.vector_sink_b()
+        self.tb.connect(src, op, dst)
+        self.tb.run()
+        tags = dst.tags()
+        self.assertEqual(2, len(tags))
+        self.assertEqual((10, 19), (tags[0].offset, tags[1].offset))
+        self.assertEqual(3, pmt.to_long(pmt.dict_ref(tags[1].value, pmt.intern("bit"), pmt.PMT_NIL)))
+        self.assertEqual(2, pmt.to_long(pmt.dict_ref(tags[1].value, pmt.intern("nwrong"), pmt.PMT_NIL)))
+
 if __name__ == '__main__':
     gr_unittest.run(test_correlate_access_code, "test_correlate_access_code.xml")
         
@@ -20,6 +20,9 @@
 # Boston, MA 02110-1301, USA.
 # 
 import math
+import random
+
+import numpy
 
 import pmt
 from gnuradio import gr, gr_unittest, digital, blocks, filter
@@ -99,6 +102,64 @@ class test_correlate_and_sync(gr_unittest.TestCase):
             print("Tag gives timing estimate of {0}. QA calculates it as {1}.  Tolerance is {2}".format(timing_error, remainder, tol))
         self.assertTrue(abs(difference) < tol)
 
+    def test_002_long_preamble(self):
+        # A preamble this long is correlated with the FFT; compare
+        # with a direct convolution by the correlator's own taps.
+        rng = random.Random(0)
+        preamble = [rng.choice((-1, 1)) for i in xrange(300)]
+        n_filters = 12
+        sps = 4
+        data = [0]*100 + preamble + [0]*400
+        src = blocks.vector_source_c(data)
+        pulse_shape = make_parabolic_pulse_shape(sps=n_filters, N=0.5, scale=35)
+        shape = filter.pfb_arb_resampler_ccf(sps, pulse_shape, n_filters)
+        correlator = digital.correlate_and_sync_cc(preamble, pulse_shape, sps, n_filters)
+        snk = blocks.vector_sink_c()
+        snk_corr = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(src, shape, correlator, snk)
+        tb.connect((correlator, 1), snk_corr)
+        tb.run()
+
+        taps = numpy.array(correlator.symbols())
+        x = numpy.array(snk.data())
+        expected = numpy.convolve(x, taps)[:len(x)]
+        corr = numpy.array(snk_corr.data())
+        scale = numpy.max(numpy.abs(expected))
+        self.assertTrue(numpy.max(numpy.abs(corr - expected)) < 1e-4*scale)
+
+        offsets = [tag.offset for tag in snk.tags()
+                   if pmt.symbol_to_string(tag.key) == "corr_est"]
+        self.assertEqual(len(offsets), 1)
+        self.assertTrue(abs(offsets[0] - numpy.argmax(numpy.abs(corr))) <= 1)
+
+    def test_003_multi(self):
+        # Two preambles at three frequency offsets; the second one
+        # is sent with the last offset.
+        rng = random.Random(1)
+        preambles = [[rng.choice((-1, 1)) for i in xrange(64)] for p in xrange(2)]
+        freq_offsets = [-0.004, 0, 0.004]
+        n_filters = 12
+        sps = 4
+        data = [0]*50 + preambles[1] + [0]*200
+        src = blocks.vector_source_c(data)
+        pulse_shape = make_parabolic_pulse_shape(sps=n_filters, N=0.5, scale=35)
+        shape = filter.pfb_arb_resampler_ccf(sps, pulse_shape, n_filters)
+        rotate = blocks.rotator_cc(freq_offsets[2])
+        correlator = digital.correlate_and_sync_multi_cc(preambles, pulse_shape, sps,
+                                                         freq_offsets, n_filters)
+        self.assertEqual(correlator.num_preambles(), 2)
+        snk = blocks.vector_sink_c()
+        tb = gr.top_block()
+        tb.connect(src, shape, rotate, correlator, snk)
+        tb.run()
+
+        tags = dict((pmt.symbol_to_string(tag.key), tag.value) for tag in snk.tags())
+        self.assertEqual(pmt.to_long(tags["preamble"]), 1)
+        self.assertAlmostEqual(pmt.to_double(tags["freq_est"]), freq_offsets[2], places=6)
+        self.assertTrue("phase_est" in tags)
+        self.assertTrue("time_est" in tags)
+
 
 if __name__ == '__main__':
     gr_unittest.run(test_correlate_and_sync, "test_correlate_and_sync.xml")
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+import random
+import cmath
+
+from gnuradio import gr, gr_unittest, digital, blocks
+
+class test_costas_loop_vcc(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def test_001_match_scalar(self):
+        # Every channel must follow costas_loop_cc on the same samples
+        vlen = 5
+        N = 2000
+        natfreq = 0.25
+        for order in (2, 4, 8):
+            chans = []
+            for c in xrange(vlen):
+                rot = cmath.exp(1j*(0.1 + 0.2*c))
+                w = 0.002*(c - 2)
+                chans.append([rot*cmath.exp(1j*w*i)*cmath.exp(2j*cmath.pi*random.randint(0, order-1)/order)
+                              for i in xrange(N)])
+            data = [chans[c][i] for i in xrange(N) for c in xrange(vlen)]
+
+            tb = gr.top_block()
+            src = blocks.vector_source_c(data, False, vlen)
+            bank = digital.costas_loop_vcc(vlen, natfreq, order)
+            snk = blocks.vector_sink_c(vlen)
+            fsnk = blocks.vector_sink_f(vlen)
+            tb.connect(src, bank, snk)
+            tb.connect((bank, 1), fsnk)
+            refs = []
+            for c in xrange(vlen):
+                rsrc = blocks.vector_source_c(chans[c], False)
+                ref = digital.costas_loop_cc(natfreq, order)
+                rsnk = blocks.vector_sink_c()
+                rfsnk = blocks.vector_sink_f()
+                tb.connect(rsrc, ref, rsnk)
+                tb.connect((ref, 1), rfsnk)
+                refs.append((rsnk, rfsnk))
+            tb.run()
+
+            out = snk.data()
+            freq = fsnk.data()
+            for c in xrange(vlen):
+                self.assertComplexTuplesAlmostEqual(refs[c][0].data(), out[c::vlen], 3)
+                self.assertFloatTuplesAlmostEqual(refs[c][1].data(), freq[c::vlen], 4)
+
+    def test_002_pll(self):
+        # Order 1 locks to an unmodulated carrier on every channel
+        vlen = 3
+        N = 4000
+        freqs = (-0.05, 0.0, 0.03)
+        data = [cmath.exp(1j*(freqs[c]*i + c)) for i in xrange(N) for c in xrange(vlen)]
+        src = blocks.vector_source_c(data, False, vlen)
+        bank = digital.costas_loop_vcc(vlen, 0.05, 1)
+        snk = blocks.vector_sink_c(vlen)
+        self.tb.connect(src, bank, snk)
+        self.tb.run()
+
+        out = snk.data()
+        for c in xrange(vlen):
+            self.assertAlmostEqual(bank.frequency(c), freqs[c], 3)
+            self.assertComplexTuplesAlmostEqual(out[-100*vlen+c::vlen], 100*[1,], 2)
+
+if __name__ == '__main__':
+    gr_unittest.run(test_costas_loop_vcc, "test_costas_loop_vcc.xml")
@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+from gnuradio import gr, gr_unittest, blocks, digital
+import pmt
+
+# (num_bits, poly, initial_value, final_xor, input_reflected,
+#  result_reflected, CRC of "123456789")
+crc_catalog = {
+    'CRC-8':          (8, 0x07, 0x00, 0x00, False, False, 0xF4),
+    'CRC-16/CCITT':   (16, 0x1021, 0xFFFF, 0x0000, False, False, 0x29B1),
+    'CRC-16/ARC':     (16, 0x8005, 0x0000, 0x0000, True, True, 0xBB3D),
+    'CRC-24/OPENPGP': (24, 0x864CFB, 0xB704CE, 0x000000, False, False, 0x21CF02),
+    'CRC-32':         (32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, True, True, 0xCBF43926),
+    'CRC-32/BZIP2':   (32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, False, False, 0xFC891918),
+    'CRC-32C':        (32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, True, True, 0xE3069283),
+    'CRC-5/USB':      (5, 0x05, 0x1F, 0x1F, True, True, 0x19),
+    'CRC-12/UMTS':    (12, 0x80F, 0x000, 0x000, False, True, 0xDAF),
+}
+
+class qa_crc_bb (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def make_tag(self, tag_name, offset, length):
+        tag = gr.tag_t()
+        tag.offset = offset
+        tag.key = pmt.string_to_symbol(tag_name)
+        tag.value = pmt.from_long(length)
+        return tag
+
+    def test_001_catalog (self):
+        """ Check values of common CRCs """
+        for name, p in crc_catalog.items():
+            engine = digital.crc_engine(*p[:6])
+            self.assertEqual(engine.compute("123456789"), p[6], name)
+
+    def test_002_crc32_compat (self):
+        """ With the CRC-32 parameters the output matches crc32_bb """
+        data = range(200)
+        tag_name = "len"
+        tag = self.make_tag(tag_name, 0, len(data))
+        src = blocks.vector_source_b(data, False, 1, (tag,))
+        crc = digital.crc_bb(32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, True, True, False, tag_name)
+        crc32 = digital.crc32_bb(False, tag_name)
+        sink = blocks.vector_sink_b()
+        sink32 = blocks.vector_sink_b()
+        self.tb.connect(src, crc, sink)
+        self.tb.connect(src, crc32, sink32)
+        self.tb.run()
+        self.assertEqual(sink32.data(), sink.data())
+
+    def test_003_crc16_bytes (self):
+        """ A normal CRC is appended most significant byte first """
+        data = [ord(c) for c in "123456789"]
+        tag_name = "len"
+        tag = self.make_tag(tag_name, 0, len(data))
+        src = blocks.vector_source_b(data, False, 1, (tag,))
+        crc = digital.crc_bb(16, 0x1021, 0xFFFF, 0x0000, False, False, False, tag_name)
+        sink = blocks.vector_sink_b()
+        self.tb.connect(src, crc, sink)
+        self.tb.run()
+        self.assertEqual(tuple(data + [0x29, 0xB1]), sink.data())
+
+    def test_004_check (self):
+        """ Generate and check: good packets pass, corrupted ones are dropped """
+        pack_len = 64
+        tag_name = "len"
+        data = range(pack_len) * 3
+        tags = [self.make_tag(tag_name, i*pack_len, pack_len) for i in range(3)]
+        src = blocks.vector_source_b(data, False, 1, tags)
+        crc = digital.crc_bb(24, 0x864CFB, 0xB704CE, 0, False, False, False, tag_name)
+        self.tb.connect(src, crc)
+        # Corrupt one byte of the second packet
+        mask = [0] * (3*(pack_len+3))
+        mask[pack_len+3+5] = 0x10
+        corrupt = blocks.xor_bb()
+        mask_src = blocks.vector_source_b(mask)
+        check = digital.crc_bb(24, 0x864CFB, 0xB704CE, 0, False, False, True, tag_name)
+        sink = blocks.vector_sink_b()
+        self.tb.connect(crc, (corrupt, 0))
+        self.tb.connect(mask_src, (corrupt, 1))
+        self.tb.connect(corrupt, check, sink)
+        self.tb.run()
+        self.assertEqual(tuple(range(pack_len) * 2), sink.data())
+        self.assertEqual(2, check.num_passed())
+        self.assertEqual(1, check.num_failed())
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_crc_bb, "qa_crc_bb.xml")
@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+import random
+
+from gnuradio import gr, gr_unittest, digital, blocks
+
+class test_kurtotic_equalizer(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def transform(self, src_data, num_taps, gain):
+        SRC = blocks.vector_source_c(src_data, False)
+        EQU = digital.kurtotic_equalizer_cc(num_taps, gain)
+        DST = blocks.vector_sink_c()
+        self.tb.connect(SRC, EQU, DST)
+        self.tb.run()
+        return DST.data()
+
+    def dispersion(self, data):
+        # Normalized variance of |z|^2; 0 for a constant modulus
+        p = sum(abs(z)**2 for z in data) / len(data)
+        m = sum(abs(z)**4 for z in data) / len(data)
+        return m / (p*p) - 1
+
+    def test_001_blind_isi(self):
+        random.seed(0)
+        points = digital.constellation_qpsk().points()
+        src_data = [points[random.randint(0, 3)] for i in range(20000)]
+        h = (1.0, 0.4-0.2j, 0.1+0.2j)
+        rx_data = [sum(h[k]*src_data[n-k] for k in range(len(h)) if n >= k)
+                   for n in range(len(src_data))]
+        result = self.transform(rx_data, 11, 0.001)
+
+        N = -2000
+        self.assertGreater(self.dispersion(rx_data[N:]), 0.2)
+        self.assertLess(self.dispersion(result[N:]), 0.05)
+
+if __name__ == "__main__":
+    gr_unittest.run(test_kurtotic_equalizer, "test_kurtotic_equalizer.xml")
@@ -0,0 +1,83 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+import random
+
+from gnuradio import gr, gr_unittest, digital, blocks
+
+class test_lms_dfe_equalizer(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def transform(self, src_data, num_ff_taps, num_fb_taps, gain, const, block_size=1):
+        SRC = blocks.vector_source_c(src_data, False)
+        EQU = digital.lms_dfe_equalizer_cc(num_ff_taps, num_fb_taps, gain, 1,
+                                           const.base(), block_size)
+        DST = blocks.vector_sink_c()
+        self.tb.connect(SRC, EQU, DST)
+        self.tb.run()
+        return DST.data()
+
+    def qpsk_symbols(self, const, n):
+        random.seed(0)
+        points = const.points()
+        return [points[random.randint(0, len(points)-1)] for i in range(n)]
+
+    def test_001_identity(self):
+        # Clean constellation points; the equalizer must not move
+        const = digital.constellation_qpsk()
+        src_data = const.points()*1000
+        for block_size in (1, 8):
+            result = self.transform(src_data, 4, 2, 0.1, const, block_size)
+            N = -500
+            self.assertComplexTuplesAlmostEqual(src_data[N:], result[N:], 5)
+
+    def test_002_postcursor_isi(self):
+        # The feedback taps cancel the ISI of the past symbols
+        const = digital.constellation_qpsk()
+        src_data = self.qpsk_symbols(const, 4000)
+        h = (1.0, 0.5, 0.25j)
+        rx_data = [sum(h[k]*src_data[n-k] for k in range(len(h)) if n >= k)
+                   for n in range(len(src_data))]
+        result = self.transform(rx_data, 4, 3, 0.01, const)
+
+        N = -500
+        self.assertComplexTuplesAlmostEqual(src_data[N:], result[N:], 1)
+
+    def test_003_long_block_update(self):
+        # Block updates of a long feed-forward filter
+        const = digital.constellation_qpsk()
+        src_data = self.qpsk_symbols(const, 8192)
+        h = (1.0, 0.3-0.2j, 0.1j)
+        rx_data = [sum(h[k]*src_data[n-k] for k in range(len(h)) if n >= k)
+                   for n in range(len(src_data))]
+        result = self.transform(rx_data, 128, 0, 0.002, const, 128)
+
+        N = -1024
+        self.assertComplexTuplesAlmostEqual(src_data[N:], result[N:], 1)
+
+if __name__ == "__main__":
+    gr_unittest.run(test_lms_dfe_equalizer, "test_lms_dfe_equalizer.xml")
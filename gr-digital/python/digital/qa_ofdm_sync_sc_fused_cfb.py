@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+# 
+# This file is part of GNU Radio
+# 
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+# 
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+# 
+
+import numpy
+import random
+
+from gnuradio import gr, gr_unittest, blocks, analog
+from gnuradio import digital
+
+class qa_ofdm_sync_sc_fused_cfb (gr_unittest.TestCase):
+
+    def setUp (self):
+        self.tb = gr.top_block ()
+
+    def tearDown (self):
+        self.tb = None
+
+    def test_001_detect (self):
+        """ Send two bursts with a long FFT, with zeros in between, and
+        check they are both detected at the correct position """
+        n_zeros = 100
+        fft_len = 2048
+        cp_len = 128
+        sig_len = (fft_len + cp_len) * 4
+        sync_symbol = [(random.randint(0, 1)*2)-1 for x in range(fft_len/2)] * 2
+        tx_signal = [0,] * n_zeros + \
+                    sync_symbol[-cp_len:] + \
+                    sync_symbol + \
+                    [(random.randint(0, 1)*2)-1 for x in range(sig_len)]
+        tx_signal = tx_signal * 2
+        add = blocks.add_cc()
+        sync = digital.ofdm_sync_sc_fused_cfb(fft_len, cp_len)
+        sink_freq   = blocks.vector_sink_f()
+        sink_detect = blocks.vector_sink_b()
+        self.tb.connect(blocks.vector_source_c(tx_signal), (add, 0))
+        self.tb.connect(analog.noise_source_c(analog.GR_GAUSSIAN, .01), (add, 1))
+        self.tb.connect(add, sync)
+        self.tb.connect((sync, 0), sink_freq)
+        self.tb.connect((sync, 1), sink_detect)
+        self.tb.run()
+        sig1_detect = sink_detect.data()[0:len(tx_signal)/2]
+        sig2_detect = sink_detect.data()[len(tx_signal)/2:]
+        self.assertTrue(abs(sig1_detect.index(1) - (n_zeros + fft_len + cp_len)) < cp_len)
+        self.assertTrue(abs(sig2_detect.index(1) - (n_zeros + fft_len + cp_len)) < cp_len)
+        self.assertEqual(numpy.sum(sig1_detect), 1)
+        self.assertEqual(numpy.sum(sig2_detect), 1)
+
+    def test_002_metric (self):
+        """ Check the metric output, and that raising the threshold
+        above the plateau suppresses the detection """
+        fft_len = 32
+        cp_len = 4
+        sync_symbol = [(random.randint(0, 1)*2)-1 for x in range(fft_len/2)] * 2
+        tx_signal = [0,] * fft_len + \
+                    sync_symbol[-cp_len:] + \
+                    sync_symbol + \
+                    [0,] * (fft_len * 4)
+        for threshold, n_detects in ((0.9, 1), (1.1, 0)):
+            self.tb = gr.top_block ()
+            sync = digital.ofdm_sync_sc_fused_cfb(fft_len, cp_len)
+            sync.set_threshold(threshold)
+            self.assertAlmostEqual(sync.threshold(), threshold, places=6)
+            sink_freq   = blocks.vector_sink_f()
+            sink_detect = blocks.vector_sink_b()
+            sink_metric = blocks.vector_sink_f()
+            self.tb.connect(blocks.vector_source_c(tx_signal), sync)
+            self.tb.connect((sync, 0), sink_freq)
+            self.tb.connect((sync, 1), sink_detect)
+            self.tb.connect((sync, 2), sink_metric)
+            self.tb.run()
+            metric = sink_metric.data()
+            self.assertEqual(len(metric), len(tx_signal))
+            self.assertAlmostEqual(max(metric), 1.0, places=4)
+            self.assertEqual(metric[0], 0)
+            self.assertEqual(numpy.sum(sink_detect.data()), n_detects)
+
+
+if __name__ == '__main__':
+    gr_unittest.run(qa_ofdm_sync_sc_fused_cfb, "qa_ofdm_sync_sc_fused_cfb.xml")
@@ -53,12 +53,17 @@
 #include "gnuradio/digital/constellation_receiver_cb.h"
 #include "gnuradio/digital/constellation_soft_decoder_cf.h"
 #include "gnuradio/digital/correlate_access_code_bb.h"
+#include "gnuradio/digital/correlate_access_code_packed_tag_bb.h"
 #include "gnuradio/digital/correlate_access_code_tag_bb.h"
 #include "gnuradio/digital/correlate_and_sync_cc.h"
+#include "gnuradio/digital/correlate_and_sync_multi_cc.h"
 #include "gnuradio/digital/costas_loop_cc.h"
+#include "gnuradio/digital/costas_loop_vcc.h"
 #include "gnuradio/digital/cpmmod_bc.h"
 #include "gnuradio/digital/crc32.h"
 #include "gnuradio/digital/crc32_bb.h"
+#include "gnuradio/digital/crc_bb.h"
+#include "gnuradio/digital/crc_engine.h"
 #include "gnuradio/digital/descrambler_bb.h"
 #include "gnuradio/digital/diff_decoder_bb.h"
 #include "gnuradio/digital/diff_encoder_bb.h"
@@ -71,6 +76,7 @@
 #include "gnuradio/digital/kurtotic_equalizer_cc.h"
 #include "gnuradio/digital/lfsr.h"
 #include "gnuradio/digital/lms_dd_equalizer_cc.h"
+#include "gnuradio/digital/lms_dfe_equalizer_cc.h"
 #include "gnuradio/digital/map_bb.h"
 #include "gnuradio/digital/metric_type.h"
 #include "gnuradio/digital/mpsk_receiver_cc.h"
@@ -90,6 +96,7 @@
 #include "gnuradio/digital/ofdm_sampler.h"
 #include "gnuradio/digital/ofdm_serializer_vcc.h"
 #include "gnuradio/digital/ofdm_sync_sc_cfb.h"
+#include "gnuradio/digital/ofdm_sync_sc_fused_cfb.h"
 #include "gnuradio/digital/packet_header_default.h"
 #include "gnuradio/digital/packet_header_ofdm.h"
 #include "gnuradio/digital/packet_headergenerator_bb.h"
@@ -124,12 +131,17 @@
 %include "gnuradio/digital/constellation_receiver_cb.h"
 %include "gnuradio/digital/constellation_soft_decoder_cf.h"
 %include "gnuradio/digital/correlate_access_code_bb.h"
+%include "gnuradio/digital/correlate_access_code_packed_tag_bb.h"
 %include "gnuradio/digital/correlate_access_code_tag_bb.h"
 %include "gnuradio/digital/correlate_and_sync_cc.h"
+%include "gnuradio/digital/correlate_and_sync_multi_cc.h"
 %include "gnuradio/digital/costas_loop_cc.h"
+%include "gnuradio/digital/costas_loop_vcc.h"
 %include "gnuradio/digital/cpmmod_bc.h"
 %include "gnuradio/digital/crc32.h"
 %include "gnuradio/digital/crc32_bb.h"
+%include "gnuradio/digital/crc_bb.h"
+%include "gnuradio/digital/crc_engine.h"
 %include "gnuradio/digital/descrambler_bb.h"
 %include "gnuradio/digital/diff_decoder_bb.h"
 %include "gnuradio/digital/diff_encoder_bb.h"
@@ -142,6 +154,7 @@
 %include "gnuradio/digital/kurtotic_equalizer_cc.h"
 %include "gnuradio/digital/lfsr.h"
 %include "gnuradio/digital/lms_dd_equalizer_cc.h"
+%include "gnuradio/digital/lms_dfe_equalizer_cc.h"
 %include "gnuradio/digital/map_bb.h"
 %include "gnuradio/digital/metric_type.h"
 %include "gnuradio/digital/mpsk_receiver_cc.h"
@@ -161,6 +174,7 @@
 %include "gnuradio/digital/ofdm_sampler.h"
 %include "gnuradio/digital/ofdm_serializer_vcc.h"
 %include "gnuradio/digital/ofdm_sync_sc_cfb.h"
+%include "gnuradio/digital/ofdm_sync_sc_fused_cfb.h"
 %include "gnuradio/digital/packet_header_default.h"
 %include "gnuradio/digital/packet_header_ofdm.h"
 %include "gnuradio/digital/packet_headergenerator_bb.h"
@@ -190,10 +204,14 @@ GR_SWIG_BLOCK_MAGIC2(digital, constellation_decoder_cb);
 GR_SWIG_BLOCK_MAGIC2(digital, constellation_receiver_cb);
 GR_SWIG_BLOCK_MAGIC2(digital, constellation_soft_decoder_cf);
 GR_SWIG_BLOCK_MAGIC2(digital, correlate_access_code_bb);
+GR_SWIG_BLOCK_MAGIC2(digital, correlate_access_code_packed_tag_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, correlate_access_code_tag_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, correlate_and_sync_cc);
+GR_SWIG_BLOCK_MAGIC2(digital, correlate_and_sync_multi_cc);
 GR_SWIG_BLOCK_MAGIC2(digital, costas_loop_cc);
+GR_SWIG_BLOCK_MAGIC2(digital, costas_loop_vcc);
 GR_SWIG_BLOCK_MAGIC2(digital, crc32_bb);
+GR_SWIG_BLOCK_MAGIC2(digital, crc_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, cpmmod_bc);
 GR_SWIG_BLOCK_MAGIC2(digital, descrambler_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, diff_decoder_bb);
@@ -206,6 +224,7 @@ GR_SWIG_BLOCK_MAGIC2(digital, glfsr_source_f);
 GR_SWIG_BLOCK_MAGIC2(digital, header_payload_demux);
 GR_SWIG_BLOCK_MAGIC2(digital, kurtotic_equalizer_cc);
 GR_SWIG_BLOCK_MAGIC2(digital, lms_dd_equalizer_cc);
+GR_SWIG_BLOCK_MAGIC2(digital, lms_dfe_equalizer_cc);
 GR_SWIG_BLOCK_MAGIC2(digital, map_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, mpsk_receiver_cc);
 GR_SWIG_BLOCK_MAGIC2(digital, mpsk_snr_est_cc);
@@ -220,6 +239,7 @@ GR_SWIG_BLOCK_MAGIC2(digital, ofdm_mapper_bcv);
 GR_SWIG_BLOCK_MAGIC2(digital, ofdm_sampler);
 GR_SWIG_BLOCK_MAGIC2(digital, ofdm_serializer_vcc);
 GR_SWIG_BLOCK_MAGIC2(digital, ofdm_sync_sc_cfb);
+GR_SWIG_BLOCK_MAGIC2(digital, ofdm_sync_sc_fused_cfb);
 GR_SWIG_BLOCK_MAGIC2(digital, packet_headergenerator_bb);
 GR_SWIG_BLOCK_MAGIC2(digital, packet_headerparser_b);
 GR_SWIG_BLOCK_MAGIC2(digital, packet_sink);
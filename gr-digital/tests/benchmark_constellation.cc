@@ -0,0 +1,149 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compares deciding one sample at a time (decision_maker and
+ * calc_soft_dec, as the decoder blocks used to) with the batch calls
+ * decision_maker_n and soft_decision_maker_n for a few constellations.
+ * The decisions must agree.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <gnuradio/digital/constellation.h>
+
+#define NSYMBOLS 200000
+#define NSOFT 20000
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static bool
+run(const char *name, gr::digital::constellation_sptr c)
+{
+  std::vector<gr_complex> samples(NSYMBOLS);
+  std::vector<unsigned int> one(NSYMBOLS), batch(NSYMBOLS);
+  std::vector<float> llrs(NSOFT * c->bits_per_symbol());
+  bool ok = true;
+
+  for(int i = 0; i < NSYMBOLS; i++)
+    samples[i] = gr_complex(3.0f * rand() / RAND_MAX - 1.5f,
+			    3.0f * rand() / RAND_MAX - 1.5f);
+
+  double start = cpu_time();
+  for(int i = 0; i < NSYMBOLS; i++)
+    one[i] = c->decision_maker(&samples[i]);
+  double t_one = cpu_time() - start;
+
+  start = cpu_time();
+  c->decision_maker_n(&samples[0], &batch[0], NSYMBOLS);
+  double t_batch = cpu_time() - start;
+
+  for(int i = 0; i < NSYMBOLS; i++)
+    if(one[i] != batch[i])
+      ok = false;
+
+  const unsigned int k = c->bits_per_symbol();
+  std::vector<float> soft(NSOFT * k);
+  start = cpu_time();
+  for(int i = 0; i < NSOFT; i++) {
+    std::vector<float> s = c->calc_soft_dec(samples[i]);
+    std::copy(s.begin(), s.end(), soft.begin() + i*k);
+  }
+  double t_soft = cpu_time() - start;
+
+  start = cpu_time();
+  c->soft_decision_maker_n(&samples[0], &llrs[0], NSOFT);
+  double t_soft_batch = cpu_time() - start;
+
+  for(unsigned int i = 0; i < NSOFT * k; i++)
+    if(soft[i] != llrs[i] && !(std::isnan(soft[i]) && std::isnan(llrs[i])))
+      ok = false;
+
+  printf("%-10s hard: %7.1f -> %7.1f Msym/s   soft: %6.2f -> %6.2f Msym/s  %s\n",
+	 name, NSYMBOLS/t_one*1e-6, NSYMBOLS/t_batch*1e-6,
+	 NSOFT/t_soft*1e-6, NSOFT/t_soft_batch*1e-6, ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+  std::vector<gr_complex> bpsk, three, qam16, qam256, apsk16, psk8;
+  std::vector<int> no_code;
+  bool ok = true;
+
+  bpsk.push_back(gr_complex(-1, 0));
+  bpsk.push_back(gr_complex(1, 0));
+  for(int k = 0; k < 3; k++)
+    three.push_back(std::polar(1.0f, float(2*M_PI/3*k)));
+  for(int i = 0; i < 4; i++)
+    for(int j = 0; j < 4; j++)
+      qam16.push_back(gr_complex(2*i-3, 2*j-3));
+  for(int i = 0; i < 16; i++)
+    for(int j = 0; j < 16; j++)
+      qam256.push_back(gr_complex(2*i-15, 2*j-15));
+  for(int k = 0; k < 4; k++)
+    apsk16.push_back(std::polar(1.0f, float(M_PI/2*k + M_PI/4)));
+  for(int k = 0; k < 12; k++)
+    apsk16.push_back(std::polar(2.6f, float(M_PI/6*k + M_PI/12)));
+  for(int k = 0; k < 8; k++)
+    psk8.push_back(std::polar(1.0f, float(M_PI/4*k)));
+
+  srand(1);
+  ok &= run("BPSK", gr::digital::constellation_calcdist::make(bpsk, no_code, 2, 1));
+  ok &= run("3PSK", gr::digital::constellation_calcdist::make(three, no_code, 3, 1));
+  ok &= run("16QAM", gr::digital::constellation_calcdist::make(qam16, no_code, 4, 1));
+  ok &= run("256QAM", gr::digital::constellation_calcdist::make(qam256, no_code, 4, 1));
+  ok &= run("16APSK", gr::digital::constellation_calcdist::make(apsk16, no_code, 4, 1));
+  ok &= run("8PSK", gr::digital::constellation_psk::make(psk8, no_code, 8));
+  ok &= run("16QAM rect", gr::digital::constellation_rect::make(qam16, no_code, 4, 4, 4, 2, 2));
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Runs gr::digital::preamble_correlator in direct and FFT form on
+ * preambles of 16 to 4096 samples, with one hypothesis and with three
+ * preambles at three frequency offsets, and prints the throughput of
+ * both and the form AUTO picks.  The outputs must agree.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <cmath>
+#include <vector>
+#include <gnuradio/digital/preamble_correlator.h>
+
+#define NSAMPLES (256*1024)
+#define CHUNK 8192
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static gr_complex
+random_sample()
+{
+  return gr_complex(rand() / (float)RAND_MAX - 0.5f, rand() / (float)RAND_MAX - 0.5f);
+}
+
+// Runs the correlator over the input CHUNK samples at a time, returns
+// samples per second
+static double
+run(gr::digital::preamble_correlator &corr, const std::vector<gr_complex> &in,
+    std::vector<std::vector<gr_complex> > &out)
+{
+  const size_t nhyp = corr.num_hypotheses();
+  const size_t n = in.size() - corr.ntaps() + 1;
+  std::vector<gr_complex*> ptrs(nhyp);
+
+  double start = cpu_time();
+  for(size_t i = 0; i < n; i += CHUNK) {
+    unsigned int m = std::min((size_t)CHUNK, n - i);
+    for(size_t h = 0; h < nhyp; h++)
+      ptrs[h] = &out[h][i];
+    corr.filter(m, &in[i], &ptrs[0]);
+  }
+  return n / (cpu_time() - start);
+}
+
+static bool
+bench(unsigned int ntaps, unsigned int npreambles, unsigned int nfreqs)
+{
+  std::vector<std::vector<gr_complex> > taps(npreambles, std::vector<gr_complex>(ntaps));
+  std::vector<float> freqs;
+  for(unsigned int t = 0; t < npreambles; t++)
+    for(unsigned int k = 0; k < ntaps; k++)
+      taps[t][k] = random_sample();
+  for(unsigned int f = 0; f < nfreqs; f++)
+    freqs.push_back(0.001 * f);
+
+  gr::digital::preamble_correlator direct(taps, freqs, gr::digital::preamble_correlator::DIRECT);
+  gr::digital::preamble_correlator fft(taps, freqs, gr::digital::preamble_correlator::FFT);
+  gr::digital::preamble_correlator automatic(taps, freqs);
+
+  std::vector<gr_complex> in(NSAMPLES + ntaps - 1);
+  for(size_t i = 0; i < in.size(); i++)
+    in[i] = random_sample();
+  std::vector<std::vector<gr_complex> > out_direct(direct.num_hypotheses(), std::vector<gr_complex>(NSAMPLES));
+  std::vector<std::vector<gr_complex> > out_fft(out_direct);
+
+  double r_direct = run(direct, in, out_direct);
+  double r_fft = run(fft, in, out_fft);
+
+  // Errors relative to the RMS of a correlation of random samples
+  double maxerr = 0;
+  for(size_t h = 0; h < out_direct.size(); h++)
+    for(size_t i = 0; i < NSAMPLES; i++)
+      maxerr = std::max(maxerr, (double)std::abs(out_direct[h][i] - out_fft[h][i]));
+  maxerr /= std::sqrt(ntaps / 6.0);
+  bool ok = maxerr < 1e-4;
+
+  printf("%5u taps %2u hyp  direct: %8.2f Msps  fft(%5u): %8.2f Msps  %6.2fx  auto: %-6s %s\n",
+	 ntaps, npreambles*nfreqs, r_direct*1e-6, fft.fft_size(), r_fft*1e-6,
+	 r_fft/r_direct, automatic.use_fft() ? "fft" : "direct", ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+  bool ok = true;
+
+  srand(1);
+  for(unsigned int ntaps = 16; ntaps <= 4096; ntaps *= 2) {
+    ok &= bench(ntaps, 1, 1);
+    ok &= bench(ntaps, 3, 3);
+  }
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compares a bytewise boost::crc_optimal register, as crc32_bb used
+ * before, with gr::digital::crc_engine for 64 and 1500 byte packets
+ * and CRCs of 8, 16, 24 and 32 bits. Both must give the same CRC.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <vector>
+#include <boost/crc.hpp>
+#include <gnuradio/digital/crc_engine.h>
+
+#define NBYTES (64*1024*1024)
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+template<int Bits, unsigned int Poly, unsigned int Init, unsigned int Xor,
+	 bool RefIn, bool RefOut>
+static bool
+run(const char *name, const std::vector<unsigned char> &data, size_t pkt_len)
+{
+  typedef typename boost::uint_t<Bits>::fast value_type;
+  boost::crc_optimal<Bits, Poly, Init, Xor, RefIn, RefOut> ref;
+  gr::digital::crc_engine engine(Bits, Poly, Init, Xor, RefIn, RefOut);
+  const size_t npkts = data.size() / pkt_len;
+  std::vector<unsigned int> crc_ref(npkts), crc_engine(npkts);
+  bool ok = true;
+
+  double start = cpu_time();
+  for(size_t p = 0; p < npkts; p++) {
+    ref.reset();
+    ref.process_bytes(&data[p*pkt_len], pkt_len);
+    crc_ref[p] = (value_type)ref();
+  }
+  double t_ref = cpu_time() - start;
+
+  start = cpu_time();
+  for(size_t p = 0; p < npkts; p++)
+    crc_engine[p] = engine.compute(&data[p*pkt_len], pkt_len);
+  double t_engine = cpu_time() - start;
+
+  for(size_t p = 0; p < npkts; p++)
+    if(crc_ref[p] != crc_engine[p])
+      ok = false;
+
+  printf("%-14s %4d bytes  boost: %7.1f MB/s  engine: %7.1f MB/s  %5.2fx  %s\n",
+	 name, (int)pkt_len, npkts*pkt_len/t_ref*1e-6, npkts*pkt_len/t_engine*1e-6,
+	 t_ref/t_engine, ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+  std::vector<unsigned char> data(NBYTES);
+  bool ok = true;
+
+  srand(1);
+  for(size_t i = 0; i < data.size(); i++)
+    data[i] = rand() & 0xff;
+
+  const size_t lengths[] = { 64, 1500 };
+  for(int l = 0; l < 2; l++) {
+    ok &= run<8, 0x07, 0x00, 0x00, false, false>("CRC-8", data, lengths[l]);
+    ok &= run<16, 0x1021, 0xFFFF, 0x0000, false, false>("CRC-16/CCITT", data, lengths[l]);
+    ok &= run<24, 0x864CFB, 0xB704CE, 0x000000, false, false>("CRC-24/OPENPGP", data, lengths[l]);
+    ok &= run<32, 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true>("CRC-32", data, lengths[l]);
+  }
+
+  return ok ? 0 : 1;
+}
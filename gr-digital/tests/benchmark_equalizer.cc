@@ -0,0 +1,194 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/*
+ * Runs an LMS decision-directed equalizer on QPSK through a short
+ * channel, the way the equalizer blocks did before
+ * gr::digital::adaptive_equalizer (filter::kernel::fir_filter_ccc and
+ * a scalar loop over the taps after every symbol) and with the
+ * engine: per-symbol updates, block updates of ntaps symbols done
+ * directly and with the FFT, and per-symbol updates with 4 feedback
+ * taps.  Prints the cost per symbol.  The per-symbol outputs must
+ * agree with the old loop.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <cmath>
+#include <vector>
+#include <gnuradio/digital/adaptive_equalizer.h>
+#include <gnuradio/filter/fir_filter.h>
+
+#define NSYMBOLS (64*1024)
+#define CHUNK 4096
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static gr_complex
+slice(const gr_complex &y)
+{
+  return gr_complex(y.real() >= 0 ? M_SQRT1_2 : -M_SQRT1_2,
+		    y.imag() >= 0 ? M_SQRT1_2 : -M_SQRT1_2);
+}
+
+// The loop of lms_dd_equalizer_cc before the engine
+class legacy_lms : public gr::filter::kernel::fir_filter_ccc
+{
+  float d_mu;
+
+public:
+  legacy_lms(unsigned int ntaps, float mu)
+    : fir_filter_ccc(1, std::vector<gr_complex>(ntaps)), d_mu(mu)
+  {
+    std::vector<gr_complex> taps(ntaps);
+    taps[0] = 1;
+    set_taps(taps);
+  }
+
+  void equalize(const gr_complex *in, gr_complex *out, unsigned int n)
+  {
+    for(unsigned int i = 0; i < n; i++) {
+      out[i] = filter(&in[i]);
+      gr_complex error = slice(out[i]) - out[i];
+      for(unsigned int k = 0; k < d_ntaps; k++) {
+	d_taps[k] += d_mu*conj(in[i+k])*error;
+	fir_filter_ccc::update_tap(d_taps[k], k);
+      }
+    }
+  }
+};
+
+class lms : public gr::digital::adaptive_equalizer
+{
+  float d_mu;
+
+protected:
+  gr_complex step(const gr_complex &out, gr_complex &decision)
+  {
+    decision = slice(out);
+    return d_mu*(decision - out);
+  }
+
+public:
+  lms(unsigned int ntaps, unsigned int nfb, float mu)
+    : adaptive_equalizer(ntaps, 1, nfb), d_mu(mu)
+  {
+    std::vector<gr_complex> taps(ntaps);
+    taps[ntaps-1] = 1;
+    set_taps(taps);
+  }
+};
+
+// Runs an equalizer over the input CHUNK symbols at a time, returns
+// nanoseconds per symbol
+template<class T>
+static double
+run(T &eq, const std::vector<gr_complex> &in, std::vector<gr_complex> &out)
+{
+  double start = cpu_time();
+  for(unsigned int i = 0; i < NSYMBOLS; i += CHUNK)
+    eq.equalize(&in[i], &out[i], CHUNK);
+  return (cpu_time() - start) * 1e9 / NSYMBOLS;
+}
+
+static bool
+bench(unsigned int ntaps)
+{
+  const gr_complex h[3] = { gr_complex(1, 0), gr_complex(0.3, -0.2), gr_complex(0, 0.1) };
+  const float mu = 0.1f / ntaps;
+
+  std::vector<gr_complex> in(NSYMBOLS + ntaps - 1);
+  for(unsigned int i = 0; i < NSYMBOLS; i++) {
+    gr_complex s = slice(gr_complex(rand() - RAND_MAX/2, rand() - RAND_MAX/2));
+    for(unsigned int k = 0; k < 3 && ntaps - 1 + i + k < in.size(); k++)
+      in[ntaps - 1 + i + k] += h[k] * s;
+  }
+
+  std::vector<gr_complex> out_legacy(NSYMBOLS), out(NSYMBOLS);
+
+  legacy_lms legacy(ntaps, mu);
+  double t_legacy = run(legacy, in, out_legacy);
+
+  lms symbol(ntaps, 0, mu);
+  double t_symbol = run(symbol, in, out);
+  double maxerr = 0;
+  for(unsigned int i = 0; i < NSYMBOLS; i++)
+    maxerr = std::max(maxerr, (double)std::abs(out[i] - out_legacy[i]));
+  bool ok = maxerr < 1e-3;
+
+  lms direct(ntaps, 0, mu);
+  direct.set_block_size(ntaps, gr::digital::adaptive_equalizer::DIRECT);
+  double t_direct = run(direct, in, out);
+
+  lms fft(ntaps, 0, mu);
+  fft.set_block_size(ntaps, gr::digital::adaptive_equalizer::FFT);
+  double t_fft = run(fft, in, out);
+
+  lms automatic(ntaps, 0, mu);
+  automatic.set_block_size(ntaps);
+
+  lms dfe(ntaps, 4, mu);
+  double t_dfe = run(dfe, in, out);
+
+  printf("%4u taps  legacy: %8.1f ns  symbol: %8.1f ns  block: %8.1f ns  fft(%5u): %8.1f ns  auto: %-6s  dfe: %8.1f ns  %s\n",
+	 ntaps, t_legacy, t_symbol, t_direct, fft.fft_size(), t_fft,
+	 automatic.use_fft() ? "fft" : "direct", t_dfe, ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+  bool ok = true;
+
+  srand(1);
+  for(unsigned int ntaps = 4; ntaps <= 512; ntaps *= 2)
+    ok &= bench(ntaps);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+/*
+ * Runs the loop of clock_recovery_mm_cc on QPSK at about 4 samples
+ * per symbol with a small clock offset, the way the block did before
+ * gr::digital::symbol_interpolator (an mmse_fir_interpolator_cc call
+ * and a loop update per symbol) and with the interpolator, updating
+ * the loop every 1, 4, 16 and 64 symbols.  Prints the cost per
+ * symbol and the mean absolute timing error over the second half of
+ * the run.  With an update every symbol the loop must follow the
+ * old one up to rounding: the first symbols agree, until a rounding
+ * difference in mu picks the neighbouring filter, and the timing
+ * error matches.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <cmath>
+#include <vector>
+#include <gnuradio/digital/symbol_interpolator.h>
+#include <gnuradio/filter/mmse_fir_interpolator_cc.h>
+#include <gnuradio/math.h>
+
+#define NSYMBOLS (256*1024)
+#define CHUNK 4096
+#define OMEGA 4.0f
+#define TRUE_OMEGA 4.002
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static gr_complex
+slicer_0deg(const gr_complex &sample)
+{
+  return gr_complex(sample.real() > 0 ? 1 : 0, sample.imag() > 0 ? 1 : 0);
+}
+
+// State and error detector shared by both loops
+class mm_state
+{
+protected:
+  float d_mu, d_omega, d_omega_mid, d_omega_relative_limit;
+  float d_gain_mu, d_gain_omega;
+  gr_complex d_p_2T, d_p_1T, d_p_0T;
+  gr_complex d_c_2T, d_c_1T, d_c_0T;
+
+  float detect(const gr_complex &sample)
+  {
+    d_p_2T = d_p_1T;
+    d_p_1T = d_p_0T;
+    d_p_0T = sample;
+    d_c_2T = d_c_1T;
+    d_c_1T = d_c_0T;
+    d_c_0T = slicer_0deg(d_p_0T);
+    gr_complex x = (d_c_0T - d_c_2T) * conj(d_p_1T);
+    gr_complex y = (d_p_0T - d_p_2T) * conj(d_c_1T);
+    return gr::branchless_clip((y - x).real(), 1.0);
+  }
+
+public:
+  mm_state()
+    : d_mu(0.5), d_omega(OMEGA), d_omega_mid(OMEGA), d_omega_relative_limit(0.005),
+      d_gain_mu(0.03), d_gain_omega(0.25*0.03*0.03),
+      d_p_2T(0), d_p_1T(0), d_p_0T(0), d_c_2T(0), d_c_1T(0), d_c_0T(0)
+  {
+  }
+};
+
+// The loop of clock_recovery_mm_cc before the interpolator
+class legacy_mm : public mm_state
+{
+  gr::filter::mmse_fir_interpolator_cc d_interp;
+
+public:
+  // Returns the number of outputs; *consumed the input used
+  int run(const gr_complex *in, int ni, gr_complex *out, float *err, int *consumed)
+  {
+    int ii = 0, oo = 0;
+    while(ii < ni) {
+      out[oo] = d_interp.interpolate(&in[ii], d_mu);
+      float mm_val = detect(out[oo]);
+      err[oo++] = mm_val;
+      d_omega = d_omega + d_gain_omega * mm_val;
+      d_omega = d_omega_mid + gr::branchless_clip(d_omega-d_omega_mid, d_omega_relative_limit);
+      d_mu = d_mu + d_omega + d_gain_mu * mm_val;
+      ii += (int)floor(d_mu);
+      d_mu -= floor(d_mu);
+    }
+    *consumed = ii;
+    return oo;
+  }
+};
+
+// The loop of clock_recovery_mm_cc with a loop update every
+// decimation symbols
+class batch_mm : public mm_state
+{
+  gr::digital::symbol_interpolator d_interp;
+  int d_decim, d_count;
+  float d_error;
+
+public:
+  batch_mm(int decimation) : d_decim(decimation), d_count(0), d_error(0) {}
+
+  int run(const gr_complex *in, int ni, gr_complex *out, float *err, int *consumed)
+  {
+    int ii = 0, oo = 0;
+    while(ii < ni) {
+      const int nleft = d_decim - d_count;
+      float mu = d_mu;
+      int jj = ii;
+      d_interp.clear();
+      while((int)d_interp.size() < nleft && jj < ni) {
+	d_interp.push(jj, gr::digital::symbol_interpolator::mmse_phase(mu));
+	if((int)d_interp.size() < nleft) {
+	  mu = mu + d_omega;
+	  jj += (int)floor(mu);
+	  mu -= floor(mu);
+	}
+      }
+
+      const int n = d_interp.size();
+      d_interp.interpolate(in, &out[oo]);
+      for(int j = 0; j < n; j++) {
+	err[oo+j] = detect(out[oo+j]);
+	d_error += err[oo+j];
+      }
+      oo += n;
+      d_count += n;
+
+      if(d_count == d_decim) {
+	d_omega = d_omega + d_gain_omega * d_error;
+	d_omega = d_omega_mid + gr::branchless_clip(d_omega-d_omega_mid, d_omega_relative_limit);
+	mu = mu + d_omega + d_gain_mu * d_error;
+	jj += (int)floor(mu);
+	mu -= floor(mu);
+	d_count = 0;
+	d_error = 0;
+      }
+      d_mu = mu;
+      ii = jj;
+    }
+    *consumed = ii;
+    return oo;
+  }
+};
+
+// Runs a loop over the input CHUNK samples at a time; returns
+// nanoseconds per symbol and the number of symbols in *nout
+template<class T>
+static double
+run(T &loop, const std::vector<gr_complex> &in, std::vector<gr_complex> &out,
+    std::vector<float> &err, int *nout)
+{
+  const int ntaps = 8;
+  int ii = 0, oo = 0, consumed;
+  double start = cpu_time();
+  while(ii + CHUNK + ntaps < (int)in.size()) {
+    oo += loop.run(&in[ii], CHUNK, &out[oo], &err[oo], &consumed);
+    ii += consumed;
+  }
+  *nout = oo;
+  return (cpu_time() - start) * 1e9 / oo;
+}
+
+static double
+tracking_error(const std::vector<float> &err, int n)
+{
+  double sum = 0;
+  for(int i = n/2; i < n; i++)
+    sum += fabs(err[i]);
+  return sum / (n - n/2);
+}
+
+int
+main(int argc, char **argv)
+{
+  // QPSK through a half sine pulse, sampled at TRUE_OMEGA samples per symbol
+  const int nsamples = (int)(NSYMBOLS * TRUE_OMEGA);
+  std::vector<gr_complex> symbols(NSYMBOLS + 2);
+  srand(1);
+  for(unsigned int i = 0; i < symbols.size(); i++)
+    symbols[i] = gr_complex(rand() & 1 ? 1 : -1, rand() & 1 ? 1 : -1);
+  std::vector<gr_complex> in(nsamples);
+  for(int i = 0; i < nsamples; i++) {
+    double t = i / TRUE_OMEGA;
+    int n = (int)t;
+    double frac = t - n;
+    in[i] = symbols[n] * (float)sin(M_PI * (frac + 0.5)) * (float)(frac < 0.5)
+      + symbols[n+1] * (float)sin(M_PI * (frac - 0.5)) * (float)(frac >= 0.5);
+  }
+
+  std::vector<gr_complex> out_legacy(NSYMBOLS + CHUNK), out(NSYMBOLS + CHUNK);
+  std::vector<float> err_legacy(NSYMBOLS + CHUNK), err(NSYMBOLS + CHUNK);
+  int n_legacy, n;
+
+  legacy_mm legacy;
+  double t_legacy = run(legacy, in, out_legacy, err_legacy, &n_legacy);
+  printf("legacy:            %6.1f ns  error %.4f\n", t_legacy, tracking_error(err_legacy, n_legacy));
+
+  bool ok = true;
+  for(int decim = 1; decim <= 64; decim *= 4) {
+    batch_mm batch(decim);
+    double t = run(batch, in, out, err, &n);
+    bool match = true;
+    if(decim == 1) {
+      double maxerr = 0;
+      for(int i = 0; i < CHUNK/4; i++)
+	maxerr = std::max(maxerr, (double)std::abs(out[i] - out_legacy[i]));
+      double e = tracking_error(err, n), e_legacy = tracking_error(err_legacy, n_legacy);
+      match = maxerr < 1e-3 && fabs(e - e_legacy) < 0.01 * e_legacy;
+      ok &= match;
+    }
+    printf("update every %2d:   %6.1f ns  error %.4f  %s\n", decim, t,
+	   tracking_error(err, n), match ? "" : "MISMATCH");
+  }
+
+  return ok ? 0 : 1;
+}
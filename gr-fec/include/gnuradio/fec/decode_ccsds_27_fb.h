@@ -47,6 +47,10 @@ namespace gr {
      * This block is designed for continuous data streaming, not packetized data.
      * The first 32 bits out will be zeroes, with the output delayed four bytes
      * from the corresponding inputs.
+     *
+     * The add-compare-select runs on 8-bit path metrics through the
+     * volk_8u_x4_conv_k7_r2_8u kernel, and each output byte is traced
+     * back 32 bits through the packed decision bits.
      */
     
     class FEC_API decode_ccsds_27_fb : virtual public sync_decimator
@@ -0,0 +1,82 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FEC_DECODE_RS_BB_H
+#define INCLUDED_FEC_DECODE_RS_BB_H
+
+#include <gnuradio/fec/api.h>
+#include <gnuradio/sync_block.h>
+
+namespace gr {
+  namespace fec {
+
+    /*! \brief Reed-Solomon decoder for 8-bit symbols
+     * \ingroup error_coding_blk
+     *
+     * \details
+     * Decodes a (possibly shortened) Reed-Solomon code over GF(2^8).
+     * Each input item is a vector of 255-pad code symbols, the message
+     * followed by the nroots parity symbols; each output item is the
+     * corrected message of 255-pad-nroots bytes. Codewords that cannot
+     * be corrected are passed through unchanged and counted.
+     *
+     * The code is given the same way as for the ATSC and CCSDS
+     * decoders: the field generator polynomial, the first consecutive
+     * root and the primitive element of the generator polynomial in
+     * index form, and the number of roots. The syndromes and the Chien
+     * search run in the VOLK GF(2^8) kernels on all codewords of a
+     * call to work.
+     */
+    class FEC_API decode_rs_bb : virtual public sync_block
+    {
+    public:
+      // gr::fec::decode_rs_bb::sptr
+      typedef boost::shared_ptr<decode_rs_bb> sptr;
+
+      /*!
+       * Build a Reed-Solomon decoder block.
+       *
+       * \param gfpoly Field generator polynomial, e.g. 0x11d
+       * \param fcr First consecutive root of the generator polynomial (index form)
+       * \param prim Primitive element used to generate the roots (index form)
+       * \param nroots Number of parity symbols
+       * \param pad Number of leading zero symbols removed from each codeword
+       */
+      static sptr make(int gfpoly, int fcr, int prim, int nroots, int pad);
+
+      //! Total number of symbols corrected so far
+      virtual unsigned long num_corrected() const = 0;
+
+      //! Number of codewords that could not be corrected so far
+      virtual unsigned long num_uncorrectable() const = 0;
+
+      //! Codeword length in symbols (the input vector length)
+      virtual int codeword_length() const = 0;
+
+      //! Message length in symbols (the output vector length)
+      virtual int message_length() const = 0;
+    };
+
+  } /* namespace fec */
+} /* namespace gr */
+
+#endif /* INCLUDED_FEC_DECODE_RS_BB_H */
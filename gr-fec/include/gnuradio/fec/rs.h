@@ -11,6 +11,20 @@ FEC_API void *init_rs_char(unsigned int symsize,unsigned int gfpoly,
                            unsigned int fcr,unsigned int prim,unsigned int nroots);
 FEC_API void free_rs_char(void *rs);
 
+/* RS decoder for 8-bit symbols using the VOLK GF(2^8) kernels.
+ * Decodes the same codes as decode_rs_char; data holds the nn-pad
+ * symbols of a shortened codeword, without the leading zero pad.
+ * The batch call decodes ncodewords blocks stride bytes apart, stores
+ * the per-codeword result in counts (if not NULL) and returns the
+ * number of uncorrectable codewords.
+ */
+FEC_API void *init_rs_volk(unsigned int symsize,unsigned int gfpoly,unsigned int fcr,
+                           unsigned int prim,unsigned int nroots,unsigned int pad);
+FEC_API int decode_rs_volk(void *rs,unsigned char *data,int *eras_pos,int no_eras);
+FEC_API int decode_rs_volk_batch(void *rs,unsigned char *data,unsigned int stride,
+                                 unsigned int ncodewords,int *counts);
+FEC_API void free_rs_volk(void *rs);
+
 /* General purpose RS codec, integer symbols */
 FEC_API void encode_rs_int(void *rs,int *data,int *parity);
 FEC_API int decode_rs_int(void *rs,int *data,int *eras_pos,int no_eras);
@@ -31,6 +31,21 @@ struct viterbi_state {
   long metric;		/* Cumulative metric to this state */
 };
 
+/* The SIMD decoder keeps 8-bit path metrics and one decision bit per
+ * state and decoded bit (8 bytes per bit) in a ring buffer, and traces
+ * back through the packed decisions on demand. Chainbacks may reach at
+ * most this many bits into the past.
+ */
+#define VITERBI_VOLK_HISTORY 64
+
+struct viterbi_volk_state {
+  unsigned char *metrics;	/* Path metrics, 64 bytes */
+  unsigned char *scratch;	/* Scratch metrics, 64 bytes */
+  unsigned char *decisions;	/* Decision ring, 8*VITERBI_VOLK_HISTORY bytes */
+  unsigned char branchtab[64];	/* Expected symbols per butterfly */
+  unsigned long bitcnt;		/* Bits decoded since the last reset */
+};
+
 FEC_API
 int gen_met(int mettab[2][256],	/* Metric table */
 	    int amp,		/* Signal amplitude */
@@ -51,3 +66,20 @@ viterbi_butterfly2(unsigned char *symbols, int mettab[2][256],
 
 FEC_API unsigned char
 viterbi_get_output(struct viterbi_state *state, unsigned char *outbuf);
+
+FEC_API int
+viterbi_volk_init(struct viterbi_volk_state *vp, int polya, int polyb);
+
+FEC_API void
+viterbi_volk_free(struct viterbi_volk_state *vp);
+
+FEC_API void
+viterbi_volk_reset(struct viterbi_volk_state *vp);
+
+FEC_API void
+viterbi_volk_update(struct viterbi_volk_state *vp,
+		    const unsigned char *symbols, unsigned int nbits);
+
+FEC_API void
+viterbi_volk_chainback(struct viterbi_volk_state *vp, unsigned int depth,
+		       unsigned char *data, unsigned int nbytes);
@@ -26,6 +26,13 @@
 
 #include "decode_ccsds_27_fb_impl.h"
 #include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <cmath>
+
+// The two generator polynomials for the NASA Standard K=7 code, in the
+// order encode_ccsds_27_bb emits their symbols
+#define POLYA 0x6d
+#define POLYB 0x4f
 
 namespace gr {
   namespace fec {
@@ -39,15 +46,15 @@ namespace gr {
       : sync_decimator("decode_ccsds_27_fb",
 			  io_signature::make (1, 1, sizeof(float)),
 			  io_signature::make (1, 1, sizeof(char)),
-			  2*8), d_count(0)  // Rate 1/2 code, unpacked to packed conversion
+			  2*8)  // Rate 1/2 code, unpacked to packed conversion
     {
-      float RATE = 0.5;
-      float ebn0 = 12.0;
-      float esn0 = RATE*pow(10.0, ebn0/10.0);
-      
-      gen_met(d_mettab, 100, esn0, 0.0, 256);
-      viterbi_chunks_init(d_state0);
-      viterbi_chunks_init(d_state1);
+      if(viterbi_volk_init(&d_state, POLYA, POLYB) < 0)
+	throw std::runtime_error("decode_ccsds_27_fb: failed to allocate decoder state");
+    }
+
+    decode_ccsds_27_fb_impl::~decode_ccsds_27_fb_impl()
+    {
+      viterbi_volk_free(&d_state);
     }
 
     int
@@ -57,32 +64,31 @@ namespace gr {
     {
       const float *in = (const float *)input_items[0];
       unsigned char *out = (unsigned char *)output_items[0];
-      
-      for (int i = 0; i < noutput_items*16; i++) {
+      int nsymbols = noutput_items*16;
+
+      if((int)d_viterbi_in.size() < nsymbols)
+	d_viterbi_in.resize(nsymbols);
+
+      for (int i = 0; i < nsymbols; i++) {
 	// Translate and clip [-1.0..1.0] to [28..228]
 	float sample = in[i]*100.0+128.0;
 	if (sample > 255.0)
 	  sample = 255.0;
 	else if (sample < 0.0)
 	  sample = 0.0;
-	unsigned char sym = (unsigned char)(floor(sample));
-	
-	d_viterbi_in[d_count % 4] = sym;
-	if ((d_count % 4) == 3) {
-	  // Every fourth symbol, perform butterfly operation
-	  viterbi_butterfly2(d_viterbi_in, d_mettab, d_state0, d_state1);
-	  
-	  // Every sixteenth symbol, read out a byte
-	  if (d_count % 16 == 11) {
-	    // long metric =
-	    viterbi_get_output(d_state0, out++);
-	    // printf("%li\n", *(out-1), metric);
-	  }
-	}
-	
-	d_count++;
+	d_viterbi_in[i] = (unsigned char)(floor(sample));
+      }
+
+      // Read out a byte six bits into every sixteen symbols, tracing
+      // back 32 bits to keep the latency of the path-register decoder.
+      const unsigned char *syms = &d_viterbi_in[0];
+      for (int i = 0; i < noutput_items; i++) {
+	viterbi_volk_update(&d_state, syms, 6);
+	viterbi_volk_chainback(&d_state, 32, out++, 1);
+	viterbi_volk_update(&d_state, syms+12, 2);
+	syms += 16;
       }
-      
+
       return noutput_items;
     }
 
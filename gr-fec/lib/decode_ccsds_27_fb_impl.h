@@ -24,6 +24,7 @@
 #define INCLUDED_FEC_DECODE_CCSDS_27_FB_IMPL_H
 
 #include <gnuradio/fec/decode_ccsds_27_fb.h>
+#include <vector>
 
 extern "C" {
 #include <gnuradio/fec/viterbi.h>
@@ -36,15 +37,12 @@ namespace gr {
     {
     private:
       // Viterbi state
-      int d_mettab[2][256];
-      struct viterbi_state d_state0[64];
-      struct viterbi_state d_state1[64];
-      unsigned char d_viterbi_in[16];
-      
-      int d_count;
+      struct viterbi_volk_state d_state;
+      std::vector<unsigned char> d_viterbi_in;
 
     public:
       decode_ccsds_27_fb_impl();
+      ~decode_ccsds_27_fb_impl();
 
       int work(int noutput_items,
 	       gr_vector_const_void_star &input_items,
@@ -0,0 +1,101 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "decode_rs_bb_impl.h"
+#include <gnuradio/io_signature.h>
+#include <stdexcept>
+#include <string.h>
+
+extern "C" {
+#include <gnuradio/fec/rs.h>
+}
+
+namespace gr {
+  namespace fec {
+
+    static const int RS_NN = 255;
+
+    decode_rs_bb::sptr
+    decode_rs_bb::make(int gfpoly, int fcr, int prim, int nroots, int pad)
+    {
+      return gnuradio::get_initial_sptr
+	(new decode_rs_bb_impl(gfpoly, fcr, prim, nroots, pad));
+    }
+
+    decode_rs_bb_impl::decode_rs_bb_impl(int gfpoly, int fcr, int prim,
+					 int nroots, int pad)
+      : sync_block("decode_rs_bb",
+		   io_signature::make(1, 1, sizeof(char)*(RS_NN - pad)),
+		   io_signature::make(1, 1, sizeof(char)*(RS_NN - pad - nroots))),
+	d_rs(0), d_n(RS_NN - pad), d_k(RS_NN - pad - nroots),
+	d_num_corrected(0), d_num_uncorrectable(0)
+    {
+      if(nroots <= 0 || pad < 0 || d_k <= 0)
+	throw std::invalid_argument("decode_rs_bb: invalid nroots or pad");
+
+      d_rs = init_rs_volk(8, gfpoly, fcr, prim, nroots, pad);
+      if(d_rs == 0)
+	throw std::runtime_error("decode_rs_bb: init_rs_volk failed");
+    }
+
+    decode_rs_bb_impl::~decode_rs_bb_impl()
+    {
+      free_rs_volk(d_rs);
+    }
+
+    int
+    decode_rs_bb_impl::work(int noutput_items,
+			    gr_vector_const_void_star &input_items,
+			    gr_vector_void_star &output_items)
+    {
+      const unsigned char *in = (const unsigned char *)input_items[0];
+      unsigned char *out = (unsigned char *)output_items[0];
+
+      // Decode all codewords of this call in one batch
+      if(d_buf.size() < (size_t)(noutput_items*d_n)) {
+	d_buf.resize(noutput_items*d_n);
+	d_counts.resize(noutput_items);
+      }
+      memcpy(&d_buf[0], in, noutput_items*d_n);
+
+      d_num_uncorrectable +=
+	decode_rs_volk_batch(d_rs, &d_buf[0], d_n, noutput_items, &d_counts[0]);
+
+      for(int i = 0; i < noutput_items; i++) {
+	if(d_counts[i] < 0) {
+	  // Pass uncorrectable codewords through as received
+	  memcpy(out + i*d_k, in + i*d_n, d_k);
+	  continue;
+	}
+	d_num_corrected += d_counts[i];
+	memcpy(out + i*d_k, &d_buf[i*d_n], d_k);
+      }
+
+      return noutput_items;
+    }
+
+  } /* namespace fec */
+} /* namespace gr */
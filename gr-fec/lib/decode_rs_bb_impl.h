@@ -0,0 +1,60 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_FEC_DECODE_RS_BB_IMPL_H
+#define INCLUDED_FEC_DECODE_RS_BB_IMPL_H
+
+#include <gnuradio/fec/decode_rs_bb.h>
+#include <vector>
+
+namespace gr {
+  namespace fec {
+
+    class FEC_API decode_rs_bb_impl : public decode_rs_bb
+    {
+    private:
+      void *d_rs;
+      int d_n;
+      int d_k;
+      unsigned long d_num_corrected;
+      unsigned long d_num_uncorrectable;
+      std::vector<unsigned char> d_buf;
+      std::vector<int> d_counts;
+
+    public:
+      decode_rs_bb_impl(int gfpoly, int fcr, int prim, int nroots, int pad);
+      ~decode_rs_bb_impl();
+
+      unsigned long num_corrected() const { return d_num_corrected; }
+      unsigned long num_uncorrectable() const { return d_num_uncorrectable; }
+      int codeword_length() const { return d_n; }
+      int message_length() const { return d_k; }
+
+      int work(int noutput_items,
+	       gr_vector_const_void_star &input_items,
+	       gr_vector_void_star &output_items);
+    };
+
+  } /* namespace fec */
+} /* namespace gr */
+
+#endif /* INCLUDED_FEC_DECODE_RS_BB_IMPL_H */
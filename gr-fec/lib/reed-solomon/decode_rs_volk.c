@@ -0,0 +1,364 @@
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Reed-Solomon decoder for 8-bit symbols using the VOLK GF(2^8) kernels.
+ *
+ * This decodes the same codes as decode_rs.c.  The two loops that touch
+ * every symbol of the block are vectorized:
+ *
+ *  - the syndromes are computed with volk_8u_x2_gf256_horner_8u, which
+ *    runs Horner's rule on 16 symbols at a time;
+ *  - the Chien search evaluates the error locator at all NN points at
+ *    once with volk_8u_x2_gf256_lincomb_8u, as a combination of the
+ *    precomputed rows alpha^(i*j) with the locator coefficients.
+ *
+ * Berlekamp-Massey and Forney work on at most NROOTS values and stay
+ * scalar, following Karn's decoder.  Shortened codes are decoded in
+ * place without copying the block behind a run of zero pad symbols.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <volk/volk.h>
+
+#include "char.h"
+#include <gnuradio/fec/rs.h>
+
+#ifndef NULL
+#define NULL ((void *)0)
+#endif
+
+#define	min(a,b)	((a) < (b) ? (a) : (b))
+
+/* Only 8-bit symbols: every array fits in 256 entries */
+#define RS_VOLK_MAX 256
+
+struct rs_volk {
+  struct rs *rs;                /* Field tables and code parameters */
+  unsigned int pad;             /* Number of leading pad symbols */
+  unsigned char *multab;        /* Split multiplication table per symbol, 32*256 */
+  unsigned char *syn_tables;    /* Horner tables per syndrome root, 160*NROOTS */
+  unsigned char *chien_rows;    /* alpha^(i*j), (NROOTS+1) rows of NN points */
+  unsigned char *chien_tables;  /* Split tables of the locator coefficients */
+  unsigned char *chien_out;     /* Locator values at the NN points */
+};
+
+static unsigned char
+gf_mul(struct rs *rs, unsigned char a, unsigned char b)
+{
+  if(a == 0 || b == 0)
+    return 0;
+  return ALPHA_TO[MODNN(INDEX_OF[a] + INDEX_OF[b])];
+}
+
+void
+free_rs_volk(void *p)
+{
+  struct rs_volk *rv = (struct rs_volk *)p;
+
+  if(rv == NULL)
+    return;
+  if(rv->rs)
+    free_rs_char(rv->rs);
+  free(rv->multab);
+  free(rv->syn_tables);
+  free(rv->chien_rows);
+  free(rv->chien_tables);
+  free(rv->chien_out);
+  free(rv);
+}
+
+/* Initialize a Reed-Solomon decoder
+ * symsize = symbol size, bits (must be 8)
+ * gfpoly = Field generator polynomial coefficients
+ * fcr = first root of RS code generator polynomial, index form
+ * prim = primitive element to generate polynomial roots
+ * nroots = RS code generator polynomial degree (number of roots)
+ * pad = number of leading zero symbols of a shortened code
+ */
+void *
+init_rs_volk(unsigned int symsize, unsigned int gfpoly, unsigned int fcr,
+	     unsigned int prim, unsigned int nroots, unsigned int pad)
+{
+  struct rs_volk *rv;
+  struct rs *rs;
+  unsigned int i, j, k, n;
+
+  if(symsize != 8)
+    return NULL;
+
+  rv = (struct rs_volk *)calloc(1, sizeof(struct rs_volk));
+  if(rv == NULL)
+    return NULL;
+
+  rv->rs = rs = (struct rs *)init_rs_char(symsize, gfpoly, fcr, prim, nroots);
+  if(rs == NULL || pad >= NN - NROOTS) {
+    free_rs_volk(rv);
+    return NULL;
+  }
+  rv->pad = pad;
+
+  rv->multab = (unsigned char *)malloc(32*(NN+1));
+  rv->syn_tables = (unsigned char *)malloc(160*NROOTS);
+  rv->chien_rows = (unsigned char *)malloc((NROOTS+1)*NN);
+  rv->chien_tables = (unsigned char *)malloc(32*(NROOTS+1));
+  rv->chien_out = (unsigned char *)malloc(NN);
+  if(rv->multab == NULL || rv->syn_tables == NULL || rv->chien_rows == NULL ||
+     rv->chien_tables == NULL || rv->chien_out == NULL) {
+    free_rs_volk(rv);
+    return NULL;
+  }
+
+  /* c*n and c*(n<<4) for every symbol c */
+  for(i = 0; i <= NN; i++) {
+    for(n = 0; n < 16; n++) {
+      rv->multab[32*i + n] = gf_mul(rs, i, n);
+      rv->multab[32*i + 16 + n] = gf_mul(rs, i, n << 4);
+    }
+  }
+
+  /* x^16, x^8, x^4, x^2 and x for the roots x = alpha^((FCR+i)*PRIM) */
+  for(i = 0; i < NROOTS; i++) {
+    unsigned char x = ALPHA_TO[MODNN((FCR+i)*PRIM)];
+    unsigned char powers[5];
+
+    powers[4] = x;
+    for(k = 4; k > 0; k--)
+      powers[k-1] = gf_mul(rs, powers[k], powers[k]);
+    for(k = 0; k < 5; k++)
+      memcpy(rv->syn_tables + 160*i + 32*k, rv->multab + 32*powers[k], 32);
+  }
+
+  /* Point i of row j is alpha^(i*j); point 0 stands for alpha^NN */
+  for(j = 0; j <= NROOTS; j++) {
+    for(i = 0; i < NN; i++)
+      rv->chien_rows[j*NN + i] = ALPHA_TO[MODNN(i*j)];
+  }
+
+  return rv;
+}
+
+int
+decode_rs_volk(void *p, unsigned char *data, int *eras_pos, int no_eras)
+{
+  struct rs_volk *rv = (struct rs_volk *)p;
+  struct rs *rs = rv->rs;
+  const unsigned int pad = rv->pad;
+  int deg_lambda, el, deg_omega;
+  int i, j, r, k;
+  unsigned char u, tmp, num1, num2, den, discr_r;
+  unsigned char lambda[RS_VOLK_MAX], s[RS_VOLK_MAX];
+  unsigned char b[RS_VOLK_MAX], t[RS_VOLK_MAX], omega[RS_VOLK_MAX];
+  int root[RS_VOLK_MAX], loc[RS_VOLK_MAX];
+  int syn_error, count;
+
+  /* form the syndromes; the pad symbols are zero and do not contribute */
+  volk_8u_x2_gf256_horner_8u(s, data, rv->syn_tables, NROOTS, NN - pad);
+
+  /* Convert syndromes to index form, checking for nonzero condition */
+  syn_error = 0;
+  for(i = 0; (unsigned int)i < NROOTS; i++) {
+    syn_error |= s[i];
+    s[i] = INDEX_OF[s[i]];
+  }
+
+  if(!syn_error) {
+    /* if syndrome is zero, data[] is a codeword and there are no
+     * errors to correct. So return data[] unmodified
+     */
+    count = 0;
+    goto finish;
+  }
+  memset(&lambda[1], 0, NROOTS*sizeof(lambda[0]));
+  lambda[0] = 1;
+
+  if(no_eras > 0) {
+    /* Init lambda to be the erasure locator polynomial */
+    lambda[1] = ALPHA_TO[MODNN(PRIM*(NN-1-(eras_pos[0]+pad)))];
+    for(i = 1; i < no_eras; i++) {
+      u = MODNN(PRIM*(NN-1-(eras_pos[i]+pad)));
+      for(j = i+1; j > 0; j--) {
+	tmp = INDEX_OF[lambda[j - 1]];
+	if(tmp != A0)
+	  lambda[j] ^= ALPHA_TO[MODNN(u + tmp)];
+      }
+    }
+  }
+  for(i = 0; (unsigned int)i < NROOTS+1; i++)
+    b[i] = INDEX_OF[lambda[i]];
+
+  /*
+   * Begin Berlekamp-Massey algorithm to determine error+erasure
+   * locator polynomial
+   */
+  r = no_eras;
+  el = no_eras;
+  while((unsigned int)(++r) <= NROOTS) {	/* r is the step number */
+    /* Compute discrepancy at the r-th step in poly-form */
+    discr_r = 0;
+    for(i = 0; i < r; i++) {
+      if((lambda[i] != 0) && (s[r-i-1] != A0)) {
+	discr_r ^= ALPHA_TO[MODNN(INDEX_OF[lambda[i]] + s[r-i-1])];
+      }
+    }
+    discr_r = INDEX_OF[discr_r];	/* Index form */
+    if(discr_r == A0) {
+      /* 2 lines below: B(x) <-- x*B(x) */
+      memmove(&b[1], b, NROOTS*sizeof(b[0]));
+      b[0] = A0;
+    } else {
+      /* 7 lines below: T(x) <-- lambda(x) - discr_r*x*b(x) */
+      t[0] = lambda[0];
+      for(i = 0 ; (unsigned int)i < NROOTS; i++) {
+	if(b[i] != A0)
+	  t[i+1] = lambda[i+1] ^ ALPHA_TO[MODNN(discr_r + b[i])];
+	else
+	  t[i+1] = lambda[i+1];
+      }
+      if(2 * el <= r + no_eras - 1) {
+	el = r + no_eras - el;
+	/*
+	 * 2 lines below: B(x) <-- inv(discr_r) *
+	 * lambda(x)
+	 */
+	for(i = 0; (unsigned int)i <= NROOTS; i++)
+	  b[i] = (lambda[i] == 0) ? A0 : MODNN(INDEX_OF[lambda[i]] - discr_r + NN);
+      } else {
+	/* 2 lines below: B(x) <-- x*B(x) */
+	memmove(&b[1], b, NROOTS*sizeof(b[0]));
+	b[0] = A0;
+      }
+      memcpy(lambda, t, (NROOTS+1)*sizeof(t[0]));
+    }
+  }
+
+  /* Compute deg(lambda(x)) while lambda is still in poly form */
+  deg_lambda = 0;
+  for(i = 0; (unsigned int)i < NROOTS+1; i++) {
+    memcpy(rv->chien_tables + 32*i, rv->multab + 32*lambda[i], 32);
+    if(lambda[i] != 0)
+      deg_lambda = i;
+  }
+
+  /* Find roots of the error+erasure locator polynomial by Chien search,
+   * evaluating lambda(alpha^i) at all NN points at once
+   */
+  volk_8u_x2_gf256_lincomb_8u(rv->chien_out, rv->chien_rows, rv->chien_tables,
+			      deg_lambda + 1, NN);
+
+  count = 0;		/* Number of roots of lambda(x) */
+  for(i = 0; (unsigned int)i < NN && count < deg_lambda; i++) {
+    if(rv->chien_out[i] != 0)
+      continue; /* Not a root */
+    /* store root (index-form) and error location number */
+    k = MODNN(i*IPRIM + NN - 1);
+    if((unsigned int)k < pad) {
+      /* Error in the pad symbols => uncorrectable */
+      count = -1;
+      goto finish;
+    }
+    root[count] = i;
+    loc[count] = k;
+    count++;
+  }
+  if(deg_lambda != count) {
+    /*
+     * deg(lambda) unequal to number of roots => uncorrectable
+     * error detected
+     */
+    count = -1;
+    goto finish;
+  }
+
+  /* Convert lambda to index form */
+  for(i = 0; (unsigned int)i < NROOTS+1; i++)
+    lambda[i] = INDEX_OF[lambda[i]];
+
+  /*
+   * Compute err+eras evaluator poly omega(x) = s(x)*lambda(x) (modulo
+   * x**NROOTS). in index form. Also find deg(omega).
+   */
+  deg_omega = 0;
+  for(i = 0; (unsigned int)i < NROOTS; i++) {
+    tmp = 0;
+    j = (deg_lambda < i) ? deg_lambda : i;
+    for(; j >= 0; j--) {
+      if((s[i - j] != A0) && (lambda[j] != A0))
+	tmp ^= ALPHA_TO[MODNN(s[i - j] + lambda[j])];
+    }
+    if(tmp != 0)
+      deg_omega = i;
+    omega[i] = INDEX_OF[tmp];
+  }
+  omega[NROOTS] = A0;
+
+  /*
+   * Compute error values in poly-form. num1 = omega(inv(X(l))), num2 =
+   * inv(X(l))**(FCR-1) and den = lambda_pr(inv(X(l))) all in poly-form
+   */
+  for(j = count-1; j >= 0; j--) {
+    num1 = 0;
+    for(i = deg_omega; i >= 0; i--) {
+      if(omega[i] != A0)
+	num1 ^= ALPHA_TO[MODNN(omega[i] + i * root[j])];
+    }
+    num2 = ALPHA_TO[MODNN(root[j] * (FCR - 1) + NN)];
+    den = 0;
+
+    /* lambda[i+1] for i even is the formal derivative lambda_pr of lambda[i] */
+    for(i = (int)min((unsigned int)deg_lambda, NROOTS-1) & ~1; i >= 0; i -= 2) {
+      if(lambda[i+1] != A0)
+	den ^= ALPHA_TO[MODNN(lambda[i+1] + i * root[j])];
+    }
+    if(den == 0) {
+      count = -1;
+      goto finish;
+    }
+    /* Apply error to data */
+    if(num1 != 0) {
+      data[loc[j] - pad] ^= ALPHA_TO[MODNN(INDEX_OF[num1] + INDEX_OF[num2] + NN - INDEX_OF[den])];
+    }
+  }
+ finish:
+  if(eras_pos != NULL) {
+    for(i = 0; i < count; i++)
+      eras_pos[i] = loc[i] - pad;
+  }
+  return count;
+}
+
+int
+decode_rs_volk_batch(void *p, unsigned char *data, unsigned int stride,
+		     unsigned int ncodewords, int *counts)
+{
+  unsigned int n;
+  int count, failures = 0;
+
+  for(n = 0; n < ncodewords; n++) {
+    count = decode_rs_volk(p, data + n*stride, NULL, 0);
+    if(count < 0)
+      failures++;
+    if(counts != NULL)
+      counts[n] = count;
+  }
+  return failures;
+}
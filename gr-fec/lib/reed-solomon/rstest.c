@@ -11,6 +11,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <gnuradio/fec/rs.h>
 
@@ -51,6 +52,52 @@ struct {
   {0, 0, 0, 0, 0},
 };
 
+/* Compare the VOLK decoder with decode_rs_char on a shortened 8-bit
+ * code, with random errors up to the correction capacity
+ */
+static int
+exercise_volk(void *handle,int nroots,int pad,int trials){
+  void *vhandle;
+  unsigned char block[255],tblock[255],vblock[255];
+  int errlocs[255];
+  int errors,derrors,vderrors,errloc,i;
+  int decoder_errors = 0;
+
+  if((vhandle = init_rs_volk(8,Tab[6].genpoly,Tab[6].fcs,Tab[6].prim,nroots,pad)) == NULL){
+    printf("init_rs_volk failed!\n");
+    return 1;
+  }
+  while(trials-- != 0){
+    for(errors=0;errors <= nroots/2;errors++){
+      memset(block,0,sizeof(block));
+      for(i=pad;i<255-nroots;i++)
+	block[i] = random() & 255;
+      encode_rs_char(handle,&block[0],&block[255-nroots]);
+
+      memcpy(tblock,block,sizeof(tblock));
+      memset(errlocs,0,sizeof(errlocs));
+      for(i=0;i<errors;i++){
+	do {
+	  errloc = pad + random() % (255-pad);
+	} while(errlocs[errloc] != 0);
+	errlocs[errloc] = 1;
+	tblock[errloc] ^= 1 + random() % 255;
+      }
+      memcpy(vblock,&tblock[pad],255-pad);
+
+      derrors = decode_rs_char(handle,tblock,NULL,0);
+      vderrors = decode_rs_volk(vhandle,vblock,NULL,0);
+      if(vderrors != derrors || memcmp(vblock,&block[pad],255-pad) != 0){
+	printf("(%d,%d) VOLK: decoder says %d errors, true number is %d\n",
+	       255-pad,255-pad-nroots,vderrors,errors);
+	decoder_errors++;
+      }
+    }
+  }
+  free_rs_volk(vhandle);
+  return decoder_errors;
+}
+
 int main(){
   void *handle;
   int errs,terrs;
@@ -108,6 +155,18 @@ int main(){
     }
     free_rs_char(handle);
   }
+
+  printf("Testing VOLK (207,187) RS decoder...");
+  fflush(stdout);
+  if((handle = init_rs_char(8,Tab[6].genpoly,Tab[6].fcs,Tab[6].prim,20)) != NULL){
+    errs = exercise_volk(handle,20,48,10);
+    terrs += errs;
+    if(errs == 0){
+      printf("OK\n");
+    }
+    free_rs_char(handle);
+  }
+
   if(terrs == 0)
     printf("All codec tests passed!\n");
 
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Viterbi decoder for K=7 rate=1/2 convolutional codes using the VOLK
+ * add-compare-select kernel on 8-bit metrics with packed decisions.
+ *
+ * This decodes the same trellis as viterbi.c: the path register of the
+ * scalar decoder is replaced by a traceback through the decision ring,
+ * so chainback(32, 1) returns the byte viterbi_get_output() would.
+ */
+
+#include <gnuradio/fec/viterbi.h>
+#include <volk/volk.h>
+#include <volk/volk_malloc.h>
+#include <string.h>
+
+extern unsigned char Partab[];	/* Parity lookup table */
+
+int
+viterbi_volk_init(struct viterbi_volk_state *vp, int polya, int polyb)
+{
+  size_t alignment = volk_get_alignment();
+  int i;
+
+  /* The butterfly structure needs both end taps of both polynomials */
+  if((polya & 0x41) != 0x41 || (polyb & 0x41) != 0x41 ||
+     polya > 0x7f || polyb > 0x7f)
+    return -1;
+
+  vp->metrics = (unsigned char*)volk_malloc(64, alignment);
+  vp->scratch = (unsigned char*)volk_malloc(64, alignment);
+  vp->decisions = (unsigned char*)volk_malloc(8*VITERBI_VOLK_HISTORY, alignment);
+  if(vp->metrics == NULL || vp->scratch == NULL || vp->decisions == NULL) {
+    viterbi_volk_free(vp);
+    return -1;
+  }
+
+  for(i = 0; i < 32; i++) {
+    vp->branchtab[i] = Partab[(2*i) & polya] ? 255 : 0;
+    vp->branchtab[32+i] = Partab[(2*i) & polyb] ? 255 : 0;
+  }
+
+  viterbi_volk_reset(vp);
+  return 0;
+}
+
+void
+viterbi_volk_free(struct viterbi_volk_state *vp)
+{
+  if(vp->metrics)
+    volk_free(vp->metrics);
+  if(vp->scratch)
+    volk_free(vp->scratch);
+  if(vp->decisions)
+    volk_free(vp->decisions);
+  vp->metrics = vp->scratch = vp->decisions = NULL;
+}
+
+void
+viterbi_volk_reset(struct viterbi_volk_state *vp)
+{
+  /* Initialize starting metrics to prefer 0 state. Decisions before the
+   * first bit read as zero, so early chainbacks return zero bits.
+   */
+  memset(vp->metrics, 63, 64);
+  vp->metrics[0] = 0;
+  memset(vp->decisions, 0, 8*VITERBI_VOLK_HISTORY);
+  vp->bitcnt = 0;
+}
+
+void
+viterbi_volk_update(struct viterbi_volk_state *vp,
+		    const unsigned char *symbols, unsigned int nbits)
+{
+  /* Run the kernel over contiguous runs of the decision ring */
+  while(nbits > 0) {
+    unsigned int pos = vp->bitcnt % VITERBI_VOLK_HISTORY;
+    unsigned int n = VITERBI_VOLK_HISTORY - pos;
+    if(n > nbits)
+      n = nbits;
+
+    volk_8u_x4_conv_k7_r2_8u(vp->scratch, vp->metrics,
+			     symbols, vp->decisions + 8*pos,
+			     n, vp->branchtab);
+
+    symbols += 2*n;
+    nbits -= n;
+    vp->bitcnt += n;
+  }
+}
+
+void
+viterbi_volk_chainback(struct viterbi_volk_state *vp, unsigned int depth,
+		       unsigned char *data, unsigned int nbytes)
+{
+  unsigned int state = 0, i, pos, bit;
+  unsigned int nbits = 8*nbytes;
+
+  if(depth > VITERBI_VOLK_HISTORY)
+    depth = VITERBI_VOLK_HISTORY;
+  if(nbits > depth)
+    nbits = depth;
+
+  /* Find current best path */
+  for(i = 1; i < 64; i++) {
+    if(vp->metrics[i] < vp->metrics[state])
+      state = i;
+  }
+
+  /* The decision of each state is the bit shifted out of the encoder
+   * on that step, so walk the surviving path back and keep the oldest
+   * nbits decisions, MSB first.
+   */
+  memset(data, 0, nbytes);
+  pos = vp->bitcnt;
+  for(i = 0; i < depth; i++) {
+    pos--;
+    bit = (vp->decisions[8*(pos % VITERBI_VOLK_HISTORY) + (state >> 3)] >> (state & 7)) & 1;
+    state = (state >> 1) | (bit << 5);
+    if(i >= depth - nbits) {
+      unsigned int k = depth - 1 - i;
+      data[k >> 3] |= bit << (7 - (k & 7));
+    }
+  }
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+#
+# Copyright 2014 Free Software Foundation, Inc.
+#
+# This file is part of GNU Radio
+#
+# GNU Radio is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 3, or (at your option)
+# any later version.
+#
+# GNU Radio is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GNU Radio; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+from gnuradio import gr, gr_unittest
+import fec_swig as fec
+import blocks_swig as blocks
+import random
+
+class test_decode_rs(gr_unittest.TestCase):
+
+    def setUp(self):
+        self.tb = gr.top_block()
+
+    def tearDown(self):
+        self.tb = None
+
+    def run_decoder(self, src_data, nroots, pad):
+        n = 255 - pad
+        src = blocks.vector_source_b(src_data, False, n)
+        dec = fec.decode_rs_bb(0x11d, 0, 1, nroots, pad)
+        dst = blocks.vector_sink_b(n - nroots)
+        self.tb.connect(src, dec, dst)
+        self.tb.run()
+        return dec, dst.data()
+
+    def test_001_correctable(self):
+        # The all-zero word is a codeword of every RS code; up to
+        # nroots/2 symbol errors per codeword must be corrected.
+        nroots, pad, ncw = 20, 48, 50
+        n = 255 - pad
+        random.seed(1)
+        src_data = []
+        nerrs = 0
+        for c in range(ncw):
+            cw = [0] * n
+            locs = random.sample(range(n), c % (nroots/2 + 1))
+            for l in locs:
+                cw[l] = random.randint(1, 255)
+            nerrs += len(locs)
+            src_data += cw
+        dec, dst_data = self.run_decoder(src_data, nroots, pad)
+        self.assertEqual(tuple([0] * (ncw*(n - nroots))), dst_data)
+        self.assertEqual(nerrs, dec.num_corrected())
+        self.assertEqual(0, dec.num_uncorrectable())
+
+    def test_002_uncorrectable(self):
+        # Errors on every symbol are detected and passed through
+        nroots, pad = 16, 100
+        n = 255 - pad
+        src_data = [1] * n
+        dec, dst_data = self.run_decoder(src_data, nroots, pad)
+        self.assertEqual(tuple([1] * (n - nroots)), dst_data)
+        self.assertEqual(1, dec.num_uncorrectable())
+
+if __name__ == '__main__':
+    gr_unittest.run(test_decode_rs, "test_decode_rs.xml")
@@ -29,11 +29,14 @@
 
 %{
 #include "gnuradio/fec/decode_ccsds_27_fb.h"
+#include "gnuradio/fec/decode_rs_bb.h"
 #include "gnuradio/fec/encode_ccsds_27_bb.h"
 %}
 
 %include "gnuradio/fec/decode_ccsds_27_fb.h"
+%include "gnuradio/fec/decode_rs_bb.h"
 %include "gnuradio/fec/encode_ccsds_27_bb.h"
 
 GR_SWIG_BLOCK_MAGIC2(fec, decode_ccsds_27_fb);
+GR_SWIG_BLOCK_MAGIC2(fec, decode_rs_bb);
 GR_SWIG_BLOCK_MAGIC2(fec, encode_ccsds_27_bb);
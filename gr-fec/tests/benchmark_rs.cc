@@ -0,0 +1,128 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compares decode_rs_char with the VOLK decoder on the ATSC (207,187)
+ * and CCSDS-style (255,223) codes, for clean codewords and codewords
+ * with t/2 and t symbol errors. Both decoders must return the same
+ * corrections.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <vector>
+
+extern "C" {
+#include <gnuradio/fec/rs.h>
+}
+
+#define NCODEWORDS 20000
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static bool
+run(const char *name, int gfpoly, int fcr, int prim, int nroots, int pad,
+    int nerrors)
+{
+  const int nn = 255, n = nn - pad;
+  void *rs = init_rs_char(8, gfpoly, fcr, prim, nroots);
+  void *rv = init_rs_volk(8, gfpoly, fcr, prim, nroots, pad);
+  std::vector<unsigned char> ref(NCODEWORDS*nn), dut(NCODEWORDS*n);
+  std::vector<int> counts(NCODEWORDS);
+  bool ok = true;
+
+  // Encode random shortened codewords and add nerrors symbol errors
+  for(int c = 0; c < NCODEWORDS; c++) {
+    unsigned char *cw = &ref[c*nn];
+    memset(cw, 0, pad);
+    for(int i = pad; i < nn - nroots; i++)
+      cw[i] = rand() & 0xff;
+    encode_rs_char(rs, cw, cw + nn - nroots);
+    for(int e = 0; e < nerrors; e++)
+      cw[pad + rand() % n] ^= 1 + rand() % 255;
+    memcpy(&dut[c*n], cw + pad, n);
+  }
+
+  double start = cpu_time();
+  for(int c = 0; c < NCODEWORDS; c++)
+    counts[c] = decode_rs_char(rs, &ref[c*nn], NULL, 0);
+  double t_char = cpu_time() - start;
+
+  start = cpu_time();
+  std::vector<int> vcounts(NCODEWORDS);
+  decode_rs_volk_batch(rv, &dut[0], n, NCODEWORDS, &vcounts[0]);
+  double t_volk = cpu_time() - start;
+
+  for(int c = 0; c < NCODEWORDS; c++) {
+    if(counts[c] >= 0 && (vcounts[c] != counts[c] ||
+			  memcmp(&ref[c*nn + pad], &dut[c*n], n) != 0))
+      ok = false;
+  }
+
+  printf("%-12s %2d errs  char: %8.0f cw/s  volk: %8.0f cw/s  %5.2fx  %s\n",
+	 name, nerrors, NCODEWORDS/t_char, NCODEWORDS/t_volk, t_char/t_volk,
+	 ok ? "ok" : "MISMATCH");
+
+  free_rs_volk(rv);
+  free_rs_char(rs);
+  return ok;
+}
+
+int
+main(int argc, char **argv)
+{
+  bool ok = true;
+
+  srand(1);
+  for(int e = 0; e <= 10; e += 5)
+    ok &= run("(207,187)", 0x11d, 0, 1, 20, 48, e);
+  for(int e = 0; e <= 16; e += 8)
+    ok &= run("(255,223)", 0x11d, 1, 1, 32, 0, e);
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compares the scalar path-register Viterbi decoder with the VOLK
+ * packed-decision decoder for the CCSDS K=7 rate 1/2 code. Both run the
+ * chunked streaming loop used by decode_ccsds_27_fb; the outputs must
+ * be identical on noise-free input, and every VOLK implementation must
+ * produce the same decisions as the generic one.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <vector>
+#include <volk/volk.h>
+
+extern "C" {
+#include <gnuradio/fec/viterbi.h>
+}
+
+#define NBYTES (100 * 1000)
+#define POLYA 0x6d
+#define POLYB 0x4f
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static double
+gaussian()
+{
+  double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double u2 = rand() / (RAND_MAX + 1.0);
+  return sqrt(-2.0*log(u1)) * cos(2.0*M_PI*u2);
+}
+
+// Encode random data and quantize to offset-binary soft symbols the
+// same way decode_ccsds_27_fb does.
+static void
+make_symbols(std::vector<unsigned char> &data,
+             std::vector<unsigned char> &syms, double sigma)
+{
+  std::vector<unsigned char> bits(16*NBYTES);
+
+  data.resize(NBYTES);
+  syms.resize(16*NBYTES);
+  for(int i = 0; i < NBYTES; i++)
+    data[i] = rand() & 0xff;
+  encode(&bits[0], &data[0], NBYTES, 0);
+
+  for(int i = 0; i < 16*NBYTES; i++) {
+    double sample = ((bits[i] ? 1.0 : -1.0) + sigma*gaussian())*100.0 + 128.0;
+    if(sample > 255.0)
+      sample = 255.0;
+    else if(sample < 0.0)
+      sample = 0.0;
+    syms[i] = (unsigned char)floor(sample);
+  }
+}
+
+static double
+decode_scalar(const std::vector<unsigned char> &syms,
+              std::vector<unsigned char> &out)
+{
+  int mettab[2][256];
+  struct viterbi_state state0[64], state1[64];
+
+  gen_met(mettab, 100, 0.5*pow(10.0, 12.0/10.0), 0.0, 256);
+  viterbi_chunks_init(state0);
+  viterbi_chunks_init(state1);
+  out.resize(NBYTES);
+
+  double start = cpu_time();
+  unsigned char *symbols = const_cast<unsigned char*>(&syms[0]);
+  for(int i = 0; i < NBYTES; i++) {
+    viterbi_butterfly2(symbols, mettab, state0, state1);
+    viterbi_butterfly2(symbols+4, mettab, state0, state1);
+    viterbi_butterfly2(symbols+8, mettab, state0, state1);
+    viterbi_get_output(state0, &out[i]);
+    viterbi_butterfly2(symbols+12, mettab, state0, state1);
+    symbols += 16;
+  }
+  return cpu_time() - start;
+}
+
+static double
+decode_volk(const std::vector<unsigned char> &syms,
+            std::vector<unsigned char> &out)
+{
+  struct viterbi_volk_state state;
+
+  if(viterbi_volk_init(&state, POLYA, POLYB) < 0) {
+    fprintf(stderr, "viterbi_volk_init failed\n");
+    exit(1);
+  }
+  out.resize(NBYTES);
+
+  double start = cpu_time();
+  const unsigned char *symbols = &syms[0];
+  for(int i = 0; i < NBYTES; i++) {
+    viterbi_volk_update(&state, symbols, 6);
+    viterbi_volk_chainback(&state, 32, &out[i], 1);
+    viterbi_volk_update(&state, symbols+12, 2);
+    symbols += 16;
+  }
+  double elapsed = cpu_time() - start;
+
+  viterbi_volk_free(&state);
+  return elapsed;
+}
+
+// Run the ACS kernel over the whole stream with one implementation and
+// return its decisions.
+static double
+acs_impl(const std::vector<unsigned char> &syms, const char *impl,
+         std::vector<unsigned char> &decisions)
+{
+  struct viterbi_volk_state state;
+  int nbits = 8*NBYTES;
+
+  viterbi_volk_init(&state, POLYA, POLYB);
+  decisions.resize(8*nbits);
+
+  double start = cpu_time();
+  volk_8u_x4_conv_k7_r2_8u_manual(state.scratch, state.metrics,
+                                  &syms[0], &decisions[0], nbits,
+                                  state.branchtab, impl);
+  double elapsed = cpu_time() - start;
+
+  viterbi_volk_free(&state);
+  return elapsed;
+}
+
+static int
+bit_errors(const std::vector<unsigned char> &data,
+           const std::vector<unsigned char> &out)
+{
+  int errors = 0;
+  // The decoders output the data delayed by four bytes
+  for(int i = 4; i < NBYTES; i++) {
+    unsigned char diff = data[i-4] ^ out[i];
+    for(; diff; diff &= diff - 1)
+      errors++;
+  }
+  return errors;
+}
+
+int
+main(int argc, char **argv)
+{
+  const double sigmas[] = {0.0, 0.5, 0.7, 0.9};
+  std::vector<unsigned char> data, syms, out_scalar, out_volk;
+  bool ok = true;
+
+  srand(1);
+
+  for(size_t s = 0; s < sizeof(sigmas)/sizeof(sigmas[0]); s++) {
+    make_symbols(data, syms, sigmas[s]);
+
+    double t_scalar = decode_scalar(syms, out_scalar);
+    double t_volk = decode_volk(syms, out_volk);
+    int differ = 0;
+    for(int i = 0; i < NBYTES; i++)
+      differ += out_scalar[i] != out_volk[i];
+
+    printf("sigma %4.2f  scalar: %8.3f Mb/s %6d errs  volk: %8.3f Mb/s %6d errs  %d bytes differ\n",
+           sigmas[s], 8e-6*NBYTES/t_scalar, bit_errors(data, out_scalar),
+           8e-6*NBYTES/t_volk, bit_errors(data, out_volk), differ);
+
+    if(sigmas[s] == 0.0 && differ != 0) {
+      printf("  FAIL: decoders disagree on noise-free input\n");
+      ok = false;
+    }
+  }
+
+  // Bit-exact check of every kernel implementation against generic
+  volk_func_desc_t desc = volk_8u_x4_conv_k7_r2_8u_get_func_desc();
+  std::vector<unsigned char> ref, dec;
+  acs_impl(syms, "generic", ref);
+  for(size_t i = 0; i < desc.n_impls; i++) {
+    double t = acs_impl(syms, desc.impl_names[i], dec);
+    bool same = (ref == dec);
+    printf("%18s:  acs: %8.3f Mb/s  %s\n", desc.impl_names[i],
+           8e-6*NBYTES/t, same ? "bit-exact" : "MISMATCH");
+    ok = ok && same;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -35,6 +35,20 @@ namespace gr {
     float min(float a, float b);
     float min_star(float a, float b);
 
+    /*!
+     * \brief min_star with log(1+exp(-|a-b|)) replaced by a
+     * piecewise linear function, resp. a table of eight steps.
+     */
+    float min_star_linear(float a, float b);
+    float min_star_lut(float a, float b);
+
+    /*!
+     * \brief Fills table with the 18 value correction of
+     * volk_32f_x2_trellis_maxstar_32f that matches p2mymin and returns
+     * true, or returns false if p2mymin has no such table.
+     */
+    bool min_star_table(float (*p2mymin)(float,float), float *table);
+
     template <class T>
     void viterbi_algorithm(int I, int S, int O,
 			   const std::vector<int> &NS,
@@ -0,0 +1,205 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef INCLUDED_TRELLIS_FSM_ENGINE_H
+#define INCLUDED_TRELLIS_FSM_ENGINE_H
+
+#include <gnuradio/trellis/api.h>
+#include <gnuradio/trellis/fsm.h>
+#include <vector>
+
+namespace gr {
+  namespace trellis {
+
+    /*!
+     * \brief Viterbi and SISO decoding on a flattened FSM trellis.
+     * \ingroup trellis_coding_blk
+     *
+     * \details
+     * The predecessor lists of the FSM are compiled once into flat
+     * tables with the same number of predecessors P for every state,
+     * so that the add-compare-select of a trellis step runs over all
+     * states at once (volk_32f_x2_trellis_acs_32f, or
+     * volk_16i_x2_trellis_acs_16i on saturating 16-bit metrics).  The
+     * decisions, path metrics and forward/backward metrics are kept
+     * between calls instead of being allocated for every block.
+     *
+     * viterbi() and siso() decode blocks of K steps with the same
+     * arguments and results as viterbi_algorithm() and
+     * siso_algorithm().  The stream_*() calls decode a continuous
+     * stream instead: decisions are traced back from the best state
+     * with a sliding window of a given depth, so the output lags the
+     * input by that many steps.  viterbi() and siso() end a stream in
+     * progress.
+     *
+     * An instance holds decoder state and must not be shared between
+     * threads.
+     */
+    class TRELLIS_API fsm_engine
+    {
+    private:
+      int d_I;
+      int d_S;
+      int d_O;
+      int d_P;
+      std::vector<int> d_NS;
+      std::vector<int> d_OS;
+
+      // Number of predecessors of each state, and for predecessor p of
+      // state j the previous state and input at [p*S+j]
+      std::vector<int> d_npred;
+      std::vector<int> d_pred_state;
+      std::vector<int> d_pred_input;
+
+      // ACS tables: P rows of predecessor states followed by P rows of
+      // branch metric indices; states without predecessors point at
+      // the extra, infinite path metric S
+      std::vector<int> d_vit_tables;
+      std::vector<int> d_fwd_tables;
+      std::vector<int> d_bwd_tables;
+
+      float d_scale;
+      int d_cur;
+      std::vector<float> d_metrics;
+      std::vector<short> d_qmetrics;
+      std::vector<short> d_qbranch;
+      std::vector<unsigned short> d_dec;
+
+      int d_depth;
+      int d_pending;
+
+      std::vector<float> d_alpha;
+      std::vector<float> d_beta;
+      std::vector<float> d_gamma;
+      std::vector<float> d_comb;
+
+      // min* correction of the recursions (see min_star_table()), and
+      // its 16-bit version
+      bool d_maxstar;
+      float d_corr[18];
+      short d_qcorr[18];
+      std::vector<short> d_qgamma;
+      std::vector<short> d_qalpha;
+      std::vector<short> d_qbeta;
+
+      void start(int S0);
+      void quantize(const float *in, int n, short *out) const;
+      void quantize_correction();
+      void acs(const float *in, unsigned short *dec);
+      int best_state() const;
+      template <class T> void traceback(int st, int nsteps, int nout, T *out) const;
+      void siso_branch(int k, const float *priori, const float *prioro);
+      void siso_step(int k, const float *priori, const float *prioro,
+		     const int *tables, int npred,
+		     const float *m0, float *m1,
+		     const short *q0, short *q1);
+
+    public:
+      /*!
+       * \brief Compiles the trellis of \p FSM.
+       */
+      fsm_engine(const fsm &FSM);
+
+      int I() const { return d_I; }
+      int S() const { return d_S; }
+      int O() const { return d_O; }
+
+      //! Predecessors per state in the flattened trellis
+      int P() const { return d_P; }
+
+      /*!
+       * \brief Selects 16-bit path metrics for the Viterbi decoder
+       * and the vectorized SISO recursions.
+       *
+       * With \p scale > 0 the branch metrics of each step are shifted
+       * so that the smallest is 0, multiplied by \p scale and rounded,
+       * and the ACS runs eight states per SSE register.  The scale
+       * should map the largest likely branch metric to a few hundred.
+       * The SISO forward and backward metrics are scaled back to float
+       * for the combining.  0 (the default) keeps float metrics.
+       */
+      void set_metric_scale(float scale);
+      float metric_scale() const { return d_scale; }
+
+      /*!
+       * \brief Decodes K steps, as viterbi_algorithm().
+       *
+       * \param K  number of trellis steps
+       * \param S0 initial state, or -1 if unknown
+       * \param SK final state, or -1 if unknown
+       * \param in K*O branch metrics
+       * \param out K decoded input symbols
+       */
+      template <class T>
+      void viterbi(int K, int S0, int SK, const float *in, T *out);
+
+      /*!
+       * \brief Starts decoding a continuous stream.
+       *
+       * \param S0    initial state, or -1 if unknown
+       * \param depth traceback depth in steps, e.g. five times the
+       *              memory of a convolutional code
+       */
+      void stream_start(int S0, int depth);
+
+      /*!
+       * \brief Decodes \p nsteps steps of the stream.
+       *
+       * \param in    nsteps*O branch metrics
+       * \param nsteps number of trellis steps
+       * \param out   room for nsteps decoded input symbols
+       * \return the number of symbols written, which leave the
+       *         window \p depth steps after their branch metrics
+       */
+      template <class T>
+      int stream_decode(const float *in, int nsteps, T *out);
+
+      /*!
+       * \brief Emits the symbols still in the traceback window.
+       *
+       * \param SK  final state, or -1 if unknown
+       * \param out room for depth decoded input symbols
+       * \return the number of symbols written
+       */
+      template <class T>
+      int stream_flush(int SK, T *out);
+
+      /*!
+       * \brief Soft-input soft-output decoding of K steps, as
+       * siso_algorithm().
+       *
+       * The recursions run vectorized when \p p2mymin is min(),
+       * min_star_linear() or min_star_lut(), the latter two with
+       * volk_32f_x2_trellis_maxstar_32f.  Other functions, such as
+       * min_star(), are evaluated per transition in the order of
+       * siso_algorithm().
+       */
+      void siso(int K, int S0, int SK,
+		bool POSTI, bool POSTO,
+		float (*p2mymin)(float,float),
+		const float *priori, const float *prioro, float *post);
+    };
+
+  } /* namespace trellis */
+} /* namespace gr */
+
+#endif /* INCLUDED_TRELLIS_FSM_ENGINE_H */
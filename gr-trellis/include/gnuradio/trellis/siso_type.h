@@ -28,7 +28,9 @@ namespace gr {
 
     typedef enum {
       TRELLIS_MIN_SUM = 200,
-      TRELLIS_SUM_PRODUCT
+      TRELLIS_SUM_PRODUCT,
+      TRELLIS_SUM_PRODUCT_LINEAR, // piecewise linear correction
+      TRELLIS_SUM_PRODUCT_LUT     // eight step table correction
     } siso_type_t;
     
   } /* namespace trellis */
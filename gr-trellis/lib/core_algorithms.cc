@@ -25,6 +25,7 @@
 #include <iostream>
 #include <gnuradio/trellis/core_algorithms.h>
 #include <gnuradio/trellis/calc_metric.h>
+#include <gnuradio/trellis/fsm_engine.h>
 
 namespace gr {
   namespace trellis {
@@ -43,6 +44,61 @@ namespace gr {
       return (a <= b ? a : b)-log(1+exp(a <= b ? a-b : b-a));
     }
 
+    // log(1+exp(-d)) as a line through log(2), resp. as steps of 0.5
+    // taking the value at the middle of each step
+    static const float MIN_STAR_LINEAR[18] = {
+      0.6931472, 0.25,
+      0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, 0, 0, 0, 0
+    };
+
+    static const float MIN_STAR_LUT[18] = {
+      0, 0,
+      0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 4.0,
+      0.1890684, 0.1349419, 0.0917049, 0.0600176,
+      0.0382390, 0.0239262, 0.0147959, 0.0232455
+    };
+
+    static float
+    min_star_corrected(float a, float b, const float *c)
+    {
+      float d = a <= b ? b-a : a-b;
+      float f = c[0]-c[1]*d;
+
+      f = f > 0 ? f : 0;
+      for(int k=0;k<8 && c[10+k]!=0;k++)
+        if(d < c[2+k]) f += c[10+k];
+      return (b < a ? b : a)-f;
+    }
+
+    float
+    min_star_linear(float a, float b)
+    {
+      return min_star_corrected(a,b,MIN_STAR_LINEAR);
+    }
+
+    float
+    min_star_lut(float a, float b)
+    {
+      return min_star_corrected(a,b,MIN_STAR_LUT);
+    }
+
+    bool
+    min_star_table(float (*p2mymin)(float,float), float *table)
+    {
+      const float *c;
+
+      if(p2mymin == &min_star_linear)
+        c = MIN_STAR_LINEAR;
+      else if(p2mymin == &min_star_lut)
+        c = MIN_STAR_LUT;
+      else
+        return false;
+      for(int k=0;k<18;k++)
+        table[k] = c[k];
+      return true;
+    }
+
     template <class T> void
     viterbi_algorithm(int I, int S, int O,
 		      const std::vector<int> &NS,
@@ -754,15 +810,16 @@ namespace gr {
 	iprioro[k*FSMi.O()] *= scaling;
       }
 
+      //compile the trellises of inner and outer FSM for their SISO runs
+      fsm_engine Ei(FSMi), Eo(FSMo);
+
       for(int rep=0;rep<iterations;rep++) {
 	// run inner SISO
-	siso_algorithm(FSMi.I(),FSMi.S(),FSMi.O(),
-		       FSMi.NS(), FSMi.OS(), FSMi.PS(), FSMi.PI(),
-		       blocklength,
-		       STi0,STiK,
-		       true, false,
-		       p2mymin,
-		       &(ipriori[0]), &(iprioro[0]), &(iposti[0]));
+	Ei.siso(blocklength,
+		STi0,STiK,
+		true, false,
+		p2mymin,
+		&(ipriori[0]), &(iprioro[0]), &(iposti[0]));
 
 	//interleave soft info inner -> outer
 	for(int k=0;k<blocklength;k++) {
@@ -776,13 +833,11 @@ namespace gr {
 	// run outer SISO
 
 	if(rep<iterations-1) { // do not produce posti
-	  siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-			 FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-			 blocklength,
-			 STo0,SToK,
-			 false, true,
-			 p2mymin,
-			 &(opriori[0]),  &(oprioro[0]), &(oposto[0]));
+	  Eo.siso(blocklength,
+		  STo0,SToK,
+		  false, true,
+		  p2mymin,
+		  &(opriori[0]),  &(oprioro[0]), &(oposto[0]));
 
 	  //interleave soft info outer --> inner
 	  for(int k=0;k<blocklength;k++) {
@@ -795,13 +850,11 @@ namespace gr {
 	}
 	else // produce posti but not posto
 
-	  siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-			 FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-			 blocklength,
-			 STo0,SToK,
-			 true, false,
-			 p2mymin,
-			 &(opriori[0]),  &(oprioro[0]), &(oposti[0]));
+	  Eo.siso(blocklength,
+		  STo0,SToK,
+		  true, false,
+		  p2mymin,
+		  &(opriori[0]),  &(oprioro[0]), &(oposti[0]));
 
 	/*
 	  viterbi_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
@@ -915,15 +968,16 @@ namespace gr {
       std::vector<float> oposti(blocklength*FSMo.I());
       std::vector<float> oposto(blocklength*FSMo.O());
 
+      //compile the trellises of inner and outer FSM for their SISO runs
+      fsm_engine Ei(FSMi), Eo(FSMo);
+
       for(int rep=0;rep<iterations;rep++) {
 	// run inner SISO
-	siso_algorithm(FSMi.I(),FSMi.S(),FSMi.O(),
-		       FSMi.NS(), FSMi.OS(), FSMi.PS(), FSMi.PI(),
-		       blocklength,
-		       STi0,STiK,
-		       true, false,
-		       p2mymin,
-		       &(ipriori[0]),  &(iprioro[0]), &(iposti[0]));
+	Ei.siso(blocklength,
+		STi0,STiK,
+		true, false,
+		p2mymin,
+		&(ipriori[0]),  &(iprioro[0]), &(iposti[0]));
 
 	//interleave soft info inner -> outer
 	for(int k=0;k<blocklength;k++) {
@@ -937,13 +991,11 @@ namespace gr {
 	// run outer SISO
 
 	if(rep<iterations-1) { // do not produce posti
-	  siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-			 FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-			 blocklength,
-			 STo0,SToK,
-			 false, true,
-			 p2mymin,
-			 &(opriori[0]),  &(oprioro[0]), &(oposto[0]));
+	  Eo.siso(blocklength,
+		  STo0,SToK,
+		  false, true,
+		  p2mymin,
+		  &(opriori[0]),  &(oprioro[0]), &(oposto[0]));
 
 	  //interleave soft info outer --> inner
 	  for(int k=0;k<blocklength;k++) {
@@ -955,13 +1007,11 @@ namespace gr {
 	  }
 	}
 	else {// produce posti but not posto
-	  siso_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
-			 FSMo.NS(), FSMo.OS(), FSMo.PS(), FSMo.PI(),
-			 blocklength,
-			 STo0,SToK,
-			 true, false,
-			 p2mymin,
-			 &(opriori[0]),  &(oprioro[0]), &(oposti[0]));
+	  Eo.siso(blocklength,
+		  STo0,SToK,
+		  true, false,
+		  p2mymin,
+		  &(opriori[0]),  &(oprioro[0]), &(oposti[0]));
 
 	  /*
 	    viterbi_algorithm(FSMo.I(),FSMo.S(),FSMo.O(),
@@ -1052,15 +1102,16 @@ namespace gr {
 	}
       }
 
+      //compile the trellises of FSM1 and FSM2 for their SISO runs
+      fsm_engine E1(FSM1), E2(FSM2);
+
       for(int rep=0;rep<iterations;rep++) {
 	// run  SISO 1
-	siso_algorithm(FSM1.I(),FSM1.S(),FSM1.O(),
-		       FSM1.NS(), FSM1.OS(), FSM1.PS(), FSM1.PI(),
-		       blocklength,
-		       ST10,ST1K,
-		       true, false,
-		       p2mymin,
-		       &(priori1[0]),  &(prioro1[0]), &(posti1[0]));
+	E1.siso(blocklength,
+		ST10,ST1K,
+		true, false,
+		p2mymin,
+		&(priori1[0]),  &(prioro1[0]), &(posti1[0]));
 
 	//for(int k=0;k<blocklength;k++){
 	//for(int i=0;i<FSM1.I();i++)
@@ -1078,13 +1129,11 @@ namespace gr {
 	}
 
 	// run SISO 2
-	siso_algorithm(FSM2.I(),FSM2.S(),FSM2.O(),
-		       FSM2.NS(), FSM2.OS(), FSM2.PS(), FSM2.PI(),
-		       blocklength,
-		       ST20,ST2K,
-		       true, false,
-		       p2mymin,
-		       &(priori2[0]),  &(prioro2[0]), &(posti2[0]));
+	E2.siso(blocklength,
+		ST20,ST2K,
+		true, false,
+		p2mymin,
+		&(priori2[0]),  &(prioro2[0]), &(posti2[0]));
 
 	//interleave soft info 2 --> 1
 	for(int k=0;k<blocklength;k++) {
@@ -1192,15 +1241,16 @@ namespace gr {
 	}
       }
 
+      //compile the trellises of FSM1 and FSM2 for their SISO runs
+      fsm_engine E1(FSM1), E2(FSM2);
+
       for(int rep=0;rep<iterations;rep++) {
 	// run  SISO 1
-	siso_algorithm(FSM1.I(),FSM1.S(),FSM1.O(),
-		       FSM1.NS(), FSM1.OS(), FSM1.PS(), FSM1.PI(),
-		       blocklength,
-		       ST10,ST1K,
-		       true, false,
-		       p2mymin,
-		       &(priori1[0]),  &(prioro1[0]), &(posti1[0]));
+	E1.siso(blocklength,
+		ST10,ST1K,
+		true, false,
+		p2mymin,
+		&(priori1[0]),  &(prioro1[0]), &(posti1[0]));
 
 	//for(int k=0;k<blocklength;k++){
 	//for(int i=0;i<FSM1.I();i++)
@@ -1218,13 +1268,11 @@ namespace gr {
 	}
 
 	// run SISO 2
-	siso_algorithm(FSM2.I(),FSM2.S(),FSM2.O(),
-		       FSM2.NS(), FSM2.OS(), FSM2.PS(), FSM2.PI(),
-		       blocklength,
-		       ST20,ST2K,
-		       true, false,
-		       p2mymin,
-		       &(priori2[0]),  &(prioro2[0]), &(posti2[0]));
+	E2.siso(blocklength,
+		ST20,ST2K,
+		true, false,
+		p2mymin,
+		&(priori2[0]),  &(prioro2[0]), &(posti2[0]));
 
 	//interleave soft info 2 --> 1
 	for(int k=0;k<blocklength;k++) {
@@ -0,0 +1,453 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gnuradio/trellis/fsm_engine.h>
+#include <gnuradio/trellis/core_algorithms.h>
+#include <volk/volk.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace gr {
+  namespace trellis {
+
+    static const float INF = 1.0e9;
+    static const short QINF = 32767;
+
+    fsm_engine::fsm_engine(const fsm &FSM)
+      : d_I(FSM.I()), d_S(FSM.S()), d_O(FSM.O()), d_P(1),
+	d_NS(FSM.NS()), d_OS(FSM.OS()),
+	d_scale(0), d_cur(0), d_depth(0), d_pending(0), d_maxstar(false)
+    {
+      const std::vector< std::vector<int> > &PS = FSM.PS();
+      const std::vector< std::vector<int> > &PI = FSM.PI();
+
+      for(int j = 0; j < d_S; j++)
+	d_P = std::max(d_P, (int)PS[j].size());
+      if(d_P > 32768)
+	throw std::invalid_argument("fsm_engine: more than 32768 predecessors per state");
+
+      d_npred.resize(d_S);
+      d_pred_state.resize(d_P*d_S);
+      d_pred_input.resize(d_P*d_S);
+      d_vit_tables.resize(2*d_P*d_S);
+      d_fwd_tables.resize(2*d_P*d_S);
+      for(int j = 0; j < d_S; j++) {
+	int n = PS[j].size();
+	d_npred[j] = n;
+	for(int p = 0; p < d_P; p++) {
+	  int i0 = p*d_S+j;
+	  if(n == 0) {
+	    d_pred_state[i0] = 0;
+	    d_pred_input[i0] = 0;
+	    d_vit_tables[i0] = d_S;
+	    d_vit_tables[d_P*d_S+i0] = 0;
+	    d_fwd_tables[i0] = d_S;
+	    d_fwd_tables[d_P*d_S+i0] = 0;
+	  }
+	  else {
+	    // Pad with the first predecessor, which never wins a tie
+	    int q = p < n ? p : 0;
+	    int ps = PS[j][q], pi = PI[j][q];
+	    d_pred_state[i0] = ps;
+	    d_pred_input[i0] = pi;
+	    d_vit_tables[i0] = ps;
+	    d_vit_tables[d_P*d_S+i0] = d_OS[ps*d_I+pi];
+	    // The forward recursion also folds with min*, which would
+	    // count a repeat twice, so it pads with the infinite metric
+	    d_fwd_tables[i0] = p < n ? ps : d_S;
+	    d_fwd_tables[d_P*d_S+i0] = p < n ? ps*d_I+pi : 0;
+	  }
+	}
+      }
+
+      d_bwd_tables.resize(2*d_I*d_S);
+      for(int j = 0; j < d_S; j++) {
+	for(int i = 0; i < d_I; i++) {
+	  d_bwd_tables[i*d_S+j] = d_NS[j*d_I+i];
+	  d_bwd_tables[(d_I+i)*d_S+j] = j*d_I+i;
+	}
+      }
+
+      d_metrics.resize(2*(d_S+1));
+      d_qmetrics.resize(2*(d_S+1));
+      d_qbranch.resize(d_O);
+      d_gamma.resize(d_S*d_I);
+      d_qgamma.resize(d_S*d_I);
+      d_comb.resize(d_O);
+      d_dec.resize(d_S);
+    }
+
+    void
+    fsm_engine::set_metric_scale(float scale)
+    {
+      if(scale < 0)
+	throw std::invalid_argument("fsm_engine: metric scale must not be negative");
+      d_scale = scale;
+    }
+
+    void
+    fsm_engine::start(int S0)
+    {
+      for(int h = 0; h < 2; h++) {
+	float *m = &d_metrics[h*(d_S+1)];
+	short *q = &d_qmetrics[h*(d_S+1)];
+	for(int i = 0; i <= d_S; i++) {
+	  m[i] = S0 < 0 && i < d_S ? 0 : INF;
+	  q[i] = S0 < 0 && i < d_S ? 0 : QINF;
+	}
+	if(S0 >= 0) {
+	  m[S0] = 0;
+	  q[S0] = 0;
+	}
+      }
+      d_cur = 0;
+    }
+
+    void
+    fsm_engine::quantize(const float *in, int n, short *out) const
+    {
+      float bmin = in[0];
+      for(int o = 1; o < n; o++)
+	bmin = std::min(bmin, in[o]);
+      for(int o = 0; o < n; o++) {
+	float v = (in[o] - bmin) * d_scale;
+	out[o] = v < QINF ? (short)(v + 0.5f) : QINF;
+      }
+    }
+
+    void
+    fsm_engine::acs(const float *in, unsigned short *dec)
+    {
+      int S1 = d_S + 1;
+
+      if(d_scale > 0) {
+	quantize(in, d_O, &d_qbranch[0]);
+	volk_16i_x2_trellis_acs_16i(&d_qmetrics[(1-d_cur)*S1], dec,
+				    &d_qmetrics[d_cur*S1], &d_qbranch[0],
+				    &d_vit_tables[0], d_P, d_S);
+      }
+      else {
+	volk_32f_x2_trellis_acs_32f(&d_metrics[(1-d_cur)*S1], dec,
+				    &d_metrics[d_cur*S1], in,
+				    &d_vit_tables[0], d_P, d_S);
+      }
+      d_cur = 1 - d_cur;
+    }
+
+    int
+    fsm_engine::best_state() const
+    {
+      int st = 0;
+      if(d_scale > 0) {
+	const short *q = &d_qmetrics[d_cur*(d_S+1)];
+	for(int i = 1; i < d_S; i++)
+	  if(q[i] < q[st]) st = i;
+      }
+      else {
+	const float *m = &d_metrics[d_cur*(d_S+1)];
+	for(int i = 1; i < d_S; i++)
+	  if(m[i] < m[st]) st = i;
+      }
+      return st;
+    }
+
+    template <class T> void
+    fsm_engine::traceback(int st, int nsteps, int nout, T *out) const
+    {
+      for(int k = nsteps-1; k >= 0; k--) {
+	int i0 = d_dec[k*d_S+st]*d_S + st;
+	if(k < nout)
+	  out[k] = (T)d_pred_input[i0];
+	st = d_pred_state[i0];
+      }
+    }
+
+    template <class T> void
+    fsm_engine::viterbi(int K, int S0, int SK, const float *in, T *out)
+    {
+      if(d_dec.size() < (size_t)K*d_S)
+	d_dec.resize(K*d_S);
+      d_pending = 0;
+
+      start(S0);
+      for(int k = 0; k < K; k++)
+	acs(&in[k*d_O], &d_dec[k*d_S]);
+
+      traceback(SK < 0 ? best_state() : SK, K, K, out);
+    }
+
+    void
+    fsm_engine::stream_start(int S0, int depth)
+    {
+      if(depth < 0)
+	throw std::invalid_argument("fsm_engine: traceback depth must not be negative");
+      d_depth = depth;
+      d_pending = 0;
+      start(S0);
+    }
+
+    template <class T> int
+    fsm_engine::stream_decode(const float *in, int nsteps, T *out)
+    {
+      if(d_dec.size() < (size_t)(d_pending+nsteps)*d_S)
+	d_dec.resize((d_pending+nsteps)*d_S);
+
+      for(int k = 0; k < nsteps; k++)
+	acs(&in[k*d_O], &d_dec[(d_pending+k)*d_S]);
+      d_pending += nsteps;
+
+      int nout = d_pending - d_depth;
+      if(nout <= 0)
+	return 0;
+
+      // Trace the whole window back and emit its oldest steps
+      traceback(best_state(), d_pending, nout, out);
+      std::copy(d_dec.begin() + nout*d_S, d_dec.begin() + d_pending*d_S,
+		d_dec.begin());
+      d_pending = d_depth;
+      return nout;
+    }
+
+    template <class T> int
+    fsm_engine::stream_flush(int SK, T *out)
+    {
+      int nout = d_pending;
+      traceback(SK < 0 ? best_state() : SK, nout, nout, out);
+      d_pending = 0;
+      return nout;
+    }
+
+    void
+    fsm_engine::siso_branch(int k, const float *priori, const float *prioro)
+    {
+      for(int j = 0; j < d_S; j++)
+	for(int i = 0; i < d_I; i++)
+	  d_gamma[j*d_I+i] = priori[k*d_I+i] + prioro[k*d_O+d_OS[j*d_I+i]];
+    }
+
+    void
+    fsm_engine::quantize_correction()
+    {
+      // The slope becomes a right shift, the table values metric units
+      int shift = 0;
+      while(shift < 15 && d_corr[1] > 0 && d_corr[1]*(1 << shift) < 0.75f)
+	shift++;
+      d_qcorr[0] = (short)std::min(d_corr[0]*d_scale + 0.5f, (float)QINF);
+      d_qcorr[1] = d_corr[1] > 0 ? shift : 15;
+      // Rounds the partial sums of the table, so that the rounding
+      // errors do not add up
+      float sum = 0;
+      int prev = 0;
+      for(int k = 7; k >= 0; k--) {
+	sum += d_corr[10+k];
+	int v = (int)std::min(sum*d_scale + 0.5f, (float)QINF);
+	d_qcorr[2+k] = (short)std::min(d_corr[2+k]*d_scale + 0.5f, (float)QINF);
+	d_qcorr[10+k] = v - prev;
+	prev = v;
+      }
+    }
+
+    void
+    fsm_engine::siso_step(int k, const float *priori, const float *prioro,
+			  const int *tables, int npred,
+			  const float *m0, float *m1,
+			  const short *q0, short *q1)
+    {
+      siso_branch(k, priori, prioro);
+      if(d_scale > 0) {
+	quantize(&d_gamma[0], d_S*d_I, &d_qgamma[0]);
+	if(d_maxstar)
+	  volk_16i_x2_trellis_maxstar_16i(q1, q0, &d_qgamma[0], tables,
+					  &d_qcorr[0], npred, d_S);
+	else
+	  volk_16i_x2_trellis_acs_16i(q1, &d_dec[0], q0, &d_qgamma[0],
+				      tables, npred, d_S);
+	for(int j = 0; j < d_S; j++)
+	  m1[j] = q1[j] < QINF ? q1[j] / d_scale : INF;
+      }
+      else if(d_maxstar)
+	volk_32f_x2_trellis_maxstar_32f(m1, m0, &d_gamma[0], tables,
+					&d_corr[0], npred, d_S);
+      else
+	volk_32f_x2_trellis_acs_32f(m1, &d_dec[0], m0, &d_gamma[0],
+				    tables, npred, d_S);
+    }
+
+    void
+    fsm_engine::siso(int K, int S0, int SK,
+		     bool POSTI, bool POSTO,
+		     float (*p2mymin)(float,float),
+		     const float *priori, const float *prioro, float *post)
+    {
+      if(!POSTI && !POSTO)
+	throw std::runtime_error("Not both POSTI and POSTO can be false.");
+
+      const int S1 = d_S + 1;
+      d_maxstar = min_star_table(p2mymin, &d_corr[0]);
+      const bool vec = d_maxstar || (p2mymin == &min);
+      float norm, mm, minm;
+
+      d_alpha.resize(S1*(K+1));
+      d_beta.resize(S1*(K+1));
+      d_pending = 0;
+      if(vec && d_scale > 0) {
+	d_qalpha.resize(2*S1);
+	d_qbeta.resize(2*S1);
+	if(d_maxstar)
+	  quantize_correction();
+      }
+
+      float *alpha = &d_alpha[0];
+      float *beta = &d_beta[0];
+      short *qalpha = d_qalpha.empty() ? NULL : &d_qalpha[0];
+      short *qbeta = d_qbeta.empty() ? NULL : &d_qbeta[0];
+
+      for(int i = 0; i < d_S; i++)
+	alpha[i] = S0 < 0 ? 0 : INF;
+      if(S0 >= 0)
+	alpha[S0] = 0.0;
+      alpha[d_S] = INF;
+      if(vec && d_scale > 0) {
+	for(int i = 0; i <= d_S; i++)
+	  qalpha[i] = qalpha[S1+i] = alpha[i] < INF ? 0 : QINF;
+      }
+
+      for(int k = 0; k < K; k++) { // forward recursion
+	float *a0 = &alpha[k*S1];
+	float *a1 = &alpha[(k+1)*S1];
+	if(vec) {
+	  // The 16-bit metrics only keep the last two steps
+	  siso_step(k, priori, prioro, &d_fwd_tables[0], d_P, a0, a1,
+		    qalpha ? &qalpha[(k&1)*S1] : NULL,
+		    qalpha ? &qalpha[(1-(k&1))*S1] : NULL);
+	}
+	else {
+	  norm = INF;
+	  for(int j = 0; j < d_S; j++) {
+	    minm = INF;
+	    for(int p = 0; p < d_npred[j]; p++) {
+	      int s = d_pred_state[p*d_S+j], i = d_pred_input[p*d_S+j];
+	      mm = a0[s] + priori[k*d_I+i] + prioro[k*d_O+d_OS[s*d_I+i]];
+	      minm = (*p2mymin)(minm, mm);
+	    }
+	    a1[j] = minm;
+	    if(minm < norm) norm = minm;
+	  }
+	  for(int j = 0; j < d_S; j++)
+	    a1[j] -= norm; // normalize total metrics so they do not explode
+	}
+	a1[d_S] = INF;
+      }
+
+      for(int i = 0; i < d_S; i++)
+	beta[K*S1+i] = SK < 0 ? 0 : INF;
+      if(SK >= 0)
+	beta[K*S1+SK] = 0.0;
+      if(vec && d_scale > 0) {
+	for(int i = 0; i < d_S; i++)
+	  qbeta[(K&1)*S1+i] = beta[K*S1+i] < INF ? 0 : QINF;
+      }
+
+      for(int k = K-1; k >= 0; k--) { // backward recursion
+	float *b0 = &beta[k*S1];
+	float *b1 = &beta[(k+1)*S1];
+	if(vec) {
+	  siso_step(k, priori, prioro, &d_bwd_tables[0], d_I, b1, b0,
+		    qbeta ? &qbeta[((k+1)&1)*S1] : NULL,
+		    qbeta ? &qbeta[(k&1)*S1] : NULL);
+	}
+	else {
+	  norm = INF;
+	  for(int j = 0; j < d_S; j++) {
+	    minm = INF;
+	    for(int i = 0; i < d_I; i++) {
+	      int i0 = j*d_I+i;
+	      mm = b1[d_NS[i0]] + priori[k*d_I+i] + prioro[k*d_O+d_OS[i0]];
+	      minm = (*p2mymin)(minm, mm);
+	    }
+	    b0[j] = minm;
+	    if(minm < norm) norm = minm;
+	  }
+	  for(int j = 0; j < d_S; j++)
+	    b0[j] -= norm; // normalize total metrics so they do not explode
+	}
+      }
+
+      const int stride = (POSTI ? d_I : 0) + (POSTO ? d_O : 0);
+      for(int k = 0; k < K; k++) {
+	const float *a0 = &alpha[k*S1];
+	const float *b1 = &beta[(k+1)*S1];
+	float *p = &post[k*stride];
+
+	if(POSTI) { // input combining
+	  norm = INF;
+	  for(int i = 0; i < d_I; i++) {
+	    minm = INF;
+	    for(int j = 0; j < d_S; j++) {
+	      mm = a0[j] + prioro[k*d_O+d_OS[j*d_I+i]] + b1[d_NS[j*d_I+i]];
+	      minm = (*p2mymin)(minm, mm);
+	    }
+	    p[i] = minm;
+	    if(minm < norm) norm = minm;
+	  }
+	  for(int i = 0; i < d_I; i++)
+	    p[i] -= norm; // normalize metrics
+	  p += d_I;
+	}
+
+	if(POSTO) { // output combining, one pass over the transitions
+	  for(int n = 0; n < d_O; n++)
+	    d_comb[n] = INF;
+	  for(int j = 0; j < d_S; j++) {
+	    for(int i = 0; i < d_I; i++) {
+	      int i0 = j*d_I+i;
+	      mm = a0[j] + priori[k*d_I+i] + b1[d_NS[i0]];
+	      d_comb[d_OS[i0]] = (*p2mymin)(d_comb[d_OS[i0]], mm);
+	    }
+	  }
+	  norm = INF;
+	  for(int n = 0; n < d_O; n++)
+	    if(d_comb[n] < norm) norm = d_comb[n];
+	  for(int n = 0; n < d_O; n++)
+	    p[n] = d_comb[n] - norm; // normalize metrics
+	}
+      }
+    }
+
+    template void fsm_engine::viterbi<unsigned char>(int K, int S0, int SK, const float *in, unsigned char *out);
+    template void fsm_engine::viterbi<short>(int K, int S0, int SK, const float *in, short *out);
+    template void fsm_engine::viterbi<int>(int K, int S0, int SK, const float *in, int *out);
+
+    template int fsm_engine::stream_decode<unsigned char>(const float *in, int nsteps, unsigned char *out);
+    template int fsm_engine::stream_decode<short>(const float *in, int nsteps, short *out);
+    template int fsm_engine::stream_decode<int>(const float *in, int nsteps, int *out);
+
+    template int fsm_engine::stream_flush<unsigned char>(int SK, unsigned char *out);
+    template int fsm_engine::stream_flush<short>(int SK, short *out);
+    template int fsm_engine::stream_flush<int>(int SK, int *out);
+
+  } /* namespace trellis */
+} /* namespace gr */
@@ -115,6 +115,10 @@ namespace gr {
 	p2min = &min;
       else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT)
 	p2min = &min_star;
+      else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT_LINEAR)
+	p2min = &min_star_linear;
+      else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT_LUT)
+	p2min = &min_star_lut;
 
       const @I_TYPE@ *in = (const @I_TYPE@*)input_items[0];
       @O_TYPE@ *out = (@O_TYPE@*)output_items[0];
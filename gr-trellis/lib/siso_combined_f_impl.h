@@ -23,6 +23,7 @@
 #ifndef INCLUDED_TRELLIS_SISO_COMBINED_F_IMPL_H
 #define INCLUDED_TRELLIS_SISO_COMBINED_F_IMPL_H
 
+#include <gnuradio/trellis/fsm_engine.h>
 #include <gnuradio/trellis/siso_combined_f.h>
 
 namespace gr {
@@ -41,6 +42,8 @@ namespace gr {
       int d_D;
       std::vector<float> d_TABLE;
       digital::trellis_metric_type_t d_TYPE;
+      fsm_engine d_engine;
+      std::vector<float> d_prioro;	// branch metrics of one block
       //std::vector<float> d_alpha;
       //std::vector<float> d_beta;
 
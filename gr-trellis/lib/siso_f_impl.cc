@@ -55,9 +55,8 @@ namespace gr {
 	d_FSM(FSM), d_K(K),
 	d_S0(S0),d_SK(SK),
 	d_POSTI(POSTI), d_POSTO(POSTO),
-	d_SISO_TYPE(SISO_TYPE)//,
-	//d_alpha(FSM.S()*(K+1)),
-	//d_beta(FSM.S()*(K+1))
+	d_SISO_TYPE(SISO_TYPE),
+	d_engine(FSM)
     {
       int multiple;
       if(d_POSTI && d_POSTO)
@@ -141,21 +140,21 @@ namespace gr {
 	p2min = &min;
       else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT)
 	p2min = &min_star;
+      else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT_LINEAR)
+	p2min = &min_star_linear;
+      else if(d_SISO_TYPE == TRELLIS_SUM_PRODUCT_LUT)
+	p2min = &min_star_lut;
 
       for(int m = 0; m < nstreams; m++) {
 	const float *in1 = (const float*)input_items[2*m];
 	const float *in2 = (const float*)input_items[2*m+1];
 	float *out = (float*)output_items[m];
 	for(int n = 0;n < nblocks; n++) {
-	  siso_algorithm(d_FSM.I(),d_FSM.S(),d_FSM.O(),
-			 d_FSM.NS(),d_FSM.OS(),d_FSM.PS(),d_FSM.PI(),
-			 d_K,d_S0,d_SK,
-			 d_POSTI,d_POSTO,
-			 p2min,
-			 &(in1[n*d_K*d_FSM.I()]),&(in2[n*d_K*d_FSM.O()]),
-			 &(out[n*d_K*multiple])//,
-			 //d_alpha,d_beta
-			 );
+	  d_engine.siso(d_K,d_S0,d_SK,
+			d_POSTI,d_POSTO,
+			p2min,
+			&(in1[n*d_K*d_FSM.I()]),&(in2[n*d_K*d_FSM.O()]),
+			&(out[n*d_K*multiple]));
 	}
       }
 
@@ -27,6 +27,7 @@
 #include <gnuradio/trellis/fsm.h>
 #include <gnuradio/trellis/siso_type.h>
 #include <gnuradio/trellis/core_algorithms.h>
+#include <gnuradio/trellis/fsm_engine.h>
 #include <gnuradio/trellis/siso_f.h>
 
 namespace gr {
@@ -42,8 +43,7 @@ namespace gr {
       bool d_POSTI;
       bool d_POSTO;
       siso_type_t d_SISO_TYPE;
-      //std::vector<float> d_alpha;
-      //std::vector<float> d_beta;
+      fsm_engine d_engine;
 
     public:
       siso_f_impl(const fsm &FSM, int K,
@@ -48,8 +48,8 @@ namespace gr {
     : block("@BASE_NAME@",
 	       io_signature::make(1, -1, sizeof(float)),
 	       io_signature::make(1, -1, sizeof(@TYPE@))),
-      d_FSM(FSM), d_K(K), d_S0(S0), d_SK(SK)//,
-      //d_trace(FSM.S()*K)
+      d_FSM(FSM), d_K(K), d_S0(S0), d_SK(SK),
+      d_engine(FSM)
     {
       set_relative_rate(1.0 / ((double)d_FSM.O()));
       set_output_multiple(d_K);
@@ -84,10 +84,8 @@ namespace gr {
 	@TYPE@ *out = (@TYPE@*)output_items[m];
 
 	for(int n = 0; n < nblocks; n++) {
-	  viterbi_algorithm(d_FSM.I(), d_FSM.S(), d_FSM.O(),
-			    d_FSM.NS(), d_FSM.OS(), d_FSM.PS(),
-			    d_FSM.PI(), d_K,d_S0, d_SK,
-			    &(in[n*d_K*d_FSM.O()]), &(out[n*d_K]));
+	  d_engine.viterbi(d_K, d_S0, d_SK,
+			   &(in[n*d_K*d_FSM.O()]), &(out[n*d_K]));
 	}
       }
 
@@ -26,6 +26,7 @@
 #define @GUARD_NAME@
 
 #include <gnuradio/trellis/@BASE_NAME@.h>
+#include <gnuradio/trellis/fsm_engine.h>
 
 namespace gr {
   namespace trellis {
@@ -37,7 +38,7 @@ namespace gr {
       int d_K;
       int d_S0;
       int d_SK;
-      //std::vector<int> d_trace;
+      fsm_engine d_engine;
 
     public:
       @IMPL_NAME@(const fsm &FSM, int K,
@@ -28,6 +28,7 @@
 
 #include "@NAME@.h"
 #include <gnuradio/io_signature.h>
+#include <gnuradio/trellis/calc_metric.h>
 #include <iostream>
 
 namespace gr {
@@ -53,8 +54,8 @@ namespace gr {
 	       io_signature::make(1, -1, sizeof(@I_TYPE@)),
 	       io_signature::make(1, -1, sizeof(@O_TYPE@))),
       d_FSM(FSM), d_K(K), d_S0(S0), d_SK(SK), d_D(D),
-      d_TABLE(TABLE), d_TYPE(TYPE)//,
-      //d_trace(FSM.S()*K)
+      d_TABLE(TABLE), d_TYPE(TYPE),
+      d_engine(FSM), d_metrics(FSM.O()*K)
     {
       set_relative_rate(1.0 / ((double)d_D));
       set_output_multiple(d_K);
@@ -95,11 +96,10 @@ namespace gr {
 	@O_TYPE@ *out = (@O_TYPE@*)output_items[m];
 
 	for(int n=0;n<nblocks;n++) {
-	  viterbi_algorithm_combined(d_FSM.I(), d_FSM.S(), d_FSM.O(),
-				     d_FSM.NS(), d_FSM.OS(), d_FSM.PS(),
-				     d_FSM.PI(), d_K,d_S0, d_SK, d_D,
-				     d_TABLE, d_TYPE,
-				     &(in[n*d_K*d_D]), &(out[n*d_K]));
+	  for(int k=0;k<d_K;k++)
+	    calc_metric(d_FSM.O(), d_D, d_TABLE, &(in[(n*d_K+k)*d_D]),
+			&(d_metrics[k*d_FSM.O()]), d_TYPE);
+	  d_engine.viterbi(d_K, d_S0, d_SK, &(d_metrics[0]), &(out[n*d_K]));
 	}
       }
 
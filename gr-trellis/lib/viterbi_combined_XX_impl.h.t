@@ -26,6 +26,7 @@
 #define @GUARD_NAME@
 
 #include <gnuradio/trellis/@BASE_NAME@.h>
+#include <gnuradio/trellis/fsm_engine.h>
 
 namespace gr {
   namespace trellis {
@@ -40,7 +41,8 @@ namespace gr {
       int d_D;
       std::vector<@I_TYPE@> d_TABLE;
       digital::trellis_metric_type_t d_TYPE;
-      //std::vector<int> d_trace;
+      fsm_engine d_engine;
+      std::vector<float> d_metrics;
 
     public:
       @IMPL_NAME@(const fsm &FSM, int K,
@@ -0,0 +1,296 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Compares viterbi_algorithm() and siso_algorithm() with fsm_engine on
+ * the 64 state (171,133) and 256 state (561,753) rate 1/2 codes over
+ * BPSK in AWGN.  The float Viterbi decoder must reproduce the legacy
+ * output exactly, as must the min* SISO; the fixed point, streaming and
+ * vectorized min-sum variants are reported for comparison.  Every VOLK
+ * implementation of the ACS kernel must make the same decisions as the
+ * generic one.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+#include <volk/volk.h>
+#include <gnuradio/trellis/fsm.h>
+#include <gnuradio/trellis/fsm_engine.h>
+#include <gnuradio/trellis/core_algorithms.h>
+#include <gnuradio/trellis/siso_type.h>
+
+using namespace gr::trellis;
+
+#define K 1000
+#define NBLOCKS 100
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static double
+gaussian()
+{
+  double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double u2 = rand() / (RAND_MAX + 1.0);
+  return sqrt(-2.0*log(u1)) * cos(2.0*M_PI*u2);
+}
+
+// Encode one continuous stream of random bits and compute the
+// Euclidean branch metrics of the received BPSK symbols.  S0[b] is the
+// encoder state at the start of block b.
+static void
+make_metrics(const fsm &f, double sigma, std::vector<int> &data,
+             std::vector<int> &S0, std::vector<float> &metrics)
+{
+  int st = 0;
+
+  data.resize(NBLOCKS*K);
+  S0.resize(NBLOCKS);
+  metrics.resize(NBLOCKS*K*f.O());
+  for(int k = 0; k < NBLOCKS*K; k++) {
+    if(k % K == 0)
+      S0[k/K] = st;
+    data[k] = rand() % f.I();
+    int os = f.OS()[st*f.I()+data[k]];
+    st = f.NS()[st*f.I()+data[k]];
+
+    double r0 = ((os >> 1) ? 1.0 : -1.0) + sigma*gaussian();
+    double r1 = ((os & 1) ? 1.0 : -1.0) + sigma*gaussian();
+    for(int o = 0; o < f.O(); o++) {
+      double d0 = r0 - ((o >> 1) ? 1.0 : -1.0);
+      double d1 = r1 - ((o & 1) ? 1.0 : -1.0);
+      metrics[k*f.O()+o] = d0*d0 + d1*d1;
+    }
+  }
+}
+
+static int
+errors(const std::vector<int> &data, const std::vector<int> &out)
+{
+  int n = 0;
+  for(size_t i = 0; i < data.size(); i++)
+    n += data[i] != out[i];
+  return n;
+}
+
+static bool
+bench_viterbi(const fsm &f, double sigma, int depth)
+{
+  std::vector<int> data, S0, out_legacy(NBLOCKS*K), out_engine(NBLOCKS*K);
+  std::vector<int> out_fixed(NBLOCKS*K), out_stream(NBLOCKS*K);
+  std::vector<float> metrics;
+  fsm_engine engine(f);
+  int O = f.O();
+
+  make_metrics(f, sigma, data, S0, metrics);
+
+  double start = cpu_time();
+  for(int b = 0; b < NBLOCKS; b++)
+    viterbi_algorithm(f.I(), f.S(), O, f.NS(), f.OS(), f.PS(), f.PI(),
+                      K, S0[b], -1, &metrics[b*K*O], &out_legacy[b*K]);
+  double t_legacy = cpu_time() - start;
+
+  start = cpu_time();
+  for(int b = 0; b < NBLOCKS; b++)
+    engine.viterbi(K, S0[b], -1, &metrics[b*K*O], &out_engine[b*K]);
+  double t_engine = cpu_time() - start;
+
+  engine.set_metric_scale(32.0);
+  start = cpu_time();
+  for(int b = 0; b < NBLOCKS; b++)
+    engine.viterbi(K, S0[b], -1, &metrics[b*K*O], &out_fixed[b*K]);
+  double t_fixed = cpu_time() - start;
+  engine.set_metric_scale(0);
+
+  // The stream is fed in pieces that do not line up with the blocks
+  start = cpu_time();
+  int nout = 0;
+  engine.stream_start(0, depth);
+  for(int k = 0; k < NBLOCKS*K; k += 777) {
+    int n = std::min(777, NBLOCKS*K - k);
+    nout += engine.stream_decode(&metrics[k*O], n, &out_stream[nout]);
+  }
+  nout += engine.stream_flush(-1, &out_stream[nout]);
+  double t_stream = cpu_time() - start;
+
+  int differ = 0;
+  for(int i = 0; i < NBLOCKS*K; i++)
+    differ += out_legacy[i] != out_engine[i];
+
+  double mbits = 1e-6*NBLOCKS*K;
+  printf("  sigma %4.2f  legacy %7.3f Mb/s %5d errs  float %7.3f Mb/s %5d errs  "
+         "int16 %7.3f Mb/s %5d errs  stream %7.3f Mb/s %5d errs\n",
+         sigma, mbits/t_legacy, errors(data, out_legacy),
+         mbits/t_engine, errors(data, out_engine),
+         mbits/t_fixed, errors(data, out_fixed),
+         mbits/t_stream, errors(data, out_stream));
+
+  bool ok = true;
+  if(differ != 0) {
+    printf("    FAIL: float engine differs from viterbi_algorithm in %d symbols\n", differ);
+    ok = false;
+  }
+  if(nout != NBLOCKS*K) {
+    printf("    FAIL: stream decoded %d of %d symbols\n", nout, NBLOCKS*K);
+    ok = false;
+  }
+  return ok;
+}
+
+static bool
+bench_siso(const fsm &f, double sigma, siso_type_t type)
+{
+  std::vector<int> data, S0;
+  std::vector<float> metrics, priori(K*f.I(), 0.0);
+  std::vector<float> post_legacy(NBLOCKS*K*(f.I()+f.O()));
+  std::vector<float> post_engine(NBLOCKS*K*(f.I()+f.O()));
+  float (*p2mymin)(float,float) = type == TRELLIS_MIN_SUM ? &min : &min_star;
+  fsm_engine engine(f);
+  int IO = f.I()+f.O();
+  int nblocks = NBLOCKS/10;
+
+  make_metrics(f, sigma, data, S0, metrics);
+
+  double start = cpu_time();
+  for(int b = 0; b < nblocks; b++)
+    siso_algorithm(f.I(), f.S(), f.O(), f.NS(), f.OS(), f.PS(), f.PI(),
+                   K, S0[b], -1, true, true, p2mymin,
+                   &priori[0], &metrics[b*K*f.O()], &post_legacy[b*K*IO]);
+  double t_legacy = cpu_time() - start;
+
+  start = cpu_time();
+  for(int b = 0; b < nblocks; b++)
+    engine.siso(K, S0[b], -1, true, true, p2mymin,
+                &priori[0], &metrics[b*K*f.O()], &post_engine[b*K*IO]);
+  double t_engine = cpu_time() - start;
+
+  double maxdiff = 0;
+  for(int i = 0; i < nblocks*K*IO; i++)
+    maxdiff = std::max(maxdiff, (double)fabs(post_legacy[i] - post_engine[i]));
+
+  double msteps = 1e-6*nblocks*K;
+  printf("  %s  legacy %7.3f Msteps/s  engine %7.3f Msteps/s  max difference %g\n",
+         type == TRELLIS_MIN_SUM ? "min-sum" : "min*   ",
+         msteps/t_legacy, msteps/t_engine, maxdiff);
+
+  // min* runs in the legacy order; min-sum adds the a priori terms first
+  if(type == TRELLIS_SUM_PRODUCT ? maxdiff != 0 : maxdiff > 1e-3) {
+    printf("    FAIL: engine differs from siso_algorithm\n");
+    return false;
+  }
+  return true;
+}
+
+// Run the float ACS kernel with one implementation and return its
+// decisions over the first block.
+static double
+acs_impl(const fsm &f, const std::vector<float> &metrics, const char *impl,
+         std::vector<unsigned short> &decisions)
+{
+  std::vector<int> tables(4*f.S());
+  std::vector<float> m0(f.S(), 0.0), m1(f.S());
+  int S = f.S();
+
+  for(int j = 0; j < S; j++) {
+    for(int p = 0; p < 2; p++) {
+      int ps = f.PS()[j][p], pi = f.PI()[j][p];
+      tables[p*S+j] = ps;
+      tables[(2+p)*S+j] = f.OS()[ps*f.I()+pi];
+    }
+  }
+  decisions.resize(K*S);
+
+  double start = cpu_time();
+  for(int k = 0; k < K; k++) {
+    volk_32f_x2_trellis_acs_32f_manual(&m1[0], &decisions[k*S], &m0[0],
+                                       &metrics[k*f.O()], &tables[0], 2, S,
+                                       impl);
+    m0.swap(m1);
+  }
+  return cpu_time() - start;
+}
+
+int
+main(int argc, char **argv)
+{
+  const double sigmas[] = {0.0, 0.7, 0.9};
+  int G64[] = {0171, 0133};
+  int G256[] = {0561, 0753};
+  bool ok = true;
+
+  srand(1);
+
+  for(int c = 0; c < 2; c++) {
+    std::vector<int> G(c == 0 ? G64 : G256, (c == 0 ? G64 : G256) + 2);
+    fsm f(1, 2, G);
+    int memory = c == 0 ? 6 : 8;
+
+    printf("%d states, rate 1/2\n", f.S());
+    for(size_t s = 0; s < sizeof(sigmas)/sizeof(sigmas[0]); s++)
+      ok = bench_viterbi(f, sigmas[s], 5*memory) && ok;
+    ok = bench_siso(f, 0.7, TRELLIS_MIN_SUM) && ok;
+    ok = bench_siso(f, 0.7, TRELLIS_SUM_PRODUCT) && ok;
+
+    // Bit-exact check of every kernel implementation against generic
+    std::vector<int> data, S0;
+    std::vector<float> metrics;
+    std::vector<unsigned short> ref, dec;
+    make_metrics(f, 0.7, data, S0, metrics);
+    volk_func_desc_t desc = volk_32f_x2_trellis_acs_32f_get_func_desc();
+    acs_impl(f, metrics, "generic", ref);
+    for(size_t i = 0; i < desc.n_impls; i++) {
+      double t = acs_impl(f, metrics, desc.impl_names[i], dec);
+      bool same = (ref == dec);
+      printf("%18s:  acs: %8.3f Msteps/s  %s\n", desc.impl_names[i],
+             1e-6*K/t, same ? "bit-exact" : "MISMATCH");
+      ok = ok && same;
+    }
+  }
+
+  return ok ? 0 : 1;
+}
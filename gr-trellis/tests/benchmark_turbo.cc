@@ -0,0 +1,294 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2014 Free Software Foundation, Inc.
+ *
+ * This file is part of GNU Radio
+ *
+ * GNU Radio is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * GNU Radio is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GNU Radio; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Turbo decodes a rate 1/3 parallel concatenation of two 8 state
+ * recursive systematic codes (1, 15/13) over BPSK in AWGN with
+ * siso_algorithm() and with fsm_engine, for min-sum, exact min* and
+ * the piecewise linear and table min* approximations, with float and
+ * 16-bit recursions.  The bit error rate after a number of iterations
+ * and the decoding speed are reported.  Every VOLK implementation of
+ * the max* kernels must give the same metrics as the generic one.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+#include <volk/volk.h>
+#include <gnuradio/trellis/fsm.h>
+#include <gnuradio/trellis/fsm_engine.h>
+#include <gnuradio/trellis/interleaver.h>
+#include <gnuradio/trellis/core_algorithms.h>
+
+using namespace gr::trellis;
+
+#define K 1024
+#define NBLOCKS 40
+#define ITERATIONS 8
+
+static double
+cpu_time()
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage	rusage;
+  if(getrusage(RUSAGE_SELF, &rusage) < 0) {
+    perror("getrusage");
+    exit(1);
+  }
+  return (double)rusage.ru_utime.tv_sec + (double)rusage.ru_utime.tv_usec * 1e-6
+    + (double)rusage.ru_stime.tv_sec + (double)rusage.ru_stime.tv_usec * 1e-6;
+#else
+  return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static double
+gaussian()
+{
+  double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+  double u2 = rand() / (RAND_MAX + 1.0);
+  return sqrt(-2.0*log(u1)) * cos(2.0*M_PI*u2);
+}
+
+// The constituent code: feedback 1+D^2+D^3, parity 1+D+D^3.  The
+// state holds the last three feedback bits, newest first, and the
+// output is the systematic bit followed by the parity bit.
+static fsm
+rsc_fsm()
+{
+  std::vector<int> NS(16), OS(16);
+
+  for(int s = 0; s < 8; s++) {
+    int a1 = (s >> 2) & 1, a2 = (s >> 1) & 1, a3 = s & 1;
+    for(int u = 0; u < 2; u++) {
+      int w = u ^ a2 ^ a3;
+      NS[s*2+u] = (w << 2) | (a1 << 1) | a2;
+      OS[s*2+u] = (u << 1) | (w ^ a1 ^ a3);
+    }
+  }
+  return fsm(2, 8, 4, NS, OS);
+}
+
+// Encode NBLOCKS blocks of random bits and compute the metrics of the
+// two constituent decoders.  The second one only sees its parity bit.
+static void
+make_metrics(const fsm &f, const interleaver &inter, double sigma,
+             std::vector<int> &data, std::vector<float> &metrics1,
+             std::vector<float> &metrics2)
+{
+  double scale = 1.0/(2.0*sigma*sigma);
+
+  data.resize(NBLOCKS*K);
+  metrics1.resize(NBLOCKS*K*4);
+  metrics2.resize(NBLOCKS*K*4);
+  for(int b = 0; b < NBLOCKS; b++) {
+    int *u = &data[b*K];
+    int st1 = 0, st2 = 0;
+
+    for(int k = 0; k < K; k++)
+      u[k] = rand() & 1;
+    for(int k = 0; k < K; k++) {
+      int o1 = f.OS()[st1*2+u[k]];
+      int o2 = f.OS()[st2*2+u[inter.INTER()[k]]];
+      st1 = f.NS()[st1*2+u[k]];
+      st2 = f.NS()[st2*2+u[inter.INTER()[k]]];
+
+      double rs = ((o1 >> 1) ? 1.0 : -1.0) + sigma*gaussian();
+      double r1 = ((o1 & 1) ? 1.0 : -1.0) + sigma*gaussian();
+      double r2 = ((o2 & 1) ? 1.0 : -1.0) + sigma*gaussian();
+      for(int o = 0; o < 4; o++) {
+        double ds = rs - ((o >> 1) ? 1.0 : -1.0);
+        double d1 = r1 - ((o & 1) ? 1.0 : -1.0);
+        double d2 = r2 - ((o & 1) ? 1.0 : -1.0);
+        metrics1[(b*K+k)*4+o] = scale*(ds*ds + d1*d1);
+        metrics2[(b*K+k)*4+o] = scale*d2*d2;
+      }
+    }
+  }
+}
+
+struct decoder_t {
+  const char *name;
+  bool engine;
+  float scale;
+  float (*p2mymin)(float,float);
+};
+
+static void
+siso(const fsm &f, fsm_engine &engine, const decoder_t &dec,
+     const float *priori, const float *prioro, float *post)
+{
+  if(dec.engine)
+    engine.siso(K, 0, -1, true, false, dec.p2mymin, priori, prioro, post);
+  else
+    siso_algorithm(f.I(), f.S(), f.O(), f.NS(), f.OS(), f.PS(), f.PI(),
+                   K, 0, -1, true, false, dec.p2mymin, priori, prioro, post);
+}
+
+// Decode all blocks and return the number of bit errors.  The output
+// metrics of each SISO exclude the a priori metrics of its input, so
+// they go to the other decoder as they are.
+static int
+turbo_decode(const fsm &f, const interleaver &inter, const decoder_t &dec,
+             const std::vector<int> &data, const std::vector<float> &metrics1,
+             const std::vector<float> &metrics2, double &t)
+{
+  fsm_engine engine(f);
+  std::vector<float> priori1(2*K), priori2(2*K), post1(2*K), post2(2*K);
+  const std::vector<int> &INTER = inter.INTER();
+  int nerrors = 0;
+
+  engine.set_metric_scale(dec.scale);
+
+  double start = cpu_time();
+  for(int b = 0; b < NBLOCKS; b++) {
+    std::fill(priori1.begin(), priori1.end(), 0.0f);
+    for(int it = 0; it < ITERATIONS; it++) {
+      siso(f, engine, dec, &priori1[0], &metrics1[b*K*4], &post1[0]);
+      for(int k = 0; k < K; k++) {
+        priori2[2*k] = post1[2*INTER[k]];
+        priori2[2*k+1] = post1[2*INTER[k]+1];
+      }
+      siso(f, engine, dec, &priori2[0], &metrics2[b*K*4], &post2[0]);
+      for(int k = 0; k < K; k++) {
+        priori1[2*INTER[k]] = post2[2*k];
+        priori1[2*INTER[k]+1] = post2[2*k+1];
+      }
+    }
+    for(int k = 0; k < K; k++) {
+      int u = post1[2*k+1] + priori1[2*k+1] < post1[2*k] + priori1[2*k];
+      nerrors += u != data[b*K+k];
+    }
+  }
+  t = cpu_time() - start;
+  return nerrors;
+}
+
+// Run a max* kernel with one implementation over the forward recursion
+// of the constituent code and return the final metrics.
+static std::vector<float>
+maxstar_impl(const fsm &f, const std::vector<float> &metrics, const char *impl)
+{
+  std::vector<int> tables(4*f.S());
+  std::vector<float> m0(f.S(), 0.0), m1(f.S()), gamma(2*f.S());
+  std::vector<short> q0(f.S(), 0), q1(f.S()), qgamma(2*f.S());
+  float correction[18];
+  short qcorrection[18] = {0, 15};
+  int S = f.S();
+
+  min_star_table(&min_star_lut, correction);
+  for(int k = 0; k < 8; k++) {
+    qcorrection[2+k] = (short)(correction[2+k]*32 + 0.5f);
+    qcorrection[10+k] = (short)std::max(correction[10+k]*32 + 0.5f, 1.0f);
+  }
+  for(int j = 0; j < S; j++) {
+    for(int p = 0; p < 2; p++) {
+      int ps = f.PS()[j][p], pi = f.PI()[j][p];
+      tables[p*S+j] = ps;
+      tables[(2+p)*S+j] = ps*2+pi;
+    }
+  }
+
+  for(int k = 0; k < K; k++) {
+    for(int i = 0; i < 2*S; i++) {
+      gamma[i] = metrics[k*4+f.OS()[i]];
+      qgamma[i] = (short)std::min(gamma[i]*32 + 0.5f, 32767.0f);
+    }
+    volk_32f_x2_trellis_maxstar_32f_manual(&m1[0], &m0[0], &gamma[0], &tables[0],
+                                           correction, 2, S, impl);
+    volk_16i_x2_trellis_maxstar_16i_manual(&q1[0], &q0[0], &qgamma[0], &tables[0],
+                                           qcorrection, 2, S, impl);
+    m0.swap(m1);
+    q0.swap(q1);
+  }
+  for(int j = 0; j < S; j++)
+    m0.push_back(q0[j]);
+  return m0;
+}
+
+int
+main(int argc, char **argv)
+{
+  const double ebn0s[] = {0.5, 1.0, 1.5};
+  const decoder_t decoders[] = {
+    {"legacy min-sum", false, 0, &min},
+    {"legacy min*", false, 0, &min_star},
+    {"legacy linear", false, 0, &min_star_linear},
+    {"legacy table", false, 0, &min_star_lut},
+    {"float min-sum", true, 0, &min},
+    {"float min*", true, 0, &min_star},
+    {"float linear", true, 0, &min_star_linear},
+    {"float table", true, 0, &min_star_lut},
+    {"int16 min-sum", true, 16, &min},
+    {"int16 linear", true, 16, &min_star_linear},
+    {"int16 table", true, 16, &min_star_lut}
+  };
+  const int ndecoders = sizeof(decoders)/sizeof(decoders[0]);
+  fsm f = rsc_fsm();
+  interleaver inter(K, 1);
+  std::vector<int> data;
+  std::vector<float> metrics1, metrics2;
+  bool ok = true;
+
+  srand(1);
+
+  printf("rate 1/3 PCCC, 8 state constituents, %d bits, %d iterations\n",
+         K, ITERATIONS);
+  for(size_t e = 0; e < sizeof(ebn0s)/sizeof(ebn0s[0]); e++) {
+    double sigma = sqrt(1.0/(2.0/3.0*pow(10.0, ebn0s[e]/10.0)));
+    make_metrics(f, inter, sigma, data, metrics1, metrics2);
+
+    printf("Eb/N0 %3.1f dB\n", ebn0s[e]);
+    for(int d = 0; d < ndecoders; d++) {
+      double t;
+      int nerrors = turbo_decode(f, inter, decoders[d], data, metrics1, metrics2, t);
+      printf("  %-15s %8.3f Mb/s  BER %.2e\n", decoders[d].name,
+             1e-6*NBLOCKS*K/t, (double)nerrors/(NBLOCKS*K));
+    }
+  }
+
+  // Bit-exact check of every kernel implementation against generic
+  std::vector<float> ref, out;
+  make_metrics(f, inter, 0.8, data, metrics1, metrics2);
+  ref = maxstar_impl(f, metrics1, "generic");
+  volk_func_desc_t desc = volk_32f_x2_trellis_maxstar_32f_get_func_desc();
+  for(size_t i = 0; i < desc.n_impls; i++) {
+    out = maxstar_impl(f, metrics1, desc.impl_names[i]);
+    bool same = (ref == out);
+    printf("%18s:  maxstar: %s\n", desc.impl_names[i], same ? "bit-exact" : "MISMATCH");
+    ok = ok && same;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -68,6 +68,19 @@ int main(int argc, char *argv[]) {
     //VOLK_PROFILE(volk_16i_x5_add_quad_16i_x4, 1e-4, 2046, 10000, &results, benchmark_mode, kernel_regex);
     //VOLK_PROFILE(volk_16i_branch_4_state_8, 1e-4, 2046, 10000, &results, benchmark_mode, kernel_regex);
     VOLK_PUPPET_PROFILE(volk_32fc_s32fc_rotatorpuppet_32fc, volk_32fc_s32fc_x2_rotator_32fc, 1e-2, (lv_32fc_t)lv_cmake(0.953939201, 0.3), 20462, 10000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_8u_conv_k7_r2puppet_8u, volk_8u_x4_conv_k7_r2_8u, 0, 0, 2050, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_8u_gf256_hornerpuppet_8u, volk_8u_x2_gf256_horner_8u, 0, 0, 2070, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_8u_gf256_lincombpuppet_8u, volk_8u_x2_gf256_lincomb_8u, 0, 0, 8192, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_8u_crcpuppet_32u, volk_8u_x2_crc_32u, 0, 0, 204602, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_8u_hammingpuppet_8u, volk_8u_x2_hamming_8u, 0, 0, 20462, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_32f_trellis_acspuppet_32f, volk_32f_x2_trellis_acs_32f, 1e-4, 0, 20480, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_16i_trellis_acspuppet_16i, volk_16i_x2_trellis_acs_16i, 0, 0, 20480, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_32f_trellis_maxstarpuppet_32f, volk_32f_x2_trellis_maxstar_32f, 1e-4, 0, 20480, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_16i_trellis_maxstarpuppet_16i, volk_16i_x2_trellis_maxstar_16i, 0, 0, 20480, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_32fc_costas_looppuppet_32fc, volk_32fc_s32f_x2_costas_loop_32fc, 1e-4, 0, 20462, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_32u_gaussianpuppet_32f, volk_32u_gaussian_32f, 1e-5, 0, 20462, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_32fc_sum_of_sinusoidspuppet_32f, volk_32fc_x2_sum_of_sinusoids_32f, 1e-3, 0, 20462, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PUPPET_PROFILE(volk_32fc_gather_dot_prodpuppet_32fc, volk_32fc_32f_32u_gather_dot_prod_32fc, 1e-4, 0, 20462, 1000, &results, benchmark_mode, kernel_regex);
     VOLK_PROFILE(volk_16ic_s32f_deinterleave_real_32f, 1e-5, 32768.0, 204602, 10000, &results, benchmark_mode, kernel_regex);
     VOLK_PROFILE(volk_16ic_deinterleave_real_8i, 0, 0, 204602, 10000, &results, benchmark_mode, kernel_regex);
     VOLK_PROFILE(volk_16ic_deinterleave_16i_x2, 0, 0, 204602, 10000, &results, benchmark_mode, kernel_regex);
@@ -152,6 +165,7 @@ int main(int argc, char *argv[]) {
     VOLK_PROFILE(volk_8i_s32f_convert_32f, 1e-4, 100, 204602, 2000, &results, benchmark_mode, kernel_regex);
     //VOLK_PROFILE(volk_32fc_s32fc_multiply_32fc, 1e-4, lv_32fc_t(1.0, 0.5), 204602, 1000, &results, benchmark_mode, kernel_regex);
     VOLK_PROFILE(volk_32fc_s32fc_multiply_32fc, 1e-4, 0, 204602, 1000, &results, benchmark_mode, kernel_regex);
+    VOLK_PROFILE(volk_32fc_x2_s32fc_multiply_conjugate_add_32fc, 1e-4, (lv_32fc_t)lv_cmake(0.03, -0.02), 204602, 1000, &results, benchmark_mode, kernel_regex);
     VOLK_PROFILE(volk_32f_s32f_multiply_32f, 1e-4, 1.0, 204602, 10000, &results, benchmark_mode, kernel_regex);
 
     // Until we can update the config on a kernel by kernel basis
@@ -0,0 +1,92 @@
+#ifndef INCLUDED_volk_16i_trellis_acspuppet_16i_H
+#define INCLUDED_volk_16i_trellis_acspuppet_16i_H
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk/volk_16i_x2_trellis_acs_16i.h>
+
+/*
+ * Test puppet for volk_16i_x2_trellis_acs_16i: runs num_points/64-1
+ * steps of a 64 state, rate 1/2 shift register trellis on the low ten
+ * bits of the input as branch metrics (four per step) and writes every
+ * decision followed by the final path metrics.
+ */
+
+static inline void
+volk_16i_trellis_acspuppet_16i_tables(int* tables)
+{
+  const unsigned int polys[2] = {0x4f, 0x6d};
+  unsigned int j, p, k, reg, par, o;
+
+  // State j is entered from (j >> 1) | (p << 5) with input j & 1
+  for(p = 0; p < 2; p++) {
+    for(j = 0; j < 64; j++) {
+      reg = (p << 6) | j;
+      o = 0;
+      for(k = 0; k < 2; k++) {
+        par = reg & polys[k];
+        par ^= par >> 4;
+        par ^= par >> 2;
+        par ^= par >> 1;
+        o = (o << 1) | (par & 1);
+      }
+      tables[p*64 + j] = (j >> 1) | (p << 5);
+      tables[(2+p)*64 + j] = o;
+    }
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_16i_trellis_acspuppet_16i_generic(int16_t* out, const int16_t* in, unsigned int num_points){
+  const unsigned int nsteps = num_points / 64 - 1;
+  int16_t metrics[2][64], branch[4];
+  uint16_t dec[64];
+  int tables[256];
+  unsigned int k, j;
+
+  volk_16i_trellis_acspuppet_16i_tables(tables);
+  memset(out, 0, num_points*sizeof(int16_t));
+  memset(metrics[0], 0, sizeof(metrics[0]));
+  for(k = 0; k < nsteps; k++) {
+    for(j = 0; j < 4; j++) {
+      branch[j] = in[4*k + j] & 1023;
+    }
+    volk_16i_x2_trellis_acs_16i_generic(metrics[(k+1) & 1], dec, metrics[k & 1], branch, tables, 2, 64);
+    for(j = 0; j < 64; j++) {
+      out[64*k + j] = dec[j];
+    }
+  }
+  memcpy(out + 64*nsteps, metrics[nsteps & 1], sizeof(metrics[0]));
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_16i_trellis_acspuppet_16i_sse2(int16_t* out, const int16_t* in, unsigned int num_points){
+  const unsigned int nsteps = num_points / 64 - 1;
+  int16_t metrics[2][64], branch[4];
+  uint16_t dec[64];
+  int tables[256];
+  unsigned int k, j;
+
+  volk_16i_trellis_acspuppet_16i_tables(tables);
+  memset(out, 0, num_points*sizeof(int16_t));
+  memset(metrics[0], 0, sizeof(metrics[0]));
+  for(k = 0; k < nsteps; k++) {
+    for(j = 0; j < 4; j++) {
+      branch[j] = in[4*k + j] & 1023;
+    }
+    volk_16i_x2_trellis_acs_16i_sse2(metrics[(k+1) & 1], dec, metrics[k & 1], branch, tables, 2, 64);
+    for(j = 0; j < 64; j++) {
+      out[64*k + j] = dec[j];
+    }
+  }
+  memcpy(out + 64*nsteps, metrics[nsteps & 1], sizeof(metrics[0]));
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_16i_trellis_acspuppet_16i_H */
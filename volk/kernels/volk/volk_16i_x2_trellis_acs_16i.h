@@ -0,0 +1,156 @@
+#ifndef INCLUDED_volk_16i_x2_trellis_acs_16i_H
+#define INCLUDED_volk_16i_x2_trellis_acs_16i_H
+
+/*
+ * Fixed point version of volk_32f_x2_trellis_acs_32f: the path and
+ * branch metrics are 16-bit and the additions saturate at 32767, so
+ * eight states share a register.  With non-negative branch metrics the
+ * normalized path metrics stay in [0, 32767].  For every state j:
+ *
+ *   m[j] = min_p sat(metrics_in[tables[p*S + j]] + branch[tables[(npred+p)*S + j]])
+ *   metrics_out[j] = m[j] - min_j m[j]
+ *   decisions[j] = the first p reaching m[j]
+ *
+ * where S = num_points.  npred may be at most 32768.
+ */
+
+#include <inttypes.h>
+
+static inline int16_t
+volk_16i_x2_trellis_acs_16i_adds(int16_t a, int16_t b)
+{
+  int s = (int)a + (int)b;
+  return s > 32767 ? 32767 : (s < -32768 ? -32768 : s);
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Runs one normalized add-compare-select step over all states on 16-bit metrics
+  \param metrics_out The new path metrics
+  \param decisions The index of the surviving predecessor of each state
+  \param metrics_in The old path metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_16i_x2_trellis_acs_16i_generic(int16_t* metrics_out, uint16_t* decisions, const int16_t* metrics_in, const int16_t* branch, const int* tables, unsigned int npred, unsigned int num_points){
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  int16_t norm = 0, m, best;
+  unsigned int j, p;
+  uint16_t d;
+
+  for(j = 0; j < num_points; j++) {
+    best = volk_16i_x2_trellis_acs_16i_adds(metrics_in[st[j]], branch[br[j]]);
+    d = 0;
+    for(p = 1; p < npred; p++) {
+      m = volk_16i_x2_trellis_acs_16i_adds(metrics_in[st[p*num_points + j]], branch[br[p*num_points + j]]);
+      if(m < best) {
+        best = m;
+        d = p;
+      }
+    }
+    metrics_out[j] = best;
+    decisions[j] = d;
+    if(j == 0 || best < norm)
+      norm = best;
+  }
+  for(j = 0; j < num_points; j++) {
+    metrics_out[j] = (int16_t)(metrics_out[j] - norm);
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+// There is no gather, but the compares and selects run branch free
+#define volk_16i_x2_trellis_acs_16i_gather(v, idx)                        \
+  _mm_setr_epi16((v)[(idx)[0]], (v)[(idx)[1]], (v)[(idx)[2]], (v)[(idx)[3]], \
+                 (v)[(idx)[4]], (v)[(idx)[5]], (v)[(idx)[6]], (v)[(idx)[7]])
+
+/*!
+  \brief Runs one normalized add-compare-select step over all states on 16-bit metrics, eight states per step
+  \param metrics_out The new path metrics
+  \param decisions The index of the surviving predecessor of each state
+  \param metrics_in The old path metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_16i_x2_trellis_acs_16i_sse2(int16_t* metrics_out, uint16_t* decisions, const int16_t* metrics_in, const int16_t* branch, const int* tables, unsigned int npred, unsigned int num_points){
+  const unsigned int eighth_points = num_points / 8;
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  __m128i best, cand, lt, idx, vnorm;
+  int16_t norm, m, b;
+  int16_t tmp[8];
+  unsigned int j, p, q;
+  uint16_t d;
+
+  vnorm = _mm_set1_epi16(32767);
+  for(q = 0; q < eighth_points; q++) {
+    const int* s = st + 8*q;
+    const int* r = br + 8*q;
+
+    best = _mm_adds_epi16(volk_16i_x2_trellis_acs_16i_gather(metrics_in, s),
+                          volk_16i_x2_trellis_acs_16i_gather(branch, r));
+    idx = _mm_setzero_si128();
+    for(p = 1; p < npred; p++) {
+      s += num_points;
+      r += num_points;
+      cand = _mm_adds_epi16(volk_16i_x2_trellis_acs_16i_gather(metrics_in, s),
+                            volk_16i_x2_trellis_acs_16i_gather(branch, r));
+      lt = _mm_cmplt_epi16(cand, best);
+      best = _mm_min_epi16(cand, best);
+      idx = _mm_or_si128(_mm_and_si128(lt, _mm_set1_epi16(p)), _mm_andnot_si128(lt, idx));
+    }
+    _mm_storeu_si128((__m128i*)(metrics_out + 8*q), best);
+    _mm_storeu_si128((__m128i*)(decisions + 8*q), idx);
+    vnorm = _mm_min_epi16(vnorm, best);
+  }
+
+  _mm_storeu_si128((__m128i*)tmp, vnorm);
+  norm = tmp[0];
+  for(j = 1; j < 8; j++) {
+    if(tmp[j] < norm)
+      norm = tmp[j];
+  }
+
+  for(j = 8*eighth_points; j < num_points; j++) {
+    b = volk_16i_x2_trellis_acs_16i_adds(metrics_in[st[j]], branch[br[j]]);
+    d = 0;
+    for(p = 1; p < npred; p++) {
+      m = volk_16i_x2_trellis_acs_16i_adds(metrics_in[st[p*num_points + j]], branch[br[p*num_points + j]]);
+      if(m < b) {
+        b = m;
+        d = p;
+      }
+    }
+    metrics_out[j] = b;
+    decisions[j] = d;
+    if(b < norm)
+      norm = b;
+  }
+
+  vnorm = _mm_set1_epi16(norm);
+  for(q = 0; q < eighth_points; q++) {
+    _mm_storeu_si128((__m128i*)(metrics_out + 8*q),
+                     _mm_sub_epi16(_mm_loadu_si128((const __m128i*)(metrics_out + 8*q)), vnorm));
+  }
+  for(j = 8*eighth_points; j < num_points; j++) {
+    metrics_out[j] = (int16_t)(metrics_out[j] - norm);
+  }
+}
+
+#undef volk_16i_x2_trellis_acs_16i_gather
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_16i_x2_trellis_acs_16i_H */
@@ -0,0 +1,170 @@
+#ifndef INCLUDED_volk_16i_x2_trellis_maxstar_16i_H
+#define INCLUDED_volk_16i_x2_trellis_maxstar_16i_H
+
+/*
+ * Fixed point version of volk_32f_x2_trellis_maxstar_32f on 16-bit
+ * metrics with saturating arithmetic, eight states per register.  The
+ * correction is given by 18 values in metric units:
+ * f(d) = max(0, c[0] - (d >> c[1])) plus c[10+k] for every k < 8 with
+ * d < c[2+k]; the table ends at the first zero height.  A saturated
+ * metric of 32767 stands for an impossible state and is kept as it is,
+ * so that corrections and normalization do not make it possible.
+ */
+
+#include <inttypes.h>
+
+static inline int16_t
+volk_16i_x2_trellis_maxstar_16i_sat(int s)
+{
+  return s > 32767 ? 32767 : (s < -32768 ? -32768 : s);
+}
+
+static inline int16_t
+volk_16i_x2_trellis_maxstar_16i_fold(int16_t x, int16_t y, const int16_t* c)
+{
+  int16_t d = volk_16i_x2_trellis_maxstar_16i_sat(x > y ? x - y : y - x);
+  int16_t m = y < x ? y : x;
+  int f = c[0] - (d >> c[1]);
+  unsigned int k;
+
+  if(m == 32767)
+    return m;
+  f = f > 0 ? f : 0;
+  for(k = 0; k < 8 && c[10+k] != 0; k++) {
+    if(d < c[2+k])
+      f += c[10+k];
+  }
+  return volk_16i_x2_trellis_maxstar_16i_sat(m - volk_16i_x2_trellis_maxstar_16i_sat(f));
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Runs one normalized min* recursion step over all states on 16-bit metrics
+  \param metrics_out The new state metrics
+  \param metrics_in The old state metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param correction The correction function, 18 values
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_16i_x2_trellis_maxstar_16i_generic(int16_t* metrics_out, const int16_t* metrics_in, const int16_t* branch, const int* tables, const int16_t* correction, unsigned int npred, unsigned int num_points){
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  int16_t norm = 0, acc;
+  unsigned int j, p;
+
+  for(j = 0; j < num_points; j++) {
+    acc = volk_16i_x2_trellis_maxstar_16i_sat(metrics_in[st[j]] + branch[br[j]]);
+    for(p = 1; p < npred; p++) {
+      acc = volk_16i_x2_trellis_maxstar_16i_fold(acc, volk_16i_x2_trellis_maxstar_16i_sat(metrics_in[st[p*num_points + j]] + branch[br[p*num_points + j]]), correction);
+    }
+    metrics_out[j] = acc;
+    if(j == 0 || acc < norm)
+      norm = acc;
+  }
+  for(j = 0; j < num_points; j++) {
+    if(metrics_out[j] != 32767)
+      metrics_out[j] = (int16_t)(metrics_out[j] - norm);
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+#define volk_16i_x2_trellis_maxstar_16i_gather(v, idx)                    \
+  _mm_setr_epi16((v)[(idx)[0]], (v)[(idx)[1]], (v)[(idx)[2]], (v)[(idx)[3]], \
+                 (v)[(idx)[4]], (v)[(idx)[5]], (v)[(idx)[6]], (v)[(idx)[7]])
+
+/*!
+  \brief Runs one normalized min* recursion step over all states on 16-bit metrics, eight states per step
+  \param metrics_out The new state metrics
+  \param metrics_in The old state metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param correction The correction function, 18 values
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_16i_x2_trellis_maxstar_16i_sse2(int16_t* metrics_out, const int16_t* metrics_in, const int16_t* branch, const int* tables, const int16_t* correction, unsigned int npred, unsigned int num_points){
+  const unsigned int eighth_points = num_points / 8;
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i inf = _mm_set1_epi16(32767);
+  const __m128i a = _mm_set1_epi16(correction[0]);
+  const __m128i shift = _mm_cvtsi32_si128(correction[1]);
+  __m128i thresh[8], height[8];
+  __m128i acc, cand, d, f, m, vnorm;
+  int16_t norm, acc_s, tmp[8];
+  unsigned int j, p, q, k, nlut;
+
+  for(nlut = 0; nlut < 8 && correction[10+nlut] != 0; nlut++) {
+    thresh[nlut] = _mm_set1_epi16(correction[2+nlut]);
+    height[nlut] = _mm_set1_epi16(correction[10+nlut]);
+  }
+
+  vnorm = inf;
+  for(q = 0; q < eighth_points; q++) {
+    const int* s = st + 8*q;
+    const int* r = br + 8*q;
+
+    acc = _mm_adds_epi16(volk_16i_x2_trellis_maxstar_16i_gather(metrics_in, s),
+                         volk_16i_x2_trellis_maxstar_16i_gather(branch, r));
+    for(p = 1; p < npred; p++) {
+      s += num_points;
+      r += num_points;
+      cand = _mm_adds_epi16(volk_16i_x2_trellis_maxstar_16i_gather(metrics_in, s),
+                            volk_16i_x2_trellis_maxstar_16i_gather(branch, r));
+      d = _mm_subs_epi16(_mm_max_epi16(acc, cand), _mm_min_epi16(acc, cand));
+      f = _mm_max_epi16(_mm_sub_epi16(a, _mm_sra_epi16(d, shift)), zero);
+      for(k = 0; k < nlut; k++) {
+        f = _mm_adds_epi16(f, _mm_and_si128(_mm_cmplt_epi16(d, thresh[k]), height[k]));
+      }
+      m = _mm_min_epi16(cand, acc);
+      acc = _mm_subs_epi16(m, _mm_andnot_si128(_mm_cmpeq_epi16(m, inf), f));
+    }
+    _mm_storeu_si128((__m128i*)(metrics_out + 8*q), acc);
+    vnorm = _mm_min_epi16(vnorm, acc);
+  }
+
+  _mm_storeu_si128((__m128i*)tmp, vnorm);
+  norm = tmp[0];
+  for(j = 1; j < 8; j++) {
+    if(tmp[j] < norm)
+      norm = tmp[j];
+  }
+
+  for(j = 8*eighth_points; j < num_points; j++) {
+    acc_s = volk_16i_x2_trellis_maxstar_16i_sat(metrics_in[st[j]] + branch[br[j]]);
+    for(p = 1; p < npred; p++) {
+      acc_s = volk_16i_x2_trellis_maxstar_16i_fold(acc_s, volk_16i_x2_trellis_maxstar_16i_sat(metrics_in[st[p*num_points + j]] + branch[br[p*num_points + j]]), correction);
+    }
+    metrics_out[j] = acc_s;
+    if(acc_s < norm)
+      norm = acc_s;
+  }
+
+  vnorm = _mm_set1_epi16(norm);
+  for(q = 0; q < eighth_points; q++) {
+    m = _mm_loadu_si128((const __m128i*)(metrics_out + 8*q));
+    d = _mm_cmpeq_epi16(m, inf);
+    _mm_storeu_si128((__m128i*)(metrics_out + 8*q),
+                     _mm_or_si128(_mm_andnot_si128(d, _mm_sub_epi16(m, vnorm)), _mm_and_si128(d, inf)));
+  }
+  for(j = 8*eighth_points; j < num_points; j++) {
+    if(metrics_out[j] != 32767)
+      metrics_out[j] = (int16_t)(metrics_out[j] - norm);
+  }
+}
+
+#undef volk_16i_x2_trellis_maxstar_16i_gather
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_16i_x2_trellis_maxstar_16i_H */
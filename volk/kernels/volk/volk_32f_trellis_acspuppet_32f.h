@@ -0,0 +1,86 @@
+#ifndef INCLUDED_volk_32f_trellis_acspuppet_32f_H
+#define INCLUDED_volk_32f_trellis_acspuppet_32f_H
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk/volk_32f_x2_trellis_acs_32f.h>
+
+/*
+ * Test puppet for volk_32f_x2_trellis_acs_32f: runs num_points/64-1
+ * steps of a 64 state, rate 1/2 shift register trellis on the input as
+ * branch metrics (four per step) and writes every decision followed by
+ * the final path metrics.
+ */
+
+static inline void
+volk_32f_trellis_acspuppet_32f_tables(int* tables)
+{
+  const unsigned int polys[2] = {0x4f, 0x6d};
+  unsigned int j, p, k, reg, par, o;
+
+  // State j is entered from (j >> 1) | (p << 5) with input j & 1
+  for(p = 0; p < 2; p++) {
+    for(j = 0; j < 64; j++) {
+      reg = (p << 6) | j;
+      o = 0;
+      for(k = 0; k < 2; k++) {
+        par = reg & polys[k];
+        par ^= par >> 4;
+        par ^= par >> 2;
+        par ^= par >> 1;
+        o = (o << 1) | (par & 1);
+      }
+      tables[p*64 + j] = (j >> 1) | (p << 5);
+      tables[(2+p)*64 + j] = o;
+    }
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_32f_trellis_acspuppet_32f_generic(float* out, const float* in, unsigned int num_points){
+  const unsigned int nsteps = num_points / 64 - 1;
+  float metrics[2][64];
+  uint16_t dec[64];
+  int tables[256];
+  unsigned int k, j;
+
+  volk_32f_trellis_acspuppet_32f_tables(tables);
+  memset(out, 0, num_points*sizeof(float));
+  memset(metrics[0], 0, sizeof(metrics[0]));
+  for(k = 0; k < nsteps; k++) {
+    volk_32f_x2_trellis_acs_32f_generic(metrics[(k+1) & 1], dec, metrics[k & 1], in + 4*k, tables, 2, 64);
+    for(j = 0; j < 64; j++) {
+      out[64*k + j] = dec[j];
+    }
+  }
+  memcpy(out + 64*nsteps, metrics[nsteps & 1], sizeof(metrics[0]));
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_32f_trellis_acspuppet_32f_sse2(float* out, const float* in, unsigned int num_points){
+  const unsigned int nsteps = num_points / 64 - 1;
+  float metrics[2][64];
+  uint16_t dec[64];
+  int tables[256];
+  unsigned int k, j;
+
+  volk_32f_trellis_acspuppet_32f_tables(tables);
+  memset(out, 0, num_points*sizeof(float));
+  memset(metrics[0], 0, sizeof(metrics[0]));
+  for(k = 0; k < nsteps; k++) {
+    volk_32f_x2_trellis_acs_32f_sse2(metrics[(k+1) & 1], dec, metrics[k & 1], in + 4*k, tables, 2, 64);
+    for(j = 0; j < 64; j++) {
+      out[64*k + j] = dec[j];
+    }
+  }
+  memcpy(out + 64*nsteps, metrics[nsteps & 1], sizeof(metrics[0]));
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_32f_trellis_acspuppet_32f_H */
@@ -0,0 +1,81 @@
+#ifndef INCLUDED_volk_32f_trellis_maxstarpuppet_32f_H
+#define INCLUDED_volk_32f_trellis_maxstarpuppet_32f_H
+
+#include <inttypes.h>
+#include <string.h>
+#include <volk/volk_32f_x2_trellis_maxstar_32f.h>
+
+/*
+ * Test puppet for volk_32f_x2_trellis_maxstar_32f: runs num_points/64
+ * steps of the forward recursion of a 64 state, rate 1/2 shift register
+ * trellis on the input as branch metrics (four per step) with both the
+ * line and the table correction, and writes the state metrics of every
+ * step.
+ */
+
+static const float volk_32f_trellis_maxstarpuppet_32f_correction[18] = {
+  0.6931472f, 0.25f,
+  0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 3.5f, 4.0f,
+  0.05f, 0.04f, 0.03f, 0.02f, 0.01f, 0.005f, 0.0025f, 0.00125f
+};
+
+static inline void
+volk_32f_trellis_maxstarpuppet_32f_tables(int* tables)
+{
+  const unsigned int polys[2] = {0x4f, 0x6d};
+  unsigned int j, p, k, reg, par, o;
+
+  // State j is entered from (j >> 1) | (p << 5) with input j & 1
+  for(p = 0; p < 2; p++) {
+    for(j = 0; j < 64; j++) {
+      reg = (p << 6) | j;
+      o = 0;
+      for(k = 0; k < 2; k++) {
+        par = reg & polys[k];
+        par ^= par >> 4;
+        par ^= par >> 2;
+        par ^= par >> 1;
+        o = (o << 1) | (par & 1);
+      }
+      tables[p*64 + j] = (j >> 1) | (p << 5);
+      tables[(2+p)*64 + j] = o;
+    }
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_32f_trellis_maxstarpuppet_32f_generic(float* out, const float* in, unsigned int num_points){
+  const unsigned int nsteps = num_points / 64;
+  float metrics[64];
+  int tables[256];
+  unsigned int k;
+
+  volk_32f_trellis_maxstarpuppet_32f_tables(tables);
+  memset(metrics, 0, sizeof(metrics));
+  for(k = 0; k < nsteps; k++) {
+    volk_32f_x2_trellis_maxstar_32f_generic(out + 64*k, k == 0 ? metrics : out + 64*(k-1), in + 4*k, tables, volk_32f_trellis_maxstarpuppet_32f_correction, 2, 64);
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_32f_trellis_maxstarpuppet_32f_sse2(float* out, const float* in, unsigned int num_points){
+  const unsigned int nsteps = num_points / 64;
+  float metrics[64];
+  int tables[256];
+  unsigned int k;
+
+  volk_32f_trellis_maxstarpuppet_32f_tables(tables);
+  memset(metrics, 0, sizeof(metrics));
+  for(k = 0; k < nsteps; k++) {
+    volk_32f_x2_trellis_maxstar_32f_sse2(out + 64*k, k == 0 ? metrics : out + 64*(k-1), in + 4*k, tables, volk_32f_trellis_maxstarpuppet_32f_correction, 2, 64);
+  }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_32f_trellis_maxstarpuppet_32f_H */
@@ -0,0 +1,147 @@
+#ifndef INCLUDED_volk_32f_x2_trellis_acs_32f_H
+#define INCLUDED_volk_32f_x2_trellis_acs_32f_H
+
+/*
+ * Add-compare-select over all states of a general trellis whose
+ * predecessors have been flattened into tables (see
+ * gr::trellis::fsm_engine).  For every state j:
+ *
+ *   m[j] = min_p metrics_in[tables[p*S + j]] + branch[tables[(npred+p)*S + j]]
+ *   metrics_out[j] = m[j] - min_j m[j]
+ *   decisions[j] = the first p reaching m[j]
+ *
+ * where S = num_points.  Row p of the first half of the tables holds the
+ * p-th predecessor state of every state, row p of the second half the
+ * index of the matching branch metric.  States with fewer than npred
+ * predecessors repeat one of them, which never changes the minimum.
+ * npred may be at most 32768.
+ */
+
+#include <inttypes.h>
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Runs one normalized add-compare-select step over all states
+  \param metrics_out The new path metrics
+  \param decisions The index of the surviving predecessor of each state
+  \param metrics_in The old path metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_32f_x2_trellis_acs_32f_generic(float* metrics_out, uint16_t* decisions, const float* metrics_in, const float* branch, const int* tables, unsigned int npred, unsigned int num_points){
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  float norm = 0, m, best;
+  unsigned int j, p;
+  uint16_t d;
+
+  for(j = 0; j < num_points; j++) {
+    best = metrics_in[st[j]] + branch[br[j]];
+    d = 0;
+    for(p = 1; p < npred; p++) {
+      m = metrics_in[st[p*num_points + j]] + branch[br[p*num_points + j]];
+      if(m < best) {
+        best = m;
+        d = p;
+      }
+    }
+    metrics_out[j] = best;
+    decisions[j] = d;
+    if(j == 0 || best < norm)
+      norm = best;
+  }
+  for(j = 0; j < num_points; j++) {
+    metrics_out[j] -= norm;
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+/*!
+  \brief Runs one normalized add-compare-select step over all states, four states per step
+  \param metrics_out The new path metrics
+  \param decisions The index of the surviving predecessor of each state
+  \param metrics_in The old path metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_32f_x2_trellis_acs_32f_sse2(float* metrics_out, uint16_t* decisions, const float* metrics_in, const float* branch, const int* tables, unsigned int npred, unsigned int num_points){
+  const unsigned int quarter_points = num_points / 4;
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  __m128 best, cand, lt, vnorm;
+  __m128i idx;
+  float norm, m, b;
+  float tmp[4];
+  unsigned int j, p, q;
+  uint16_t d;
+
+  vnorm = _mm_set1_ps(0);
+  for(q = 0; q < quarter_points; q++) {
+    const int* s = st + 4*q;
+    const int* r = br + 4*q;
+
+    // There is no gather, but the compares and selects run branch free
+    best = _mm_add_ps(_mm_setr_ps(metrics_in[s[0]], metrics_in[s[1]], metrics_in[s[2]], metrics_in[s[3]]),
+                      _mm_setr_ps(branch[r[0]], branch[r[1]], branch[r[2]], branch[r[3]]));
+    idx = _mm_setzero_si128();
+    for(p = 1; p < npred; p++) {
+      s += num_points;
+      r += num_points;
+      cand = _mm_add_ps(_mm_setr_ps(metrics_in[s[0]], metrics_in[s[1]], metrics_in[s[2]], metrics_in[s[3]]),
+                        _mm_setr_ps(branch[r[0]], branch[r[1]], branch[r[2]], branch[r[3]]));
+      lt = _mm_cmplt_ps(cand, best);
+      best = _mm_min_ps(cand, best);
+      idx = _mm_or_si128(_mm_and_si128(_mm_castps_si128(lt), _mm_set1_epi32(p)),
+                         _mm_andnot_si128(_mm_castps_si128(lt), idx));
+    }
+    _mm_storeu_ps(metrics_out + 4*q, best);
+    _mm_storel_epi64((__m128i*)(decisions + 4*q), _mm_packs_epi32(idx, idx));
+    vnorm = q == 0 ? best : _mm_min_ps(vnorm, best);
+  }
+
+  _mm_storeu_ps(tmp, vnorm);
+  norm = tmp[0];
+  for(j = 1; j < 4; j++) {
+    if(tmp[j] < norm)
+      norm = tmp[j];
+  }
+
+  for(j = 4*quarter_points; j < num_points; j++) {
+    b = metrics_in[st[j]] + branch[br[j]];
+    d = 0;
+    for(p = 1; p < npred; p++) {
+      m = metrics_in[st[p*num_points + j]] + branch[br[p*num_points + j]];
+      if(m < b) {
+        b = m;
+        d = p;
+      }
+    }
+    metrics_out[j] = b;
+    decisions[j] = d;
+    if((j == 0 && quarter_points == 0) || b < norm)
+      norm = b;
+  }
+
+  vnorm = _mm_set1_ps(norm);
+  for(q = 0; q < quarter_points; q++) {
+    _mm_storeu_ps(metrics_out + 4*q, _mm_sub_ps(_mm_loadu_ps(metrics_out + 4*q), vnorm));
+  }
+  for(j = 4*quarter_points; j < num_points; j++) {
+    metrics_out[j] -= norm;
+  }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_32f_x2_trellis_acs_32f_H */
@@ -0,0 +1,161 @@
+#ifndef INCLUDED_volk_32f_x2_trellis_maxstar_32f_H
+#define INCLUDED_volk_32f_x2_trellis_maxstar_32f_H
+
+/*
+ * One step of the forward or backward recursion of a log-MAP decoder
+ * over all states of a flattened trellis (see volk_32f_x2_trellis_acs_32f
+ * for the table layout).  Metrics are negative log probabilities, so
+ * the Jacobian logarithm becomes
+ *
+ *   min*(x, y) = min(x, y) - f(|x - y|),  f(d) ~ log(1 + exp(-d))
+ *
+ * and the predecessors of each state are folded with min* in order.  The
+ * correction is given by 18 values: f(d) = max(0, c[0] - c[1]*d) plus
+ * c[10+k] for every k < 8 with d < c[2+k], i.e. a line and a small
+ * lookup table over ascending thresholds, either of which may be zero.
+ * The table ends at the first zero height.
+ * The results are normalized so that the smallest is 0.
+ *
+ * Padding entries of the tables must point at a path metric large
+ * enough that it never changes the result.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+
+static inline float
+volk_32f_x2_trellis_maxstar_32f_fold(float x, float y, const float* c)
+{
+  float d = fabsf(x - y);
+  float m = y < x ? y : x;
+  float f = c[0] - c[1]*d;
+  unsigned int k;
+
+  f = f > 0 ? f : 0;
+  for(k = 0; k < 8 && c[10+k] != 0; k++) {
+    if(d < c[2+k])
+      f += c[10+k];
+  }
+  return m - f;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Runs one normalized min* recursion step over all states
+  \param metrics_out The new state metrics
+  \param metrics_in The old state metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param correction The correction function, 18 values
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_32f_x2_trellis_maxstar_32f_generic(float* metrics_out, const float* metrics_in, const float* branch, const int* tables, const float* correction, unsigned int npred, unsigned int num_points){
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  float norm = 0, acc;
+  unsigned int j, p;
+
+  for(j = 0; j < num_points; j++) {
+    acc = metrics_in[st[j]] + branch[br[j]];
+    for(p = 1; p < npred; p++) {
+      acc = volk_32f_x2_trellis_maxstar_32f_fold(acc, metrics_in[st[p*num_points + j]] + branch[br[p*num_points + j]], correction);
+    }
+    metrics_out[j] = acc;
+    if(j == 0 || acc < norm)
+      norm = acc;
+  }
+  for(j = 0; j < num_points; j++) {
+    metrics_out[j] -= norm;
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+/*!
+  \brief Runs one normalized min* recursion step over all states, four states per step
+  \param metrics_out The new state metrics
+  \param metrics_in The old state metrics
+  \param branch The branch metrics of this step
+  \param tables Predecessor states and branch metric indices, npred rows each
+  \param correction The correction function, 18 values
+  \param npred The number of predecessors per state
+  \param num_points The number of states
+*/
+static inline void volk_32f_x2_trellis_maxstar_32f_sse2(float* metrics_out, const float* metrics_in, const float* branch, const int* tables, const float* correction, unsigned int npred, unsigned int num_points){
+  const unsigned int quarter_points = num_points / 4;
+  const int* st = tables;
+  const int* br = tables + npred*num_points;
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 a = _mm_set1_ps(correction[0]);
+  const __m128 b = _mm_set1_ps(correction[1]);
+  __m128 thresh[8], height[8];
+  __m128 acc, cand, d, f, vnorm;
+  float norm, tmp[4];
+  unsigned int j, p, q, k, nlut;
+
+  // Only the table entries that can add something are evaluated
+  for(nlut = 0; nlut < 8 && correction[10+nlut] != 0; nlut++) {
+    thresh[nlut] = _mm_set1_ps(correction[2+nlut]);
+    height[nlut] = _mm_set1_ps(correction[10+nlut]);
+  }
+
+  vnorm = zero;
+  for(q = 0; q < quarter_points; q++) {
+    const int* s = st + 4*q;
+    const int* r = br + 4*q;
+
+    acc = _mm_add_ps(_mm_setr_ps(metrics_in[s[0]], metrics_in[s[1]], metrics_in[s[2]], metrics_in[s[3]]),
+                     _mm_setr_ps(branch[r[0]], branch[r[1]], branch[r[2]], branch[r[3]]));
+    for(p = 1; p < npred; p++) {
+      s += num_points;
+      r += num_points;
+      cand = _mm_add_ps(_mm_setr_ps(metrics_in[s[0]], metrics_in[s[1]], metrics_in[s[2]], metrics_in[s[3]]),
+                        _mm_setr_ps(branch[r[0]], branch[r[1]], branch[r[2]], branch[r[3]]));
+      d = _mm_and_ps(_mm_sub_ps(acc, cand), abs_mask);
+      f = _mm_max_ps(_mm_sub_ps(a, _mm_mul_ps(b, d)), zero);
+      for(k = 0; k < nlut; k++) {
+        f = _mm_add_ps(f, _mm_and_ps(_mm_cmplt_ps(d, thresh[k]), height[k]));
+      }
+      acc = _mm_sub_ps(_mm_min_ps(cand, acc), f);
+    }
+    _mm_storeu_ps(metrics_out + 4*q, acc);
+    vnorm = q == 0 ? acc : _mm_min_ps(vnorm, acc);
+  }
+
+  _mm_storeu_ps(tmp, vnorm);
+  norm = tmp[0];
+  for(j = 1; j < 4; j++) {
+    if(tmp[j] < norm)
+      norm = tmp[j];
+  }
+
+  for(j = 4*quarter_points; j < num_points; j++) {
+    float m = metrics_in[st[j]] + branch[br[j]];
+    for(p = 1; p < npred; p++) {
+      m = volk_32f_x2_trellis_maxstar_32f_fold(m, metrics_in[st[p*num_points + j]] + branch[br[p*num_points + j]], correction);
+    }
+    metrics_out[j] = m;
+    if((j == 0 && quarter_points == 0) || m < norm)
+      norm = m;
+  }
+
+  vnorm = _mm_set1_ps(norm);
+  for(q = 0; q < quarter_points; q++) {
+    _mm_storeu_ps(metrics_out + 4*q, _mm_sub_ps(_mm_loadu_ps(metrics_out + 4*q), vnorm));
+  }
+  for(j = 4*quarter_points; j < num_points; j++) {
+    metrics_out[j] -= norm;
+  }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_32f_x2_trellis_maxstar_32f_H */
@@ -0,0 +1,173 @@
+#ifndef INCLUDED_volk_32fc_32f_32u_gather_dot_prod_32fc_u_H
+#define INCLUDED_volk_32fc_32f_32u_gather_dot_prod_32fc_u_H
+
+/*
+ * result[i] = sum_k input[schedule[2i] + k] * taps[schedule[2i+1] + k]
+ *
+ * for k < ntaps: a batch of real filters, each applied at its own
+ * input offset.  With taps holding a polyphase bank and schedule
+ * holding the sample offset and the tap row of each output, this is
+ * the interpolation of a block of symbols at fractional delays.
+ *
+ * Each product is summed into one of four partial sums by its tap
+ * index modulo 4, over the whole groups of four taps; the sums are
+ * combined as (s0 + s2) + (s1 + s3) and the remaining taps added in
+ * order, the same in every implementation.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_common.h>
+#include <volk/volk_complex.h>
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Filters a complex vector with a real tap row at each scheduled offset
+  \param result The num_points filter outputs
+  \param input The complex input
+  \param taps The tap rows
+  \param schedule Input offset and tap offset, in samples and taps, of each output
+  \param ntaps The number of taps per output
+  \param num_points The number of outputs
+*/
+static inline void volk_32fc_32f_32u_gather_dot_prod_32fc_generic(lv_32fc_t* result, const lv_32fc_t* input, const float* taps, const uint32_t* schedule, unsigned int ntaps, unsigned int num_points){
+  const unsigned int groups = ntaps / 4;
+  float sr[4], si[4], re, im;
+  const float* x;
+  const float* t;
+  unsigned int number, k, j;
+
+  for(number = 0; number < num_points; number++) {
+    x = (const float*)(input + schedule[0]);
+    t = taps + schedule[1];
+
+    for(j = 0; j < 4; j++) {
+      sr[j] = 0;
+      si[j] = 0;
+    }
+    for(k = 0; k < groups; k++) {
+      for(j = 0; j < 4; j++) {
+        sr[j] += x[0] * t[0];
+        si[j] += x[1] * t[0];
+        x += 2;
+        t++;
+      }
+    }
+    re = (sr[0] + sr[2]) + (sr[1] + sr[3]);
+    im = (si[0] + si[2]) + (si[1] + si[3]);
+    for(k = 4 * groups; k < ntaps; k++) {
+      re += x[0] * t[0];
+      im += x[1] * t[0];
+      x += 2;
+      t++;
+    }
+
+    *result++ = lv_cmake(re, im);
+    schedule += 2;
+  }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE
+#include <xmmintrin.h>
+/*!
+  \brief Filters a complex vector with a real tap row at each scheduled offset
+  \param result The num_points filter outputs
+  \param input The complex input
+  \param taps The tap rows
+  \param schedule Input offset and tap offset, in samples and taps, of each output
+  \param ntaps The number of taps per output
+  \param num_points The number of outputs
+*/
+static inline void volk_32fc_32f_32u_gather_dot_prod_32fc_u_sse(lv_32fc_t* result, const lv_32fc_t* input, const float* taps, const uint32_t* schedule, unsigned int ntaps, unsigned int num_points){
+  const unsigned int groups = ntaps / 4;
+  __m128 acc0, acc1, tv, x0, x1;
+  __VOLK_ATTR_ALIGNED(16) float s[4];
+  float re, im;
+  const float* x;
+  const float* t;
+  unsigned int number, k;
+
+  for(number = 0; number < num_points; number++) {
+    x = (const float*)(input + schedule[0]);
+    t = taps + schedule[1];
+
+    acc0 = _mm_setzero_ps(); // s0, s1
+    acc1 = _mm_setzero_ps(); // s2, s3
+    for(k = 0; k < groups; k++) {
+      tv = _mm_loadu_ps(t);
+      x0 = _mm_loadu_ps(x);
+      x1 = _mm_loadu_ps(x + 4);
+      acc0 = _mm_add_ps(acc0, _mm_mul_ps(x0, _mm_unpacklo_ps(tv, tv)));
+      acc1 = _mm_add_ps(acc1, _mm_mul_ps(x1, _mm_unpackhi_ps(tv, tv)));
+      x += 8;
+      t += 4;
+    }
+    _mm_store_ps(s, _mm_add_ps(acc0, acc1));
+    re = s[0] + s[2];
+    im = s[1] + s[3];
+    for(k = 4 * groups; k < ntaps; k++) {
+      re += x[0] * t[0];
+      im += x[1] * t[0];
+      x += 2;
+      t++;
+    }
+
+    *result++ = lv_cmake(re, im);
+    schedule += 2;
+  }
+}
+#endif /* LV_HAVE_SSE */
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+/*!
+  \brief Filters a complex vector with a real tap row at each scheduled offset, four taps per step
+  \param result The num_points filter outputs
+  \param input The complex input
+  \param taps The tap rows
+  \param schedule Input offset and tap offset, in samples and taps, of each output
+  \param ntaps The number of taps per output
+  \param num_points The number of outputs
+*/
+static inline void volk_32fc_32f_32u_gather_dot_prod_32fc_u_avx(lv_32fc_t* result, const lv_32fc_t* input, const float* taps, const uint32_t* schedule, unsigned int ntaps, unsigned int num_points){
+  const unsigned int groups = ntaps / 4;
+  __m256 acc, tv;
+  __m128 t4, half;
+  __VOLK_ATTR_ALIGNED(16) float s[4];
+  float re, im;
+  const float* x;
+  const float* t;
+  unsigned int number, k;
+
+  for(number = 0; number < num_points; number++) {
+    x = (const float*)(input + schedule[0]);
+    t = taps + schedule[1];
+
+    acc = _mm256_setzero_ps(); // s0, s1, s2, s3
+    for(k = 0; k < groups; k++) {
+      t4 = _mm_loadu_ps(t);
+      tv = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t4, t4)),
+                                _mm_unpackhi_ps(t4, t4), 1);
+      acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(x), tv));
+      x += 8;
+      t += 4;
+    }
+    half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    _mm_store_ps(s, half);
+    re = s[0] + s[2];
+    im = s[1] + s[3];
+    for(k = 4 * groups; k < ntaps; k++) {
+      re += x[0] * t[0];
+      im += x[1] * t[0];
+      x += 2;
+      t++;
+    }
+
+    *result++ = lv_cmake(re, im);
+    schedule += 2;
+  }
+}
+#endif /* LV_HAVE_AVX */
+
+#endif /* INCLUDED_volk_32fc_32f_32u_gather_dot_prod_32fc_u_H */
@@ -0,0 +1,71 @@
+#ifndef INCLUDED_volk_32fc_costas_looppuppet_32fc_H
+#define INCLUDED_volk_32fc_costas_looppuppet_32fc_H
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <volk/volk_32fc_s32f_x2_costas_loop_32fc.h>
+
+/*
+ * Test puppet for volk_32fc_s32f_x2_costas_loop_32fc: runs six QPSK
+ * Costas loops, so that two channels take the scalar path of the SIMD
+ * versions, over the input as interleaved samples and writes the
+ * derotated samples.  The sine table is a plain linear interpolation
+ * in the layout of gr::fxpt.
+ */
+
+static const float volk_32fc_costas_looppuppet_32fc_gains[4] = {
+  0.0894f, 0.00422f, -1.0f, 1.0f
+};
+
+static inline void
+volk_32fc_costas_looppuppet_32fc_table(float* table)
+{
+  const double step = 3.14159265358979323846 / 1073741824.0;
+  double v0, s0, s1;
+  unsigned int i;
+
+  for(i = 0; i < 1024; i++) {
+    v0 = (double)i * 2097152.0;
+    s0 = sin(v0 * step);
+    s1 = sin((v0 + 2097152.0) * step);
+    table[2*i] = (float)((s1 - s0) / 2097152.0);
+    table[2*i+1] = (float)(s0 - (s1 - s0) / 2097152.0 * v0);
+  }
+}
+
+#define volk_32fc_costas_looppuppet_32fc_body(arch)                     \
+  const unsigned int nchan = 6;                                         \
+  const unsigned int n = num_points / nchan * nchan;                    \
+  float* table = (float*)malloc(2048*sizeof(float));                    \
+  float* freq_out = (float*)malloc((n + 1)*sizeof(float));              \
+  int32_t phase[6] = { 0, 0x10000000, -0x10000000, 0x40000000, 0x7fffffff, -0x7fffffff }; \
+  float freq[6] = { 0.0f, 0.01f, -0.01f, 0.1f, -0.1f, 0.0f };           \
+  unsigned int i;                                                       \
+  volk_32fc_costas_looppuppet_32fc_table(table);                        \
+  volk_32fc_s32f_x2_costas_loop_32fc_##arch(out, freq_out, in, phase, freq, table, volk_32fc_costas_looppuppet_32fc_gains, 4, nchan, n); \
+  for(i = n; i < num_points; i++)                                       \
+    out[i] = lv_cmake(0.0f, 0.0f);                                      \
+  free(freq_out);                                                       \
+  free(table)
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_32fc_costas_looppuppet_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_costas_looppuppet_32fc_body(generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_32fc_costas_looppuppet_32fc_sse2(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_costas_looppuppet_32fc_body(sse2);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#undef volk_32fc_costas_looppuppet_32fc_body
+
+#endif /* INCLUDED_volk_32fc_costas_looppuppet_32fc_H */
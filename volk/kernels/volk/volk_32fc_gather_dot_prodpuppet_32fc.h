@@ -0,0 +1,72 @@
+#ifndef INCLUDED_volk_32fc_gather_dot_prodpuppet_32fc_H
+#define INCLUDED_volk_32fc_gather_dot_prodpuppet_32fc_H
+
+#include <inttypes.h>
+#include <volk/volk_complex.h>
+#include <volk/volk_32fc_32f_32u_gather_dot_prod_32fc.h>
+
+/*
+ * Test puppet for volk_32fc_32f_32u_gather_dot_prod_32fc: a bank of
+ * 8 rows of 11 taps, so that the last taps of each row are left to
+ * the scalar tail, taken from the imaginary parts of the input.
+ * Output i filters the input at offset 5i/4 with row 3i mod 8,
+ * wrapped to stay inside the input, and is scheduled in batches of
+ * 64 outputs.
+ */
+
+#define VOLK_GATHER_PUPPET_NTAPS 11
+#define VOLK_GATHER_PUPPET_ROWS 8
+#define VOLK_GATHER_PUPPET_BATCH 64
+
+#define volk_32fc_gather_dot_prodpuppet_32fc_body(arch)                 \
+  float taps[VOLK_GATHER_PUPPET_ROWS * VOLK_GATHER_PUPPET_NTAPS];       \
+  uint32_t schedule[2 * VOLK_GATHER_PUPPET_BATCH];                      \
+  unsigned int i, j, n;                                                 \
+  if(num_points <= VOLK_GATHER_PUPPET_NTAPS) {                          \
+    for(i = 0; i < num_points; i++)                                     \
+      out[i] = lv_cmake(0.0f, 0.0f);                                    \
+    return;                                                             \
+  }                                                                     \
+  for(i = 0; i < VOLK_GATHER_PUPPET_ROWS * VOLK_GATHER_PUPPET_NTAPS; i++) \
+    taps[i] = lv_cimag(in[i % num_points]);                             \
+  for(i = 0; i < num_points; i += n) {                                  \
+    n = num_points - i < VOLK_GATHER_PUPPET_BATCH ? num_points - i : VOLK_GATHER_PUPPET_BATCH; \
+    for(j = 0; j < n; j++) {                                            \
+      schedule[2*j] = ((i + j) * 5 / 4) % (num_points - VOLK_GATHER_PUPPET_NTAPS + 1); \
+      schedule[2*j+1] = ((i + j) * 3 % VOLK_GATHER_PUPPET_ROWS) * VOLK_GATHER_PUPPET_NTAPS; \
+    }                                                                   \
+    volk_32fc_32f_32u_gather_dot_prod_32fc_##arch(out + i, in, taps, schedule, VOLK_GATHER_PUPPET_NTAPS, n); \
+  }
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_32fc_gather_dot_prodpuppet_32fc_generic(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_gather_dot_prodpuppet_32fc_body(generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE
+
+static inline void volk_32fc_gather_dot_prodpuppet_32fc_u_sse(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_gather_dot_prodpuppet_32fc_body(u_sse);
+}
+
+#endif /* LV_HAVE_SSE */
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_32fc_gather_dot_prodpuppet_32fc_u_avx(lv_32fc_t* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_gather_dot_prodpuppet_32fc_body(u_avx);
+}
+
+#endif /* LV_HAVE_AVX */
+
+#undef volk_32fc_gather_dot_prodpuppet_32fc_body
+#undef VOLK_GATHER_PUPPET_NTAPS
+#undef VOLK_GATHER_PUPPET_ROWS
+#undef VOLK_GATHER_PUPPET_BATCH
+
+#endif /* INCLUDED_volk_32fc_gather_dot_prodpuppet_32fc_H */
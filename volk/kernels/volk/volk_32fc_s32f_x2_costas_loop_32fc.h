@@ -0,0 +1,278 @@
+#ifndef INCLUDED_volk_32fc_s32f_x2_costas_loop_32fc_H
+#define INCLUDED_volk_32fc_s32f_x2_costas_loop_32fc_H
+
+/*
+ * Runs nchan independent second order carrier tracking loops over
+ * num_points/nchan time steps of interleaved input, in[t*nchan + c]
+ * being sample t of channel c.  For every channel and step:
+ *
+ *   y = x * exp(-j*phase)
+ *   e = detector(y)
+ *   f = freq + beta*e
+ *   phase += f + alpha*e
+ *   freq = min(max(f, min_freq), max_freq)
+ *
+ * as in gr::blocks::control_loop.  The detector is that of the Costas
+ * loop for order 2, 4 and 8, clipped to [-1, 1], and arg(y) for order
+ * 1, i.e. a PLL on an unmodulated carrier.  The phase is kept per
+ * channel as a 32-bit fixed point angle (2^31 is pi, so it wraps by
+ * itself) and sin/cos come from the 1024 segment table of gr::fxpt:
+ * table[2*i] is the slope and table[2*i+1] the offset of segment i,
+ * indexed by the top ten bits of the angle and applied to the angle
+ * shifted right once.  gains holds alpha, beta, min_freq and
+ * max_freq.  The state is updated in place and the clamped frequency
+ * of every step is written to freq_out.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <volk/volk_complex.h>
+
+static inline float
+volk_32fc_s32f_x2_costas_loop_32fc_sincos(const float* table, uint32_t ux)
+{
+  const unsigned int idx = ux >> 22;
+  return table[2*idx] * (float)(ux >> 1) + table[2*idx+1];
+}
+
+// atan2 with a degree 9 odd polynomial, within 1e-5 rad
+static inline float
+volk_32fc_s32f_x2_costas_loop_32fc_atan2(float y, float x)
+{
+  const float ax = fabsf(x), ay = fabsf(y);
+  const float mx = ax > ay ? ax : ay;
+  const float mn = ax > ay ? ay : ax;
+  const float z = mx > 0 ? mn / mx : 0;
+  const float z2 = z*z;
+  float r = z*(0.99997726f + z2*(-0.33262347f + z2*(0.19354346f + z2*(-0.11643287f + z2*0.05265332f))));
+
+  if(ay > ax)
+    r = 1.57079633f - r;
+  if(x < 0)
+    r = 3.14159265f - r;
+  return y < 0 ? -r : r;
+}
+
+static inline float
+volk_32fc_s32f_x2_costas_loop_32fc_detector(float re, float im, unsigned int order)
+{
+  const float K = 0.41421356f;
+  float e;
+
+  switch(order) {
+  case 1:
+    return volk_32fc_s32f_x2_costas_loop_32fc_atan2(im, re);
+  case 2:
+    e = re*im;
+    break;
+  case 4:
+    e = (re > 0 ? im : -im) - (im > 0 ? re : -re);
+    break;
+  default:
+    if(fabsf(re) >= fabsf(im))
+      e = (re > 0 ? im : -im) - (im > 0 ? re : -re)*K;
+    else
+      e = (re > 0 ? im : -im)*K - (im > 0 ? re : -re);
+    break;
+  }
+  return e > 1 ? 1 : (e < -1 ? -1 : e);
+}
+
+static inline void
+volk_32fc_s32f_x2_costas_loop_32fc_channel(lv_32fc_t* out, float* freq_out, const lv_32fc_t* in, int32_t* phase, float* freq, const float* table, const float* gains, unsigned int order, unsigned int nchan, unsigned int nsteps)
+{
+  const float scale = 2147483648.0f / 3.14159265f;
+  const float alpha = gains[0], beta = gains[1];
+  uint32_t ph = (uint32_t)*phase;
+  float fr = *freq, s, c, xr, xi, yr, yi, e, f, inc;
+  unsigned int t;
+
+  for(t = 0; t < nsteps; t++) {
+    s = volk_32fc_s32f_x2_costas_loop_32fc_sincos(table, ph);
+    c = volk_32fc_s32f_x2_costas_loop_32fc_sincos(table, ph + 0x40000000u);
+    xr = lv_creal(in[t*nchan]);
+    xi = lv_cimag(in[t*nchan]);
+    yr = xr*c + xi*s;
+    yi = xi*c - xr*s;
+    out[t*nchan] = lv_cmake(yr, yi);
+
+    e = volk_32fc_s32f_x2_costas_loop_32fc_detector(yr, yi, order);
+    f = fr + beta*e;
+    inc = f + alpha*e;
+    inc = inc > 3.14159f ? 3.14159f : (inc < -3.14159f ? -3.14159f : inc);
+    ph += (uint32_t)(int32_t)(inc*scale);
+    fr = f > gains[3] ? gains[3] : (f < gains[2] ? gains[2] : f);
+    freq_out[t*nchan] = fr;
+  }
+  *phase = (int32_t)ph;
+  *freq = fr;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Advances nchan independent Costas loops or PLLs over interleaved samples
+  \param out The derotated samples
+  \param freq_out The frequency of every loop after every step
+  \param in The input samples, nchan per step
+  \param phase The fixed point phase of every loop
+  \param freq The frequency of every loop in rad/sample
+  \param table The sine table of gr::fxpt
+  \param gains alpha, beta, min_freq and max_freq
+  \param order 1 (PLL), 2, 4 or 8
+  \param nchan The number of loops
+  \param num_points The number of samples, a multiple of nchan
+*/
+static inline void volk_32fc_s32f_x2_costas_loop_32fc_generic(lv_32fc_t* out, float* freq_out, const lv_32fc_t* in, int32_t* phase, float* freq, const float* table, const float* gains, unsigned int order, unsigned int nchan, unsigned int num_points){
+  const unsigned int nsteps = num_points / nchan;
+  unsigned int c;
+
+  for(c = 0; c < nchan; c++) {
+    volk_32fc_s32f_x2_costas_loop_32fc_channel(out + c, freq_out + c, in + c, phase + c, freq + c, table, gains, order, nchan, nsteps);
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+// Segment slopes (off 0) or offsets (off 1) of four table indices;
+// there is no gather
+#define volk_32fc_s32f_x2_costas_loop_32fc_gather(table, idx, off)      \
+  _mm_setr_ps((table)[2*_mm_cvtsi128_si32(idx) + (off)],                \
+              (table)[2*_mm_cvtsi128_si32(_mm_srli_si128(idx, 4)) + (off)], \
+              (table)[2*_mm_cvtsi128_si32(_mm_srli_si128(idx, 8)) + (off)], \
+              (table)[2*_mm_cvtsi128_si32(_mm_srli_si128(idx, 12)) + (off)])
+
+/*!
+  \brief Advances nchan independent Costas loops or PLLs over interleaved samples, four loops per register
+  \param out The derotated samples
+  \param freq_out The frequency of every loop after every step
+  \param in The input samples, nchan per step
+  \param phase The fixed point phase of every loop
+  \param freq The frequency of every loop in rad/sample
+  \param table The sine table of gr::fxpt
+  \param gains alpha, beta, min_freq and max_freq
+  \param order 1 (PLL), 2, 4 or 8
+  \param nchan The number of loops
+  \param num_points The number of samples, a multiple of nchan
+*/
+static inline void volk_32fc_s32f_x2_costas_loop_32fc_sse2(lv_32fc_t* out, float* freq_out, const lv_32fc_t* in, int32_t* phase, float* freq, const float* table, const float* gains, unsigned int order, unsigned int nchan, unsigned int num_points){
+  const unsigned int nsteps = num_points / nchan;
+  const unsigned int quarter_chan = nchan / 4;
+  const __m128 alpha = _mm_set1_ps(gains[0]);
+  const __m128 beta = _mm_set1_ps(gains[1]);
+  const __m128 min_freq = _mm_set1_ps(gains[2]);
+  const __m128 max_freq = _mm_set1_ps(gains[3]);
+  const __m128 scale = _mm_set1_ps(2147483648.0f / 3.14159265f);
+  const __m128 max_inc = _mm_set1_ps(3.14159f);
+  const __m128 min_inc = _mm_set1_ps(-3.14159f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 mone = _mm_set1_ps(-1.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 K = _mm_set1_ps(0.41421356f);
+  const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  const __m128i quarter_turn = _mm_set1_epi32(0x40000000);
+  __m128i ph, phc, idx;
+  __m128 fr, s, c, a, b, xr, xi, yr, yi, e, f, inc, sr, si, t1, t2;
+  unsigned int q, t;
+
+  for(q = 0; q < quarter_chan; q++) {
+    const lv_32fc_t* ip = in + 4*q;
+    lv_32fc_t* op = out + 4*q;
+    float* fp = freq_out + 4*q;
+
+    ph = _mm_loadu_si128((const __m128i*)(phase + 4*q));
+    fr = _mm_loadu_ps(freq + 4*q);
+
+    for(t = 0; t < nsteps; t++) {
+      // The angles shifted right once are below 2^31, so the signed
+      // conversion to float gives the same as the scalar version
+      idx = _mm_srli_epi32(ph, 22);
+      s = _mm_add_ps(_mm_mul_ps(volk_32fc_s32f_x2_costas_loop_32fc_gather(table, idx, 0),
+                                _mm_cvtepi32_ps(_mm_srli_epi32(ph, 1))),
+                     volk_32fc_s32f_x2_costas_loop_32fc_gather(table, idx, 1));
+      phc = _mm_add_epi32(ph, quarter_turn);
+      idx = _mm_srli_epi32(phc, 22);
+      c = _mm_add_ps(_mm_mul_ps(volk_32fc_s32f_x2_costas_loop_32fc_gather(table, idx, 0),
+                                _mm_cvtepi32_ps(_mm_srli_epi32(phc, 1))),
+                     volk_32fc_s32f_x2_costas_loop_32fc_gather(table, idx, 1));
+
+      a = _mm_loadu_ps((const float*)ip);
+      b = _mm_loadu_ps((const float*)(ip + 2));
+      xr = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+      xi = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+      yr = _mm_add_ps(_mm_mul_ps(xr, c), _mm_mul_ps(xi, s));
+      yi = _mm_sub_ps(_mm_mul_ps(xi, c), _mm_mul_ps(xr, s));
+      _mm_storeu_ps((float*)op, _mm_unpacklo_ps(yr, yi));
+      _mm_storeu_ps((float*)(op + 2), _mm_unpackhi_ps(yr, yi));
+
+      if(order == 1) {
+        // Same polynomial as the generic version
+        __m128 ax = _mm_and_ps(yr, abs_mask);
+        __m128 ay = _mm_and_ps(yi, abs_mask);
+        __m128 mx, mn, z, z2, r, swap;
+        mx = _mm_max_ps(ax, ay);
+        mn = _mm_min_ps(ax, ay);
+        z = _mm_and_ps(_mm_cmpgt_ps(mx, zero), _mm_div_ps(mn, _mm_max_ps(mx, _mm_set1_ps(1e-30f))));
+        z2 = _mm_mul_ps(z, z);
+        r = _mm_add_ps(_mm_set1_ps(-0.11643287f), _mm_mul_ps(z2, _mm_set1_ps(0.05265332f)));
+        r = _mm_add_ps(_mm_set1_ps(0.19354346f), _mm_mul_ps(z2, r));
+        r = _mm_add_ps(_mm_set1_ps(-0.33262347f), _mm_mul_ps(z2, r));
+        r = _mm_add_ps(_mm_set1_ps(0.99997726f), _mm_mul_ps(z2, r));
+        r = _mm_mul_ps(z, r);
+        swap = _mm_cmpgt_ps(ay, ax);
+        r = _mm_or_ps(_mm_and_ps(swap, _mm_sub_ps(_mm_set1_ps(1.57079633f), r)), _mm_andnot_ps(swap, r));
+        swap = _mm_cmplt_ps(yr, zero);
+        r = _mm_or_ps(_mm_and_ps(swap, _mm_sub_ps(_mm_set1_ps(3.14159265f), r)), _mm_andnot_ps(swap, r));
+        e = _mm_or_ps(r, _mm_and_ps(_mm_cmplt_ps(yi, zero), sign_mask));
+      }
+      else {
+        // x > 0 ? v : -v, as a sign flip of v where x <= 0
+        sr = _mm_andnot_ps(_mm_cmpgt_ps(yr, zero), sign_mask);
+        si = _mm_andnot_ps(_mm_cmpgt_ps(yi, zero), sign_mask);
+        if(order == 2) {
+          e = _mm_mul_ps(yr, yi);
+        }
+        else if(order == 4) {
+          e = _mm_sub_ps(_mm_xor_ps(yi, sr), _mm_xor_ps(yr, si));
+        }
+        else {
+          __m128 big = _mm_cmpge_ps(_mm_and_ps(yr, abs_mask), _mm_and_ps(yi, abs_mask));
+          t1 = _mm_sub_ps(_mm_xor_ps(yi, sr), _mm_mul_ps(_mm_xor_ps(yr, si), K));
+          t2 = _mm_sub_ps(_mm_mul_ps(_mm_xor_ps(yi, sr), K), _mm_xor_ps(yr, si));
+          e = _mm_or_ps(_mm_and_ps(big, t1), _mm_andnot_ps(big, t2));
+        }
+        e = _mm_min_ps(_mm_max_ps(e, mone), one);
+      }
+
+      f = _mm_add_ps(fr, _mm_mul_ps(beta, e));
+      inc = _mm_add_ps(f, _mm_mul_ps(alpha, e));
+      inc = _mm_min_ps(_mm_max_ps(inc, min_inc), max_inc);
+      ph = _mm_add_epi32(ph, _mm_cvttps_epi32(_mm_mul_ps(inc, scale)));
+      fr = _mm_min_ps(_mm_max_ps(f, min_freq), max_freq);
+      _mm_storeu_ps(fp, fr);
+
+      ip += nchan;
+      op += nchan;
+      fp += nchan;
+    }
+
+    _mm_storeu_si128((__m128i*)(phase + 4*q), ph);
+    _mm_storeu_ps(freq + 4*q, fr);
+  }
+
+  for(q = 4*quarter_chan; q < nchan; q++) {
+    volk_32fc_s32f_x2_costas_loop_32fc_channel(out + q, freq_out + q, in + q, phase + q, freq + q, table, gains, order, nchan, nsteps);
+  }
+}
+
+#undef volk_32fc_s32f_x2_costas_loop_32fc_gather
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_32fc_s32f_x2_costas_loop_32fc_H */
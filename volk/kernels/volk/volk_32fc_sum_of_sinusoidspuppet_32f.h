@@ -0,0 +1,61 @@
+#ifndef INCLUDED_volk_32fc_sum_of_sinusoidspuppet_32f_H
+#define INCLUDED_volk_32fc_sum_of_sinusoidspuppet_32f_H
+
+#include <math.h>
+#include <volk/volk_complex.h>
+#include <volk/volk_32fc_x2_sum_of_sinusoids_32f.h>
+
+/*
+ * Test puppet for volk_32fc_x2_sum_of_sinusoids_32f: seven sinusoids,
+ * so that one register is only partly used, with phasors taken from
+ * the first 7 inputs and rotators from the directions of the next 7.
+ * The samples are drawn in two calls to also check the state left
+ * between them.
+ */
+
+static inline lv_32fc_t
+volk_32fc_sum_of_sinusoidspuppet_32f_unit(lv_32fc_t x)
+{
+  float mag = sqrtf(lv_creal(x)*lv_creal(x) + lv_cimag(x)*lv_cimag(x));
+  return mag > 0 ? lv_cmake(lv_creal(x) / mag, lv_cimag(x) / mag) : lv_cmake(1.0f, 0.0f);
+}
+
+#define volk_32fc_sum_of_sinusoidspuppet_32f_body(arch)                 \
+  lv_32fc_t phasors[7], rotators[7];                                    \
+  unsigned int k;                                                       \
+  for(k = 0; k < 7; k++) {                                              \
+    phasors[k] = k < num_points ? in[k] : lv_cmake(1.0f, 0.0f);         \
+    rotators[k] = volk_32fc_sum_of_sinusoidspuppet_32f_unit(k + 7 < num_points ? in[k + 7] : lv_cmake(1.0f, 0.0f)); \
+  }                                                                     \
+  volk_32fc_x2_sum_of_sinusoids_32f_##arch(out, phasors, rotators, 7, num_points / 2); \
+  volk_32fc_x2_sum_of_sinusoids_32f_##arch(out + num_points / 2, phasors, rotators, 7, num_points - num_points / 2)
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_32fc_sum_of_sinusoidspuppet_32f_generic(float* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_sum_of_sinusoidspuppet_32f_body(generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_32fc_sum_of_sinusoidspuppet_32f_sse2(float* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_sum_of_sinusoidspuppet_32f_body(sse2);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX
+
+static inline void volk_32fc_sum_of_sinusoidspuppet_32f_avx(float* out, const lv_32fc_t* in, unsigned int num_points){
+  volk_32fc_sum_of_sinusoidspuppet_32f_body(avx);
+}
+
+#endif /* LV_HAVE_AVX */
+
+#undef volk_32fc_sum_of_sinusoidspuppet_32f_body
+
+#endif /* INCLUDED_volk_32fc_sum_of_sinusoidspuppet_32f_H */
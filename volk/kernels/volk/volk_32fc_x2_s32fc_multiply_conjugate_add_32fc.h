@@ -0,0 +1,235 @@
+#ifndef INCLUDED_volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_u_H
+#define INCLUDED_volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_u_H
+
+/*
+ * cVector[i] = aVector[i] + conj(bVector[i]) * scalar
+ *
+ * This is the tap update of an LMS type adaptive filter, w += conj(x) * mu * e,
+ * with cVector == aVector.  The two may be the same vector.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_complex.h>
+#include <float.h>
+
+#ifdef LV_HAVE_GENERIC
+/*!
+  \brief Adds the conjugate of vector b times a scalar to vector a
+  \param cVector The vector where the results will be stored
+  \param aVector The vector to be added to
+  \param bVector The vector that is conjugated and multiplied by the scalar
+  \param scalar The complex scalar to multiply the conjugate of bVector
+  \param num_points The number of complex values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_generic(lv_32fc_t* cVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const lv_32fc_t scalar, unsigned int num_points){
+  const float* a = (const float*)aVector;
+  const float* b = (const float*)bVector;
+  float* c = (float*)cVector;
+  const float sr = lv_creal(scalar);
+  const float si = lv_cimag(scalar);
+  float re, im;
+  unsigned int number;
+
+  for(number = 0; number < num_points; number++) {
+    re = b[0] * sr + b[1] * si;
+    im = b[0] * si - b[1] * sr;
+    c[0] = a[0] + re;
+    c[1] = a[1] + im;
+    a += 2;
+    b += 2;
+    c += 2;
+  }
+}
+#endif /* LV_HAVE_GENERIC */
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+/*!
+  \brief Adds the conjugate of vector b times a scalar to vector a
+  \param cVector The vector where the results will be stored
+  \param aVector The vector to be added to
+  \param bVector The vector that is conjugated and multiplied by the scalar
+  \param scalar The complex scalar to multiply the conjugate of bVector
+  \param num_points The number of complex values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_u_sse3(lv_32fc_t* cVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const lv_32fc_t scalar, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int halfPoints = num_points / 2;
+
+  __m128 x, y, sl, sh, tmp1, tmp2;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  const __m128 conjugator = _mm_setr_ps(0, -0.f, 0, -0.f);
+  sl = _mm_set_ps1(lv_creal(scalar));
+  sh = _mm_set_ps1(lv_cimag(scalar));
+
+  for(;number < halfPoints; number++){
+    x = _mm_loadu_ps((float*)a);
+    y = _mm_loadu_ps((float*)b);
+
+    y = _mm_xor_ps(y, conjugator); // br,-bi
+    tmp1 = _mm_mul_ps(y, sl); // br*sr,-bi*sr
+    y = _mm_shuffle_ps(y, y, 0xB1); // -bi,br
+    tmp2 = _mm_mul_ps(y, sh); // -bi*si,br*si
+    y = _mm_addsub_ps(tmp1, tmp2); // br*sr+bi*si,br*si-bi*sr
+
+    _mm_storeu_ps((float*)c, _mm_add_ps(x, y));
+
+    a += 2;
+    b += 2;
+    c += 2;
+  }
+
+  if((num_points % 2) != 0) {
+    volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_generic(c, a, b, scalar, 1);
+  }
+}
+#endif /* LV_HAVE_SSE3 */
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+/*!
+  \brief Adds the conjugate of vector b times a scalar to vector a, four points per step
+  \param cVector The vector where the results will be stored
+  \param aVector The vector to be added to
+  \param bVector The vector that is conjugated and multiplied by the scalar
+  \param scalar The complex scalar to multiply the conjugate of bVector
+  \param num_points The number of complex values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_u_avx(lv_32fc_t* cVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const lv_32fc_t scalar, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m256 x, y, sl, sh, tmp1, tmp2;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  const __m256 conjugator = _mm256_setr_ps(0, -0.f, 0, -0.f, 0, -0.f, 0, -0.f);
+  sl = _mm256_set1_ps(lv_creal(scalar));
+  sh = _mm256_set1_ps(lv_cimag(scalar));
+
+  for(;number < quarterPoints; number++){
+    x = _mm256_loadu_ps((float*)a);
+    y = _mm256_loadu_ps((float*)b);
+
+    y = _mm256_xor_ps(y, conjugator);
+    tmp1 = _mm256_mul_ps(y, sl);
+    y = _mm256_permute_ps(y, 0xB1);
+    tmp2 = _mm256_mul_ps(y, sh);
+    y = _mm256_addsub_ps(tmp1, tmp2);
+
+    _mm256_storeu_ps((float*)c, _mm256_add_ps(x, y));
+
+    a += 4;
+    b += 4;
+    c += 4;
+  }
+
+  volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_generic(c, a, b, scalar, num_points - 4*quarterPoints);
+}
+#endif /* LV_HAVE_AVX */
+
+#endif /* INCLUDED_volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_u_H */
+#ifndef INCLUDED_volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_a_H
+#define INCLUDED_volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_a_H
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <volk/volk_complex.h>
+#include <float.h>
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+/*!
+  \brief Adds the conjugate of vector b times a scalar to vector a
+  \param cVector The vector where the results will be stored
+  \param aVector The vector to be added to
+  \param bVector The vector that is conjugated and multiplied by the scalar
+  \param scalar The complex scalar to multiply the conjugate of bVector
+  \param num_points The number of complex values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_a_sse3(lv_32fc_t* cVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const lv_32fc_t scalar, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int halfPoints = num_points / 2;
+
+  __m128 x, y, sl, sh, tmp1, tmp2;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  const __m128 conjugator = _mm_setr_ps(0, -0.f, 0, -0.f);
+  sl = _mm_set_ps1(lv_creal(scalar));
+  sh = _mm_set_ps1(lv_cimag(scalar));
+
+  for(;number < halfPoints; number++){
+    x = _mm_load_ps((float*)a);
+    y = _mm_load_ps((float*)b);
+
+    y = _mm_xor_ps(y, conjugator); // br,-bi
+    tmp1 = _mm_mul_ps(y, sl); // br*sr,-bi*sr
+    y = _mm_shuffle_ps(y, y, 0xB1); // -bi,br
+    tmp2 = _mm_mul_ps(y, sh); // -bi*si,br*si
+    y = _mm_addsub_ps(tmp1, tmp2); // br*sr+bi*si,br*si-bi*sr
+
+    _mm_store_ps((float*)c, _mm_add_ps(x, y));
+
+    a += 2;
+    b += 2;
+    c += 2;
+  }
+
+  if((num_points % 2) != 0) {
+    volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_generic(c, a, b, scalar, 1);
+  }
+}
+#endif /* LV_HAVE_SSE3 */
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+/*!
+  \brief Adds the conjugate of vector b times a scalar to vector a, four points per step
+  \param cVector The vector where the results will be stored
+  \param aVector The vector to be added to
+  \param bVector The vector that is conjugated and multiplied by the scalar
+  \param scalar The complex scalar to multiply the conjugate of bVector
+  \param num_points The number of complex values in aVector and bVector
+*/
+static inline void volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_a_avx(lv_32fc_t* cVector, const lv_32fc_t* aVector, const lv_32fc_t* bVector, const lv_32fc_t scalar, unsigned int num_points){
+  unsigned int number = 0;
+  const unsigned int quarterPoints = num_points / 4;
+
+  __m256 x, y, sl, sh, tmp1, tmp2;
+  lv_32fc_t* c = cVector;
+  const lv_32fc_t* a = aVector;
+  const lv_32fc_t* b = bVector;
+
+  const __m256 conjugator = _mm256_setr_ps(0, -0.f, 0, -0.f, 0, -0.f, 0, -0.f);
+  sl = _mm256_set1_ps(lv_creal(scalar));
+  sh = _mm256_set1_ps(lv_cimag(scalar));
+
+  for(;number < quarterPoints; number++){
+    x = _mm256_load_ps((float*)a);
+    y = _mm256_load_ps((float*)b);
+
+    y = _mm256_xor_ps(y, conjugator);
+    tmp1 = _mm256_mul_ps(y, sl);
+    y = _mm256_permute_ps(y, 0xB1);
+    tmp2 = _mm256_mul_ps(y, sh);
+    y = _mm256_addsub_ps(tmp1, tmp2);
+
+    _mm256_store_ps((float*)c, _mm256_add_ps(x, y));
+
+    a += 4;
+    b += 4;
+    c += 4;
+  }
+
+  volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_generic(c, a, b, scalar, num_points - 4*quarterPoints);
+}
+#endif /* LV_HAVE_AVX */
+
+#endif /* INCLUDED_volk_32fc_x2_s32fc_multiply_conjugate_add_32fc_a_H */
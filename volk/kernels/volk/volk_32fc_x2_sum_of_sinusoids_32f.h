@@ -0,0 +1,287 @@
+#ifndef INCLUDED_volk_32fc_x2_sum_of_sinusoids_32f_H
+#define INCLUDED_volk_32fc_x2_sum_of_sinusoids_32f_H
+
+/*
+ * Sum of nsinusoids cosines, each given by a phasor p_k, whose
+ * magnitude is the amplitude, and a unit rotator r_k = exp(j w_k):
+ *
+ *   out[m] = sum_k Re(p_k r_k^m),  m = 0 .. num_points-1
+ *
+ * after which p_k is advanced to p_k r_k^num_points and renormalized
+ * to its starting magnitude.  The recursion steps four samples at a
+ * time with r^4, so that the cosines of four consecutive samples share
+ * one register, and the phasors are renormalized once per call.
+ */
+
+#include <inttypes.h>
+#include <float.h>
+#include <math.h>
+#include <volk/volk_complex.h>
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Sums sinusoids generated by phasor recursions
+  \param out The sum of the cosines
+  \param phasors The phasors at the first sample, advanced past the last one
+  \param rotators The rotation of each phasor per sample
+  \param nsinusoids The number of sinusoids
+  \param num_points The number of samples
+*/
+static inline void volk_32fc_x2_sum_of_sinusoids_32f_generic(float* out, lv_32fc_t* phasors, const lv_32fc_t* rotators, unsigned int nsinusoids, unsigned int num_points){
+  const unsigned int quarter_points = num_points / 4;
+  const unsigned int rem = num_points - 4*quarter_points;
+  float pr[4], pi[4], rr[4][4], ri[4][4], r4r[4], r4i[4], v[4];
+  float mag0[4], mag, t;
+  unsigned int k, q, j, l, nl;
+
+  for(j = 0; j < num_points; j++) {
+    out[j] = 0;
+  }
+
+  // Sinusoids are taken four at a time and summed in the same order as
+  // the SIMD versions
+  for(k = 0; k < nsinusoids; k += 4) {
+    nl = nsinusoids - k < 4 ? nsinusoids - k : 4;
+
+    for(l = 0; l < 4; l++) {
+      pr[l] = l < nl ? lv_creal(phasors[k + l]) : 0.0f;
+      pi[l] = l < nl ? lv_cimag(phasors[k + l]) : 0.0f;
+      mag0[l] = sqrtf(pr[l]*pr[l] + pi[l]*pi[l]);
+      rr[0][l] = 1.0f;
+      ri[0][l] = 0.0f;
+      rr[1][l] = l < nl ? lv_creal(rotators[k + l]) : 1.0f;
+      ri[1][l] = l < nl ? lv_cimag(rotators[k + l]) : 0.0f;
+      rr[2][l] = rr[1][l]*rr[1][l] - ri[1][l]*ri[1][l];
+      ri[2][l] = rr[1][l]*ri[1][l] + ri[1][l]*rr[1][l];
+      rr[3][l] = rr[2][l]*rr[1][l] - ri[2][l]*ri[1][l];
+      ri[3][l] = rr[2][l]*ri[1][l] + ri[2][l]*rr[1][l];
+      r4r[l] = rr[2][l]*rr[2][l] - ri[2][l]*ri[2][l];
+      r4i[l] = rr[2][l]*ri[2][l] + ri[2][l]*rr[2][l];
+    }
+
+    for(q = 0; q < quarter_points; q++) {
+      for(j = 0; j < 4; j++) {
+        for(l = 0; l < 4; l++) {
+          v[l] = j == 0 ? pr[l] : pr[l]*rr[j][l] - pi[l]*ri[j][l];
+        }
+        out[4*q + j] += (v[0] + v[1]) + (v[2] + v[3]);
+      }
+      for(l = 0; l < 4; l++) {
+        t = pr[l]*r4r[l] - pi[l]*r4i[l];
+        pi[l] = pr[l]*r4i[l] + pi[l]*r4r[l];
+        pr[l] = t;
+      }
+    }
+
+    if(rem > 0) {
+      for(j = 0; j < rem; j++) {
+        for(l = 0; l < 4; l++) {
+          v[l] = pr[l]*rr[j][l] - pi[l]*ri[j][l];
+        }
+        out[4*quarter_points + j] += (v[0] + v[1]) + (v[2] + v[3]);
+      }
+      for(l = 0; l < 4; l++) {
+        t = pr[l]*rr[rem][l] - pi[l]*ri[rem][l];
+        pi[l] = pr[l]*ri[rem][l] + pi[l]*rr[rem][l];
+        pr[l] = t;
+      }
+    }
+
+    for(l = 0; l < nl; l++) {
+      mag = sqrtf(pr[l]*pr[l] + pi[l]*pi[l]);
+      mag = mag0[l] / (mag > FLT_MIN ? mag : FLT_MIN);
+      phasors[k + l] = lv_cmake(pr[l] * mag, pi[l] * mag);
+    }
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+/*!
+  \brief Sums sinusoids generated by phasor recursions, four sinusoids per register
+  \param out The sum of the cosines
+  \param phasors The phasors at the first sample, advanced past the last one
+  \param rotators The rotation of each phasor per sample
+  \param nsinusoids The number of sinusoids
+  \param num_points The number of samples
+*/
+static inline void volk_32fc_x2_sum_of_sinusoids_32f_sse2(float* out, lv_32fc_t* phasors, const lv_32fc_t* rotators, unsigned int nsinusoids, unsigned int num_points){
+  const unsigned int quarter_points = num_points / 4;
+  const unsigned int rem = num_points - 4*quarter_points;
+  __m128 pr, pi, mag0, rr[4], ri[4], r4r, r4i, t0, t1, t2, t3, t;
+  float a[4], b[4], c[4], d[4];
+  unsigned int k, q, j, l, nl;
+
+  for(j = 0; j < num_points; j++) {
+    out[j] = 0;
+  }
+
+  for(k = 0; k < nsinusoids; k += 4) {
+    nl = nsinusoids - k < 4 ? nsinusoids - k : 4;
+
+    // Missing lanes are silent phasors
+    for(l = 0; l < 4; l++) {
+      a[l] = l < nl ? lv_creal(phasors[k + l]) : 0.0f;
+      b[l] = l < nl ? lv_cimag(phasors[k + l]) : 0.0f;
+      c[l] = l < nl ? lv_creal(rotators[k + l]) : 1.0f;
+      d[l] = l < nl ? lv_cimag(rotators[k + l]) : 0.0f;
+    }
+    pr = _mm_loadu_ps(a);
+    pi = _mm_loadu_ps(b);
+    mag0 = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(pr, pr), _mm_mul_ps(pi, pi)));
+    rr[0] = _mm_set1_ps(1.0f);
+    ri[0] = _mm_setzero_ps();
+    rr[1] = _mm_loadu_ps(c);
+    ri[1] = _mm_loadu_ps(d);
+    rr[2] = _mm_sub_ps(_mm_mul_ps(rr[1], rr[1]), _mm_mul_ps(ri[1], ri[1]));
+    ri[2] = _mm_add_ps(_mm_mul_ps(rr[1], ri[1]), _mm_mul_ps(ri[1], rr[1]));
+    rr[3] = _mm_sub_ps(_mm_mul_ps(rr[2], rr[1]), _mm_mul_ps(ri[2], ri[1]));
+    ri[3] = _mm_add_ps(_mm_mul_ps(rr[2], ri[1]), _mm_mul_ps(ri[2], rr[1]));
+    r4r = _mm_sub_ps(_mm_mul_ps(rr[2], rr[2]), _mm_mul_ps(ri[2], ri[2]));
+    r4i = _mm_add_ps(_mm_mul_ps(rr[2], ri[2]), _mm_mul_ps(ri[2], rr[2]));
+
+    for(q = 0; q < quarter_points; q++) {
+      // Cosines of four samples for every sinusoid, then summed over the
+      // sinusoids by transposing
+      t0 = pr;
+      t1 = _mm_sub_ps(_mm_mul_ps(pr, rr[1]), _mm_mul_ps(pi, ri[1]));
+      t2 = _mm_sub_ps(_mm_mul_ps(pr, rr[2]), _mm_mul_ps(pi, ri[2]));
+      t3 = _mm_sub_ps(_mm_mul_ps(pr, rr[3]), _mm_mul_ps(pi, ri[3]));
+      _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+      t0 = _mm_add_ps(_mm_add_ps(t0, t1), _mm_add_ps(t2, t3));
+      _mm_storeu_ps(out + 4*q, _mm_add_ps(_mm_loadu_ps(out + 4*q), t0));
+
+      t = _mm_sub_ps(_mm_mul_ps(pr, r4r), _mm_mul_ps(pi, r4i));
+      pi = _mm_add_ps(_mm_mul_ps(pr, r4i), _mm_mul_ps(pi, r4r));
+      pr = t;
+    }
+
+    if(rem > 0) {
+      for(j = 0; j < rem; j++) {
+        _mm_storeu_ps(a, _mm_sub_ps(_mm_mul_ps(pr, rr[j]), _mm_mul_ps(pi, ri[j])));
+        out[4*quarter_points + j] += (a[0] + a[1]) + (a[2] + a[3]);
+      }
+      t = _mm_sub_ps(_mm_mul_ps(pr, rr[rem]), _mm_mul_ps(pi, ri[rem]));
+      pi = _mm_add_ps(_mm_mul_ps(pr, ri[rem]), _mm_mul_ps(pi, rr[rem]));
+      pr = t;
+    }
+
+    t = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(pr, pr), _mm_mul_ps(pi, pi)));
+    t = _mm_div_ps(mag0, _mm_max_ps(t, _mm_set1_ps(FLT_MIN)));
+    _mm_storeu_ps(a, _mm_mul_ps(pr, t));
+    _mm_storeu_ps(b, _mm_mul_ps(pi, t));
+    for(l = 0; l < nl; l++) {
+      phasors[k + l] = lv_cmake(a[l], b[l]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX
+
+#include <immintrin.h>
+
+/*!
+  \brief Sums sinusoids generated by phasor recursions, two groups of four sinusoids per register
+  \param out The sum of the cosines
+  \param phasors The phasors at the first sample, advanced past the last one
+  \param rotators The rotation of each phasor per sample
+  \param nsinusoids The number of sinusoids
+  \param num_points The number of samples
+*/
+static inline void volk_32fc_x2_sum_of_sinusoids_32f_avx(float* out, lv_32fc_t* phasors, const lv_32fc_t* rotators, unsigned int nsinusoids, unsigned int num_points){
+  const unsigned int quarter_points = num_points / 4;
+  const unsigned int rem = num_points - 4*quarter_points;
+  __m256 pr, pi, mag0, rr[4], ri[4], r4r, r4i, t0, t1, t2, t3, u0, u1, u2, u3, t;
+  __m128 o;
+  float a[8], b[8], c[8], d[8];
+  unsigned int k, q, j, l, nl;
+
+  for(j = 0; j < num_points; j++) {
+    out[j] = 0;
+  }
+
+  // The low half of each register holds sinusoids k..k+3 and the high
+  // half k+4..k+7; the halves are added to the output in that order, as
+  // in the generic version
+  for(k = 0; k < nsinusoids; k += 8) {
+    nl = nsinusoids - k < 8 ? nsinusoids - k : 8;
+
+    for(l = 0; l < 8; l++) {
+      a[l] = l < nl ? lv_creal(phasors[k + l]) : 0.0f;
+      b[l] = l < nl ? lv_cimag(phasors[k + l]) : 0.0f;
+      c[l] = l < nl ? lv_creal(rotators[k + l]) : 1.0f;
+      d[l] = l < nl ? lv_cimag(rotators[k + l]) : 0.0f;
+    }
+    pr = _mm256_loadu_ps(a);
+    pi = _mm256_loadu_ps(b);
+    mag0 = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(pr, pr), _mm256_mul_ps(pi, pi)));
+    rr[0] = _mm256_set1_ps(1.0f);
+    ri[0] = _mm256_setzero_ps();
+    rr[1] = _mm256_loadu_ps(c);
+    ri[1] = _mm256_loadu_ps(d);
+    rr[2] = _mm256_sub_ps(_mm256_mul_ps(rr[1], rr[1]), _mm256_mul_ps(ri[1], ri[1]));
+    ri[2] = _mm256_add_ps(_mm256_mul_ps(rr[1], ri[1]), _mm256_mul_ps(ri[1], rr[1]));
+    rr[3] = _mm256_sub_ps(_mm256_mul_ps(rr[2], rr[1]), _mm256_mul_ps(ri[2], ri[1]));
+    ri[3] = _mm256_add_ps(_mm256_mul_ps(rr[2], ri[1]), _mm256_mul_ps(ri[2], rr[1]));
+    r4r = _mm256_sub_ps(_mm256_mul_ps(rr[2], rr[2]), _mm256_mul_ps(ri[2], ri[2]));
+    r4i = _mm256_add_ps(_mm256_mul_ps(rr[2], ri[2]), _mm256_mul_ps(ri[2], rr[2]));
+
+    for(q = 0; q < quarter_points; q++) {
+      t0 = pr;
+      t1 = _mm256_sub_ps(_mm256_mul_ps(pr, rr[1]), _mm256_mul_ps(pi, ri[1]));
+      t2 = _mm256_sub_ps(_mm256_mul_ps(pr, rr[2]), _mm256_mul_ps(pi, ri[2]));
+      t3 = _mm256_sub_ps(_mm256_mul_ps(pr, rr[3]), _mm256_mul_ps(pi, ri[3]));
+
+      // _MM_TRANSPOSE4_PS within each half
+      u0 = _mm256_unpacklo_ps(t0, t1);
+      u2 = _mm256_unpacklo_ps(t2, t3);
+      u1 = _mm256_unpackhi_ps(t0, t1);
+      u3 = _mm256_unpackhi_ps(t2, t3);
+      t0 = _mm256_shuffle_ps(u0, u2, _MM_SHUFFLE(1, 0, 1, 0));
+      t1 = _mm256_shuffle_ps(u0, u2, _MM_SHUFFLE(3, 2, 3, 2));
+      t2 = _mm256_shuffle_ps(u1, u3, _MM_SHUFFLE(1, 0, 1, 0));
+      t3 = _mm256_shuffle_ps(u1, u3, _MM_SHUFFLE(3, 2, 3, 2));
+      t0 = _mm256_add_ps(_mm256_add_ps(t0, t1), _mm256_add_ps(t2, t3));
+
+      o = _mm_add_ps(_mm_loadu_ps(out + 4*q), _mm256_castps256_ps128(t0));
+      o = _mm_add_ps(o, _mm256_extractf128_ps(t0, 1));
+      _mm_storeu_ps(out + 4*q, o);
+
+      t = _mm256_sub_ps(_mm256_mul_ps(pr, r4r), _mm256_mul_ps(pi, r4i));
+      pi = _mm256_add_ps(_mm256_mul_ps(pr, r4i), _mm256_mul_ps(pi, r4r));
+      pr = t;
+    }
+
+    if(rem > 0) {
+      for(j = 0; j < rem; j++) {
+        _mm256_storeu_ps(a, _mm256_sub_ps(_mm256_mul_ps(pr, rr[j]), _mm256_mul_ps(pi, ri[j])));
+        out[4*quarter_points + j] += (a[0] + a[1]) + (a[2] + a[3]);
+        out[4*quarter_points + j] += (a[4] + a[5]) + (a[6] + a[7]);
+      }
+      t = _mm256_sub_ps(_mm256_mul_ps(pr, rr[rem]), _mm256_mul_ps(pi, ri[rem]));
+      pi = _mm256_add_ps(_mm256_mul_ps(pr, ri[rem]), _mm256_mul_ps(pi, rr[rem]));
+      pr = t;
+    }
+
+    t = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(pr, pr), _mm256_mul_ps(pi, pi)));
+    t = _mm256_div_ps(mag0, _mm256_max_ps(t, _mm256_set1_ps(FLT_MIN)));
+    _mm256_storeu_ps(a, _mm256_mul_ps(pr, t));
+    _mm256_storeu_ps(b, _mm256_mul_ps(pi, t));
+    for(l = 0; l < nl; l++) {
+      phasors[k + l] = lv_cmake(a[l], b[l]);
+    }
+  }
+}
+
+#endif /* LV_HAVE_AVX */
+
+#endif /* INCLUDED_volk_32fc_x2_sum_of_sinusoids_32f_H */
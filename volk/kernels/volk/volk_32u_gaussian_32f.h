@@ -0,0 +1,266 @@
+#ifndef INCLUDED_volk_32u_gaussian_32f_H
+#define INCLUDED_volk_32u_gaussian_32f_H
+
+/*
+ * Normally distributed deviates with zero mean and variance 1 from four
+ * interleaved xoshiro128** generators.  The state holds 16 words laid
+ * out as s0[4] s1[4] s2[4] s3[4], one column per generator; a generator
+ * must not be all zero.
+ *
+ * Every round advances each generator twice and turns the two words
+ * into a pair of deviates with the Box-Muller transform:
+ *
+ *   r = sqrt(-2 ln u1), u1 = (31 bits of the first word + 0.5) / 2^31
+ *   out[8k + 2l] = r cos(2 pi u2), out[8k + 2l + 1] = r sin(2 pi u2)
+ *
+ * with u2 the top 24 bits of the second word of generator l.  The
+ * deviates are exact up to 6.6 sigma.  ln, sin and cos are the Cephes
+ * single precision polynomials, evaluated in the same order by all
+ * versions.  A round that is cut short by num_points is still consumed
+ * as a whole.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+static inline uint32_t
+volk_32u_gaussian_32f_next(uint32_t* state, unsigned int l)
+{
+  const uint32_t s1 = state[4 + l];
+  const uint32_t r = s1 * 5;
+  const uint32_t result = ((r << 7) | (r >> 25)) * 9;
+  const uint32_t t = s1 << 9;
+
+  state[8 + l] ^= state[l];
+  state[12 + l] ^= s1;
+  state[4 + l] ^= state[8 + l];
+  state[l] ^= state[12 + l];
+  state[8 + l] ^= t;
+  state[12 + l] = (state[12 + l] << 11) | (state[12 + l] >> 21);
+  return result;
+}
+
+static inline void
+volk_32u_gaussian_32f_pair(float* out, uint32_t k1, uint32_t k2)
+{
+  float u, m, z, y, c, s, r;
+  uint32_t bits, q;
+  int32_t e, res;
+
+  // Radius from the natural log of u1 in (0, 1]
+  u = ((float)(int32_t)(k1 >> 1) + 0.5f) * 4.656612873077392578125e-10f;
+  memcpy(&bits, &u, sizeof(bits));
+  e = (int32_t)(bits >> 23) - 126;
+  bits = (bits & 0x007fffff) | 0x3f000000;
+  memcpy(&m, &bits, sizeof(m));
+  if(m < 0.707106781186547524f) {
+    e = e - 1;
+    m = m + m - 1.0f;
+  }
+  else {
+    m = m - 1.0f;
+  }
+  z = m * m;
+  y = 7.0376836292e-2f;
+  y = y * m - 1.1514610310e-1f;
+  y = y * m + 1.1676998740e-1f;
+  y = y * m - 1.2420140846e-1f;
+  y = y * m + 1.4249322787e-1f;
+  y = y * m - 1.6668057665e-1f;
+  y = y * m + 2.0000714765e-1f;
+  y = y * m - 2.4999993993e-1f;
+  y = y * m + 3.3333331174e-1f;
+  y = y * m * z;
+  y = y + (float)e * -2.12194440e-4f;
+  y = y - 0.5f * z;
+  u = m + y;
+  u = u + (float)e * 0.693359375f;
+  r = sqrtf(-2.0f * u);
+
+  // Angle in [-pi/4, pi/4) and quadrant
+  k2 = (k2 >> 8) + 0x200000;
+  q = (k2 >> 22) & 3;
+  res = (int32_t)(k2 & 0x3fffff) - 0x200000;
+  u = (float)res * 3.745070282923984e-7f;
+  z = u * u;
+  s = -1.9515295891e-4f;
+  s = s * z + 8.3321608736e-3f;
+  s = s * z - 1.6666654611e-1f;
+  s = s * z * u + u;
+  c = 2.443315711809948e-5f;
+  c = c * z - 1.388731625493765e-3f;
+  c = c * z + 4.166664568298827e-2f;
+  c = c * z * z - 0.5f * z + 1.0f;
+
+  if(q & 1) {
+    y = c;
+    c = s;
+    s = y;
+  }
+  out[0] = ((q + 1) & 2) ? -r * c : r * c;
+  out[1] = (q & 2) ? -r * s : r * s;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Draws normally distributed deviates from four interleaved xoshiro128** generators
+  \param out The deviates
+  \param state The generator state, 16 words, updated in place
+  \param num_points The number of deviates
+*/
+static inline void volk_32u_gaussian_32f_generic(float* out, uint32_t* state, unsigned int num_points){
+  float tmp[8];
+  uint32_t k1[4];
+  unsigned int n, l;
+
+  for(n = 0; n < num_points; n += 8) {
+    float* o = num_points - n >= 8 ? out + n : tmp;
+    for(l = 0; l < 4; l++) {
+      k1[l] = volk_32u_gaussian_32f_next(state, l);
+    }
+    for(l = 0; l < 4; l++) {
+      volk_32u_gaussian_32f_pair(o + 2*l, k1[l], volk_32u_gaussian_32f_next(state, l));
+    }
+    if(o == tmp) {
+      for(l = 0; n + l < num_points; l++) {
+        out[n + l] = tmp[l];
+      }
+    }
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+#define volk_32u_gaussian_32f_rotl(x, k)                                \
+  _mm_or_si128(_mm_slli_epi32((x), (k)), _mm_srli_epi32((x), 32 - (k)))
+
+/*!
+  \brief Draws normally distributed deviates from four interleaved xoshiro128** generators, one per lane
+  \param out The deviates
+  \param state The generator state, 16 words, updated in place
+  \param num_points The number of deviates
+*/
+static inline void volk_32u_gaussian_32f_sse2(float* out, uint32_t* state, unsigned int num_points){
+  const __m128i mant_mask = _mm_set1_epi32(0x007fffff);
+  const __m128i half_bits = _mm_set1_epi32(0x3f000000);
+  const __m128i exp_bias = _mm_set1_epi32(126);
+  const __m128i ang_half = _mm_set1_epi32(0x200000);
+  const __m128i ang_mask = _mm_set1_epi32(0x3fffff);
+  const __m128i three = _mm_set1_epi32(3);
+  const __m128i one_i = _mm_set1_epi32(1);
+  const __m128i two_i = _mm_set1_epi32(2);
+  const __m128 sqrthf = _mm_set1_ps(0.707106781186547524f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  __m128i s0 = _mm_loadu_si128((const __m128i*)state);
+  __m128i s1 = _mm_loadu_si128((const __m128i*)(state + 4));
+  __m128i s2 = _mm_loadu_si128((const __m128i*)(state + 8));
+  __m128i s3 = _mm_loadu_si128((const __m128i*)(state + 12));
+  __m128i k1, k2, t, bits, e, lt, q, swap, sx, sy;
+  __m128 u, m, z, y, fe, r, c, s, x0, y0;
+  float tmp[8];
+  unsigned int n, l;
+
+  for(n = 0; n < num_points; n += 8) {
+    float* o = num_points - n >= 8 ? out + n : tmp;
+
+    // Two steps of every generator
+    t = _mm_add_epi32(_mm_slli_epi32(s1, 2), s1);
+    t = volk_32u_gaussian_32f_rotl(t, 7);
+    k1 = _mm_add_epi32(_mm_slli_epi32(t, 3), t);
+    t = _mm_slli_epi32(s1, 9);
+    s2 = _mm_xor_si128(s2, s0);
+    s3 = _mm_xor_si128(s3, s1);
+    s1 = _mm_xor_si128(s1, s2);
+    s0 = _mm_xor_si128(s0, s3);
+    s2 = _mm_xor_si128(s2, t);
+    s3 = volk_32u_gaussian_32f_rotl(s3, 11);
+
+    t = _mm_add_epi32(_mm_slli_epi32(s1, 2), s1);
+    t = volk_32u_gaussian_32f_rotl(t, 7);
+    k2 = _mm_add_epi32(_mm_slli_epi32(t, 3), t);
+    t = _mm_slli_epi32(s1, 9);
+    s2 = _mm_xor_si128(s2, s0);
+    s3 = _mm_xor_si128(s3, s1);
+    s1 = _mm_xor_si128(s1, s2);
+    s0 = _mm_xor_si128(s0, s3);
+    s2 = _mm_xor_si128(s2, t);
+    s3 = volk_32u_gaussian_32f_rotl(s3, 11);
+
+    // Radius
+    u = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(_mm_srli_epi32(k1, 1)), half),
+                   _mm_set1_ps(4.656612873077392578125e-10f));
+    bits = _mm_castps_si128(u);
+    e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), exp_bias);
+    m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mant_mask), half_bits));
+    lt = _mm_castps_si128(_mm_cmplt_ps(m, sqrthf));
+    e = _mm_add_epi32(e, lt);
+    m = _mm_sub_ps(_mm_add_ps(m, _mm_and_ps(m, _mm_castsi128_ps(lt))), one);
+    z = _mm_mul_ps(m, m);
+    y = _mm_set1_ps(7.0376836292e-2f);
+    y = _mm_sub_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1514610310e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1676998740e-1f));
+    y = _mm_sub_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.2420140846e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.4249322787e-1f));
+    y = _mm_sub_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.6668057665e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.0000714765e-1f));
+    y = _mm_sub_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.4999993993e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(3.3333331174e-1f));
+    y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+    fe = _mm_cvtepi32_ps(e);
+    y = _mm_add_ps(y, _mm_mul_ps(fe, _mm_set1_ps(-2.12194440e-4f)));
+    y = _mm_sub_ps(y, _mm_mul_ps(half, z));
+    u = _mm_add_ps(m, y);
+    u = _mm_add_ps(u, _mm_mul_ps(fe, _mm_set1_ps(0.693359375f)));
+    r = _mm_sqrt_ps(_mm_mul_ps(_mm_set1_ps(-2.0f), u));
+
+    // Angle
+    k2 = _mm_add_epi32(_mm_srli_epi32(k2, 8), ang_half);
+    q = _mm_and_si128(_mm_srli_epi32(k2, 22), three);
+    u = _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(k2, ang_mask), ang_half)),
+                   _mm_set1_ps(3.745070282923984e-7f));
+    z = _mm_mul_ps(u, u);
+    s = _mm_set1_ps(-1.9515295891e-4f);
+    s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(8.3321608736e-3f));
+    s = _mm_sub_ps(_mm_mul_ps(s, z), _mm_set1_ps(1.6666654611e-1f));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), u), u);
+    c = _mm_set1_ps(2.443315711809948e-5f);
+    c = _mm_sub_ps(_mm_mul_ps(c, z), _mm_set1_ps(1.388731625493765e-3f));
+    c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(4.166664568298827e-2f));
+    c = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_mul_ps(half, z)), one);
+
+    swap = _mm_cmpeq_epi32(_mm_and_si128(q, one_i), one_i);
+    sx = _mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one_i), two_i), 30);
+    sy = _mm_slli_epi32(_mm_and_si128(q, two_i), 30);
+    x0 = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(swap), s), _mm_andnot_ps(_mm_castsi128_ps(swap), c));
+    y0 = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(swap), c), _mm_andnot_ps(_mm_castsi128_ps(swap), s));
+    x0 = _mm_xor_ps(_mm_mul_ps(r, x0), _mm_castsi128_ps(sx));
+    y0 = _mm_xor_ps(_mm_mul_ps(r, y0), _mm_castsi128_ps(sy));
+
+    _mm_storeu_ps(o, _mm_unpacklo_ps(x0, y0));
+    _mm_storeu_ps(o + 4, _mm_unpackhi_ps(x0, y0));
+    if(o == tmp) {
+      for(l = 0; n + l < num_points; l++) {
+        out[n + l] = tmp[l];
+      }
+    }
+  }
+
+  _mm_storeu_si128((__m128i*)state, s0);
+  _mm_storeu_si128((__m128i*)(state + 4), s1);
+  _mm_storeu_si128((__m128i*)(state + 8), s2);
+  _mm_storeu_si128((__m128i*)(state + 12), s3);
+}
+
+#undef volk_32u_gaussian_32f_rotl
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_32u_gaussian_32f_H */
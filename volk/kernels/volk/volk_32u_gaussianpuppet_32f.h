@@ -0,0 +1,41 @@
+#ifndef INCLUDED_volk_32u_gaussianpuppet_32f_H
+#define INCLUDED_volk_32u_gaussianpuppet_32f_H
+
+#include <inttypes.h>
+#include <volk/volk_32u_gaussian_32f.h>
+
+/*
+ * Test puppet for volk_32u_gaussian_32f: the generators are seeded
+ * from the first 16 input words, the first word of each generator
+ * forced odd so that none is all zero, and num_points deviates are
+ * drawn in two calls to also cover a round cut short mid stream.
+ */
+
+#define volk_32u_gaussianpuppet_32f_body(arch)                          \
+  uint32_t state[16];                                                   \
+  unsigned int i;                                                       \
+  for(i = 0; i < 16; i++)                                               \
+    state[i] = (i < num_points ? in[i] : 0) | (i < 4 ? 1 : 0);          \
+  volk_32u_gaussian_32f_##arch(out, state, num_points / 2);             \
+  volk_32u_gaussian_32f_##arch(out + num_points / 2, state, num_points - num_points / 2)
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_32u_gaussianpuppet_32f_generic(float* out, const uint32_t* in, unsigned int num_points){
+  volk_32u_gaussianpuppet_32f_body(generic);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_32u_gaussianpuppet_32f_sse2(float* out, const uint32_t* in, unsigned int num_points){
+  volk_32u_gaussianpuppet_32f_body(sse2);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#undef volk_32u_gaussianpuppet_32f_body
+
+#endif /* INCLUDED_volk_32u_gaussianpuppet_32f_H */
@@ -0,0 +1,86 @@
+#ifndef INCLUDED_volk_8u_conv_k7_r2puppet_8u_H
+#define INCLUDED_volk_8u_conv_k7_r2puppet_8u_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <volk/volk_8u_x4_conv_k7_r2_8u.h>
+
+/*
+ * Test puppet for volk_8u_x4_conv_k7_r2_8u: decodes num_points/2 bits out
+ * of num_points soft symbols and writes them unpacked, one per byte, so
+ * every implementation can be checked bit-exact against the generic one.
+ */
+
+static inline void
+volk_8u_conv_k7_r2puppet_8u_chainback(unsigned char* data, const unsigned char* dec,
+                                      const unsigned char* metrics, unsigned int nbits)
+{
+  unsigned int state = 0, i;
+
+  for(i = 1; i < 64; i++) {
+    if(metrics[i] < metrics[state])
+      state = i;
+  }
+  while(nbits-- != 0) {
+    data[nbits] = state & 1;
+    state = (state >> 1) | (((dec[8*nbits + (state >> 3)] >> (state & 7)) & 1) << 5);
+  }
+}
+
+static inline void
+volk_8u_conv_k7_r2puppet_8u_branchtab(unsigned char* Branchtab)
+{
+  const unsigned int polys[2] = {0x6d, 0x4f};
+  unsigned int i, j, p;
+
+  for(i = 0; i < 32; i++) {
+    for(j = 0; j < 2; j++) {
+      p = (2*i) & polys[j];
+      p ^= p >> 4;
+      p ^= p >> 2;
+      p ^= p >> 1;
+      Branchtab[32*j + i] = (p & 1) ? 255 : 0;
+    }
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_8u_conv_k7_r2puppet_8u_generic(unsigned char* dec, const unsigned char* syms, unsigned int num_points){
+  unsigned int framebits = num_points / 2;
+  unsigned char X[64], Y[64], Branchtab[64];
+  unsigned char* decisions = (unsigned char*)malloc(8*framebits + 8);
+
+  memset(X, 63, 64);
+  X[0] = 0;
+  volk_8u_conv_k7_r2puppet_8u_branchtab(Branchtab);
+  volk_8u_x4_conv_k7_r2_8u_generic(Y, X, syms, decisions, framebits, Branchtab);
+
+  memset(dec, 0, num_points);
+  volk_8u_conv_k7_r2puppet_8u_chainback(dec, decisions, X, framebits);
+  free(decisions);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+static inline void volk_8u_conv_k7_r2puppet_8u_sse2(unsigned char* dec, const unsigned char* syms, unsigned int num_points){
+  unsigned int framebits = num_points / 2;
+  unsigned char X[64], Y[64], Branchtab[64];
+  unsigned char* decisions = (unsigned char*)malloc(8*framebits + 8);
+
+  memset(X, 63, 64);
+  X[0] = 0;
+  volk_8u_conv_k7_r2puppet_8u_branchtab(Branchtab);
+  volk_8u_x4_conv_k7_r2_8u_sse2(Y, X, syms, decisions, framebits, Branchtab);
+
+  memset(dec, 0, num_points);
+  volk_8u_conv_k7_r2puppet_8u_chainback(dec, decisions, X, framebits);
+  free(decisions);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_8u_conv_k7_r2puppet_8u_H */
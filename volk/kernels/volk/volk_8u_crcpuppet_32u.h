@@ -0,0 +1,122 @@
+#ifndef INCLUDED_volk_8u_crcpuppet_32u_H
+#define INCLUDED_volk_8u_crcpuppet_32u_H
+
+#include <volk/volk_8u_x2_crc_32u.h>
+#include <string.h>
+
+/*
+ * Test puppet for volk_8u_x2_crc_32u: out[0] is the CRC-32 register
+ * (reflected), out[1] the CRC-32/BZIP2 register and out[2] the
+ * CRC-16/CCITT register (normal, in the upper 16 bits) after all
+ * num_points bytes.
+ */
+
+static inline uint64_t
+volk_8u_crcpuppet_32u_xpow(unsigned int k, unsigned int width, uint64_t poly)
+{
+  uint64_t r = 1;
+  for(; k > 0; k--) {
+    r <<= 1;
+    if((r >> width) & 1)
+      r ^= poly;
+  }
+  return r;
+}
+
+static inline uint64_t
+volk_8u_crcpuppet_32u_rev64(uint64_t v)
+{
+  uint64_t r = 0;
+  unsigned int i;
+  for(i = 0; i < 64; i++)
+    r |= ((v >> i) & 1) << (63 - i);
+  return r;
+}
+
+static inline void
+volk_8u_crcpuppet_32u_tables(unsigned int* tables, unsigned int width,
+                             unsigned int poly, int reflected)
+{
+  unsigned int* t = tables + VOLK_CRC_TABLE_OFFSET;
+  uint64_t k[4];
+  unsigned int n, b, c, rpoly = 0;
+
+  memset(tables, 0, VOLK_CRC_TABLE_OFFSET*sizeof(unsigned int));
+  tables[0] = reflected;
+
+  if(reflected) {
+    const uint64_t full = ((uint64_t)1 << width) | poly;
+    for(b = 0; b < width; b++)
+      rpoly |= ((poly >> b) & 1) << (width - 1 - b);
+    for(n = 0; n < 256; n++) {
+      for(c = n, b = 0; b < 8; b++)
+        c = (c & 1) ? (c >> 1) ^ rpoly : c >> 1;
+      t[n] = c;
+    }
+    k[0] = volk_8u_crcpuppet_32u_rev64(volk_8u_crcpuppet_32u_xpow(575, width, full));
+    k[1] = volk_8u_crcpuppet_32u_rev64(volk_8u_crcpuppet_32u_xpow(511, width, full));
+    k[2] = volk_8u_crcpuppet_32u_rev64(volk_8u_crcpuppet_32u_xpow(191, width, full));
+    k[3] = volk_8u_crcpuppet_32u_rev64(volk_8u_crcpuppet_32u_xpow(127, width, full));
+  }
+  else {
+    const unsigned int p = poly << (32 - width);
+    const uint64_t full = ((uint64_t)1 << 32) | p;
+    for(n = 0; n < 256; n++) {
+      for(c = n << 24, b = 0; b < 8; b++)
+        c = (c & 0x80000000) ? (c << 1) ^ p : c << 1;
+      t[n] = c;
+    }
+    k[0] = volk_8u_crcpuppet_32u_xpow(512, 32, full);
+    k[1] = volk_8u_crcpuppet_32u_xpow(576, 32, full);
+    k[2] = volk_8u_crcpuppet_32u_xpow(128, 32, full);
+    k[3] = volk_8u_crcpuppet_32u_xpow(192, 32, full);
+  }
+  for(n = 0; n < 4; n++) {
+    tables[2 + 2*n] = (unsigned int)k[n];
+    tables[3 + 2*n] = (unsigned int)(k[n] >> 32);
+  }
+
+  for(n = 256; n < 8*256; n++) {
+    c = t[n - 256];
+    t[n] = reflected ? (c >> 8) ^ t[c & 0xff] : (c << 8) ^ t[c >> 24];
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_8u_crcpuppet_32u_generic(unsigned int* out, const unsigned char* in, unsigned int num_points){
+  unsigned int tables[VOLK_CRC_TABLE_OFFSET + 8*256];
+
+  memset(out, 0, num_points*sizeof(unsigned int));
+  out[0] = out[1] = 0xffffffff;
+  out[2] = 0xffff0000;
+  volk_8u_crcpuppet_32u_tables(tables, 32, 0x04c11db7, 1);
+  volk_8u_x2_crc_32u_generic(out, in, tables, num_points);
+  volk_8u_crcpuppet_32u_tables(tables, 32, 0x04c11db7, 0);
+  volk_8u_x2_crc_32u_generic(out + 1, in, tables, num_points);
+  volk_8u_crcpuppet_32u_tables(tables, 16, 0x1021, 0);
+  volk_8u_x2_crc_32u_generic(out + 2, in, tables, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#if LV_HAVE_SSSE3 && LV_HAVE_PCLMUL
+
+static inline void volk_8u_crcpuppet_32u_pclmul(unsigned int* out, const unsigned char* in, unsigned int num_points){
+  unsigned int tables[VOLK_CRC_TABLE_OFFSET + 8*256];
+
+  memset(out, 0, num_points*sizeof(unsigned int));
+  out[0] = out[1] = 0xffffffff;
+  out[2] = 0xffff0000;
+  volk_8u_crcpuppet_32u_tables(tables, 32, 0x04c11db7, 1);
+  volk_8u_x2_crc_32u_pclmul(out, in, tables, num_points);
+  volk_8u_crcpuppet_32u_tables(tables, 32, 0x04c11db7, 0);
+  volk_8u_x2_crc_32u_pclmul(out + 1, in, tables, num_points);
+  volk_8u_crcpuppet_32u_tables(tables, 16, 0x1021, 0);
+  volk_8u_x2_crc_32u_pclmul(out + 2, in, tables, num_points);
+}
+
+#endif /* LV_HAVE_SSSE3 && LV_HAVE_PCLMUL */
+
+#endif /* INCLUDED_volk_8u_crcpuppet_32u_H */
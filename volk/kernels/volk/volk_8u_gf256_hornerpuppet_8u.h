@@ -0,0 +1,85 @@
+#ifndef INCLUDED_volk_8u_gf256_hornerpuppet_8u_H
+#define INCLUDED_volk_8u_gf256_hornerpuppet_8u_H
+
+#include <volk/volk_8u_x2_gf256_horner_8u.h>
+
+/*
+ * Test puppet for volk_8u_x2_gf256_horner_8u: computes the 20 syndromes
+ * of consecutive shortened (207,187) ATSC codewords in the input.
+ */
+
+#define VOLK_HORNERPUPPET_NN 207
+#define VOLK_HORNERPUPPET_NROOTS 20
+
+static inline unsigned char
+volk_8u_gf256_hornerpuppet_8u_mul(unsigned char a, unsigned char b)
+{
+  unsigned int p = 0, x = a;
+  for(; b; b >>= 1) {
+    if(b & 1)
+      p ^= x;
+    x <<= 1;
+    if(x & 0x100)
+      x ^= 0x11d;
+  }
+  return (unsigned char)p;
+}
+
+static inline void
+volk_8u_gf256_hornerpuppet_8u_tables(unsigned char* tables)
+{
+  unsigned int i, k, n;
+  unsigned char root = 1;
+
+  for(i = 0; i < VOLK_HORNERPUPPET_NROOTS; i++) {
+    // x^16, x^8, x^4, x^2, x for root alpha^i
+    unsigned char powers[5];
+    powers[4] = root;
+    for(k = 4; k > 0; k--)
+      powers[k-1] = volk_8u_gf256_hornerpuppet_8u_mul(powers[k], powers[k]);
+    for(k = 0; k < 5; k++) {
+      for(n = 0; n < 16; n++) {
+        tables[160*i + 32*k + n] = volk_8u_gf256_hornerpuppet_8u_mul(powers[k], n);
+        tables[160*i + 32*k + 16 + n] = volk_8u_gf256_hornerpuppet_8u_mul(powers[k], n << 4);
+      }
+    }
+    root = volk_8u_gf256_hornerpuppet_8u_mul(root, 2);
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_8u_gf256_hornerpuppet_8u_generic(unsigned char* out, const unsigned char* in, unsigned int num_points){
+  unsigned char tables[160*VOLK_HORNERPUPPET_NROOTS];
+  unsigned int c;
+
+  volk_8u_gf256_hornerpuppet_8u_tables(tables);
+  for(c = 0; c < num_points; c++)
+    out[c] = 0;
+  for(c = 0; c < num_points / VOLK_HORNERPUPPET_NN; c++) {
+    volk_8u_x2_gf256_horner_8u_generic(out + VOLK_HORNERPUPPET_NROOTS*c, in + VOLK_HORNERPUPPET_NN*c,
+                                       tables, VOLK_HORNERPUPPET_NROOTS, VOLK_HORNERPUPPET_NN);
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void volk_8u_gf256_hornerpuppet_8u_ssse3(unsigned char* out, const unsigned char* in, unsigned int num_points){
+  unsigned char tables[160*VOLK_HORNERPUPPET_NROOTS];
+  unsigned int c;
+
+  volk_8u_gf256_hornerpuppet_8u_tables(tables);
+  for(c = 0; c < num_points; c++)
+    out[c] = 0;
+  for(c = 0; c < num_points / VOLK_HORNERPUPPET_NN; c++) {
+    volk_8u_x2_gf256_horner_8u_ssse3(out + VOLK_HORNERPUPPET_NROOTS*c, in + VOLK_HORNERPUPPET_NN*c,
+                                     tables, VOLK_HORNERPUPPET_NROOTS, VOLK_HORNERPUPPET_NN);
+  }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#endif /* INCLUDED_volk_8u_gf256_hornerpuppet_8u_H */
@@ -0,0 +1,66 @@
+#ifndef INCLUDED_volk_8u_gf256_lincombpuppet_8u_H
+#define INCLUDED_volk_8u_gf256_lincombpuppet_8u_H
+
+#include <volk/volk_8u_x2_gf256_lincomb_8u.h>
+
+/*
+ * Test puppet for volk_8u_x2_gf256_lincomb_8u: combines the input, split
+ * into 8 rows, with fixed constants.
+ */
+
+#define VOLK_LINCOMBPUPPET_NROWS 8
+
+static inline void
+volk_8u_gf256_lincombpuppet_8u_tables(unsigned char* tables)
+{
+  unsigned int r, n, b;
+
+  for(r = 0; r < VOLK_LINCOMBPUPPET_NROWS; r++) {
+    unsigned int c = (37*r + 5) & 0xff;
+    for(n = 0; n < 32; n++) {
+      unsigned int v = n < 16 ? n : (n - 16) << 4;
+      unsigned int p = 0, x = c;
+      for(b = v; b; b >>= 1) {
+        if(b & 1)
+          p ^= x;
+        x <<= 1;
+        if(x & 0x100)
+          x ^= 0x11d;
+      }
+      tables[32*r + n] = (unsigned char)p;
+    }
+  }
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_8u_gf256_lincombpuppet_8u_generic(unsigned char* out, const unsigned char* in, unsigned int num_points){
+  unsigned char tables[32*VOLK_LINCOMBPUPPET_NROWS];
+  unsigned int k;
+
+  volk_8u_gf256_lincombpuppet_8u_tables(tables);
+  for(k = 0; k < num_points; k++)
+    out[k] = 0;
+  volk_8u_x2_gf256_lincomb_8u_generic(out, in, tables, VOLK_LINCOMBPUPPET_NROWS,
+                                      num_points / VOLK_LINCOMBPUPPET_NROWS);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void volk_8u_gf256_lincombpuppet_8u_ssse3(unsigned char* out, const unsigned char* in, unsigned int num_points){
+  unsigned char tables[32*VOLK_LINCOMBPUPPET_NROWS];
+  unsigned int k;
+
+  volk_8u_gf256_lincombpuppet_8u_tables(tables);
+  for(k = 0; k < num_points; k++)
+    out[k] = 0;
+  volk_8u_x2_gf256_lincomb_8u_ssse3(out, in, tables, VOLK_LINCOMBPUPPET_NROWS,
+                                    num_points / VOLK_LINCOMBPUPPET_NROWS);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#endif /* INCLUDED_volk_8u_gf256_lincombpuppet_8u_H */
@@ -0,0 +1,71 @@
+#ifndef INCLUDED_volk_8u_hammingpuppet_8u_H
+#define INCLUDED_volk_8u_hammingpuppet_8u_H
+
+#include <volk/volk_8u_x2_hamming_8u.h>
+
+/*
+ * Test puppet for volk_8u_x2_hamming_8u: distances of the input to a
+ * fixed 100 bit pattern, for num_points/8 - 14 window positions.  The
+ * rest of the output is zeroed.
+ */
+
+#define VOLK_HAMMINGPUPPET_BITS 100
+#define VOLK_HAMMINGPUPPET_NBYTES ((VOLK_HAMMINGPUPPET_BITS + 7) / 8 + 1)
+
+static inline void
+volk_8u_hammingpuppet_8u_tables(unsigned char* tables)
+{
+  const unsigned int nbytes = VOLK_HAMMINGPUPPET_NBYTES;
+  unsigned int o, b;
+
+  for(b = 0; b < 16*nbytes; b++)
+    tables[b] = 0;
+  // The pattern ends just before bit o of the last byte
+  for(o = 0; o < 8; o++) {
+    for(b = 0; b < VOLK_HAMMINGPUPPET_BITS; b++) {
+      unsigned int pos = 8*(nbytes - 1) + o - VOLK_HAMMINGPUPPET_BITS + b;
+      unsigned char bit = 0x80 >> (pos % 8);
+      tables[2*nbytes*o + nbytes + pos/8] |= bit;
+      if((b * 37 + 11) % 7 < 3)
+        tables[2*nbytes*o + pos/8] |= bit;
+    }
+  }
+}
+
+static inline unsigned int
+volk_8u_hammingpuppet_8u_setup(unsigned char* out, unsigned char* tables, unsigned int num_points)
+{
+  unsigned int k;
+
+  volk_8u_hammingpuppet_8u_tables(tables);
+  for(k = 0; k < num_points; k++)
+    out[k] = 0;
+  if(num_points / 8 <= VOLK_HAMMINGPUPPET_NBYTES)
+    return 0;
+  return num_points / 8 - VOLK_HAMMINGPUPPET_NBYTES;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_8u_hammingpuppet_8u_generic(unsigned char* out, const unsigned char* in, unsigned int num_points){
+  unsigned char tables[16*VOLK_HAMMINGPUPPET_NBYTES];
+  unsigned int n = volk_8u_hammingpuppet_8u_setup(out, tables, num_points);
+
+  volk_8u_x2_hamming_8u_generic(out, in, tables, VOLK_HAMMINGPUPPET_NBYTES, n);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+static inline void volk_8u_hammingpuppet_8u_ssse3(unsigned char* out, const unsigned char* in, unsigned int num_points){
+  unsigned char tables[16*VOLK_HAMMINGPUPPET_NBYTES];
+  unsigned int n = volk_8u_hammingpuppet_8u_setup(out, tables, num_points);
+
+  volk_8u_x2_hamming_8u_ssse3(out, in, tables, VOLK_HAMMINGPUPPET_NBYTES, n);
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#endif /* INCLUDED_volk_8u_hammingpuppet_8u_H */
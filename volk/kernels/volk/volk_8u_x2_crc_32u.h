@@ -0,0 +1,156 @@
+#ifndef INCLUDED_volk_8u_x2_crc_32u_H
+#define INCLUDED_volk_8u_x2_crc_32u_H
+
+/*
+ * Runs a table driven CRC register of up to 32 bits over num_points bytes.
+ *
+ * The tables array describes the CRC (see gr::digital::crc_engine):
+ *   tables[0]       1 for a reflected (LSB first) register, 0 for a
+ *                   normal register shifted up to bit 31
+ *   tables[2..5]    constants to fold by 64 bytes
+ *   tables[6..9]    constants to fold by 16 bytes
+ *   tables[16..]    eight 256 entry tables for slicing-by-8
+ *
+ * Each pair of folding constants is a low and a high 64 bit word, low
+ * 32 bits first.  For a normal register they are x^512 and x^576, resp.
+ * x^128 and x^192, mod P (P shifted up to degree 32).  For a reflected
+ * register they are x^575 and x^511, resp. x^191 and x^127, mod P, bit
+ * reversed in 64 bits.
+ */
+
+#include <inttypes.h>
+
+#define VOLK_CRC_TABLE_OFFSET 16
+
+static inline unsigned int
+volk_8u_x2_crc_32u_slice8(unsigned int crc, const unsigned char* in,
+                          const unsigned int* tables, unsigned int num_points)
+{
+  const unsigned int* t = tables + VOLK_CRC_TABLE_OFFSET;
+
+  if(tables[0]) {
+    for(; num_points >= 8; num_points -= 8, in += 8) {
+      crc ^= in[0] | (in[1] << 8) | (in[2] << 16) | ((unsigned int)in[3] << 24);
+      crc = t[7*256 + (crc & 0xff)] ^ t[6*256 + ((crc >> 8) & 0xff)] ^
+            t[5*256 + ((crc >> 16) & 0xff)] ^ t[4*256 + (crc >> 24)] ^
+            t[3*256 + in[4]] ^ t[2*256 + in[5]] ^ t[256 + in[6]] ^ t[in[7]];
+    }
+    for(; num_points > 0; num_points--, in++) {
+      crc = t[(crc ^ *in) & 0xff] ^ (crc >> 8);
+    }
+  }
+  else {
+    for(; num_points >= 8; num_points -= 8, in += 8) {
+      crc ^= ((unsigned int)in[0] << 24) | (in[1] << 16) | (in[2] << 8) | in[3];
+      crc = t[7*256 + (crc >> 24)] ^ t[6*256 + ((crc >> 16) & 0xff)] ^
+            t[5*256 + ((crc >> 8) & 0xff)] ^ t[4*256 + (crc & 0xff)] ^
+            t[3*256 + in[4]] ^ t[2*256 + in[5]] ^ t[256 + in[6]] ^ t[in[7]];
+    }
+    for(; num_points > 0; num_points--, in++) {
+      crc = t[(crc >> 24) ^ *in] ^ (crc << 8);
+    }
+  }
+  return crc;
+}
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Updates a CRC register with num_points bytes, eight bytes per step
+  \param crc The CRC register, updated in place
+  \param in The bytes to process
+  \param tables The CRC description and tables
+  \param num_points The number of bytes
+*/
+static inline void volk_8u_x2_crc_32u_generic(unsigned int* crc, const unsigned char* in, const unsigned int* tables, unsigned int num_points){
+  *crc = volk_8u_x2_crc_32u_slice8(*crc, in, tables, num_points);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#if LV_HAVE_SSSE3 && LV_HAVE_PCLMUL
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+/*!
+  \brief Updates a CRC register with num_points bytes by carry-less folding
+  \param crc The CRC register, updated in place
+  \param in The bytes to process
+  \param tables The CRC description and tables
+  \param num_points The number of bytes
+
+  The message is folded 64 and then 16 bytes at a time into a 16 byte
+  remainder with the same CRC, which is finished with the tables.
+*/
+static inline void volk_8u_x2_crc_32u_pclmul(unsigned int* crc, const unsigned char* in, const unsigned int* tables, unsigned int num_points){
+  const int reflected = tables[0];
+  const __m128i k64 = _mm_loadu_si128((const __m128i*)(tables + 2));
+  const __m128i k16 = _mm_loadu_si128((const __m128i*)(tables + 6));
+  // Normal registers see the message as a big endian 128 bit polynomial
+  const __m128i swap = reflected ? _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+                                 : _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  unsigned char rem[16];
+  __m128i acc0, acc1, acc2, acc3;
+  unsigned int nblocks;
+
+  if(num_points < 32) {
+    *crc = volk_8u_x2_crc_32u_slice8(*crc, in, tables, num_points);
+    return;
+  }
+
+  nblocks = num_points / 16;
+
+  // The register adds onto the first bytes of the message
+  acc0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), swap);
+  acc0 = _mm_xor_si128(acc0, reflected ? _mm_cvtsi32_si128(*crc) : _mm_set_epi32(*crc, 0, 0, 0));
+  in += 16;
+  nblocks--;
+
+  if(nblocks >= 7) {
+    acc1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), swap);
+    acc2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + 16)), swap);
+    acc3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + 32)), swap);
+    in += 48;
+    nblocks -= 3;
+
+    for(; nblocks >= 4; nblocks -= 4, in += 64) {
+      acc0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc0, k64, 0x00),
+                                         _mm_clmulepi64_si128(acc0, k64, 0x11)),
+                           _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), swap));
+      acc1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc1, k64, 0x00),
+                                         _mm_clmulepi64_si128(acc1, k64, 0x11)),
+                           _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + 16)), swap));
+      acc2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc2, k64, 0x00),
+                                         _mm_clmulepi64_si128(acc2, k64, 0x11)),
+                           _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + 32)), swap));
+      acc3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc3, k64, 0x00),
+                                         _mm_clmulepi64_si128(acc3, k64, 0x11)),
+                           _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + 48)), swap));
+    }
+
+    // Combine the four lanes into one
+    acc0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc0, k16, 0x00),
+                                       _mm_clmulepi64_si128(acc0, k16, 0x11)), acc1);
+    acc0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc0, k16, 0x00),
+                                       _mm_clmulepi64_si128(acc0, k16, 0x11)), acc2);
+    acc0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc0, k16, 0x00),
+                                       _mm_clmulepi64_si128(acc0, k16, 0x11)), acc3);
+  }
+
+  for(; nblocks > 0; nblocks--, in += 16) {
+    acc0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(acc0, k16, 0x00),
+                                       _mm_clmulepi64_si128(acc0, k16, 0x11)),
+                         _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)in), swap));
+  }
+
+  _mm_storeu_si128((__m128i*)rem, _mm_shuffle_epi8(acc0, swap));
+  *crc = volk_8u_x2_crc_32u_slice8(0, rem, tables, 16);
+  *crc = volk_8u_x2_crc_32u_slice8(*crc, in, tables, num_points % 16);
+}
+
+#endif /* LV_HAVE_SSSE3 && LV_HAVE_PCLMUL */
+
+#endif /* INCLUDED_volk_8u_x2_crc_32u_H */
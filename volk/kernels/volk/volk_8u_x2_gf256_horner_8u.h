@@ -0,0 +1,109 @@
+#ifndef INCLUDED_volk_8u_x2_gf256_horner_8u_H
+#define INCLUDED_volk_8u_x2_gf256_horner_8u_H
+
+/*
+ * Evaluates a polynomial over GF(2^8) at several points, as used for
+ * Reed-Solomon syndromes: out[i] = sum_p in[p] * x_i^(num_points-1-p),
+ * i.e. in[0] is the highest order coefficient.
+ *
+ * Multiplications use split tables: for a constant c, 32 bytes holding
+ * c*n for n = 0..15 followed by c*(n<<4) for n = 0..15, so that
+ * c*v = lo[v & 15] ^ hi[v >> 4].  Each point takes five split tables,
+ * 160 bytes, for x^16, x^8, x^4, x^2 and x in that order.
+ */
+
+#include <inttypes.h>
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Evaluates a GF(2^8) polynomial at npoints points
+  \param out The npoints results
+  \param in The polynomial coefficients, highest order first
+  \param tables Five split tables per point for x^16, x^8, x^4, x^2 and x
+  \param npoints The number of points to evaluate
+  \param num_points The number of coefficients
+*/
+static inline void volk_8u_x2_gf256_horner_8u_generic(unsigned char* out, const unsigned char* in, const unsigned char* tables, unsigned int npoints, unsigned int num_points){
+  unsigned int i, p;
+
+  for(i = 0; i < npoints; i++) {
+    const unsigned char* x = tables + 160*i + 128;
+    unsigned char s = 0;
+    for(p = 0; p < num_points; p++) {
+      s = x[s & 15] ^ x[16 + (s >> 4)] ^ in[p];
+    }
+    out[i] = s;
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <string.h>
+
+/*!
+  \brief Evaluates a GF(2^8) polynomial at npoints points, 16 coefficients per step
+  \param out The npoints results
+  \param in The polynomial coefficients, highest order first
+  \param tables Five split tables per point for x^16, x^8, x^4, x^2 and x
+  \param npoints The number of points to evaluate
+  \param num_points The number of coefficients
+*/
+static inline void volk_8u_x2_gf256_horner_8u_ssse3(unsigned char* out, const unsigned char* in, const unsigned char* tables, unsigned int npoints, unsigned int num_points){
+  const __m128i low_mask = _mm_set1_epi8(0x0f);
+  // Gather the even lanes, resp. the odd lanes, into the lower half
+  const __m128i even_lanes = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14,
+                                           -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i odd_lanes = _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15,
+                                          -1, -1, -1, -1, -1, -1, -1, -1);
+  const unsigned int head = num_points % 16;
+  const unsigned int nblocks = num_points / 16;
+  unsigned char first[16];
+  __m128i head_block, acc, lo, hi, prod;
+  unsigned int i, b, k;
+
+  // Leading zero coefficients do not change the value, so the partial
+  // block is padded at the front.
+  memset(first, 0, sizeof(first));
+  memcpy(first + 16 - head, in, head);
+  head_block = _mm_loadu_si128((const __m128i*)first);
+
+  for(i = 0; i < npoints; i++) {
+    const __m128i* t = (const __m128i*)(tables + 160*i);
+    const __m128i t16_lo = _mm_loadu_si128(t);
+    const __m128i t16_hi = _mm_loadu_si128(t + 1);
+    const unsigned char* p = in + head;
+
+    // Lane L accumulates the coefficients with weight x^(15-L)
+    acc = head_block;
+    for(b = 0; b < nblocks; b++) {
+      lo = _mm_and_si128(acc, low_mask);
+      hi = _mm_and_si128(_mm_srli_epi16(acc, 4), low_mask);
+      prod = _mm_xor_si128(_mm_shuffle_epi8(t16_lo, lo), _mm_shuffle_epi8(t16_hi, hi));
+      acc = _mm_xor_si128(prod, _mm_loadu_si128((const __m128i*)p));
+      p += 16;
+    }
+
+    // Fold pairs of lanes with x, x^2, x^4 and x^8 until one lane is left
+    for(k = 4; k > 0; k--) {
+      const __m128i tk_lo = _mm_loadu_si128(t + 2*k);
+      const __m128i tk_hi = _mm_loadu_si128(t + 2*k + 1);
+      lo = _mm_and_si128(acc, low_mask);
+      hi = _mm_and_si128(_mm_srli_epi16(acc, 4), low_mask);
+      prod = _mm_xor_si128(_mm_shuffle_epi8(tk_lo, lo), _mm_shuffle_epi8(tk_hi, hi));
+      acc = _mm_xor_si128(_mm_shuffle_epi8(prod, even_lanes),
+                          _mm_shuffle_epi8(acc, odd_lanes));
+    }
+
+    out[i] = (unsigned char)(_mm_cvtsi128_si32(acc) & 0xff);
+  }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#endif /* INCLUDED_volk_8u_x2_gf256_horner_8u_H */
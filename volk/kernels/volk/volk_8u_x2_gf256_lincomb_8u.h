@@ -0,0 +1,89 @@
+#ifndef INCLUDED_volk_8u_x2_gf256_lincomb_8u_H
+#define INCLUDED_volk_8u_x2_gf256_lincomb_8u_H
+
+/*
+ * Linear combination of rows over GF(2^8):
+ * out[k] = sum_r c_r * in[r*num_points + k].
+ *
+ * Each constant c_r is given as a 32 byte split table holding c_r*n for
+ * n = 0..15 followed by c_r*(n<<4) for n = 0..15, so that
+ * c_r*v = lo[v & 15] ^ hi[v >> 4].  Evaluating a polynomial at many
+ * points at once (e.g. a Chien search) is a combination of the rows of
+ * precomputed powers with the polynomial coefficients as constants.
+ */
+
+#include <inttypes.h>
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Computes a linear combination of nrows rows over GF(2^8)
+  \param out The num_points results
+  \param in nrows rows of num_points elements
+  \param tables One split table per row
+  \param nrows The number of rows
+  \param num_points The number of elements per row
+*/
+static inline void volk_8u_x2_gf256_lincomb_8u_generic(unsigned char* out, const unsigned char* in, const unsigned char* tables, unsigned int nrows, unsigned int num_points){
+  unsigned int r, k;
+
+  for(k = 0; k < num_points; k++) {
+    out[k] = 0;
+  }
+  for(r = 0; r < nrows; r++) {
+    const unsigned char* t = tables + 32*r;
+    const unsigned char* row = in + r*num_points;
+    for(k = 0; k < num_points; k++) {
+      out[k] ^= t[row[k] & 15] ^ t[16 + (row[k] >> 4)];
+    }
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+/*!
+  \brief Computes a linear combination of nrows rows over GF(2^8), 16 elements per step
+  \param out The num_points results
+  \param in nrows rows of num_points elements
+  \param tables One split table per row
+  \param nrows The number of rows
+  \param num_points The number of elements per row
+*/
+static inline void volk_8u_x2_gf256_lincomb_8u_ssse3(unsigned char* out, const unsigned char* in, const unsigned char* tables, unsigned int nrows, unsigned int num_points){
+  const __m128i low_mask = _mm_set1_epi8(0x0f);
+  const unsigned int sixteenth_points = num_points / 16;
+  __m128i acc, v, lo, hi;
+  unsigned int r, k;
+
+  for(k = 0; k < sixteenth_points; k++) {
+    acc = _mm_setzero_si128();
+    for(r = 0; r < nrows; r++) {
+      const __m128i* t = (const __m128i*)(tables + 32*r);
+      v = _mm_loadu_si128((const __m128i*)(in + r*num_points + 16*k));
+      lo = _mm_and_si128(v, low_mask);
+      hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+      acc = _mm_xor_si128(acc, _mm_shuffle_epi8(_mm_loadu_si128(t), lo));
+      acc = _mm_xor_si128(acc, _mm_shuffle_epi8(_mm_loadu_si128(t + 1), hi));
+    }
+    _mm_storeu_si128((__m128i*)(out + 16*k), acc);
+  }
+
+  for(k = 16*sixteenth_points; k < num_points; k++) {
+    out[k] = 0;
+    for(r = 0; r < nrows; r++) {
+      const unsigned char* t = tables + 32*r;
+      unsigned char e = in[r*num_points + k];
+      out[k] ^= t[e & 15] ^ t[16 + (e >> 4)];
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#endif /* INCLUDED_volk_8u_x2_gf256_lincomb_8u_H */
@@ -0,0 +1,107 @@
+#ifndef INCLUDED_volk_8u_x2_hamming_8u_H
+#define INCLUDED_volk_8u_x2_hamming_8u_H
+
+/*
+ * Hamming distance between a bit pattern and a packed bit stream at all
+ * eight bit offsets of each byte, as used to search for access codes.
+ *
+ * The pattern is given once per offset as nbytes code bytes followed by
+ * nbytes mask bytes, 16*nbytes bytes in all.  For offset o and byte j
+ *
+ *   dist[o*num_points + j] = sum_k popcount((in[j+k] ^ code_o[k]) & mask_o[k])
+ *
+ * over k = 0..nbytes-1, saturated to 255.  in must hold
+ * num_points + nbytes - 1 bytes.  Where the pattern sits in the nbytes
+ * window for each offset is up to the caller (see
+ * gr::digital::access_code_correlator).
+ */
+
+#include <inttypes.h>
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Computes the distance to a bit pattern at eight bit offsets per byte
+  \param dist Eight planes of num_points distances, one per offset
+  \param in The packed bits, num_points + nbytes - 1 bytes
+  \param tables Code and mask bytes for each offset
+  \param nbytes The number of bytes in the window
+  \param num_points The number of window positions
+*/
+static inline void volk_8u_x2_hamming_8u_generic(unsigned char* dist, const unsigned char* in, const unsigned char* tables, unsigned int nbytes, unsigned int num_points){
+  unsigned int o, j, k;
+
+  for(o = 0; o < 8; o++) {
+    const unsigned char* code = tables + 2*nbytes*o;
+    const unsigned char* mask = code + nbytes;
+    for(j = 0; j < num_points; j++) {
+      unsigned int d = 0;
+      for(k = 0; k < nbytes; k++) {
+        unsigned int x = (in[j+k] ^ code[k]) & mask[k];
+        x = (x & 0x55) + ((x >> 1) & 0x55);
+        x = (x & 0x33) + ((x >> 2) & 0x33);
+        d += (x & 0x0f) + (x >> 4);
+      }
+      dist[o*num_points + j] = d > 255 ? 255 : d;
+    }
+  }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSSE3
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+/*!
+  \brief Computes the distance to a bit pattern at eight bit offsets per byte, 16 bytes per step
+  \param dist Eight planes of num_points distances, one per offset
+  \param in The packed bits, num_points + nbytes - 1 bytes
+  \param tables Code and mask bytes for each offset
+  \param nbytes The number of bytes in the window
+  \param num_points The number of window positions
+*/
+static inline void volk_8u_x2_hamming_8u_ssse3(unsigned char* dist, const unsigned char* in, const unsigned char* tables, unsigned int nbytes, unsigned int num_points){
+  const __m128i low_mask = _mm_set1_epi8(0x0f);
+  // Bit count of each nibble
+  const __m128i nibble_pop = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                           1, 2, 2, 3, 2, 3, 3, 4);
+  const unsigned int sixteenth_points = num_points / 16;
+  __m128i acc, x;
+  unsigned int o, j, k;
+
+  for(o = 0; o < 8; o++) {
+    const unsigned char* code = tables + 2*nbytes*o;
+    const unsigned char* mask = code + nbytes;
+
+    for(j = 0; j < sixteenth_points; j++) {
+      const unsigned char* p = in + 16*j;
+      acc = _mm_setzero_si128();
+      for(k = 0; k < nbytes; k++) {
+        x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(p + k)), _mm_set1_epi8(code[k]));
+        x = _mm_and_si128(x, _mm_set1_epi8(mask[k]));
+        x = _mm_add_epi8(_mm_shuffle_epi8(nibble_pop, _mm_and_si128(x, low_mask)),
+                         _mm_shuffle_epi8(nibble_pop, _mm_and_si128(_mm_srli_epi16(x, 4), low_mask)));
+        acc = _mm_adds_epu8(acc, x);
+      }
+      _mm_storeu_si128((__m128i*)(dist + o*num_points + 16*j), acc);
+    }
+
+    for(j = 16*sixteenth_points; j < num_points; j++) {
+      unsigned int d = 0;
+      for(k = 0; k < nbytes; k++) {
+        unsigned int v = (in[j+k] ^ code[k]) & mask[k];
+        v = (v & 0x55) + ((v >> 1) & 0x55);
+        v = (v & 0x33) + ((v >> 2) & 0x33);
+        d += (v & 0x0f) + (v >> 4);
+      }
+      dist[o*num_points + j] = d > 255 ? 255 : d;
+    }
+  }
+}
+
+#endif /* LV_HAVE_SSSE3 */
+
+#endif /* INCLUDED_volk_8u_x2_hamming_8u_H */
@@ -0,0 +1,205 @@
+#ifndef INCLUDED_volk_8u_x4_conv_k7_r2_8u_H
+#define INCLUDED_volk_8u_x4_conv_k7_r2_8u_H
+
+/*
+ * Add-compare-select for the 64 state, K=7 rate 1/2 convolutional code.
+ *
+ * Path metrics are unsigned 8-bit distances (smaller is better) and are
+ * renormalized after every decoded bit so that the best state is always
+ * 0.  The per-bit branch metric is the rounded average of the two symbol
+ * distances scaled down to [0,31], so the spread between any two states
+ * stays well below 255 and the saturating adds never clip a survivor.
+ *
+ * Trellis convention: the encoder shifts the new bit into the LSB of its
+ * register, so new states 2i and 2i+1 are reached from old states i and
+ * i+32.  The decision bit for a state is 1 when the survivor came from
+ * the upper predecessor (i+32), i.e. it is the MSB of the previous state.
+ * Decisions are packed one bit per state, 8 bytes per decoded bit; bit
+ * (s & 7) of byte (s >> 3) belongs to state s.
+ *
+ * Branchtab holds the expected symbols for the 32 butterflies, 0 or 255:
+ * Branchtab[i] for the first polynomial and Branchtab[32+i] for the
+ * second, evaluated on encoder register 2*i.  Both code polynomials must
+ * have their first and last taps set.
+ *
+ * Y is scratch space for the new metrics; the final metrics are always
+ * left in X.  Both hold 64 bytes.  syms holds 2*framebits soft symbols in
+ * offset binary (0 is a strong 0, 255 a strong 1, 128 an erasure).
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#ifdef LV_HAVE_GENERIC
+
+/*!
+  \brief Advances the K=7 rate 1/2 trellis by framebits bits
+  \param Y Scratch buffer for 64 path metrics
+  \param X The 64 path metrics; updated in place
+  \param syms 2*framebits soft symbols in offset binary
+  \param dec Packed decision bits, 8 bytes per decoded bit
+  \param framebits The number of bits to decode
+  \param Branchtab Expected symbols for the 32 butterflies of both polynomials
+*/
+static inline void volk_8u_x4_conv_k7_r2_8u_generic(unsigned char* Y, unsigned char* X, const unsigned char* syms, unsigned char* dec, unsigned int framebits, const unsigned char* Branchtab){
+  unsigned char *old_metrics = X, *new_metrics = Y, *tmp;
+  unsigned int s, i;
+
+  for(s = 0; s < framebits; s++) {
+    unsigned char sym0 = syms[2*s];
+    unsigned char sym1 = syms[2*s+1];
+    unsigned char *d = dec + 8*s;
+    unsigned char min_metric = 255;
+
+    memset(d, 0, 8);
+    for(i = 0; i < 32; i++) {
+      unsigned int metric = ((Branchtab[i] ^ sym0) + (Branchtab[32+i] ^ sym1) + 1) >> 4;
+      unsigned int m_metric = 31 - metric;
+      unsigned int m0, m1, decision;
+
+      // Saturate like the SIMD adds so all implementations are bit-exact
+      m0 = old_metrics[i] + metric;
+      m1 = old_metrics[i+32] + m_metric;
+      m0 = m0 > 255 ? 255 : m0;
+      m1 = m1 > 255 ? 255 : m1;
+      decision = m1 < m0;
+      new_metrics[2*i] = decision ? m1 : m0;
+      d[(2*i) >> 3] |= decision << ((2*i) & 7);
+
+      m0 = old_metrics[i] + m_metric;
+      m1 = old_metrics[i+32] + metric;
+      m0 = m0 > 255 ? 255 : m0;
+      m1 = m1 > 255 ? 255 : m1;
+      decision = m1 < m0;
+      new_metrics[2*i+1] = decision ? m1 : m0;
+      d[(2*i+1) >> 3] |= decision << ((2*i+1) & 7);
+    }
+
+    // Renormalize so the best state has metric 0
+    for(i = 0; i < 64; i++) {
+      if(new_metrics[i] < min_metric)
+        min_metric = new_metrics[i];
+    }
+    for(i = 0; i < 64; i++) {
+      new_metrics[i] -= min_metric;
+    }
+
+    tmp = old_metrics;
+    old_metrics = new_metrics;
+    new_metrics = tmp;
+  }
+
+  if(old_metrics != X)
+    memcpy(X, old_metrics, 64);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+
+#include <emmintrin.h>
+
+/*!
+  \brief Advances the K=7 rate 1/2 trellis by framebits bits, 16 butterflies per instruction
+  \param Y Scratch buffer for 64 path metrics
+  \param X The 64 path metrics; updated in place
+  \param syms 2*framebits soft symbols in offset binary
+  \param dec Packed decision bits, 8 bytes per decoded bit
+  \param framebits The number of bits to decode
+  \param Branchtab Expected symbols for the 32 butterflies of both polynomials
+*/
+static inline void volk_8u_x4_conv_k7_r2_8u_sse2(unsigned char* Y, unsigned char* X, const unsigned char* syms, unsigned char* dec, unsigned int framebits, const unsigned char* Branchtab){
+  const __m128i max_metric = _mm_set1_epi8(31);
+  const __m128i bt0_lo = _mm_loadu_si128((const __m128i*)Branchtab);
+  const __m128i bt0_hi = _mm_loadu_si128((const __m128i*)(Branchtab+16));
+  const __m128i bt1_lo = _mm_loadu_si128((const __m128i*)(Branchtab+32));
+  const __m128i bt1_hi = _mm_loadu_si128((const __m128i*)(Branchtab+48));
+
+  __m128i m_lo0 = _mm_loadu_si128((const __m128i*)X);
+  __m128i m_lo1 = _mm_loadu_si128((const __m128i*)(X+16));
+  __m128i m_hi0 = _mm_loadu_si128((const __m128i*)(X+32));
+  __m128i m_hi1 = _mm_loadu_si128((const __m128i*)(X+48));
+
+  __m128i sym0, sym1, metric, m_metric, m0, m1;
+  __m128i even, odd, keep_even, keep_odd, n0, n1, n2, n3, min_metric;
+  unsigned int s, keep0, keep1, keep2, keep3;
+
+  (void)Y; // the metrics are kept in registers between bits
+
+  for(s = 0; s < framebits; s++) {
+    unsigned char *d = dec + 8*s;
+
+    sym0 = _mm_set1_epi8(syms[2*s]);
+    sym1 = _mm_set1_epi8(syms[2*s+1]);
+
+    // Butterflies 0..15 produce states 0..31
+    metric = _mm_avg_epu8(_mm_xor_si128(bt0_lo, sym0), _mm_xor_si128(bt1_lo, sym1));
+    metric = _mm_and_si128(_mm_srli_epi16(metric, 3), max_metric);
+    m_metric = _mm_sub_epi8(max_metric, metric);
+
+    m0 = _mm_adds_epu8(m_lo0, metric);
+    m1 = _mm_adds_epu8(m_hi0, m_metric);
+    even = _mm_min_epu8(m0, m1);
+    keep_even = _mm_cmpeq_epi8(even, m0);
+
+    m0 = _mm_adds_epu8(m_lo0, m_metric);
+    m1 = _mm_adds_epu8(m_hi0, metric);
+    odd = _mm_min_epu8(m0, m1);
+    keep_odd = _mm_cmpeq_epi8(odd, m0);
+
+    n0 = _mm_unpacklo_epi8(even, odd);
+    n1 = _mm_unpackhi_epi8(even, odd);
+    keep0 = _mm_movemask_epi8(_mm_unpacklo_epi8(keep_even, keep_odd));
+    keep1 = _mm_movemask_epi8(_mm_unpackhi_epi8(keep_even, keep_odd));
+
+    // Butterflies 16..31 produce states 32..63
+    metric = _mm_avg_epu8(_mm_xor_si128(bt0_hi, sym0), _mm_xor_si128(bt1_hi, sym1));
+    metric = _mm_and_si128(_mm_srli_epi16(metric, 3), max_metric);
+    m_metric = _mm_sub_epi8(max_metric, metric);
+
+    m0 = _mm_adds_epu8(m_lo1, metric);
+    m1 = _mm_adds_epu8(m_hi1, m_metric);
+    even = _mm_min_epu8(m0, m1);
+    keep_even = _mm_cmpeq_epi8(even, m0);
+
+    m0 = _mm_adds_epu8(m_lo1, m_metric);
+    m1 = _mm_adds_epu8(m_hi1, metric);
+    odd = _mm_min_epu8(m0, m1);
+    keep_odd = _mm_cmpeq_epi8(odd, m0);
+
+    n2 = _mm_unpacklo_epi8(even, odd);
+    n3 = _mm_unpackhi_epi8(even, odd);
+    keep2 = _mm_movemask_epi8(_mm_unpacklo_epi8(keep_even, keep_odd));
+    keep3 = _mm_movemask_epi8(_mm_unpackhi_epi8(keep_even, keep_odd));
+
+    // A decision is set where the lower predecessor was not kept
+    d[0] = ~keep0 & 0xff; d[1] = (~keep0 >> 8) & 0xff;
+    d[2] = ~keep1 & 0xff; d[3] = (~keep1 >> 8) & 0xff;
+    d[4] = ~keep2 & 0xff; d[5] = (~keep2 >> 8) & 0xff;
+    d[6] = ~keep3 & 0xff; d[7] = (~keep3 >> 8) & 0xff;
+
+    // Renormalize so the best state has metric 0
+    min_metric = _mm_min_epu8(_mm_min_epu8(n0, n1), _mm_min_epu8(n2, n3));
+    min_metric = _mm_min_epu8(min_metric, _mm_srli_si128(min_metric, 8));
+    min_metric = _mm_min_epu8(min_metric, _mm_srli_si128(min_metric, 4));
+    min_metric = _mm_min_epu8(min_metric, _mm_srli_si128(min_metric, 2));
+    min_metric = _mm_min_epu8(min_metric, _mm_srli_si128(min_metric, 1));
+    min_metric = _mm_set1_epi8((char)(_mm_cvtsi128_si32(min_metric) & 0xff));
+
+    // The new states 0..31 are the lower predecessors of the next bit
+    m_lo0 = _mm_subs_epu8(n0, min_metric);
+    m_lo1 = _mm_subs_epu8(n1, min_metric);
+    m_hi0 = _mm_subs_epu8(n2, min_metric);
+    m_hi1 = _mm_subs_epu8(n3, min_metric);
+  }
+
+  _mm_storeu_si128((__m128i*)X, m_lo0);
+  _mm_storeu_si128((__m128i*)(X+16), m_lo1);
+  _mm_storeu_si128((__m128i*)(X+32), m_hi0);
+  _mm_storeu_si128((__m128i*)(X+48), m_hi1);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+#endif /* INCLUDED_volk_8u_x4_conv_k7_r2_8u_H */
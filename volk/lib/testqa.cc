@@ -86,6 +86,20 @@ VOLK_RUN_TESTS(volk_32fc_x2_multiply_conjugate_32fc, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_conjugate_32fc, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_x2_multiply_32f, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_s32fc_multiply_32fc, 1e-4, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32fc_x2_s32fc_multiply_conjugate_add_32fc, 1e-4, (lv_32fc_t)lv_cmake(0.03, -0.02), 20462, 1);
 VOLK_RUN_TESTS(volk_32f_s32f_multiply_32f, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32fc_s32fc_rotatorpuppet_32fc, 1e-3, (lv_32fc_t)lv_cmake(0.953939201, 0.3), 20462, 1);
+VOLK_RUN_TESTS(volk_8u_conv_k7_r2puppet_8u, 0, 0, 2050, 1);
+VOLK_RUN_TESTS(volk_8u_gf256_hornerpuppet_8u, 0, 0, 2070, 1);
+VOLK_RUN_TESTS(volk_8u_gf256_lincombpuppet_8u, 0, 0, 8192, 1);
+VOLK_RUN_TESTS(volk_8u_crcpuppet_32u, 0, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_8u_hammingpuppet_8u, 0, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32f_trellis_acspuppet_32f, 1e-4, 0, 20480, 1);
+VOLK_RUN_TESTS(volk_16i_trellis_acspuppet_16i, 0, 0, 20480, 1);
+VOLK_RUN_TESTS(volk_32f_trellis_maxstarpuppet_32f, 1e-4, 0, 20480, 1);
+VOLK_RUN_TESTS(volk_16i_trellis_maxstarpuppet_16i, 0, 0, 20480, 1);
+VOLK_RUN_TESTS(volk_32fc_costas_looppuppet_32fc, 1e-4, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32u_gaussianpuppet_32f, 1e-5, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32fc_sum_of_sinusoidspuppet_32f, 1e-3, 0, 20462, 1);
+VOLK_RUN_TESTS(volk_32fc_gather_dot_prodpuppet_32fc, 1e-4, 0, 20462, 1);
 VOLK_RUN_TESTS(volk_32f_invsqrt_32f, 1e-2, 0, 20462, 1);